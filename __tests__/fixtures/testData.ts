@@ -170,6 +170,53 @@ export const mockAudioSafetyReport = {
   clippedSamples: 0,
   feedbackScore: 0.1,
   overload: false,
+  momentaryLufs: -18.2,
+  shortTermLufs: -19.5,
+  integratedLufs: -20.1,
+  loudnessRange: 6.4,
+  truePeakDbtp: -1.3,
+  qualityTier: 0,
+  qualityTierChanges: 0,
+  cpuLoad: 0.32,
+  deadlineMisses: 0,
+};
+
+// Rapport de profilage CPU (µs par buffer de 10 ms)
+export const mockAudioProfileReport = {
+  compiledIn: true,
+  enabled: true,
+  buffers: 1200,
+  overruns: 0,
+  loadPercent: { count: 1200, mean: 4.1, p50: 3.9, p95: 6.2, p99: 8.4, max: 12.7 },
+  stagesUs: {
+    conversion: { count: 1200, mean: 18, p50: 17, p95: 24, p99: 31, max: 52 },
+    nr: { count: 1200, mean: 95, p50: 92, p95: 130, p99: 160, max: 240 },
+    rnnoise: { count: 0, mean: 0, p50: 0, p95: 0, p99: 0, max: 0 },
+    fx: { count: 1200, mean: 40, p50: 38, p95: 55, p99: 70, max: 110 },
+    safety: { count: 1200, mean: 120, p50: 115, p95: 170, p99: 210, max: 330 },
+    eq: { count: 1200, mean: 110, p50: 104, p95: 150, p99: 190, max: 300 },
+    analysis: { count: 0, mean: 0, p50: 0, p95: 0, p99: 0, max: 0 },
+    total: { count: 1200, mean: 410, p50: 390, p95: 620, p99: 840, max: 1270 },
+  },
+};
+
+// Progression d'un rendu hors ligne
+export const mockOfflineRenderProgress = {
+  state: 'running',
+  progress: 0.42,
+  realtimeFactor: 18.5,
+  audioSeconds: 75.6,
+  elapsedSeconds: 4.1,
+  filesDone: 1,
+  filesTotal: 3,
+  error: '',
+};
+
+// Courbe de l'EQ (4 points, 20 Hz .. 20 kHz)
+export const mockFrequencyResponse = {
+  frequencies: new Float32Array([20, 200, 2000, 20000]),
+  magnitudeDb: new Float32Array([5.8, 2.1, -1.4, 8.7]),
+  phase: new Float32Array([0.12, -0.31, 0.05, -0.02]),
 };
 
 // Données spectrales
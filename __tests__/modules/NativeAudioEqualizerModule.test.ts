@@ -2,11 +2,16 @@
  * Tests complets pour NativeAudioEqualizerModule
  */
 import { NativeModules } from 'react-native';
-import NativeAudioEqualizerModule from '../../specs/NativeAudioEqualizerModule';
+import NativeAudioEqualizerModule, {
+  EQFrequencyResponse,
+} from '../../specs/NativeAudioEqualizerModule';
 import {
   mockEQPresets,
   mockNoiseReductionConfig,
   mockAudioSafetyReport,
+  mockAudioProfileReport,
+  mockOfflineRenderProgress,
+  mockFrequencyResponse,
   mockSpectrumData,
 } from '../fixtures/testData';
 
@@ -138,6 +143,61 @@ describe('NativeAudioEqualizerModule', () => {
         expect(gain).toBe(0);
       });
     });
+
+    describe('getFrequencyResponse', () => {
+      it('should return the exact EQ curve as Float32Arrays', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.getFrequencyResponse.mockReturnValue(mockFrequencyResponse);
+
+        const response = NativeAudioEqualizerModule.getFrequencyResponse(
+          4, 20, 20000
+        ) as EQFrequencyResponse;
+
+        expect(mockModule.getFrequencyResponse).toHaveBeenCalledWith(4, 20, 20000);
+        expect(response).toBe(mockFrequencyResponse);
+        expect(response.frequencies).toBeInstanceOf(Float32Array);
+        expect(response.magnitudeDb).toBeInstanceOf(Float32Array);
+        expect(response.phase).toBeInstanceOf(Float32Array);
+      });
+
+      it('should return one point per requested frequency', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.getFrequencyResponse.mockReturnValue(mockFrequencyResponse);
+
+        const { frequencies, magnitudeDb, phase } =
+          NativeAudioEqualizerModule.getFrequencyResponse(4, 20, 20000) as EQFrequencyResponse;
+
+        expect(frequencies.length).toBe(4);
+        expect(magnitudeDb.length).toBe(4);
+        expect(phase.length).toBe(4);
+        expect(frequencies[0]).toBe(20);
+        expect(frequencies[3]).toBe(20000);
+      });
+
+      it('should space frequencies logarithmically', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.getFrequencyResponse.mockReturnValue(mockFrequencyResponse);
+
+        const { frequencies } =
+          NativeAudioEqualizerModule.getFrequencyResponse(4, 20, 20000) as EQFrequencyResponse;
+
+        for (let i = 1; i < frequencies.length; i++) {
+          expect(frequencies[i] / frequencies[i - 1]).toBeCloseTo(10, 3);
+        }
+      });
+
+      it('should keep phase within [-pi, pi]', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.getFrequencyResponse.mockReturnValue(mockFrequencyResponse);
+
+        const { phase } =
+          NativeAudioEqualizerModule.getFrequencyResponse(4, 20, 20000) as EQFrequencyResponse;
+
+        phase.forEach(p => {
+          expect(Math.abs(p)).toBeLessThanOrEqual(Math.PI);
+        });
+      });
+    });
   });
 
   describe('Presets', () => {
@@ -575,6 +635,167 @@ describe('NativeAudioEqualizerModule', () => {
     });
   });
 
+  describe('CPU Profiling', () => {
+    describe('perfGetReport', () => {
+      it('should get per-stage profile report', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.perfGetReport.mockReturnValue(mockAudioProfileReport);
+
+        const report = NativeAudioEqualizerModule.perfGetReport();
+
+        expect(report).toEqual(mockAudioProfileReport);
+        expect(report.compiledIn).toBe(true);
+        expect(report.overruns).toBe(0);
+      });
+
+      it('should report ordered percentiles for every stage', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.perfGetReport.mockReturnValue(mockAudioProfileReport);
+
+        const report = NativeAudioEqualizerModule.perfGetReport();
+
+        Object.values(report.stagesUs).forEach(stats => {
+          expect(stats.p50).toBeLessThanOrEqual(stats.p95);
+          expect(stats.p95).toBeLessThanOrEqual(stats.p99);
+          expect(stats.p99).toBeLessThanOrEqual(stats.max);
+        });
+        // Étages inactifs (RNNoise, analyse) : aucun échantillon
+        expect(report.stagesUs.rnnoise.count).toBe(0);
+        expect(report.stagesUs.total.count).toBe(report.buffers);
+      });
+
+      it('should keep total above the sum of stage means', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.perfGetReport.mockReturnValue(mockAudioProfileReport);
+
+        const { stagesUs } = NativeAudioEqualizerModule.perfGetReport();
+        const { total, ...stages } = stagesUs;
+        const sum = Object.values(stages).reduce((acc, s) => acc + s.mean, 0);
+
+        expect(total.mean).toBeGreaterThanOrEqual(sum);
+      });
+    });
+
+    describe('perfSetEnabled / perfReset', () => {
+      it('should toggle profiling and reset counters', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.perfSetEnabled.mockReturnValue(undefined);
+        mockModule.perfReset.mockReturnValue(undefined);
+        mockModule.perfGetReport.mockReturnValue({
+          ...mockAudioProfileReport,
+          enabled: false,
+          buffers: 0,
+        });
+
+        NativeAudioEqualizerModule.perfSetEnabled(false);
+        NativeAudioEqualizerModule.perfReset();
+        const report = NativeAudioEqualizerModule.perfGetReport();
+
+        expect(mockModule.perfSetEnabled).toHaveBeenCalledWith(false);
+        expect(mockModule.perfReset).toHaveBeenCalledTimes(1);
+        expect(report.enabled).toBe(false);
+        expect(report.buffers).toBe(0);
+      });
+    });
+  });
+
+  describe('Offline Rendering', () => {
+    describe('offlineRenderStart', () => {
+      it('should start rendering recorded files', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderStart.mockReturnValue(true);
+
+        const inputs = ['/rec/a.wav', '/rec/b.wav', '/rec/c.wav'];
+        const outputs = ['/out/a.wav', '/out/b.wav', '/rec/c.wav'];
+        const started = NativeAudioEqualizerModule.offlineRenderStart(inputs, outputs);
+
+        expect(mockModule.offlineRenderStart).toHaveBeenCalledWith(inputs, outputs);
+        expect(started).toBe(true);
+      });
+
+      it('should refuse a second render while one is running', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderStart
+          .mockReturnValueOnce(true)
+          .mockReturnValueOnce(false);
+
+        expect(NativeAudioEqualizerModule.offlineRenderStart(['/rec/a.wav'], ['/out/a.wav'])).toBe(true);
+        expect(NativeAudioEqualizerModule.offlineRenderStart(['/rec/b.wav'], ['/out/b.wav'])).toBe(false);
+      });
+    });
+
+    describe('offlineRenderGetProgress', () => {
+      it('should report progress of a running render', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderGetProgress.mockReturnValue(mockOfflineRenderProgress);
+
+        const progress = NativeAudioEqualizerModule.offlineRenderGetProgress();
+
+        expect(progress).toEqual(mockOfflineRenderProgress);
+        expect(progress.state).toBe('running');
+        expect(progress.progress).toBeGreaterThan(0);
+        expect(progress.progress).toBeLessThan(1);
+        expect(progress.filesDone).toBeLessThan(progress.filesTotal);
+        expect(progress.error).toBe('');
+      });
+
+      it('should render faster than real time', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderGetProgress.mockReturnValue(mockOfflineRenderProgress);
+
+        const { realtimeFactor, audioSeconds, elapsedSeconds } =
+          NativeAudioEqualizerModule.offlineRenderGetProgress();
+
+        expect(realtimeFactor).toBeGreaterThan(1);
+        expect(realtimeFactor).toBeCloseTo(audioSeconds / elapsedSeconds, 0);
+      });
+
+      it('should surface a failed render', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderGetProgress.mockReturnValue({
+          ...mockOfflineRenderProgress,
+          state: 'failed',
+          error: 'write failed: /out/b.wav',
+        });
+
+        const progress = NativeAudioEqualizerModule.offlineRenderGetProgress();
+
+        expect(progress.state).toBe('failed');
+        expect(progress.error).not.toBe('');
+      });
+    });
+
+    describe('offlineRenderCancel / offlineRenderSetNormalization', () => {
+      it('should cancel a running render', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderCancel.mockReturnValue(undefined);
+        mockModule.offlineRenderGetProgress.mockReturnValue({
+          ...mockOfflineRenderProgress,
+          state: 'cancelled',
+        });
+
+        NativeAudioEqualizerModule.offlineRenderCancel();
+
+        expect(mockModule.offlineRenderCancel).toHaveBeenCalledTimes(1);
+        expect(NativeAudioEqualizerModule.offlineRenderGetProgress().state).toBe('cancelled');
+      });
+
+      it('should set loudness normalization before rendering', () => {
+        const mockModule = NativeModules.NativeAudioEqualizerModule;
+        mockModule.offlineRenderSetNormalization.mockReturnValue(undefined);
+        mockModule.offlineRenderStart.mockReturnValue(true);
+
+        NativeAudioEqualizerModule.offlineRenderSetNormalization(true, -16.0, -1.0);
+        NativeAudioEqualizerModule.offlineRenderStart(['/rec/a.wav'], ['/out/a.wav']);
+
+        expect(mockModule.offlineRenderSetNormalization).toHaveBeenCalledWith(true, -16.0, -1.0);
+        expect(mockModule.offlineRenderSetNormalization).toHaveBeenCalledBefore(
+          mockModule.offlineRenderStart
+        );
+      });
+    });
+  });
+
   describe('Performance Tests', () => {
     it('should handle rapid band gain updates', () => {
       const mockModule = NativeModules.NativeAudioEqualizerModule;
@@ -17,4 +17,6 @@ public final class NativeEqProcessor {
   public static native void nativeSyncParams();
   public static native void
   nativeProcessShortInterleaved(short[] pcm, int frames, int channels);
+  // Retard de la chaîne de traitement (trames) : la sortie est en retard d'autant
+  public static native int nativeGetLatencyFrames();
 }
@@ -502,10 +502,15 @@ class Camera2VideoRecorder {
         if (read <= 0)
           continue;
         int frames = read / channels;
+        long latencyUs = 0;
         if (NativeEqProcessor.eqIsEnabled()) {
           NativeEqProcessor.nativeSyncParams();
           NativeEqProcessor.nativeProcessShortInterleaved(buf, frames,
                                                           channels);
+          // Sortie en retard de la chaîne : pts avancé d'autant (alignement
+          // vidéo)
+          latencyUs = NativeEqProcessor.nativeGetLatencyFrames() * 1000000L /
+                      sampleRate;
         }
         int inIndex = audioEncoder.dequeueInputBuffer(10000);
         if (inIndex >= 0) {
@@ -518,7 +523,7 @@ class Camera2VideoRecorder {
               inBuf.put((byte)(s & 0xff));
               inBuf.put((byte)((s >> 8) & 0xff));
             }
-            long pts = System.nanoTime() / 1000;
+            long pts = System.nanoTime() / 1000 - latencyUs;
             audioEncoder.queueInputBuffer(inIndex, 0, read * 2, pts, 0);
           }
         }
@@ -6,6 +6,7 @@
 #include <math.h>
 #include <algorithm>
 #include <cstring>
+#include <cstdint>
 
 // C API global exposée par le module EQ
 extern "C" bool NaayaEQ_IsEnabled();
@@ -14,6 +15,7 @@ extern "C" size_t NaayaEQ_CopyBandGains(double* out, size_t maxCount);
 extern "C" size_t NaayaEQ_GetNumBands();
 extern "C" bool NaayaEQ_HasPendingUpdate();
 extern "C" void NaayaEQ_ClearPendingUpdate();
+extern "C" double NaayaEQ_ConsumeMorphMs();
 
 // NR state exposed by C API (shared with iOS)
 extern "C" bool NaayaNR_IsEnabled();
@@ -39,13 +41,49 @@ extern "C" void NaayaFX_GetCompressor(double* thresholdDb,
 extern "C" void NaayaFX_GetDelay(double* delayMs,
                                   double* feedback,
                                   double* mix);
+extern "C" void NaayaFX_GetSaturation(bool* enabled,
+                                       int* type,
+                                       double* driveDb,
+                                       double* mix,
+                                       double* outputDb);
+
+// Safety report (shared with iOS)
+extern "C" void NaayaSafety_UpdateReport(double peak,
+                                         double rms,
+                                         double dcOffset,
+                                         uint32_t clippedSamples,
+                                         double feedbackScore,
+                                         bool overload);
+extern "C" void NaayaSafety_UpdateLoudness(double momentaryLufs,
+                                           double shortTermLufs,
+                                           double integratedLufs,
+                                           double loudnessRange,
+                                           double truePeakDbtp);
+extern "C" bool NaayaSafety_ConsumeLoudnessReset();
+extern "C" void NaayaSafety_UpdateGovernor(int qualityTier,
+                                           uint32_t tierChanges,
+                                           double cpuLoad,
+                                           uint32_t deadlineMisses);
+extern "C" bool NaayaSafety_IsGovernorEnabled();
+
+// Enregistrement de la sortie traitée (module partagé)
+extern "C" void NaayaRecord_SetStreamFormat(uint32_t sampleRate, int numChannels);
+extern "C" void NaayaRecord_PushPlanar(const float* const* channels, int numChannels, size_t frames);
+
+// Latence de la chaîne (module partagé)
+extern "C" void NaayaLatency_Update(uint32_t sampleRate, size_t noiseReduction, size_t effects, size_t safety, size_t equalizer);
 
 #include "core/AudioEqualizer.h"
 #include "noise/NoiseReducer.h"
 #include "safety/AudioSafety.h"
+#include "safety/CpuGovernor.h"
 #include "effects/EffectChain.h"
 #include "effects/Compressor.h"
 #include "effects/Delay.h"
+#include "effects/Saturation.h"
+#include "utils/RealtimeScope.h"
+#include "utils/AudioProfiler.h"
+#include "utils/AudioBuffer.h"
 
 namespace {
 using AudioEqClass = AudioEqualizer::AudioEqualizer;
@@ -55,9 +93,73 @@ int g_channels = 2;
 std::unique_ptr<AudioNR::NoiseReducer> g_nr;
 std::unique_ptr<AudioSafety::AudioSafetyEngine> g_safety;
 std::unique_ptr<AudioFX::EffectChain> g_fx;
+// Effets de g_fx (construits une fois dans nativeInit), mis à jour en place par nativeSyncParams
+AudioFX::SaturationEffect* g_sat = nullptr;
+AudioFX::CompressorEffect* g_comp = nullptr;
+AudioFX::DelayEffect* g_del = nullptr;
+std::unique_ptr<AudioSafety::CpuGovernor> g_governor;
+// Tampons de travail stéréo (entrée, ping-pong, sortie), réutilisés d'un buffer à l'autre
+constexpr size_t kScratchBuffers = 3;
+constexpr size_t kScratchFrames = 4096;
+std::unique_ptr<AudioEqualizer::AudioBufferPool> g_scratch;
+
+// Retard de la chaîne courante (échantillons), relu par l'enregistreur pour recaler ses pts
+std::atomic<size_t> g_latencyFrames{0};
 
 // === Spectre (aligné iOS) ===
 static std::atomic<bool> g_spectrumRunning{false};
+
+// Sans verrou : seqlock du module, lu par safetyGetReport
+static void publishSafetyReport() {
+  auto rep = g_safety->getLastReport();
+  NaayaSafety_UpdateReport(rep.peak, rep.rms, rep.dcOffset, rep.clippedSamples, rep.feedbackScore, rep.overloadActive);
+  NaayaSafety_UpdateLoudness(rep.momentaryLufs, rep.shortTermLufs, rep.integratedLufs, rep.loudnessRange, rep.truePeakDbtp);
+}
+
+// Android : expander seul (pas de RNNoise), le palier agit sur la limite de bandes EQ
+static void beginGovernorBuffer() {
+  bool enabled = NaayaSafety_IsGovernorEnabled();
+  if (g_governor->getConfig().enabled != enabled) {
+    AudioSafety::GovernorConfig cfg = g_governor->getConfig();
+    cfg.enabled = enabled;
+    g_governor->setConfig(cfg);
+  }
+  g_governor->beginBuffer();
+  g_eq->setBandLimit(AudioSafety::CpuGovernor::eqBandLimitFor(g_governor->tier(), g_eq->getNumBands()));
+}
+
+// Android : étages sans retard aujourd'hui, publiés pour le rapport JS et l'enregistreur.
+// Sans verrou (seqlock du module), et seulement quand un retard change.
+static void publishLatency() {
+  const size_t nr = g_nr ? g_nr->getLatencySamples() : 0;
+  const size_t fx = (g_fx && g_fx->isEnabled()) ? g_fx->getLatencySamples() : 0;
+  const size_t safety = g_safety ? g_safety->getLatencySamples() : 0;
+  const size_t eq = g_eq->getLatencySamples();
+  static size_t s_published[5] = {SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX};
+  const size_t current[5] = {g_sampleRate, nr, fx, safety, eq};
+  if (std::equal(current, current + 5, s_published)) return;
+  std::copy(current, current + 5, s_published);
+  NaayaLatency_Update(g_sampleRate, nr, fx, safety, eq);
+  g_latencyFrames.store(nr + fx + safety + eq, std::memory_order_relaxed);
+}
+
+// Paramètres FX du module appliqués aux effets existants, sans reconstruire la chaîne
+static void applyFxParams() {
+  g_fx->setEnabled(NaayaFX_IsEnabled());
+  bool sEn; int sTy; double sDr, sMx, sOut; NaayaFX_GetSaturation(&sEn, &sTy, &sDr, &sMx, &sOut);
+  g_sat->setParameters(static_cast<AudioFX::SaturationType>(sTy), sDr, sMx, sOut);
+  g_sat->setEnabled(sEn);
+  double th, ra, at, rl, mk; NaayaFX_GetCompressor(&th, &ra, &at, &rl, &mk);
+  g_comp->setParameters(th, ra, at, rl, mk);
+  double dm, fb, mx; NaayaFX_GetDelay(&dm, &fb, &mx);
+  g_del->setParameters(dm, fb, mx);
+}
+
+static void endGovernorBuffer(size_t frames) {
+  g_governor->endBuffer(frames);
+  NaayaSafety_UpdateGovernor(static_cast<int>(g_governor->tier()), g_governor->tierChanges(),
+                             g_governor->smoothedLoad(), g_governor->deadlineMisses());
+}
 static float g_spectrum[64] = {0};
 
 static inline float hann(size_t n, size_t N) {
@@ -137,24 +239,22 @@ Java_com_naaya_audio_NativeEqProcessor_nativeInit(JNIEnv*, jclass, jint sampleRa
   g_eq = std::make_unique<AudioEqClass>(10, static_cast<uint32_t>(sampleRate));
   g_sampleRate = static_cast<uint32_t>(sampleRate);
   g_channels = channels;
+  NaayaRecord_SetStreamFormat(g_sampleRate, g_channels);
   // NR init
   g_nr = std::make_unique<AudioNR::NoiseReducer>(g_sampleRate, g_channels);
   g_safety = std::make_unique<AudioSafety::AudioSafetyEngine>(g_sampleRate, g_channels);
+  g_governor = std::make_unique<AudioSafety::CpuGovernor>(g_sampleRate);
+  g_scratch = std::make_unique<AudioEqualizer::AudioBufferPool>(kScratchBuffers, 2, kScratchFrames);
   // FX init
   g_fx = std::make_unique<AudioFX::EffectChain>();
-  g_fx->setEnabled(NaayaFX_IsEnabled());
   g_fx->setSampleRate(g_sampleRate, g_channels);
-  // Build chain with defaults
-  {
-    auto* comp = g_fx->emplaceEffect<AudioFX::CompressorEffect>();
-    auto* del = g_fx->emplaceEffect<AudioFX::DelayEffect>();
-    comp->setEnabled(true);
-    del->setEnabled(true);
-    double th, ra, at, rl, mk; NaayaFX_GetCompressor(&th, &ra, &at, &rl, &mk);
-    comp->setParameters(th, ra, at, rl, mk);
-    double dm, fb, mx; NaayaFX_GetDelay(&dm, &fb, &mx);
-    del->setParameters(dm, fb, mx);
-  }
+  // Chaîne construite une seule fois; nativeSyncParams ne fait que changer les paramètres
+  g_sat = g_fx->emplaceEffect<AudioFX::SaturationEffect>();
+  g_comp = g_fx->emplaceEffect<AudioFX::CompressorEffect>();
+  g_del = g_fx->emplaceEffect<AudioFX::DelayEffect>();
+  g_comp->setEnabled(true);
+  g_del->setEnabled(true);
+  applyFxParams();
   {
     bool hpE; double hpHz, thDb, ratio, flDb, aMs, rMs;
     NaayaNR_GetConfig(&hpE, &hpHz, &thDb, &ratio, &flDb, &aMs, &rMs);
@@ -162,9 +262,10 @@ Java_com_naaya_audio_NativeEqProcessor_nativeInit(JNIEnv*, jclass, jint sampleRa
   }
   double gains[32] = {0};
   size_t nb = NaayaEQ_CopyBandGains(gains, 32);
-  g_eq->beginParameterUpdate();
-  for (size_t i = 0; i < nb; ++i) g_eq->setBandGain(i, gains[i]);
-  g_eq->endParameterUpdate();
+  AudioEqualizer::EQPreset initial;
+  initial.gains.assign(gains, gains + nb);
+  g_eq->loadPreset(initial);
+  NaayaEQ_ConsumeMorphMs();
   g_eq->setMasterGain(NaayaEQ_GetMasterGainDB());
   g_eq->setBypass(!NaayaEQ_IsEnabled());
 }
@@ -173,6 +274,8 @@ extern "C" JNIEXPORT void JNICALL
 Java_com_naaya_audio_NativeEqProcessor_nativeRelease(JNIEnv*, jclass) {
   g_eq.reset();
   g_nr.reset();
+  g_governor.reset();
+  g_scratch.reset();
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -181,9 +284,12 @@ Java_com_naaya_audio_NativeEqProcessor_nativeSyncParams(JNIEnv*, jclass) {
   if (NaayaEQ_HasPendingUpdate()) {
     double gains[32] = {0};
     size_t nb = NaayaEQ_CopyBandGains(gains, 32);
-    g_eq->beginParameterUpdate();
-    for (size_t i = 0; i < nb; ++i) g_eq->setBandGain(i, gains[i]);
-    g_eq->endParameterUpdate();
+    // Un seul verrou pour toutes les bandes; fondu si demandé (morphToPreset côté JS)
+    AudioEqualizer::EQPreset target;
+    target.gains.assign(gains, gains + nb);
+    const double morphMs = NaayaEQ_ConsumeMorphMs();
+    if (morphMs > 0.0) g_eq->morphToPreset(target, morphMs);
+    else g_eq->loadPreset(target);
     g_eq->setMasterGain(NaayaEQ_GetMasterGainDB());
     g_eq->setBypass(!NaayaEQ_IsEnabled());
     NaayaEQ_ClearPendingUpdate();
@@ -197,72 +303,95 @@ Java_com_naaya_audio_NativeEqProcessor_nativeSyncParams(JNIEnv*, jclass) {
     }
   }
   if (NaayaFX_HasPendingUpdate()) {
-    if (g_fx) {
-      g_fx->setEnabled(NaayaFX_IsEnabled());
-      double th, ra, at, rl, mk; NaayaFX_GetCompressor(&th, &ra, &at, &rl, &mk);
-      double dm, fb, mx; NaayaFX_GetDelay(&dm, &fb, &mx);
-      g_fx->setSampleRate(g_sampleRate, g_channels);
-      g_fx->clear();
-      auto* comp = g_fx->emplaceEffect<AudioFX::CompressorEffect>();
-      auto* del = g_fx->emplaceEffect<AudioFX::DelayEffect>();
-      comp->setEnabled(true); del->setEnabled(true);
-      comp->setParameters(th, ra, at, rl, mk);
-      del->setParameters(dm, fb, mx);
-    }
+    if (g_fx) applyFxParams();
     NaayaFX_ClearPendingUpdate();
   }
 }
 
+extern "C" JNIEXPORT jint JNICALL
+Java_com_naaya_audio_NativeEqProcessor_nativeGetLatencyFrames(JNIEnv*, jclass) {
+  return static_cast<jint>(g_latencyFrames.load(std::memory_order_relaxed));
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_naaya_audio_NativeEqProcessor_nativeProcessShortInterleaved(JNIEnv* env, jclass, jshortArray pcm, jint frames, jint channels) {
-  if (!g_eq || !pcm || frames <= 0) return;
+  if (!g_eq || !g_governor || !g_scratch || !pcm || frames <= 0) return;
   if (channels != 1 && channels != 2) channels = 2;
   jsize len = env->GetArrayLength(pcm);
   if (len < (channels * frames)) return;
+  // Buffer plus long que prévu : agrandit le pool hors section temps réel (rare)
+  if ((size_t)frames > g_scratch->getMaxSamples()) g_scratch->reserve((size_t)frames);
   jshort* buf = env->GetShortArrayElements(pcm, nullptr);
   if (!buf) return;
-  // Tampons réutilisés par thread pour limiter les allocations
-  static thread_local std::vector<float> tlMono;
-  static thread_local std::vector<float> tlTmpMono;
-  static thread_local std::vector<float> tlOutMono;
-  static thread_local std::vector<float> tlLeft;
-  static thread_local std::vector<float> tlRight;
-  static thread_local std::vector<float> tlTmpL;
-  static thread_local std::vector<float> tlTmpR;
-  static thread_local std::vector<float> tlOutL;
-  static thread_local std::vector<float> tlOutR;
-  if (channels == 1) {
-    tlMono.resize((size_t)frames);
-    tlOutMono.resize((size_t)frames);
-    for (int i = 0; i < frames; ++i) tlMono[(size_t)i] = (float)buf[i] / 32768.0f;
-    if (g_nr) { tlTmpMono.resize((size_t)frames); g_nr->processMono(tlMono.data(), tlTmpMono.data(), (size_t)frames); tlMono.swap(tlTmpMono); }
-    if (g_spectrumRunning.load()) { computeSpectrumFromMono(tlMono.data(), (size_t)frames); }
-    if (g_fx && g_fx->isEnabled()) { tlTmpMono.resize((size_t)frames); g_fx->processMono(tlMono.data(), tlTmpMono.data(), (size_t)frames); tlMono.swap(tlTmpMono); }
-    if (g_safety) { g_safety->processMono(tlMono.data(), (size_t)frames); }
-    g_eq->process(tlMono.data(), tlOutMono.data(), (size_t)frames);
-    for (int i = 0; i < frames; ++i) {
-      float v = tlOutMono[(size_t)i]; if (v < -1.f) v = -1.f; if (v > 1.f) v = 1.f;
-      buf[i] = (jshort)lrintf(v * 32767.0f);
-    }
-  } else {
-    tlLeft.resize((size_t)frames); tlRight.resize((size_t)frames);
-    tlOutL.resize((size_t)frames); tlOutR.resize((size_t)frames);
-    for (int i = 0; i < frames; ++i) { tlLeft[(size_t)i] = (float)buf[2*i] / 32768.0f; tlRight[(size_t)i] = (float)buf[2*i+1] / 32768.0f; }
-    if (g_nr) { tlTmpL.resize((size_t)frames); tlTmpR.resize((size_t)frames); g_nr->processStereo(tlLeft.data(), tlRight.data(), tlTmpL.data(), tlTmpR.data(), (size_t)frames); tlLeft.swap(tlTmpL); tlRight.swap(tlTmpR); }
-    if (g_spectrumRunning.load()) {
-      tlTmpMono.resize((size_t)frames);
-      for (int i = 0; i < frames; ++i) tlTmpMono[(size_t)i] = 0.5f * (tlLeft[(size_t)i] + tlRight[(size_t)i]);
-      computeSpectrumFromMono(tlTmpMono.data(), (size_t)frames);
-    }
-    if (g_fx && g_fx->isEnabled()) { tlTmpL.resize((size_t)frames); tlTmpR.resize((size_t)frames); g_fx->processStereo(tlLeft.data(), tlRight.data(), tlTmpL.data(), tlTmpR.data(), (size_t)frames); tlLeft.swap(tlTmpL); tlRight.swap(tlTmpR); }
-    if (g_safety) { g_safety->processStereo(tlLeft.data(), tlRight.data(), (size_t)frames); }
-    g_eq->processStereo(tlLeft.data(), tlRight.data(), tlOutL.data(), tlOutR.data(), (size_t)frames);
-    for (int i = 0; i < frames; ++i) {
-      float vl = tlOutL[(size_t)i]; if (vl < -1.f) vl = -1.f; if (vl > 1.f) vl = 1.f;
-      float vr = tlOutR[(size_t)i]; if (vr < -1.f) vr = -1.f; if (vr > 1.f) vr = 1.f;
-      buf[2*i] = (jshort)lrintf(vl * 32767.0f);
-      buf[2*i+1] = (jshort)lrintf(vr * 32767.0f);
+  {
+    // Section temps réel : FTZ/DAZ + tripwires (builds NAAYA_RT_TRIPWIRES)
+    AudioEqualizer::RealtimeScope rtScope;
+    AudioEqualizer::ProfileLap lap((size_t)frames, g_sampleRate);
+    beginGovernorBuffer();
+    publishLatency();
+    const size_t n = (size_t)frames;
+    auto work = g_scratch->acquire(n);
+    auto tmp = g_scratch->acquire(n);
+    auto out = g_scratch->acquire(n);
+    if (channels == 1) {
+      for (size_t i = 0; i < n; ++i) work.getChannel(0)[i] = (float)buf[i] / 32768.0f;
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+      if (g_nr) { g_nr->processMono(work.getChannel(0), tmp.getChannel(0), n); std::swap(work, tmp); lap.mark(AudioEqualizer::ProfileStage::NoiseReducer); }
+      if (g_spectrumRunning.load()) { computeSpectrumFromMono(work.getChannel(0), n); lap.mark(AudioEqualizer::ProfileStage::Analysis); }
+      if (g_fx && g_fx->isEnabled()) { g_fx->processMono(work.getChannel(0), tmp.getChannel(0), n); std::swap(work, tmp); lap.mark(AudioEqualizer::ProfileStage::Effects); }
+      if (g_safety) {
+        if (NaayaSafety_ConsumeLoudnessReset()) g_safety->resetLoudness();
+        g_safety->processMono(work.getChannel(0), n);
+        publishSafetyReport();
+        lap.mark(AudioEqualizer::ProfileStage::Safety);
+      }
+      g_eq->process(work.getChannel(0), out.getChannel(0), n);
+      lap.mark(AudioEqualizer::ProfileStage::Equalizer);
+      const float* o = out.getChannel(0);
+      NaayaRecord_PushPlanar(&o, 1, n);
+      for (size_t i = 0; i < n; ++i) {
+        float v = o[i]; if (v < -1.f) v = -1.f; if (v > 1.f) v = 1.f;
+        buf[i] = (jshort)lrintf(v * 32767.0f);
+      }
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+    } else {
+      float* inL = work.getChannel(0);
+      float* inR = work.getChannel(1);
+      for (size_t i = 0; i < n; ++i) { inL[i] = (float)buf[2*i] / 32768.0f; inR[i] = (float)buf[2*i+1] / 32768.0f; }
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+      if (g_nr) { g_nr->processStereo(work.getChannel(0), work.getChannel(1), tmp.getChannel(0), tmp.getChannel(1), n); std::swap(work, tmp); lap.mark(AudioEqualizer::ProfileStage::NoiseReducer); }
+      if (g_spectrumRunning.load()) {
+        // Mixage mono dans le tampon de sortie, réécrit ensuite par l'EQ
+        float* mono = out.getChannel(0);
+        std::memcpy(mono, work.getChannel(0), n * sizeof(float));
+        AudioEqualizer::AudioKernels::mix(mono, work.getChannel(1), n);
+        AudioEqualizer::AudioKernels::gain(mono, n, 0.5f);
+        computeSpectrumFromMono(mono, n);
+        lap.mark(AudioEqualizer::ProfileStage::Analysis);
+      }
+      if (g_fx && g_fx->isEnabled()) { g_fx->processStereo(work.getChannel(0), work.getChannel(1), tmp.getChannel(0), tmp.getChannel(1), n); std::swap(work, tmp); lap.mark(AudioEqualizer::ProfileStage::Effects); }
+      if (g_safety) {
+        if (NaayaSafety_ConsumeLoudnessReset()) g_safety->resetLoudness();
+        g_safety->processStereo(work.getChannel(0), work.getChannel(1), n);
+        publishSafetyReport();
+        lap.mark(AudioEqualizer::ProfileStage::Safety);
+      }
+      g_eq->processStereo(work.getChannel(0), work.getChannel(1), out.getChannel(0), out.getChannel(1), n);
+      lap.mark(AudioEqualizer::ProfileStage::Equalizer);
+      const float* oL = out.getChannel(0);
+      const float* oR = out.getChannel(1);
+      const float* rec[2] = {oL, oR};
+      NaayaRecord_PushPlanar(rec, 2, n);
+      for (size_t i = 0; i < n; ++i) {
+        float vl = oL[i]; if (vl < -1.f) vl = -1.f; if (vl > 1.f) vl = 1.f;
+        float vr = oR[i]; if (vr < -1.f) vr = -1.f; if (vr > 1.f) vr = 1.f;
+        buf[2*i] = (jshort)lrintf(vl * 32767.0f);
+        buf[2*i+1] = (jshort)lrintf(vr * 32767.0f);
+      }
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
     }
+    lap.finish();
+    endGovernorBuffer((size_t)frames);
   }
   env->ReleaseShortArrayElements(pcm, buf, 0);
 }
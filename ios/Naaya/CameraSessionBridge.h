@@ -37,6 +37,13 @@ void NaayaGetWhiteBalanceGains(double* red, double* green, double* blue);
 const char** NaayaGetSupportedWhiteBalanceModes(int* count);
 void NaayaGetWhiteBalanceTemperatureRange(double* min, double* max);
 
+// Buffer BGRA de sortie des filtres, pris dans un CVPixelBufferPool par flux
+// (0 = aperçu, 1 = enregistrement), recréé si la taille change. À rendre par CVPixelBufferRelease.
+// Entrée caméra distincte de ce buffer : les passes natives écrivent directement dedans, FFmpeg y
+// recopie la sortie du graphe (une copie par image). Le buffer caméra n'est jamais filtré en place,
+// il est partagé entre les sorties vidéo de la session.
+CVPixelBufferRef NaayaCreateFilterOutputBuffer(int stream, size_t width, size_t height);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,7 @@
 #import <Foundation/Foundation.h>
 #import <AVFoundation/AVFoundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <os/lock.h>
 
 #import "CameraSessionBridge.h"
 
@@ -183,4 +185,43 @@ void NaayaGetWhiteBalanceTemperatureRange(double* min, double* max) {
 }
 #endif
 
-
+// Pools de sortie des filtres : un par flux, remplacés quand la taille change
+static CVPixelBufferPoolRef s_filterPools[2] = {NULL, NULL};
+static size_t s_filterPoolWidth[2] = {0, 0};
+static size_t s_filterPoolHeight[2] = {0, 0};
+static os_unfair_lock s_filterPoolLock = OS_UNFAIR_LOCK_INIT;
+
+CVPixelBufferRef NaayaCreateFilterOutputBuffer(int stream, size_t width, size_t height) {
+  if (stream < 0 || stream > 1 || width == 0 || height == 0) return NULL;
+
+  os_unfair_lock_lock(&s_filterPoolLock);
+  if (s_filterPools[stream] && (s_filterPoolWidth[stream] != width || s_filterPoolHeight[stream] != height)) {
+    // Les buffers encore en vol gardent l'ancien pool en vie
+    CVPixelBufferPoolRelease(s_filterPools[stream]);
+    s_filterPools[stream] = NULL;
+  }
+  if (!s_filterPools[stream]) {
+    NSDictionary* poolAttrs = @{ (NSString*)kCVPixelBufferPoolMinimumBufferCountKey: @(3) };
+    NSDictionary* attrs = @{
+      (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+      (NSString*)kCVPixelBufferWidthKey: @(width),
+      (NSString*)kCVPixelBufferHeightKey: @(height),
+      (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{}
+    };
+    CVPixelBufferPoolRef pool = NULL;
+    if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttrs,
+                                (__bridge CFDictionaryRef)attrs, &pool) == kCVReturnSuccess) {
+      s_filterPools[stream] = pool;
+      s_filterPoolWidth[stream] = width;
+      s_filterPoolHeight[stream] = height;
+    }
+  }
+  CVPixelBufferPoolRef pool = s_filterPools[stream] ? CVPixelBufferPoolRetain(s_filterPools[stream]) : NULL;
+  os_unfair_lock_unlock(&s_filterPoolLock);
+  if (!pool) return NULL;
+
+  CVPixelBufferRef buffer = NULL;
+  CVReturn status = CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, pool, &buffer);
+  CVPixelBufferPoolRelease(pool);
+  return status == kCVReturnSuccess ? buffer : NULL;
+}
@@ -5,6 +5,8 @@
 #import <QuartzCore/QuartzCore.h>
 #import <Metal/Metal.h>
 #import "CameraSessionBridge.h"
+#include "../../shared/Camera/pipeline/FramePipeline.hpp"
+#include <memory>
 
 // API C exposée par le module filtres C++
 #ifdef __cplusplus
@@ -41,7 +43,10 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
 }
 #endif
 
-@interface NaayaPreviewView () <AVCaptureVideoDataOutputSampleBufferDelegate>
+@interface NaayaPreviewView () <AVCaptureVideoDataOutputSampleBufferDelegate> {
+  // Filtre et affichage hors du callback AVFoundation
+  std::unique_ptr<Camera::FramePipeline> _pipeline;
+}
 @property(nonatomic, strong) AVCaptureVideoPreviewLayer* previewLayer;
 @property(nonatomic, strong) AVCaptureVideoDataOutput* videoOutput;
 @property(nonatomic) dispatch_queue_t videoQueue;
@@ -85,12 +90,34 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
   // Contexte CI
   self.ciContext = [CIContext contextWithOptions:nil];
 
-  // Sortie vidéo (pour frames brutes)
+  // Couche d'affichage vidéo pour éviter CGImage à chaque frame
+  self.displayLayer = [AVSampleBufferDisplayLayer layer];
+  self.displayLayer.videoGravity = AVLayerVideoGravityResizeAspectFill;
+  self.displayLayer.frame = self.bounds;
+  self.displayLayer.hidden = YES;
+  [self.layer addSublayer:self.displayLayer];
+
+  // Chemin Metal (rendu GPU natif)
+  self.metalDevice = MTLCreateSystemDefaultDevice();
+  if (self.metalDevice) {
+    self.metalLayer = [CAMetalLayer layer];
+    self.metalLayer.device = self.metalDevice;
+    self.metalLayer.pixelFormat = MTLPixelFormatBGRA8Unorm;
+    self.metalLayer.frame = self.bounds;
+    self.metalLayer.contentsScale = [UIScreen mainScreen].scale;
+    self.metalLayer.hidden = YES;
+    [self.layer addSublayer:self.metalLayer];
+    self.metalQueue = [self.metalDevice newCommandQueue];
+    self.ciMetalContext = [CIContext contextWithMTLDevice:self.metalDevice options:nil];
+  }
+
+  // Sortie vidéo (pour frames brutes), après les couches de rendu utilisées par le pipeline
   if (session) {
     AVCaptureVideoDataOutput* output = [[AVCaptureVideoDataOutput alloc] init];
     // Format facile pour CoreImage
     output.videoSettings = @{ (NSString*)kCVPixelBufferPixelFormatTypeKey : @(kCVPixelFormatType_32BGRA) };
     output.alwaysDiscardsLateVideoFrames = YES;
+    [self setupPipeline];
     dispatch_queue_t queue = dispatch_queue_create("naaya.camera.videoQueue", DISPATCH_QUEUE_SERIAL);
     [output setSampleBufferDelegate:self queue:queue];
     self.videoQueue = queue;
@@ -105,33 +132,63 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
       self.videoOutput = output;
     }
   }
+}
 
-  // Couche d'affichage vidéo pour éviter CGImage à chaque frame
-  self.displayLayer = [AVSampleBufferDisplayLayer layer];
-  self.displayLayer.videoGravity = AVLayerVideoGravityResizeAspectFill;
-  self.displayLayer.frame = self.bounds;
-  self.displayLayer.hidden = YES;
-  [self.layer addSublayer:self.displayLayer];
-
-  // Chemin Metal (rendu GPU natif)
-  self.metalDevice = MTLCreateSystemDefaultDevice();
-  if (self.metalDevice) {
-    self.metalLayer = [CAMetalLayer layer];
-    self.metalLayer.device = self.metalDevice;
-    self.metalLayer.pixelFormat = MTLPixelFormatBGRA8Unorm;
-    self.metalLayer.frame = self.bounds;
-    self.metalLayer.contentsScale = [UIScreen mainScreen].scale;
-    self.metalLayer.hidden = YES;
-    [self.layer addSublayer:self.metalLayer];
-    self.metalQueue = [self.metalDevice newCommandQueue];
-    self.ciMetalContext = [CIContext contextWithMTLDevice:self.metalDevice options:nil];
+// Aperçu filtré : étapes filtre puis affichage sur leurs threads, deux images en vol au plus;
+// une image en attente est remplacée par la plus récente plutôt que de retarder l'aperçu
+- (void)setupPipeline {
+  if (_pipeline) return;
+  Camera::FramePipelineConfig config;
+  config.name = "aperçu";
+  config.depth = 2;
+  config.policy = Camera::FrameDropPolicy::DropOldest;
+  _pipeline = std::make_unique<Camera::FramePipeline>(config);
+  // Non retenue : le pipeline est arrêté quand la vue quitte sa fenêtre, avant sa libération.
+  // Threads d'étape hors GCD : un pool d'autorelease par image.
+  __unsafe_unretained NaayaPreviewView* view = self;
+  _pipeline->addStage("filtre", [view](Camera::PipelineFrame& frame) -> bool {
+    @autoreleasepool { return [view filterFrame:frame]; }
+  });
+  _pipeline->addStage("affichage", [view](Camera::PipelineFrame& frame) -> bool {
+    @autoreleasepool { return [view presentFrame:frame]; }
+  });
+  _pipeline->setReleaseCallback([](Camera::PipelineFrame& frame, Camera::FrameOutcome) {
+    if (frame.output) CFRelease((CFTypeRef)frame.output);
+    if (frame.image) CFRelease((CFTypeRef)frame.image);
+  });
+  if (!_pipeline->start()) {
+    _pipeline.reset();
   }
 }
 
 - (void)layoutSubviews { [super layoutSubviews]; self.previewLayer.frame = self.bounds; self.filteredLayer.frame = self.bounds; self.displayLayer.frame = self.bounds; self.metalLayer.frame = self.bounds; }
 
+// Hors fenêtre : images en vol rendues et threads d'étape arrêtés, relancés au retour.
+// Sur la file de capture : aucune soumission pendant le démarrage ou l'arrêt.
+- (void)didMoveToWindow {
+  [super didMoveToWindow];
+  if (!_pipeline || !self.videoQueue) return;
+  BOOL visible = self.window != nil;
+  Camera::FramePipeline* pipeline = _pipeline.get();
+  dispatch_sync(self.videoQueue, ^{
+    if (visible) {
+      pipeline->start();
+    } else {
+      pipeline->stop(false);
+    }
+  });
+}
+
+- (void)dealloc {
+  // Plus de callback de capture (celui en cours se termine), puis pipeline arrêté
+  [self.videoOutput setSampleBufferDelegate:nil queue:NULL];
+  if (self.videoQueue) dispatch_sync(self.videoQueue, ^{});
+  if (_pipeline) _pipeline->stop(false);
+}
+
 #pragma mark - AVCaptureVideoDataOutputSampleBufferDelegate
 
+// Callback de capture : aucun traitement ici, l'image part dans le pipeline de l'aperçu
 - (void)captureOutput:(AVCaptureOutput *)output didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer fromConnection:(AVCaptureConnection *)connection {
   (void)output; (void)connection;
   BOOL hasFilter = NaayaFilters_HasFilter();
@@ -152,7 +209,128 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
     }
     return;
   }
+  if (!_pipeline || !CMSampleBufferGetImageBuffer(sampleBuffer)) return;
+
+  // Sample buffer retenu jusqu'au callback de libération du pipeline
+  CFRetain(sampleBuffer);
+  CMTime pts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+  int64_t timestampNs = CMTIME_IS_VALID(pts) ? (int64_t)(CMTimeGetSeconds(pts) * 1e9) : 0;
+  if (!_pipeline->submit((void*)sampleBuffer, timestampNs)) {
+    CFRelease(sampleBuffer);
+  }
+}
+
+#pragma mark - Pipeline de l'aperçu
+
+// Étape filtre : FFmpeg vers un buffer du pool de l'aperçu, sinon Core Image (CGImage)
+- (BOOL)filterFrame:(Camera::PipelineFrame&)frame {
+  CVImageBufferRef pixelBuffer = CMSampleBufferGetImageBuffer((CMSampleBufferRef)frame.image);
+  if (!pixelBuffer) return NO;
+  CVPixelBufferRef outputBuffer = [self ffmpegFilteredBuffer:pixelBuffer];
+  if (outputBuffer) {
+    frame.output = outputBuffer;
+    return YES;
+  }
+  CGImageRef cgimg = [self coreImageFilteredImage:pixelBuffer];
+  frame.output = (void*)cgimg;
+  return cgimg != NULL;
+}
+
+// Étape affichage : Metal, AVSampleBufferDisplayLayer, ou calque CGImage (Core Image)
+- (BOOL)presentFrame:(Camera::PipelineFrame&)frame {
+  if (CFGetTypeID((CFTypeRef)frame.output) == CGImageGetTypeID()) {
+    id contents = (__bridge id)frame.output;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      self.filteredLayer.frame = self.bounds;
+      self.filteredLayer.contents = contents;
+      self.filteredLayer.opacity = 1.0;
+      self.usingFilteredPreview = YES;
+    });
+    return YES;
+  }
+
+  CVPixelBufferRef outputBuffer = (CVPixelBufferRef)frame.output;
+  // Chemin Metal prioritaire si disponible (zéro création de sample buffer)
+  if (self.metalDevice && self.metalLayer && self.ciMetalContext && self.metalQueue) {
+    id<CAMetalDrawable> drawable = [self.metalLayer nextDrawable];
+    if (!drawable) return NO;
+    CIImage* filteredImage = [CIImage imageWithCVPixelBuffer:outputBuffer];
+    if (!filteredImage) return NO;
+    CGRect extent = filteredImage.extent;
+    id<MTLCommandBuffer> cb = [self.metalQueue commandBuffer];
+    static CGColorSpaceRef sRGB = NULL;
+    if (!sRGB) { sRGB = CGColorSpaceCreateDeviceRGB(); }
+    [self.ciMetalContext render:filteredImage
+                    toMTLTexture:drawable.texture
+                   commandBuffer:cb
+                         bounds:extent
+                      colorSpace:sRGB];
+    [cb presentDrawable:drawable];
+    [cb commit];
+    dispatch_async(dispatch_get_main_queue(), ^{
+      self.filteredLayer.opacity = 0.0;
+      if (self.displayLayer) { [self.displayLayer flushAndRemoveImage]; self.displayLayer.hidden = YES; }
+      self.metalLayer.hidden = NO;
+      self.usingFilteredPreview = YES;
+    });
+    return YES;
+  }
+
+  // Fallback: AVSampleBufferDisplayLayer
+  CMVideoFormatDescriptionRef fmtDesc = NULL;
+  OSStatus fr = CMVideoFormatDescriptionCreateForImageBuffer(kCFAllocatorDefault, outputBuffer, &fmtDesc);
+  if (fr != noErr || !fmtDesc) return NO;
+  CMSampleTimingInfo timing = kCMTimingInfoInvalid;
+  timing.presentationTimeStamp = CMSampleBufferGetPresentationTimeStamp((CMSampleBufferRef)frame.image);
+  CMSampleBufferRef dispSample = NULL;
+  OSStatus cr = CMSampleBufferCreateReadyWithImageBuffer(kCFAllocatorDefault, outputBuffer, fmtDesc, &timing, &dispSample);
+  CFRelease(fmtDesc);
+  if (cr != noErr || !dispSample) return NO;
+  CFArrayRef attachments = CMSampleBufferGetSampleAttachmentsArray(dispSample, YES);
+  if (attachments && CFArrayGetCount(attachments) > 0) {
+    CFMutableDictionaryRef dict = (CFMutableDictionaryRef)CFArrayGetValueAtIndex(attachments, 0);
+    CFDictionarySetValue(dict, kCMSampleAttachmentKey_DisplayImmediately, kCFBooleanTrue);
+  }
+  dispatch_async(dispatch_get_main_queue(), ^{
+    self.filteredLayer.opacity = 0.0;
+    self.displayLayer.hidden = NO;
+    [self.displayLayer enqueueSampleBuffer:dispSample];
+    self.usingFilteredPreview = YES;
+    CFRelease(dispSample);
+  });
+  return YES;
+}
 
+// Filtre (passe native ou FFmpeg) dans un buffer du pool de l'aperçu; NULL si indisponible ou en échec.
+// FFmpeg : une copie de la sortie du graphe vers ce buffer (voir NaayaCreateFilterOutputBuffer).
+- (CVPixelBufferRef)ffmpegFilteredBuffer:(CVImageBufferRef)pixelBuffer CF_RETURNS_RETAINED {
+  CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+  size_t width = CVPixelBufferGetWidth(pixelBuffer);
+  size_t height = CVPixelBufferGetHeight(pixelBuffer);
+  size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
+  uint8_t* baseAddress = (uint8_t*)CVPixelBufferGetBaseAddress(pixelBuffer);
+  CVPixelBufferRef outputBuffer = baseAddress ? NaayaCreateFilterOutputBuffer(0, width, height) : NULL;
+  BOOL processed = NO;
+  if (outputBuffer) {
+    CVPixelBufferLockBaseAddress(outputBuffer, 0);
+    uint8_t* outBase = (uint8_t*)CVPixelBufferGetBaseAddress(outputBuffer);
+    size_t outStride = CVPixelBufferGetBytesPerRow(outputBuffer);
+    // 30 fps par défaut pour l'aperçu
+    processed = NaayaFilters_ProcessBGRA(baseAddress, (int)bytesPerRow,
+                                         (int)width, (int)height, 30.0,
+                                         outBase, (int)outStride);
+    CVPixelBufferUnlockBaseAddress(outputBuffer, 0);
+  }
+  CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+  if (!processed && outputBuffer) {
+    CVPixelBufferRelease(outputBuffer);
+    outputBuffer = NULL;
+  }
+  return outputBuffer;
+}
+
+// Fallback Core Image (FFmpeg non disponible ou échec) : rendu vers CGImage (naïf)
+- (CGImageRef)coreImageFilteredImage:(CVImageBufferRef)pixelBuffer CF_RETURNS_RETAINED {
   const char* cname = NaayaFilters_GetCurrentName();
   double intensity = NaayaFilters_GetCurrentIntensity();
   NSString* name = cname ? [NSString stringWithUTF8String:cname] : @"";
@@ -166,114 +344,8 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
     }
   }
 
-  CVImageBufferRef pixelBuffer = CMSampleBufferGetImageBuffer(sampleBuffer);
-  if (!pixelBuffer) return;
-  
-  // === Tentative de traitement via FFmpeg en priorité ===
-  BOOL ffmpegProcessed = NO;
-  
-  // Verrouiller le pixel buffer pour accès direct
-  CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
-  
-  size_t width = CVPixelBufferGetWidth(pixelBuffer);
-  size_t height = CVPixelBufferGetHeight(pixelBuffer);
-  size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
-  uint8_t* baseAddress = (uint8_t*)CVPixelBufferGetBaseAddress(pixelBuffer);
-  
-  if (baseAddress) {
-    // Créer un pixel buffer de sortie
-    CVPixelBufferRef outputBuffer = NULL;
-    NSDictionary* attrs = @{
-      (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
-      (NSString*)kCVPixelBufferWidthKey: @(width),
-      (NSString*)kCVPixelBufferHeightKey: @(height),
-      (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{}
-    };
-    
-    CVReturn status = CVPixelBufferCreate(kCFAllocatorDefault,
-                                          width, height,
-                                          kCVPixelFormatType_32BGRA,
-                                          (__bridge CFDictionaryRef)attrs,
-                                          &outputBuffer);
-    
-    if (status == kCVReturnSuccess && outputBuffer) {
-      CVPixelBufferLockBaseAddress(outputBuffer, 0);
-      uint8_t* outBase = (uint8_t*)CVPixelBufferGetBaseAddress(outputBuffer);
-      size_t outStride = CVPixelBufferGetBytesPerRow(outputBuffer);
-      
-      // Essayer FFmpeg (30 fps par défaut pour preview)
-      ffmpegProcessed = NaayaFilters_ProcessBGRA(baseAddress, (int)bytesPerRow,
-                                                 (int)width, (int)height, 30.0,
-                                                 outBase, (int)outStride);
-      
-      CVPixelBufferUnlockBaseAddress(outputBuffer, 0);
-      
-      if (ffmpegProcessed) {
-        // Chemin Metal prioritaire si disponible (zéro création de sample buffer)
-        if (self.metalDevice && self.metalLayer && self.ciMetalContext && self.metalQueue) {
-          id<CAMetalDrawable> drawable = [self.metalLayer nextDrawable];
-          if (drawable) {
-            CIImage* filteredImage = [CIImage imageWithCVPixelBuffer:outputBuffer];
-            if (filteredImage) {
-              CGRect extent = filteredImage.extent;
-              id<MTLCommandBuffer> cb = [self.metalQueue commandBuffer];
-              static CGColorSpaceRef sRGB = NULL;
-              if (!sRGB) { sRGB = CGColorSpaceCreateDeviceRGB(); }
-              [self.ciMetalContext render:filteredImage
-                              toMTLTexture:drawable.texture
-                             commandBuffer:cb
-                                   bounds:extent
-                                colorSpace:sRGB];
-              [cb presentDrawable:drawable];
-              [cb commit];
-              dispatch_async(dispatch_get_main_queue(), ^{
-                self.filteredLayer.opacity = 0.0;
-                if (self.displayLayer) { [self.displayLayer flushAndRemoveImage]; self.displayLayer.hidden = YES; }
-                self.metalLayer.hidden = NO;
-                self.usingFilteredPreview = YES;
-              });
-            }
-          }
-        } else {
-          // Fallback: AVSampleBufferDisplayLayer
-          CMVideoFormatDescriptionRef fmtDesc = NULL;
-          OSStatus fr = CMVideoFormatDescriptionCreateForImageBuffer(kCFAllocatorDefault, outputBuffer, &fmtDesc);
-          if (fr == noErr && fmtDesc) {
-            CMSampleTimingInfo timing = kCMTimingInfoInvalid;
-            timing.presentationTimeStamp = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
-            CMSampleBufferRef dispSample = NULL;
-            OSStatus cr = CMSampleBufferCreateReadyWithImageBuffer(kCFAllocatorDefault, outputBuffer, fmtDesc, &timing, &dispSample);
-            if (cr == noErr && dispSample) {
-              CFArrayRef attachments = CMSampleBufferGetSampleAttachmentsArray(dispSample, YES);
-              if (attachments && CFArrayGetCount(attachments) > 0) {
-                CFMutableDictionaryRef dict = (CFMutableDictionaryRef)CFArrayGetValueAtIndex(attachments, 0);
-                CFDictionarySetValue(dict, kCMSampleAttachmentKey_DisplayImmediately, kCFBooleanTrue);
-              }
-              dispatch_async(dispatch_get_main_queue(), ^{
-                self.filteredLayer.opacity = 0.0;
-                self.displayLayer.hidden = NO;
-                [self.displayLayer enqueueSampleBuffer:dispSample];
-                self.usingFilteredPreview = YES;
-              });
-              CFRelease(dispSample);
-            }
-            CFRelease(fmtDesc);
-          }
-        }
-        CVPixelBufferRelease(outputBuffer);
-        CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
-        return;
-      }
-      
-      CVPixelBufferRelease(outputBuffer);
-    }
-  }
-  
-  CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
-  
-  // === Fallback vers Core Image si FFmpeg non disponible ou échec ===
   CIImage* inputImage = [CIImage imageWithCVPixelBuffer:pixelBuffer];
-  if (!inputImage) return;
+  if (!inputImage) return NULL;
 
   CIImage* outputImage = inputImage;
 
@@ -406,21 +478,8 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
     }
   }
 
-  // Rendu vers CGImage (naïf) puis CALayer
-  CGRect extent = inputImage.extent;
-  CGImageRef cgimg = [self.ciContext createCGImage:outputImage fromRect:extent];
-  if (!cgimg) return;
-  id contents = (__bridge id)cgimg;
-  dispatch_async(dispatch_get_main_queue(), ^{
-    self.filteredLayer.frame = self.bounds;
-    self.filteredLayer.contents = contents;
-    self.filteredLayer.opacity = 1.0;
-    self.usingFilteredPreview = YES;
-  });
-  CGImageRelease(cgimg);
+  return [self.ciContext createCGImage:outputImage fromRect:inputImage.extent];
 }
 
 @end
 #endif
-
-
@@ -9,6 +9,7 @@
 #include "VideoCaptureIOS.h"
 #import "CameraSessionBridge.h"
 #include <math.h>
+#include <algorithm>
 #include <chrono>
 #include "../../shared/Audio/core/AudioEqualizer.h"
 #include <vector>
@@ -16,12 +17,20 @@
 #include "../../shared/Audio/safety/AudioSafety.h"
 #include "../../shared/Audio/noise/NoiseReducer.h"
 #include "../../shared/Audio/noise/RNNoiseSuppressor.h"
+#include "../../shared/Audio/noise/SpectralNR.h"
+#include "../../shared/Audio/safety/CpuGovernor.h"
 #ifndef FFMPEG_AVAILABLE
 #define FFMPEG_AVAILABLE 1
 #endif
 #include "../../shared/Audio/effects/EffectChain.h"
 #include "../../shared/Audio/effects/Compressor.h"
 #include "../../shared/Audio/effects/Delay.h"
+#include "../../shared/Audio/effects/Saturation.h"
+#include "../../shared/Audio/utils/RealtimeScope.h"
+#include "../../shared/Audio/utils/AudioProfiler.h"
+#include "../../shared/Audio/utils/AudioBuffer.h"
+#include "../../shared/Audio/utils/CompensationDelay.h"
+#include "../../shared/Camera/pipeline/FramePipeline.hpp"
 
 // API C filtres exposée par le runtime C++
 #ifdef __cplusplus
@@ -38,6 +47,9 @@ bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
                               double fps,
                               uint8_t* outData,
                               int outStride);
+// LUT 3D (.cube) via le parseur natif et son cache binaire
+void NaayaFilters_SetLUTCacheDirectory(const char* directory);
+bool NaayaFilters_LoadLUTRGBA(const char* path, float* outRGBA, size_t capacity, int* outSize);
 // Paramètres avancés (exposés par le module C)
 typedef struct {
   double brightness;
@@ -62,6 +74,7 @@ size_t NaayaEQ_CopyBandGains(double* out, size_t maxCount);
 size_t NaayaEQ_GetNumBands(void);
 bool NaayaEQ_HasPendingUpdate(void);
 void NaayaEQ_ClearPendingUpdate(void);
+double NaayaEQ_ConsumeMorphMs(void);
 bool NaayaNR_IsEnabled(void);
 bool NaayaNR_HasPendingUpdate(void);
 void NaayaNR_ClearPendingUpdate(void);
@@ -92,6 +105,11 @@ void NaayaFX_GetCompressor(double* thresholdDb,
 void NaayaFX_GetDelay(double* delayMs,
                       double* feedback,
                       double* mix);
+void NaayaFX_GetSaturation(bool* enabled,
+                           int* type,
+                           double* driveDb,
+                           double* mix,
+                           double* outputDb);
 // Safety report updater (globally exposed by TurboModule)
 void NaayaSafety_UpdateReport(double peak,
                               double rms,
@@ -99,6 +117,23 @@ void NaayaSafety_UpdateReport(double peak,
                               uint32_t clippedSamples,
                               double feedbackScore,
                               bool overload);
+void NaayaSafety_UpdateLoudness(double momentaryLufs,
+                                double shortTermLufs,
+                                double integratedLufs,
+                                double loudnessRange,
+                                double truePeakDbtp);
+bool NaayaSafety_ConsumeLoudnessReset(void);
+void NaayaSafety_UpdateGovernor(int qualityTier,
+                                uint32_t tierChanges,
+                                double cpuLoad,
+                                uint32_t deadlineMisses);
+bool NaayaSafety_IsGovernorEnabled(void);
+// Enregistrement de la sortie traitée
+void NaayaRecord_SetStreamFormat(uint32_t sampleRate, int numChannels);
+void NaayaRecord_PushPlanar(const float* const* channels, int numChannels, size_t frames);
+// Latence de la chaîne (échantillons par étage) et budget du mode faible latence
+void NaayaLatency_Update(uint32_t sampleRate, size_t noiseReduction, size_t effects, size_t safety, size_t equalizer);
+size_t NaayaLatency_GetBudgetSamples(uint32_t sampleRate);
 #pragma clang diagnostic pop
 #ifdef __cplusplus
 }
@@ -236,16 +271,22 @@ didFinishRecordingToOutputFileAtURL:(NSURL *)outputFileURL
   std::unique_ptr<AudioNR::RNNoiseSuppressor> _rnns;
   std::unique_ptr<AudioSafety::AudioSafetyEngine> _safety;
   std::unique_ptr<AudioFX::EffectChain> _fx;
-  // Tampons audio réutilisés (éviter allocations par frame)
-  std::vector<float> _bufMono;
-  std::vector<float> _tmpMono;
-  std::vector<float> _outMono;
-  std::vector<float> _left;
-  std::vector<float> _right;
-  std::vector<float> _tmpLeft;
-  std::vector<float> _tmpRight;
-  std::vector<float> _outLeft;
-  std::vector<float> _outRight;
+  // Effets de _fx, construits avec la chaîne et mis à jour en place
+  AudioFX::SaturationEffect* _sat;
+  AudioFX::CompressorEffect* _comp;
+  AudioFX::DelayEffect* _del;
+  // Gouverneur CPU + NR spectrale (palier intermédiaire entre RNNoise et l'expander)
+  std::unique_ptr<AudioSafety::CpuGovernor> _governor;
+  std::unique_ptr<AudioNR::SpectralNR> _snrL;
+  std::unique_ptr<AudioNR::SpectralNR> _snrR;
+  // Compensation NR : un retard par moteur (index NoiseEngine) pour l'aligner sur le plus lent
+  AudioSafety::NoiseEngineLatency _nrLatency;
+  std::vector<AudioEqualizer::CompensationDelay> _nrAlignL;
+  std::vector<AudioEqualizer::CompensationDelay> _nrAlignR;
+  // Tampons de travail stéréo alignés (entrée, ping-pong, sortie, fondu NR), réutilisés
+  std::unique_ptr<AudioEqualizer::AudioBufferPool> _scratch;
+  // Filtre et encodage vidéo hors du callback AVFoundation
+  std::unique_ptr<Camera::FramePipeline> _videoPipeline;
 }
 @property(nonatomic, assign) AVCaptureSession* session; // éviter weak sous MRC
 @property(nonatomic, strong) NSURL* outputURL;
@@ -482,6 +523,9 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
     }
   }
 
+  if (![self setupVideoPipeline]) {
+    return NO;
+  }
   self.configured = NO; // démarrera à la première frame avec le PTS
   self.recording = YES;
   return YES;
@@ -495,6 +539,12 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
     [self.session commitConfiguration];
     self.videoOutput = nil;
   }
+  // Plus de soumission (callback en cours terminé), puis images en vol filtrées et encodées
+  if (self.videoQueue) dispatch_sync(self.videoQueue, ^{});
+  if (_videoPipeline) {
+    _videoPipeline->stop(true);
+    _videoPipeline.reset();
+  }
   if (self.audioOutput && self.session) {
     [self.session beginConfiguration];
     [self.session removeOutput:self.audioOutput];
@@ -515,198 +565,359 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
   }
 }
 
-- (void)captureOutput:(AVCaptureOutput *)output didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer fromConnection:(AVCaptureConnection *)connection {
-  (void)output; (void)connection;
-  if (!self.recording || !self.writer) return;
+- (void)dealloc {
+  // Enregistrement non arrêté : plus de callback de capture, images en vol rendues
+  [self.videoOutput setSampleBufferDelegate:nil queue:NULL];
+  if (self.videoQueue) dispatch_sync(self.videoQueue, ^{});
+  if (_videoPipeline) _videoPipeline->stop(false);
+}
 
-  // Différencier flux vidéo / audio
-  if (output == self.videoOutput) {
-    CVImageBufferRef pb = CMSampleBufferGetImageBuffer(sampleBuffer);
+// Paramètres FX du module appliqués aux effets existants : ni reconstruction ni allocation
+// sur le thread audio
+- (void)applyFxParams {
+  _fx->setEnabled(NaayaFX_IsEnabled());
+  bool sEn; int sTy; double sDr, sMx, sOut; NaayaFX_GetSaturation(&sEn, &sTy, &sDr, &sMx, &sOut);
+  _sat->setParameters(static_cast<AudioFX::SaturationType>(sTy), sDr, sMx, sOut);
+  _sat->setEnabled(sEn);
+  double th, ra, at, rl, mk; NaayaFX_GetCompressor(&th, &ra, &at, &rl, &mk);
+  _comp->setParameters(th, ra, at, rl, mk);
+  double dm, fb, mx; NaayaFX_GetDelay(&dm, &fb, &mx);
+  _del->setParameters(dm, fb, mx);
+}
 
-  size_t width = CVPixelBufferGetWidth(pb);
-  size_t height = CVPixelBufferGetHeight(pb);
-  
-  // === Traitement FFmpeg pour l'enregistrement ===
-  BOOL ffmpegProcessed = NO;
-  CVImageBufferRef processedBuffer = pb; // par défaut, utiliser l'original
-  
-  // Vérifier s'il y a un filtre actif
-  extern bool NaayaFilters_HasFilter();
-  if (NaayaFilters_HasFilter()) {
-    CVPixelBufferLockBaseAddress(pb, kCVPixelBufferLock_ReadOnly);
-    
-    uint8_t* baseAddress = (uint8_t*)CVPixelBufferGetBaseAddress(pb);
-    size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pb);
-    
-    if (baseAddress) {
-      // Créer buffer de sortie pour FFmpeg
-      CVPixelBufferRef outputBuffer = NULL;
-      NSDictionary* attrs = @{
-        (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
-        (NSString*)kCVPixelBufferWidthKey: @(width),
-        (NSString*)kCVPixelBufferHeightKey: @(height),
-        (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{}
-      };
-      
-      CVReturn status = CVPixelBufferCreate(kCFAllocatorDefault,
-                                            width, height,
-                                            kCVPixelFormatType_32BGRA,
-                                            (__bridge CFDictionaryRef)attrs,
-                                            &outputBuffer);
-      
-      if (status == kCVReturnSuccess && outputBuffer) {
-        CVPixelBufferLockBaseAddress(outputBuffer, 0);
-        uint8_t* outBase = (uint8_t*)CVPixelBufferGetBaseAddress(outputBuffer);
-        size_t outStride = CVPixelBufferGetBytesPerRow(outputBuffer);
-        
-        // Traitement FFmpeg (fps basé sur la config d'enregistrement)
-        double fps = 30.0; // TODO: récupérer fps depuis la config
-        ffmpegProcessed = NaayaFilters_ProcessBGRA(baseAddress, (int)bytesPerRow,
-                                                   (int)width, (int)height, fps,
-                                                   outBase, (int)outStride);
-        
-        CVPixelBufferUnlockBaseAddress(outputBuffer, 0);
-        
-        if (ffmpegProcessed) {
-          processedBuffer = outputBuffer; // utiliser le buffer traité
-        } else {
-          CVPixelBufferRelease(outputBuffer); // libérer si échec
+// ===== Gouverneur CPU (thread audio) =====
+
+- (AudioSafety::NoiseEngine)requestedNoiseEngine {
+  AudioSafety::NoiseEngine engine = AudioSafety::NoiseEngine::Off;
+  if (NaayaNR_GetMode() == 1 && _rnns && _rnns->isAvailable()) engine = AudioSafety::NoiseEngine::RNNoise;
+  else if (_nr) engine = AudioSafety::NoiseEngine::Expander;
+  // Mode faible latence : moteur le plus riche tenant dans le budget
+  return AudioSafety::CpuGovernor::noiseEngineWithinBudget(engine, NaayaLatency_GetBudgetSamples((uint32_t)self.eqSampleRate), _nrLatency);
+}
+
+// Retard de la chaîne pour le moteur demandé; publié pour le rapport JS et l'enregistreur
+- (size_t)updateLatencyForEngine:(AudioSafety::NoiseEngine)requested {
+  const size_t nr = AudioSafety::CpuGovernor::noiseChainLatency(requested, _nrLatency);
+  for (size_t e = 0; e < _nrAlignL.size(); ++e) {
+    const size_t own = _nrLatency.of((AudioSafety::NoiseEngine)e);
+    _nrAlignL[e].setDelay(nr > own ? nr - own : 0);
+    _nrAlignR[e].setDelay(nr > own ? nr - own : 0);
+  }
+  const size_t fx = (_fx && _fx->isEnabled()) ? _fx->getLatencySamples() : 0;
+  const size_t safety = _safety ? _safety->getLatencySamples() : 0;
+  const size_t eq = _eq->getLatencySamples();
+  NaayaLatency_Update((uint32_t)self.eqSampleRate, nr, fx, safety, eq);
+  return nr + fx + safety + eq;
+}
+
+// Sortie traitée en retard de latencyFrames : horodatage avancé d'autant (alignement vidéo)
+- (void)appendProcessedAudio:(CMSampleBufferRef)sampleBuffer latencyFrames:(size_t)latencyFrames sampleRate:(double)sr {
+  CMSampleTimingInfo timing[4];
+  CMItemCount count = 0;
+  if (latencyFrames == 0 || CMSampleBufferGetSampleTimingInfoArray(sampleBuffer, 4, timing, &count) != noErr || count == 0) {
+    [self.audioInput appendSampleBuffer:sampleBuffer];
+    return;
+  }
+  const CMTime shift = CMTimeMake((int64_t)latencyFrames, (int32_t)lrint(sr));
+  for (CMItemCount i = 0; i < count; ++i) {
+    timing[i].presentationTimeStamp = CMTimeSubtract(timing[i].presentationTimeStamp, shift);
+    if (CMTIME_IS_VALID(timing[i].decodeTimeStamp)) timing[i].decodeTimeStamp = CMTimeSubtract(timing[i].decodeTimeStamp, shift);
+  }
+  CMSampleBufferRef shifted = NULL;
+  if (CMSampleBufferCreateCopyWithNewTiming(kCFAllocatorDefault, sampleBuffer, count, timing, &shifted) == noErr && shifted) {
+    [self.audioInput appendSampleBuffer:shifted];
+    CFRelease(shifted);
+  } else {
+    [self.audioInput appendSampleBuffer:sampleBuffer];
+  }
+}
+
+// inR/outR nuls : mono; sortie complétée au retard commun des moteurs
+- (void)runNoiseEngine:(AudioSafety::NoiseEngine)engine inL:(const float*)inL inR:(const float*)inR outL:(float*)outL outR:(float*)outR frames:(size_t)n {
+  [self processNoiseEngine:engine inL:inL inR:inR outL:outL outR:outR frames:n];
+  const size_t e = (size_t)engine;
+  if (e < _nrAlignL.size()) {
+    _nrAlignL[e].process(outL, outL, n);
+    if (outR) _nrAlignR[e].process(outR, outR, n);
+  }
+}
+
+- (void)processNoiseEngine:(AudioSafety::NoiseEngine)engine inL:(const float*)inL inR:(const float*)inR outL:(float*)outL outR:(float*)outR frames:(size_t)n {
+  switch (engine) {
+    case AudioSafety::NoiseEngine::RNNoise:
+      _rnns->setAggressiveness(NaayaRNNS_GetAggressiveness());
+      if (inR) _rnns->processStereo(inL, inR, outL, outR, n); else _rnns->processMono(inL, outL, n);
+      return;
+    case AudioSafety::NoiseEngine::Spectral:
+      if (_snrL) {
+        _snrL->process(inL, outL, n);
+        if (inR) _snrR->process(inR, outR, n);
+        return;
+      }
+      break;
+    case AudioSafety::NoiseEngine::Expander:
+      if (_nr) {
+        if (NaayaNR_HasPendingUpdate()) {
+          AudioNR::NoiseReducerConfig cfg; bool hpE; double hpHz, thDb, ratio, flDb, aMs, rMs;
+          NaayaNR_GetConfig(&hpE, &hpHz, &thDb, &ratio, &flDb, &aMs, &rMs);
+          cfg.enabled = NaayaNR_IsEnabled(); cfg.enableHighPass = hpE; cfg.highPassHz = hpHz; cfg.thresholdDb = thDb; cfg.ratio = ratio; cfg.floorDb = flDb; cfg.attackMs = aMs; cfg.releaseMs = rMs; _nr->setConfig(cfg);
+          NaayaNR_ClearPendingUpdate();
         }
+        if (inR) _nr->processStereo(inL, inR, outL, outR, n); else _nr->processMono(inL, outL, n);
+        return;
       }
+      break;
+    case AudioSafety::NoiseEngine::Off:
+      break;
+  }
+  std::copy(inL, inL + n, outL);
+  if (inR) std::copy(inR, inR + n, outR);
+}
+
+- (void)beginGovernorBuffer {
+  if (!_governor) return;
+  bool enabled = NaayaSafety_IsGovernorEnabled();
+  if (enabled != _governor->getConfig().enabled) {
+    AudioSafety::GovernorConfig cfg = _governor->getConfig(); cfg.enabled = enabled; _governor->setConfig(cfg);
+  }
+  if (_eq) _eq->setBandLimit(AudioSafety::CpuGovernor::eqBandLimitFor(_governor->tier(), _eq->getNumBands()));
+  _governor->beginBuffer();
+}
+
+- (void)endGovernorBuffer:(size_t)frames {
+  if (!_governor) return;
+  uint32_t changesBefore = _governor->tierChanges();
+  AudioSafety::QualityTier tier = _governor->endBuffer(frames);
+  if (_governor->tierChanges() != changesBefore) {
+    // Le moteur entrant reprend du silence plutôt que des trames périmées
+    if (tier == AudioSafety::QualityTier::Reduced) {
+      if (_snrL) _snrL->reset();
+      if (_snrR) _snrR->reset();
     }
-    
-    CVPixelBufferUnlockBaseAddress(pb, kCVPixelBufferLock_ReadOnly);
+    if (tier == AudioSafety::QualityTier::Full && _rnns) _rnns->reset();
+    const size_t e = (size_t)AudioSafety::CpuGovernor::noiseEngineFor(tier, [self requestedNoiseEngine]);
+    if (e < _nrAlignL.size()) { _nrAlignL[e].reset(); _nrAlignR[e].reset(); }
   }
+  NaayaSafety_UpdateGovernor((int)tier, _governor->tierChanges(), _governor->smoothedLoad(), _governor->deadlineMisses());
+}
+
+// ===== Pipeline vidéo de l'enregistrement =====
+
+// Filtre puis encodage sur leurs threads, trois images en vol. Block : le callback de capture
+// attend une place quand l'encodeur est en retard, aucune image n'est perdue en silence; refus
+// au-delà de deux périodes pour ne pas caler la file de capture.
+- (BOOL)setupVideoPipeline {
+  Camera::FramePipelineConfig config;
+  config.name = "enregistrement";
+  config.depth = 3;
+  config.policy = Camera::FrameDropPolicy::Block;
+  config.blockTimeoutMs = std::max(10, 2000 / std::max(1, self.targetFPS));
+  _videoPipeline = std::make_unique<Camera::FramePipeline>(config);
+  // Non retenu : pipeline vidé dans stopWithCompletion, arrêté au plus tard dans dealloc.
+  // Threads d'étape hors GCD : un pool d'autorelease par image.
+  __unsafe_unretained NaayaFilteredVideoRecorder* recorder = self;
+  _videoPipeline->addStage("filtre", [recorder](Camera::PipelineFrame& frame) -> bool {
+    @autoreleasepool { return [recorder filterFrame:frame]; }
+  });
+  _videoPipeline->addStage("encodage", [recorder](Camera::PipelineFrame& frame) -> bool {
+    @autoreleasepool { return [recorder appendFrame:frame]; }
+  });
+  _videoPipeline->setReleaseCallback([](Camera::PipelineFrame& frame, Camera::FrameOutcome) {
+    if (frame.output) CFRelease((CFTypeRef)frame.output);
+    if (frame.image) CFRelease((CFTypeRef)frame.image);
+  });
+  if (!_videoPipeline->start()) {
+    _videoPipeline.reset();
+    return NO;
+  }
+  return YES;
+}
+
+// Étape filtre : FFmpeg ou passe native, sinon Core Image, vers un buffer du pool de
+// l'enregistrement. Sans filtre applicable : sortie vide, l'image caméra est encodée telle quelle.
+- (BOOL)filterFrame:(Camera::PipelineFrame&)frame {
+  if (!NaayaFilters_HasFilter()) return YES;
+  CVImageBufferRef pb = CMSampleBufferGetImageBuffer((CMSampleBufferRef)frame.image);
+  if (!pb) return NO;
+  CVPixelBufferRef filtered = [self ffmpegFilteredBuffer:pb];
+  if (!filtered) filtered = [self coreImageFilteredBuffer:pb];
+  frame.output = filtered;
+  return YES;
+}
 
+// Étape encodage : session démarrée au PTS de la première image, rendu dans un buffer du pool de
+// l'adaptor puis ajout. Encodeur pas prêt : image sautée (issue Failed).
+- (BOOL)appendFrame:(Camera::PipelineFrame&)frame {
+  CMSampleBufferRef sampleBuffer = (CMSampleBufferRef)frame.image;
+  AVAssetWriter* writer = self.writer;
+  if (!writer) return NO;
+  CMTime ts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
   if (!self.configured) {
-    if ([self.writer status] == AVAssetWriterStatusUnknown) {
-      [self.writer startWriting];
-      CMTime ts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+    if ([writer status] == AVAssetWriterStatusUnknown) {
+      [writer startWriting];
       self.startTime = ts;
-      [self.writer startSessionAtSourceTime:ts];
+      [writer startSessionAtSourceTime:ts];
       self.configured = YES;
     }
   }
+  if (!self.videoInput || !self.videoInput.isReadyForMoreMediaData) return NO;
 
-  if (!self.videoInput || !self.videoInput.isReadyForMoreMediaData) {
-    return;
+  CVPixelBufferRef source = frame.output ? (CVPixelBufferRef)frame.output : CMSampleBufferGetImageBuffer(sampleBuffer);
+  CIImage* image = [CIImage imageWithCVPixelBuffer:source];
+  if (!image) return NO;
+  CVPixelBufferRef outPb = NULL;
+  CVReturn cr = kCVReturnError;
+  if (self.adaptor && self.adaptor.pixelBufferPool) {
+    cr = CVPixelBufferPoolCreatePixelBuffer(NULL, self.adaptor.pixelBufferPool, &outPb);
+  }
+  if (cr != kCVReturnSuccess || !outPb) return NO;
+  [self.ciContext render:image toCVPixelBuffer:outPb bounds:CGRectMake(0, 0, CVPixelBufferGetWidth(source), CVPixelBufferGetHeight(source)) colorSpace:nil];
+  BOOL appended = [self.adaptor appendPixelBuffer:outPb withPresentationTime:ts];
+  CVPixelBufferRelease(outPb);
+  return appended;
+}
+
+// FFmpeg ou passe native dans un buffer du pool de l'enregistrement; NULL si indisponible ou en échec
+- (CVPixelBufferRef)ffmpegFilteredBuffer:(CVImageBufferRef)pb CF_RETURNS_RETAINED {
+  CVPixelBufferLockBaseAddress(pb, kCVPixelBufferLock_ReadOnly);
+  size_t width = CVPixelBufferGetWidth(pb);
+  size_t height = CVPixelBufferGetHeight(pb);
+  size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pb);
+  uint8_t* baseAddress = (uint8_t*)CVPixelBufferGetBaseAddress(pb);
+  CVPixelBufferRef outputBuffer = baseAddress ? NaayaCreateFilterOutputBuffer(1, width, height) : NULL;
+  BOOL processed = NO;
+  if (outputBuffer) {
+    CVPixelBufferLockBaseAddress(outputBuffer, 0);
+    uint8_t* outBase = (uint8_t*)CVPixelBufferGetBaseAddress(outputBuffer);
+    size_t outStride = CVPixelBufferGetBytesPerRow(outputBuffer);
+    processed = NaayaFilters_ProcessBGRA(baseAddress, (int)bytesPerRow,
+                                         (int)width, (int)height, (double)self.targetFPS,
+                                         outBase, (int)outStride);
+    CVPixelBufferUnlockBaseAddress(outputBuffer, 0);
+  }
+  CVPixelBufferUnlockBaseAddress(pb, kCVPixelBufferLock_ReadOnly);
+  if (!processed && outputBuffer) {
+    CVPixelBufferRelease(outputBuffer);
+    outputBuffer = NULL;
   }
+  return outputBuffer;
+}
 
-  // Utiliser le buffer traité (FFmpeg si dispo, sinon original)
-  CIImage* inImg = [CIImage imageWithCVPixelBuffer:processedBuffer];
-  if (!inImg) return;
+// Fallback Core Image rendu dans un buffer du pool de l'enregistrement; NULL si aucun filtre
+// Core Image ne correspond
+- (CVPixelBufferRef)coreImageFilteredBuffer:(CVImageBufferRef)pb CF_RETURNS_RETAINED {
+  CIImage* inImg = [CIImage imageWithCVPixelBuffer:pb];
+  if (!inImg) return NULL;
+  CIImage* outImg = [self coreImageFilteredImage:inImg];
+  if (outImg == inImg) return NULL;
+  size_t width = CVPixelBufferGetWidth(pb);
+  size_t height = CVPixelBufferGetHeight(pb);
+  CVPixelBufferRef outputBuffer = NaayaCreateFilterOutputBuffer(1, width, height);
+  if (!outputBuffer) return NULL;
+  [self.ciContext render:outImg toCVPixelBuffer:outputBuffer bounds:CGRectMake(0, 0, width, height) colorSpace:nil];
+  return outputBuffer;
+}
+
+// Filtre courant en Core Image (graphe paresseux, rendu par l'appelant); inImg si aucun ne correspond
+- (CIImage*)coreImageFilteredImage:(CIImage*)inImg {
   CIImage* outImg = inImg;
-  
-  // Si FFmpeg n'a pas traité, appliquer Core Image en fallback
-  if (!ffmpegProcessed && NaayaFilters_HasFilter()) {
-    NSString* name = NaayaFilters_GetCurrentName() ? [NSString stringWithUTF8String:NaayaFilters_GetCurrentName()] : @"";
-    if ([name hasPrefix:@"lut3d:"]) {
-      NSRange qpos = [name rangeOfString:@"?"];
-      if (qpos.location != NSNotFound) {
-        name = [name substringToIndex:qpos.location];
-      }
+  NSString* name = NaayaFilters_GetCurrentName() ? [NSString stringWithUTF8String:NaayaFilters_GetCurrentName()] : @"";
+  if ([name hasPrefix:@"lut3d:"]) {
+    NSRange qpos = [name rangeOfString:@"?"];
+    if (qpos.location != NSNotFound) {
+      name = [name substringToIndex:qpos.location];
     }
-    double intensity = NaayaFilters_GetCurrentIntensity();
-    if ([name isEqualToString:@"sepia"]) {
-      CIFilter* f = [CIFilter filterWithName:@"CISepiaTone"];
-      [f setValue:inImg forKey:kCIInputImageKey];
-      [f setValue:@(MAX(0, MIN(1, intensity))) forKey:kCIInputIntensityKey];
-      outImg = f.outputImage ?: inImg;
-    } else if ([name isEqualToString:@"noir"]) {
-      CIFilter* f = [CIFilter filterWithName:@"CIPhotoEffectNoir"];
-      [f setValue:inImg forKey:kCIInputImageKey];
-      outImg = f.outputImage ?: inImg;
-    } else if ([name isEqualToString:@"monochrome"]) {
-      CIFilter* f = [CIFilter filterWithName:@"CIColorMonochrome"];
-      [f setValue:inImg forKey:kCIInputImageKey];
-      [f setValue:@(1.0) forKey:@"inputIntensity"];
-      outImg = f.outputImage ?: inImg;
-    } else if ([name isEqualToString:@"color_controls"]) {
-      NaayaAdvancedFilterParams adv; bool hasAdv = NaayaFilters_GetAdvancedParams(&adv);
-      if (hasAdv) {
-        CIImage* tmp = inImg;
-        {
-          CIFilter* c = [CIFilter filterWithName:@"CIColorControls"];
-          [c setValue:tmp forKey:kCIInputImageKey];
-          [c setValue:@(MAX(-1.0, MIN(1.0, adv.brightness))) forKey:@"inputBrightness"];
-          [c setValue:@(MAX(0.0, MIN(2.0, adv.contrast))) forKey:@"inputContrast"];
-          [c setValue:@(MAX(0.0, MIN(2.0, adv.saturation))) forKey:@"inputSaturation"];
-          tmp = c.outputImage ?: tmp;
-        }
-        if (fabs(adv.hue) > 0.01) { CIFilter* h = [CIFilter filterWithName:@"CIHueAdjust"]; [h setValue:tmp forKey:kCIInputImageKey]; double radians = adv.hue * M_PI / 180.0; [h setValue:@(radians) forKey:@"inputAngle"]; tmp = h.outputImage ?: tmp; }
-        if (fabs(adv.gamma - 1.0) > 0.01) { CIFilter* g = [CIFilter filterWithName:@"CIGammaAdjust"]; [g setValue:tmp forKey:kCIInputImageKey]; [g setValue:@(MAX(0.1, MIN(3.0, adv.gamma))) forKey:@"inputPower"]; tmp = g.outputImage ?: tmp; }
-        if (fabs(adv.exposure) > 0.01) { CIFilter* e = [CIFilter filterWithName:@"CIExposureAdjust"]; [e setValue:tmp forKey:kCIInputImageKey]; [e setValue:@(MAX(-2.0, MIN(2.0, adv.exposure))) forKey:@"inputEV"]; tmp = e.outputImage ?: tmp; }
-        if (fabs(adv.shadows) > 0.01 || fabs(adv.highlights) > 0.01) { CIFilter* sh = [CIFilter filterWithName:@"CIHighlightShadowAdjust"]; [sh setValue:tmp forKey:kCIInputImageKey]; double s = (adv.shadows + 1.0) / 2.0; double hl = (adv.highlights + 1.0) / 2.0; [sh setValue:@(MAX(0.0, MIN(1.0, s))) forKey:@"inputShadowAmount"]; [sh setValue:@(MAX(0.0, MIN(1.0, hl))) forKey:@"inputHighlightAmount"]; tmp = sh.outputImage ?: tmp; }
-        if (fabs(adv.warmth) > 0.01 || fabs(adv.tint) > 0.01) { CIFilter* tt = [CIFilter filterWithName:@"CITemperatureAndTint"]; [tt setValue:tmp forKey:kCIInputImageKey]; CGFloat temp = (CGFloat)(6500.0 + adv.warmth * 2000.0); CGFloat tint = (CGFloat)(adv.tint * 50.0); CIVector* neutral = [CIVector vectorWithX:temp Y:tint]; CIVector* target = [CIVector vectorWithX:6500 Y:0]; [tt setValue:neutral forKey:@"inputNeutral"]; [tt setValue:target forKey:@"inputTargetNeutral"]; tmp = tt.outputImage ?: tmp; }
-        if (adv.vignette > 0.01) { CIFilter* v = [CIFilter filterWithName:@"CIVignette"]; [v setValue:tmp forKey:kCIInputImageKey]; [v setValue:@(MIN(1.0, MAX(0.0, adv.vignette)) * 2.0) forKey:@"inputIntensity"]; [v setValue:@(1.0) forKey:@"inputRadius"]; tmp = v.outputImage ?: tmp; }
-        if (adv.grain > 0.01) { CGRect extent = inImg.extent; CIFilter* rnd = [CIFilter filterWithName:@"CIRandomGenerator"]; CIImage* noise = rnd.outputImage; if (noise) { noise = [noise imageByCroppingToRect:extent]; CIFilter* ctrl = [CIFilter filterWithName:@"CIColorControls"]; [ctrl setValue:noise forKey:kCIInputImageKey]; [ctrl setValue:@(0.0) forKey:@"inputSaturation"]; [ctrl setValue:@(0.0) forKey:@"inputBrightness"]; [ctrl setValue:@(1.0 + MIN(1.0, MAX(0.0, adv.grain)) * 0.5) forKey:@"inputContrast"]; noise = ctrl.outputImage ?: noise; CIFilter* blur = [CIFilter filterWithName:@"CIGaussianBlur"]; [blur setValue:noise forKey:kCIInputImageKey]; [blur setValue:@(0.5) forKey:@"inputRadius"]; noise = [blur.outputImage imageByCroppingToRect:extent] ?: noise; CIFilter* mat = [CIFilter filterWithName:@"CIColorMatrix"]; [mat setValue:noise forKey:kCIInputImageKey]; [mat setValue:[CIVector vectorWithX:1 Y:0 Z:0 W:0] forKey:@"inputRVector"]; [mat setValue:[CIVector vectorWithX:0 Y:1 Z:0 W:0] forKey:@"inputGVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:1 W:0] forKey:@"inputBVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:0 W:0] forKey:@"inputAVector"]; CGFloat alpha = (CGFloat)(MIN(1.0, MAX(0.0, adv.grain)) * 0.18); [mat setValue:[CIVector vectorWithX:0 Y:0 Z:0 W:alpha] forKey:@"inputBiasVector"]; CIImage* noiseA = mat.outputImage ?: noise; CIFilter* comp = [CIFilter filterWithName:@"CISourceOverCompositing"]; [comp setValue:noiseA forKey:kCIInputImageKey]; [comp setValue:tmp forKey:kCIInputBackgroundImageKey]; tmp = [comp.outputImage imageByCroppingToRect:extent] ?: tmp; } }
-        outImg = tmp;
-      } else {
-        CIFilter* f = [CIFilter filterWithName:@"CIColorControls"]; [f setValue:inImg forKey:kCIInputImageKey]; [f setValue:@(1.0) forKey:@"inputSaturation"]; [f setValue:@(intensity * 0.2) forKey:@"inputBrightness"]; [f setValue:@(1.0 + intensity * 0.5) forKey:@"inputContrast"]; outImg = f.outputImage ?: inImg;
+  }
+  double intensity = NaayaFilters_GetCurrentIntensity();
+  if ([name isEqualToString:@"sepia"]) {
+    CIFilter* f = [CIFilter filterWithName:@"CISepiaTone"];
+    [f setValue:inImg forKey:kCIInputImageKey];
+    [f setValue:@(MAX(0, MIN(1, intensity))) forKey:kCIInputIntensityKey];
+    outImg = f.outputImage ?: inImg;
+  } else if ([name isEqualToString:@"noir"]) {
+    CIFilter* f = [CIFilter filterWithName:@"CIPhotoEffectNoir"];
+    [f setValue:inImg forKey:kCIInputImageKey];
+    outImg = f.outputImage ?: inImg;
+  } else if ([name isEqualToString:@"monochrome"]) {
+    CIFilter* f = [CIFilter filterWithName:@"CIColorMonochrome"];
+    [f setValue:inImg forKey:kCIInputImageKey];
+    [f setValue:@(1.0) forKey:@"inputIntensity"];
+    outImg = f.outputImage ?: inImg;
+  } else if ([name isEqualToString:@"color_controls"]) {
+    NaayaAdvancedFilterParams adv; bool hasAdv = NaayaFilters_GetAdvancedParams(&adv);
+    if (hasAdv) {
+      CIImage* tmp = inImg;
+      {
+        CIFilter* c = [CIFilter filterWithName:@"CIColorControls"];
+        [c setValue:tmp forKey:kCIInputImageKey];
+        [c setValue:@(MAX(-1.0, MIN(1.0, adv.brightness))) forKey:@"inputBrightness"];
+        [c setValue:@(MAX(0.0, MIN(2.0, adv.contrast))) forKey:@"inputContrast"];
+        [c setValue:@(MAX(0.0, MIN(2.0, adv.saturation))) forKey:@"inputSaturation"];
+        tmp = c.outputImage ?: tmp;
       }
-    } else if ([name hasPrefix:@"lut3d:"]) {
-      static NSMutableDictionary<NSString*, NSData*>* sCubeCache = nil;
-      static NSMutableDictionary<NSString*, NSNumber*>* sCubeSizeCache = nil;
-      if (!sCubeCache) sCubeCache = [NSMutableDictionary new];
-      if (!sCubeSizeCache) sCubeSizeCache = [NSMutableDictionary new];
-      NSString* lutPath = [name substringFromIndex:6];
-      NSData* cubeData = sCubeCache[lutPath];
-      NSNumber* cubeSizeNum = sCubeSizeCache[lutPath];
-      if (!cubeData || !cubeSizeNum) {
-        int cubeSize = 0; NSError* err = nil; NSString* fileText = [NSString stringWithContentsOfFile:lutPath encoding:NSUTF8StringEncoding error:&err];
-        if (fileText && fileText.length > 0) {
-          NSArray<NSString*>* lines = [fileText componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]];
-          NSInteger lutSize = 0; NSMutableArray<NSNumber*>* values = [NSMutableArray arrayWithCapacity:1024];
-          for (NSString* raw in lines) {
-            NSString* line = [raw stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-            if (line.length == 0) continue;
-            if ([line hasPrefix:@"#"] || [line hasPrefix:@"TITLE"] || [line hasPrefix:@"DOMAIN_MIN"] || [line hasPrefix:@"DOMAIN_MAX"]) continue;
-            if ([line hasPrefix:@"LUT_3D_SIZE"]) {
-              NSArray* parts = [line componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
-              for (NSString* p in parts) { if (p.length == 0) continue; NSScanner* sc = [NSScanner scannerWithString:p]; NSInteger n = 0; if ([sc scanInteger:&n]) { lutSize = n; break; } }
-              continue;
-            }
-            NSArray* comps = [line componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
-            NSMutableArray<NSString*>* tokens = [NSMutableArray new];
-            for (NSString* c in comps) { if (c.length > 0) [tokens addObject:c]; }
-            if (tokens.count >= 3) {
-              double r = [tokens[0] doubleValue]; double g = [tokens[1] doubleValue]; double b = [tokens[2] doubleValue];
-              r = r < 0.0 ? 0.0 : (r > 1.0 ? 1.0 : r); g = g < 0.0 ? 0.0 : (g > 1.0 ? 1.0 : g); b = b < 0.0 ? 0.0 : (b > 1.0 ? 1.0 : b);
-              [values addObject:@(r)]; [values addObject:@(g)]; [values addObject:@(b)]; [values addObject:@(1.0)];
-            }
-          }
-          if (lutSize > 1) {
-            NSUInteger expected = (NSUInteger)lutSize * (NSUInteger)lutSize * (NSUInteger)lutSize * 4;
-            if (values.count >= expected) {
-              cubeSize = (int)lutSize; NSMutableData* data = [NSMutableData dataWithLength:expected * sizeof(float)]; float* ptr = (float*)data.mutableBytes; for (NSUInteger i = 0; i < expected; ++i) { ptr[i] = (float)values[i].doubleValue; } cubeData = data;
-            }
-          }
-        }
-        if (cubeData && cubeSize > 1) { sCubeCache[lutPath] = cubeData; sCubeSizeCache[lutPath] = @(cubeSize); cubeSizeNum = @(cubeSize); }
+      if (fabs(adv.hue) > 0.01) { CIFilter* h = [CIFilter filterWithName:@"CIHueAdjust"]; [h setValue:tmp forKey:kCIInputImageKey]; double radians = adv.hue * M_PI / 180.0; [h setValue:@(radians) forKey:@"inputAngle"]; tmp = h.outputImage ?: tmp; }
+      if (fabs(adv.gamma - 1.0) > 0.01) { CIFilter* g = [CIFilter filterWithName:@"CIGammaAdjust"]; [g setValue:tmp forKey:kCIInputImageKey]; [g setValue:@(MAX(0.1, MIN(3.0, adv.gamma))) forKey:@"inputPower"]; tmp = g.outputImage ?: tmp; }
+      if (fabs(adv.exposure) > 0.01) { CIFilter* e = [CIFilter filterWithName:@"CIExposureAdjust"]; [e setValue:tmp forKey:kCIInputImageKey]; [e setValue:@(MAX(-2.0, MIN(2.0, adv.exposure))) forKey:@"inputEV"]; tmp = e.outputImage ?: tmp; }
+      if (fabs(adv.shadows) > 0.01 || fabs(adv.highlights) > 0.01) { CIFilter* sh = [CIFilter filterWithName:@"CIHighlightShadowAdjust"]; [sh setValue:tmp forKey:kCIInputImageKey]; double s = (adv.shadows + 1.0) / 2.0; double hl = (adv.highlights + 1.0) / 2.0; [sh setValue:@(MAX(0.0, MIN(1.0, s))) forKey:@"inputShadowAmount"]; [sh setValue:@(MAX(0.0, MIN(1.0, hl))) forKey:@"inputHighlightAmount"]; tmp = sh.outputImage ?: tmp; }
+      if (fabs(adv.warmth) > 0.01 || fabs(adv.tint) > 0.01) { CIFilter* tt = [CIFilter filterWithName:@"CITemperatureAndTint"]; [tt setValue:tmp forKey:kCIInputImageKey]; CGFloat temp = (CGFloat)(6500.0 + adv.warmth * 2000.0); CGFloat tint = (CGFloat)(adv.tint * 50.0); CIVector* neutral = [CIVector vectorWithX:temp Y:tint]; CIVector* target = [CIVector vectorWithX:6500 Y:0]; [tt setValue:neutral forKey:@"inputNeutral"]; [tt setValue:target forKey:@"inputTargetNeutral"]; tmp = tt.outputImage ?: tmp; }
+      if (adv.vignette > 0.01) { CIFilter* v = [CIFilter filterWithName:@"CIVignette"]; [v setValue:tmp forKey:kCIInputImageKey]; [v setValue:@(MIN(1.0, MAX(0.0, adv.vignette)) * 2.0) forKey:@"inputIntensity"]; [v setValue:@(1.0) forKey:@"inputRadius"]; tmp = v.outputImage ?: tmp; }
+      if (adv.grain > 0.01) { CGRect extent = inImg.extent; CIFilter* rnd = [CIFilter filterWithName:@"CIRandomGenerator"]; CIImage* noise = rnd.outputImage; if (noise) { noise = [noise imageByCroppingToRect:extent]; CIFilter* ctrl = [CIFilter filterWithName:@"CIColorControls"]; [ctrl setValue:noise forKey:kCIInputImageKey]; [ctrl setValue:@(0.0) forKey:@"inputSaturation"]; [ctrl setValue:@(0.0) forKey:@"inputBrightness"]; [ctrl setValue:@(1.0 + MIN(1.0, MAX(0.0, adv.grain)) * 0.5) forKey:@"inputContrast"]; noise = ctrl.outputImage ?: noise; CIFilter* blur = [CIFilter filterWithName:@"CIGaussianBlur"]; [blur setValue:noise forKey:kCIInputImageKey]; [blur setValue:@(0.5) forKey:@"inputRadius"]; noise = [blur.outputImage imageByCroppingToRect:extent] ?: noise; CIFilter* mat = [CIFilter filterWithName:@"CIColorMatrix"]; [mat setValue:noise forKey:kCIInputImageKey]; [mat setValue:[CIVector vectorWithX:1 Y:0 Z:0 W:0] forKey:@"inputRVector"]; [mat setValue:[CIVector vectorWithX:0 Y:1 Z:0 W:0] forKey:@"inputGVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:1 W:0] forKey:@"inputBVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:0 W:0] forKey:@"inputAVector"]; CGFloat alpha = (CGFloat)(MIN(1.0, MAX(0.0, adv.grain)) * 0.18); [mat setValue:[CIVector vectorWithX:0 Y:0 Z:0 W:alpha] forKey:@"inputBiasVector"]; CIImage* noiseA = mat.outputImage ?: noise; CIFilter* comp = [CIFilter filterWithName:@"CISourceOverCompositing"]; [comp setValue:noiseA forKey:kCIInputImageKey]; [comp setValue:tmp forKey:kCIInputBackgroundImageKey]; tmp = [comp.outputImage imageByCroppingToRect:extent] ?: tmp; } }
+      outImg = tmp;
+    } else {
+      CIFilter* f = [CIFilter filterWithName:@"CIColorControls"]; [f setValue:inImg forKey:kCIInputImageKey]; [f setValue:@(1.0) forKey:@"inputSaturation"]; [f setValue:@(intensity * 0.2) forKey:@"inputBrightness"]; [f setValue:@(1.0 + intensity * 0.5) forKey:@"inputContrast"]; outImg = f.outputImage ?: inImg;
+    }
+  } else if ([name hasPrefix:@"lut3d:"]) {
+    static NSMutableDictionary<NSString*, NSData*>* sCubeCache = nil;
+    static NSMutableDictionary<NSString*, NSNumber*>* sCubeSizeCache = nil;
+    if (!sCubeCache) sCubeCache = [NSMutableDictionary new];
+    if (!sCubeSizeCache) sCubeSizeCache = [NSMutableDictionary new];
+    NSString* lutPath = [name substringFromIndex:6];
+    NSData* cubeData = sCubeCache[lutPath];
+    NSNumber* cubeSizeNum = sCubeSizeCache[lutPath];
+    if (!cubeData || !cubeSizeNum) {
+      static dispatch_once_t sLutCacheOnce;
+      dispatch_once(&sLutCacheOnce, ^{
+        NSString* caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        if (caches) NaayaFilters_SetLUTCacheDirectory(caches.fileSystemRepresentation);
+      });
+      int cubeSize = 0;
+      if (NaayaFilters_LoadLUTRGBA(lutPath.fileSystemRepresentation, NULL, 0, &cubeSize) && cubeSize > 1) {
+        size_t count = (size_t)cubeSize * (size_t)cubeSize * (size_t)cubeSize * 4;
+        NSMutableData* data = [NSMutableData dataWithLength:count * sizeof(float)];
+        if (NaayaFilters_LoadLUTRGBA(lutPath.fileSystemRepresentation, (float*)data.mutableBytes, count, &cubeSize)) cubeData = data;
       }
-      if (cubeData && cubeSizeNum) {
-        CIFilter* cube = [CIFilter filterWithName:@"CIColorCube"];
-        [cube setValue:inImg forKey:kCIInputImageKey];
-        [cube setValue:cubeData forKey:@"inputCubeData"];
-        [cube setValue:cubeSizeNum forKey:@"inputCubeDimension"];
-        CIImage* lutApplied = cube.outputImage ?: inImg; CGFloat mix = (CGFloat)MAX(0.0, MIN(1.0, intensity));
-        if (mix < 1.0 - 1e-3) {
-          CIFilter* mat = [CIFilter filterWithName:@"CIColorMatrix"]; [mat setValue:lutApplied forKey:kCIInputImageKey]; [mat setValue:[CIVector vectorWithX:1 Y:0 Z:0 W:0] forKey:@"inputRVector"]; [mat setValue:[CIVector vectorWithX:0 Y:1 Z:0 W:0] forKey:@"inputGVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:1 W:0] forKey:@"inputBVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:0 W:mix] forKey:@"inputAVector"]; CIImage* withAlpha = mat.outputImage ?: lutApplied; CIFilter* comp = [CIFilter filterWithName:@"CISourceOverCompositing"]; [comp setValue:withAlpha forKey:kCIInputImageKey]; [comp setValue:inImg forKey:kCIInputBackgroundImageKey]; outImg = [comp.outputImage imageByCroppingToRect:inImg.extent] ?: lutApplied;
-        } else { outImg = lutApplied; }
-      } else { outImg = inImg; }
+      if (cubeData && cubeSize > 1) { sCubeCache[lutPath] = cubeData; sCubeSizeCache[lutPath] = @(cubeSize); cubeSizeNum = @(cubeSize); }
     }
+    if (cubeData && cubeSizeNum) {
+      CIFilter* cube = [CIFilter filterWithName:@"CIColorCube"];
+      [cube setValue:inImg forKey:kCIInputImageKey];
+      [cube setValue:cubeData forKey:@"inputCubeData"];
+      [cube setValue:cubeSizeNum forKey:@"inputCubeDimension"];
+      CIImage* lutApplied = cube.outputImage ?: inImg; CGFloat mix = (CGFloat)MAX(0.0, MIN(1.0, intensity));
+      if (mix < 1.0 - 1e-3) {
+        CIFilter* mat = [CIFilter filterWithName:@"CIColorMatrix"]; [mat setValue:lutApplied forKey:kCIInputImageKey]; [mat setValue:[CIVector vectorWithX:1 Y:0 Z:0 W:0] forKey:@"inputRVector"]; [mat setValue:[CIVector vectorWithX:0 Y:1 Z:0 W:0] forKey:@"inputGVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:1 W:0] forKey:@"inputBVector"]; [mat setValue:[CIVector vectorWithX:0 Y:0 Z:0 W:mix] forKey:@"inputAVector"]; CIImage* withAlpha = mat.outputImage ?: lutApplied; CIFilter* comp = [CIFilter filterWithName:@"CISourceOverCompositing"]; [comp setValue:withAlpha forKey:kCIInputImageKey]; [comp setValue:inImg forKey:kCIInputBackgroundImageKey]; outImg = [comp.outputImage imageByCroppingToRect:inImg.extent] ?: lutApplied;
+      } else { outImg = lutApplied; }
+    } else { outImg = inImg; }
   }
+  return outImg;
+}
 
-  // Rendu vers pixel buffer de sortie
-  CVPixelBufferRef outPb = NULL;
-  if (!self.adaptor || !self.adaptor.pixelBufferPool) return;
-  CVReturn cr = CVPixelBufferPoolCreatePixelBuffer(NULL, self.adaptor.pixelBufferPool, &outPb);
-  if (cr != kCVReturnSuccess || !outPb) return;
-  [self.ciContext render:outImg toCVPixelBuffer:outPb bounds:CGRectMake(0, 0, width, height) colorSpace:nil];
-  CMTime ts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
-  [self.adaptor appendPixelBuffer:outPb withPresentationTime:ts];
-  CVPixelBufferRelease(outPb);
-  return;
+- (void)captureOutput:(AVCaptureOutput *)output didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer fromConnection:(AVCaptureConnection *)connection {
+  (void)output; (void)connection;
+  if (!self.recording || !self.writer) return;
+
+  // Différencier flux vidéo / audio
+  if (output == self.videoOutput) {
+    // Aucun traitement ici : filtre et encodage sur les étapes du pipeline d'enregistrement
+    if (!_videoPipeline || !CMSampleBufferGetImageBuffer(sampleBuffer)) return;
+    // Sample buffer retenu jusqu'au callback de libération du pipeline
+    CFRetain(sampleBuffer);
+    CMTime pts = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+    int64_t timestampNs = CMTIME_IS_VALID(pts) ? (int64_t)(CMTimeGetSeconds(pts) * 1e9) : 0;
+    if (!_videoPipeline->submit((void*)sampleBuffer, timestampNs)) {
+      CFRelease(sampleBuffer);
+    }
+    return;
   }
 
   // Audio
@@ -728,34 +939,48 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
       self.eqSampleRate = sr;
       self.eqChannels = channels;
       self.eqConfigured = YES;
+      NaayaRecord_SetStreamFormat((uint32_t)sr, channels);
       // Init NR moteur simple (expander + passe-haut)
       _nr = std::make_unique<AudioNR::NoiseReducer>((uint32_t)sr, channels);
       // Init RNNoise wrapper (squelette; actif lorsque vendorisé)
       _rnns = std::make_unique<AudioNR::RNNoiseSuppressor>();
       _rnns->initialize((uint32_t)sr, channels);
       _safety = std::make_unique<AudioSafety::AudioSafetyEngine>((uint32_t)sr, channels);
+      _governor = std::make_unique<AudioSafety::CpuGovernor>((uint32_t)sr);
+      {
+        // 512/128 : latence ~10 ms, proche de RNNoise pour des fondus sans effet de peigne marqué
+        AudioNR::SpectralNRConfig snrCfg; snrCfg.sampleRate = (uint32_t)sr; snrCfg.fftSize = 512; snrCfg.hopSize = 128; snrCfg.enabled = true;
+        _snrL = std::make_unique<AudioNR::SpectralNR>(snrCfg);
+        _snrR = std::make_unique<AudioNR::SpectralNR>(snrCfg);
+      }
+      _nrLatency.expander = _nr->getLatencySamples();
+      _nrLatency.spectral = _snrL->getLatencySamples();
+      _nrLatency.rnnoise = _rnns->getLatencySamples();
+      {
+        const size_t maxNR = std::max({_nrLatency.expander, _nrLatency.spectral, _nrLatency.rnnoise});
+        _nrAlignL.assign(4, AudioEqualizer::CompensationDelay(maxNR));
+        _nrAlignR.assign(4, AudioEqualizer::CompensationDelay(maxNR));
+      }
+      // 4 tampons stéréo : entrée, ping-pong, sortie, fondu NR (agrandis au besoin)
+      _scratch = std::make_unique<AudioEqualizer::AudioBufferPool>(4, 2, 4096);
       // FX chain setup
       _fx = std::make_unique<AudioFX::EffectChain>();
-      _fx->setEnabled(NaayaFX_IsEnabled());
       _fx->setSampleRate((uint32_t)sr, channels);
-      {
-        auto* comp = _fx->emplaceEffect<AudioFX::CompressorEffect>();
-        auto* del = _fx->emplaceEffect<AudioFX::DelayEffect>();
-        comp->setEnabled(true); del->setEnabled(true);
-        double th, ra, at, rl, mk; NaayaFX_GetCompressor(&th, &ra, &at, &rl, &mk);
-        comp->setParameters(th, ra, at, rl, mk);
-        double dm, fb, mx; NaayaFX_GetDelay(&dm, &fb, &mx);
-        del->setParameters(dm, fb, mx);
-      }
+      _sat = _fx->emplaceEffect<AudioFX::SaturationEffect>();
+      _comp = _fx->emplaceEffect<AudioFX::CompressorEffect>();
+      _del = _fx->emplaceEffect<AudioFX::DelayEffect>();
+      _comp->setEnabled(true); _del->setEnabled(true);
+      [self applyFxParams];
       AudioNR::NoiseReducerConfig cfg; bool hpE; double hpHz, thDb, ratio, flDb, aMs, rMs;
       NaayaNR_GetConfig(&hpE, &hpHz, &thDb, &ratio, &flDb, &aMs, &rMs);
       cfg.enabled = NaayaNR_IsEnabled(); cfg.enableHighPass = hpE; cfg.highPassHz = hpHz; cfg.thresholdDb = thDb; cfg.ratio = ratio; cfg.floorDb = flDb; cfg.attackMs = aMs; cfg.releaseMs = rMs; _nr->setConfig(cfg);
       // Charger gains initiaux
       double gains[32] = {0};
       size_t nb = NaayaEQ_CopyBandGains(gains, 32);
-      _eq->beginParameterUpdate();
-      for (size_t i = 0; i < nb; ++i) { _eq->setBandGain(i, gains[i]); }
-      _eq->endParameterUpdate();
+      AudioEqualizer::EQPreset initial;
+      initial.gains.assign(gains, gains + nb);
+      _eq->loadPreset(initial);
+      NaayaEQ_ConsumeMorphMs();
       _eq->setMasterGain(NaayaEQ_GetMasterGainDB());
       _eq->setBypass(!NaayaEQ_IsEnabled());
     }
@@ -763,26 +988,18 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
     if (NaayaEQ_HasPendingUpdate()) {
       double gains[32] = {0};
       size_t nb = NaayaEQ_CopyBandGains(gains, 32);
-      _eq->beginParameterUpdate();
-      for (size_t i = 0; i < nb; ++i) { _eq->setBandGain(i, gains[i]); }
-      _eq->endParameterUpdate();
+      // Un seul verrou pour toutes les bandes; fondu si demandé (morphToPreset côté JS)
+      AudioEqualizer::EQPreset target;
+      target.gains.assign(gains, gains + nb);
+      const double morphMs = NaayaEQ_ConsumeMorphMs();
+      if (morphMs > 0.0) { _eq->morphToPreset(target, morphMs); }
+      else { _eq->loadPreset(target); }
       _eq->setMasterGain(NaayaEQ_GetMasterGainDB());
       _eq->setBypass(!NaayaEQ_IsEnabled());
       NaayaEQ_ClearPendingUpdate();
     }
     if (NaayaFX_HasPendingUpdate()) {
-      if (_fx) {
-        _fx->setEnabled(NaayaFX_IsEnabled());
-        _fx->setSampleRate((uint32_t)sr, channels);
-        _fx->clear();
-        auto* comp = _fx->emplaceEffect<AudioFX::CompressorEffect>();
-        auto* del = _fx->emplaceEffect<AudioFX::DelayEffect>();
-        comp->setEnabled(true); del->setEnabled(true);
-        double th, ra, at, rl, mk; NaayaFX_GetCompressor(&th, &ra, &at, &rl, &mk);
-        comp->setParameters(th, ra, at, rl, mk);
-        double dm, fb, mx; NaayaFX_GetDelay(&dm, &fb, &mx);
-        del->setParameters(dm, fb, mx);
-      }
+      if (_fx) [self applyFxParams];
       NaayaFX_ClearPendingUpdate();
     }
 
@@ -795,6 +1012,12 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
     }
 
     size_t numFrames = (size_t)CMSampleBufferGetNumSamples(sampleBuffer);
+    // Buffer plus long que prévu : agrandit le pool avant la section temps réel (rare)
+    if (numFrames > _scratch->getMaxSamples()) _scratch->reserve(numFrames);
+    // FTZ/DAZ pendant la chaîne DSP (remplace les tests de dénormaux par échantillon)
+    AudioEqualizer::RealtimeScope rtScope;
+    AudioEqualizer::ProfileLap lap(numFrames, (uint32_t)asbd->mSampleRate);
+    [self beginGovernorBuffer];
     // Formats supportés: PCM S16 interleaved OU PCM float32 interleaved
     bool isPCM = (asbd->mFormatID == kAudioFormatLinearPCM);
     bool isInt16 = isPCM && asbd->mBitsPerChannel == 16;
@@ -809,32 +1032,33 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
 
     // Convertir → float, traiter, reconvertir selon format
     if (channels == 1) {
-      _bufMono.resize(numFrames);
+      auto work = _scratch->acquire(numFrames);
+      auto tmp = _scratch->acquire(numFrames);
+      auto out = _scratch->acquire(numFrames);
       if (isInt16) {
         int16_t* in16 = reinterpret_cast<int16_t*>(dataPtr);
-        for (size_t i = 0; i < numFrames; ++i) _bufMono[i] = (float)in16[i] / 32768.0f;
+        float* mono = work.getChannel(0);
+        for (size_t i = 0; i < numFrames; ++i) mono[i] = (float)in16[i] / 32768.0f;
       } else {
         float* inF = reinterpret_cast<float*>(dataPtr);
         // Copier tel quel dans tampon float
-        memcpy(_bufMono.data(), inF, numFrames * sizeof(float));
+        memcpy(work.getChannel(0), inF, numFrames * sizeof(float));
       }
-      // NR temps-réel (sélection): RNNoise si dispo+activé, sinon expander
-      bool useRNNS = (NaayaNR_GetMode() == 1);
-      if (useRNNS && _rnns && _rnns->isAvailable()) {
-        _tmpMono.resize(numFrames);
-        _rnns->setAggressiveness(NaayaRNNS_GetAggressiveness());
-        _rnns->processMono(_bufMono.data(), _tmpMono.data(), numFrames);
-        _bufMono.swap(_tmpMono);
-      } else if (_nr) {
-        if (NaayaNR_HasPendingUpdate()) {
-          AudioNR::NoiseReducerConfig cfg; bool hpE; double hpHz, thDb, ratio, flDb, aMs, rMs;
-          NaayaNR_GetConfig(&hpE, &hpHz, &thDb, &ratio, &flDb, &aMs, &rMs);
-          cfg.enabled = NaayaNR_IsEnabled(); cfg.enableHighPass = hpE; cfg.highPassHz = hpHz; cfg.thresholdDb = thDb; cfg.ratio = ratio; cfg.floorDb = flDb; cfg.attackMs = aMs; cfg.releaseMs = rMs; _nr->setConfig(cfg);
-          NaayaNR_ClearPendingUpdate();
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+      // NR temps-réel (sélection): RNNoise si dispo+activé, sinon expander; dégradé selon le palier CPU
+      AudioSafety::NoiseEngine requestedNR = [self requestedNoiseEngine];
+      const size_t latencyFrames = [self updateLatencyForEngine:requestedNR];
+      AudioSafety::NoiseEngine engineNR = AudioSafety::CpuGovernor::noiseEngineFor(_governor->tier(), requestedNR);
+      if (engineNR != AudioSafety::NoiseEngine::Off) {
+        [self runNoiseEngine:engineNR inL:work.getChannel(0) inR:nullptr outL:tmp.getChannel(0) outR:nullptr frames:numFrames];
+        AudioSafety::NoiseEngine previousNR = AudioSafety::CpuGovernor::noiseEngineFor(_governor->previousTier(), requestedNR);
+        if (_governor->crossfading() && previousNR != engineNR) {
+          auto xfade = _scratch->acquire(numFrames);
+          [self runNoiseEngine:previousNR inL:work.getChannel(0) inR:nullptr outL:xfade.getChannel(0) outR:nullptr frames:numFrames];
+          _governor->crossfadeMono(xfade.getChannel(0), tmp.getChannel(0), numFrames);
         }
-        _tmpMono.resize(numFrames);
-        _nr->processMono(_bufMono.data(), _tmpMono.data(), numFrames);
-        _bufMono.swap(_tmpMono);
+        std::swap(work, tmp);
+        lap.mark(engineNR == AudioSafety::NoiseEngine::RNNoise ? AudioEqualizer::ProfileStage::RNNoise : AudioEqualizer::ProfileStage::NoiseReducer);
       }
       // Spectre (optionnel)
       if (sNaayaSpectrumRunning) {
@@ -844,7 +1068,7 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
           static float realp[N]; static float imagp[N];
           size_t L = (numFrames < N ? numFrames : N);
           // Copier mono -> realp et zero-pad
-          memcpy(realp, _bufMono.data(), sizeof(float) * L);
+          memcpy(realp, work.getChannel(0), sizeof(float) * L);
           if (L < N) memset(realp + L, 0, sizeof(float) * (N - L));
           memset(imagp, 0, sizeof(float) * N);
           DSPSplitComplex split = { .realp = realp, .imagp = imagp };
@@ -874,67 +1098,78 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
             if (norm < 0.f) norm = 0.f; else if (norm > 1.f) norm = 1.f;
             sNaayaSpectrum[b] = norm;
           }
-        
+          lap.mark(AudioEqualizer::ProfileStage::Analysis);
       }
       // Effets créatifs (FX)
       if (_fx && _fx->isEnabled()) {
-        _tmpMono.resize(numFrames);
-        _fx->processMono(_bufMono.data(), _tmpMono.data(), numFrames);
-        _bufMono.swap(_tmpMono);
+        _fx->processMono(work.getChannel(0), tmp.getChannel(0), numFrames);
+        std::swap(work, tmp);
+        lap.mark(AudioEqualizer::ProfileStage::Effects);
       }
        // Sécurité audio (DC offset / limiter / validation)
        if (_safety) {
-        _safety->processMono(_bufMono.data(), numFrames);
+        if (NaayaSafety_ConsumeLoudnessReset()) _safety->resetLoudness();
+        _safety->processMono(work.getChannel(0), numFrames);
         auto rep = _safety->getLastReport();
         NaayaSafety_UpdateReport(rep.peak, rep.rms, rep.dcOffset, rep.clippedSamples, rep.feedbackScore, rep.overloadActive);
+        NaayaSafety_UpdateLoudness(rep.momentaryLufs, rep.shortTermLufs, rep.integratedLufs, rep.loudnessRange, rep.truePeakDbtp);
+        lap.mark(AudioEqualizer::ProfileStage::Safety);
        }
-       _outMono.resize(numFrames);
-      _eq->process(_bufMono.data(), _outMono.data(), numFrames);
+      _eq->process(work.getChannel(0), out.getChannel(0), numFrames);
+      lap.mark(AudioEqualizer::ProfileStage::Equalizer);
+      const float* outMono = out.getChannel(0);
+      NaayaRecord_PushPlanar(&outMono, 1, numFrames);
       if (isInt16) {
         int16_t* in16 = reinterpret_cast<int16_t*>(dataPtr);
         for (size_t i = 0; i < numFrames; ++i) {
-          float v = std::max(-1.0f, std::min(1.0f, _outMono[i]));
+          float v = std::max(-1.0f, std::min(1.0f, outMono[i]));
           in16[i] = (int16_t)lrintf(v * 32767.0f);
         }
       } else {
         float* inF = reinterpret_cast<float*>(dataPtr);
         for (size_t i = 0; i < numFrames; ++i) {
-          float v = std::max(-1.0f, std::min(1.0f, _outMono[i]));
+          float v = std::max(-1.0f, std::min(1.0f, outMono[i]));
           inF[i] = v;
         }
       }
-      [self.audioInput appendSampleBuffer:sampleBuffer];
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+      lap.finish();
+      [self endGovernorBuffer:numFrames];
+      [self appendProcessedAudio:sampleBuffer latencyFrames:latencyFrames sampleRate:sr];
     } else {
       // stéréo interleaved LR LR ...
-      _left.resize(numFrames); _right.resize(numFrames);
+      auto work = _scratch->acquire(numFrames);
+      auto tmp = _scratch->acquire(numFrames);
+      auto out = _scratch->acquire(numFrames);
+      float* inL = work.getChannel(0);
+      float* inR = work.getChannel(1);
       if (isInt16) {
         int16_t* in16 = reinterpret_cast<int16_t*>(dataPtr);
         for (size_t i = 0; i < numFrames; ++i) {
-          _left[i] = (float)in16[2*i] / 32768.0f;
-          _right[i] = (float)in16[2*i+1] / 32768.0f;
+          inL[i] = (float)in16[2*i] / 32768.0f;
+          inR[i] = (float)in16[2*i+1] / 32768.0f;
         }
       } else {
         float* inF = reinterpret_cast<float*>(dataPtr);
         for (size_t i = 0; i < numFrames; ++i) {
-          _left[i] = inF[2*i];
-          _right[i] = inF[2*i+1];
+          inL[i] = inF[2*i];
+          inR[i] = inF[2*i+1];
         }
       }
-      if (NaayaNR_GetMode() == 1 && _rnns && _rnns->isAvailable()) {
-        _tmpLeft.resize(numFrames); _tmpRight.resize(numFrames);
-        _rnns->setAggressiveness(NaayaRNNS_GetAggressiveness());
-        _rnns->processStereo(_left.data(), _right.data(), _tmpLeft.data(), _tmpRight.data(), numFrames);
-        _left.swap(_tmpLeft); _right.swap(_tmpRight);
-      } else if (_nr) {
-        if (NaayaNR_HasPendingUpdate()) {
-          AudioNR::NoiseReducerConfig cfg; bool hpE; double hpHz, thDb, ratio, flDb, aMs, rMs;
-          NaayaNR_GetConfig(&hpE, &hpHz, &thDb, &ratio, &flDb, &aMs, &rMs);
-          cfg.enabled = NaayaNR_IsEnabled(); cfg.enableHighPass = hpE; cfg.highPassHz = hpHz; cfg.thresholdDb = thDb; cfg.ratio = ratio; cfg.floorDb = flDb; cfg.attackMs = aMs; cfg.releaseMs = rMs; _nr->setConfig(cfg);
-          NaayaNR_ClearPendingUpdate();
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+      AudioSafety::NoiseEngine requestedNR = [self requestedNoiseEngine];
+      const size_t latencyFrames = [self updateLatencyForEngine:requestedNR];
+      AudioSafety::NoiseEngine engineNR = AudioSafety::CpuGovernor::noiseEngineFor(_governor->tier(), requestedNR);
+      if (engineNR != AudioSafety::NoiseEngine::Off) {
+        [self runNoiseEngine:engineNR inL:work.getChannel(0) inR:work.getChannel(1) outL:tmp.getChannel(0) outR:tmp.getChannel(1) frames:numFrames];
+        AudioSafety::NoiseEngine previousNR = AudioSafety::CpuGovernor::noiseEngineFor(_governor->previousTier(), requestedNR);
+        if (_governor->crossfading() && previousNR != engineNR) {
+          auto xfade = _scratch->acquire(numFrames);
+          [self runNoiseEngine:previousNR inL:work.getChannel(0) inR:work.getChannel(1) outL:xfade.getChannel(0) outR:xfade.getChannel(1) frames:numFrames];
+          _governor->crossfadeStereo(xfade.getChannel(0), xfade.getChannel(1), tmp.getChannel(0), tmp.getChannel(1), numFrames);
         }
-        _tmpLeft.resize(numFrames); _tmpRight.resize(numFrames);
-        _nr->processStereo(_left.data(), _right.data(), _tmpLeft.data(), _tmpRight.data(), numFrames);
-        _left.swap(_tmpLeft); _right.swap(_tmpRight);
+        std::swap(work, tmp);
+        lap.mark(engineNR == AudioSafety::NoiseEngine::RNNoise ? AudioEqualizer::ProfileStage::RNNoise : AudioEqualizer::ProfileStage::NoiseReducer);
       }
       // Spectre (optionnel)
       if (sNaayaSpectrumRunning) {
@@ -945,7 +1180,9 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
           // moyenne L/R
           static float monoBuf[N];
           size_t L = (numFrames < N ? numFrames : N);
-          for (size_t i = 0; i < L; ++i) monoBuf[i] = 0.5f * (_left[i] + _right[i]);
+          const float* mixL = work.getChannel(0);
+          const float* mixR = work.getChannel(1);
+          for (size_t i = 0; i < L; ++i) monoBuf[i] = 0.5f * (mixL[i] + mixR[i]);
           memcpy(realp, monoBuf, sizeof(float) * L);
           if (L < N) memset(realp + L, 0, sizeof(float) * (N - L));
           memset(imagp, 0, sizeof(float) * N);
@@ -973,39 +1210,50 @@ static CGAffineTransform NaayaTransformForOrientation(AVCaptureVideoOrientation
             if (norm < 0.f) norm = 0.f; else if (norm > 1.f) norm = 1.f;
             sNaayaSpectrum[b] = norm;
           }
+          lap.mark(AudioEqualizer::ProfileStage::Analysis);
       }
       // Effets créatifs (FX)
       if (_fx && _fx->isEnabled()) {
-        _tmpLeft.resize(numFrames); _tmpRight.resize(numFrames);
-        _fx->processStereo(_left.data(), _right.data(), _tmpLeft.data(), _tmpRight.data(), numFrames);
-        _left.swap(_tmpLeft); _right.swap(_tmpRight);
+        _fx->processStereo(work.getChannel(0), work.getChannel(1), tmp.getChannel(0), tmp.getChannel(1), numFrames);
+        std::swap(work, tmp);
+        lap.mark(AudioEqualizer::ProfileStage::Effects);
       }
        // Sécurité audio
        if (_safety) {
-        _safety->processStereo(_left.data(), _right.data(), numFrames);
+        if (NaayaSafety_ConsumeLoudnessReset()) _safety->resetLoudness();
+        _safety->processStereo(work.getChannel(0), work.getChannel(1), numFrames);
         auto repL = _safety->getLastReport();
         NaayaSafety_UpdateReport(repL.peak, repL.rms, repL.dcOffset, repL.clippedSamples, repL.feedbackScore, repL.overloadActive);
+        NaayaSafety_UpdateLoudness(repL.momentaryLufs, repL.shortTermLufs, repL.integratedLufs, repL.loudnessRange, repL.truePeakDbtp);
+        lap.mark(AudioEqualizer::ProfileStage::Safety);
        }
-       _outLeft.resize(numFrames); _outRight.resize(numFrames);
-      _eq->processStereo(_left.data(), _right.data(), _outLeft.data(), _outRight.data(), numFrames);
+      _eq->processStereo(work.getChannel(0), work.getChannel(1), out.getChannel(0), out.getChannel(1), numFrames);
+      lap.mark(AudioEqualizer::ProfileStage::Equalizer);
+      const float* outL = out.getChannel(0);
+      const float* outR = out.getChannel(1);
+      const float* rec[2] = {outL, outR};
+      NaayaRecord_PushPlanar(rec, 2, numFrames);
       if (isInt16) {
         int16_t* in16 = reinterpret_cast<int16_t*>(dataPtr);
         for (size_t i = 0; i < numFrames; ++i) {
-          float vl = std::max(-1.0f, std::min(1.0f, _outLeft[i]));
-          float vr = std::max(-1.0f, std::min(1.0f, _outRight[i]));
+          float vl = std::max(-1.0f, std::min(1.0f, outL[i]));
+          float vr = std::max(-1.0f, std::min(1.0f, outR[i]));
           in16[2*i]   = (int16_t)lrintf(vl * 32767.0f);
           in16[2*i+1] = (int16_t)lrintf(vr * 32767.0f);
         }
       } else {
         float* inF = reinterpret_cast<float*>(dataPtr);
         for (size_t i = 0; i < numFrames; ++i) {
-          float vl = std::max(-1.0f, std::min(1.0f, _outLeft[i]));
-          float vr = std::max(-1.0f, std::min(1.0f, _outRight[i]));
+          float vl = std::max(-1.0f, std::min(1.0f, outL[i]));
+          float vr = std::max(-1.0f, std::min(1.0f, outR[i]));
           inF[2*i]   = vl;
           inF[2*i+1] = vr;
         }
       }
-      [self.audioInput appendSampleBuffer:sampleBuffer];
+      lap.mark(AudioEqualizer::ProfileStage::Conversion);
+      lap.finish();
+      [self endGovernorBuffer:numFrames];
+      [self appendProcessedAudio:sampleBuffer latencyFrames:latencyFrames sampleRate:sr];
     }
   }
 }
@@ -5,6 +5,16 @@
 
 namespace AudioEqualizer {
 
+// Les bandes dynamiques recalculent leurs coefficients tous les 32 échantillons
+// (~0.7 ms à 48 kHz) : assez fin pour suivre une sibilante, sans coût par échantillon.
+constexpr size_t DYNAMIC_SUBBLOCK_SIZE = 32;
+
+// Fondu d'entrée/sortie des bandes écartées par setBandLimit()
+constexpr double BAND_LIMIT_FADE_MS = 20.0;
+
+// Pas de mise à jour des coefficients pendant un morphing de preset (~1.3 ms à 48 kHz)
+constexpr size_t MORPH_BLOCK_SIZE = 64;
+
 AudioEqualizer::AudioEqualizer(size_t numBands, uint32_t sampleRate)
     : m_sampleRate(sampleRate)
     , m_masterGain(1.0)
@@ -21,6 +31,8 @@ void AudioEqualizer::initialize(size_t numBands, uint32_t sampleRate) {
     m_sampleRate = sampleRate;
     m_bands.clear();
     m_bands.resize(numBands);
+    m_activeBands.clear();
+    m_activeBands.reserve(numBands);
     
     // Plus de buffer temporaire nécessaire (master gain appliqué in-place)
     
@@ -84,35 +96,302 @@ void AudioEqualizer::updateBandFilter(size_t bandIndex) {
     if (bandIndex >= m_bands.size()) return;
     
     EQBand& band = m_bands[bandIndex];
-    
-    switch (band.type) {
-        case FilterType::LOWPASS:
-            band.filter->calculateLowpass(band.frequency, m_sampleRate, band.q);
-            break;
-        case FilterType::HIGHPASS:
-            band.filter->calculateHighpass(band.frequency, m_sampleRate, band.q);
-            break;
-        case FilterType::BANDPASS:
-            band.filter->calculateBandpass(band.frequency, m_sampleRate, band.q);
-            break;
-        case FilterType::NOTCH:
-            band.filter->calculateNotch(band.frequency, m_sampleRate, band.q);
-            break;
-        case FilterType::PEAK:
-            band.filter->calculatePeaking(band.frequency, m_sampleRate, band.q, band.gain);
-            break;
-        case FilterType::LOWSHELF:
-            band.filter->calculateLowShelf(band.frequency, m_sampleRate, band.q, band.gain);
-            break;
-        case FilterType::HIGHSHELF:
-            band.filter->calculateHighShelf(band.frequency, m_sampleRate, band.q, band.gain);
-            break;
-        case FilterType::ALLPASS:
-            band.filter->calculateAllpass(band.frequency, m_sampleRate, band.q);
-            break;
+    const double gainDb = band.morphing ? currentMorphGain(band) : band.gain;
+    applyBandCoefficients(band, gainDb);
+
+    EQDynamicState& dyn = band.dynState;
+    bool wasActive = dyn.active;
+    bool gainType = band.type == FilterType::PEAK || band.type == FilterType::LOWSHELF ||
+                    band.type == FilterType::HIGHSHELF;
+
+    // cos/sin servent aussi au fondu des bandes écartées par la limite
+    double omega = TWO_PI * band.frequency / m_sampleRate;
+    dyn.cosOmega = std::cos(omega);
+    dyn.sinOmega = std::sin(omega);
+
+    dyn.active = band.dynamics.enabled && gainType && band.detector;
+    if (!dyn.active) return;
+
+    // Snapshot des paramètres : le thread audio ne lit plus band.dynamics ensuite
+    dyn.staticGainDb = gainDb;
+    dyn.q = band.q;
+    dyn.thresholdDb = band.dynamics.thresholdDb;
+    dyn.slope = 1.0 - 1.0 / band.dynamics.ratio;
+    dyn.rangeDb = band.dynamics.rangeDb;
+    dyn.attackCoeff = std::exp(-1.0 / (band.dynamics.attackMs * 0.001 * m_sampleRate));
+    dyn.releaseCoeff = std::exp(-1.0 / (band.dynamics.releaseMs * 0.001 * m_sampleRate));
+    dyn.appliedGainDb = gainDb;
+
+    // Sidechain: la bande elle-même (passe-bande pour PEAK, LP/HP pour les shelves)
+    if (band.type == FilterType::PEAK) {
+        band.detector->calculateBandpass(band.frequency, m_sampleRate, band.q);
+    } else if (band.type == FilterType::LOWSHELF) {
+        band.detector->calculateLowpass(band.frequency, m_sampleRate, DEFAULT_Q);
+    } else {
+        band.detector->calculateHighpass(band.frequency, m_sampleRate, DEFAULT_Q);
+    }
+
+    if (!wasActive) {
+        band.detector->reset();
+        dyn.envelope = 0.0;
+    }
+}
+
+void AudioEqualizer::applyBandCoefficients(EQBand& band, double gainDb) {
+    if (band.morphing && band.gainGrid.matches(band.type, band.frequency, band.q, m_sampleRate)) {
+        // Interpolation linéaire entre deux pas : le triangle de stabilité (b1, b2) étant
+        // convexe, le mélange de deux filtres stables reste stable
+        const auto& grid = band.gainGrid.coeffs;
+        const double pos = (std::max(MIN_GAIN_DB, std::min(MAX_GAIN_DB, gainDb)) - MIN_GAIN_DB) /
+                           EQGainGrid::kStepDb;
+        const size_t i0 = std::min(static_cast<size_t>(pos), grid.size() - 2);
+        const double t = pos - static_cast<double>(i0);
+        const BiquadCoefficients& c0 = grid[i0];
+        const BiquadCoefficients& c1 = grid[i0 + 1];
+        band.filter->setCoefficients(c0.a0 + t * (c1.a0 - c0.a0), c0.a1 + t * (c1.a1 - c0.a1),
+                                     c0.a2 + t * (c1.a2 - c0.a2), 1.0,
+                                     c0.b1 + t * (c1.b1 - c0.b1), c0.b2 + t * (c1.b2 - c0.b2));
+        return;
+    }
+    const BiquadCoefficients& c = m_coeffCache.get(band.type, band.frequency, band.q, gainDb,
+                                                   static_cast<double>(m_sampleRate));
+    band.filter->setCoefficients(c.a0, c.a1, c.a2, 1.0, c.b1, c.b2);
+}
+
+void AudioEqualizer::buildGainGrid(EQBand& band) {
+    if (band.gainGrid.matches(band.type, band.frequency, band.q, m_sampleRate)) return;
+    EQGainGrid& grid = band.gainGrid;
+    grid.type = band.type;
+    grid.frequency = band.frequency;
+    grid.q = band.q;
+    grid.sampleRate = m_sampleRate;
+    const size_t steps = static_cast<size_t>(std::lround((MAX_GAIN_DB - MIN_GAIN_DB) / EQGainGrid::kStepDb)) + 1;
+    grid.coeffs.resize(steps);
+    for (size_t i = 0; i < steps; ++i) {
+        grid.coeffs[i] = computeBiquadCoefficients(band.type, band.frequency, band.q,
+                                                   MIN_GAIN_DB + static_cast<double>(i) * EQGainGrid::kStepDb,
+                                                   static_cast<double>(m_sampleRate));
+    }
+}
+
+double AudioEqualizer::currentMorphGain(const EQBand& band) const {
+    const double t = m_morphLength > 0
+        ? static_cast<double>(m_morphPosition) / static_cast<double>(m_morphLength) : 1.0;
+    return band.morphFrom + (band.morphTo - band.morphFrom) * t;
+}
+
+void AudioEqualizer::startMorph(const EQPreset* from, const EQPreset& to, double durationMs) {
+    std::lock_guard<std::mutex> lock(m_parameterMutex);
+
+    const size_t numBands = std::min(to.gains.size(), m_bands.size());
+    bool any = false;
+    for (size_t i = 0; i < numBands; ++i) {
+        EQBand& band = m_bands[i];
+        const double current = band.morphing ? currentMorphGain(band) : band.gain;
+        const double start = (from && i < from->gains.size())
+            ? std::max(MIN_GAIN_DB, std::min(MAX_GAIN_DB, from->gains[i])) : current;
+        const double target = std::max(MIN_GAIN_DB, std::min(MAX_GAIN_DB, to.gains[i]));
+
+        band.gain = target;
+        // Sans gain (passe-haut, notch...) : rien à interpoler
+        band.morphing = durationMs > 0.0 && filterTypeUsesGain(band.type) &&
+                        std::abs(target - start) > 0.01;
+        if (band.morphing) {
+            band.morphFrom = start;
+            band.morphTo = target;
+            // Cible calculée ici (thread de contrôle) et insérée dans le cache : la fin du
+            // morphing sur le thread audio n'a plus de trigo à faire
+            band.morphTarget = m_coeffCache.get(band.type, band.frequency, band.q, target,
+                                                static_cast<double>(m_sampleRate));
+            buildGainGrid(band);
+            any = true;
+        }
+    }
+    for (size_t i = numBands; i < m_bands.size(); ++i) m_bands[i].morphing = false;
+
+    m_morphLength = static_cast<size_t>(std::max(0.0, durationMs) * 0.001 * m_sampleRate);
+    m_morphPosition = 0;
+    m_morphActive.store(any);
+    // updateFilters() applique le gain de départ des bandes en morphing
+    m_parametersChanged.store(true);
+}
+
+void AudioEqualizer::stepMorph(size_t numSamples) {
+    // Jamais d'attente sur le thread audio : pas sauté si l'UI tient le verrou
+    std::unique_lock<std::mutex> lock(m_parameterMutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+
+    m_morphPosition = std::min(m_morphLength, m_morphPosition + numSamples);
+    const bool done = m_morphPosition >= m_morphLength;
+    bool any = false;
+    for (size_t i = 0; i < m_bands.size(); ++i) {
+        EQBand& band = m_bands[i];
+        if (!band.morphing) continue;
+        if (done) {
+            // Coefficients exacts de la cible, précalculés par startMorph. Type, fréquence et Q
+            // n'ont pas changé (tout autre réglage interrompt le morphing).
+            band.morphing = false;
+            if (band.dynState.active) {
+                band.dynState.staticGainDb = band.morphTo;
+            } else {
+                const BiquadCoefficients& c = band.morphTarget;
+                band.filter->setCoefficients(c.a0, c.a1, c.a2, 1.0, c.b1, c.b2);
+            }
+            continue;
+        }
+        any = true;
+        const double gainDb = currentMorphGain(band);
+        if (band.dynState.active) {
+            band.dynState.staticGainDb = gainDb;   // la bande dynamique suit le fondu
+        } else {
+            applyBandCoefficients(band, gainDb);
+        }
+    }
+    if (!any) m_morphActive.store(false);
+}
+
+uint64_t AudioEqualizer::getCoefficientCacheMisses() const {
+    std::lock_guard<std::mutex> lock(m_parameterMutex);
+    return m_coeffCache.getMisses();
+}
+
+void AudioEqualizer::morphToPreset(const EQPreset& to, double durationMs) {
+    startMorph(nullptr, to, durationMs);
+}
+
+void AudioEqualizer::morphPresets(const EQPreset& from, const EQPreset& to, double durationMs) {
+    startMorph(&from, to, durationMs);
+}
+
+void AudioEqualizer::updateDynamicGain(EQBand& band) {
+    EQDynamicState& dyn = band.dynState;
+    double levelDb = 20.0 * std::log10(std::max(dyn.envelope, EPSILON));
+    double reduction = 0.0;
+    if (levelDb > dyn.thresholdDb) {
+        reduction = std::min(dyn.rangeDb, (levelDb - dyn.thresholdDb) * dyn.slope);
+    }
+    double targetDb = std::max(MIN_GAIN_DB, std::min(MAX_GAIN_DB, dyn.staticGainDb - reduction));
+
+    // Hystérésis 0.05 dB : pas de recalcul quand l'enveloppe est stable
+    if (std::abs(targetDb - dyn.appliedGainDb) < 0.05) return;
+
+    band.filter->updateGainFast(band.type, dyn.cosOmega, dyn.sinOmega, dyn.q, targetDb);
+    dyn.appliedGainDb = targetDb;
+}
+
+void AudioEqualizer::processDynamicBand(EQBand& band, float* data, size_t numSamples) {
+    EQDynamicState& dyn = band.dynState;
+    BiquadFilter& detector = *band.detector;
+
+    for (size_t offset = 0; offset < numSamples; offset += DYNAMIC_SUBBLOCK_SIZE) {
+        size_t n = std::min(DYNAMIC_SUBBLOCK_SIZE, numSamples - offset);
+        float* sub = data + offset;
+
+        double env = dyn.envelope;
+        for (size_t i = 0; i < n; ++i) {
+            double level = std::abs(static_cast<double>(detector.processSample(sub[i])));
+            double coeff = (level > env) ? dyn.attackCoeff : dyn.releaseCoeff;
+            env = level + coeff * (env - level);
+        }
+        dyn.envelope = env;
+
+        updateDynamicGain(band);
+        band.filter->process(sub, sub, n);
+    }
+}
+
+void AudioEqualizer::processDynamicBandStereo(EQBand& band, float* dataL, float* dataR,
+                                              size_t numSamples) {
+    EQDynamicState& dyn = band.dynState;
+    BiquadFilter& detector = *band.detector;
+
+    for (size_t offset = 0; offset < numSamples; offset += DYNAMIC_SUBBLOCK_SIZE) {
+        size_t n = std::min(DYNAMIC_SUBBLOCK_SIZE, numSamples - offset);
+        float* subL = dataL + offset;
+        float* subR = dataR + offset;
+
+        // Détection sur le mid : un seul sidechain pour les deux canaux (gain lié)
+        double env = dyn.envelope;
+        for (size_t i = 0; i < n; ++i) {
+            float mid = 0.5f * (subL[i] + subR[i]);
+            double level = std::abs(static_cast<double>(detector.processSample(mid)));
+            double coeff = (level > env) ? dyn.attackCoeff : dyn.releaseCoeff;
+            env = level + coeff * (env - level);
+        }
+        dyn.envelope = env;
+
+        updateDynamicGain(band);
+        band.filter->processStereo(subL, subR, subL, subR, n);
     }
 }
 
+void AudioEqualizer::advanceLimitFade(EQBand& band) {
+    const double step = static_cast<double>(DYNAMIC_SUBBLOCK_SIZE) /
+                        (BAND_LIMIT_FADE_MS * 0.001 * static_cast<double>(m_sampleRate));
+    if (band.limitKept) band.limitFade = std::min(1.0, band.limitFade + step);
+    else band.limitFade = std::max(0.0, band.limitFade - step);
+    band.filter->updateGainFast(band.type, band.dynState.cosOmega, band.dynState.sinOmega,
+                                band.q, band.gain * band.limitFade);
+}
+
+void AudioEqualizer::processFadingBand(EQBand& band, float* data, size_t numSamples) {
+    // Réintégration : état du filtre périmé, sans effet audible à gain 0 dB
+    if (band.limitKept && band.limitFade <= 0.0) band.filter->reset();
+    for (size_t offset = 0; offset < numSamples; offset += DYNAMIC_SUBBLOCK_SIZE) {
+        size_t n = std::min(DYNAMIC_SUBBLOCK_SIZE, numSamples - offset);
+        advanceLimitFade(band);
+        band.filter->process(data + offset, data + offset, n);
+    }
+}
+
+void AudioEqualizer::processFadingBandStereo(EQBand& band, float* dataL, float* dataR,
+                                             size_t numSamples) {
+    if (band.limitKept && band.limitFade <= 0.0) band.filter->reset();
+    for (size_t offset = 0; offset < numSamples; offset += DYNAMIC_SUBBLOCK_SIZE) {
+        size_t n = std::min(DYNAMIC_SUBBLOCK_SIZE, numSamples - offset);
+        advanceLimitFade(band);
+        band.filter->processStereo(dataL + offset, dataR + offset, dataL + offset, dataR + offset, n);
+    }
+}
+
+void AudioEqualizer::collectActiveBands() {
+    // Capacité réservée dans initialize() : aucune allocation sur le thread audio
+    m_activeBands.clear();
+    for (auto& band : m_bands) {
+        if (band.enabled && (std::abs(band.gain) > 0.01 || band.dynState.active || band.morphing)) {
+            m_activeBands.push_back(&band);
+        }
+    }
+    applyBandLimit();
+}
+
+void AudioEqualizer::applyBandLimit() {
+    const size_t limit = m_bandLimit.load(std::memory_order_relaxed);
+    if (limit == 0 || m_activeBands.size() <= limit) {
+        for (auto* band : m_activeBands) band->limitKept = true;
+        return;
+    }
+
+    // Bandes dynamiques et filtres sans gain (passe-haut, notch...) toujours conservés
+    auto significance = [](const EQBand* band) {
+        bool fadable = !band->dynState.active && !band->morphing &&
+                       (band->type == FilterType::PEAK || band->type == FilterType::LOWSHELF ||
+                        band->type == FilterType::HIGHSHELF);
+        return fadable ? std::abs(band->gain) : MAX_GAIN_DB * 2.0;
+    };
+    std::nth_element(m_activeBands.begin(), m_activeBands.begin() + static_cast<std::ptrdiff_t>(limit),
+                     m_activeBands.end(),
+                     [&](const EQBand* a, const EQBand* b) { return significance(a) > significance(b); });
+    for (size_t i = 0; i < m_activeBands.size(); ++i) {
+        m_activeBands[i]->limitKept = i < limit || significance(m_activeBands[i]) > MAX_GAIN_DB;
+    }
+
+    // Bandes complètement fondues : hors cascade
+    m_activeBands.erase(std::remove_if(m_activeBands.begin(), m_activeBands.end(),
+                                       [](const EQBand* band) { return !band->limitKept && band->limitFade <= 0.0; }),
+                        m_activeBands.end());
+}
+
 void AudioEqualizer::process(const float* input, float* output, size_t numSamples) {
     if (m_bypass.load()) {
         // Bypass mode - just copy input to output
@@ -127,24 +406,23 @@ void AudioEqualizer::process(const float* input, float* output, size_t numSample
 void AudioEqualizer::processOptimized(const float* input, float* output, size_t numSamples) {
     // Check if parameters have changed
     if (m_parametersChanged.load()) {
-        std::lock_guard<std::mutex> lock(m_parameterMutex);
-        updateFilters();
-        m_parametersChanged.store(false);
+        // Jamais d'attente sur le thread audio : si un batch UI tient le verrou,
+        // la mise à jour est reprise au buffer suivant
+        std::unique_lock<std::mutex> lock(m_parameterMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            updateFilters();
+            m_parametersChanged.store(false);
+        }
     }
     
     // Optimisation: traiter par blocs plus grands pour améliorer la localité du cache
     constexpr size_t OPTIMAL_BLOCK_SIZE = 1024;  // Augmenté pour meilleure efficacité cache
-    size_t blockSize = std::min(numSamples, OPTIMAL_BLOCK_SIZE);
+    size_t blockSize = std::min(numSamples, isMorphing() ? MORPH_BLOCK_SIZE : OPTIMAL_BLOCK_SIZE);
     size_t processedSamples = 0;
     
     // Pré-calculer les filtres actifs pour éviter les vérifications répétées
-    std::vector<const EQBand*> activeBands;
-    activeBands.reserve(m_bands.size());
-    for (const auto& band : m_bands) {
-        if (band.enabled && std::abs(band.gain) > 0.01) {
-            activeBands.push_back(&band);
-        }
-    }
+    collectActiveBands();
+    const std::vector<EQBand*>& activeBands = m_activeBands;
     
     // Si aucun filtre actif, appliquer seulement le gain master
     if (activeBands.empty()) {
@@ -197,6 +475,7 @@ void AudioEqualizer::processOptimized(const float* input, float* output, size_t
         size_t samplesToProcess = std::min(blockSize, numSamples - processedSamples);
         const float* blockInput = input + processedSamples;
         float* blockOutput = output + processedSamples;
+        if (isMorphing()) stepMorph(samplesToProcess);
         
         // Copier l'entrée vers la sortie pour le premier filtre
         if (blockOutput != blockInput) {
@@ -204,8 +483,14 @@ void AudioEqualizer::processOptimized(const float* input, float* output, size_t
         }
         
         // Appliquer chaque bande de filtre active
-        for (const auto* band : activeBands) {
-            band->filter->process(blockOutput, blockOutput, samplesToProcess);
+        for (auto* band : activeBands) {
+            if (band->dynState.active) {
+                processDynamicBand(*band, blockOutput, samplesToProcess);
+            } else if (!band->limitKept || band->limitFade < 1.0) {
+                processFadingBand(*band, blockOutput, samplesToProcess);
+            } else {
+                band->filter->process(blockOutput, blockOutput, samplesToProcess);
+            }
         }
         
         // Appliquer le gain master avec SIMD
@@ -276,24 +561,23 @@ void AudioEqualizer::processStereo(const float* inputL, const float* inputR,
     
     // Check if parameters have changed
     if (m_parametersChanged.load()) {
-        std::lock_guard<std::mutex> lock(m_parameterMutex);
-        updateFilters();
-        m_parametersChanged.store(false);
+        // Jamais d'attente sur le thread audio : si un batch UI tient le verrou,
+        // la mise à jour est reprise au buffer suivant
+        std::unique_lock<std::mutex> lock(m_parameterMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            updateFilters();
+            m_parametersChanged.store(false);
+        }
     }
     
     // Optimisation: traiter par blocs plus grands
     constexpr size_t OPTIMAL_BLOCK_SIZE = 1024;
-    size_t blockSize = std::min(numSamples, OPTIMAL_BLOCK_SIZE);
+    size_t blockSize = std::min(numSamples, isMorphing() ? MORPH_BLOCK_SIZE : OPTIMAL_BLOCK_SIZE);
     size_t processedSamples = 0;
     
     // Pré-calculer les filtres actifs
-    std::vector<const EQBand*> activeBands;
-    activeBands.reserve(m_bands.size());
-    for (const auto& band : m_bands) {
-        if (band.enabled && std::abs(band.gain) > 0.01) {
-            activeBands.push_back(&band);
-        }
-    }
+    collectActiveBands();
+    const std::vector<EQBand*>& activeBands = m_activeBands;
     
     while (processedSamples < numSamples) {
         size_t samplesToProcess = std::min(blockSize, numSamples - processedSamples);
@@ -301,6 +585,7 @@ void AudioEqualizer::processStereo(const float* inputL, const float* inputR,
         const float* blockInputR = inputR + processedSamples;
         float* blockOutputL = outputL + processedSamples;
         float* blockOutputR = outputR + processedSamples;
+        if (isMorphing()) stepMorph(samplesToProcess);
         
         // Copier l'entrée vers la sortie
         if (blockOutputL != blockInputL || blockOutputR != blockInputR) {
@@ -309,9 +594,15 @@ void AudioEqualizer::processStereo(const float* inputL, const float* inputR,
         }
         
         // Appliquer chaque bande de filtre active
-        for (const auto* band : activeBands) {
-            band->filter->processStereo(blockOutputL, blockOutputR,
-                                       blockOutputL, blockOutputR, samplesToProcess);
+        for (auto* band : activeBands) {
+            if (band->dynState.active) {
+                processDynamicBandStereo(*band, blockOutputL, blockOutputR, samplesToProcess);
+            } else if (!band->limitKept || band->limitFade < 1.0) {
+                processFadingBandStereo(*band, blockOutputL, blockOutputR, samplesToProcess);
+            } else {
+                band->filter->processStereo(blockOutputL, blockOutputR,
+                                           blockOutputL, blockOutputR, samplesToProcess);
+            }
         }
         
         // Appliquer le gain master avec SIMD pour les deux canaux
@@ -355,6 +646,7 @@ void AudioEqualizer::setBandGain(size_t bandIndex, double gainDB) {
     {
         std::lock_guard<std::mutex> lock(m_parameterMutex);
         m_bands[bandIndex].gain = gainDB;
+        m_bands[bandIndex].morphing = false;
         m_parametersChanged.store(true);
     }
 }
@@ -367,6 +659,7 @@ void AudioEqualizer::setBandFrequency(size_t bandIndex, double frequency) {
     {
         std::lock_guard<std::mutex> lock(m_parameterMutex);
         m_bands[bandIndex].frequency = frequency;
+        m_bands[bandIndex].morphing = false;
         m_parametersChanged.store(true);
     }
 }
@@ -379,6 +672,7 @@ void AudioEqualizer::setBandQ(size_t bandIndex, double q) {
     {
         std::lock_guard<std::mutex> lock(m_parameterMutex);
         m_bands[bandIndex].q = q;
+        m_bands[bandIndex].morphing = false;
         m_parametersChanged.store(true);
     }
 }
@@ -389,6 +683,7 @@ void AudioEqualizer::setBandType(size_t bandIndex, FilterType type) {
     {
         std::lock_guard<std::mutex> lock(m_parameterMutex);
         m_bands[bandIndex].type = type;
+        m_bands[bandIndex].morphing = false;
         m_parametersChanged.store(true);
     }
 }
@@ -402,6 +697,33 @@ void AudioEqualizer::setBandEnabled(size_t bandIndex, bool enabled) {
     }
 }
 
+void AudioEqualizer::setBandDynamics(size_t bandIndex, const EQDynamicParams& params) {
+    if (bandIndex >= m_bands.size()) return;
+
+    EQDynamicParams clamped = params;
+    clamped.thresholdDb = std::max(-96.0, std::min(0.0, params.thresholdDb));
+    clamped.ratio = std::max(1.0, std::min(20.0, params.ratio));
+    clamped.attackMs = std::max(0.1, std::min(500.0, params.attackMs));
+    clamped.releaseMs = std::max(1.0, std::min(5000.0, params.releaseMs));
+    clamped.rangeDb = std::max(0.0, std::min(MAX_GAIN_DB, params.rangeDb));
+
+    {
+        std::lock_guard<std::mutex> lock(m_parameterMutex);
+        EQBand& band = m_bands[bandIndex];
+        band.dynamics = clamped;
+        // Alloué hors thread audio; conservé ensuite même si la bande redevient statique
+        if (clamped.enabled && !band.detector) {
+            band.detector = std::make_unique<BiquadFilter>();
+        }
+        m_parametersChanged.store(true);
+    }
+}
+
+EQDynamicParams AudioEqualizer::getBandDynamics(size_t bandIndex) const {
+    std::lock_guard<std::mutex> lock(m_parameterMutex);
+    return (bandIndex < m_bands.size()) ? m_bands[bandIndex].dynamics : EQDynamicParams{};
+}
+
 // Get band parameters
 double AudioEqualizer::getBandGain(size_t bandIndex) const {
     std::lock_guard<std::mutex> lock(m_parameterMutex);
@@ -446,13 +768,50 @@ bool AudioEqualizer::isBypassed() const {
     return m_bypass.load();
 }
 
+// Frequency response
+void AudioEqualizer::getFrequencyResponse(const float* freqs, float* magDb, float* phase, size_t n) const {
+    if (n == 0 || !freqs || !magDb) return;
+    std::lock_guard<std::mutex> responseLock(m_responseMutex);
+
+    // Snapshot des cellules actives (mêmes critères que collectActiveBands, gain statique).
+    // Coefficients issus des paramètres (cache LRU) : ceux des filtres appartiennent au
+    // thread audio (bandes dynamiques et fondus les modifient sans verrou).
+    uint32_t sampleRate;
+    m_responseScratch.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_parameterMutex);
+        sampleRate = m_sampleRate;
+        for (const auto& band : m_bands) {
+            if (!band.enabled || (std::abs(band.gain) <= 0.01 && !band.dynamics.enabled)) continue;
+            m_responseScratch.push_back(m_coeffCache.get(band.type, band.frequency, band.q, band.gain,
+                                                         static_cast<double>(sampleRate)));
+        }
+    }
+
+    const bool gridChanged = m_response.setGrid(freqs, n, static_cast<double>(sampleRate));
+    if (gridChanged || !m_responseValid || m_responseScratch != m_responseSections) {
+        m_responseMagDb.resize(n);
+        m_responsePhase.resize(n);
+        m_response.evaluate(m_responseScratch.data(), m_responseScratch.size(), 0.0,
+                            m_responseMagDb.data(), m_responsePhase.data());
+        m_responseSections.swap(m_responseScratch);
+        m_responseValid = true;
+    }
+
+    // Gain master hors cache : un fader ne relance pas l'évaluation
+    const float masterDb = static_cast<float>(m_masterGain.load());
+    for (size_t i = 0; i < n; ++i) magDb[i] = m_responseMagDb[i] + masterDb;
+    if (phase) std::memcpy(phase, m_responsePhase.data(), n * sizeof(float));
+}
+
 // Preset management
 void AudioEqualizer::loadPreset(const EQPreset& preset) {
     std::lock_guard<std::mutex> lock(m_parameterMutex);
     
     size_t numBands = std::min(preset.gains.size(), m_bands.size());
     for (size_t i = 0; i < numBands; ++i) {
-        m_bands[i].gain = preset.gains[i];
+        m_bands[i].gain = std::max(MIN_GAIN_DB, std::min(MAX_GAIN_DB, preset.gains[i]));
+        m_bands[i].morphing = false;
     }
     
     m_parametersChanged.store(true);
@@ -474,6 +833,7 @@ void AudioEqualizer::resetAllBands() {
     
     for (auto& band : m_bands) {
         band.gain = 0.0;
+        band.morphing = false;
     }
     
     m_parametersChanged.store(true);
@@ -580,4 +940,16 @@ EQPreset EQPresetFactory::createLoudnessPreset() {
     return preset;
 }
 
+const EQPreset* EQPresetFactory::findPreset(const std::string& name) {
+    static const std::vector<EQPreset> presets = {
+        createFlatPreset(), createRockPreset(), createPopPreset(), createJazzPreset(),
+        createClassicalPreset(), createElectronicPreset(), createVocalBoostPreset(),
+        createBassBoostPreset(), createTrebleBoostPreset(), createLoudnessPreset()
+    };
+    for (const auto& preset : presets) {
+        if (preset.name == name) return &preset;
+    }
+    return nullptr;
+}
+
 } // namespace AudioEqualizer
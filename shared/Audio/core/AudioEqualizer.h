@@ -2,12 +2,15 @@
 
 #ifdef __cplusplus
 #include "BiquadFilter.h"
+#include "CoefficientCache.h"
+#include "FrequencyResponse.h"
 #include "../utils/Constants.h"
 #include <vector>
 #include <memory>
 #include <atomic>
 #include <mutex>
 #include <cstdint>
+#include <string>
 
 // SIMD optimizations
 #ifdef __AVX2__
@@ -18,6 +21,50 @@
 
 namespace AudioEqualizer {
 
+// Dynamic band parameters (de-essing, resonance taming)
+// Le gain de la bande suit l'enveloppe de sa propre bande (sidechain) :
+// au-dessus du seuil, le gain est réduit de (niveau - seuil) * (1 - 1/ratio), borné à rangeDb.
+struct EQDynamicParams {
+    bool enabled = false;
+    double thresholdDb = -24.0;
+    double ratio = 4.0;
+    double attackMs = 5.0;
+    double releaseMs = 80.0;
+    double rangeDb = 12.0;
+};
+
+// Runtime state of a dynamic band (audio thread only, snapshot taken in updateBandFilter)
+struct EQDynamicState {
+    bool active = false;
+    double staticGainDb = 0.0;
+    double q = DEFAULT_Q;
+    double thresholdDb = 0.0;
+    double slope = 0.0;          // 1 - 1/ratio
+    double rangeDb = 0.0;
+    double cosOmega = 1.0;
+    double sinOmega = 0.0;
+    double attackCoeff = 0.0;
+    double releaseCoeff = 0.0;
+    double envelope = 0.0;
+    double appliedGainDb = 0.0;
+};
+
+// Coefficients d'une bande échantillonnés en gain (type, fréquence, Q et fs fixés).
+// Le morphing interpole entre deux pas voisins au lieu de recalculer sin/cos/pow.
+struct EQGainGrid {
+    static constexpr double kStepDb = 0.25;
+
+    FilterType type = FilterType::PEAK;
+    double frequency = 0.0;
+    double q = 0.0;
+    uint32_t sampleRate = 0;
+    std::vector<BiquadCoefficients> coeffs;   // MIN_GAIN_DB .. MAX_GAIN_DB
+
+    bool matches(FilterType t, double f, double qq, uint32_t sr) const {
+        return !coeffs.empty() && type == t && frequency == f && q == qq && sampleRate == sr;
+    }
+};
+
 // Structure for a single EQ band
 struct EQBand {
     double frequency;
@@ -26,6 +73,22 @@ struct EQBand {
     FilterType type;
     std::unique_ptr<BiquadFilter> filter;
     bool enabled;
+
+    EQDynamicParams dynamics;
+    EQDynamicState dynState;
+    std::unique_ptr<BiquadFilter> detector;  // Sidechain, alloué à la première activation
+
+    // Limite de bandes (gouverneur CPU) : une bande écartée voit son gain fondu vers 0 dB
+    // avant d'être retirée de la cascade, et inversement à la réintégration
+    bool limitKept = true;
+    double limitFade = 1.0;
+
+    // Morphing de preset : gain interpolé de morphFrom à morphTo (gain = morphTo)
+    bool morphing = false;
+    double morphFrom = 0.0;
+    double morphTo = 0.0;
+    BiquadCoefficients morphTarget{};   // coefficients exacts de morphTo (calculés par startMorph)
+    EQGainGrid gainGrid;    // conservée d'un morphing à l'autre
     
     EQBand() : frequency(1000.0), gain(0.0), q(DEFAULT_Q), 
                type(FilterType::PEAK), enabled(true) {
@@ -58,6 +121,10 @@ public:
     void setBandQ(size_t bandIndex, double q);
     void setBandType(size_t bandIndex, FilterType type);
     void setBandEnabled(size_t bandIndex, bool enabled);
+
+    // Dynamic bands (PEAK, LOWSHELF, HIGHSHELF uniquement)
+    void setBandDynamics(size_t bandIndex, const EQDynamicParams& params);
+    EQDynamicParams getBandDynamics(size_t bandIndex) const;
     
     // Get band parameters
     double getBandGain(size_t bandIndex) const;
@@ -76,6 +143,14 @@ public:
     void loadPreset(const EQPreset& preset);
     void savePreset(EQPreset& preset) const;
     void resetAllBands();
+
+    // Morphing : gains interpolés (en dB) vers "to" en durationMs. Coefficients mis à jour
+    // toutes les 64 échantillons depuis la grille en gain de chaque bande, sans trigonométrie
+    // sur le thread audio. morphToPreset part des gains courants, y compris d'un morphing en
+    // cours. durationMs <= 0 : équivalent à loadPreset().
+    void morphToPreset(const EQPreset& to, double durationMs);
+    void morphPresets(const EQPreset& from, const EQPreset& to, double durationMs);
+    bool isMorphing() const { return m_morphActive.load(std::memory_order_relaxed); }
     
     // Sample rate
     void setSampleRate(uint32_t sampleRate);
@@ -83,6 +158,26 @@ public:
     
     // Get number of bands
     size_t getNumBands() const { return m_bands.size(); }
+
+    // Cascade de biquads (IIR) : retard de groupe selon la courbe, aucun retard de traitement
+    size_t getLatencySamples() const { return 0; }
+
+    // Réponse exacte de la courbe réglée (bandes actives + gain master) aux n fréquences
+    // freqs (Hz) : magDb en dB, phase en radians (optionnelle, nullptr). Hors bypass,
+    // dynamique et limite de bandes. Résultat en cache tant que réglages et grille sont
+    // inchangés. Thread UI uniquement (verrouille les paramètres).
+    void getFrequencyResponse(const float* freqs, float* magDb, float* phase, size_t n) const;
+
+    // Nombre maximal de bandes traitées (0 = toutes). Au-delà, seules les bandes les plus
+    // marquées (|gain|) sont conservées; les autres sont fondues en ~20 ms.
+    // Appelable depuis le thread audio.
+    void setBandLimit(size_t maxBands) { m_bandLimit.store(maxBands, std::memory_order_relaxed); }
+    size_t getBandLimit() const { return m_bandLimit.load(std::memory_order_relaxed); }
+    // Bandes traitées au dernier process(), fondus en cours compris. Thread audio.
+    size_t getProcessedBandCount() const { return m_activeBands.size(); }
+
+    // Coefficients calculés faute d'entrée en cache (diagnostic)
+    uint64_t getCoefficientCacheMisses() const;
     
     // Thread-safe parameter updates
     void beginParameterUpdate();
@@ -90,24 +185,56 @@ public:
 
 private:
     std::vector<EQBand> m_bands;
+    std::vector<EQBand*> m_activeBands;
     uint32_t m_sampleRate;
     
     // Master controls
     std::atomic<double> m_masterGain;
     std::atomic<bool> m_bypass;
+    std::atomic<size_t> m_bandLimit{0};
     
     // Thread safety
     mutable std::mutex m_parameterMutex;
     std::atomic<bool> m_parametersChanged;
     
+    // Coefficients statiques (sous m_parameterMutex)
+    mutable CoefficientCache m_coeffCache;
+
+    // Morphing de preset (sous m_parameterMutex)
+    std::atomic<bool> m_morphActive{false};
+    size_t m_morphLength = 0;      // échantillons
+    size_t m_morphPosition = 0;
+
+    // Cache de getFrequencyResponse() (verrou pris avant m_parameterMutex)
+    mutable std::mutex m_responseMutex;
+    mutable FrequencyResponse m_response;
+    mutable std::vector<BiquadCoefficients> m_responseSections;
+    mutable std::vector<BiquadCoefficients> m_responseScratch;
+    mutable std::vector<float> m_responseMagDb;    // sans gain master
+    mutable std::vector<float> m_responsePhase;
+    mutable bool m_responseValid = false;
+
     // Helper functions
     void updateFilters();
     void updateBandFilter(size_t bandIndex);
+    void applyBandCoefficients(EQBand& band, double gainDb);
+    void buildGainGrid(EQBand& band);
+    double currentMorphGain(const EQBand& band) const;
+    void startMorph(const EQPreset* from, const EQPreset& to, double durationMs);
+    void stepMorph(size_t numSamples);
     double dbToLinear(double db) const;
     double linearToDb(double linear) const;
     
     // Optimized processing paths
+    void collectActiveBands();
+    void applyBandLimit();
     void processOptimized(const float* input, float* output, size_t numSamples);
+    void processDynamicBand(EQBand& band, float* data, size_t numSamples);
+    void processDynamicBandStereo(EQBand& band, float* dataL, float* dataR, size_t numSamples);
+    void updateDynamicGain(EQBand& band);
+    void processFadingBand(EQBand& band, float* data, size_t numSamples);
+    void processFadingBandStereo(EQBand& band, float* dataL, float* dataR, size_t numSamples);
+    void advanceLimitFade(EQBand& band);
     
     // Default band setup
     void setupDefaultBands();
@@ -126,6 +253,9 @@ public:
     static EQPreset createBassBoostPreset();
     static EQPreset createTrebleBoostPreset();
     static EQPreset createLoudnessPreset();
+
+    // Presets construits une seule fois; nullptr si le nom est inconnu
+    static const EQPreset* findPreset(const std::string& name);
 };
 
 } // namespace AudioEqualizer
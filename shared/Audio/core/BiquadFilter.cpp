@@ -175,6 +175,54 @@ void BiquadFilter::calculateAllpass(double frequency, double sampleRate, double
     setCoefficients(a0, a1, a2, b0, b1, b2);
 }
 
+void BiquadFilter::updateGainFast(FilterType type, double cosOmega, double sinOmega,
+                                  double q, double gainDB) {
+    // A = 10^(g/40) via exp (ln(10)/40), sqrt(A) = 10^(g/80)
+    constexpr double LN10_OVER_40 = 0.05756462732485114;
+    double A = std::exp(gainDB * LN10_OVER_40);
+    double b0, b1, b2, a0, a1, a2;
+
+    switch (type) {
+        case FilterType::PEAK: {
+            double alpha = sinOmega / (2.0 * q);
+            b0 = 1.0 + alpha / A;
+            b1 = -2.0 * cosOmega;
+            b2 = 1.0 - alpha / A;
+            a0 = 1.0 + alpha * A;
+            a1 = -2.0 * cosOmega;
+            a2 = 1.0 - alpha * A;
+            break;
+        }
+        case FilterType::LOWSHELF:
+        case FilterType::HIGHSHELF: {
+            // S = 1 : alpha = sin(omega)/2 * sqrt(2), indépendant du gain
+            double sqrtA = std::exp(gainDB * (LN10_OVER_40 * 0.5));
+            double two_sqrt_A_alpha = 2.0 * sqrtA * (sinOmega * 0.7071067811865476);
+            double ap1 = A + 1.0, am1 = A - 1.0;
+            if (type == FilterType::LOWSHELF) {
+                b0 = ap1 + am1 * cosOmega + two_sqrt_A_alpha;
+                b1 = -2.0 * (am1 + ap1 * cosOmega);
+                b2 = ap1 + am1 * cosOmega - two_sqrt_A_alpha;
+                a0 = A * (ap1 - am1 * cosOmega + two_sqrt_A_alpha);
+                a1 = 2.0 * A * (am1 - ap1 * cosOmega);
+                a2 = A * (ap1 - am1 * cosOmega - two_sqrt_A_alpha);
+            } else {
+                b0 = ap1 - am1 * cosOmega + two_sqrt_A_alpha;
+                b1 = 2.0 * (am1 - ap1 * cosOmega);
+                b2 = ap1 - am1 * cosOmega - two_sqrt_A_alpha;
+                a0 = A * (ap1 + am1 * cosOmega + two_sqrt_A_alpha);
+                a1 = -2.0 * A * (am1 + ap1 * cosOmega);
+                a2 = A * (ap1 + am1 * cosOmega - two_sqrt_A_alpha);
+            }
+            break;
+        }
+        default:
+            return;
+    }
+
+    setCoefficients(a0, a1, a2, b0, b1, b2);
+}
+
 void BiquadFilter::process(const float* input, float* output, size_t numSamples) {
 #if defined(__AVX2__)
     // Use AVX2 optimized version on x86_64
@@ -202,7 +250,7 @@ void BiquadFilter::process(const float* input, float* output, size_t numSamples)
             double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
             
             y2 = y1;
-            y1 = preventDenormal(w);
+            y1 = w;
             
             output[offset + i] = static_cast<float>(y);
         }
@@ -216,7 +264,7 @@ void BiquadFilter::process(const float* input, float* output, size_t numSamples)
         double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
         
         y2 = y1;
-        y1 = preventDenormal(w);
+        y1 = w;
         
         output[offset + i] = static_cast<float>(y);
     }
@@ -237,7 +285,7 @@ void BiquadFilter::processStereo(const float* inputL, const float* inputR,
         double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
         
         y2 = y1;
-        y1 = preventDenormal(w);
+        y1 = w;
         
         outputL[i] = static_cast<float>(y);
     }
@@ -253,7 +301,7 @@ void BiquadFilter::processStereo(const float* inputL, const float* inputR,
         double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
         
         y2 = y1;
-        y1 = preventDenormal(w);
+        y1 = w;
         
         outputR[i] = static_cast<float>(y);
     }
@@ -323,7 +371,7 @@ void BiquadFilter::processAVX2(const float* input, float* output, size_t numSamp
             double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
             
             y2 = y1;
-            y1 = preventDenormal(w);
+            y1 = w;
             y_arr[j] = y;
         }
         
@@ -340,7 +388,7 @@ void BiquadFilter::processAVX2(const float* input, float* output, size_t numSamp
         double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
         
         y2 = y1;
-        y1 = preventDenormal(w);
+        y1 = w;
         
         output[i] = static_cast<float>(y);
     }
@@ -371,7 +419,7 @@ void BiquadFilter::processSSE2(const float* input, float* output, size_t numSamp
             double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
             
             y2 = y1;
-            y1 = preventDenormal(w);
+            y1 = w;
             temp[j] = static_cast<float>(y);
         }
         
@@ -386,7 +434,7 @@ void BiquadFilter::processSSE2(const float* input, float* output, size_t numSamp
         double y = m_a0 * w + m_a1 * y1 + m_a2 * y2;
         
         y2 = y1;
-        y1 = preventDenormal(w);
+        y1 = w;
         output[i] = static_cast<float>(y);
     }
     
@@ -32,6 +32,10 @@ public:
     void calculateHighShelf(double frequency, double sampleRate, double q, double gainDB);
     void calculateAllpass(double frequency, double sampleRate, double q);
 
+    // Recalcul du gain seul (PEAK / LOWSHELF / HIGHSHELF) à partir de cos/sin(omega)
+    // pré-calculés : ni sin/cos ni pow, destiné aux mises à jour par sous-bloc des bandes dynamiques
+    void updateGainFast(FilterType type, double cosOmega, double sinOmega, double q, double gainDB);
+
     // Process audio samples
     void process(const float* input, float* output, size_t numSamples);
     void processStereo(const float* inputL, const float* inputR, 
@@ -56,13 +60,9 @@ private:
     double m_y1, m_y2;        // Previous outputs for left/mono channel
     double m_y1R, m_y2R;      // Previous outputs for right channel
     
-    // Helper function
-    
-    
-    // Prevent denormal numbers
-    inline double preventDenormal(double x) {
-        return (std::abs(x) < EPSILON) ? 0.0 : x;
-    }
+    // Pas de test de dénormaux par échantillon : chaque point d'entrée du traitement ouvre
+    // FTZ/DAZ (RealtimeScope sur les threads audio, DenormalScope pour JSI, le mixeur et le
+    // rendu hors ligne), voir utils/RealtimeScope.h
     
     // Normalize coefficients
     void normalizeCoefficients(double& a0, double& a1, double& a2, 
@@ -97,7 +97,7 @@ inline float AudioEqualizer::BiquadFilter::processSample(float input) {
     
     // Update state variables
     m_y2 = m_y1;
-    m_y1 = preventDenormal(w);
+    m_y1 = w;
     
     return static_cast<float>(y);
 }
@@ -0,0 +1,136 @@
+#include "CoefficientCache.h"
+#include "BiquadFilter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace AudioEqualizer {
+
+BiquadCoefficients computeBiquadCoefficients(FilterType type, double frequency, double q,
+                                             double gainDb, double sampleRate) {
+    BiquadFilter filter;
+    switch (type) {
+        case FilterType::LOWPASS:
+            filter.calculateLowpass(frequency, sampleRate, q);
+            break;
+        case FilterType::HIGHPASS:
+            filter.calculateHighpass(frequency, sampleRate, q);
+            break;
+        case FilterType::BANDPASS:
+            filter.calculateBandpass(frequency, sampleRate, q);
+            break;
+        case FilterType::NOTCH:
+            filter.calculateNotch(frequency, sampleRate, q);
+            break;
+        case FilterType::PEAK:
+            filter.calculatePeaking(frequency, sampleRate, q, gainDb);
+            break;
+        case FilterType::LOWSHELF:
+            filter.calculateLowShelf(frequency, sampleRate, q, gainDb);
+            break;
+        case FilterType::HIGHSHELF:
+            filter.calculateHighShelf(frequency, sampleRate, q, gainDb);
+            break;
+        case FilterType::ALLPASS:
+            filter.calculateAllpass(frequency, sampleRate, q);
+            break;
+    }
+    BiquadCoefficients c;
+    double b0;
+    filter.getCoefficients(c.a0, c.a1, c.a2, b0, c.b1, c.b2);
+    return c;
+}
+
+CoefficientCache::CoefficientCache(size_t capacity) {
+    if (capacity == 0) capacity = 1;
+    m_entries.resize(capacity);
+    size_t buckets = 1;
+    while (buckets < capacity * 2) buckets <<= 1;
+    m_buckets.assign(buckets, kNone);
+}
+
+void CoefficientCache::clear() {
+    std::fill(m_buckets.begin(), m_buckets.end(), kNone);
+    m_head = m_tail = kNone;
+    m_size = 0;
+}
+
+size_t CoefficientCache::hashKey(const Key& key) {
+    // Comparaison exacte des doubles : hachage de leurs bits
+    auto mix = [](uint64_t h, double v) {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        h ^= bits + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        return h;
+    };
+    uint64_t h = static_cast<uint64_t>(key.type);
+    h = mix(h, key.frequency);
+    h = mix(h, key.q);
+    h = mix(h, key.gainDb);
+    h = mix(h, key.sampleRate);
+    return static_cast<size_t>(h ^ (h >> 29));
+}
+
+void CoefficientCache::unlink(uint32_t index) {
+    Entry& e = m_entries[index];
+    if (e.prev != kNone) m_entries[e.prev].next = e.next; else m_head = e.next;
+    if (e.next != kNone) m_entries[e.next].prev = e.prev; else m_tail = e.prev;
+    e.prev = e.next = kNone;
+}
+
+void CoefficientCache::pushFront(uint32_t index) {
+    Entry& e = m_entries[index];
+    e.prev = kNone;
+    e.next = m_head;
+    if (m_head != kNone) m_entries[m_head].prev = index;
+    m_head = index;
+    if (m_tail == kNone) m_tail = index;
+}
+
+void CoefficientCache::removeFromBucket(uint32_t index) {
+    uint32_t* link = &m_buckets[hashKey(m_entries[index].key) & (m_buckets.size() - 1)];
+    while (*link != kNone && *link != index) link = &m_entries[*link].chain;
+    if (*link == index) *link = m_entries[index].chain;
+    m_entries[index].chain = kNone;
+}
+
+const BiquadCoefficients& CoefficientCache::get(FilterType type, double frequency, double q,
+                                                double gainDb, double sampleRate) {
+    Key key;
+    key.type = type;
+    key.frequency = frequency;
+    key.q = q;
+    key.gainDb = filterTypeUsesGain(type) ? gainDb : 0.0;
+    key.sampleRate = sampleRate;
+
+    uint32_t& bucket = m_buckets[hashKey(key) & (m_buckets.size() - 1)];
+    for (uint32_t i = bucket; i != kNone; i = m_entries[i].chain) {
+        if (m_entries[i].key == key) {
+            ++m_hits;
+            if (i != m_head) {
+                unlink(i);
+                pushFront(i);
+            }
+            return m_entries[i].coeffs;
+        }
+    }
+
+    ++m_misses;
+    uint32_t index;
+    if (m_size < m_entries.size()) {
+        index = static_cast<uint32_t>(m_size++);
+    } else {
+        index = m_tail;
+        unlink(index);
+        removeFromBucket(index);
+    }
+
+    Entry& e = m_entries[index];
+    e.key = key;
+    e.coeffs = computeBiquadCoefficients(type, frequency, q, key.gainDb, sampleRate);
+    e.chain = bucket;   // relu : l'éviction a pu retirer la tête du seau
+    bucket = index;
+    pushFront(index);
+    return e.coeffs;
+}
+
+} // namespace AudioEqualizer
@@ -0,0 +1,80 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "FrequencyResponse.h"
+#include "../utils/Constants.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AudioEqualizer {
+
+// Coefficients d'une bande (formules de BiquadFilter::calculate*), sans filtre
+BiquadCoefficients computeBiquadCoefficients(FilterType type, double frequency, double q,
+                                             double gainDb, double sampleRate);
+
+// Le gain n'agit que sur PEAK / LOWSHELF / HIGHSHELF
+inline bool filterTypeUsesGain(FilterType type) {
+    return type == FilterType::PEAK || type == FilterType::LOWSHELF || type == FilterType::HIGHSHELF;
+}
+
+// Cache LRU de coefficients, clé (type, fréquence, Q, gain, fréquence d'échantillonnage).
+//
+// Revenir à un preset déjà utilisé ne recalcule plus sin/cos/pow. Capacité fixe allouée à
+// la construction : get() n'alloue pas (utilisable sur le thread audio).
+// Non synchronisé : l'appelant sérialise les accès (AudioEqualizer : sous m_parameterMutex).
+class CoefficientCache {
+public:
+    explicit CoefficientCache(size_t capacity = 256);
+
+    // Depuis le cache, sinon calculés puis insérés (éviction de l'entrée la moins récente)
+    const BiquadCoefficients& get(FilterType type, double frequency, double q,
+                                  double gainDb, double sampleRate);
+
+    void clear();
+    size_t size() const { return m_size; }
+    size_t getCapacity() const { return m_entries.size(); }
+    uint64_t getHits() const { return m_hits; }
+    uint64_t getMisses() const { return m_misses; }
+
+private:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Key {
+        FilterType type = FilterType::PEAK;
+        double frequency = 0.0;
+        double q = 0.0;
+        double gainDb = 0.0;
+        double sampleRate = 0.0;
+
+        bool operator==(const Key& o) const {
+            return type == o.type && frequency == o.frequency && q == o.q &&
+                   gainDb == o.gainDb && sampleRate == o.sampleRate;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        BiquadCoefficients coeffs;
+        uint32_t prev = kNone;       // liste LRU (tête = plus récent)
+        uint32_t next = kNone;
+        uint32_t chain = kNone;      // suivant dans le seau
+    };
+
+    static size_t hashKey(const Key& key);
+    void unlink(uint32_t index);
+    void pushFront(uint32_t index);
+    void removeFromBucket(uint32_t index);
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_buckets;   // puissance de 2, >= 2 x capacité
+    uint32_t m_head = kNone;
+    uint32_t m_tail = kNone;
+    size_t m_size = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
@@ -0,0 +1,197 @@
+#include "FrequencyResponse.h"
+#include "../utils/Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace AudioEqualizer {
+
+namespace {
+
+// Plancher du module au carré (-240 dB) : zéros exacts (notch) sans -inf
+constexpr double kMinMagnitudeSq = 1e-24;
+
+// Une cellule en un point. Avec N = Nr - j Ni et D = Dr - j Di (Ni, Di >= 0 par convention) :
+// N / D = ((Nr Dr + Ni Di) + j (Nr Di - Ni Dr)) / (Dr^2 + Di^2)
+inline void accumulateSection(const BiquadCoefficients& s, double c1, double s1, double c2, double s2,
+                              double& re, double& im) {
+    const double nr = s.a0 + s.a1 * c1 + s.a2 * c2;
+    const double ni = s.a1 * s1 + s.a2 * s2;
+    const double dr = 1.0 + s.b1 * c1 + s.b2 * c2;
+    const double di = s.b1 * s1 + s.b2 * s2;
+    const double inv = 1.0 / (dr * dr + di * di);
+    const double qr = (nr * dr + ni * di) * inv;
+    const double qi = (nr * di - ni * dr) * inv;
+    const double tr = re * qr - im * qi;
+    im = re * qi + im * qr;
+    re = tr;
+}
+
+} // namespace
+
+bool FrequencyResponse::setGrid(const float* freqs, size_t numPoints, double sampleRate) {
+    if (sampleRate == m_sampleRate && numPoints == m_freqs.size() &&
+        (numPoints == 0 || std::memcmp(freqs, m_freqs.data(), numPoints * sizeof(float)) == 0)) {
+        return false;
+    }
+
+    m_freqs.assign(freqs, freqs + numPoints);
+    m_sampleRate = sampleRate;
+    m_cos1.resize(numPoints);
+    m_sin1.resize(numPoints);
+    m_cos2.resize(numPoints);
+    m_sin2.resize(numPoints);
+    m_re.resize(numPoints);
+    m_im.resize(numPoints);
+
+    const double nyquist = 0.5 * sampleRate;
+    for (size_t i = 0; i < numPoints; ++i) {
+        const double f = std::max(0.0, std::min(static_cast<double>(freqs[i]), nyquist));
+        const double w = TWO_PI * f / sampleRate;
+        const double c = std::cos(w);
+        const double s = std::sin(w);
+        m_cos1[i] = c;
+        m_sin1[i] = s;
+        m_cos2[i] = 2.0 * c * c - 1.0;
+        m_sin2[i] = 2.0 * s * c;
+    }
+    return true;
+}
+
+void FrequencyResponse::evaluate(const BiquadCoefficients* sections, size_t numSections, double gainDb,
+                                 float* magDb, float* phase) {
+    const size_t n = m_freqs.size();
+    const double* c1p = m_cos1.data();
+    const double* s1p = m_sin1.data();
+    const double* c2p = m_cos2.data();
+    const double* s2p = m_sin2.data();
+    double* rep = m_re.data();
+    double* imp = m_im.data();
+    size_t i = 0;
+
+    // Les points d'un vecteur traversent toute la cascade sans repasser par la mémoire
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        const __m256d c1 = _mm256_loadu_pd(c1p + i);
+        const __m256d s1 = _mm256_loadu_pd(s1p + i);
+        const __m256d c2 = _mm256_loadu_pd(c2p + i);
+        const __m256d s2 = _mm256_loadu_pd(s2p + i);
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d re = one;
+        __m256d im = _mm256_setzero_pd();
+        for (size_t k = 0; k < numSections; ++k) {
+            const BiquadCoefficients& s = sections[k];
+            const __m256d a0 = _mm256_set1_pd(s.a0), a1 = _mm256_set1_pd(s.a1), a2 = _mm256_set1_pd(s.a2);
+            const __m256d b1 = _mm256_set1_pd(s.b1), b2 = _mm256_set1_pd(s.b2);
+#ifdef __FMA__
+            const __m256d nr = _mm256_fmadd_pd(a2, c2, _mm256_fmadd_pd(a1, c1, a0));
+            const __m256d ni = _mm256_fmadd_pd(a2, s2, _mm256_mul_pd(a1, s1));
+            const __m256d dr = _mm256_fmadd_pd(b2, c2, _mm256_fmadd_pd(b1, c1, one));
+            const __m256d di = _mm256_fmadd_pd(b2, s2, _mm256_mul_pd(b1, s1));
+            const __m256d inv = _mm256_div_pd(one, _mm256_fmadd_pd(dr, dr, _mm256_mul_pd(di, di)));
+            const __m256d qr = _mm256_mul_pd(_mm256_fmadd_pd(nr, dr, _mm256_mul_pd(ni, di)), inv);
+            const __m256d qi = _mm256_mul_pd(_mm256_fmsub_pd(nr, di, _mm256_mul_pd(ni, dr)), inv);
+            const __m256d tr = _mm256_fmsub_pd(re, qr, _mm256_mul_pd(im, qi));
+            im = _mm256_fmadd_pd(re, qi, _mm256_mul_pd(im, qr));
+#else
+            const __m256d nr = _mm256_add_pd(a0, _mm256_add_pd(_mm256_mul_pd(a1, c1), _mm256_mul_pd(a2, c2)));
+            const __m256d ni = _mm256_add_pd(_mm256_mul_pd(a1, s1), _mm256_mul_pd(a2, s2));
+            const __m256d dr = _mm256_add_pd(one, _mm256_add_pd(_mm256_mul_pd(b1, c1), _mm256_mul_pd(b2, c2)));
+            const __m256d di = _mm256_add_pd(_mm256_mul_pd(b1, s1), _mm256_mul_pd(b2, s2));
+            const __m256d inv = _mm256_div_pd(one, _mm256_add_pd(_mm256_mul_pd(dr, dr), _mm256_mul_pd(di, di)));
+            const __m256d qr = _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(nr, dr), _mm256_mul_pd(ni, di)), inv);
+            const __m256d qi = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(nr, di), _mm256_mul_pd(ni, dr)), inv);
+            const __m256d tr = _mm256_sub_pd(_mm256_mul_pd(re, qr), _mm256_mul_pd(im, qi));
+            im = _mm256_add_pd(_mm256_mul_pd(re, qi), _mm256_mul_pd(im, qr));
+#endif
+            re = tr;
+        }
+        _mm256_storeu_pd(rep + i, re);
+        _mm256_storeu_pd(imp + i, im);
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        const __m128d c1 = _mm_loadu_pd(c1p + i);
+        const __m128d s1 = _mm_loadu_pd(s1p + i);
+        const __m128d c2 = _mm_loadu_pd(c2p + i);
+        const __m128d s2 = _mm_loadu_pd(s2p + i);
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d re = one;
+        __m128d im = _mm_setzero_pd();
+        for (size_t k = 0; k < numSections; ++k) {
+            const BiquadCoefficients& s = sections[k];
+            const __m128d a0 = _mm_set1_pd(s.a0), a1 = _mm_set1_pd(s.a1), a2 = _mm_set1_pd(s.a2);
+            const __m128d b1 = _mm_set1_pd(s.b1), b2 = _mm_set1_pd(s.b2);
+            const __m128d nr = _mm_add_pd(a0, _mm_add_pd(_mm_mul_pd(a1, c1), _mm_mul_pd(a2, c2)));
+            const __m128d ni = _mm_add_pd(_mm_mul_pd(a1, s1), _mm_mul_pd(a2, s2));
+            const __m128d dr = _mm_add_pd(one, _mm_add_pd(_mm_mul_pd(b1, c1), _mm_mul_pd(b2, c2)));
+            const __m128d di = _mm_add_pd(_mm_mul_pd(b1, s1), _mm_mul_pd(b2, s2));
+            const __m128d inv = _mm_div_pd(one, _mm_add_pd(_mm_mul_pd(dr, dr), _mm_mul_pd(di, di)));
+            const __m128d qr = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(nr, dr), _mm_mul_pd(ni, di)), inv);
+            const __m128d qi = _mm_mul_pd(_mm_sub_pd(_mm_mul_pd(nr, di), _mm_mul_pd(ni, dr)), inv);
+            const __m128d tr = _mm_sub_pd(_mm_mul_pd(re, qr), _mm_mul_pd(im, qi));
+            im = _mm_add_pd(_mm_mul_pd(re, qi), _mm_mul_pd(im, qr));
+            re = tr;
+        }
+        _mm_storeu_pd(rep + i, re);
+        _mm_storeu_pd(imp + i, im);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 2 <= n; i += 2) {
+        const float64x2_t c1 = vld1q_f64(c1p + i);
+        const float64x2_t s1 = vld1q_f64(s1p + i);
+        const float64x2_t c2 = vld1q_f64(c2p + i);
+        const float64x2_t s2 = vld1q_f64(s2p + i);
+        const float64x2_t one = vdupq_n_f64(1.0);
+        float64x2_t re = one;
+        float64x2_t im = vdupq_n_f64(0.0);
+        for (size_t k = 0; k < numSections; ++k) {
+            const BiquadCoefficients& s = sections[k];
+            const float64x2_t nr = vfmaq_n_f64(vfmaq_n_f64(vdupq_n_f64(s.a0), c1, s.a1), c2, s.a2);
+            const float64x2_t ni = vfmaq_n_f64(vmulq_n_f64(s1, s.a1), s2, s.a2);
+            const float64x2_t dr = vfmaq_n_f64(vfmaq_n_f64(one, c1, s.b1), c2, s.b2);
+            const float64x2_t di = vfmaq_n_f64(vmulq_n_f64(s1, s.b1), s2, s.b2);
+            const float64x2_t inv = vdivq_f64(one, vfmaq_f64(vmulq_f64(di, di), dr, dr));
+            const float64x2_t qr = vmulq_f64(vfmaq_f64(vmulq_f64(ni, di), nr, dr), inv);
+            const float64x2_t qi = vmulq_f64(vfmsq_f64(vmulq_f64(nr, di), ni, dr), inv);
+            const float64x2_t tr = vfmsq_f64(vmulq_f64(re, qr), im, qi);
+            im = vfmaq_f64(vmulq_f64(re, qi), im, qr);
+            re = tr;
+        }
+        vst1q_f64(rep + i, re);
+        vst1q_f64(imp + i, im);
+    }
+#endif
+    for (; i < n; ++i) {
+        double re = 1.0, im = 0.0;
+        for (size_t k = 0; k < numSections; ++k) {
+            accumulateSection(sections[k], c1p[i], s1p[i], c2p[i], s2p[i], re, im);
+        }
+        rep[i] = re;
+        imp[i] = im;
+    }
+
+    // log/atan2 en float : la cascade est déjà faite, l'erreur reste < 1e-5 dB / 1e-6 rad
+    const float offset = static_cast<float>(gainDb);
+    for (size_t j = 0; j < n; ++j) {
+        const double magSq = std::max(rep[j] * rep[j] + imp[j] * imp[j], kMinMagnitudeSq);
+        magDb[j] = 10.0f * std::log10(static_cast<float>(magSq)) + offset;
+    }
+    if (phase) {
+        for (size_t j = 0; j < n; ++j) {
+            phase[j] = std::atan2(static_cast<float>(imp[j]), static_cast<float>(rep[j]));
+        }
+    }
+}
+
+} // namespace AudioEqualizer
@@ -10,15 +10,19 @@ namespace AudioFX {
 
 class DelayEffect final : public IAudioEffect {
 public:
+  // Sans allocation (capacité réservée par setSampleRate); historique conservé si le retard ne change pas
   void setParameters(double delayMs, double feedback, double mix) {
+    const double previousMs = delayMs_;
     delayMs_ = std::max(0.0, delayMs);
     feedback_ = std::clamp(feedback, 0.0, 0.95);
     mix_ = std::clamp(mix, 0.0, 1.0);
-    updateBuffers();
+    if (delaySamples() != delaySamples(previousMs)) updateBuffers();
   }
 
   void setSampleRate(uint32_t sampleRate, int numChannels) override {
     IAudioEffect::setSampleRate(sampleRate, numChannels);
+    ensureState(channels_);
+    for (auto& b : buffer_) b.reserve(delaySamples(kMaxDelayMs));
     updateBuffers();
   }
 
@@ -63,11 +67,17 @@ public:
   }
 
 private:
+  static constexpr double kMaxDelayMs = 4000.0;
+
+  size_t delaySamples(double ms) const {
+    size_t n = static_cast<size_t>(std::round(std::min(ms, kMaxDelayMs) * 0.001 * static_cast<double>(sampleRate_)));
+    return std::max<size_t>(n, 1);
+  }
+  size_t delaySamples() const { return delaySamples(delayMs_); }
+
   void updateBuffers() {
     ensureState(channels_);
-    size_t maxDelaySamples = static_cast<size_t>(std::round(delayMs_ * 0.001 * static_cast<double>(sampleRate_)));
-    if (maxDelaySamples < 1) maxDelaySamples = 1;
-    if (maxDelaySamples > 4 * 48000) maxDelaySamples = 4 * 48000; // clamp 4s max
+    const size_t maxDelaySamples = delaySamples();
     for (int ch = 0; ch < channels_; ++ch) {
       buffer_[ch].assign(maxDelaySamples, 0.0f);
     }
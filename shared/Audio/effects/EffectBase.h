@@ -18,6 +18,9 @@ public:
   virtual void setEnabled(bool enabled) { enabled_ = enabled; }
   bool isEnabled() const { return enabled_; }
 
+  // Retard de traitement (échantillons) introduit quand l'effet est actif
+  virtual size_t getLatencySamples() const { return 0; }
+
   // Process mono buffer
   virtual void processMono(const float* input, float* output, size_t numSamples) {
     if (!enabled_ || !input || !output || numSamples == 0) {
@@ -32,13 +32,20 @@ public:
 
   void clear() { effects_.clear(); }
 
+  // Somme des retards des effets actifs
+  size_t getLatencySamples() const {
+    if (!enabled_) return 0;
+    size_t total = 0;
+    for (const auto& e : effects_) if (e && e->isEnabled()) total += e->getLatencySamples();
+    return total;
+  }
+
   void processMono(const float* input, float* output, size_t numSamples) {
     if (!enabled_ || effects_.empty()) {
       if (output != input && input && output) for (size_t i = 0; i < numSamples; ++i) output[i] = input[i];
       return;
     }
-    // first effect reads input, others in-place on tmp buffer
-    if (!scratch_.size()) scratch_.resize(numSamples);
+    // first effect reads input, others in-place on output
     // run first
     effects_[0]->processMono(input, output, numSamples);
     // then chain in-place
@@ -64,7 +71,6 @@ private:
   uint32_t sampleRate_ = 48000;
   int channels_ = 2;
   std::vector<std::unique_ptr<IAudioEffect>> effects_;
-  std::vector<float> scratch_;
 };
 
 } // namespace AudioFX
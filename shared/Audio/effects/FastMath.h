@@ -0,0 +1,226 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace AudioFX {
+
+// Primitives mathématiques rapides sur 4 floats (SSE2, NEON, repli scalaire).
+// exp/log : polynômes Cephes, erreur relative ~2e-7 (|x| < 88 pour exp, x > 0 pour log).
+// Aucune contrainte d'alignement sur les pointeurs.
+namespace FastMath {
+
+#if defined(__SSE2__)
+struct vf4 { __m128 v; };
+struct vm4 { __m128 v; };   // masque : lanes à 0xFFFFFFFF ou 0
+
+inline vf4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+inline void store(float* p, vf4 a) { _mm_storeu_ps(p, a.v); }
+inline vf4 set1(float x) { return {_mm_set1_ps(x)}; }
+inline vf4 operator+(vf4 a, vf4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline vf4 operator-(vf4 a, vf4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline vf4 operator*(vf4 a, vf4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline vf4 operator/(vf4 a, vf4 b) { return {_mm_div_ps(a.v, b.v)}; }
+inline vf4 min(vf4 a, vf4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline vf4 max(vf4 a, vf4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline vf4 abs(vf4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+// Bit de signe de b sur |a|
+inline vf4 copysign(vf4 a, vf4 b) {
+  const __m128 s = _mm_set1_ps(-0.0f);
+  return {_mm_or_ps(_mm_andnot_ps(s, a.v), _mm_and_ps(s, b.v))};
+}
+inline vm4 operator>(vf4 a, vf4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline vm4 operator<(vf4 a, vf4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline vf4 select(vm4 m, vf4 a, vf4 b) { return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))}; }
+
+// x * 2^n, n arrondi au plus proche (n de x exact en entier)
+inline vf4 roundedExp2Split(vf4 x, vf4& n) {
+  const __m128i i = _mm_cvtps_epi32(x.v);   // MXCSR : arrondi au plus proche
+  n = {_mm_cvtepi32_ps(i)};
+  return {_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(i, _mm_set1_epi32(127)), 23))};
+}
+// Mantisse dans [0.5, 1) et exposant
+inline vf4 frexp(vf4 x, vf4& e) {
+  const __m128i bits = _mm_castps_si128(x.v);
+  e = {_mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)))};
+  const __m128i m = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000));
+  return {_mm_castsi128_ps(m)};
+}
+
+#elif defined(__ARM_NEON)
+struct vf4 { float32x4_t v; };
+struct vm4 { uint32x4_t v; };
+
+inline vf4 load(const float* p) { return {vld1q_f32(p)}; }
+inline void store(float* p, vf4 a) { vst1q_f32(p, a.v); }
+inline vf4 set1(float x) { return {vdupq_n_f32(x)}; }
+inline vf4 operator+(vf4 a, vf4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline vf4 operator-(vf4 a, vf4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline vf4 operator*(vf4 a, vf4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline vf4 operator/(vf4 a, vf4 b) {
+#if defined(__aarch64__)
+  return {vdivq_f32(a.v, b.v)};
+#else
+  // ARMv7 : estimation de l'inverse + 2 itérations de Newton (~1 ulp)
+  float32x4_t r = vrecpeq_f32(b.v);
+  r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+  r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+  return {vmulq_f32(a.v, r)};
+#endif
+}
+inline vf4 min(vf4 a, vf4 b) { return {vminq_f32(a.v, b.v)}; }
+inline vf4 max(vf4 a, vf4 b) { return {vmaxq_f32(a.v, b.v)}; }
+inline vf4 abs(vf4 a) { return {vabsq_f32(a.v)}; }
+inline vf4 copysign(vf4 a, vf4 b) {
+  return {vbslq_f32(vdupq_n_u32(0x80000000u), b.v, a.v)};
+}
+inline vm4 operator>(vf4 a, vf4 b) { return {vcgtq_f32(a.v, b.v)}; }
+inline vm4 operator<(vf4 a, vf4 b) { return {vcltq_f32(a.v, b.v)}; }
+inline vf4 select(vm4 m, vf4 a, vf4 b) { return {vbslq_f32(m.v, a.v, b.v)}; }
+
+inline vf4 roundedExp2Split(vf4 x, vf4& n) {
+#if defined(__aarch64__)
+  const int32x4_t i = vcvtnq_s32_f32(x.v);
+#else
+  // Pas de conversion arrondie en ARMv7 : demi-unité signée puis troncature
+  const float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000u), x.v, vdupq_n_f32(0.5f));
+  const int32x4_t i = vcvtq_s32_f32(vaddq_f32(x.v, half));
+#endif
+  n = {vcvtq_f32_s32(i)};
+  return {vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(i, vdupq_n_s32(127)), 23))};
+}
+inline vf4 frexp(vf4 x, vf4& e) {
+  const uint32x4_t bits = vreinterpretq_u32_f32(x.v);
+  e = {vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)))};
+  const uint32x4_t m = vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFFu)), vdupq_n_u32(0x3F000000u));
+  return {vreinterpretq_f32_u32(m)};
+}
+
+#else
+struct vf4 { float v[4]; };
+struct vm4 { bool v[4]; };
+
+inline vf4 load(const float* p) { vf4 r; for (int k = 0; k < 4; ++k) r.v[k] = p[k]; return r; }
+inline void store(float* p, vf4 a) { for (int k = 0; k < 4; ++k) p[k] = a.v[k]; }
+inline vf4 set1(float x) { return {{x, x, x, x}}; }
+#define NAAYA_FASTMATH_LANES(expr) vf4 r; for (int k = 0; k < 4; ++k) r.v[k] = (expr); return r
+inline vf4 operator+(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(a.v[k] + b.v[k]); }
+inline vf4 operator-(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(a.v[k] - b.v[k]); }
+inline vf4 operator*(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(a.v[k] * b.v[k]); }
+inline vf4 operator/(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(a.v[k] / b.v[k]); }
+inline vf4 min(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(b.v[k] < a.v[k] ? b.v[k] : a.v[k]); }
+inline vf4 max(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(b.v[k] > a.v[k] ? b.v[k] : a.v[k]); }
+inline vf4 abs(vf4 a) { NAAYA_FASTMATH_LANES(std::fabs(a.v[k])); }
+inline vf4 copysign(vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(std::copysign(a.v[k], b.v[k])); }
+inline vf4 select(vm4 m, vf4 a, vf4 b) { NAAYA_FASTMATH_LANES(m.v[k] ? a.v[k] : b.v[k]); }
+inline vf4 roundedExp2Split(vf4 x, vf4& n) {
+  vf4 r;
+  for (int k = 0; k < 4; ++k) {
+    const int32_t i = static_cast<int32_t>(std::lrint(x.v[k]));
+    n.v[k] = static_cast<float>(i);
+    const uint32_t bits = static_cast<uint32_t>(i + 127) << 23;
+    std::memcpy(&r.v[k], &bits, sizeof(float));
+  }
+  return r;
+}
+inline vf4 frexp(vf4 x, vf4& e) {
+  vf4 r;
+  for (int k = 0; k < 4; ++k) {
+    uint32_t bits;
+    std::memcpy(&bits, &x.v[k], sizeof(float));
+    e.v[k] = static_cast<float>(static_cast<int32_t>(bits >> 23) - 126);
+    bits = (bits & 0x007FFFFFu) | 0x3F000000u;
+    std::memcpy(&r.v[k], &bits, sizeof(float));
+  }
+  return r;
+}
+#undef NAAYA_FASTMATH_LANES
+inline vm4 operator>(vf4 a, vf4 b) { vm4 m; for (int k = 0; k < 4; ++k) m.v[k] = a.v[k] > b.v[k]; return m; }
+inline vm4 operator<(vf4 a, vf4 b) { vm4 m; for (int k = 0; k < 4; ++k) m.v[k] = a.v[k] < b.v[k]; return m; }
+#endif
+
+inline vf4 fma(vf4 a, vf4 b, vf4 c) { return a * b + c; }
+
+// e^x, x borné à [-87.3, 88.3]
+inline vf4 exp(vf4 x) {
+  x = min(max(x, set1(-87.3f)), set1(88.3f));
+  vf4 n;
+  const vf4 scale = roundedExp2Split(x * set1(1.44269504088896341f), n);
+  // r = x - n ln2 en deux termes (ln2 = 0.693359375 - 2.12194440e-4)
+  const vf4 r = x - n * set1(0.693359375f) + n * set1(2.12194440e-4f);
+  vf4 p = set1(1.9875691500e-4f);
+  p = fma(p, r, set1(1.3981999507e-3f));
+  p = fma(p, r, set1(8.3334519073e-3f));
+  p = fma(p, r, set1(4.1665795894e-2f));
+  p = fma(p, r, set1(1.6666665459e-1f));
+  p = fma(p, r, set1(5.0000001201e-1f));
+  p = fma(p, r * r, r + set1(1.0f));
+  return p * scale;
+}
+
+// ln x, x > 0 normalisé
+inline vf4 log(vf4 x) {
+  vf4 e;
+  vf4 m = frexp(x, e);
+  // m dans [sqrt(0.5), sqrt(2)) : m - 1 proche de 0
+  const vm4 low = m < set1(0.707106781186547524f);
+  e = select(low, e - set1(1.0f), e);
+  m = select(low, m + m, m) - set1(1.0f);
+  const vf4 z = m * m;
+  vf4 p = set1(7.0376836292e-2f);
+  p = fma(p, m, set1(-1.1514610310e-1f));
+  p = fma(p, m, set1(1.1676998740e-1f));
+  p = fma(p, m, set1(-1.2420140846e-1f));
+  p = fma(p, m, set1(1.4249322787e-1f));
+  p = fma(p, m, set1(-1.6668057665e-1f));
+  p = fma(p, m, set1(2.0000714765e-1f));
+  p = fma(p, m, set1(-2.4999993993e-1f));
+  p = fma(p, m, set1(3.3333331174e-1f));
+  vf4 y = p * m * z;
+  y = fma(e, set1(-2.12194440e-4f), y);
+  y = y - set1(0.5f) * z;
+  return m + y + e * set1(0.693359375f);
+}
+
+// tanh x = sign(x) (1 - t) / (1 + t), t = e^-2|x| (pas d'overflow)
+inline vf4 tanh(vf4 x) {
+  const vf4 t = exp(set1(-2.0f) * abs(x));
+  return copysign((set1(1.0f) - t) / (set1(1.0f) + t), x);
+}
+
+// ln cosh x - |x| + ln 2 = ln(1 + e^-2|x|), dans [0, ln 2] : partie bornée de ln cosh
+inline vf4 logCoshResidual(vf4 x) {
+  return log(set1(1.0f) + exp(set1(-2.0f) * abs(x)));
+}
+
+// Versions tableau (queue scalaire via un vecteur partiel)
+template <typename Fn>
+inline void applyBlock(const float* in, float* out, size_t n, Fn fn) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) store(out + i, fn(load(in + i)));
+  if (i < n) {
+    float tmp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t k = 0; i + k < n; ++k) tmp[k] = in[i + k];
+    store(tmp, fn(load(tmp)));
+    for (size_t k = 0; i + k < n; ++k) out[i + k] = tmp[k];
+  }
+}
+
+inline void expBlock(const float* in, float* out, size_t n) { applyBlock(in, out, n, [](vf4 x) { return exp(x); }); }
+inline void logBlock(const float* in, float* out, size_t n) { applyBlock(in, out, n, [](vf4 x) { return log(x); }); }
+inline void tanhBlock(const float* in, float* out, size_t n) { applyBlock(in, out, n, [](vf4 x) { return tanh(x); }); }
+
+} // namespace FastMath
+
+} // namespace AudioFX
+
+#endif // __cplusplus
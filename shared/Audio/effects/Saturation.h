@@ -0,0 +1,241 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "EffectBase.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace AudioFX {
+
+enum class SaturationType : int {
+  Tanh = 0,        // symétrique, harmoniques impaires
+  Cubic = 1,       // x - x^3/3 borné à +-2/3, genou plus dur
+  Asymmetric = 2   // tanh(x + b) - tanh(b) : harmoniques paires, DC retiré par un passe-haut
+};
+
+// Saturation douce avec anti-repliement par primitive (ADAA 1er ordre).
+//
+// y[n] = (F(v[n]) - F(v[n-1])) / (v[n] - v[n-1]), F primitive du shaper, v = drive x (+ biais).
+// La moyenne du shaper sur l'intervalle réduit le repliement sans suréchantillonnage
+// (~ -10 dB en moyenne de 500 Hz à 16 kHz, jusqu'à -30 dB vers 8 kHz; SaturationBenchmark)
+// pour ~2x le coût du shaper direct. Retard d'1/2 échantillon : la voie sèche est interpolée
+// au même instant. Quand |dv| < kEpsilon, Taylor au point milieu
+// f(m) + f''(m) dv^2/24 remplace la différence divisée (mal conditionnée).
+// F s'écrit s |v| + h(v), h bornée : la différence reste précise en float quel que soit v.
+// Traitement par blocs vectorisés (FastMath), aucune allocation dans process*.
+class SaturationEffect final : public IAudioEffect {
+public:
+  SaturationEffect() { updateShaper(); reset(); }
+
+  // driveDb [0, 36] : gain avant shaper; mix [0, 1]; outputDb [-24, 24] : gain final
+  void setParameters(SaturationType type, double driveDb, double mix, double outputDb) {
+    const bool typeChanged = type != type_;
+    type_ = type;
+    driveDb_ = std::clamp(driveDb, 0.0, 36.0);
+    mix_ = std::clamp(mix, 0.0, 1.0);
+    outputDb_ = std::clamp(outputDb, -24.0, 24.0);
+    updateShaper();
+    if (typeChanged) reset();
+  }
+
+  // false : shaper appliqué directement (référence de repliement pour le benchmark)
+  void setAntiAliasing(bool enabled) { antiAliasing_ = enabled; }
+  bool isAntiAliasing() const { return antiAliasing_; }
+
+  SaturationType getType() const { return type_; }
+
+  // Retard ADAA d'1/2 échantillon (voie sèche alignée) : sous l'échantillon, non compensé
+  size_t getLatencySamples() const override { return 0; }
+
+  void setSampleRate(uint32_t sampleRate, int numChannels) override {
+    IAudioEffect::setSampleRate(sampleRate, numChannels);
+    // Passe-haut 1er ordre à 10 Hz (mode asymétrique)
+    dcCoeff_ = static_cast<float>(std::exp(-2.0 * 3.14159265358979323846 * 10.0 / static_cast<double>(sampleRate_)));
+    reset();
+  }
+
+  void reset() {
+    for (auto& s : state_) {
+      s.prevV = bias_;
+      s.prevH = shaperResidualScalar(bias_);
+      s.prevX = 0.0f;
+      s.dcX1 = s.dcY1 = 0.0f;
+    }
+  }
+
+  void processMono(const float* input, float* output, size_t numSamples) override {
+    if (!isEnabled() || !input || !output || numSamples == 0) {
+      if (output != input && input && output) for (size_t i = 0; i < numSamples; ++i) output[i] = input[i];
+      return;
+    }
+    processChannel(state_[0], input, output, numSamples);
+  }
+
+  void processStereo(const float* inL, const float* inR, float* outL, float* outR, size_t numSamples) override {
+    if (!isEnabled() || !inL || !inR || !outL || !outR || numSamples == 0) {
+      if (outL != inL && inL && outL) for (size_t i = 0; i < numSamples; ++i) outL[i] = inL[i];
+      if (outR != inR && inR && outR) for (size_t i = 0; i < numSamples; ++i) outR[i] = inR[i];
+      return;
+    }
+    processChannel(state_[0], inL, outL, numSamples);
+    processChannel(state_[1], inR, outR, numSamples);
+  }
+
+private:
+  static constexpr size_t kChunk = 256;
+  static constexpr float kEpsilon = 0.02f;
+  static constexpr float kAsymmetricBias = 0.25f;
+
+  struct ChannelState {
+    float prevV = 0.0f;   // dernière entrée du shaper
+    float prevH = 0.0f;   // h(prevV)
+    float prevX = 0.0f;   // dernière entrée sèche
+    float dcX1 = 0.0f;
+    float dcY1 = 0.0f;
+  };
+
+  void updateShaper() {
+    drive_ = static_cast<float>(std::pow(10.0, driveDb_ / 20.0));
+    const float out = static_cast<float>(std::pow(10.0, outputDb_ / 20.0));
+    wetGain_ = out * static_cast<float>(mix_);
+    dryGain_ = out * static_cast<float>(1.0 - mix_);
+    bias_ = type_ == SaturationType::Asymmetric ? kAsymmetricBias : 0.0f;
+    offset_ = type_ == SaturationType::Asymmetric ? -std::tanh(kAsymmetricBias) : 0.0f;
+    slope_ = type_ == SaturationType::Cubic ? 2.0f / 3.0f : 1.0f;
+  }
+
+  // F(v) = slope |v| + h(v) (à une constante près) :
+  //  tanh  : ln cosh v = |v| + ln(1 + e^-2|v|) - ln 2
+  //  cubic : c = min(|v|, 1), F = c^2/2 - c^4/12 + 2/3 (|v| - c)
+  FastMath::vf4 shaperResidual(FastMath::vf4 v) const {
+    using namespace FastMath;
+    if (type_ == SaturationType::Cubic) {
+      const vf4 c = min(abs(v), set1(1.0f));
+      const vf4 c2 = c * c;
+      return c2 * (set1(0.5f) - c2 * set1(1.0f / 12.0f)) - c * set1(2.0f / 3.0f);
+    }
+    return logCoshResidual(v);
+  }
+
+  float shaperResidualScalar(float v) const {
+    float tmp[4] = {v, v, v, v};
+    FastMath::store(tmp, shaperResidual(FastMath::load(tmp)));
+    return tmp[0];
+  }
+
+  // f(m) + f''(m) d^2 / 24
+  FastMath::vf4 shaperMidpoint(FastMath::vf4 m, FastMath::vf4 d2) const {
+    using namespace FastMath;
+    if (type_ == SaturationType::Cubic) {
+      const vf4 c = min(max(m, set1(-1.0f)), set1(1.0f));
+      const vf4 f = c - c * c * c * set1(1.0f / 3.0f);
+      // f'' = -2c à l'intérieur, 0 sur les paliers
+      const vf4 inner = select(abs(m) < set1(1.0f), c, set1(0.0f));
+      return f - inner * d2 * set1(1.0f / 12.0f);
+    }
+    const vf4 t = tanh(m);
+    return t - t * (set1(1.0f) - t * t) * d2 * set1(1.0f / 12.0f);
+  }
+
+  FastMath::vf4 shaperDirect(FastMath::vf4 v) const {
+    using namespace FastMath;
+    if (type_ == SaturationType::Cubic) {
+      const vf4 c = min(max(v, set1(-1.0f)), set1(1.0f));
+      return c - c * c * c * set1(1.0f / 3.0f);
+    }
+    return tanh(v);
+  }
+
+  void processChannel(ChannelState& s, const float* input, float* output, size_t numSamples) {
+    using namespace FastMath;
+    for (size_t offset = 0; offset < numSamples; offset += kChunk) {
+      const size_t n = std::min(kChunk, numSamples - offset);
+      const float* in = input + offset;
+      float* out = output + offset;
+
+      // Index 0 : dernier échantillon du bloc précédent (in-place autorisé)
+      x_[0] = s.prevX;
+      v_[0] = s.prevV;
+      h_[0] = s.prevH;
+      for (size_t i = 0; i < n; ++i) {
+        x_[i + 1] = in[i];
+        v_[i + 1] = drive_ * in[i] + bias_;
+      }
+      // Lanes de bourrage : valeurs finies
+      for (size_t i = n + 1; i < n + 5; ++i) v_[i] = v_[n];
+
+      const vf4 off = set1(offset_);
+      if (antiAliasing_) {
+        for (size_t i = 0; i < n; i += 4) store(h_.data() + i + 1, shaperResidual(load(v_.data() + i + 1)));
+        const vf4 slope = set1(slope_);
+        const vf4 eps = set1(kEpsilon);
+        for (size_t i = 0; i < n; i += 4) {
+          const vf4 v0 = load(v_.data() + i);
+          const vf4 v1 = load(v_.data() + i + 1);
+          const vf4 d = v1 - v0;
+          const vm4 wide = abs(d) > eps;
+          const vf4 num = slope * (abs(v1) - abs(v0)) + (load(h_.data() + i + 1) - load(h_.data() + i));
+          const vf4 dd = num / select(wide, d, set1(1.0f));
+          const vf4 mid = shaperMidpoint(set1(0.5f) * (v0 + v1), d * d);
+          store(w_.data() + i, select(wide, dd, mid) + off);
+        }
+        s.prevH = h_[n];
+
+        // Voie sèche au même instant que l'ADAA (n - 1/2)
+        for (size_t i = 0; i < n; ++i) {
+          w_[i] = wetGain_ * w_[i] + dryGain_ * 0.5f * (x_[i] + x_[i + 1]);
+        }
+      } else {
+        for (size_t i = 0; i < n; i += 4) store(w_.data() + i, shaperDirect(load(v_.data() + i + 1)) + off);
+        for (size_t i = 0; i < n; ++i) w_[i] = wetGain_ * w_[i] + dryGain_ * x_[i + 1];
+      }
+      s.prevV = v_[n];
+      s.prevX = x_[n];
+
+      if (type_ == SaturationType::Asymmetric) {
+        float x1 = s.dcX1, y1 = s.dcY1;
+        for (size_t i = 0; i < n; ++i) {
+          const float y = w_[i] - x1 + dcCoeff_ * y1;
+          x1 = w_[i];
+          y1 = y;
+          out[i] = y;
+        }
+        s.dcX1 = x1;
+        s.dcY1 = y1;
+      } else {
+        for (size_t i = 0; i < n; ++i) out[i] = w_[i];
+      }
+    }
+    if (!antiAliasing_) s.prevH = shaperResidualScalar(s.prevV);
+  }
+
+  // params
+  SaturationType type_ = SaturationType::Tanh;
+  double driveDb_ = 12.0;
+  double mix_ = 1.0;
+  double outputDb_ = -6.0;
+  bool antiAliasing_ = true;
+
+  // dérivés
+  float drive_ = 1.0f;
+  float wetGain_ = 1.0f;
+  float dryGain_ = 0.0f;
+  float bias_ = 0.0f;
+  float offset_ = 0.0f;
+  float slope_ = 1.0f;
+  float dcCoeff_ = 0.9987f;
+
+  // state
+  ChannelState state_[2];
+  // Travail : [0] = échantillon précédent, + bourrage d'un vecteur
+  std::array<float, kChunk + 8> x_{};
+  std::array<float, kChunk + 8> v_{};
+  std::array<float, kChunk + 8> h_{};
+  std::array<float, kChunk + 8> w_{};
+};
+
+} // namespace AudioFX
+
+#endif // __cplusplus
@@ -0,0 +1,262 @@
+#include "SaturationBenchmark.h"
+#include "../../PerformanceBenchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace AudioFX {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Référence : shaper direct entre deux FIR passe-bas à 4 fs (Blackman, 128 prises, coupure 0.45 fs)
+class Oversampler4x {
+public:
+  static constexpr size_t kFactor = 4;
+  static constexpr size_t kTaps = 128;
+  static constexpr size_t kPhaseTaps = kTaps / kFactor;
+
+  Oversampler4x(uint32_t sampleRate, SaturationType type, double driveDb, size_t maxBlock)
+      : up_(maxBlock * kFactor), inHist_(kPhaseTaps - 1, 0.0f), upHist_(kTaps - 1, 0.0f) {
+    const double fc = 0.45 / kFactor;   // relative à 4 fs
+    double sum = 0.0;
+    for (size_t k = 0; k < kTaps; ++k) {
+      const double m = static_cast<double>(k) - 0.5 * (kTaps - 1);
+      const double sinc = m == 0.0 ? 2.0 * fc : std::sin(2.0 * kPi * fc * m) / (kPi * m);
+      const double w = 0.42 - 0.5 * std::cos(2.0 * kPi * k / (kTaps - 1)) + 0.08 * std::cos(4.0 * kPi * k / (kTaps - 1));
+      h_[k] = sinc * w;
+      sum += h_[k];
+    }
+    for (size_t k = 0; k < kTaps; ++k) h_[k] /= sum;
+    // Phases de montée (gain kFactor), inversées pour un produit scalaire contigu
+    for (size_t p = 0; p < kFactor; ++p) {
+      for (size_t j = 0; j < kPhaseTaps; ++j) {
+        phases_[p][kPhaseTaps - 1 - j] = static_cast<float>(kFactor * h_[p + kFactor * j]);
+      }
+    }
+    for (size_t k = 0; k < kTaps; ++k) down_[kTaps - 1 - k] = static_cast<float>(h_[k]);
+    shaper_.setSampleRate(sampleRate * static_cast<uint32_t>(kFactor), 1);
+    shaper_.setParameters(type, driveDb, 1.0, 0.0);
+    shaper_.setAntiAliasing(false);
+  }
+
+  void process(const float* input, float* output, size_t numSamples) {
+    // Montée : historique + bloc contigus
+    inHist_.insert(inHist_.end(), input, input + numSamples);
+    for (size_t n = 0; n < numSamples; ++n) {
+      const float* x = inHist_.data() + n;
+      for (size_t p = 0; p < kFactor; ++p) {
+        float acc = 0.0f;
+        for (size_t j = 0; j < kPhaseTaps; ++j) acc += phases_[p][j] * x[j];
+        up_[n * kFactor + p] = acc;
+      }
+    }
+    inHist_.erase(inHist_.begin(), inHist_.begin() + static_cast<std::ptrdiff_t>(numSamples));
+
+    const size_t upCount = numSamples * kFactor;
+    shaper_.processMono(up_.data(), up_.data(), upCount);
+
+    // Descente : un point sur kFactor
+    upHist_.insert(upHist_.end(), up_.begin(), up_.begin() + static_cast<std::ptrdiff_t>(upCount));
+    for (size_t n = 0; n < numSamples; ++n) {
+      const float* u = upHist_.data() + n * kFactor + (kFactor - 1);
+      float acc = 0.0f;
+      for (size_t k = 0; k < kTaps; ++k) acc += down_[k] * u[k];
+      output[n] = acc;
+    }
+    upHist_.erase(upHist_.begin(), upHist_.begin() + static_cast<std::ptrdiff_t>(upCount));
+  }
+
+private:
+  double h_[kTaps];
+  float phases_[kFactor][kPhaseTaps];
+  float down_[kTaps];
+  std::vector<float> up_;
+  std::vector<float> inHist_;
+  std::vector<float> upHist_;
+  SaturationEffect shaper_;
+};
+
+// Une chaîne de traitement par méthode, même interface pour la mesure
+class Processor {
+public:
+  Processor(SaturationMethod method, SaturationType type, const SaturationBenchmarkConfig& config) {
+    if (method == SaturationMethod::Oversampled4x) {
+      os_ = std::make_unique<Oversampler4x>(config.sampleRate, type, config.driveDb,
+                                            std::max(config.blockSize, config.fftSize));
+    } else {
+      effect_.setSampleRate(config.sampleRate, 1);
+      effect_.setParameters(type, config.driveDb, 1.0, 0.0);
+      effect_.setAntiAliasing(method == SaturationMethod::ADAA);
+    }
+  }
+
+  void process(const float* input, float* output, size_t numSamples) {
+    if (os_) os_->process(input, output, numSamples);
+    else effect_.processMono(input, output, numSamples);
+  }
+
+private:
+  SaturationEffect effect_;
+  std::unique_ptr<Oversampler4x> os_;
+};
+
+void fft(std::vector<std::complex<double>>& a) {
+  const size_t n = a.size();
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) std::swap(a[i], a[j]);
+  }
+  for (size_t len = 2; len <= n; len <<= 1) {
+    const std::complex<double> wl = std::polar(1.0, -2.0 * kPi / static_cast<double>(len));
+    for (size_t i = 0; i < n; i += len) {
+      std::complex<double> w(1.0, 0.0);
+      for (size_t k = 0; k < len / 2; ++k) {
+        const std::complex<double> u = a[i + k];
+        const std::complex<double> v = a[i + k + len / 2] * w;
+        a[i + k] = u + v;
+        a[i + k + len / 2] = u - v;
+        w *= wl;
+      }
+    }
+  }
+}
+
+// Énergie hors harmoniques / fondamentale (dB) pour un sinus au bin impair `bin`.
+// Bin impair, taille puissance de 2 : une harmonique repliée ne tombe jamais sur un multiple de bin.
+double measureAliasing(SaturationMethod method, SaturationType type, size_t bin,
+                       const SaturationBenchmarkConfig& config) {
+  const size_t n = config.fftSize;
+  const double w = 2.0 * kPi * static_cast<double>(bin) / static_cast<double>(n);
+  std::vector<float> in(n), out(n);
+  Processor proc(method, type, config);
+  size_t t = 0;
+  auto fill = [&]() {
+    for (size_t i = 0; i < n; ++i, ++t) {
+      in[i] = static_cast<float>(config.amplitude * std::sin(w * static_cast<double>(t % n)));
+    }
+  };
+  // Régime établi : FIR et passe-haut DC (10 Hz) stabilisés
+  for (int pass = 0; pass < 2; ++pass) { fill(); proc.process(in.data(), out.data(), n); }
+  fill();
+  proc.process(in.data(), out.data(), n);
+
+  std::vector<std::complex<double>> spec(n);
+  for (size_t i = 0; i < n; ++i) spec[i] = std::complex<double>(out[i], 0.0);
+  fft(spec);
+
+  const double fundamental = std::norm(spec[bin]);
+  double alias = 0.0;
+  for (size_t k = 1; k < n / 2; ++k) {
+    if (k % bin != 0) alias += std::norm(spec[k]);
+  }
+  return 10.0 * std::log10(std::max(alias, 1e-30) / std::max(fundamental, 1e-30));
+}
+
+const char* methodName(SaturationMethod method) {
+  switch (method) {
+    case SaturationMethod::Direct: return "direct";
+    case SaturationMethod::ADAA: return "ADAA";
+    case SaturationMethod::Oversampled4x: return "OS 4x";
+  }
+  return "?";
+}
+
+const char* typeName(SaturationType type) {
+  switch (type) {
+    case SaturationType::Tanh: return "tanh";
+    case SaturationType::Cubic: return "cubic";
+    case SaturationType::Asymmetric: return "asym";
+  }
+  return "?";
+}
+
+} // namespace
+
+std::vector<SaturationBenchmarkResult> runSaturationBenchmark(const SaturationBenchmarkConfig& config) {
+  std::vector<SaturationBenchmarkResult> results;
+  const size_t block = std::max<size_t>(16, config.blockSize);
+  const size_t numBlocks = std::max<size_t>(1, static_cast<size_t>(config.seconds * config.sampleRate / block));
+  const double blockMs = 1000.0 * static_cast<double>(block) / config.sampleRate;
+
+  // Glissando logarithmique 20 Hz -> 20 kHz, phase continue
+  std::vector<float> sweep(numBlocks * block);
+  {
+    const double f0 = 20.0, f1 = std::min(20000.0, 0.49 * config.sampleRate);
+    const double total = static_cast<double>(sweep.size());
+    double phase = 0.0;
+    for (size_t i = 0; i < sweep.size(); ++i) {
+      const double f = f0 * std::pow(f1 / f0, static_cast<double>(i) / total);
+      sweep[i] = static_cast<float>(config.amplitude * std::sin(phase));
+      phase += 2.0 * kPi * f / config.sampleRate;
+    }
+  }
+
+  // Paliers du balayage : bins impairs distincts
+  std::vector<size_t> bins;
+  const size_t steps = std::max<size_t>(1, config.sweepSteps);
+  for (size_t s = 0; s < steps; ++s) {
+    const double ratio = steps > 1 ? static_cast<double>(s) / static_cast<double>(steps - 1) : 0.0;
+    const double hz = config.minHz * std::pow(config.maxHz / config.minHz, ratio);
+    size_t bin = static_cast<size_t>(hz * config.fftSize / config.sampleRate) | 1u;
+    bin = std::min(bin, config.fftSize / 2 - 1);
+    if (bins.empty() || bins.back() != bin) bins.push_back(bin);
+  }
+
+  const SaturationType types[] = {SaturationType::Tanh, SaturationType::Cubic, SaturationType::Asymmetric};
+  const SaturationMethod methods[] = {SaturationMethod::Direct, SaturationMethod::ADAA, SaturationMethod::Oversampled4x};
+  std::vector<float> out(block);
+
+  for (SaturationType type : types) {
+    for (SaturationMethod method : methods) {
+      SaturationBenchmarkResult r;
+      r.type = type;
+      r.method = method;
+
+      // Moyenne en énergie : les paliers graves quasi sans repliement ne masquent pas les aigus
+      double sumPower = 0.0;
+      r.maxAliasDb = -300.0;
+      for (size_t bin : bins) {
+        const double db = measureAliasing(method, type, bin, config);
+        sumPower += std::pow(10.0, db / 10.0);
+        r.maxAliasDb = std::max(r.maxAliasDb, db);
+      }
+      r.meanAliasDb = 10.0 * std::log10(sumPower / static_cast<double>(bins.size()));
+
+      Processor proc(method, type, config);
+      for (size_t b = 0; b < 16; ++b) proc.process(sweep.data() + (b % numBlocks) * block, out.data(), block);
+      Performance::Benchmark bench("saturation");
+      for (size_t b = 0; b < numBlocks; ++b) {
+        BENCHMARK_SCOPE(bench);
+        proc.process(sweep.data() + b * block, out.data(), block);
+      }
+      const double meanMs = bench.getAverageTime();
+      r.nsPerSample = 1e6 * meanMs / static_cast<double>(block);
+      r.realtimeFactor = meanMs > 0.0 ? blockMs / meanMs : 0.0;
+      results.push_back(r);
+    }
+  }
+  return results;
+}
+
+void printSaturationBenchmark(const std::vector<SaturationBenchmarkResult>& results) {
+  std::cout << "\n=== Saturation: repliement vs CPU ===" << std::endl;
+  std::cout << std::setw(7) << "shaper" << std::setw(9) << "method"
+            << std::setw(10) << "ns/smp" << std::setw(10) << "x RT"
+            << std::setw(13) << "alias moy dB" << std::setw(13) << "alias max dB" << std::endl;
+  std::cout << std::fixed;
+  for (const auto& r : results) {
+    std::cout << std::setw(7) << typeName(r.type) << std::setw(9) << methodName(r.method)
+              << std::setprecision(2) << std::setw(10) << r.nsPerSample
+              << std::setprecision(0) << std::setw(10) << r.realtimeFactor
+              << std::setprecision(1) << std::setw(13) << r.meanAliasDb << std::setw(13) << r.maxAliasDb << std::endl;
+  }
+}
+
+} // namespace AudioFX
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "Saturation.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AudioFX {
+
+enum class SaturationMethod : int {
+  Direct = 0,          // shaper sans anti-repliement
+  ADAA = 1,            // primitive 1er ordre (SaturationEffect)
+  Oversampled4x = 2    // shaper direct à 4 fs, FIR polyphase 128 prises montée/descente
+};
+
+struct SaturationBenchmarkResult {
+  SaturationType type = SaturationType::Tanh;
+  SaturationMethod method = SaturationMethod::Direct;
+  double nsPerSample = 0.0;
+  double realtimeFactor = 0.0; // durée audio / temps de calcul
+  double meanAliasDb = 0.0;    // énergie repliée / fondamentale, moyenne sur le balayage
+  double maxAliasDb = 0.0;     // pire point du balayage
+};
+
+struct SaturationBenchmarkConfig {
+  uint32_t sampleRate = 48000;
+  size_t blockSize = 512;
+  double seconds = 2.0;        // glissando mesuré pour le CPU
+  double driveDb = 18.0;
+  double amplitude = 0.5;
+  // Balayage par paliers : sinus cohérents (bin FFT impair), log de minHz à maxHz
+  double minHz = 500.0;
+  double maxHz = 16000.0;
+  size_t sweepSteps = 24;
+  size_t fftSize = 8192;
+};
+
+// Repliement vs CPU : direct, ADAA et suréchantillonnage 4x pour chaque shaper.
+// Le repliement compte l'énergie hors harmoniques de la fondamentale (harmoniques au-delà de
+// Nyquist repliées), le CPU est mesuré sur un sinus glissant 20 Hz -> 20 kHz.
+std::vector<SaturationBenchmarkResult> runSaturationBenchmark(const SaturationBenchmarkConfig& config = {});
+void printSaturationBenchmark(const std::vector<SaturationBenchmarkResult>& results);
+
+} // namespace AudioFX
+
+#endif // __cplusplus
@@ -0,0 +1,801 @@
+#include "AudioFileWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/falloc.h>
+#endif
+
+#ifdef FFMPEG_AVAILABLE
+extern "C" {
+    #include <libavformat/avformat.h>
+    #include <libavcodec/avcodec.h>
+    #include <libavutil/channel_layout.h>
+}
+#endif
+
+namespace AudioIO {
+
+namespace {
+
+constexpr size_t kBlockAlign = 4096;        // en-tête WAV/W64 et lots alignés sur cette taille
+constexpr size_t kStagingFrames = 2048;     // conversion float -> format disque par tranche
+constexpr uint64_t kWavMaxBytes = 0xFFFFFFFFull;
+
+// GUID Wave64 (champs little-endian)
+constexpr uint8_t kW64Riff[16] = {0x72, 0x69, 0x66, 0x66, 0x2E, 0x91, 0xCF, 0x11,
+                                  0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00};
+constexpr uint8_t kW64Wave[16] = {0x77, 0x61, 0x76, 0x65, 0xF3, 0xAC, 0xD3, 0x11,
+                                  0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A};
+constexpr uint8_t kW64Fmt[16]  = {0x66, 0x6D, 0x74, 0x20, 0xF3, 0xAC, 0xD3, 0x11,
+                                  0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A};
+constexpr uint8_t kW64Junk[16] = {0x6A, 0x75, 0x6E, 0x6B, 0xF3, 0xAC, 0xD3, 0x11,
+                                  0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A};
+constexpr uint8_t kW64Data[16] = {0x64, 0x61, 0x74, 0x61, 0xF3, 0xAC, 0xD3, 0x11,
+                                  0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A};
+
+void putLE16(uint8_t* p, uint16_t v) { p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); }
+void putLE32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = uint8_t(v >> (8 * i)); }
+void putLE64(uint8_t* p, uint64_t v) { for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * i)); }
+uint32_t getLE32(const uint8_t* p) { uint32_t v = 0; for (int i = 3; i >= 0; --i) v = (v << 8) | p[i]; return v; }
+uint64_t getLE64(const uint8_t* p) { uint64_t v = 0; for (int i = 7; i >= 0; --i) v = (v << 8) | p[i]; return v; }
+
+bool pwriteAll(int fd, const void* data, size_t size, uint64_t offset) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t w = ::pwrite(fd, p, size, static_cast<off_t>(offset));
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += w; size -= static_cast<size_t>(w); offset += static_cast<uint64_t>(w);
+    }
+    return true;
+}
+
+bool preadAll(int fd, void* data, size_t size, uint64_t offset) {
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t r = ::pread(fd, p, size, static_cast<off_t>(offset));
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r; size -= static_cast<size_t>(r); offset += static_cast<uint64_t>(r);
+    }
+    return true;
+}
+
+size_t bytesPerSample(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16: return 2;
+        case SampleFormat::Int24: return 3;
+        case SampleFormat::Float32: return 4;
+    }
+    return 2;
+}
+
+// float -> PCM little-endian, écrêtage à [-1, 1]
+void convertSamples(const float* in, size_t count, SampleFormat format, uint8_t* out) {
+    switch (format) {
+        case SampleFormat::Int16:
+            for (size_t i = 0; i < count; ++i) {
+                const float v = std::max(-1.0f, std::min(1.0f, in[i]));
+                putLE16(out + 2 * i, static_cast<uint16_t>(static_cast<int16_t>(std::lrint(v * 32767.0f))));
+            }
+            break;
+        case SampleFormat::Int24:
+            for (size_t i = 0; i < count; ++i) {
+                const float v = std::max(-1.0f, std::min(1.0f, in[i]));
+                const uint32_t s = static_cast<uint32_t>(static_cast<int32_t>(std::lrint(v * 8388607.0f)));
+                out[3 * i] = uint8_t(s); out[3 * i + 1] = uint8_t(s >> 8); out[3 * i + 2] = uint8_t(s >> 16);
+            }
+            break;
+        case SampleFormat::Float32:
+            std::memcpy(out, in, count * sizeof(float));   // cibles little-endian (ARM, x86)
+            break;
+    }
+}
+
+} // namespace
+
+// ===== ChunkedFileSink =====
+
+// Écritures séquentielles regroupées en lots alignés; le lot partiel peut être écrit
+// (point de contrôle) puis réécrit complet au même offset. Réserve disque par extensions.
+class ChunkedFileSink {
+public:
+    ~ChunkedFileSink() { if (m_fd >= 0) ::close(m_fd); }
+
+    bool open(const std::string& path, size_t chunkBytes, uint64_t preallocBytes, std::string& error) {
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m_fd < 0) { error = "Ouverture impossible: " + path + " (" + std::strerror(errno) + ")"; return false; }
+        m_capacity = std::max(kBlockAlign, (chunkBytes + kBlockAlign - 1) / kBlockAlign * kBlockAlign);
+        m_buffer.reset(static_cast<uint8_t*>(::operator new[](m_capacity, std::align_val_t(kBlockAlign))));
+        m_preallocBytes = preallocBytes;
+        return true;
+    }
+
+    bool append(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            const size_t n = std::min(m_capacity - m_fill, size);
+            std::memcpy(m_buffer.get() + m_fill, p, n);
+            m_fill += n; p += n; size -= n;
+            if (m_fill == m_capacity) {
+                if (!writeBuffer()) return false;
+                m_base += m_capacity;
+                m_fill = 0;
+            }
+        }
+        m_size = std::max(m_size, position());
+        return true;
+    }
+
+    // Lot partiel sur disque; il reste en mémoire et sera réécrit complet
+    bool flush() { return m_fill == 0 || writeBuffer(); }
+
+    bool seek(uint64_t pos) {
+        if (pos == position()) return true;
+        if (!flush()) return false;
+        m_base = pos;
+        m_fill = 0;
+        return true;
+    }
+
+    // Hors lot (en-têtes); garde le lot cohérent s'il couvre la zone
+    bool writeAt(uint64_t offset, const void* data, size_t size) {
+        if (offset < m_base + m_fill && offset + size > m_base) {
+            const uint64_t from = std::max(offset, m_base);
+            const uint64_t to = std::min(offset + size, m_base + m_fill);
+            std::memcpy(m_buffer.get() + (from - m_base), static_cast<const uint8_t*>(data) + (from - offset), to - from);
+        }
+        ++m_writeCalls;
+        return pwriteAll(m_fd, data, size, offset);
+    }
+
+    bool sync() {
+#if defined(__APPLE__)
+        return ::fsync(m_fd) == 0;
+#else
+        return ::fdatasync(m_fd) == 0;
+#endif
+    }
+
+    bool close() {
+        bool ok = flush();
+        if (m_fd >= 0) {
+            // Réserve non utilisée rendue (KEEP_SIZE : taille logique déjà exacte)
+            ok = ::ftruncate(m_fd, static_cast<off_t>(m_size)) == 0 && ok;
+            ok = sync() && ok;
+            ok = ::close(m_fd) == 0 && ok;
+            m_fd = -1;
+        }
+        return ok;
+    }
+
+    uint64_t position() const { return m_base + m_fill; }
+    uint64_t size() const { return m_size; }
+    uint64_t getWriteCalls() const { return m_writeCalls; }
+
+private:
+    struct AlignedDelete {
+        void operator()(uint8_t* p) const noexcept { ::operator delete[](p, std::align_val_t(kBlockAlign)); }
+    };
+
+    bool writeBuffer() {
+        reserve(m_base + m_fill);
+        ++m_writeCalls;
+        return pwriteAll(m_fd, m_buffer.get(), m_fill, m_base);
+    }
+
+    // Au mieux : un échec de réservation n'empêche pas l'écriture
+    void reserve(uint64_t end) {
+        if (end <= m_reserved || m_preallocBytes == 0) return;
+        const uint64_t target = end + m_preallocBytes;
+#if defined(__linux__)
+        ::fallocate(m_fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(m_reserved), static_cast<off_t>(target - m_reserved));
+#elif defined(__APPLE__)
+        fstore_t store = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(target - m_reserved), 0};
+        if (::fcntl(m_fd, F_PREALLOCATE, &store) == -1) {
+            store.fst_flags = F_ALLOCATEALL;
+            ::fcntl(m_fd, F_PREALLOCATE, &store);
+        }
+#endif
+        m_reserved = target;
+    }
+
+    int m_fd = -1;
+    std::unique_ptr<uint8_t[], AlignedDelete> m_buffer;
+    size_t m_capacity = 0;
+    size_t m_fill = 0;
+    uint64_t m_base = 0;        // offset fichier de m_buffer[0]
+    uint64_t m_size = 0;        // plus grande position écrite
+    uint64_t m_reserved = 0;
+    uint64_t m_preallocBytes = 0;
+    uint64_t m_writeCalls = 0;
+};
+
+// ===== Encodeurs (thread d'E/S uniquement) =====
+
+class AudioFileWriter::Encoder {
+public:
+    virtual ~Encoder() = default;
+    virtual bool begin(const std::string& path, const AudioFileWriterConfig& config, std::string& error) = 0;
+    virtual bool encode(const float* interleaved, size_t frames, std::string& error) = 0;
+    virtual bool checkpoint(std::string& error) = 0;
+    virtual bool finish(std::string& error) = 0;
+    virtual uint64_t getBytesWritten() const = 0;
+    virtual uint64_t getWriteCalls() const = 0;
+};
+
+class AudioFileWriter::PcmEncoder final : public AudioFileWriter::Encoder {
+public:
+    bool begin(const std::string& path, const AudioFileWriterConfig& config, std::string& error) override {
+        m_w64 = config.format == AudioFileFormat::W64;
+        m_format = config.sampleFormat;
+        m_channels = static_cast<size_t>(config.numChannels);
+        const uint64_t bytesPerSecond = uint64_t(config.sampleRate) * m_channels * bytesPerSample(m_format);
+        const uint64_t prealloc = static_cast<uint64_t>(std::max(0.0, config.preallocateSeconds) * bytesPerSecond);
+        if (!m_sink.open(path, config.chunkBytes, prealloc, error)) return false;
+        m_staging.resize(kStagingFrames * m_channels * bytesPerSample(m_format));
+
+        uint8_t header[kBlockAlign] = {0};
+        const uint16_t bits = static_cast<uint16_t>(8 * bytesPerSample(m_format));
+        const uint16_t blockAlign = static_cast<uint16_t>(m_channels * bytesPerSample(m_format));
+        auto putFmt = [&](uint8_t* p) {
+            putLE16(p, m_format == SampleFormat::Float32 ? 3 : 1);   // IEEE float / PCM
+            putLE16(p + 2, static_cast<uint16_t>(m_channels));
+            putLE32(p + 4, config.sampleRate);
+            putLE32(p + 8, config.sampleRate * blockAlign);
+            putLE16(p + 12, blockAlign);
+            putLE16(p + 14, bits);
+        };
+        if (m_w64) {
+            // riff(40) fmt(24+16) junk(24+3968) data(24) : données à 4096 (tailles GUID incluses)
+            std::memcpy(header, kW64Riff, 16);
+            std::memcpy(header + 24, kW64Wave, 16);
+            std::memcpy(header + 40, kW64Fmt, 16);
+            putLE64(header + 56, 40);
+            putFmt(header + 64);
+            std::memcpy(header + 80, kW64Junk, 16);
+            putLE64(header + 96, kBlockAlign - 80 - 24);
+            std::memcpy(header + kBlockAlign - 24, kW64Data, 16);
+        } else {
+            // RIFF(12) fmt(8+16) JUNK(8+4044) data(8) : données à 4096
+            std::memcpy(header, "RIFF", 4);
+            std::memcpy(header + 8, "WAVE", 4);
+            std::memcpy(header + 12, "fmt ", 4);
+            putLE32(header + 16, 16);
+            putFmt(header + 20);
+            std::memcpy(header + 36, "JUNK", 4);
+            putLE32(header + 40, static_cast<uint32_t>(kBlockAlign - 52));
+            std::memcpy(header + kBlockAlign - 8, "data", 4);
+        }
+        writeSizes(header, 0);
+        // En-tête sur disque dès l'ouverture : fichier valide (vide) avant le premier lot
+        if (!m_sink.append(header, sizeof(header)) || !m_sink.flush()) { error = "Écriture de l'en-tête impossible"; return false; }
+        return true;
+    }
+
+    bool encode(const float* interleaved, size_t frames, std::string& error) override {
+        const size_t frameBytes = m_channels * bytesPerSample(m_format);
+        if (!m_w64 && kBlockAlign + m_dataBytes + frames * frameBytes > kWavMaxBytes) {
+            error = "Limite WAV de 4 Go atteinte (utiliser W64)";
+            return false;
+        }
+        while (frames > 0) {
+            const size_t n = std::min(frames, kStagingFrames);
+            convertSamples(interleaved, n * m_channels, m_format, m_staging.data());
+            if (!m_sink.append(m_staging.data(), n * frameBytes)) { error = "Écriture impossible"; return false; }
+            m_dataBytes += n * frameBytes;
+            interleaved += n * m_channels;
+            frames -= n;
+        }
+        return true;
+    }
+
+    bool checkpoint(std::string& error) override {
+        if (!m_sink.flush() || !patchSizes()) { error = "Point de contrôle impossible"; return false; }
+        return true;
+    }
+
+    bool finish(std::string& error) override {
+        bool ok = true;
+        // RIFF : bloc de données de taille paire (24 bits mono, nombre impair de trames)
+        if (!m_w64 && (m_dataBytes & 1)) { const uint8_t pad = 0; ok = m_sink.append(&pad, 1); }
+        ok = m_sink.flush() && patchSizes() && ok;
+        ok = m_sink.close() && ok;
+        if (!ok) error = "Finalisation du fichier impossible";
+        return ok;
+    }
+
+    uint64_t getBytesWritten() const override { return m_dataBytes; }
+    uint64_t getWriteCalls() const override { return m_sink.getWriteCalls(); }
+
+private:
+    void writeSizes(uint8_t* header, uint64_t dataBytes) const {
+        if (m_w64) {
+            putLE64(header + 16, kBlockAlign + dataBytes);
+            putLE64(header + kBlockAlign - 8, 24 + dataBytes);
+        } else {
+            const uint64_t padded = dataBytes + (dataBytes & 1);
+            putLE32(header + 4, static_cast<uint32_t>(kBlockAlign - 8 + padded));
+            putLE32(header + kBlockAlign - 4, static_cast<uint32_t>(dataBytes));
+        }
+    }
+
+    bool patchSizes() {
+        uint8_t header[kBlockAlign];
+        writeSizes(header, m_dataBytes);
+        if (m_w64) {
+            return m_sink.writeAt(16, header + 16, 8) &&
+                   m_sink.writeAt(kBlockAlign - 8, header + kBlockAlign - 8, 8);
+        }
+        return m_sink.writeAt(4, header + 4, 4) &&
+               m_sink.writeAt(kBlockAlign - 4, header + kBlockAlign - 4, 4);
+    }
+
+    ChunkedFileSink m_sink;
+    std::vector<uint8_t> m_staging;
+    SampleFormat m_format = SampleFormat::Int16;
+    size_t m_channels = 2;
+    bool m_w64 = false;
+    uint64_t m_dataBytes = 0;
+};
+
+#ifdef FFMPEG_AVAILABLE
+// FLAC via libavcodec; le muxer écrit dans le même puits à lots (AVIO personnalisé)
+class AudioFileWriter::FlacEncoder final : public AudioFileWriter::Encoder {
+public:
+    ~FlacEncoder() override { release(); }
+
+    bool begin(const std::string& path, const AudioFileWriterConfig& config, std::string& error) override {
+        m_channels = static_cast<size_t>(config.numChannels);
+        m_s16 = config.sampleFormat == SampleFormat::Int16;
+        // Débit FLAC inconnu : réserve sur la base de ~60 % du PCM
+        const uint64_t pcmPerSecond = uint64_t(config.sampleRate) * m_channels * (m_s16 ? 2 : 3);
+        const uint64_t prealloc = static_cast<uint64_t>(std::max(0.0, config.preallocateSeconds) * pcmPerSecond * 0.6);
+        if (!m_sink.open(path, config.chunkBytes, prealloc, error)) return false;
+
+        const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_FLAC);
+        if (!codec) { error = "Encodeur FLAC indisponible"; return false; }
+        if (avformat_alloc_output_context2(&m_fmt, nullptr, "flac", nullptr) < 0 || !m_fmt) {
+            error = "Muxer FLAC indisponible"; return false;
+        }
+        m_enc = avcodec_alloc_context3(codec);
+        if (!m_enc) { error = "Encodeur FLAC"; return false; }
+        m_enc->sample_rate = static_cast<int>(config.sampleRate);
+        m_enc->sample_fmt = m_s16 ? AV_SAMPLE_FMT_S16 : AV_SAMPLE_FMT_S32;
+        m_enc->bits_per_raw_sample = m_s16 ? 16 : 24;
+        m_enc->time_base = AVRational{1, static_cast<int>(config.sampleRate)};
+        av_channel_layout_default(&m_enc->ch_layout, config.numChannels);
+        if (avcodec_open2(m_enc, codec, nullptr) < 0) { error = "Ouverture de l'encodeur FLAC"; return false; }
+
+        m_stream = avformat_new_stream(m_fmt, nullptr);
+        if (!m_stream || avcodec_parameters_from_context(m_stream->codecpar, m_enc) < 0) {
+            error = "Flux FLAC"; return false;
+        }
+        m_stream->time_base = m_enc->time_base;
+
+        constexpr int kAvioBuffer = 64 * 1024;
+        auto* buffer = static_cast<unsigned char*>(av_malloc(kAvioBuffer));
+        m_avio = buffer ? avio_alloc_context(buffer, kAvioBuffer, 1, this, nullptr, &FlacEncoder::writePacket, &FlacEncoder::seekPacket) : nullptr;
+        if (!m_avio) { av_free(buffer); error = "Contexte AVIO"; return false; }
+        m_avio->seekable = AVIO_SEEKABLE_NORMAL;
+        m_fmt->pb = m_avio;
+        m_fmt->flags |= AVFMT_FLAG_CUSTOM_IO;
+        if (avformat_write_header(m_fmt, nullptr) < 0) { error = "En-tête FLAC"; return false; }
+
+        m_frame = av_frame_alloc();
+        m_pkt = av_packet_alloc();
+        if (!m_frame || !m_pkt) { error = "Allocation FLAC"; return false; }
+        m_frame->nb_samples = m_enc->frame_size > 0 ? m_enc->frame_size : 4096;
+        m_frame->format = m_enc->sample_fmt;
+        m_frame->sample_rate = m_enc->sample_rate;
+        if (av_channel_layout_copy(&m_frame->ch_layout, &m_enc->ch_layout) < 0 || av_frame_get_buffer(m_frame, 0) < 0) {
+            error = "Trame FLAC"; return false;
+        }
+        m_frameCapacity = static_cast<size_t>(m_frame->nb_samples);
+        return true;
+    }
+
+    bool encode(const float* interleaved, size_t frames, std::string& error) override {
+        while (frames > 0) {
+            if (m_frameFill == 0 && av_frame_make_writable(m_frame) < 0) { error = "Trame FLAC"; return false; }
+            const size_t n = std::min(frames, m_frameCapacity - m_frameFill);
+            const size_t count = n * m_channels;
+            if (m_s16) {
+                auto* dst = reinterpret_cast<int16_t*>(m_frame->data[0]) + m_frameFill * m_channels;
+                for (size_t i = 0; i < count; ++i) {
+                    dst[i] = static_cast<int16_t>(std::lrint(std::max(-1.0f, std::min(1.0f, interleaved[i])) * 32767.0f));
+                }
+            } else {
+                // S32 avec 24 bits utiles : échantillon dans les bits de poids fort
+                auto* dst = reinterpret_cast<int32_t*>(m_frame->data[0]) + m_frameFill * m_channels;
+                for (size_t i = 0; i < count; ++i) {
+                    dst[i] = static_cast<int32_t>(std::lrint(std::max(-1.0f, std::min(1.0f, interleaved[i])) * 8388607.0f)) * 256;
+                }
+            }
+            m_frameFill += n;
+            interleaved += count;
+            frames -= n;
+            m_pcmBytes += count * (m_s16 ? 2 : 3);
+            if (m_frameFill == m_frameCapacity && !sendFrame(error)) return false;
+        }
+        return true;
+    }
+
+    bool checkpoint(std::string& error) override {
+        // Trames FLAC déjà encodées poussées vers le disque; la trame partielle attend
+        avio_flush(m_avio);
+        if (m_ioFailed || !m_sink.flush()) { error = "Point de contrôle FLAC impossible"; return false; }
+        return true;
+    }
+
+    bool finish(std::string& error) override {
+        bool ok = true;
+        if (m_frameFill > 0) {
+            m_frame->nb_samples = static_cast<int>(m_frameFill);
+            ok = sendFrame(error);
+        }
+        if (ok && avcodec_send_frame(m_enc, nullptr) >= 0) ok = drainPackets(error);
+        // Trailer : STREAMINFO (nombre d'échantillons, MD5) réécrit en tête via seek
+        ok = av_write_trailer(m_fmt) >= 0 && ok;
+        avio_flush(m_avio);
+        ok = !m_ioFailed && m_sink.close() && ok;
+        if (!ok && error.empty()) error = "Finalisation FLAC impossible";
+        release();
+        return ok;
+    }
+
+    uint64_t getBytesWritten() const override { return m_pcmBytes; }
+    uint64_t getWriteCalls() const override { return m_sink.getWriteCalls(); }
+
+private:
+    static int writePacket(void* opaque, const uint8_t* buf, int size) {
+        auto* self = static_cast<FlacEncoder*>(opaque);
+        if (!self->m_sink.append(buf, static_cast<size_t>(size))) { self->m_ioFailed = true; return AVERROR(EIO); }
+        return size;
+    }
+
+    static int64_t seekPacket(void* opaque, int64_t offset, int whence) {
+        auto* self = static_cast<FlacEncoder*>(opaque);
+        whence &= ~AVSEEK_FORCE;
+        if (whence == AVSEEK_SIZE) return static_cast<int64_t>(std::max(self->m_sink.size(), self->m_sink.position()));
+        int64_t target = offset;
+        if (whence == SEEK_CUR) target += static_cast<int64_t>(self->m_sink.position());
+        else if (whence == SEEK_END) target += static_cast<int64_t>(self->m_sink.size());
+        if (target < 0 || !self->m_sink.seek(static_cast<uint64_t>(target))) return AVERROR(EIO);
+        return target;
+    }
+
+    bool sendFrame(std::string& error) {
+        m_frame->pts = m_pts;
+        m_pts += m_frame->nb_samples;
+        if (avcodec_send_frame(m_enc, m_frame) < 0) { error = "Encodage FLAC"; return false; }
+        m_frameFill = 0;
+        return drainPackets(error);
+    }
+
+    bool drainPackets(std::string& error) {
+        for (;;) {
+            const int r = avcodec_receive_packet(m_enc, m_pkt);
+            if (r == AVERROR(EAGAIN) || r == AVERROR_EOF) return true;
+            if (r < 0) { error = "Encodage FLAC"; return false; }
+            m_pkt->stream_index = m_stream->index;
+            av_packet_rescale_ts(m_pkt, m_enc->time_base, m_stream->time_base);
+            const int w = av_write_frame(m_fmt, m_pkt);
+            av_packet_unref(m_pkt);
+            if (w < 0 || m_ioFailed) { error = "Écriture FLAC impossible"; return false; }
+        }
+    }
+
+    void release() {
+        av_frame_free(&m_frame);
+        av_packet_free(&m_pkt);
+        avcodec_free_context(&m_enc);
+        if (m_fmt) { m_fmt->pb = nullptr; avformat_free_context(m_fmt); m_fmt = nullptr; }
+        if (m_avio) { av_freep(&m_avio->buffer); avio_context_free(&m_avio); }
+    }
+
+    ChunkedFileSink m_sink;
+    AVFormatContext* m_fmt = nullptr;
+    AVCodecContext* m_enc = nullptr;
+    AVStream* m_stream = nullptr;
+    AVIOContext* m_avio = nullptr;
+    AVFrame* m_frame = nullptr;
+    AVPacket* m_pkt = nullptr;
+    size_t m_channels = 2;
+    size_t m_frameCapacity = 0;
+    size_t m_frameFill = 0;
+    int64_t m_pts = 0;
+    uint64_t m_pcmBytes = 0;
+    bool m_s16 = false;
+    bool m_ioFailed = false;
+};
+#endif // FFMPEG_AVAILABLE
+
+// ===== AudioFileWriter =====
+
+AudioFileWriter::AudioFileWriter() = default;
+
+AudioFileWriter::~AudioFileWriter() {
+    close();
+}
+
+bool AudioFileWriter::open(const std::string& path, const AudioFileWriterConfig& config, std::string& error) {
+    close();
+    if (config.numChannels < 1 || config.numChannels > 8 || config.sampleRate == 0) {
+        error = "Format audio invalide";
+        return false;
+    }
+    m_config = config;
+    m_config.checkpointSeconds = std::max(0.05, config.checkpointSeconds);
+
+    if (config.format == AudioFileFormat::FLAC) {
+#ifdef FFMPEG_AVAILABLE
+        m_encoder = std::make_unique<FlacEncoder>();
+#else
+        error = "FLAC indisponible (FFmpeg absent)";
+        return false;
+#endif
+    } else {
+        m_encoder = std::make_unique<PcmEncoder>();
+    }
+    if (!m_encoder->begin(path, m_config, error)) {
+        m_encoder.reset();
+        return false;
+    }
+
+    const size_t channels = static_cast<size_t>(config.numChannels);
+    const size_t capacityFrames = std::max<size_t>(4096, static_cast<size_t>(std::max(0.1, config.queueSeconds) * config.sampleRate));
+    m_queue.assign(capacityFrames * channels, 0.0f);
+    m_writePos.store(0);
+    m_readPos.store(0);
+    m_framesQueued.store(0);
+    m_framesDropped.store(0);
+    m_framesWritten.store(0);
+    m_maxFillSamples.store(0);
+    m_failed.store(false);
+    m_stopRequested.store(false);
+    {
+        std::lock_guard<std::mutex> lk(m_errorMutex);
+        m_lastError.clear();
+    }
+    m_ioThread = std::thread(&AudioFileWriter::ioLoop, this);
+    m_accepting.store(true, std::memory_order_release);
+    return true;
+}
+
+bool AudioFileWriter::reserveWriter() noexcept {
+    if (!m_accepting.load(std::memory_order_acquire)) return false;
+    // Dekker avec close() : annonce puis revérifie (seq_cst des deux côtés)
+    m_producerActive.store(true);
+    if (!m_accepting.load()) {
+        releaseWriter();
+        return false;
+    }
+    return true;
+}
+
+bool AudioFileWriter::write(const float* interleaved, size_t frames) noexcept {
+    if (!interleaved || frames == 0) return false;
+    return pushInterleaved(nullptr, interleaved, frames);
+}
+
+bool AudioFileWriter::writePlanar(const float* const* channels, size_t frames) noexcept {
+    if (!channels || frames == 0) return false;
+    return pushInterleaved(channels, nullptr, frames);
+}
+
+bool AudioFileWriter::pushInterleaved(const float* const* channels, const float* interleaved, size_t frames) noexcept {
+    if (!reserveWriter()) return false;
+    const size_t numCh = static_cast<size_t>(m_config.numChannels);
+    const size_t capacity = m_queue.size();
+    const size_t samples = frames * numCh;
+    const uint64_t w = m_writePos.load(std::memory_order_relaxed);
+    const uint64_t r = m_readPos.load(std::memory_order_acquire);
+    if (m_failed.load(std::memory_order_relaxed) || samples > capacity - static_cast<size_t>(w - r)) {
+        m_framesDropped.fetch_add(frames, std::memory_order_relaxed);
+        releaseWriter();
+        return false;
+    }
+
+    float* q = m_queue.data();
+    size_t idx = static_cast<size_t>(w % capacity);
+    if (interleaved) {
+        const size_t first = std::min(samples, capacity - idx);
+        std::memcpy(q + idx, interleaved, first * sizeof(float));
+        std::memcpy(q, interleaved + first, (samples - first) * sizeof(float));
+    } else {
+        for (size_t i = 0; i < frames; ++i) {
+            for (size_t c = 0; c < numCh; ++c) {
+                q[idx] = channels[c][i];
+                if (++idx == capacity) idx = 0;
+            }
+        }
+    }
+    m_writePos.store(w + samples, std::memory_order_release);
+    m_framesQueued.fetch_add(frames, std::memory_order_relaxed);
+
+    const uint64_t fill = w + samples - r;
+    if (fill > m_maxFillSamples.load(std::memory_order_relaxed)) m_maxFillSamples.store(fill, std::memory_order_relaxed);
+    releaseWriter();
+    return true;
+}
+
+void AudioFileWriter::ioLoop() {
+    using Clock = std::chrono::steady_clock;
+    const size_t numCh = static_cast<size_t>(m_config.numChannels);
+    const size_t capacity = m_queue.size();
+    // Lot : au moins chunkBytes d'entrée float (~ un lot disque), par trames entières
+    const size_t batchSamples = std::max<size_t>(numCh, std::min(capacity / 2, m_config.chunkBytes / sizeof(float)) / numCh * numCh);
+    const auto checkpointEvery = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_config.checkpointSeconds));
+    auto nextCheckpoint = Clock::now() + checkpointEvery;
+    bool dirty = false;
+    std::string error;
+
+    for (;;) {
+        const bool stopping = m_stopRequested.load(std::memory_order_acquire);
+        const uint64_t r = m_readPos.load(std::memory_order_relaxed);
+        const uint64_t w = m_writePos.load(std::memory_order_acquire);
+        const size_t available = static_cast<size_t>(w - r);
+        const bool due = Clock::now() >= nextCheckpoint;
+
+        if (available > 0 && m_failed.load(std::memory_order_relaxed)) {
+            // Échec d'écriture : la file ne sera plus vidée, on abandonne l'arriéré
+            m_readPos.store(w, std::memory_order_release);
+            if (stopping) break;
+            continue;
+        }
+        if (available >= batchSamples || (available > 0 && (stopping || due))) {
+            size_t todo = std::min(available, batchSamples);
+            uint64_t pos = r;
+            while (todo > 0 && !m_failed.load(std::memory_order_relaxed)) {
+                const size_t idx = static_cast<size_t>(pos % capacity);
+                const size_t n = std::min(todo, capacity - idx);   // trames entières : capacité multiple de numCh
+                if (m_encoder->encode(m_queue.data() + idx, n / numCh, error)) {
+                    m_framesWritten.fetch_add(n / numCh, std::memory_order_relaxed);
+                } else {
+                    setError(error);
+                    m_failed.store(true);
+                }
+                pos += n;
+                todo -= n;
+            }
+            m_readPos.store(pos, std::memory_order_release);
+            m_bytesWritten.store(m_encoder->getBytesWritten(), std::memory_order_relaxed);
+            m_writeCalls.store(m_encoder->getWriteCalls(), std::memory_order_relaxed);
+            dirty = true;
+            continue;
+        }
+
+        if (dirty && (due || stopping) && !m_failed.load(std::memory_order_relaxed)) {
+            if (!m_encoder->checkpoint(error)) {
+                setError(error);
+                m_failed.store(true);
+            }
+            dirty = false;
+        }
+        if (due) nextCheckpoint = Clock::now() + checkpointEvery;
+        if (stopping) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+bool AudioFileWriter::close() {
+    if (!m_ioThread.joinable()) return true;
+    m_accepting.store(false);
+    while (m_producerActive.load()) std::this_thread::yield();
+    m_stopRequested.store(true, std::memory_order_release);
+    m_ioThread.join();
+
+    std::string error;
+    bool ok = !m_failed.load();
+    if (!m_encoder->finish(error)) {
+        setError(error);
+        ok = false;
+    }
+    m_bytesWritten.store(m_encoder->getBytesWritten(), std::memory_order_relaxed);
+    m_writeCalls.store(m_encoder->getWriteCalls(), std::memory_order_relaxed);
+    m_encoder.reset();
+    m_queue.clear();
+    m_queue.shrink_to_fit();
+    return ok;
+}
+
+AudioFileWriterStats AudioFileWriter::getStats() const {
+    AudioFileWriterStats s;
+    s.framesQueued = m_framesQueued.load(std::memory_order_relaxed);
+    s.framesWritten = m_framesWritten.load(std::memory_order_relaxed);
+    s.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+    s.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    s.writeCalls = m_writeCalls.load(std::memory_order_relaxed);
+    const size_t capacity = m_queue.size();
+    s.maxQueueFill = capacity > 0 ? static_cast<double>(m_maxFillSamples.load(std::memory_order_relaxed)) / capacity : 0.0;
+    return s;
+}
+
+std::string AudioFileWriter::getLastError() const {
+    std::lock_guard<std::mutex> lk(m_errorMutex);
+    return m_lastError;
+}
+
+void AudioFileWriter::setError(const std::string& error) {
+    std::lock_guard<std::mutex> lk(m_errorMutex);
+    if (m_lastError.empty()) m_lastError = error;
+}
+
+bool AudioFileWriter::repairHeader(const std::string& path, std::string& error) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) { error = "Ouverture impossible: " + path; return false; }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) { ::close(fd); error = "stat impossible"; return false; }
+    const uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+
+    uint8_t head[40] = {0};
+    bool ok = false;
+    if (fileSize >= 40 && preadAll(fd, head, sizeof(head), 0)) {
+        if (std::memcmp(head, "RIFF", 4) == 0 && std::memcmp(head + 8, "WAVE", 4) == 0) {
+            // Parcours des blocs RIFF jusqu'à "data"
+            uint64_t off = 12;
+            uint32_t blockAlign = 1;
+            uint8_t ck[16];
+            while (off + 8 <= fileSize && preadAll(fd, ck, 8, off)) {
+                const uint32_t size = getLE32(ck + 4);
+                if (std::memcmp(ck, "fmt ", 4) == 0 && size >= 16 && preadAll(fd, ck, 16, off + 8)) {
+                    blockAlign = std::max<uint32_t>(1, ck[12] | (uint32_t(ck[13]) << 8));
+                } else if (std::memcmp(ck, "data", 4) == 0) {
+                    uint64_t data = fileSize - (off + 8);
+                    data = std::min<uint64_t>(data - data % blockAlign, kWavMaxBytes - (off + 8));
+                    uint8_t v[4];
+                    putLE32(v, static_cast<uint32_t>(data));
+                    ok = pwriteAll(fd, v, 4, off + 4);
+                    putLE32(v, static_cast<uint32_t>(off + 8 + data + (data & 1) - 8));
+                    ok = pwriteAll(fd, v, 4, 4) && ok;
+                    break;
+                }
+                off += 8 + size + (size & 1);
+            }
+            if (!ok) error = "Bloc data introuvable";
+        } else if (std::memcmp(head, kW64Riff, 16) == 0 && std::memcmp(head + 24, kW64Wave, 16) == 0) {
+            uint64_t off = 40;
+            uint32_t blockAlign = 1;
+            uint8_t ck[24];
+            while (off + 24 <= fileSize && preadAll(fd, ck, 24, off)) {
+                const uint64_t size = getLE64(ck + 16);
+                if (std::memcmp(ck, kW64Fmt, 16) == 0 && size >= 40) {
+                    uint8_t fmt[16];
+                    if (preadAll(fd, fmt, 16, off + 24)) blockAlign = std::max<uint32_t>(1, fmt[12] | (uint32_t(fmt[13]) << 8));
+                } else if (std::memcmp(ck, kW64Data, 16) == 0) {
+                    uint64_t data = fileSize - (off + 24);
+                    data -= data % blockAlign;
+                    uint8_t v[8];
+                    putLE64(v, 24 + data);
+                    ok = pwriteAll(fd, v, 8, off + 16);
+                    putLE64(v, off + 24 + data);
+                    ok = pwriteAll(fd, v, 8, 16) && ok;
+                    break;
+                }
+                if (size < 24) break;
+                off += (size + 7) & ~uint64_t(7);
+            }
+            if (!ok) error = "Bloc data introuvable";
+        } else {
+            error = "Format non reconnu (WAV/W64)";
+        }
+    } else {
+        error = "Fichier tronqué";
+    }
+    ok = ::fsync(fd) == 0 && ok;
+    ::close(fd);
+    return ok;
+}
+
+} // namespace AudioIO
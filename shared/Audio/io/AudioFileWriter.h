@@ -0,0 +1,124 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AudioIO {
+
+enum class AudioFileFormat : int {
+    WAV = 0,    // RIFF, limité à 4 Go de données
+    W64 = 1,    // Sony Wave64, tailles 64 bits
+    FLAC = 2    // via libavcodec (FFMPEG_AVAILABLE)
+};
+
+enum class SampleFormat : int {
+    Int16 = 0,
+    Int24 = 1,
+    Float32 = 2   // WAV/W64 seulement; FLAC : enregistré en 24 bits
+};
+
+struct AudioFileWriterConfig {
+    AudioFileFormat format = AudioFileFormat::WAV;
+    SampleFormat sampleFormat = SampleFormat::Int24;
+    uint32_t sampleRate = 48000;
+    int numChannels = 2;
+    double queueSeconds = 2.0;          // file temps réel : marge si le disque cale
+    size_t chunkBytes = 256 * 1024;     // lot d'écriture, arrondi à 4 Kio
+    double preallocateSeconds = 30.0;   // réserve disque par extension (taille logique inchangée)
+    double checkpointSeconds = 0.5;     // données + en-têtes sur disque au moins à ce rythme
+};
+
+struct AudioFileWriterStats {
+    uint64_t framesQueued = 0;
+    uint64_t framesWritten = 0;
+    uint64_t framesDropped = 0;    // file pleine : trames perdues (le thread audio n'attend jamais)
+    uint64_t bytesWritten = 0;     // octets audio (hors en-têtes)
+    uint64_t writeCalls = 0;       // pwrite issus des lots et points de contrôle
+    double maxQueueFill = 0.0;     // 0..1
+};
+
+class ChunkedFileSink;
+
+// Enregistrement sans perte alimenté par le thread audio.
+//
+// write()/writePlanar() copient dans une file SPSC sans verrou ni allocation; un thread d'E/S
+// convertit, regroupe en lots alignés sur 4 Kio et écrit. WAV/W64 : en-tête complété à 4 Kio par
+// un bloc JUNK (données alignées), réserve disque par fallocate(KEEP_SIZE) / F_PREALLOCATE
+// (la taille du fichier reste celle des données écrites), tailles d'en-tête mises à jour à
+// chaque point de contrôle. Fichier interrompu (crash, kill) : lisible jusqu'au dernier point
+// de contrôle, repairHeader() récupère le reste. FLAC : trames autonomes, STREAMINFO complété
+// à la fermeture.
+//
+// Un seul producteur à la fois. open()/close() hors thread audio; close() peut être appelé
+// pendant que le thread audio écrit (les écritures suivantes sont refusées).
+class AudioFileWriter {
+public:
+    AudioFileWriter();
+    ~AudioFileWriter();
+
+    AudioFileWriter(const AudioFileWriter&) = delete;
+    AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+
+    bool open(const std::string& path, const AudioFileWriterConfig& config, std::string& error);
+
+    // Temps réel. false si fermé ou file pleine (trames comptées dans framesDropped)
+    bool write(const float* interleaved, size_t frames) noexcept;
+    bool writePlanar(const float* const* channels, size_t frames) noexcept;
+
+    // Vide la file, finalise les en-têtes, fdatasync. false si une erreur d'E/S est survenue.
+    bool close();
+
+    bool isOpen() const { return m_accepting.load(std::memory_order_acquire); }
+    const AudioFileWriterConfig& getConfig() const { return m_config; }
+    AudioFileWriterStats getStats() const;
+    std::string getLastError() const;
+
+    // WAV/W64 interrompu : tailles recalculées depuis la longueur du fichier
+    static bool repairHeader(const std::string& path, std::string& error);
+
+private:
+    class Encoder;
+    class PcmEncoder;
+    class FlacEncoder;
+
+    bool reserveWriter() noexcept;
+    void releaseWriter() noexcept { m_producerActive.store(false, std::memory_order_release); }
+    bool pushInterleaved(const float* const* channels, const float* interleaved, size_t frames) noexcept;
+    void ioLoop();
+    void setError(const std::string& error);
+
+    AudioFileWriterConfig m_config;
+    std::unique_ptr<Encoder> m_encoder;
+    std::thread m_ioThread;
+
+    // File SPSC d'échantillons entrelacés; positions monotones (en échantillons)
+    std::vector<float> m_queue;
+    std::atomic<uint64_t> m_writePos{0};
+    std::atomic<uint64_t> m_readPos{0};
+
+    std::atomic<bool> m_accepting{false};
+    std::atomic<bool> m_producerActive{false};
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<bool> m_failed{false};
+
+    std::atomic<uint64_t> m_framesQueued{0};
+    std::atomic<uint64_t> m_framesDropped{0};
+    std::atomic<uint64_t> m_framesWritten{0};
+    std::atomic<uint64_t> m_maxFillSamples{0};
+    std::atomic<uint64_t> m_bytesWritten{0};     // mis à jour par le thread d'E/S
+    std::atomic<uint64_t> m_writeCalls{0};
+
+    mutable std::mutex m_errorMutex;
+    std::string m_lastError;
+};
+
+} // namespace AudioIO
+
+#endif // __cplusplus
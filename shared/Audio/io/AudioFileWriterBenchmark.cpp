@@ -0,0 +1,132 @@
+#include "AudioFileWriterBenchmark.h"
+#include "../../PerformanceBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace AudioIO {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+const char* formatName(AudioFileFormat format) {
+    switch (format) {
+        case AudioFileFormat::WAV: return "WAV";
+        case AudioFileFormat::W64: return "W64";
+        case AudioFileFormat::FLAC: return "FLAC";
+    }
+    return "?";
+}
+
+const char* sampleFormatName(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16: return "16 bit";
+        case SampleFormat::Int24: return "24 bit";
+        case SampleFormat::Float32: return "float";
+    }
+    return "?";
+}
+
+} // namespace
+
+std::vector<AudioFileWriterBenchmarkResult> runAudioFileWriterBenchmark(const AudioFileWriterBenchmarkConfig& config) {
+    struct Case { AudioFileFormat format; SampleFormat sampleFormat; };
+    std::vector<Case> cases = {
+        {AudioFileFormat::WAV, SampleFormat::Int16},
+        {AudioFileFormat::WAV, SampleFormat::Int24},
+        {AudioFileFormat::WAV, SampleFormat::Float32},
+        {AudioFileFormat::W64, SampleFormat::Int24},
+    };
+#ifdef FFMPEG_AVAILABLE
+    cases.push_back({AudioFileFormat::FLAC, SampleFormat::Int16});
+    cases.push_back({AudioFileFormat::FLAC, SampleFormat::Int24});
+#endif
+
+    const size_t channels = static_cast<size_t>(std::max(1, config.numChannels));
+    const size_t block = std::max<size_t>(16, config.blockSize);
+    const size_t numBlocks = std::max<size_t>(1, static_cast<size_t>(config.seconds * config.sampleRate / block));
+
+    // Musique synthétique (accord + bruit léger) : FLAC ne compresse pas un signal trivial
+    std::vector<float> source(block * channels * 64);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < source.size() / channels; ++i) {
+        const double t = static_cast<double>(i) / config.sampleRate;
+        for (size_t c = 0; c < channels; ++c) {
+            seed = seed * 1664525u + 1013904223u;
+            const double noise = (static_cast<double>(seed >> 8) / 16777216.0 - 0.5) * 0.02;
+            source[i * channels + c] = static_cast<float>(0.2 * std::sin(2.0 * kPi * 220.0 * t) +
+                                                          0.15 * std::sin(2.0 * kPi * 277.2 * t + c) +
+                                                          0.1 * std::sin(2.0 * kPi * 329.6 * t) + noise);
+        }
+    }
+
+    std::vector<AudioFileWriterBenchmarkResult> results;
+    for (const Case& c : cases) {
+        AudioFileWriterConfig wc;
+        wc.format = c.format;
+        wc.sampleFormat = c.sampleFormat;
+        wc.sampleRate = config.sampleRate;
+        wc.numChannels = static_cast<int>(channels);
+        const std::string path = config.directory + "/naaya_writer_bench." + (c.format == AudioFileFormat::FLAC ? "flac" : c.format == AudioFileFormat::W64 ? "w64" : "wav");
+
+        AudioFileWriter writer;
+        std::string error;
+        AudioFileWriterBenchmarkResult r;
+        r.format = c.format;
+        r.sampleFormat = c.sampleFormat;
+        if (!writer.open(path, wc, error)) {
+            std::cout << formatName(c.format) << ": " << error << std::endl;
+            continue;
+        }
+
+        // Producteur aussi rapide que le disque : attend si la file dépasse la moitié
+        const uint64_t halfQueue = static_cast<uint64_t>(wc.queueSeconds * wc.sampleRate / 2);
+        Performance::Benchmark push("writer push");
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numBlocks; ++b) {
+            for (;;) {
+                const AudioFileWriterStats s = writer.getStats();
+                if (s.framesQueued - s.framesWritten < halfQueue) break;
+                std::this_thread::yield();
+            }
+            BENCHMARK_SCOPE(push);
+            writer.write(source.data() + (b % 64) * block * channels, block);
+        }
+        const bool closed = writer.close();
+        const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const AudioFileWriterStats s = writer.getStats();
+        r.mbPerSecond = wallSeconds > 0.0 ? static_cast<double>(s.bytesWritten) / wallSeconds / 1e6 : 0.0;
+        r.realtimeFactor = wallSeconds > 0.0 ? static_cast<double>(s.framesWritten) / config.sampleRate / wallSeconds : 0.0;
+        r.maxPushUs = push.getMaxTime() * 1000.0;
+        r.writeCalls = s.writeCalls;
+        r.framesDropped = s.framesDropped;
+        if (!closed) std::cout << formatName(c.format) << ": " << writer.getLastError() << std::endl;
+        results.push_back(r);
+        ::unlink(path.c_str());
+    }
+    return results;
+}
+
+void printAudioFileWriterBenchmark(const std::vector<AudioFileWriterBenchmarkResult>& results) {
+    std::cout << "\n=== AudioFileWriter: débit disque ===" << std::endl;
+    std::cout << std::setw(6) << "format" << std::setw(8) << "depth"
+              << std::setw(10) << "Mo/s" << std::setw(10) << "x RT"
+              << std::setw(12) << "push max us" << std::setw(10) << "pwrite" << std::setw(9) << "perdues" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        std::cout << std::setw(6) << formatName(r.format) << std::setw(8) << sampleFormatName(r.sampleFormat)
+                  << std::setprecision(1) << std::setw(10) << r.mbPerSecond
+                  << std::setprecision(0) << std::setw(10) << r.realtimeFactor
+                  << std::setprecision(1) << std::setw(12) << r.maxPushUs
+                  << std::setw(10) << r.writeCalls << std::setw(9) << r.framesDropped << std::endl;
+    }
+}
+
+} // namespace AudioIO
@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "AudioFileWriter.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AudioIO {
+
+struct AudioFileWriterBenchmarkResult {
+    AudioFileFormat format = AudioFileFormat::WAV;
+    SampleFormat sampleFormat = SampleFormat::Int24;
+    double mbPerSecond = 0.0;      // octets audio écrits / temps mur (close() compris)
+    double realtimeFactor = 0.0;   // durée audio / temps mur
+    double maxPushUs = 0.0;        // pire appel write() côté producteur
+    uint64_t writeCalls = 0;
+    uint64_t framesDropped = 0;
+};
+
+struct AudioFileWriterBenchmarkConfig {
+    std::string directory = "/tmp";
+    uint32_t sampleRate = 48000;
+    int numChannels = 2;
+    size_t blockSize = 512;
+    double seconds = 60.0;          // audio écrit par mesure, aussi vite que la file l'accepte
+};
+
+std::vector<AudioFileWriterBenchmarkResult> runAudioFileWriterBenchmark(const AudioFileWriterBenchmarkConfig& config = {});
+void printAudioFileWriterBenchmark(const std::vector<AudioFileWriterBenchmarkResult>& results);
+
+} // namespace AudioIO
+
+#endif // __cplusplus
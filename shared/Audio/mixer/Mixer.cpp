@@ -0,0 +1,252 @@
+#include "Mixer.h"
+#include "../utils/RealtimeScope.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AudioMixer {
+
+namespace {
+inline float dbToLinear(double db) {
+    return static_cast<float>(std::pow(10.0, db / 20.0));
+}
+
+inline float onePoleCoeff(double ms, uint32_t sampleRate) {
+    return static_cast<float>(std::exp(-1.0 / (std::max(0.1, ms) * 0.001 * sampleRate)));
+}
+
+// Relâchement de l'enveloppe clé (attaque instantanée)
+constexpr double KEY_RELEASE_MS = 50.0;
+
+constexpr TrackInput SILENT_INPUT{};
+} // namespace
+
+// ===== MixerTrack =====
+
+MixerTrack::MixerTrack(uint32_t sampleRate, size_t maxBlockSize)
+    : m_equalizer(AudioEqualizer::NUM_BANDS, sampleRate)
+    , m_buffer(2, maxBlockSize)
+    , m_keyEnvelope(maxBlockSize, 0.0f)
+    , m_sampleRate(sampleRate) {
+    m_effects.setSampleRate(sampleRate, 2);
+    m_keyRelease = onePoleCoeff(KEY_RELEASE_MS, sampleRate);
+}
+
+void MixerTrack::setSampleRate(uint32_t sampleRate) {
+    m_sampleRate = sampleRate;
+    m_equalizer.setSampleRate(sampleRate);
+    m_effects.setSampleRate(sampleRate, 2);
+    m_keyRelease = onePoleCoeff(KEY_RELEASE_MS, sampleRate);
+    m_keyLevel = 0.0f;
+    m_duckGain = 1.0f;
+}
+
+void MixerTrack::setGainDb(double gainDb) {
+    m_gainDb.store(std::clamp(gainDb, -96.0, AudioEqualizer::MAX_GAIN_DB), std::memory_order_relaxed);
+}
+
+void MixerTrack::setPan(double pan) {
+    m_pan.store(std::clamp(pan, -1.0, 1.0), std::memory_order_relaxed);
+}
+
+void MixerTrack::setDucking(const DuckingParams& params) {
+    m_duckSource.store(params.sourceTrack, std::memory_order_relaxed);
+    m_duckThresholdDb.store(params.thresholdDb, std::memory_order_relaxed);
+    m_duckDepthDb.store(std::max(0.0, params.depthDb), std::memory_order_relaxed);
+    m_duckAttackMs.store(params.attackMs, std::memory_order_relaxed);
+    m_duckReleaseMs.store(params.releaseMs, std::memory_order_relaxed);
+    m_duckEnabled.store(params.enabled, std::memory_order_release);
+}
+
+DuckingParams MixerTrack::getDucking() const {
+    DuckingParams p;
+    p.enabled = m_duckEnabled.load(std::memory_order_relaxed);
+    p.sourceTrack = m_duckSource.load(std::memory_order_relaxed);
+    p.thresholdDb = m_duckThresholdDb.load(std::memory_order_relaxed);
+    p.depthDb = m_duckDepthDb.load(std::memory_order_relaxed);
+    p.attackMs = m_duckAttackMs.load(std::memory_order_relaxed);
+    p.releaseMs = m_duckReleaseMs.load(std::memory_order_relaxed);
+    return p;
+}
+
+double MixerTrack::getDuckReductionDb() const {
+    const float g = m_duckGainReport.load(std::memory_order_relaxed);
+    return g > 0.0f ? -20.0 * std::log10(static_cast<double>(g)) : 0.0;
+}
+
+void MixerTrack::render(const TrackInput& input, size_t offset, size_t numSamples) noexcept {
+    float* L = m_buffer.getChannel(0);
+    float* R = m_buffer.getChannel(1);
+    if (!input.left) {
+        std::memset(L, 0, numSamples * sizeof(float));
+        std::memset(R, 0, numSamples * sizeof(float));
+    } else {
+        std::memcpy(L, input.left + offset, numSamples * sizeof(float));
+        std::memcpy(R, (input.right ? input.right : input.left) + offset, numSamples * sizeof(float));
+    }
+
+    m_equalizer.processStereo(L, R, L, R, numSamples);
+    m_effects.processStereo(L, R, L, R, numSamples);
+
+    if (m_keyed) computeKeyEnvelope(numSamples);
+}
+
+void MixerTrack::computeKeyEnvelope(size_t numSamples) noexcept {
+    const float* L = m_buffer.getChannel(0);
+    const float* R = m_buffer.getChannel(1);
+    float level = m_keyLevel;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const float x = std::max(std::abs(L[i]), std::abs(R[i]));
+        level = x > level ? x : m_keyRelease * level + (1.0f - m_keyRelease) * x;
+        m_keyEnvelope[i] = level;
+    }
+    m_keyLevel = level;
+}
+
+void MixerTrack::applyDucking(const float* keyEnvelope, size_t numSamples) noexcept {
+    // Gain lissé en linéaire : cible = profondeur quand la clé dépasse le seuil, 1 sinon
+    const float threshold = dbToLinear(m_duckThresholdDb.load(std::memory_order_relaxed));
+    const float ducked = dbToLinear(-m_duckDepthDb.load(std::memory_order_relaxed));
+    const float attack = onePoleCoeff(m_duckAttackMs.load(std::memory_order_relaxed), m_sampleRate);
+    const float release = onePoleCoeff(m_duckReleaseMs.load(std::memory_order_relaxed), m_sampleRate);
+
+    float* L = m_buffer.getChannel(0);
+    float* R = m_buffer.getChannel(1);
+    float g = m_duckGain;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const float target = keyEnvelope[i] > threshold ? ducked : 1.0f;
+        const float c = target < g ? attack : release;
+        g = c * g + (1.0f - c) * target;
+        L[i] *= g;
+        R[i] *= g;
+    }
+    m_duckGain = g;
+    m_duckGainReport.store(g, std::memory_order_relaxed);
+}
+
+// ===== Mixer =====
+
+Mixer::Mixer(uint32_t sampleRate, size_t maxBlockSize, size_t numWorkers)
+    : m_sampleRate(sampleRate > 0 ? sampleRate : AudioEqualizer::DEFAULT_SAMPLE_RATE)
+    , m_maxBlockSize(std::max<size_t>(16, maxBlockSize))
+    , m_master(2, m_maxBlockSize)
+    , m_pool(numWorkers) {}
+
+Mixer::~Mixer() = default;
+
+size_t Mixer::addTrack() {
+    m_tracks.push_back(std::make_unique<MixerTrack>(m_sampleRate, m_maxBlockSize));
+    return m_tracks.size() - 1;
+}
+
+void Mixer::removeTrack(size_t index) {
+    if (index >= m_tracks.size()) return;
+    m_tracks.erase(m_tracks.begin() + static_cast<std::ptrdiff_t>(index));
+    // Les sources de ducking suivent le décalage des index
+    for (auto& track : m_tracks) {
+        const int src = track->m_duckSource.load(std::memory_order_relaxed);
+        if (src == static_cast<int>(index)) track->m_duckEnabled.store(false, std::memory_order_relaxed);
+        else if (src > static_cast<int>(index)) track->m_duckSource.store(src - 1, std::memory_order_relaxed);
+    }
+}
+
+MixerTrack* Mixer::getTrack(size_t index) {
+    return index < m_tracks.size() ? m_tracks[index].get() : nullptr;
+}
+
+void Mixer::setSampleRate(uint32_t sampleRate) {
+    m_sampleRate = sampleRate > 0 ? sampleRate : AudioEqualizer::DEFAULT_SAMPLE_RATE;
+    for (auto& track : m_tracks) track->setSampleRate(m_sampleRate);
+}
+
+void Mixer::renderTask(void* context, size_t index) {
+    auto* self = static_cast<Mixer*>(context);
+    const TrackInput& input = index < self->m_blockNumInputs ? self->m_blockInputs[index] : SILENT_INPUT;
+    self->m_tracks[index]->render(input, self->m_blockOffset, self->m_blockSamples);
+}
+
+void Mixer::process(const TrackInput* inputs, size_t numInputs,
+                    float* outputL, float* outputR, size_t numSamples) noexcept {
+    if (!outputL || !outputR) return;
+    // Le thread appelant rend aussi des pistes (parallelFor) : FTZ/DAZ même hors thread audio
+    AudioEqualizer::DenormalScope ftz;
+    m_blockInputs = inputs;
+    m_blockNumInputs = inputs ? numInputs : 0;
+    for (size_t offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        const size_t n = std::min(m_maxBlockSize, numSamples - offset);
+        m_blockOffset = offset;
+        processBlock(n, outputL + offset, outputR + offset);
+    }
+}
+
+void Mixer::processBlock(size_t numSamples, float* outputL, float* outputR) noexcept {
+    const size_t numTracks = m_tracks.size();
+    m_blockSamples = numSamples;
+
+    // Pistes clés du bloc : seules celles-ci calculent une enveloppe
+    bool anySolo = false;
+    for (auto& track : m_tracks) {
+        track->m_keyed = false;
+        anySolo = anySolo || track->isSolo();
+    }
+    for (auto& track : m_tracks) {
+        if (!track->m_duckEnabled.load(std::memory_order_acquire)) continue;
+        const int src = track->m_duckSource.load(std::memory_order_relaxed);
+        if (src >= 0 && static_cast<size_t>(src) < numTracks && m_tracks[src].get() != track.get()) {
+            m_tracks[src]->m_keyed = true;
+        }
+    }
+
+    // Rendu parallèle, barrière à la sortie de parallelFor
+    m_pool.parallelFor(numTracks, &Mixer::renderTask, this);
+
+    // Mixage : ducking, rampes gain/pan sur le bloc, somme SIMD
+    m_master.clear(0);
+    m_master.clear(1);
+    for (size_t t = 0; t < numTracks; ++t) {
+        MixerTrack& track = *m_tracks[t];
+        if (track.isMuted() || (anySolo && !track.isSolo())) {
+            track.m_appliedL = track.m_appliedR = 0.0f;
+            continue;
+        }
+
+        if (track.m_duckEnabled.load(std::memory_order_acquire)) {
+            const int src = track.m_duckSource.load(std::memory_order_relaxed);
+            if (src >= 0 && static_cast<size_t>(src) < numTracks && static_cast<size_t>(src) != t) {
+                track.applyDucking(m_tracks[src]->m_keyEnvelope.data(), numSamples);
+            }
+        }
+
+        // Balance : centre à l'unité, le côté opposé décroît linéairement
+        const float gain = dbToLinear(track.getGainDb());
+        const float pan = static_cast<float>(track.getPan());
+        const float gl = gain * std::min(1.0f, 1.0f - pan);
+        const float gr = gain * std::min(1.0f, 1.0f + pan);
+
+        if (gl != track.m_appliedL || gr != track.m_appliedR) {
+            track.m_buffer.applyGainRamp(0, 0, numSamples, track.m_appliedL, gl);
+            track.m_buffer.applyGainRamp(1, 0, numSamples, track.m_appliedR, gr);
+            track.m_appliedL = gl;
+            track.m_appliedR = gr;
+            m_master.addFrom(0, track.m_buffer.getChannel(0), numSamples);
+            m_master.addFrom(1, track.m_buffer.getChannel(1), numSamples);
+        } else {
+            m_master.addFrom(0, track.m_buffer.getChannel(0), numSamples, gl);
+            m_master.addFrom(1, track.m_buffer.getChannel(1), numSamples, gr);
+        }
+    }
+
+    const float master = dbToLinear(m_masterGainDb.load(std::memory_order_relaxed));
+    if (master != m_appliedMaster) {
+        m_master.applyGainRamp(0, 0, numSamples, m_appliedMaster, master);
+        m_master.applyGainRamp(1, 0, numSamples, m_appliedMaster, master);
+        m_appliedMaster = master;
+    } else if (master != 1.0f) {
+        m_master.applyGain(0, 0, numSamples, master);
+        m_master.applyGain(1, 0, numSamples, master);
+    }
+    std::memcpy(outputL, m_master.getChannel(0), numSamples * sizeof(float));
+    std::memcpy(outputR, m_master.getChannel(1), numSamples * sizeof(float));
+}
+
+} // namespace AudioMixer
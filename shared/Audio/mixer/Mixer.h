@@ -0,0 +1,146 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "../core/AudioEqualizer.h"
+#include "../effects/EffectChain.h"
+#include "../utils/AudioBuffer.h"
+#include "../utils/AudioTaskPool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AudioMixer {
+
+// Atténuation d'une piste par le niveau d'une autre (ex. musique sous la voix)
+struct DuckingParams {
+    bool enabled = false;
+    int sourceTrack = -1;        // index de la piste clé
+    double thresholdDb = -40.0;  // niveau clé au-delà duquel la piste est atténuée
+    double depthDb = 12.0;       // atténuation appliquée
+    double attackMs = 10.0;
+    double releaseMs = 300.0;
+};
+
+// Entrée d'une piste pour un appel à Mixer::process(); right nul = source mono
+struct TrackInput {
+    const float* left = nullptr;
+    const float* right = nullptr;
+};
+
+// Piste : EQ + chaîne d'effets propres, gain/pan, mute/solo, ducking.
+// Les réglages scalaires sont atomiques (UI -> audio); EQ et effets suivent leurs propres règles.
+class MixerTrack {
+public:
+    MixerTrack(uint32_t sampleRate, size_t maxBlockSize);
+
+    AudioEqualizer::AudioEqualizer& getEqualizer() { return m_equalizer; }
+    AudioFX::EffectChain& getEffects() { return m_effects; }
+
+    void setGainDb(double gainDb);
+    double getGainDb() const { return m_gainDb.load(std::memory_order_relaxed); }
+    // -1 = gauche, 0 = centre (unité sur les deux canaux), +1 = droite
+    void setPan(double pan);
+    double getPan() const { return m_pan.load(std::memory_order_relaxed); }
+    void setMute(bool mute) { m_mute.store(mute, std::memory_order_relaxed); }
+    bool isMuted() const { return m_mute.load(std::memory_order_relaxed); }
+    void setSolo(bool solo) { m_solo.store(solo, std::memory_order_relaxed); }
+    bool isSolo() const { return m_solo.load(std::memory_order_relaxed); }
+
+    void setDucking(const DuckingParams& params);
+    DuckingParams getDucking() const;
+    // Atténuation courante due au ducking (dB, >= 0), pour l'affichage
+    double getDuckReductionDb() const;
+
+private:
+    friend class Mixer;
+
+    void setSampleRate(uint32_t sampleRate);
+    void render(const TrackInput& input, size_t offset, size_t numSamples) noexcept;
+    void computeKeyEnvelope(size_t numSamples) noexcept;
+    void applyDucking(const float* keyEnvelope, size_t numSamples) noexcept;
+
+    AudioEqualizer::AudioEqualizer m_equalizer;
+    AudioFX::EffectChain m_effects;
+    AudioEqualizer::AudioBuffer m_buffer;   // sortie de la piste (stéréo, maxBlockSize)
+    std::vector<float> m_keyEnvelope;       // enveloppe crête, si la piste sert de clé
+    uint32_t m_sampleRate;
+
+    std::atomic<double> m_gainDb{0.0};
+    std::atomic<double> m_pan{0.0};
+    std::atomic<bool> m_mute{false};
+    std::atomic<bool> m_solo{false};
+
+    std::atomic<bool> m_duckEnabled{false};
+    std::atomic<int> m_duckSource{-1};
+    std::atomic<double> m_duckThresholdDb{-40.0};
+    std::atomic<double> m_duckDepthDb{12.0};
+    std::atomic<double> m_duckAttackMs{10.0};
+    std::atomic<double> m_duckReleaseMs{300.0};
+
+    // État du thread audio
+    bool m_keyed = false;
+    float m_keyRelease = 0.0f;
+    float m_keyLevel = 0.0f;
+    float m_duckGain = 1.0f;
+    std::atomic<float> m_duckGainReport{1.0f};
+    float m_appliedL = 1.0f;
+    float m_appliedR = 1.0f;
+};
+
+// Mixeur multipiste.
+//
+// Chaque bloc : rendu des pistes en parallèle (EQ -> effets -> enveloppe clé) sur un
+// AudioTaskPool, barrière, puis mixage séquentiel : ducking, rampes gain/pan et somme
+// SIMD AudioBuffer::addFrom dans le bus maître. Les blocs plus longs que maxBlockSize
+// sont découpés.
+//
+// addTrack()/removeTrack()/setSampleRate() allouent et ne doivent pas être appelés
+// pendant process(); les réglages des pistes peuvent l'être.
+class Mixer {
+public:
+    // numWorkers : threads en plus de l'appelant (0 = rendu séquentiel)
+    Mixer(uint32_t sampleRate, size_t maxBlockSize = 1024,
+          size_t numWorkers = AudioEqualizer::AudioTaskPool::recommendedWorkers());
+    ~Mixer();
+
+    size_t addTrack();
+    void removeTrack(size_t index);
+    size_t getNumTracks() const { return m_tracks.size(); }
+    MixerTrack* getTrack(size_t index);
+
+    void setSampleRate(uint32_t sampleRate);
+    uint32_t getSampleRate() const { return m_sampleRate; }
+    size_t getMaxBlockSize() const { return m_maxBlockSize; }
+    size_t getNumThreads() const { return m_pool.getNumThreads(); }
+
+    void setMasterGainDb(double gainDb) { m_masterGainDb.store(gainDb, std::memory_order_relaxed); }
+    double getMasterGainDb() const { return m_masterGainDb.load(std::memory_order_relaxed); }
+
+    // inputs[i] alimente la piste i (pistes sans entrée : silence)
+    void process(const TrackInput* inputs, size_t numInputs,
+                 float* outputL, float* outputR, size_t numSamples) noexcept;
+
+private:
+    static void renderTask(void* context, size_t index);
+    void processBlock(size_t numSamples, float* outputL, float* outputR) noexcept;
+
+    uint32_t m_sampleRate;
+    size_t m_maxBlockSize;
+    std::vector<std::unique_ptr<MixerTrack>> m_tracks;
+    AudioEqualizer::AudioBuffer m_master;
+    AudioEqualizer::AudioTaskPool m_pool;
+    std::atomic<double> m_masterGainDb{0.0};
+    float m_appliedMaster = 1.0f;
+
+    // Bloc courant, lu par les tâches de rendu
+    const TrackInput* m_blockInputs = nullptr;
+    size_t m_blockNumInputs = 0;
+    size_t m_blockOffset = 0;
+    size_t m_blockSamples = 0;
+};
+
+} // namespace AudioMixer
+
+#endif // __cplusplus
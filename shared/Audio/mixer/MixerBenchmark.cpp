@@ -0,0 +1,90 @@
+#include "MixerBenchmark.h"
+#include "Mixer.h"
+#include "../effects/Compressor.h"
+#include "../effects/Delay.h"
+#include "../../PerformanceBenchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace AudioMixer {
+
+namespace {
+void configureTrack(MixerTrack& track, size_t index) {
+    auto& eq = track.getEqualizer();
+    for (size_t b = 0; b < eq.getNumBands(); ++b) {
+        eq.setBandGain(b, static_cast<double>((b + index) % 7) - 3.0);
+    }
+    auto& fx = track.getEffects();
+    fx.emplaceEffect<AudioFX::CompressorEffect>()->setParameters(-18.0, 3.0, 10.0, 80.0, 0.0);
+    fx.emplaceEffect<AudioFX::DelayEffect>()->setParameters(120.0 + 10.0 * index, 0.3, 0.2);
+    track.setPan(static_cast<double>(index % 5) * 0.5 - 1.0);
+}
+} // namespace
+
+std::vector<MixerBenchmarkResult> runMixerBenchmark(const MixerBenchmarkConfig& config) {
+    std::vector<MixerBenchmarkResult> results;
+    const size_t block = std::max<size_t>(16, config.blockSize);
+    const size_t numBlocks = std::max<size_t>(1, static_cast<size_t>(config.seconds * config.sampleRate / block));
+    const double blockMs = 1000.0 * static_cast<double>(block) / config.sampleRate;
+    const size_t maxTracks = config.trackCounts.empty() ? 0
+        : *std::max_element(config.trackCounts.begin(), config.trackCounts.end());
+
+    // Sources partagées : bruit + sinus, une par piste
+    std::vector<std::vector<float>> sources(maxTracks, std::vector<float>(block));
+    uint32_t seed = 0x1234567u;
+    for (size_t t = 0; t < maxTracks; ++t) {
+        for (size_t i = 0; i < block; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            const float noise = static_cast<float>(seed >> 9) / static_cast<float>(1u << 23) - 0.5f;
+            sources[t][i] = 0.2f * noise + 0.3f * static_cast<float>(std::sin(0.01 * (t + 1) * i));
+        }
+    }
+    std::vector<TrackInput> inputs(maxTracks);
+    for (size_t t = 0; t < maxTracks; ++t) inputs[t].left = sources[t].data();
+    std::vector<float> outL(block), outR(block);
+
+    for (size_t threads : config.threadCounts) {
+        for (size_t tracks : config.trackCounts) {
+            Mixer mixer(config.sampleRate, block, threads > 0 ? threads - 1 : 0);
+            for (size_t t = 0; t < tracks; ++t) configureTrack(*mixer.getTrack(mixer.addTrack()), t);
+            if (tracks > 1) {
+                DuckingParams duck; duck.enabled = true; duck.sourceTrack = 0;
+                mixer.getTrack(1)->setDucking(duck);
+            }
+
+            // Chauffe : caches, threads réveillés, états des filtres
+            for (size_t b = 0; b < 32; ++b) mixer.process(inputs.data(), tracks, outL.data(), outR.data(), block);
+
+            Performance::Benchmark bench("mixer");
+            for (size_t b = 0; b < numBlocks; ++b) {
+                BENCHMARK_SCOPE(bench);
+                mixer.process(inputs.data(), tracks, outL.data(), outR.data(), block);
+            }
+
+            MixerBenchmarkResult r;
+            r.tracks = tracks;
+            r.threads = mixer.getNumThreads();
+            r.meanBlockMs = bench.getAverageTime();
+            r.maxBlockMs = bench.getMaxTime();
+            r.realtimeFactor = r.meanBlockMs > 0.0 ? blockMs / r.meanBlockMs : 0.0;
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+void printMixerBenchmark(const std::vector<MixerBenchmarkResult>& results) {
+    std::cout << "\n=== Mixer: pistes x threads ===" << std::endl;
+    std::cout << std::setw(8) << "tracks" << std::setw(9) << "threads"
+              << std::setw(12) << "mean ms" << std::setw(12) << "max ms" << std::setw(10) << "x RT" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        std::cout << std::setw(8) << r.tracks << std::setw(9) << r.threads
+                  << std::setprecision(3) << std::setw(12) << r.meanBlockMs << std::setw(12) << r.maxBlockMs
+                  << std::setprecision(1) << std::setw(10) << r.realtimeFactor << std::endl;
+    }
+}
+
+} // namespace AudioMixer
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AudioMixer {
+
+struct MixerBenchmarkResult {
+    size_t tracks = 0;
+    size_t threads = 0;          // participants, appelant compris
+    double meanBlockMs = 0.0;
+    double maxBlockMs = 0.0;
+    double realtimeFactor = 0.0; // durée audio / temps de calcul (> 1 : plus rapide que le temps réel)
+};
+
+struct MixerBenchmarkConfig {
+    std::vector<size_t> trackCounts{1, 2, 4, 8, 16, 24, 32};
+    std::vector<size_t> threadCounts{1, 2, 4, 8};
+    uint32_t sampleRate = 48000;
+    size_t blockSize = 512;
+    double seconds = 2.0;        // audio traité par mesure
+};
+
+// Nombre de pistes x nombre de coeurs -> facteur temps réel. Chaque piste : EQ 10 bandes
+// actives + compresseur + délai, ducking de la piste 1 par la piste 0.
+std::vector<MixerBenchmarkResult> runMixerBenchmark(const MixerBenchmarkConfig& config = {});
+void printMixerBenchmark(const std::vector<MixerBenchmarkResult>& results);
+
+} // namespace AudioMixer
+
+#endif // __cplusplus
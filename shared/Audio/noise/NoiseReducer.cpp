@@ -1,4 +1,5 @@
 #include "NoiseReducer.h"
+#include <cstring>
 
 namespace AudioNR {
 
@@ -39,6 +39,9 @@ public:
     void processMono(const float* input, float* output, size_t numSamples);
     void processStereo(const float* inL, const float* inR, float* outL, float* outR, size_t numSamples);
 
+    // Passe-haut biquad + gain suivi d'enveloppe : aucun retard
+    size_t getLatencySamples() const { return 0; }
+
 private:
     uint32_t sampleRate_;
     int channels_;
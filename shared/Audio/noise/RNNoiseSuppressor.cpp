@@ -1,4 +1,5 @@
 #include "RNNoiseSuppressor.h"
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #ifdef NAAYA_RNNOISE
@@ -21,17 +22,40 @@ extern "C" {
 
 namespace AudioNR {
 
+namespace {
+// Retard propre du backend, trame en attente exclue. rnnoise 0.2 (vendorisé) : une trame de
+// recouvrement-addition + une trame de spectre différé (delayed_X). arnndn : recouvrement seul.
+#if defined(NAAYA_RNNOISE)
+constexpr size_t kBackendDelay = 2 * RNNoiseSuppressor::kFrameSize;
+#else
+constexpr size_t kBackendDelay = RNNoiseSuppressor::kFrameSize;
+#endif
+// rnnoise attend l'échelle int16
+constexpr float kRnnoiseScale = 32768.0f;
+} // namespace
+
 RNNoiseSuppressor::RNNoiseSuppressor() = default;
-RNNoiseSuppressor::~RNNoiseSuppressor() = default;
+
+RNNoiseSuppressor::~RNNoiseSuppressor() {
+#if defined(NAAYA_RNNOISE)
+    destroyRNNoise();
+#endif
+#if defined(FFMPEG_AVAILABLE)
+    destroyGraph();
+#endif
+}
 
 bool RNNoiseSuppressor::initialize(uint32_t sampleRate, int numChannels) {
     sampleRate_ = sampleRate > 0 ? sampleRate : 48000;
     channels_ = (numChannels == 2 ? 2 : 1);
     available_ = false;
-    
+    frameIn_.assign(kFrameSize, 0.0f);
+    frameOut_.assign(kFrameSize, 0.0f);
+    frameFill_ = 0;
+
 #if defined(NAAYA_RNNOISE)
     // Native RNNoise backend
-    if (rnnsState_) rnnoise_destroy(rnnsState_);
+    destroyRNNoise();
     rnnsState_ = rnnoise_create(NULL); // Use default model
     if (rnnsState_) { available_ = true; }
 #elif defined(FFMPEG_AVAILABLE)
@@ -45,83 +69,74 @@ bool RNNoiseSuppressor::initialize(uint32_t sampleRate, int numChannels) {
 
 bool RNNoiseSuppressor::isAvailable() const { return available_; }
 
+size_t RNNoiseSuppressor::getLatencySamples() const {
+    return available_ ? kFrameSize + kBackendDelay : 0;
+}
+
+void RNNoiseSuppressor::reset() {
+    std::fill(frameIn_.begin(), frameIn_.end(), 0.0f);
+    std::fill(frameOut_.begin(), frameOut_.end(), 0.0f);
+    frameFill_ = 0;
+}
+
 void RNNoiseSuppressor::setAggressiveness(double aggressiveness) {
     if (aggressiveness < 0.0) aggressiveness = 0.0;
     if (aggressiveness > 3.0) aggressiveness = 3.0;
     aggressiveness_ = aggressiveness;
 }
 
-void RNNoiseSuppressor::processMono(const float* input, float* output, size_t numSamples) {
-    if (!input || !output || numSamples == 0) return;
-    
-#if defined(FFMPEG_AVAILABLE)
-    if (available_) {
-        // Construire trames de 10ms pour arnndn (optionnel: on peut pousser tout d'un coup)
-        const int nb_samples = (int)numSamples;
-        if (!inputFrame_) inputFrame_ = av_frame_alloc();
-        if (!outputFrame_) outputFrame_ = av_frame_alloc();
-        if (!inputFrame_ || !outputFrame_) { if (output!=input) std::memcpy(output,input,numSamples*sizeof(float)); return; }
-        // Réinitialiser puis configurer l'AVFrame
+// Entrée au rang frameFill_ de la trame courante, sortie au même rang de la trame précédente
+inline float RNNoiseSuppressor::pushSample(float x) {
+    frameIn_[frameFill_] = x;
+    const float y = frameOut_[frameFill_];
+    if (++frameFill_ == kFrameSize) {
+        processFrame();
+        frameFill_ = 0;
+    }
+    return y;
+}
+
+// frameIn_ -> frameOut_; en cas d'échec, la trame sèche garde la ligne de temps
+void RNNoiseSuppressor::processFrame() {
+#if defined(NAAYA_RNNOISE)
+    if (rnnsState_) {
+        for (size_t i = 0; i < kFrameSize; ++i) frameIn_[i] *= kRnnoiseScale;
+        rnnoise_process_frame(rnnsState_, frameOut_.data(), frameIn_.data());
+        for (size_t i = 0; i < kFrameSize; ++i) frameOut_[i] *= 1.0f / kRnnoiseScale;
+        return;
+    }
+#elif defined(FFMPEG_AVAILABLE)
+    if (graphReady_ && inputFrame_ && outputFrame_) {
+        // arnndn consomme et produit des trames de kFrameSize : une entrée, une sortie
         av_frame_unref(inputFrame_);
-        inputFrame_->nb_samples = nb_samples;
-        inputFrame_->format = AV_SAMPLE_FMT_FLT; // interleaved float32
+        inputFrame_->nb_samples = (int)kFrameSize;
+        inputFrame_->format = AV_SAMPLE_FMT_FLT;
         inputFrame_->sample_rate = (int)sampleRate_;
-        // Toujours traiter en mono côté arnndn pour la stabilité
-        AVChannelLayout tmpLayout{};
-        av_channel_layout_default(&tmpLayout, 1);
-        av_channel_layout_copy(&inputFrame_->ch_layout, &tmpLayout);
-        if (av_frame_get_buffer(inputFrame_, 0) < 0) { std::memcpy(output,input,numSamples*sizeof(float)); return; }
-        std::memcpy(inputFrame_->data[0], input, numSamples * sizeof(float));
-        if (av_buffersrc_add_frame_flags(sourceContext_, inputFrame_, AV_BUFFERSRC_FLAG_KEEP_REF) < 0) {
-            std::memcpy(output, input, numSamples * sizeof(float));
-            return;
-        }
-        if (av_buffersink_get_frame(sinkContext_, outputFrame_) < 0) {
-            std::memcpy(output, input, numSamples * sizeof(float));
-            return;
+        inputFrame_->pts = framePts_;
+        framePts_ += (int64_t)kFrameSize;
+        av_channel_layout_default(&inputFrame_->ch_layout, 1);
+        if (av_frame_get_buffer(inputFrame_, 0) >= 0) {
+            std::memcpy(inputFrame_->data[0], frameIn_.data(), kFrameSize * sizeof(float));
+            if (av_buffersrc_add_frame_flags(sourceContext_, inputFrame_, AV_BUFFERSRC_FLAG_KEEP_REF) >= 0 &&
+                av_buffersink_get_frame(sinkContext_, outputFrame_) >= 0) {
+                const size_t got = std::min(kFrameSize, (size_t)outputFrame_->nb_samples);
+                std::memcpy(frameOut_.data(), outputFrame_->data[0], got * sizeof(float));
+                if (got < kFrameSize) std::fill(frameOut_.begin() + (std::ptrdiff_t)got, frameOut_.end(), 0.0f);
+                av_frame_unref(outputFrame_);
+                return;
+            }
         }
-        // Copier en sortie
-        std::memcpy(output, outputFrame_->data[0], (size_t)outputFrame_->nb_samples * sizeof(float));
-        av_frame_unref(outputFrame_);
-        return;
     }
 #endif
-#ifdef NAAYA_RNNOISE
-    if (available_ && rnnsState_) {
-        // Traiter à 48kHz par trames de 480
-        size_t writeIdx = 0;
-        // S'il y a des restes en attente, on les complète et on sort une trame
-        if (!pendingMono_.empty()) {
-            size_t need = 480 - pendingMono_.size();
-            size_t chunk = std::min(need, numSamples);
-            pendingMono_.insert(pendingMono_.end(), input, input + chunk);
-            if (pendingMono_.size() == 480) {
-                float frame[480];
-                for (int i = 0; i < 480; ++i) frame[i] = pendingMono_[i];
-                rnnoise_process_frame(rnnsState_, frame, frame);
-                std::memcpy(output, frame, 480 * sizeof(float));
-                writeIdx += 480;
-                pendingMono_.clear();
-            }
-        }
-        // Traiter toutes les trames complètes suivantes
-        while (writeIdx + 480 <= numSamples) {
-            float frame[480];
-            std::memcpy(frame, input + writeIdx, 480 * sizeof(float));
-            rnnoise_process_frame(rnnsState_, frame, frame);
-            std::memcpy(output + writeIdx, frame, 480 * sizeof(float));
-            writeIdx += 480;
-        }
-        // Stocker le reste en attente
-        size_t rest = numSamples - writeIdx;
-        if (rest > 0) {
-            pendingMono_.insert(pendingMono_.end(), input + writeIdx, input + numSamples);
-            // Copier tel quel pour éviter trous (latence d'une trame)
-            std::memcpy(output + writeIdx, input + writeIdx, rest * sizeof(float));
-        }
+    std::copy(frameIn_.begin(), frameIn_.end(), frameOut_.begin());
+}
+
+void RNNoiseSuppressor::processMono(const float* input, float* output, size_t numSamples) {
+    if (!input || !output || numSamples == 0) return;
+    if (available_) {
+        for (size_t i = 0; i < numSamples; ++i) output[i] = pushSample(input[i]);
         return;
     }
-#endif
     // Fallback sans lib: copie
     if (output != input) std::memcpy(output, input, numSamples * sizeof(float));
 }
@@ -130,31 +145,25 @@ void RNNoiseSuppressor::processStereo(const float* inL, const float* inR,
                                       float* outL, float* outR,
                                       size_t numSamples) {
     if (!inL || !inR || !outL || !outR || numSamples == 0) return;
-#ifdef FFMPEG_AVAILABLE
     if (available_) {
-        // Downmix -> mono -> arnndn -> upmix (simple et efficace)
-        std::vector<float> mono(numSamples);
-        for (size_t i = 0; i < numSamples; ++i) mono[i] = 0.5f * (inL[i] + inR[i]);
-        std::vector<float> den(numSamples);
-        processMono(mono.data(), den.data(), numSamples);
-        for (size_t i = 0; i < numSamples; ++i) { outL[i] = den[i]; outR[i] = den[i]; }
-        return;
-    }
-#endif
-#ifdef NAAYA_RNNOISE
-    if (available_ && rnnsState_) {
-        std::vector<float> mono(numSamples);
-        for (size_t i = 0; i < numSamples; ++i) mono[i] = 0.5f * (inL[i] + inR[i]);
-        std::vector<float> den(numSamples);
-        processMono(mono.data(), den.data(), numSamples);
-        for (size_t i = 0; i < numSamples; ++i) { outL[i] = den[i]; outR[i] = den[i]; }
+        // Downmix -> mono -> RNNoise -> upmix, sans tampon intermédiaire
+        for (size_t i = 0; i < numSamples; ++i) {
+            const float y = pushSample(0.5f * (inL[i] + inR[i]));
+            outL[i] = y;
+            outR[i] = y;
+        }
         return;
     }
-#endif
     if (outL != inL) std::memcpy(outL, inL, numSamples * sizeof(float));
     if (outR != inR) std::memcpy(outR, inR, numSamples * sizeof(float));
 }
 
+#ifdef NAAYA_RNNOISE
+void RNNoiseSuppressor::destroyRNNoise() {
+    if (rnnsState_) { rnnoise_destroy(rnnsState_); rnnsState_ = nullptr; }
+}
+#endif
+
 #ifdef FFMPEG_AVAILABLE
 bool RNNoiseSuppressor::buildGraph() {
     filterGraph_ = avfilter_graph_alloc();
@@ -187,7 +196,10 @@ bool RNNoiseSuppressor::buildGraph() {
     avfilter_inout_free(&inputs);
     if (ret < 0) return false;
     if (avfilter_graph_config(filterGraph_, NULL) < 0) return false;
-    return true;
+    inputFrame_ = av_frame_alloc();
+    outputFrame_ = av_frame_alloc();
+    framePts_ = 0;
+    return inputFrame_ && outputFrame_;
 }
 
 void RNNoiseSuppressor::destroyGraph() {
@@ -20,15 +20,23 @@ struct DenoiseState;
 namespace AudioNR {
 
 /**
- * Squelette d'un suppresseur de bruit basé sur RNNoise.
- * - Sans lib tierce (NAAYA_RNNOISE non définie), il est inactif et passe les données.
- * - Lorsqu'intégrée, l'implémentation pourra appeler la lib RNNoise.
+ * Suppresseur de bruit basé sur RNNoise (lib vendorisée NAAYA_RNNOISE, sinon filtre
+ * FFmpeg arnndn). Sans backend, il est inactif et passe les données.
+ * - Trames de kFrameSize échantillons remplies échantillon par échantillon : la trame
+ *   débruitée ressort pendant le remplissage de la suivante, quelle que soit la taille
+ *   des blocs. Retard constant : getLatencySamples().
+ * - Stéréo : mixé en mono, même sortie sur les deux canaux.
  */
 class RNNoiseSuppressor {
 public:
+    static constexpr size_t kFrameSize = 480;   // 10 ms @ 48 kHz
+
     RNNoiseSuppressor();
     ~RNNoiseSuppressor();
 
+    RNNoiseSuppressor(const RNNoiseSuppressor&) = delete;
+    RNNoiseSuppressor& operator=(const RNNoiseSuppressor&) = delete;
+
     // Initialise le moteur. Retourne true si disponible (lib présente), false sinon.
     bool initialize(uint32_t sampleRate, int numChannels);
 
@@ -44,12 +52,25 @@ public:
                        float* outL, float* outR,
                        size_t numSamples);
 
+    // Retard de la sortie (échantillons) : trame en attente + retard propre du backend.
+    // 0 si indisponible (copie directe).
+    size_t getLatencySamples() const;
+
+    // Vide la trame en cours (reprise après silence)
+    void reset();
+
 private:
     bool available_{false};
     uint32_t sampleRate_{48000};
     int channels_{1};
     double aggressiveness_{1.0};
 
+    std::vector<float> frameIn_;    // trame en cours de remplissage
+    std::vector<float> frameOut_;   // trame débruitée, restituée pendant le remplissage suivant
+    size_t frameFill_{0};
+    inline float pushSample(float x);
+    void processFrame();
+
 #ifdef FFMPEG_AVAILABLE
     // FFmpeg graph for arnndn
     ::AVFilterGraph* filterGraph_{nullptr};
@@ -58,14 +79,13 @@ private:
     ::AVFrame* inputFrame_{nullptr};
     ::AVFrame* outputFrame_{nullptr};
     bool graphReady_{false};
+    int64_t framePts_{0};
     bool buildGraph();
     void destroyGraph();
 #endif
 
 #ifdef NAAYA_RNNOISE
     ::DenoiseState* rnnsState_{nullptr};
-    // Tampon d'agrégation pour traiter par trames de 480 échantillons (10 ms @ 48k)
-    std::vector<float> pendingMono_;
     void destroyRNNoise();
 #endif
 };
@@ -1,59 +1,82 @@
 #include "SpectralNR.h"
+#include "../utils/RealFFT.h"
 #include <cstring>
 
 namespace AudioNR {
 
-static inline float hann(size_t n, size_t N) {
-    return 0.5f * (1.0f - std::cos(2.0f * static_cast<float>(M_PI) * static_cast<float>(n) / static_cast<float>(N - 1)));
-}
-
 SpectralNR::SpectralNR(const SpectralNRConfig& cfg) { setConfig(cfg); }
 SpectralNR::~SpectralNR() = default;
 
 void SpectralNR::setConfig(const SpectralNRConfig& cfg) {
     cfg_ = cfg;
-    buildWindow();
+    // RealFFT : taille puissance de deux, hop <= taille
+    size_t n = 16;
+    while (n < cfg_.fftSize && n < (size_t(1) << 15)) n <<= 1;
+    cfg_.fftSize = n;
+    cfg_.hopSize = std::max<size_t>(1, std::min(cfg_.hopSize, cfg_.fftSize));
+
+    fft_ = std::make_unique<AudioEqualizer::RealFFT>(cfg_.fftSize);
+    const float* window = fft_->window();
+    double energy = 0.0;
+    for (size_t i = 0; i < cfg_.fftSize; ++i) energy += static_cast<double>(window[i]) * window[i];
+    // Analyse + synthèse fenêtrées (Hann) : normalisation par la somme des w² recouvrantes
+    olaScale_ = energy > 0.0 ? static_cast<float>(static_cast<double>(cfg_.hopSize) / energy) : 1.0f;
+
     inBuf_.assign(cfg_.fftSize, 0.0f);
     outBuf_.assign(cfg_.fftSize, 0.0f);
+    outReady_.assign(cfg_.hopSize, 0.0f);
+    frame_.assign(cfg_.fftSize, 0.0f);
+    re_.assign(fft_->numBins(), 0.0f);
+    im_.assign(fft_->numBins(), 0.0f);
     noiseMag_.assign(cfg_.fftSize / 2 + 1, 0.0f);
-    writePos_ = 0;
+    inFill_ = 0;
     noiseInit_ = true;
 }
 
-void SpectralNR::buildWindow() {
-    window_.resize(cfg_.fftSize);
-    for (size_t n = 0; n < cfg_.fftSize; ++n) window_[n] = hann(n, cfg_.fftSize);
+void SpectralNR::reset() {
+    std::fill(inBuf_.begin(), inBuf_.end(), 0.0f);
+    std::fill(outBuf_.begin(), outBuf_.end(), 0.0f);
+    std::fill(outReady_.begin(), outReady_.end(), 0.0f);
+    inFill_ = 0;
+    noiseInit_ = true;
 }
 
-void SpectralNR::fft(const std::vector<float>& in, std::vector<float>& re, std::vector<float>& im) {
-    // Naive DFT O(N^2) fallback for simplicity; replace with platform FFT for production
-    size_t N = cfg_.fftSize;
-    re.assign(N, 0.0f); im.assign(N, 0.0f);
-    const double twoPiOverN = 2.0 * M_PI / static_cast<double>(N);
-    for (size_t k = 0; k < N; ++k) {
-        double sumRe = 0.0, sumIm = 0.0;
-        for (size_t n = 0; n < N; ++n) {
-            double angle = twoPiOverN * static_cast<double>(k * n);
-            sumRe += in[n] * std::cos(angle);
-            sumIm -= in[n] * std::sin(angle);
-        }
-        re[k] = static_cast<float>(sumRe);
-        im[k] = static_cast<float>(sumIm);
+void SpectralNR::processFrame() {
+    const size_t N = cfg_.fftSize;
+    const size_t hop = cfg_.hopSize;
+    const size_t half = N / 2;
+
+    const float* window = fft_->window();
+    for (size_t i = 0; i < N; ++i) frame_[i] = inBuf_[i] * window[i];
+    fft_->forward(frame_.data(), re_.data(), im_.data());
+
+    // Estimation du bruit (lissage exponentiel des magnitudes) puis soustraction
+    // spectrale appliquée comme un gain réel par case : la phase est conservée
+    // sans atan2/cos/sin.
+    const float beta = static_cast<float>(cfg_.beta);
+    const float floorGain = static_cast<float>(cfg_.floorGain);
+    const float upd = static_cast<float>(cfg_.noiseUpdate);
+    for (size_t k = 0; k <= half; ++k) {
+        float mag = std::sqrt(re_[k] * re_[k] + im_[k] * im_[k]);
+        if (noiseInit_) noiseMag_[k] = mag;
+        else noiseMag_[k] = upd * noiseMag_[k] + (1.0f - upd) * mag;
+
+        float sub = mag - beta * noiseMag_[k];
+        float minMag = floorGain * noiseMag_[k];
+        if (sub < minMag) sub = minMag;
+        float g = mag > 1e-12f ? sub / mag : 0.0f;
+        re_[k] *= g; im_[k] *= g;
     }
-}
+    noiseInit_ = false;
 
-void SpectralNR::ifft(const std::vector<float>& re, const std::vector<float>& im, std::vector<float>& out) {
-    size_t N = cfg_.fftSize;
-    out.assign(N, 0.0f);
-    const double twoPiOverN = 2.0 * M_PI / static_cast<double>(N);
-    for (size_t n = 0; n < N; ++n) {
-        double sum = 0.0;
-        for (size_t k = 0; k < N; ++k) {
-            double angle = twoPiOverN * static_cast<double>(k * n);
-            sum += re[k] * std::cos(angle) - im[k] * std::sin(angle);
-        }
-        out[n] = static_cast<float>(sum / static_cast<double>(N));
-    }
+    fft_->inverse(re_.data(), im_.data(), frame_.data());
+
+    for (size_t i = 0; i < N; ++i) outBuf_[i] += frame_[i] * olaScale_ * window[i];
+
+    std::memcpy(outReady_.data(), outBuf_.data(), hop * sizeof(float));
+    std::memmove(outBuf_.data(), outBuf_.data() + hop, (N - hop) * sizeof(float));
+    std::memset(outBuf_.data() + (N - hop), 0, hop * sizeof(float));
+    std::memmove(inBuf_.data(), inBuf_.data() + hop, (N - hop) * sizeof(float));
 }
 
 void SpectralNR::process(const float* input, float* output, size_t numSamples) {
@@ -61,79 +84,18 @@ void SpectralNR::process(const float* input, float* output, size_t numSamples) {
         if (output != input) std::memcpy(output, input, numSamples * sizeof(float));
         return;
     }
-    size_t pos = 0;
-    while (pos < numSamples) {
-        size_t toCopy = std::min(cfg_.hopSize, numSamples - pos);
-        // Shift buffer left by hop
-        std::memmove(inBuf_.data(), inBuf_.data() + cfg_.hopSize, (cfg_.fftSize - cfg_.hopSize) * sizeof(float));
-        // Copy new input
-        std::memcpy(inBuf_.data() + (cfg_.fftSize - cfg_.hopSize), input + pos, toCopy * sizeof(float));
-        if (toCopy < cfg_.hopSize) {
-            std::memset(inBuf_.data() + (cfg_.fftSize - cfg_.hopSize + toCopy), 0, (cfg_.hopSize - toCopy) * sizeof(float));
-        }
-
-        // Window
-        std::vector<float> frame(cfg_.fftSize);
-        for (size_t i = 0; i < cfg_.fftSize; ++i) frame[i] = inBuf_[i] * window_[i];
-
-        // FFT
-        std::vector<float> re, im;
-        fft(frame, re, im);
-
-        // Magnitude and phase
-        size_t half = cfg_.fftSize / 2;
-        std::vector<float> mag(half + 1), ph(half + 1);
-        for (size_t k = 0; k <= half; ++k) {
-            float r = re[k]; float ii = im[k];
-            mag[k] = std::sqrt(r * r + ii * ii);
-            ph[k] = std::atan2(ii, r);
+    // Latence fixe (fftSize) : taille de bloc quelconque, aucune allocation
+    const size_t N = cfg_.fftSize;
+    const size_t hop = cfg_.hopSize;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const float x = input[i];
+        inBuf_[N - hop + inFill_] = x;
+        output[i] = outReady_[inFill_];
+        if (++inFill_ == hop) {
+            processFrame();
+            inFill_ = 0;
         }
-
-        // Noise estimate (MCRA-like)
-        if (noiseInit_) {
-            for (size_t k = 0; k <= half; ++k) noiseMag_[k] = mag[k];
-            noiseInit_ = false;
-        } else {
-            for (size_t k = 0; k <= half; ++k) noiseMag_[k] = static_cast<float>(cfg_.noiseUpdate * noiseMag_[k] + (1.0 - cfg_.noiseUpdate) * mag[k]);
-        }
-
-        // Spectral subtraction with floor
-        for (size_t k = 0; k <= half; ++k) {
-            float sub = mag[k] - static_cast<float>(cfg_.beta) * noiseMag_[k];
-            if (sub < cfg_.floorGain * noiseMag_[k]) sub = static_cast<float>(cfg_.floorGain * noiseMag_[k]);
-            mag[k] = sub;
-        }
-
-        // Reconstruct full spectrum (Hermitian for real signal)
-        for (size_t k = 0; k <= half; ++k) {
-            re[k] = mag[k] * std::cos(ph[k]);
-            im[k] = mag[k] * std::sin(ph[k]);
-        }
-        for (size_t k = half + 1; k < cfg_.fftSize; ++k) {
-            size_t kr = cfg_.fftSize - k;
-            re[k] = re[kr];
-            im[k] = -im[kr];
-        }
-
-        // IFFT
-        std::vector<float> time;
-        ifft(re, im, time);
-
-        // Overlap-add
-        if (outBuf_.size() != cfg_.fftSize) outBuf_.assign(cfg_.fftSize, 0.0f);
-        for (size_t i = 0; i < cfg_.fftSize; ++i) outBuf_[i] += time[i] * window_[i];
-
-        // Output hop segment
-        size_t outCount = std::min(cfg_.hopSize, numSamples - pos);
-        std::memcpy(output + pos, outBuf_.data(), outCount * sizeof(float));
-        // Shift out buffer left
-        std::memmove(outBuf_.data(), outBuf_.data() + cfg_.hopSize, (cfg_.fftSize - cfg_.hopSize) * sizeof(float));
-        std::memset(outBuf_.data() + (cfg_.fftSize - cfg_.hopSize), 0, cfg_.hopSize * sizeof(float));
-
-        pos += toCopy;
     }
 }
 
 } // namespace AudioNR
-
-
@@ -2,10 +2,13 @@
 
 #ifdef __cplusplus
 #include <vector>
+#include <memory>
 #include <cstdint>
 #include <cmath>
 #include <algorithm>
 
+namespace AudioEqualizer { class RealFFT; }
+
 namespace AudioNR {
 
 struct SpectralNRConfig {
@@ -26,24 +29,32 @@ public:
     void setConfig(const SpectralNRConfig& cfg);
     const SpectralNRConfig& getConfig() const { return cfg_; }
 
-    // Mono frame processing; input length arbitrary, output matched
+    // Mono frame processing; input length arbitrary, output matched.
+    // Latence : fftSize échantillons (fenêtre + hop en attente). In-place autorisé.
     void process(const float* input, float* output, size_t numSamples);
+    void reset();
+
+    // 0 quand désactivée (copie directe)
+    size_t getLatencySamples() const { return cfg_.enabled ? cfg_.fftSize : 0; }
 
 private:
     SpectralNRConfig cfg_{};
-    std::vector<float> window_;
     std::vector<float> inBuf_;
     std::vector<float> outBuf_;
-    size_t writePos_ = 0;
+    std::vector<float> outReady_;   // hop synthétisé, restitué pendant le hop suivant
+    size_t inFill_ = 0;
+    float olaScale_ = 1.0f;
 
     // Noise magnitude estimate per bin
     std::vector<float> noiseMag_;
     bool noiseInit_ = true;
 
-    // FFT buffers (simple Radix-2 Cooley–Tukey placeholder; replace with platform FFT if needed)
-    void fft(const std::vector<float>& in, std::vector<float>& re, std::vector<float>& im);
-    void ifft(const std::vector<float>& re, const std::vector<float>& im, std::vector<float>& out);
-    void buildWindow();
+    // FFT réelle partagée (fenêtre de Hann comprise), recréée dans setConfig()
+    std::unique_ptr<AudioEqualizer::RealFFT> fft_;
+    std::vector<float> frame_;
+    std::vector<float> re_;
+    std::vector<float> im_;
+    void processFrame();
 };
 
 } // namespace AudioNR
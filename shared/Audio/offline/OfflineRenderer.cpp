@@ -0,0 +1,742 @@
+#include "OfflineRenderer.h"
+#include "../effects/Compressor.h"
+#include "../effects/Delay.h"
+#include "../effects/Saturation.h"
+#include "../utils/RealtimeScope.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifdef FFMPEG_AVAILABLE
+extern "C" {
+    #include <libavformat/avformat.h>
+    #include <libavcodec/avcodec.h>
+    #include <libavutil/channel_layout.h>
+    #include <libavutil/mathematics.h>
+    #include <libswresample/swresample.h>
+}
+#endif
+
+namespace AudioOffline {
+
+// ===== RenderChain =====
+
+RenderChain::RenderChain(const ChainSettings& settings, uint32_t sampleRate, int channels, size_t maxBlock)
+    : channels_(channels == 1 ? 1 : 2)
+    , maxBlock_(std::max<size_t>(64, maxBlock))
+    , nr_(sampleRate, channels_)
+    , safety_(sampleRate, channels_)
+    , eq_(AudioEqualizer::NUM_BANDS, sampleRate) {
+    nr_.setConfig(settings.nr);
+
+    fx_.setEnabled(settings.fxEnabled);
+    fx_.setSampleRate(sampleRate, channels_);
+    auto* sat = fx_.emplaceEffect<AudioFX::SaturationEffect>();
+    sat->setParameters(static_cast<AudioFX::SaturationType>(settings.satType), settings.satDriveDb,
+                       settings.satMix, settings.satOutputDb);
+    sat->setEnabled(settings.satEnabled);
+    auto* comp = fx_.emplaceEffect<AudioFX::CompressorEffect>();
+    auto* del = fx_.emplaceEffect<AudioFX::DelayEffect>();
+    comp->setParameters(settings.compThresholdDb, settings.compRatio, settings.compAttackMs,
+                        settings.compReleaseMs, settings.compMakeupDb);
+    del->setParameters(settings.delayMs, settings.delayFeedback, settings.delayMix);
+
+    safety_.setConfig(settings.safety);
+
+    // Chaîne non partagée : pas de begin/endParameterUpdate (setBandGain verrouille déjà)
+    for (size_t i = 0; i < settings.eqBandGains.size() && i < eq_.getNumBands(); ++i) {
+        eq_.setBandGain(i, settings.eqBandGains[i]);
+    }
+    eq_.setMasterGain(settings.eqMasterGainDb);
+    eq_.setBypass(!settings.eqEnabled);
+}
+
+size_t RenderChain::warmUpFrames(const ChainSettings& settings, uint32_t sampleRate) {
+    // Filtres, enveloppes NR/compresseur et limiteur : quelques centaines de ms suffisent
+    double seconds = 0.5;
+    if (settings.fxEnabled && settings.delayMix > 0.0) {
+        // Retard réinjecté : temps pour que l'écho décroisse sous -80 dB
+        const double fb = std::clamp(std::abs(settings.delayFeedback), 1e-3, 0.95);
+        const double repeats = std::ceil(std::log(1e-4) / std::log(fb));
+        seconds = std::max(seconds, settings.delayMs * 0.001 * (repeats + 1.0));
+    }
+    return static_cast<size_t>(std::min(seconds, 10.0) * sampleRate);
+}
+
+void RenderChain::process(float* const* channels, size_t numFrames) {
+    for (size_t offset = 0; offset < numFrames; offset += maxBlock_) {
+        const size_t n = std::min(maxBlock_, numFrames - offset);
+        float* block[2] = {channels[0] + offset, channels_ == 2 ? channels[1] + offset : nullptr};
+        processBlock(block, n);
+    }
+}
+
+void RenderChain::processBlock(float* const* channels, size_t n) {
+    // Même ordre que la chaîne live : NR -> FX -> safety -> EQ, tout en place
+    if (channels_ == 1) {
+        nr_.processMono(channels[0], channels[0], n);
+        fx_.processMono(channels[0], channels[0], n);
+        safety_.processMono(channels[0], n);
+        eq_.process(channels[0], channels[0], n);
+    } else {
+        nr_.processStereo(channels[0], channels[1], channels[0], channels[1], n);
+        fx_.processStereo(channels[0], channels[1], channels[0], channels[1], n);
+        safety_.processStereo(channels[0], channels[1], n);
+        eq_.processStereo(channels[0], channels[1], channels[0], channels[1], n);
+    }
+}
+
+// ===== Fenêtres et segments =====
+
+size_t OfflineRenderer::segmentFramesFor(const ChainSettings& settings, const RenderOptions& options,
+                                         uint32_t sampleRate) {
+    // Un segment doit couvrir au moins deux chauffes pour que le surcoût reste borné.
+    // Multiple de blockSize : même découpage en blocs qu'un rendu continu (la sécurité
+    // estime le DC par bloc).
+    const size_t block = std::max<size_t>(1, options.blockSize);
+    size_t seg = static_cast<size_t>(std::max(0.5, options.segmentSeconds) * sampleRate);
+    seg = std::max(seg, 2 * RenderChain::warmUpFrames(settings, sampleRate));
+    return (seg + block - 1) / block * block;
+}
+
+namespace {
+struct WindowJob {
+    const ChainSettings* settings;
+    uint32_t sampleRate;
+    int channels;
+    const float* const* input;
+    float* const* output;
+    size_t frames;
+    size_t segmentFrames;
+    size_t blockSize;
+    size_t warmUp;
+    std::vector<std::unique_ptr<RenderChain>>* chains;
+};
+
+void renderSegmentTask(void* context, size_t s) {
+    auto& job = *static_cast<WindowJob*>(context);
+    const size_t begin = s * job.segmentFrames;
+    const size_t end = std::min(job.frames, begin + job.segmentFrames);
+    auto& chain = (*job.chains)[s];
+
+    if (!chain) {
+        chain = std::make_unique<RenderChain>(*job.settings, job.sampleRate, job.channels, job.blockSize);
+        // Chauffe sur l'entrée qui précède le segment (lue, jamais écrite par les autres tâches),
+        // arrondie au bloc comme la taille des segments
+        const size_t warmBlocks = (job.warmUp + job.blockSize - 1) / job.blockSize * job.blockSize;
+        const size_t warm = std::min(warmBlocks, begin);
+        if (warm > 0) {
+            std::vector<float> scratch[2];
+            float* ptrs[2] = {nullptr, nullptr};
+            for (int c = 0; c < job.channels; ++c) {
+                scratch[c].assign(job.input[c] + (begin - warm), job.input[c] + begin);
+                ptrs[c] = scratch[c].data();
+            }
+            chain->process(ptrs, warm);
+        }
+    }
+
+    float* ptrs[2] = {nullptr, nullptr};
+    for (int c = 0; c < job.channels; ++c) {
+        std::memcpy(job.output[c] + begin, job.input[c] + begin, (end - begin) * sizeof(float));
+        ptrs[c] = job.output[c] + begin;
+    }
+    chain->process(ptrs, end - begin);
+}
+} // namespace
+
+void OfflineRenderer::renderWindow(const ChainSettings& settings, uint32_t sampleRate, int channels,
+                                   const float* const* input, float* const* output, size_t frames,
+                                   size_t segmentFrames, size_t blockSize,
+                                   std::unique_ptr<RenderChain>& carry,
+                                   AudioEqualizer::AudioTaskPool* pool) {
+    if (frames == 0) return;
+    const size_t segFrames = pool ? std::max<size_t>(1, segmentFrames) : frames;
+    const size_t numSegments = (frames + segFrames - 1) / segFrames;
+
+    std::vector<std::unique_ptr<RenderChain>> chains(numSegments);
+    chains[0] = std::move(carry);
+
+    WindowJob job{&settings, sampleRate, channels == 1 ? 1 : 2, input, output, frames, segFrames,
+                  blockSize, RenderChain::warmUpFrames(settings, sampleRate), &chains};
+    if (pool && numSegments > 1) {
+        pool->parallelFor(numSegments, &renderSegmentTask, &job);
+    } else {
+        for (size_t s = 0; s < numSegments; ++s) renderSegmentTask(&job, s);
+    }
+    carry = std::move(chains.back());
+}
+
+// ===== Normalisation =====
+
+void OfflineRenderer::measureWindow(AudioSafety::LoudnessMeter& meter, int channels,
+                                    const float* const* output, size_t frames) {
+    if (channels == 1) {
+        meter.processMono(output[0], frames);
+    } else {
+        meter.processStereo(output[0], output[1], frames);
+    }
+}
+
+double OfflineRenderer::exportGainDb(const RenderOptions& options, const AudioSafety::LoudnessReport& measured) {
+    if (!options.normalize) return 0.0;
+    return AudioSafety::LoudnessMeter::normalizationGainDb(measured, options.targetLufs, options.ceilingDbtp);
+}
+
+void OfflineRenderer::applyGain(float* const* output, int channels, size_t frames, double gainDb) {
+    if (gainDb == 0.0) return;
+    const float g = static_cast<float>(std::pow(10.0, gainDb / 20.0));
+    for (int c = 0; c < (channels == 1 ? 1 : 2); ++c) {
+        float* x = output[c];
+        for (size_t i = 0; i < frames; ++i) x[i] *= g;
+    }
+}
+
+// ===== E/S FFmpeg =====
+
+#ifdef FFMPEG_AVAILABLE
+namespace {
+
+std::string avErrorString(int err) {
+    char buf[AV_ERROR_MAX_STRING_SIZE] = {0};
+    av_strerror(err, buf, sizeof(buf));
+    return buf;
+}
+
+// Durée de la piste audio principale (µs), 0 si inconnue
+uint64_t probeAudioDurationUs(const std::string& path) {
+    AVFormatContext* fmt = nullptr;
+    if (avformat_open_input(&fmt, path.c_str(), nullptr, nullptr) < 0) return 0;
+    uint64_t us = 0;
+    if (avformat_find_stream_info(fmt, nullptr) >= 0) {
+        int idx = av_find_best_stream(fmt, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+        if (idx >= 0 && fmt->streams[idx]->duration > 0) {
+            us = static_cast<uint64_t>(av_rescale_q(fmt->streams[idx]->duration, fmt->streams[idx]->time_base, AVRational{1, 1000000}));
+        } else if (fmt->duration > 0) {
+            us = static_cast<uint64_t>(fmt->duration);
+        }
+    }
+    avformat_close_input(&fmt);
+    return us;
+}
+
+// Démultiplexe l'entrée, décode l'audio en float planaire (mono/stéréo), ré-encode l'audio
+// traité et recopie tels quels les paquets des autres pistes.
+class MediaTranscoder {
+public:
+    ~MediaTranscoder() { close(); }
+
+    bool open(const std::string& inPath, const std::string& outPath, std::string& error) {
+        return openInput(inPath, error) && openOutput(outPath, error);
+    }
+    // Décodage seul (passe de mesure) : les paquets des autres pistes sont ignorés
+    bool openInput(const std::string& inPath, std::string& error);
+    uint32_t sampleRate() const { return sampleRate_; }
+    int channels() const { return channels_; }
+
+    // Ajoute jusqu'à maxFrames - frames échantillons décodés à planar[c][frames..]
+    bool readAudio(std::vector<std::vector<float>>& planar, size_t& frames, size_t maxFrames,
+                   bool& eof, std::string& error);
+    bool writeAudio(const float* const* planar, size_t frames, std::string& error);
+    bool finish(std::string& error);
+    void close();
+
+private:
+    bool openOutput(const std::string& outPath, std::string& error);
+    bool decodeMore(std::string& error);
+    bool encodeFrame(size_t offset, size_t n, std::string& error);
+    bool drainEncoder(std::string& error);
+
+    AVFormatContext* inFmt_ = nullptr;
+    AVFormatContext* outFmt_ = nullptr;
+    AVCodecContext* dec_ = nullptr;
+    AVCodecContext* enc_ = nullptr;
+    SwrContext* swrIn_ = nullptr;
+    SwrContext* swrOut_ = nullptr;
+    AVPacket* pkt_ = nullptr;
+    AVFrame* frame_ = nullptr;
+    AVFrame* encFrame_ = nullptr;
+    int audioIndex_ = -1;
+    int outAudioIndex_ = -1;
+    std::vector<int> streamMap_;
+    uint32_t sampleRate_ = 0;
+    int channels_ = 0;
+    size_t frameSize_ = 1024;
+    bool padLastFrame_ = false;
+    int64_t nextPts_ = 0;
+    bool demuxEof_ = false;
+    bool decoderDrained_ = false;
+    bool headerWritten_ = false;
+
+    std::vector<std::vector<float>> decoded_;   // décodé, pas encore rendu
+    size_t decodedFrames_ = 0;
+    std::vector<std::vector<float>> toEncode_;  // rendu, en attente d'une trame complète
+    size_t toEncodeFrames_ = 0;
+};
+
+bool MediaTranscoder::openInput(const std::string& inPath, std::string& error) {
+    int r = avformat_open_input(&inFmt_, inPath.c_str(), nullptr, nullptr);
+    if (r < 0) { error = "Ouverture impossible: " + avErrorString(r); return false; }
+    if ((r = avformat_find_stream_info(inFmt_, nullptr)) < 0) { error = avErrorString(r); return false; }
+
+    const AVCodec* decCodec = nullptr;
+    audioIndex_ = av_find_best_stream(inFmt_, AVMEDIA_TYPE_AUDIO, -1, -1, &decCodec, 0);
+    if (audioIndex_ < 0 || !decCodec) { error = "Aucune piste audio"; return false; }
+    AVStream* inAudio = inFmt_->streams[audioIndex_];
+
+    dec_ = avcodec_alloc_context3(decCodec);
+    if (!dec_ || avcodec_parameters_to_context(dec_, inAudio->codecpar) < 0) { error = "Décodeur audio"; return false; }
+    dec_->pkt_timebase = inAudio->time_base;
+    if ((r = avcodec_open2(dec_, decCodec, nullptr)) < 0) { error = "Décodeur audio: " + avErrorString(r); return false; }
+
+    sampleRate_ = static_cast<uint32_t>(dec_->sample_rate);
+    channels_ = dec_->ch_layout.nb_channels >= 2 ? 2 : 1;
+    AVChannelLayout layout;
+    av_channel_layout_default(&layout, channels_);
+    if (swr_alloc_set_opts2(&swrIn_, &layout, AV_SAMPLE_FMT_FLTP, dec_->sample_rate,
+                            &dec_->ch_layout, dec_->sample_fmt, dec_->sample_rate, 0, nullptr) < 0 ||
+        swr_init(swrIn_) < 0) {
+        error = "Conversion audio (entrée)";
+        return false;
+    }
+    av_channel_layout_uninit(&layout);
+
+    pkt_ = av_packet_alloc();
+    frame_ = av_frame_alloc();
+    if (!pkt_ || !frame_) { error = "Mémoire"; return false; }
+    decoded_.assign(channels_, {});
+    return true;
+}
+
+bool MediaTranscoder::openOutput(const std::string& outPath, std::string& error) {
+    AVStream* inAudio = inFmt_->streams[audioIndex_];
+    AVChannelLayout layout;
+    av_channel_layout_default(&layout, channels_);
+    int r = 0;
+    if ((r = avformat_alloc_output_context2(&outFmt_, nullptr, nullptr, outPath.c_str())) < 0 || !outFmt_) {
+        error = "Format de sortie: " + avErrorString(r);
+        return false;
+    }
+
+    // Encodeur : codec d'origine si disponible, sinon AAC
+    const AVCodec* encCodec = avcodec_find_encoder(inAudio->codecpar->codec_id);
+    if (!encCodec || avformat_query_codec(outFmt_->oformat, encCodec->id, FF_COMPLIANCE_NORMAL) != 1) {
+        encCodec = avcodec_find_encoder(AV_CODEC_ID_AAC);
+    }
+    if (!encCodec) { error = "Aucun encodeur audio"; return false; }
+    enc_ = avcodec_alloc_context3(encCodec);
+    if (!enc_) { error = "Encodeur audio"; return false; }
+    enc_->sample_rate = dec_->sample_rate;
+    av_channel_layout_copy(&enc_->ch_layout, &layout);
+    const AVSampleFormat* fmts = nullptr;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(61, 13, 100)
+    avcodec_get_supported_config(enc_, encCodec, AV_CODEC_CONFIG_SAMPLE_FORMAT, 0,
+                                 reinterpret_cast<const void**>(&fmts), nullptr);
+#else
+    fmts = encCodec->sample_fmts;
+#endif
+    enc_->sample_fmt = AV_SAMPLE_FMT_FLTP;
+    if (fmts) {
+        enc_->sample_fmt = fmts[0];
+        for (const AVSampleFormat* f = fmts; *f != AV_SAMPLE_FMT_NONE; ++f) {
+            if (*f == AV_SAMPLE_FMT_FLTP) { enc_->sample_fmt = *f; break; }
+        }
+    }
+    enc_->bit_rate = inAudio->codecpar->bit_rate > 0 ? inAudio->codecpar->bit_rate : 192000;
+    enc_->time_base = AVRational{1, dec_->sample_rate};
+    if (outFmt_->oformat->flags & AVFMT_GLOBALHEADER) enc_->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    if ((r = avcodec_open2(enc_, encCodec, nullptr)) < 0) { error = "Encodeur audio: " + avErrorString(r); return false; }
+
+    const bool variable = (encCodec->capabilities & AV_CODEC_CAP_VARIABLE_FRAME_SIZE) != 0;
+    frameSize_ = (enc_->frame_size > 0 && !variable) ? static_cast<size_t>(enc_->frame_size) : 1024;
+    padLastFrame_ = !variable && !(encCodec->capabilities & AV_CODEC_CAP_SMALL_LAST_FRAME);
+
+    if (swr_alloc_set_opts2(&swrOut_, &layout, enc_->sample_fmt, enc_->sample_rate,
+                            &layout, AV_SAMPLE_FMT_FLTP, enc_->sample_rate, 0, nullptr) < 0 ||
+        swr_init(swrOut_) < 0) {
+        error = "Conversion audio (sortie)";
+        return false;
+    }
+    av_channel_layout_uninit(&layout);
+
+    // Pistes de sortie : audio ré-encodé, autres pistes recopiées
+    streamMap_.assign(inFmt_->nb_streams, -1);
+    for (unsigned i = 0; i < inFmt_->nb_streams; ++i) {
+        AVStream* in = inFmt_->streams[i];
+        const AVMediaType type = in->codecpar->codec_type;
+        if (static_cast<int>(i) != audioIndex_ && type != AVMEDIA_TYPE_VIDEO &&
+            type != AVMEDIA_TYPE_AUDIO && type != AVMEDIA_TYPE_SUBTITLE) continue;
+        AVStream* out = avformat_new_stream(outFmt_, nullptr);
+        if (!out) { error = "Piste de sortie"; return false; }
+        if (static_cast<int>(i) == audioIndex_) {
+            avcodec_parameters_from_context(out->codecpar, enc_);
+            out->time_base = enc_->time_base;
+            outAudioIndex_ = out->index;
+        } else {
+            avcodec_parameters_copy(out->codecpar, in->codecpar);
+            out->codecpar->codec_tag = 0;
+            out->time_base = in->time_base;
+        }
+        av_dict_copy(&out->metadata, in->metadata, 0);
+        streamMap_[i] = out->index;
+    }
+
+    if (!(outFmt_->oformat->flags & AVFMT_NOFILE)) {
+        if ((r = avio_open(&outFmt_->pb, outPath.c_str(), AVIO_FLAG_WRITE)) < 0) {
+            error = "Écriture impossible: " + avErrorString(r);
+            return false;
+        }
+    }
+    if ((r = avformat_write_header(outFmt_, nullptr)) < 0) { error = "En-tête: " + avErrorString(r); return false; }
+    headerWritten_ = true;
+
+    encFrame_ = av_frame_alloc();
+    if (!encFrame_) { error = "Mémoire"; return false; }
+    encFrame_->format = enc_->sample_fmt;
+    av_channel_layout_copy(&encFrame_->ch_layout, &enc_->ch_layout);
+    encFrame_->sample_rate = enc_->sample_rate;
+    encFrame_->nb_samples = static_cast<int>(frameSize_);
+    if (av_frame_get_buffer(encFrame_, 0) < 0) { error = "Mémoire"; return false; }
+
+    // Alignement sur le début d'origine de la piste audio (synchro vidéo)
+    if (inAudio->start_time != AV_NOPTS_VALUE) {
+        nextPts_ = av_rescale_q(inAudio->start_time, inAudio->time_base, enc_->time_base);
+    }
+    toEncode_.assign(channels_, {});
+    return true;
+}
+
+bool MediaTranscoder::decodeMore(std::string& error) {
+    for (;;) {
+        int r = avcodec_receive_frame(dec_, frame_);
+        if (r == 0) {
+            const int maxOut = swr_get_out_samples(swrIn_, frame_->nb_samples);
+            for (auto& ch : decoded_) ch.resize(decodedFrames_ + static_cast<size_t>(std::max(0, maxOut)));
+            uint8_t* dst[2] = {nullptr, nullptr};
+            for (int c = 0; c < channels_; ++c) dst[c] = reinterpret_cast<uint8_t*>(decoded_[c].data() + decodedFrames_);
+            const int got = swr_convert(swrIn_, dst, maxOut, const_cast<const uint8_t**>(frame_->extended_data), frame_->nb_samples);
+            av_frame_unref(frame_);
+            if (got < 0) { error = "Conversion audio: " + avErrorString(got); return false; }
+            decodedFrames_ += static_cast<size_t>(got);
+            return true;
+        }
+        if (r == AVERROR_EOF) {
+            // Fin du décodeur : vidange du convertisseur
+            const int maxOut = swr_get_out_samples(swrIn_, 0);
+            if (maxOut > 0) {
+                for (auto& ch : decoded_) ch.resize(decodedFrames_ + static_cast<size_t>(maxOut));
+                uint8_t* dst[2] = {nullptr, nullptr};
+                for (int c = 0; c < channels_; ++c) dst[c] = reinterpret_cast<uint8_t*>(decoded_[c].data() + decodedFrames_);
+                const int got = swr_convert(swrIn_, dst, maxOut, nullptr, 0);
+                if (got > 0) decodedFrames_ += static_cast<size_t>(got);
+            }
+            decoderDrained_ = true;
+            return true;
+        }
+        if (r != AVERROR(EAGAIN)) { error = "Décodage: " + avErrorString(r); return false; }
+
+        // Le décodeur attend un paquet
+        if (demuxEof_) {
+            avcodec_send_packet(dec_, nullptr);
+            continue;
+        }
+        r = av_read_frame(inFmt_, pkt_);
+        if (r < 0) {
+            demuxEof_ = true;
+            avcodec_send_packet(dec_, nullptr);
+            continue;
+        }
+        const int outIndex = pkt_->stream_index < static_cast<int>(streamMap_.size()) ? streamMap_[pkt_->stream_index] : -1;
+        if (pkt_->stream_index == audioIndex_) {
+            r = avcodec_send_packet(dec_, pkt_);
+            av_packet_unref(pkt_);
+            if (r < 0 && r != AVERROR(EAGAIN)) { error = "Décodage: " + avErrorString(r); return false; }
+        } else if (outIndex >= 0) {
+            av_packet_rescale_ts(pkt_, inFmt_->streams[pkt_->stream_index]->time_base, outFmt_->streams[outIndex]->time_base);
+            pkt_->stream_index = outIndex;
+            pkt_->pos = -1;
+            r = av_interleaved_write_frame(outFmt_, pkt_);
+            if (r < 0) { error = "Recopie: " + avErrorString(r); return false; }
+        } else {
+            av_packet_unref(pkt_);
+        }
+    }
+}
+
+bool MediaTranscoder::readAudio(std::vector<std::vector<float>>& planar, size_t& frames, size_t maxFrames,
+                                bool& eof, std::string& error) {
+    eof = false;
+    while (frames < maxFrames) {
+        if (decodedFrames_ > 0) {
+            const size_t n = std::min(decodedFrames_, maxFrames - frames);
+            for (int c = 0; c < channels_; ++c) {
+                std::memcpy(planar[c].data() + frames, decoded_[c].data(), n * sizeof(float));
+                decoded_[c].erase(decoded_[c].begin(), decoded_[c].begin() + static_cast<std::ptrdiff_t>(n));
+            }
+            decodedFrames_ -= n;
+            frames += n;
+            continue;
+        }
+        if (decoderDrained_) { eof = true; break; }
+        if (!decodeMore(error)) return false;
+    }
+    return true;
+}
+
+bool MediaTranscoder::writeAudio(const float* const* planar, size_t frames, std::string& error) {
+    for (int c = 0; c < channels_; ++c) toEncode_[c].insert(toEncode_[c].end(), planar[c], planar[c] + frames);
+    toEncodeFrames_ += frames;
+    size_t offset = 0;
+    while (toEncodeFrames_ - offset >= frameSize_) {
+        if (!encodeFrame(offset, frameSize_, error)) return false;
+        offset += frameSize_;
+    }
+    // Reste (< une trame) gardé pour l'appel suivant
+    for (int c = 0; c < channels_; ++c) {
+        toEncode_[c].erase(toEncode_[c].begin(), toEncode_[c].begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+    toEncodeFrames_ -= offset;
+    return true;
+}
+
+bool MediaTranscoder::encodeFrame(size_t offset, size_t n, std::string& error) {
+    int r = av_frame_make_writable(encFrame_);
+    if (r < 0) { error = avErrorString(r); return false; }
+    // Dernière trame complétée par du silence si l'encodeur l'exige
+    const size_t outFrames = padLastFrame_ ? frameSize_ : n;
+    for (int c = 0; c < channels_; ++c) {
+        if (toEncode_[c].size() < offset + outFrames) toEncode_[c].resize(offset + outFrames, 0.0f);
+    }
+    const uint8_t* src[2] = {nullptr, nullptr};
+    for (int c = 0; c < channels_; ++c) src[c] = reinterpret_cast<const uint8_t*>(toEncode_[c].data() + offset);
+    encFrame_->nb_samples = static_cast<int>(outFrames);
+    r = swr_convert(swrOut_, encFrame_->extended_data, static_cast<int>(outFrames), src, static_cast<int>(outFrames));
+    if (r < 0) { error = "Conversion audio: " + avErrorString(r); return false; }
+    encFrame_->pts = nextPts_;
+    nextPts_ += static_cast<int64_t>(outFrames);
+    r = avcodec_send_frame(enc_, encFrame_);
+    if (r < 0) { error = "Encodage: " + avErrorString(r); return false; }
+    return drainEncoder(error);
+}
+
+bool MediaTranscoder::drainEncoder(std::string& error) {
+    for (;;) {
+        int r = avcodec_receive_packet(enc_, pkt_);
+        if (r == AVERROR(EAGAIN) || r == AVERROR_EOF) return true;
+        if (r < 0) { error = "Encodage: " + avErrorString(r); return false; }
+        pkt_->stream_index = outAudioIndex_;
+        av_packet_rescale_ts(pkt_, enc_->time_base, outFmt_->streams[outAudioIndex_]->time_base);
+        r = av_interleaved_write_frame(outFmt_, pkt_);
+        if (r < 0) { error = "Écriture audio: " + avErrorString(r); return false; }
+    }
+}
+
+bool MediaTranscoder::finish(std::string& error) {
+    if (toEncodeFrames_ > 0) {
+        if (!encodeFrame(0, toEncodeFrames_, error)) return false;
+        toEncodeFrames_ = 0;
+    }
+    int r = avcodec_send_frame(enc_, nullptr);
+    if (r < 0 && r != AVERROR_EOF) { error = "Encodage: " + avErrorString(r); return false; }
+    if (!drainEncoder(error)) return false;
+    r = av_write_trailer(outFmt_);
+    headerWritten_ = false;
+    if (r < 0) { error = "Finalisation: " + avErrorString(r); return false; }
+    return true;
+}
+
+void MediaTranscoder::close() {
+    if (outFmt_) {
+        if (!(outFmt_->oformat->flags & AVFMT_NOFILE)) avio_closep(&outFmt_->pb);
+        avformat_free_context(outFmt_);
+        outFmt_ = nullptr;
+    }
+    if (inFmt_) avformat_close_input(&inFmt_);
+    avcodec_free_context(&dec_);
+    avcodec_free_context(&enc_);
+    swr_free(&swrIn_);
+    swr_free(&swrOut_);
+    av_packet_free(&pkt_);
+    av_frame_free(&frame_);
+    av_frame_free(&encFrame_);
+}
+
+// clip.mp4 -> clip.naaya-tmp.mp4 (l'extension guide le choix du conteneur)
+std::string temporaryPathFor(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    const size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + ".naaya-tmp";
+    return path.substr(0, dot) + ".naaya-tmp" + path.substr(dot);
+}
+
+} // namespace
+#endif // FFMPEG_AVAILABLE
+
+// ===== OfflineRenderer =====
+
+OfflineRenderer::OfflineRenderer(const ChainSettings& settings, const RenderOptions& options)
+    : settings_(settings), options_(options) {}
+
+OfflineRenderer::~OfflineRenderer() {
+    cancel();
+    wait();
+}
+
+bool OfflineRenderer::start(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs) {
+    if (worker_.joinable() || inputs.empty() || inputs.size() != outputs.size()) return false;
+    inputs_ = inputs;
+    outputs_ = outputs;
+    cancel_.store(false);
+    filesDone_.store(0);
+    audioUsDone_.store(0);
+    audioUsTotal_.store(0);
+    elapsedUs_.store(0);
+    startTime_ = std::chrono::steady_clock::now();
+    state_.store(static_cast<int>(RenderState::Running));
+    worker_ = std::thread([this] { run(); });
+    return true;
+}
+
+void OfflineRenderer::wait() {
+    if (worker_.joinable()) worker_.join();
+}
+
+RenderProgress OfflineRenderer::getProgress() const {
+    RenderProgress p;
+    p.state = static_cast<RenderState>(state_.load());
+    p.filesTotal = inputs_.size();
+    p.filesDone = filesDone_.load();
+    const uint64_t done = audioUsDone_.load();
+    const uint64_t total = audioUsTotal_.load();
+    p.audioSeconds = static_cast<double>(done) * 1e-6;
+    if (p.state == RenderState::Done) {
+        p.progress = 1.0;
+    } else if (total > 0) {
+        p.progress = std::min(1.0, static_cast<double>(done) / static_cast<double>(total));
+    } else if (p.filesTotal > 0) {
+        p.progress = static_cast<double>(p.filesDone) / static_cast<double>(p.filesTotal);
+    }
+    int64_t us = elapsedUs_.load();
+    if (p.state == RenderState::Running) {
+        us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime_).count();
+    }
+    p.elapsedSeconds = static_cast<double>(us) * 1e-6;
+    p.realtimeFactor = p.elapsedSeconds > 0.0 ? p.audioSeconds / p.elapsedSeconds : 0.0;
+    std::lock_guard<std::mutex> lk(errorMutex_);
+    p.error = error_;
+    return p;
+}
+
+void OfflineRenderer::setError(const std::string& message) {
+    std::lock_guard<std::mutex> lk(errorMutex_);
+    if (error_.empty()) error_ = message;
+}
+
+void OfflineRenderer::run() {
+    // FTZ/DAZ comme la chaîne live; pas de section temps réel, le rendu alloue et fait des E/S
+    AudioEqualizer::DenormalScope ftz;
+    bool ok = true;
+#ifdef FFMPEG_AVAILABLE
+    uint64_t total = 0;
+    for (const auto& in : inputs_) total += probeAudioDurationUs(in);
+    // Normalisation : la passe de mesure décode et rend chaque fichier une fois de plus
+    audioUsTotal_.store(options_.normalize ? 2 * total : total);
+
+    AudioEqualizer::AudioTaskPool pool(options_.numWorkers, false);
+    if (inputs_.size() >= pool.getNumThreads() && inputs_.size() > 1) {
+        // Un fichier par participant, chacun rendu séquentiellement
+        std::atomic<bool> allOk{true};
+        auto task = [this, &allOk](size_t i) {
+            if (!renderFile(i, nullptr)) allOk.store(false);
+        };
+        pool.parallelFor(inputs_.size(), task);
+        ok = allOk.load();
+    } else {
+        for (size_t i = 0; i < inputs_.size() && !cancel_.load(); ++i) {
+            ok = renderFile(i, &pool) && ok;
+        }
+    }
+#else
+    setError("FFmpeg indisponible");
+    ok = false;
+#endif
+    elapsedUs_.store(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime_).count());
+    RenderState final = RenderState::Done;
+    if (cancel_.load()) final = RenderState::Cancelled;
+    else if (!ok) final = RenderState::Failed;
+    state_.store(static_cast<int>(final));
+}
+
+bool OfflineRenderer::renderFile(size_t index, AudioEqualizer::AudioTaskPool* pool) {
+#ifdef FFMPEG_AVAILABLE
+    const std::string& inPath = inputs_[index];
+    const std::string& outPath = outputs_[index];
+    const bool inPlace = inPath == outPath;
+    const std::string writePath = inPlace ? temporaryPathFor(outPath) : outPath;
+
+    std::string error;
+    // Lecture -> chaîne -> mesure ou écriture (gain d'export appliqué), chaîne neuve à chaque passe
+    auto renderPass = [&](MediaTranscoder& io, AudioSafety::LoudnessMeter* meter, double gainDb) {
+        const uint32_t sr = io.sampleRate();
+        const int ch = io.channels();
+        const size_t seg = segmentFramesFor(settings_, options_, sr);
+        const size_t window = pool ? seg * pool->getNumThreads() : seg;
+        std::vector<std::vector<float>> in(ch, std::vector<float>(window));
+        std::vector<std::vector<float>> out(ch, std::vector<float>(window));
+        const float* inPtrs[2] = {in[0].data(), ch == 2 ? in[1].data() : nullptr};
+        float* outPtrs[2] = {out[0].data(), ch == 2 ? out[1].data() : nullptr};
+        std::unique_ptr<RenderChain> carry;
+
+        bool eof = false;
+        while (!eof) {
+            if (cancel_.load()) return false;
+            size_t frames = 0;
+            if (!io.readAudio(in, frames, window, eof, error)) return false;
+            if (frames == 0) break;
+            renderWindow(settings_, sr, ch, inPtrs, outPtrs, frames, seg, options_.blockSize, carry, pool);
+            if (meter) {
+                measureWindow(*meter, ch, outPtrs, frames);
+            } else {
+                applyGain(outPtrs, ch, frames, gainDb);
+                if (!io.writeAudio(outPtrs, frames, error)) return false;
+            }
+            audioUsDone_.fetch_add(static_cast<uint64_t>(frames) * 1000000ull / sr);
+        }
+        return meter ? true : io.finish(error);
+    };
+
+    bool ok = true;
+    double gainDb = 0.0;
+    if (options_.normalize) {
+        MediaTranscoder probe;
+        ok = probe.openInput(inPath, error);
+        if (ok) {
+            AudioSafety::LoudnessMeter meter(probe.sampleRate());
+            ok = renderPass(probe, &meter, 0.0);
+            if (ok) gainDb = exportGainDb(options_, meter.getReport());
+        }
+    }
+    if (ok) {
+        MediaTranscoder io;
+        ok = io.open(inPath, writePath, error) && renderPass(io, nullptr, gainDb);
+    }
+
+    if (ok && inPlace && std::rename(writePath.c_str(), outPath.c_str()) != 0) {
+        ok = false;
+        error = "Remplacement du fichier impossible";
+    }
+    if (!ok) {
+        std::remove(writePath.c_str());
+        if (!cancel_.load()) setError(inPath + ": " + error);
+        return false;
+    }
+    filesDone_.fetch_add(1);
+    return true;
+#else
+    (void)index; (void)pool;
+    return false;
+#endif
+}
+
+} // namespace AudioOffline
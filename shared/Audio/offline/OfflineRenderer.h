@@ -0,0 +1,164 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "../core/AudioEqualizer.h"
+#include "../effects/EffectChain.h"
+#include "../noise/NoiseReducer.h"
+#include "../safety/AudioSafety.h"
+#include "../utils/AudioTaskPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AudioOffline {
+
+// Réglages figés de la chaîne NR -> FX -> safety -> EQ (copie de l'état live au lancement)
+struct ChainSettings {
+    AudioNR::NoiseReducerConfig nr;           // nr.enabled = false : passe-tout
+    bool fxEnabled = false;
+    double compThresholdDb = -18.0;
+    double compRatio = 3.0;
+    double compAttackMs = 10.0;
+    double compReleaseMs = 80.0;
+    double compMakeupDb = 0.0;
+    double delayMs = 150.0;
+    double delayFeedback = 0.3;
+    double delayMix = 0.25;
+    bool satEnabled = false;
+    int satType = 0;                           // AudioFX::SaturationType
+    double satDriveDb = 12.0;
+    double satMix = 1.0;
+    double satOutputDb = -6.0;
+    AudioSafety::SafetyConfig safety;
+    bool eqEnabled = false;
+    double eqMasterGainDb = 0.0;
+    std::vector<double> eqBandGains;
+};
+
+// Une instance de la chaîne pour un flux continu (fichier ou segment)
+class RenderChain {
+public:
+    RenderChain(const ChainSettings& settings, uint32_t sampleRate, int channels, size_t maxBlock);
+
+    // Planaire, en place; blocs de taille quelconque (découpés à maxBlock)
+    void process(float* const* channels, size_t numFrames);
+
+    // Entrée à traiter (puis jeter) avant un segment pour que filtres, enveloppes et
+    // ligne de retard rejoignent l'état d'un rendu continu
+    static size_t warmUpFrames(const ChainSettings& settings, uint32_t sampleRate);
+
+private:
+    void processBlock(float* const* channels, size_t n);
+
+    int channels_;
+    size_t maxBlock_;
+    AudioNR::NoiseReducer nr_;
+    AudioFX::EffectChain fx_;
+    AudioSafety::AudioSafetyEngine safety_;
+    AudioEqualizer::AudioEqualizer eq_;
+};
+
+struct RenderOptions {
+    size_t blockSize = 4096;       // bloc de traitement de la chaîne
+    double segmentSeconds = 4.0;   // découpage d'un fichier entre les coeurs
+    size_t numWorkers = AudioEqualizer::AudioTaskPool::recommendedWorkers();
+    // Normalisation à l'export : une passe de mesure de la sortie de la chaîne, puis le rendu
+    // avec le gain qui amène l'intégrée à targetLufs, réduit pour que le true peak reste sous
+    // ceilingDbtp. Deux décodages par fichier.
+    bool normalize = false;
+    double targetLufs = -14.0;
+    double ceilingDbtp = -1.0;
+};
+
+enum class RenderState : int {
+    Idle = 0,
+    Running,
+    Done,
+    Cancelled,
+    Failed
+};
+
+struct RenderProgress {
+    RenderState state = RenderState::Idle;
+    double progress = 0.0;         // 0..1 (durée audio traitée / durée totale)
+    double realtimeFactor = 0.0;   // secondes audio traitées par seconde de calcul
+    double audioSeconds = 0.0;
+    double elapsedSeconds = 0.0;
+    size_t filesDone = 0;
+    size_t filesTotal = 0;
+    std::string error;
+};
+
+// Rendu hors ligne : décodage FFmpeg en flux, chaîne partagée en grands blocs, ré-encodage
+// de l'audio et recopie des autres pistes (vidéo) dans le fichier de sortie.
+//
+// Parallélisme : autant de fichiers que de coeurs -> un fichier par coeur; sinon chaque
+// fenêtre décodée d'un fichier est découpée en segments rendus en parallèle. Le premier
+// segment poursuit la chaîne de la fenêtre précédente (rendu exact), les suivants partent
+// d'une chaîne neuve chauffée sur l'entrée qui les précède (voir warmUpFrames()).
+// Sortie = entrée : écriture dans un fichier temporaire puis remplacement.
+class OfflineRenderer {
+public:
+    explicit OfflineRenderer(const ChainSettings& settings, const RenderOptions& options = {});
+    ~OfflineRenderer();
+
+    OfflineRenderer(const OfflineRenderer&) = delete;
+    OfflineRenderer& operator=(const OfflineRenderer&) = delete;
+
+    // Lance le rendu sur un thread dédié; false si déjà lancé ou listes incohérentes
+    bool start(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs);
+    void cancel() { cancel_.store(true, std::memory_order_relaxed); }
+    void wait();
+    RenderProgress getProgress() const;
+
+    // Cœur sans E/S d'une fenêtre planaire (voir la description de la classe).
+    // carry : chaîne poursuivie par le segment 0, remplacée par celle du dernier segment.
+    // pool nul : un seul segment (rendu séquentiel exact).
+    static void renderWindow(const ChainSettings& settings, uint32_t sampleRate, int channels,
+                             const float* const* input, float* const* output, size_t frames,
+                             size_t segmentFrames, size_t blockSize,
+                             std::unique_ptr<RenderChain>& carry,
+                             AudioEqualizer::AudioTaskPool* pool);
+
+    static size_t segmentFramesFor(const ChainSettings& settings, const RenderOptions& options,
+                                   uint32_t sampleRate);
+
+    // Normalisation : mesure d'une fenêtre rendue, gain d'export (dB, 0 sans normalize),
+    // application en place
+    static void measureWindow(AudioSafety::LoudnessMeter& meter, int channels,
+                              const float* const* output, size_t frames);
+    static double exportGainDb(const RenderOptions& options, const AudioSafety::LoudnessReport& measured);
+    static void applyGain(float* const* output, int channels, size_t frames, double gainDb);
+
+private:
+    void run();
+    bool renderFile(size_t index, AudioEqualizer::AudioTaskPool* pool);
+    void setError(const std::string& message);
+
+    ChainSettings settings_;
+    RenderOptions options_;
+    std::vector<std::string> inputs_;
+    std::vector<std::string> outputs_;
+    std::thread worker_;
+
+    std::atomic<bool> cancel_{false};
+    std::atomic<int> state_{static_cast<int>(RenderState::Idle)};
+    // Durées audio en microsecondes : les fichiers peuvent avoir des fréquences différentes
+    std::atomic<uint64_t> audioUsDone_{0};
+    std::atomic<uint64_t> audioUsTotal_{0};
+    std::atomic<size_t> filesDone_{0};
+    std::chrono::steady_clock::time_point startTime_{};
+    std::atomic<int64_t> elapsedUs_{0};          // figé à la fin du rendu
+    mutable std::mutex errorMutex_;
+    std::string error_;
+};
+
+} // namespace AudioOffline
+
+#endif // __cplusplus
@@ -4,13 +4,16 @@
 namespace AudioSafety {
 
 AudioSafetyEngine::AudioSafetyEngine(uint32_t sampleRate, int channels)
-    : sampleRate_(sampleRate), channels_(channels) {
+    : sampleRate_(sampleRate), channels_(channels), loudness_(sampleRate) {
     setConfig(SafetyConfig{});
 }
 
 AudioSafetyEngine::~AudioSafetyEngine() = default;
 
-void AudioSafetyEngine::setSampleRate(uint32_t sr) { sampleRate_ = sr; }
+void AudioSafetyEngine::setSampleRate(uint32_t sr) {
+    if (sr != sampleRate_) loudness_.setSampleRate(sr);
+    sampleRate_ = sr;
+}
 
 void AudioSafetyEngine::setConfig(const SafetyConfig& cfg) {
     config_ = cfg;
@@ -20,12 +23,29 @@ void AudioSafetyEngine::setConfig(const SafetyConfig& cfg) {
 void AudioSafetyEngine::processMono(float* buffer, size_t numSamples) {
     if (!config_.enabled || !buffer || numSamples == 0) return;
     analyzeAndClean(buffer, numSamples);
+    if (config_.loudnessEnabled) {
+        loudness_.processMono(buffer, numSamples);
+        fillLoudness();
+    }
 }
 
 void AudioSafetyEngine::processStereo(float* left, float* right, size_t numSamples) {
     if (!config_.enabled || !left || !right || numSamples == 0) return;
     analyzeAndClean(left, numSamples);
     analyzeAndClean(right, numSamples);
+    if (config_.loudnessEnabled) {
+        loudness_.processStereo(left, right, numSamples);
+        fillLoudness();
+    }
+}
+
+void AudioSafetyEngine::fillLoudness() {
+    LoudnessReport lr = loudness_.getReport();
+    report_.momentaryLufs = lr.momentaryLufs;
+    report_.shortTermLufs = lr.shortTermLufs;
+    report_.integratedLufs = lr.integratedLufs;
+    report_.loudnessRange = lr.loudnessRange;
+    report_.truePeakDbtp = lr.truePeakDbtp;
 }
 
 void AudioSafetyEngine::analyzeAndClean(float* x, size_t n) {
@@ -2,6 +2,7 @@
 
 #ifdef __cplusplus
 
+#include "LoudnessMeter.h"
 #include <vector>
 #include <cstdint>
 #include <cmath>
@@ -22,6 +23,8 @@ struct SafetyConfig {
     // Feedback detection
     bool feedbackDetectEnabled = true;
     double feedbackCorrThreshold = 0.95; // normalized autocorrelation
+    // Loudness (EBU R128)
+    bool loudnessEnabled = true;
 };
 
 struct SafetyReport {
@@ -32,6 +35,12 @@ struct SafetyReport {
     bool overloadActive = false;
     double feedbackScore = 0.0; // 0..1
     bool hasNaN = false;
+    // Loudness (mesuré après nettoyage/limiteur)
+    double momentaryLufs = LoudnessMeter::kSilenceLufs;
+    double shortTermLufs = LoudnessMeter::kSilenceLufs;
+    double integratedLufs = LoudnessMeter::kSilenceLufs;
+    double loudnessRange = 0.0;
+    double truePeakDbtp = LoudnessMeter::kSilenceLufs;
 };
 
 class AudioSafetyEngine {
@@ -44,15 +53,23 @@ public:
     const SafetyConfig& getConfig() const { return config_; }
     SafetyReport getLastReport() const { return report_; }
 
+    // Nouvelle mesure intégrée (début d'enregistrement / d'export)
+    void resetLoudness() { loudness_.reset(); }
+    LoudnessReport getLoudnessReport() const { return loudness_.getReport(); }
+
     void processMono(float* buffer, size_t numSamples);
     void processStereo(float* left, float* right, size_t numSamples);
 
+    // Limiteur sans anticipation, mesures en parallèle du signal : aucun retard
+    size_t getLatencySamples() const { return 0; }
+
 private:
     uint32_t sampleRate_;
     int channels_;
     SafetyConfig config_{};
     SafetyReport report_{};
     double limiterThresholdLin_ = 0.89; // from dB
+    LoudnessMeter loudness_;
 
     // Helpers
     inline double dbToLin(double dB) const { return std::pow(10.0, dB / 20.0); }
@@ -60,6 +77,7 @@ private:
     void dcRemove(float* x, size_t n, double mean);
     void limitBuffer(float* x, size_t n);
     double estimateFeedbackScore(const float* x, size_t n);
+    void fillLoudness();
 };
 
 } // namespace AudioSafety
@@ -0,0 +1,151 @@
+#include "CpuGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AudioSafety {
+
+CpuGovernor::CpuGovernor(uint32_t sampleRate)
+    : sampleRate_(sampleRate > 0 ? sampleRate : 48000) {}
+
+void CpuGovernor::setConfig(const GovernorConfig& cfg) {
+    config_ = cfg;
+    config_.stepUpLoad = std::min(config_.stepUpLoad, config_.stepDownLoad);
+    if (!config_.enabled && tier_ != QualityTier::Full) changeTier(QualityTier::Full);
+}
+
+void CpuGovernor::setSampleRate(uint32_t sampleRate) {
+    sampleRate_ = sampleRate > 0 ? sampleRate : 48000;
+}
+
+void CpuGovernor::reset() {
+    tier_ = previousTier_ = QualityTier::Full;
+    tierChanges_ = 0;
+    deadlineMisses_ = 0;
+    smoothedLoad_ = 0.0;
+    belowSinceMs_ = 0.0;
+    sinceChangeMs_ = 1e9;
+    fadePos_ = fadeLen_ = 0;
+}
+
+void CpuGovernor::beginBuffer() noexcept {
+    start_ = Clock::now();
+}
+
+QualityTier CpuGovernor::endBuffer(size_t frames) noexcept {
+    const int64_t injected = injectedDelayNs_.load(std::memory_order_relaxed);
+    if (injected > 0) {
+        // Attente active : simule un coeur bridé, comptée dans la charge
+        const auto until = start_ + std::chrono::nanoseconds(injected);
+        while (Clock::now() < until) {}
+    }
+    if (frames == 0) return tier_;
+
+    const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start_).count();
+    const double bufferMs = 1000.0 * static_cast<double>(frames) / static_cast<double>(sampleRate_);
+    const double load = elapsedMs / bufferMs;
+
+    // Avance du fondu (la rampe du buffer suivant démarre après celui-ci)
+    if (fadePos_ < fadeLen_) fadePos_ = std::min(fadeLen_, fadePos_ + frames);
+    sinceChangeMs_ += bufferMs;
+
+    const double alpha = 1.0 - std::exp(-bufferMs / std::max(1.0, config_.smoothingMs));
+    smoothedLoad_ += alpha * (load - smoothedLoad_);
+
+    if (!config_.enabled) return tier_;
+
+    const bool missed = load >= 1.0;
+    if (missed) ++deadlineMisses_;
+
+    if ((missed || smoothedLoad_ > config_.stepDownLoad) && tier_ != QualityTier::Minimal &&
+        sinceChangeMs_ >= config_.cooldownMs) {
+        changeTier(static_cast<QualityTier>(static_cast<int>(tier_) + 1));
+        // Le nouveau palier est jugé sur ses propres mesures
+        smoothedLoad_ = std::min(smoothedLoad_, config_.stepDownLoad);
+        return tier_;
+    }
+
+    if (smoothedLoad_ < config_.stepUpLoad && !missed) {
+        belowSinceMs_ += bufferMs;
+        if (belowSinceMs_ >= config_.holdUpMs && tier_ != QualityTier::Full) {
+            changeTier(static_cast<QualityTier>(static_cast<int>(tier_) - 1));
+        }
+    } else {
+        belowSinceMs_ = 0.0;
+    }
+    return tier_;
+}
+
+void CpuGovernor::changeTier(QualityTier next) {
+    previousTier_ = tier_;
+    tier_ = next;
+    ++tierChanges_;
+    belowSinceMs_ = 0.0;
+    sinceChangeMs_ = 0.0;
+    fadePos_ = 0;
+    fadeLen_ = static_cast<size_t>(std::max(0.0, config_.crossfadeMs) * 0.001 * sampleRate_);
+}
+
+void CpuGovernor::crossfadeMono(const float* previous, float* current, size_t n) const noexcept {
+    if (fadePos_ >= fadeLen_ || fadeLen_ == 0) return;
+    const float inv = 1.0f / static_cast<float>(fadeLen_);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t pos = fadePos_ + i;
+        const float g = pos >= fadeLen_ ? 1.0f : static_cast<float>(pos) * inv;
+        current[i] = previous[i] + g * (current[i] - previous[i]);
+    }
+}
+
+void CpuGovernor::crossfadeStereo(const float* prevL, const float* prevR,
+                                  float* curL, float* curR, size_t n) const noexcept {
+    crossfadeMono(prevL, curL, n);
+    crossfadeMono(prevR, curR, n);
+}
+
+NoiseEngine CpuGovernor::noiseEngineFor(QualityTier tier, NoiseEngine requested) {
+    if (requested != NoiseEngine::RNNoise && requested != NoiseEngine::Spectral) return requested;
+    switch (tier) {
+        case QualityTier::Full: return requested;
+        case QualityTier::Reduced: return NoiseEngine::Spectral;
+        case QualityTier::Minimal: return NoiseEngine::Expander;
+    }
+    return requested;
+}
+
+size_t CpuGovernor::eqBandLimitFor(QualityTier tier, size_t numBands) {
+    // Les bandes écartées sont les moins marquées (|gain|), fondues par l'égaliseur
+    constexpr size_t kMinimalBands = 3;
+    const size_t half = std::max<size_t>(1, numBands / 2);
+    switch (tier) {
+        case QualityTier::Full: return 0;
+        case QualityTier::Reduced: return half;
+        case QualityTier::Minimal: return std::min(kMinimalBands, half);
+    }
+    return 0;
+}
+
+size_t NoiseEngineLatency::of(NoiseEngine engine) const {
+    switch (engine) {
+        case NoiseEngine::Expander: return expander;
+        case NoiseEngine::Spectral: return spectral;
+        case NoiseEngine::RNNoise: return rnnoise;
+        case NoiseEngine::Off: break;
+    }
+    return 0;
+}
+
+NoiseEngine CpuGovernor::noiseEngineWithinBudget(NoiseEngine requested, size_t budgetSamples,
+                                                 const NoiseEngineLatency& latency) {
+    if (requested == NoiseEngine::RNNoise && latency.rnnoise > budgetSamples) requested = NoiseEngine::Spectral;
+    if (requested == NoiseEngine::Spectral && latency.spectral > budgetSamples) requested = NoiseEngine::Expander;
+    return requested;
+}
+
+size_t CpuGovernor::noiseChainLatency(NoiseEngine requested, const NoiseEngineLatency& latency) {
+    size_t chain = 0;
+    for (QualityTier tier : {QualityTier::Full, QualityTier::Reduced, QualityTier::Minimal}) {
+        chain = std::max(chain, latency.of(noiseEngineFor(tier, requested)));
+    }
+    return chain;
+}
+
+} // namespace AudioSafety
@@ -0,0 +1,120 @@
+#pragma once
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace AudioSafety {
+
+// Paliers de qualité, du plus coûteux au plus sobre
+enum class QualityTier : int {
+    Full = 0,      // RNNoise, EQ complet
+    Reduced = 1,   // RNNoise -> NR spectrale, EQ réduit à la moitié des bandes
+    Minimal = 2    // expander seul, EQ limité aux 3 bandes les plus marquées
+};
+
+// Moteur de réduction de bruit effectivement utilisé pour un palier
+enum class NoiseEngine : int {
+    Off = 0,
+    Expander,
+    Spectral,
+    RNNoise
+};
+
+// Retard (échantillons) de chaque moteur de réduction de bruit, relevé par la plateforme
+struct NoiseEngineLatency {
+    size_t expander = 0;
+    size_t spectral = 0;
+    size_t rnnoise = 0;
+
+    size_t of(NoiseEngine engine) const;
+};
+
+struct GovernorConfig {
+    bool enabled = true;
+    double stepDownLoad = 0.80;   // charge lissée (temps / échéance) qui déclenche une descente
+    double stepUpLoad = 0.45;     // charge lissée sous laquelle une remontée est envisagée
+    double smoothingMs = 150.0;   // constante de temps du lissage de charge
+    double holdUpMs = 3000.0;     // durée sous stepUpLoad avant de remonter d'un palier
+    double cooldownMs = 500.0;    // délai minimal entre deux descentes
+    double crossfadeMs = 20.0;    // fondu entre l'ancien et le nouveau palier
+};
+
+// Gouverneur de budget CPU du thread audio.
+//
+// beginBuffer()/endBuffer() encadrent la chaîne DSP; la charge (temps de traitement /
+// durée du buffer) est lissée et comparée à des seuils avec hystérésis : descente
+// rapide (un dépassement d'échéance suffit), remontée lente (holdUpMs sous le seuil bas).
+// Après chaque changement de palier, crossfade*() fond la sortie de l'ancien chemin
+// dans celle du nouveau sur crossfadeMs.
+//
+// Pour les tests (Linux, sans appareil) : setInjectedDelayUs() ajoute une attente active
+// mesurée dans la charge, comme un processeur bridé.
+class CpuGovernor {
+public:
+    explicit CpuGovernor(uint32_t sampleRate);
+
+    void setConfig(const GovernorConfig& cfg);
+    const GovernorConfig& getConfig() const { return config_; }
+    void setSampleRate(uint32_t sampleRate);
+    void reset();
+
+    void beginBuffer() noexcept;
+    QualityTier endBuffer(size_t frames) noexcept;
+
+    QualityTier tier() const { return tier_; }
+    QualityTier previousTier() const { return previousTier_; }
+    uint32_t tierChanges() const { return tierChanges_; }
+    double smoothedLoad() const { return smoothedLoad_; }
+    uint32_t deadlineMisses() const { return deadlineMisses_; }
+
+    // Fondu en cours : les étages qui changent de chemin doivent produire les deux sorties
+    bool crossfading() const { return fadePos_ < fadeLen_; }
+    // current <- mélange previous -> current sur la rampe du buffer courant
+    void crossfadeMono(const float* previous, float* current, size_t n) const noexcept;
+    void crossfadeStereo(const float* prevL, const float* prevR,
+                         float* curL, float* curR, size_t n) const noexcept;
+
+    // Décisions par palier
+    static NoiseEngine noiseEngineFor(QualityTier tier, NoiseEngine requested);
+    // Limite de bandes EQ (AudioEqualizer::setBandLimit) pour un égaliseur de numBands; 0 = aucune
+    static size_t eqBandLimitFor(QualityTier tier, size_t numBands);
+
+    // Mode faible latence : moteur demandé, dégradé (RNNoise -> spectrale -> expander)
+    // jusqu'à tenir dans budgetSamples
+    static NoiseEngine noiseEngineWithinBudget(NoiseEngine requested, size_t budgetSamples,
+                                               const NoiseEngineLatency& latency);
+    // Retard commun à tous les paliers atteignables depuis requested : chaque moteur est
+    // complété jusqu'à cette valeur, la ligne de temps ne bouge pas quand le palier change
+    static size_t noiseChainLatency(NoiseEngine requested, const NoiseEngineLatency& latency);
+
+    void setInjectedDelayUs(double us) { injectedDelayNs_.store(static_cast<int64_t>(us * 1000.0)); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    GovernorConfig config_{};
+    uint32_t sampleRate_;
+    Clock::time_point start_{};
+
+    QualityTier tier_ = QualityTier::Full;
+    QualityTier previousTier_ = QualityTier::Full;
+    uint32_t tierChanges_ = 0;
+    uint32_t deadlineMisses_ = 0;
+    double smoothedLoad_ = 0.0;
+    double belowSinceMs_ = 0.0;       // temps cumulé sous stepUpLoad
+    double sinceChangeMs_ = 1e9;      // temps depuis le dernier changement
+    size_t fadePos_ = 0;
+    size_t fadeLen_ = 0;
+
+    std::atomic<int64_t> injectedDelayNs_{0};
+
+    void changeTier(QualityTier next);
+};
+
+} // namespace AudioSafety
+
+#endif // __cplusplus
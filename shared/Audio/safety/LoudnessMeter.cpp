@@ -0,0 +1,293 @@
+#include "LoudnessMeter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AudioSafety {
+
+namespace {
+// ITU-R BS.1770-4 Annexe 2 : FIR polyphase 4 phases x 12 taps pour le true-peak
+constexpr float kTruePeakCoeffs[4][12] = {
+    { 0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+     -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+      0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+    {-0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+     -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+      0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+    {-0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+     -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+      0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+    {-0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+     -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+      0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f },
+};
+
+constexpr double kAbsoluteGateLufs = -70.0;
+// Porte absolue en énergie : energyToLufs plafonne à kSilenceLufs, les blocs plus calmes
+// tomberaient sinon dans la case -70
+const double kAbsoluteGateEnergy = std::pow(10.0, (kAbsoluteGateLufs + 0.691) / 10.0);
+constexpr double kIntegratedRelativeGateLu = -10.0;
+constexpr double kRangeRelativeGateLu = -20.0;
+} // namespace
+
+// ===== GatingHistogram =====
+
+void LoudnessMeter::GatingHistogram::clear() {
+    count.fill(0);
+    energy.fill(0.0);
+    total = 0;
+    totalEnergy = 0.0;
+}
+
+void LoudnessMeter::GatingHistogram::add(double blockEnergy) {
+    if (blockEnergy < kAbsoluteGateEnergy) return;
+    size_t bin = lufsToBin(energyToLufs(blockEnergy));
+    ++count[bin];
+    energy[bin] += blockEnergy;
+    ++total;
+    totalEnergy += blockEnergy;
+}
+
+size_t LoudnessMeter::GatingHistogram::relativeGateBin(double gateLu) const {
+    double absGated = energyToLufs(totalEnergy / static_cast<double>(total));
+    return lufsToBin(std::max(kAbsoluteGateLufs, absGated + gateLu));
+}
+
+// ===== LoudnessMeter =====
+
+LoudnessMeter::LoudnessMeter(uint32_t sampleRate)
+    : sampleRate_(sampleRate) {
+    setSampleRate(sampleRate);
+}
+
+void LoudnessMeter::setSampleRate(uint32_t sampleRate) {
+    sampleRate_ = sampleRate > 0 ? sampleRate : 48000;
+    blockSize_ = std::max<size_t>(1, sampleRate_ / 10);
+    configureFilters();
+    reset();
+}
+
+void LoudnessMeter::configureFilters() {
+    // K-weighting BS.1770 : paramètres analogiques (f0, G, Q) re-dérivés par transformée
+    // bilinéaire pour la fréquence courante ; à 48 kHz on retrouve les coefficients de la norme.
+    const double sr = static_cast<double>(sampleRate_);
+
+    // Pré-filtre shelf +4 dB (effet acoustique de la tête)
+    {
+        const double f0 = 1681.974450955533;
+        const double G = 3.999843853973347;
+        const double Q = 0.7071752369554196;
+        const double K = std::tan(AudioEqualizer::PI * f0 / sr);
+        const double Vh = std::pow(10.0, G / 20.0);
+        const double Vb = std::pow(Vh, 0.4996667741545416);
+        preFilter_.setCoefficients(Vh + Vb * K / Q + K * K,
+                                   2.0 * (K * K - Vh),
+                                   Vh - Vb * K / Q + K * K,
+                                   1.0 + K / Q + K * K,
+                                   2.0 * (K * K - 1.0),
+                                   1.0 - K / Q + K * K);
+    }
+    // Passe-haut RLB
+    {
+        const double f0 = 38.13547087602444;
+        const double Q = 0.5003270373238773;
+        const double K = std::tan(AudioEqualizer::PI * f0 / sr);
+        const double norm = 1.0 + K / Q + K * K;
+        rlbFilter_.setCoefficients(norm, -2.0 * norm, norm,
+                                   norm,
+                                   2.0 * (K * K - 1.0),
+                                   1.0 - K / Q + K * K);
+    }
+}
+
+void LoudnessMeter::reset() {
+    preFilter_.reset();
+    rlbFilter_.reset();
+    blockAccum_ = 0.0;
+    blockFill_ = 0;
+    ring_.fill(0.0);
+    ringPos_ = 0;
+    blocksSeen_ = 0;
+    momentaryEnergy_ = 0.0;
+    shortTermEnergy_ = 0.0;
+    momentaryHist_.clear();
+    shortTermHist_.clear();
+    for (auto& h : tpHistory_) h.fill(0.0f);
+    tpPos_ = 0;
+    truePeak_ = 0.0;
+}
+
+void LoudnessMeter::processMono(const float* x, size_t numSamples) {
+    if (!x || numSamples == 0) return;
+    trackTruePeak(x, nullptr, numSamples);
+    for (size_t offset = 0; offset < numSamples; offset += kChunk) {
+        size_t n = std::min(kChunk, numSamples - offset);
+        preFilter_.process(x + offset, scratchL_.data(), n);
+        rlbFilter_.process(scratchL_.data(), scratchL_.data(), n);
+        accumulate(scratchL_.data(), nullptr, n);
+    }
+}
+
+void LoudnessMeter::processStereo(const float* left, const float* right, size_t numSamples) {
+    if (!left || !right || numSamples == 0) return;
+    trackTruePeak(left, right, numSamples);
+    for (size_t offset = 0; offset < numSamples; offset += kChunk) {
+        size_t n = std::min(kChunk, numSamples - offset);
+        preFilter_.processStereo(left + offset, right + offset, scratchL_.data(), scratchR_.data(), n);
+        rlbFilter_.processStereo(scratchL_.data(), scratchR_.data(), scratchL_.data(), scratchR_.data(), n);
+        accumulate(scratchL_.data(), scratchR_.data(), n);
+    }
+}
+
+void LoudnessMeter::accumulate(const float* kl, const float* kr, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        size_t take = std::min(n - i, blockSize_ - blockFill_);
+        double sum = 0.0;
+        for (size_t k = 0; k < take; ++k) {
+            double v = kl[i + k];
+            sum += v * v;
+        }
+        if (kr) {
+            for (size_t k = 0; k < take; ++k) {
+                double v = kr[i + k];
+                sum += v * v;
+            }
+        }
+        blockAccum_ += sum;
+        blockFill_ += take;
+        i += take;
+        if (blockFill_ == blockSize_) closeBlock();
+    }
+}
+
+void LoudnessMeter::closeBlock() {
+    ring_[ringPos_] = blockAccum_ / static_cast<double>(blockSize_);
+    ringPos_ = (ringPos_ + 1) % kRingBlocks;
+    ++blocksSeen_;
+    blockAccum_ = 0.0;
+    blockFill_ = 0;
+
+    // Fenêtres glissantes 400 ms / 3 s (pas de 100 ms, recouvrement 75 % pour le gating)
+    auto windowEnergy = [this](size_t blocks) {
+        size_t available = std::min(blocks, blocksSeen_);
+        double sum = 0.0;
+        for (size_t b = 1; b <= available; ++b) {
+            sum += ring_[(ringPos_ + kRingBlocks - b) % kRingBlocks];
+        }
+        return sum / static_cast<double>(available);
+    };
+    momentaryEnergy_ = windowEnergy(4);
+    shortTermEnergy_ = windowEnergy(kRingBlocks);
+
+    if (blocksSeen_ >= 4) momentaryHist_.add(momentaryEnergy_);
+    if (blocksSeen_ >= kRingBlocks) shortTermHist_.add(shortTermEnergy_);
+}
+
+void LoudnessMeter::trackTruePeak(const float* left, const float* right, size_t n) {
+    const int chans = right ? 2 : 1;
+    size_t pos = tpPos_;
+    float peak = static_cast<float>(truePeak_);
+    for (int c = 0; c < chans; ++c) {
+        const float* x = (c == 0) ? left : right;
+        auto& h = tpHistory_[static_cast<size_t>(c)];
+        pos = tpPos_;
+        for (size_t i = 0; i < n; ++i) {
+            // Historique dupliqué : h[pos+1 .. pos+12] = 12 derniers échantillons, sans modulo
+            h[pos] = x[i];
+            h[pos + kTruePeakTaps] = x[i];
+            const float* newest = &h[pos + kTruePeakTaps];
+            for (int phase = 0; phase < 4; ++phase) {
+                float acc = 0.0f;
+                for (size_t k = 0; k < kTruePeakTaps; ++k) {
+                    acc += kTruePeakCoeffs[phase][k] * *(newest - k);
+                }
+                peak = std::max(peak, std::abs(acc));
+            }
+            pos = (pos + 1) % kTruePeakTaps;
+        }
+    }
+    tpPos_ = pos;
+    truePeak_ = peak;
+}
+
+double LoudnessMeter::momentaryLufs() const {
+    return blocksSeen_ == 0 ? kSilenceLufs : energyToLufs(momentaryEnergy_);
+}
+
+double LoudnessMeter::shortTermLufs() const {
+    return blocksSeen_ == 0 ? kSilenceLufs : energyToLufs(shortTermEnergy_);
+}
+
+double LoudnessMeter::integratedLufs() const {
+    const GatingHistogram& h = momentaryHist_;
+    if (h.total == 0) return kSilenceLufs;
+    size_t gate = h.relativeGateBin(kIntegratedRelativeGateLu);
+    uint64_t count = 0;
+    double energy = 0.0;
+    for (size_t b = gate; b < kHistBins; ++b) {
+        count += h.count[b];
+        energy += h.energy[b];
+    }
+    return count == 0 ? kSilenceLufs : energyToLufs(energy / static_cast<double>(count));
+}
+
+double LoudnessMeter::loudnessRange() const {
+    const GatingHistogram& h = shortTermHist_;
+    if (h.total == 0) return 0.0;
+    size_t gate = h.relativeGateBin(kRangeRelativeGateLu);
+    uint64_t gated = 0;
+    for (size_t b = gate; b < kHistBins; ++b) gated += h.count[b];
+    if (gated == 0) return 0.0;
+
+    // Percentiles 10 % / 95 % de la distribution des short-term retenus
+    auto percentileBin = [&](double p) {
+        uint64_t target = static_cast<uint64_t>(std::ceil(p * static_cast<double>(gated)));
+        target = std::max<uint64_t>(1, target);
+        uint64_t cumulative = 0;
+        for (size_t b = gate; b < kHistBins; ++b) {
+            cumulative += h.count[b];
+            if (cumulative >= target) return b;
+        }
+        return kHistBins - 1;
+    };
+    size_t low = percentileBin(0.10);
+    size_t high = percentileBin(0.95);
+    return static_cast<double>(high - low) * 0.1;
+}
+
+double LoudnessMeter::truePeakDbtp() const {
+    return truePeak_ > 0.0 ? std::max(kSilenceLufs, 20.0 * std::log10(truePeak_)) : kSilenceLufs;
+}
+
+LoudnessReport LoudnessMeter::getReport() const {
+    LoudnessReport r;
+    r.momentaryLufs = momentaryLufs();
+    r.shortTermLufs = shortTermLufs();
+    r.integratedLufs = integratedLufs();
+    r.loudnessRange = loudnessRange();
+    r.truePeakDbtp = truePeakDbtp();
+    return r;
+}
+
+double LoudnessMeter::normalizationGainDb(const LoudnessReport& report,
+                                          double targetLufs,
+                                          double ceilingDbtp) {
+    if (report.integratedLufs <= kSilenceLufs) return 0.0;
+    double gain = targetLufs - report.integratedLufs;
+    if (report.truePeakDbtp > kSilenceLufs && report.truePeakDbtp + gain > ceilingDbtp) {
+        gain = ceilingDbtp - report.truePeakDbtp;
+    }
+    return gain;
+}
+
+double LoudnessMeter::energyToLufs(double energy) {
+    if (energy <= 0.0) return kSilenceLufs;
+    return std::max(kSilenceLufs, -0.691 + 10.0 * std::log10(energy));
+}
+
+size_t LoudnessMeter::lufsToBin(double lufs) {
+    int deci = static_cast<int>(std::floor(lufs * 10.0)) - kHistMinDeciDb;
+    return static_cast<size_t>(std::max(0, std::min(static_cast<int>(kHistBins) - 1, deci)));
+}
+
+} // namespace AudioSafety
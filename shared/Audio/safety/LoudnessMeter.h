@@ -0,0 +1,105 @@
+#pragma once
+
+#ifdef __cplusplus
+
+#include "../core/BiquadFilter.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace AudioSafety {
+
+// Mesure de sonie EBU R128 / ITU-R BS.1770-4
+struct LoudnessReport {
+    double momentaryLufs = -70.0;   // fenêtre 400 ms
+    double shortTermLufs = -70.0;   // fenêtre 3 s
+    double integratedLufs = -70.0;  // depuis reset(), gating absolu -70 + relatif -10
+    double loudnessRange = 0.0;     // LRA (LU), EBU Tech 3342
+    double truePeakDbtp = -70.0;    // suréchantillonnage x4
+};
+
+// Mesure incrémentale : les énergies K-pondérées sont agrégées par blocs de 100 ms
+// (anneau de 30 blocs = 3 s). Le gating intégré et la LRA utilisent des histogrammes
+// (0.1 dB par case) plutôt qu'un re-parcours de l'historique : coût O(1) par bloc,
+// quelle que soit la durée de l'enregistrement. Aucune allocation après construction.
+class LoudnessMeter {
+public:
+    explicit LoudnessMeter(uint32_t sampleRate);
+
+    void setSampleRate(uint32_t sampleRate);
+    void reset();
+
+    void processMono(const float* x, size_t numSamples);
+    void processStereo(const float* left, const float* right, size_t numSamples);
+
+    double momentaryLufs() const;
+    double shortTermLufs() const;
+    double integratedLufs() const;
+    double loudnessRange() const;
+    double truePeakDbtp() const;
+    LoudnessReport getReport() const;
+
+    // Gain (dB) à appliquer à l'export pour atteindre targetLufs sans dépasser ceilingDbtp.
+    // Retourne 0 si la mesure intégrée est vide (silence / moins de 400 ms).
+    static double normalizationGainDb(const LoudnessReport& report,
+                                      double targetLufs,
+                                      double ceilingDbtp);
+
+    static constexpr double kSilenceLufs = -70.0;
+
+private:
+    static constexpr size_t kRingBlocks = 30;       // 3 s de blocs de 100 ms
+    static constexpr size_t kChunk = 256;           // scratch K-weighting
+    static constexpr int kHistMinDeciDb = -700;    // -70.0 LUFS (gate absolu)
+    static constexpr int kHistMaxDeciDb = 50;      // +5.0 LUFS
+    static constexpr size_t kHistBins = static_cast<size_t>(kHistMaxDeciDb - kHistMinDeciDb);
+    static constexpr size_t kTruePeakTaps = 12;
+
+    struct GatingHistogram {
+        std::array<uint32_t, kHistBins> count{};
+        std::array<double, kHistBins> energy{};
+        uint64_t total = 0;
+        double totalEnergy = 0.0;
+
+        void clear();
+        void add(double blockEnergy);
+        // Moyenne énergétique des blocs au-dessus de la porte relative (gateLu sous la moyenne absolue)
+        size_t relativeGateBin(double gateLu) const;
+    };
+
+    uint32_t sampleRate_;
+    size_t blockSize_ = 4800;
+
+    AudioEqualizer::BiquadFilter preFilter_;   // high-shelf +4 dB (effet de tête)
+    AudioEqualizer::BiquadFilter rlbFilter_;   // passe-haut RLB ~38 Hz
+
+    std::array<float, kChunk> scratchL_{};
+    std::array<float, kChunk> scratchR_{};
+
+    double blockAccum_ = 0.0;
+    size_t blockFill_ = 0;
+    std::array<double, kRingBlocks> ring_{};
+    size_t ringPos_ = 0;
+    size_t blocksSeen_ = 0;
+
+    double momentaryEnergy_ = 0.0;
+    double shortTermEnergy_ = 0.0;
+    GatingHistogram momentaryHist_;
+    GatingHistogram shortTermHist_;
+
+    std::array<std::array<float, 2 * kTruePeakTaps>, 2> tpHistory_{};   // historique dupliqué (voir trackTruePeak)
+    size_t tpPos_ = 0;
+    double truePeak_ = 0.0;
+
+    void configureFilters();
+    void accumulate(const float* kl, const float* kr, size_t n);
+    void closeBlock();
+    void trackTruePeak(const float* left, const float* right, size_t n);
+
+    static double energyToLufs(double energy);
+    static size_t lufsToBin(double lufs);
+};
+
+} // namespace AudioSafety
+
+#endif // __cplusplus
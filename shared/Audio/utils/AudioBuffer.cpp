@@ -2,17 +2,198 @@
 #include <cmath>
 #include <algorithm>
 #include <cstdlib>
+#include <utility>
 
 #ifdef __ARM_NEON
 #include <arm_neon.h>
 #endif
 
-#ifdef __SSE2__
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
 #include <emmintrin.h>
 #endif
 
 namespace AudioEqualizer {
 
+// ===== Noyaux =====
+
+namespace AudioKernels {
+
+void mix(float* dest, const float* source, size_t numSamples, float gain) noexcept {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 g = _mm256_set1_ps(gain);
+    for (; i + 8 <= numSamples; i += 8) {
+#ifdef __FMA__
+        _mm256_storeu_ps(dest + i, _mm256_fmadd_ps(_mm256_loadu_ps(source + i), g, _mm256_loadu_ps(dest + i)));
+#else
+        _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(source + i), g)));
+#endif
+    }
+#elif defined(__SSE2__)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(source + i), g)));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= numSamples; i += 4) {
+#ifdef __aarch64__
+        vst1q_f32(dest + i, vfmaq_f32(vld1q_f32(dest + i), vld1q_f32(source + i), g));
+#else
+        vst1q_f32(dest + i, vmlaq_f32(vld1q_f32(dest + i), vld1q_f32(source + i), g));
+#endif
+    }
+#endif
+    for (; i < numSamples; ++i) dest[i] += source[i] * gain;
+}
+
+void gain(float* data, size_t numSamples, float gain) noexcept {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 g = _mm256_set1_ps(gain);
+    for (; i + 8 <= numSamples; i += 8) _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+#elif defined(__SSE2__)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= numSamples; i += 4) _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+#elif defined(__ARM_NEON)
+    const float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= numSamples; i += 4) vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), g));
+#endif
+    for (; i < numSamples; ++i) data[i] *= gain;
+}
+
+void gainRamp(float* data, size_t numSamples, float startGain, float endGain) noexcept {
+    if (numSamples == 0) return;
+    // Gain recalculé depuis l'index (pas d'accumulation) : identique quel que soit le chemin
+    const float inc = (endGain - startGain) / static_cast<float>(numSamples);
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 vStart = _mm256_set1_ps(startGain);
+    const __m256 vInc = _mm256_set1_ps(inc);
+    const __m256 vStep = _mm256_set1_ps(8.0f);
+    __m256 idx = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 g = _mm256_add_ps(vStart, _mm256_mul_ps(idx, vInc));
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+        idx = _mm256_add_ps(idx, vStep);
+    }
+#elif defined(__SSE2__)
+    const __m128 vStart = _mm_set1_ps(startGain);
+    const __m128 vInc = _mm_set1_ps(inc);
+    const __m128 vStep = _mm_set1_ps(4.0f);
+    __m128 idx = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 g = _mm_add_ps(vStart, _mm_mul_ps(idx, vInc));
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+        idx = _mm_add_ps(idx, vStep);
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t vStart = vdupq_n_f32(startGain);
+    const float32x4_t vStep = vdupq_n_f32(4.0f);
+    const float lanes[4] = {0.f, 1.f, 2.f, 3.f};
+    float32x4_t idx = vld1q_f32(lanes);
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4_t g = vaddq_f32(vStart, vmulq_n_f32(idx, inc));
+        vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), g));
+        idx = vaddq_f32(idx, vStep);
+    }
+#endif
+    for (; i < numSamples; ++i) data[i] *= startGain + static_cast<float>(i) * inc;
+}
+
+float peak(const float* data, size_t numSamples) noexcept {
+    float result = 0.0f;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 m = _mm256_setzero_ps();
+    for (; i + 8 <= numSamples; i += 8) m = _mm256_max_ps(m, _mm256_and_ps(_mm256_loadu_ps(data + i), absMask));
+    __m128 m4 = _mm_max_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+    m4 = _mm_max_ps(m4, _mm_movehl_ps(m4, m4));
+    m4 = _mm_max_ss(m4, _mm_shuffle_ps(m4, m4, 1));
+    result = _mm_cvtss_f32(m4);
+#elif defined(__SSE2__)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 m = _mm_setzero_ps();
+    for (; i + 4 <= numSamples; i += 4) m = _mm_max_ps(m, _mm_and_ps(_mm_loadu_ps(data + i), absMask));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    result = _mm_cvtss_f32(m);
+#elif defined(__ARM_NEON)
+    float32x4_t m = vdupq_n_f32(0.0f);
+    for (; i + 4 <= numSamples; i += 4) m = vmaxq_f32(m, vabsq_f32(vld1q_f32(data + i)));
+#ifdef __aarch64__
+    result = vmaxvq_f32(m);
+#else
+    float32x2_t m2 = vmax_f32(vget_low_f32(m), vget_high_f32(m));
+    result = std::max(vget_lane_f32(m2, 0), vget_lane_f32(m2, 1));
+#endif
+#endif
+    for (; i < numSamples; ++i) result = std::max(result, std::abs(data[i]));
+    return result;
+}
+
+float rms(const float* data, size_t numSamples) noexcept {
+    if (numSamples == 0) return 0.0f;
+    // Sommes partielles float vidées en double par tranches : précision des longs tampons
+    constexpr size_t kFlush = 1024;
+    double sum = 0.0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    while (i + 8 <= numSamples) {
+        const size_t end = std::min(numSamples & ~static_cast<size_t>(7), i + kFlush);
+        __m256 acc = _mm256_setzero_ps();
+        for (; i < end; i += 8) {
+            const __m256 v = _mm256_loadu_ps(data + i);
+#ifdef __FMA__
+            acc = _mm256_fmadd_ps(v, v, acc);
+#else
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+#endif
+        }
+        __m128 a4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        a4 = _mm_add_ps(a4, _mm_movehl_ps(a4, a4));
+        a4 = _mm_add_ss(a4, _mm_shuffle_ps(a4, a4, 1));
+        sum += _mm_cvtss_f32(a4);
+    }
+#elif defined(__SSE2__)
+    while (i + 4 <= numSamples) {
+        const size_t end = std::min(numSamples & ~static_cast<size_t>(3), i + kFlush);
+        __m128 acc = _mm_setzero_ps();
+        for (; i < end; i += 4) {
+            const __m128 v = _mm_loadu_ps(data + i);
+            acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+        }
+        acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+        sum += _mm_cvtss_f32(acc);
+    }
+#elif defined(__ARM_NEON)
+    while (i + 4 <= numSamples) {
+        const size_t end = std::min(numSamples & ~static_cast<size_t>(3), i + kFlush);
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (; i < end; i += 4) {
+            const float32x4_t v = vld1q_f32(data + i);
+            acc = vmlaq_f32(acc, v, v);
+        }
+#ifdef __aarch64__
+        sum += vaddvq_f32(acc);
+#else
+        float32x2_t a2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+        sum += vget_lane_f32(a2, 0) + vget_lane_f32(a2, 1);
+#endif
+    }
+#endif
+    for (; i < numSamples; ++i) sum += static_cast<double>(data[i]) * data[i];
+    return static_cast<float>(std::sqrt(sum / static_cast<double>(numSamples)));
+}
+
+} // namespace AudioKernels
+
+// ===== AudioBuffer =====
+
 AudioBuffer::AudioBuffer(size_t numChannels, size_t numSamples)
     : m_numChannels(numChannels)
     , m_numSamples(numSamples) {
@@ -24,22 +205,42 @@ AudioBuffer::AudioBuffer(size_t numChannels, size_t numSamples)
 AudioBuffer::~AudioBuffer() = default;
 
 void AudioBuffer::allocateData() {
-    size_t totalSamples = m_numChannels * getAlignedSize(m_numSamples);
-    m_data = std::make_unique<float[]>(totalSamples);
+    m_capacity = getAlignedSize(m_numSamples);
+    size_t totalSamples = std::max<size_t>(1, m_numChannels * m_capacity);
+    m_data.reset(static_cast<float*>(::operator new[](totalSamples * sizeof(float), std::align_val_t(kAlignment))));
 }
 
 void AudioBuffer::allocateChannels() {
     m_channels = std::make_unique<float*[]>(m_numChannels);
-    size_t alignedSamples = getAlignedSize(m_numSamples);
-    
+
     for (size_t ch = 0; ch < m_numChannels; ++ch) {
-        m_channels[ch] = m_data.get() + (ch * alignedSamples);
+        m_channels[ch] = m_data.get() + (ch * m_capacity);
     }
 }
 
 size_t AudioBuffer::getAlignedSize(size_t size) {
-    // Align to 16-byte boundary for SIMD
-    return (size + 3) & ~3;  // Align to 4 floats (16 bytes)
+    // Pas entre canaux multiple de 64 octets : chaque canal reste aligné
+    constexpr size_t floatsPerLine = kAlignment / sizeof(float);
+    return (size + floatsPerLine - 1) & ~(floatsPerLine - 1);
+}
+
+void AudioBuffer::setSize(size_t numSamples) {
+    if (numSamples > m_capacity) {
+        m_numSamples = numSamples;
+        allocateData();
+        allocateChannels();
+        clear();
+        return;
+    }
+    m_numSamples = numSamples;
+}
+
+void AudioBuffer::swap(AudioBuffer& other) noexcept {
+    std::swap(m_numChannels, other.m_numChannels);
+    std::swap(m_numSamples, other.m_numSamples);
+    std::swap(m_capacity, other.m_capacity);
+    m_data.swap(other.m_data);
+    m_channels.swap(other.m_channels);
 }
 
 float** AudioBuffer::getArrayOfWritePointers() {
@@ -51,8 +252,7 @@ const float* const* AudioBuffer::getArrayOfReadPointers() const {
 }
 
 void AudioBuffer::clear() {
-    size_t totalSamples = m_numChannels * getAlignedSize(m_numSamples);
-    std::memset(m_data.get(), 0, totalSamples * sizeof(float));
+    std::memset(m_data.get(), 0, m_numChannels * m_capacity * sizeof(float));
 }
 
 void AudioBuffer::clear(size_t channel) {
@@ -105,55 +305,7 @@ void AudioBuffer::copyFrom(size_t destChannel, size_t destStartSample,
 
 void AudioBuffer::addFrom(size_t destChannel, const float* source, size_t numSamples, float gain) {
     if (destChannel >= m_numChannels || source == nullptr) return;
-    
-    float* dest = m_channels[destChannel];
-    size_t samplesToProcess = std::min(numSamples, m_numSamples);
-    
-#ifdef __ARM_NEON
-    // NEON optimized version
-    size_t simdSamples = samplesToProcess & ~3;
-    float32x4_t gainVec = vdupq_n_f32(gain);
-    
-    for (size_t i = 0; i < simdSamples; i += 4) {
-        float32x4_t srcVec = vld1q_f32(&source[i]);
-        float32x4_t destVec = vld1q_f32(&dest[i]);
-        destVec = vmlaq_f32(destVec, srcVec, gainVec);
-        vst1q_f32(&dest[i], destVec);
-    }
-    
-    // Process remaining samples
-    for (size_t i = simdSamples; i < samplesToProcess; ++i) {
-        dest[i] += source[i] * gain;
-    }
-#elif defined(__SSE2__)
-    // SSE2 optimized version
-    size_t simdSamples = samplesToProcess & ~3;
-    __m128 gainVec = _mm_set1_ps(gain);
-    
-    for (size_t i = 0; i < simdSamples; i += 4) {
-        __m128 srcVec = _mm_loadu_ps(&source[i]);
-        __m128 destVec = _mm_loadu_ps(&dest[i]);
-        srcVec = _mm_mul_ps(srcVec, gainVec);
-        destVec = _mm_add_ps(destVec, srcVec);
-        _mm_storeu_ps(&dest[i], destVec);
-    }
-    
-    // Process remaining samples
-    for (size_t i = simdSamples; i < samplesToProcess; ++i) {
-        dest[i] += source[i] * gain;
-    }
-#else
-    // Scalar version
-    if (gain == 1.0f) {
-        for (size_t i = 0; i < samplesToProcess; ++i) {
-            dest[i] += source[i];
-        }
-    } else {
-        for (size_t i = 0; i < samplesToProcess; ++i) {
-            dest[i] += source[i] * gain;
-        }
-    }
-#endif
+    AudioKernels::mix(m_channels[destChannel], source, std::min(numSamples, m_numSamples), gain);
 }
 
 void AudioBuffer::addFrom(const AudioBuffer& source, float gain) {
@@ -177,139 +329,72 @@ void AudioBuffer::applyGain(size_t channel, float gain) {
 }
 
 void AudioBuffer::applyGain(size_t channel, size_t startSample, size_t numSamples, float gain) {
-    if (channel >= m_numChannels) return;
-    
-    float* data = m_channels[channel] + startSample;
-    size_t samplesToProcess = std::min(numSamples, m_numSamples - startSample);
-    
-#ifdef __ARM_NEON
-    // NEON optimized version
-    size_t simdSamples = samplesToProcess & ~3;
-    float32x4_t gainVec = vdupq_n_f32(gain);
-    
-    for (size_t i = 0; i < simdSamples; i += 4) {
-        float32x4_t vec = vld1q_f32(&data[i]);
-        vec = vmulq_f32(vec, gainVec);
-        vst1q_f32(&data[i], vec);
-    }
-    
-    // Process remaining samples
-    for (size_t i = simdSamples; i < samplesToProcess; ++i) {
-        data[i] *= gain;
-    }
-#elif defined(__SSE2__)
-    // SSE2 optimized version
-    size_t simdSamples = samplesToProcess & ~3;
-    __m128 gainVec = _mm_set1_ps(gain);
-    
-    for (size_t i = 0; i < simdSamples; i += 4) {
-        __m128 vec = _mm_loadu_ps(&data[i]);
-        vec = _mm_mul_ps(vec, gainVec);
-        _mm_storeu_ps(&data[i], vec);
-    }
-    
-    // Process remaining samples
-    for (size_t i = simdSamples; i < samplesToProcess; ++i) {
-        data[i] *= gain;
-    }
-#else
-    // Scalar version
-    for (size_t i = 0; i < samplesToProcess; ++i) {
-        data[i] *= gain;
-    }
-#endif
+    if (channel >= m_numChannels || startSample >= m_numSamples) return;
+    AudioKernels::gain(m_channels[channel] + startSample, std::min(numSamples, m_numSamples - startSample), gain);
 }
 
 void AudioBuffer::applyGainRamp(size_t channel, size_t startSample, size_t numSamples,
                                float startGain, float endGain) {
-    if (channel >= m_numChannels) return;
-    
-    float* data = m_channels[channel] + startSample;
-    size_t samplesToProcess = std::min(numSamples, m_numSamples - startSample);
-    
-    if (samplesToProcess == 0) return;
-    
-    float gainIncrement = (endGain - startGain) / static_cast<float>(samplesToProcess);
-    float currentGain = startGain;
-    
-    for (size_t i = 0; i < samplesToProcess; ++i) {
-        data[i] *= currentGain;
-        currentGain += gainIncrement;
-    }
+    if (channel >= m_numChannels || startSample >= m_numSamples) return;
+    AudioKernels::gainRamp(m_channels[channel] + startSample,
+                           std::min(numSamples, m_numSamples - startSample), startGain, endGain);
 }
 
 float AudioBuffer::getMagnitude(size_t channel, size_t startSample, size_t numSamples) const {
-    if (channel >= m_numChannels) return 0.0f;
-    
-    const float* data = m_channels[channel] + startSample;
-    size_t samplesToProcess = std::min(numSamples, m_numSamples - startSample);
-    
-    float maxMagnitude = 0.0f;
-    
-#ifdef __ARM_NEON
-    // NEON optimized version
-    size_t simdSamples = samplesToProcess & ~3;
-    float32x4_t maxVec = vdupq_n_f32(0.0f);
-    
-    for (size_t i = 0; i < simdSamples; i += 4) {
-        float32x4_t vec = vld1q_f32(&data[i]);
-        vec = vabsq_f32(vec);
-        maxVec = vmaxq_f32(maxVec, vec);
-    }
-    
-    // Extract maximum from vector
-    float32x2_t max2 = vmax_f32(vget_low_f32(maxVec), vget_high_f32(maxVec));
-    maxMagnitude = std::max(vget_lane_f32(max2, 0), vget_lane_f32(max2, 1));
-    
-    // Process remaining samples
-    for (size_t i = simdSamples; i < samplesToProcess; ++i) {
-        maxMagnitude = std::max(maxMagnitude, std::abs(data[i]));
-    }
-#else
-    // Scalar version
-    for (size_t i = 0; i < samplesToProcess; ++i) {
-        maxMagnitude = std::max(maxMagnitude, std::abs(data[i]));
-    }
-#endif
-    
-    return maxMagnitude;
+    if (channel >= m_numChannels || startSample >= m_numSamples) return 0.0f;
+    return AudioKernels::peak(m_channels[channel] + startSample, std::min(numSamples, m_numSamples - startSample));
 }
 
 float AudioBuffer::getRMSLevel(size_t channel, size_t startSample, size_t numSamples) const {
-    if (channel >= m_numChannels || numSamples == 0) return 0.0f;
-    
-    const float* data = m_channels[channel] + startSample;
-    size_t samplesToProcess = std::min(numSamples, m_numSamples - startSample);
-    
-    double sum = 0.0;
-    
-#ifdef __ARM_NEON
-    // NEON optimized version
-    size_t simdSamples = samplesToProcess & ~3;
-    float32x4_t sumVec = vdupq_n_f32(0.0f);
-    
-    for (size_t i = 0; i < simdSamples; i += 4) {
-        float32x4_t vec = vld1q_f32(&data[i]);
-        vec = vmulq_f32(vec, vec);  // Square the values
-        sumVec = vaddq_f32(sumVec, vec);
-    }
-    
-    // Sum the vector elements
-    float32x2_t sum2 = vadd_f32(vget_low_f32(sumVec), vget_high_f32(sumVec));
-    sum = vget_lane_f32(sum2, 0) + vget_lane_f32(sum2, 1);
-    
-    // Process remaining samples
-    for (size_t i = simdSamples; i < samplesToProcess; ++i) {
-        sum += data[i] * data[i];
+    if (channel >= m_numChannels || startSample >= m_numSamples || numSamples == 0) return 0.0f;
+    return AudioKernels::rms(m_channels[channel] + startSample, std::min(numSamples, m_numSamples - startSample));
+}
+
+// ===== AudioBufferPool =====
+
+AudioBufferPool::AudioBufferPool(size_t numBuffers, size_t numChannels, size_t maxSamples)
+    : m_maxSamples(maxSamples) {
+    numBuffers = std::min(numBuffers, kMaxBuffers);
+    m_buffers.reserve(numBuffers);
+    for (size_t i = 0; i < numBuffers; ++i) {
+        m_buffers.push_back(std::make_unique<AudioBuffer>(numChannels, maxSamples));
     }
-#else
-    // Scalar version
-    for (size_t i = 0; i < samplesToProcess; ++i) {
-        sum += data[i] * data[i];
+    m_free.store(numBuffers == kMaxBuffers ? ~uint64_t{0} : ((uint64_t{1} << numBuffers) - 1),
+                 std::memory_order_release);
+}
+
+AudioBufferPool::Lease AudioBufferPool::acquire(size_t numSamples) noexcept {
+    if (numSamples > m_maxSamples) return {};
+    uint64_t mask = m_free.load(std::memory_order_relaxed);
+    while (mask != 0) {
+        const uint64_t bit = mask & (~mask + 1);   // bit libre le plus bas
+        if (m_free.compare_exchange_weak(mask, mask & ~bit, std::memory_order_acquire, std::memory_order_relaxed)) {
+            size_t index = 0;
+            while ((uint64_t{1} << index) != bit) ++index;
+            m_buffers[index]->setSize(numSamples);   // dans la capacité : pas d'allocation
+            return Lease(this, index);
+        }
     }
-#endif
-    
-    return static_cast<float>(std::sqrt(sum / samplesToProcess));
+    return {};
+}
+
+void AudioBufferPool::Lease::release() noexcept {
+    if (!m_pool) return;
+    m_pool->m_free.fetch_or(uint64_t{1} << m_index, std::memory_order_release);
+    m_pool = nullptr;
+}
+
+void AudioBufferPool::reserve(size_t maxSamples) {
+    if (maxSamples <= m_maxSamples) return;
+    m_maxSamples = maxSamples;
+    for (auto& buffer : m_buffers) buffer->setSize(maxSamples);
+}
+
+size_t AudioBufferPool::getNumAvailable() const {
+    uint64_t mask = m_free.load(std::memory_order_relaxed);
+    size_t count = 0;
+    for (; mask != 0; mask &= mask - 1) ++count;
+    return count;
 }
 
-} // namespace AudioEqualizer
\ No newline at end of file
+} // namespace AudioEqualizer
@@ -2,68 +2,99 @@
 
 #ifdef __cplusplus
 #include "Constants.h"
+#include <atomic>
 #include <memory>
 #include <cstring>
 #include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
 
 namespace AudioEqualizer {
 
+// Noyaux vectoriels sur pointeurs bruts (AVX2/FMA, SSE2, NEON, repli scalaire).
+// Aucune contrainte d'alignement; les canaux d'AudioBuffer sont alignés sur 64 octets.
+namespace AudioKernels {
+    void mix(float* dest, const float* source, size_t numSamples, float gain = 1.0f) noexcept;
+    void gain(float* data, size_t numSamples, float gain) noexcept;
+    // Rampe linéaire : data[i] *= startGain + i * (endGain - startGain) / numSamples
+    void gainRamp(float* data, size_t numSamples, float startGain, float endGain) noexcept;
+    float peak(const float* data, size_t numSamples) noexcept;
+    float rms(const float* data, size_t numSamples) noexcept;
+}
+
 class AudioBuffer {
 public:
+    // Alignement des canaux : ligne de cache, couvre le plus large vecteur (AVX-512)
+    static constexpr size_t kAlignment = 64;
+
     AudioBuffer(size_t numChannels, size_t numSamples);
     ~AudioBuffer();
 
+    AudioBuffer(const AudioBuffer&) = delete;
+    AudioBuffer& operator=(const AudioBuffer&) = delete;
+
     // Get buffer data
     float* getChannel(size_t channel);
     const float* getChannel(size_t channel) const;
-    
+
     // Get write pointer
     float** getArrayOfWritePointers();
     const float* const* getArrayOfReadPointers() const;
-    
+
     // Buffer info
     size_t getNumChannels() const { return m_numChannels; }
     size_t getNumSamples() const { return m_numSamples; }
-    
+    size_t getCapacity() const { return m_capacity; }
+
+    // Taille active; réalloue seulement au-delà de la capacité (contenu alors perdu)
+    void setSize(size_t numSamples);
+    void swap(AudioBuffer& other) noexcept;
+
     // Clear buffer
     void clear();
     void clear(size_t channel);
     void clear(size_t startSample, size_t numSamples);
-    
+
     // Copy operations
     void copyFrom(const AudioBuffer& source);
     void copyFrom(size_t destChannel, const float* source, size_t numSamples);
     void copyFrom(size_t destChannel, size_t destStartSample,
                   const AudioBuffer& source, size_t sourceChannel,
                   size_t sourceStartSample, size_t numSamples);
-    
+
     // Add operations (for mixing)
     void addFrom(size_t destChannel, const float* source, size_t numSamples, float gain = 1.0f);
     void addFrom(const AudioBuffer& source, float gain = 1.0f);
-    
+
     // Apply gain
     void applyGain(float gain);
     void applyGain(size_t channel, float gain);
     void applyGain(size_t channel, size_t startSample, size_t numSamples, float gain);
-    
+
     // Apply gain ramp (for smooth parameter changes)
     void applyGainRamp(size_t channel, size_t startSample, size_t numSamples,
                        float startGain, float endGain);
-    
+
     // Get magnitude
     float getMagnitude(size_t channel, size_t startSample, size_t numSamples) const;
     float getRMSLevel(size_t channel, size_t startSample, size_t numSamples) const;
 
 private:
+    struct AlignedDelete {
+        void operator()(float* p) const noexcept { ::operator delete[](p, std::align_val_t(kAlignment)); }
+    };
+
     size_t m_numChannels;
     size_t m_numSamples;
-    std::unique_ptr<float[]> m_data;
+    size_t m_capacity = 0;   // échantillons par canal (pas entre canaux)
+    std::unique_ptr<float[], AlignedDelete> m_data;
     std::unique_ptr<float*[]> m_channels;
-    
+
     // Allocate aligned memory for SIMD operations
     void allocateData();
     void allocateChannels();
-    
+
     // Helper to ensure alignment
     static size_t getAlignedSize(size_t size);
 };
@@ -77,9 +108,59 @@ inline const float* AudioBuffer::getChannel(size_t channel) const {
     return (channel < m_numChannels) ? m_channels[channel] : nullptr;
 }
 
+// Tampons de travail préalloués, réutilisés d'un bloc à l'autre.
+//
+// acquire() prend un tampon libre (CAS sur un masque 64 bits) sans allocation ni verrou :
+// utilisable depuis le thread audio. Le bail rend le tampon à sa destruction.
+// reserve() réalloue : hors thread audio, ou sans bail en cours.
+class AudioBufferPool {
+public:
+    static constexpr size_t kMaxBuffers = 64;
+
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept : m_pool(other.m_pool), m_index(other.m_index) { other.m_pool = nullptr; }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) { release(); m_pool = other.m_pool; m_index = other.m_index; other.m_pool = nullptr; }
+            return *this;
+        }
+        ~Lease() { release(); }
+
+        explicit operator bool() const { return m_pool != nullptr; }
+        AudioBuffer* get() const { return m_pool ? m_pool->m_buffers[m_index].get() : nullptr; }
+        AudioBuffer* operator->() const { return get(); }
+        AudioBuffer& operator*() const { return *get(); }
+        float* getChannel(size_t channel) const { return get()->getChannel(channel); }
+
+        void release() noexcept;
+
+    private:
+        friend class AudioBufferPool;
+        Lease(AudioBufferPool* pool, size_t index) : m_pool(pool), m_index(index) {}
+        AudioBufferPool* m_pool = nullptr;
+        size_t m_index = 0;
+    };
+
+    AudioBufferPool(size_t numBuffers, size_t numChannels, size_t maxSamples);
+
+    // Bail vide si le pool est épuisé ou numSamples > getMaxSamples()
+    Lease acquire(size_t numSamples) noexcept;
+    void reserve(size_t maxSamples);
+
+    size_t getMaxSamples() const { return m_maxSamples; }
+    size_t getNumBuffers() const { return m_buffers.size(); }
+    size_t getNumAvailable() const;
+
+private:
+    std::vector<std::unique_ptr<AudioBuffer>> m_buffers;
+    size_t m_maxSamples;
+    std::atomic<uint64_t> m_free{0};   // bit i = tampon i libre
+};
+
 } // namespace AudioEqualizer
 
 #else
 /* Ce header contient uniquement des déclarations C++.
    Aucune API C n'est exposée lorsqu'il est inclus dans un TU C/Obj-C. */
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,157 @@
+#include "AudioProfiler.h"
+#include <chrono>
+
+namespace AudioEqualizer {
+
+namespace {
+AudioProfiler g_audioProfiler;
+
+inline unsigned highestBit(uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+    unsigned e = 0;
+    while (v >>= 1) ++e;
+    return e;
+#endif
+}
+} // namespace
+
+// ===== ProfileHistogram =====
+
+size_t ProfileHistogram::bucketIndex(uint64_t value) noexcept {
+    if (value < kSub) return static_cast<size_t>(value);
+    unsigned e = highestBit(value);
+    if (e > kMaxExponent) return kBuckets - 1;
+    const size_t mantissa = static_cast<size_t>(value >> (e - kSubBits)) & (kSub - 1);
+    return (e - kSubBits + 1) * kSub + mantissa;
+}
+
+uint64_t ProfileHistogram::bucketUpperBound(size_t index) noexcept {
+    if (index < kSub) return index;
+    const unsigned e = static_cast<unsigned>(index / kSub) + kSubBits - 1;
+    const uint64_t mantissa = index % kSub;
+    const uint64_t width = uint64_t(1) << (e - kSubBits);
+    return ((kSub + mantissa) << (e - kSubBits)) + width - 1;
+}
+
+// Écrivain unique (thread audio) : load + store relaxed, pas d'instruction verrouillée
+void ProfileHistogram::record(uint64_t value) noexcept {
+    auto& bucket = counts_[bucketIndex(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+}
+
+void ProfileHistogram::reset() noexcept {
+    for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+ProfileStats ProfileHistogram::stats(double scale) const noexcept {
+    ProfileStats s;
+    // Copie locale : le writer peut avancer pendant la lecture
+    std::array<uint32_t, kBuckets> snapshot;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        snapshot[i] = counts_[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) return s;
+
+    const uint64_t maxValue = max_.load(std::memory_order_relaxed);
+    const uint64_t ranks[3] = {(total * 50 + 99) / 100, (total * 95 + 99) / 100, (total * 99 + 99) / 100};
+    double* outs[3] = {&s.p50, &s.p95, &s.p99};
+    uint64_t seen = 0;
+    size_t r = 0;
+    for (size_t i = 0; i < kBuckets && r < 3; ++i) {
+        seen += snapshot[i];
+        while (r < 3 && seen >= ranks[r]) {
+            // Borne haute de la case, sans dépasser le max observé
+            uint64_t bound = bucketUpperBound(i);
+            if (bound > maxValue) bound = maxValue;
+            *outs[r++] = static_cast<double>(bound) * scale;
+        }
+    }
+    s.count = total;
+    const uint64_t n = count_.load(std::memory_order_relaxed);
+    if (n > 0) s.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n) * scale;
+    s.max = static_cast<double>(maxValue) * scale;
+    return s;
+}
+
+// ===== AudioProfiler =====
+
+AudioProfiler& AudioProfiler::instance() noexcept {
+    return g_audioProfiler;
+}
+
+uint64_t AudioProfiler::nowNs() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const char* AudioProfiler::stageName(ProfileStage stage) noexcept {
+    switch (stage) {
+        case ProfileStage::Conversion: return "conversion";
+        case ProfileStage::NoiseReducer: return "nr";
+        case ProfileStage::RNNoise: return "rnnoise";
+        case ProfileStage::Effects: return "fx";
+        case ProfileStage::Safety: return "safety";
+        case ProfileStage::Equalizer: return "eq";
+        case ProfileStage::Analysis: return "analysis";
+        case ProfileStage::Total: return "total";
+        case ProfileStage::Count: break;
+    }
+    return "?";
+}
+
+void AudioProfiler::recordStage(ProfileStage stage, uint64_t ns) noexcept {
+    stages_[static_cast<size_t>(stage)].record(ns);
+}
+
+void AudioProfiler::recordBuffer(uint64_t totalNs, size_t frames, uint32_t sampleRate) noexcept {
+    stages_[static_cast<size_t>(ProfileStage::Total)].record(totalNs);
+    if (frames == 0 || sampleRate == 0) return;
+    const double bufferNs = static_cast<double>(frames) * 1e9 / static_cast<double>(sampleRate);
+    const double load = static_cast<double>(totalNs) / bufferNs;
+    load_.record(static_cast<uint64_t>(load * 10000.0));
+    if (load > 1.0) overruns_.store(overruns_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void AudioProfiler::reset() noexcept {
+    for (auto& h : stages_) h.reset();
+    load_.reset();
+    overruns_.store(0, std::memory_order_relaxed);
+}
+
+ProfilerReport AudioProfiler::report() const noexcept {
+    ProfilerReport r;
+    r.enabled = isEnabled();
+    for (size_t i = 0; i < kProfileStageCount; ++i) {
+        r.stagesUs[i] = stages_[i].stats(1e-3);
+    }
+    r.buffers = r.stagesUs[static_cast<size_t>(ProfileStage::Total)].count;
+    r.loadPercent = load_.stats(1e-2);
+    r.overruns = overruns_.load(std::memory_order_relaxed);
+    return r;
+}
+
+// ===== ProfileLap =====
+
+#if NAAYA_AUDIO_PROFILER
+void ProfileLap::finish() noexcept {
+    if (!active_) return;
+    active_ = false;
+    AudioProfiler& profiler = AudioProfiler::instance();
+    for (size_t i = 0; i < kProfileStageCount; ++i) {
+        if (touched_ & (1u << i)) profiler.recordStage(static_cast<ProfileStage>(i), acc_[i]);
+    }
+    profiler.recordBuffer(AudioProfiler::nowNs() - start_, frames_, sampleRate_);
+}
+#endif
+
+} // namespace AudioEqualizer
@@ -0,0 +1,149 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Interrupteur de compilation : -DNAAYA_AUDIO_PROFILER=0 retire toute l'instrumentation
+// du chemin audio (ProfileLap devient vide, aucune lecture d'horloge).
+#ifndef NAAYA_AUDIO_PROFILER
+#define NAAYA_AUDIO_PROFILER 1
+#endif
+
+namespace AudioEqualizer {
+
+// Étages instrumentés de la chaîne temps réel
+enum class ProfileStage : uint8_t {
+    Conversion = 0,   // int16/float <-> float de travail
+    NoiseReducer,
+    RNNoise,
+    Effects,
+    Safety,
+    Equalizer,
+    Analysis,         // spectre UI
+    Total,            // buffer complet
+    Count
+};
+
+constexpr size_t kProfileStageCount = static_cast<size_t>(ProfileStage::Count);
+
+struct ProfileStats {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+struct ProfilerReport {
+    bool enabled = false;
+    uint64_t buffers = 0;
+    uint64_t overruns = 0;                               // buffers traités en plus de leur durée
+    std::array<ProfileStats, kProfileStageCount> stagesUs{}; // microsecondes par buffer
+    ProfileStats loadPercent;                            // temps de traitement / durée du buffer
+};
+
+// Histogramme log-linéaire à cases fixes (16 sous-cases par octave, erreur <= 6.25%).
+// Un seul thread écrivain (le thread audio), lecteurs concurrents sans verrou :
+// compteurs atomiques relaxed, lecture approximative pendant l'écriture.
+class ProfileHistogram {
+public:
+    static constexpr unsigned kSubBits = 4;
+    static constexpr size_t kSub = size_t(1) << kSubBits;
+    static constexpr unsigned kMaxExponent = 35;   // ~34 s en ns
+    static constexpr size_t kBuckets = (kMaxExponent - kSubBits + 2) * kSub;
+
+    void record(uint64_t value) noexcept;
+    void reset() noexcept;
+    // scale : conversion unité enregistrée -> unité du rapport
+    ProfileStats stats(double scale) const noexcept;
+
+    static size_t bucketIndex(uint64_t value) noexcept;
+    static uint64_t bucketUpperBound(size_t index) noexcept;
+
+private:
+    std::array<std::atomic<uint32_t>, kBuckets> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+// Agrégat global, alimenté par le thread audio et lu par JSI
+class AudioProfiler {
+public:
+    static AudioProfiler& instance() noexcept;
+    static constexpr bool compiledIn() noexcept { return NAAYA_AUDIO_PROFILER != 0; }
+
+    void setEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return compiledIn() && enabled_.load(std::memory_order_relaxed); }
+
+    void recordStage(ProfileStage stage, uint64_t ns) noexcept;
+    void recordBuffer(uint64_t totalNs, size_t frames, uint32_t sampleRate) noexcept;
+    void reset() noexcept;
+    ProfilerReport report() const noexcept;
+
+    static uint64_t nowNs() noexcept;
+    static const char* stageName(ProfileStage stage) noexcept;
+
+private:
+    std::array<ProfileHistogram, kProfileStageCount> stages_;
+    ProfileHistogram load_;   // centièmes de pourcent
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<bool> enabled_{true};
+};
+
+// Chronomètre à tours pour une chaîne séquentielle : mark(stage) attribue le temps
+// écoulé depuis le mark précédent à l'étage (cumulé si l'étage revient, ex. conversions
+// entrée + sortie). finish() (ou le destructeur) publie une mesure par étage touché,
+// plus le total et la charge temps réel du buffer.
+class ProfileLap {
+public:
+#if NAAYA_AUDIO_PROFILER
+    ProfileLap(size_t frames, uint32_t sampleRate) noexcept
+        : frames_(frames), sampleRate_(sampleRate),
+          active_(AudioProfiler::instance().isEnabled()) {
+        if (active_) start_ = last_ = AudioProfiler::nowNs();
+    }
+    ~ProfileLap() { finish(); }
+
+    void mark(ProfileStage stage) noexcept {
+        if (!active_) return;
+        const uint64_t now = AudioProfiler::nowNs();
+        const size_t i = static_cast<size_t>(stage);
+        acc_[i] += now - last_;
+        touched_ |= 1u << i;
+        last_ = now;
+    }
+    // Ignore le temps écoulé depuis le mark précédent
+    void skip() noexcept {
+        if (active_) last_ = AudioProfiler::nowNs();
+    }
+    void finish() noexcept;
+#else
+    ProfileLap(size_t, uint32_t) noexcept {}
+    void mark(ProfileStage) noexcept {}
+    void skip() noexcept {}
+    void finish() noexcept {}
+#endif
+
+    ProfileLap(const ProfileLap&) = delete;
+    ProfileLap& operator=(const ProfileLap&) = delete;
+
+#if NAAYA_AUDIO_PROFILER
+private:
+    size_t frames_;
+    uint32_t sampleRate_;
+    bool active_;
+    uint32_t touched_ = 0;
+    uint64_t start_ = 0;
+    uint64_t last_ = 0;
+    std::array<uint64_t, kProfileStageCount> acc_{};
+#endif
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
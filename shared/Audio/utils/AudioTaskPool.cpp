@@ -0,0 +1,151 @@
+#include "AudioTaskPool.h"
+#include "RealtimeScope.h"
+#include <algorithm>
+#include <optional>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace AudioEqualizer {
+
+namespace {
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Attente active avant de s'endormir : couvre l'écart entre les deux parallelFor d'un même buffer
+constexpr int kSpinIterations = 4096;
+} // namespace
+
+AudioTaskPool::AudioTaskPool(size_t numWorkers, bool realtimePriority)
+    : slots_(numWorkers + 1), realtimePriority_(realtimePriority) {
+    workers_.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i + 1); });
+    }
+}
+
+AudioTaskPool::~AudioTaskPool() {
+    stop_.store(true, std::memory_order_release);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    generation_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+size_t AudioTaskPool::recommendedWorkers(size_t maxWorkers) {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return std::min<size_t>(maxWorkers, hw > 1 ? hw - 1 : 0);
+}
+
+void AudioTaskPool::parallelFor(size_t count, TaskFn fn, void* context) noexcept {
+    if (count == 0 || !fn) return;
+    if (workers_.empty()) {
+        for (size_t i = 0; i < count; ++i) fn(context, i);
+        return;
+    }
+
+    const size_t parts = slots_.size();
+    for (size_t base = 0; base < count; base += kMaxTasksPerBlock) {
+        const size_t n = std::min(count - base, kMaxTasksPerBlock);
+        const uint32_t gen = generation_.load(std::memory_order_relaxed) + 1;
+
+        fn_.store(fn, std::memory_order_relaxed);
+        context_.store(context, std::memory_order_relaxed);
+        base_.store(base, std::memory_order_relaxed);
+        remaining_.store(n, std::memory_order_relaxed);
+        for (size_t p = 0; p < parts; ++p) {
+            const uint32_t b = static_cast<uint32_t>(n * p / parts);
+            const uint32_t e = static_cast<uint32_t>(n * (p + 1) / parts);
+            slots_[p].range.store(pack(gen, b, e), std::memory_order_relaxed);
+        }
+        generation_.store(gen, std::memory_order_release);
+        generation_.notify_all();
+
+        runBlock(0, gen, fn, context, base);
+
+        // Barrière : toutes les tâches du bloc sont terminées (y compris celles volées)
+        while (remaining_.load(std::memory_order_acquire) != 0) cpuRelax();
+    }
+}
+
+void AudioTaskPool::runBlock(size_t self, uint32_t gen, TaskFn fn, void* context, size_t base) noexcept {
+    uint32_t index = 0;
+    while (popLocal(self, gen, index) || steal(self, gen, index)) {
+        fn(context, base + index);
+        remaining_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool AudioTaskPool::popLocal(size_t self, uint32_t gen, uint32_t& index) noexcept {
+    auto& range = slots_[self].range;
+    uint64_t cur = range.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t b = beginOf(cur), e = endOf(cur);
+        if (genOf(cur) != gen || b >= e) return false;
+        if (range.compare_exchange_weak(cur, pack(gen, b + 1, e),
+                                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+            index = b;
+            return true;
+        }
+    }
+}
+
+bool AudioTaskPool::steal(size_t self, uint32_t gen, uint32_t& index) noexcept {
+    const size_t parts = slots_.size();
+    for (size_t k = 1; k < parts; ++k) {
+        auto& victim = slots_[(self + k) % parts].range;
+        uint64_t cur = victim.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t b = beginOf(cur), e = endOf(cur);
+            if (genOf(cur) != gen || b >= e) break;
+            // Vol de la moitié haute : la victime garde [b, mid), le voleur prend [mid, e)
+            const uint32_t mid = b + (e - b) / 2;
+            if (victim.compare_exchange_weak(cur, pack(gen, b, mid),
+                                             std::memory_order_acq_rel, std::memory_order_acquire)) {
+                index = mid;
+                // Seul le propriétaire remplit sa plage, vide à ce stade : store suffisant
+                if (mid + 1 < e) slots_[self].range.store(pack(gen, mid + 1, e), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void AudioTaskPool::workerLoop(size_t self) {
+    // Pool temps réel : section temps réel complète. Pool hors ligne : FTZ/DAZ seul, ses
+    // tâches allouent (rendu par segments)
+    std::optional<RealtimeScope> rt;
+    std::optional<DenormalScope> ftz;
+    if (realtimePriority_) rt.emplace(true);
+    else ftz.emplace();
+    uint32_t seen = generation_.load(std::memory_order_acquire);
+    while (!stop_.load(std::memory_order_acquire)) {
+        uint32_t gen = generation_.load(std::memory_order_acquire);
+        if (gen == seen) {
+            for (int i = 0; i < kSpinIterations && gen == seen; ++i) {
+                cpuRelax();
+                gen = generation_.load(std::memory_order_acquire);
+            }
+            if (gen == seen) {
+                generation_.wait(seen, std::memory_order_acquire);
+                continue;
+            }
+        }
+        seen = gen;
+        if (stop_.load(std::memory_order_acquire)) break;
+        // fn_/context_/base_ publiés avant la génération (release); si un bloc plus récent les a
+        // remplacés, les plages de `gen` sont déjà vides et rien n'est exécuté
+        runBlock(self, gen, fn_.load(std::memory_order_relaxed), context_.load(std::memory_order_relaxed),
+                 base_.load(std::memory_order_relaxed));
+    }
+}
+
+} // namespace AudioEqualizer
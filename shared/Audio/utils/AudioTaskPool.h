@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace AudioEqualizer {
+
+// Pool de workers pour le traitement audio par blocs.
+//
+// parallelFor(count, fn) exécute fn(context, i) pour i dans [0, count) et rend la main
+// quand toutes les tâches du bloc sont terminées (barrière par bloc). L'appelant participe.
+// Chaque participant reçoit une plage contiguë d'indices; un participant à court de travail
+// vole la moitié haute de la plage d'un autre (vol de travail par CAS sur un mot 64 bits).
+//
+// Aucune allocation ni verrou dans parallelFor() : utilisable depuis le thread audio.
+// Les workers attendent sur un compteur de génération (atomic wait, C++20) après une
+// courte attente active. Avec realtimePriority, ils s'exécutent dans une RealtimeScope
+// (FTZ/DAZ, priorité audio, tripwires); sans, dans une DenormalScope (traitements hors ligne).
+class AudioTaskPool {
+public:
+    using TaskFn = void (*)(void* context, size_t index);
+
+    static constexpr size_t kMaxTasksPerBlock = 0xFFFF;
+
+    // numWorkers : threads créés en plus de l'appelant (0 = exécution séquentielle)
+    explicit AudioTaskPool(size_t numWorkers, bool realtimePriority = true);
+    ~AudioTaskPool();
+
+    AudioTaskPool(const AudioTaskPool&) = delete;
+    AudioTaskPool& operator=(const AudioTaskPool&) = delete;
+
+    // Participants, appelant compris
+    size_t getNumThreads() const { return slots_.size(); }
+
+    // Un seul appelant à la fois; count > kMaxTasksPerBlock est traité en plusieurs blocs
+    void parallelFor(size_t count, TaskFn fn, void* context) noexcept;
+
+    template <typename F>
+    void parallelFor(size_t count, F& f) noexcept {
+        parallelFor(count, [](void* ctx, size_t i) { (*static_cast<F*>(ctx))(i); }, &f);
+    }
+
+    // Workers recommandés pour cet appareil (coeurs - 1, borné)
+    static size_t recommendedWorkers(size_t maxWorkers = 7);
+
+private:
+    // Plage [begin, end) d'un participant, étiquetée par la génération du bloc
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> range{0};
+    };
+
+    static uint64_t pack(uint32_t gen, uint32_t begin, uint32_t end) noexcept {
+        return (static_cast<uint64_t>(gen) << 32) | (static_cast<uint64_t>(begin & 0xFFFF) << 16) | (end & 0xFFFF);
+    }
+    static uint32_t genOf(uint64_t r) noexcept { return static_cast<uint32_t>(r >> 32); }
+    static uint32_t beginOf(uint64_t r) noexcept { return static_cast<uint32_t>((r >> 16) & 0xFFFF); }
+    static uint32_t endOf(uint64_t r) noexcept { return static_cast<uint32_t>(r & 0xFFFF); }
+
+    void runBlock(size_t self, uint32_t gen, TaskFn fn, void* context, size_t base) noexcept;
+    bool popLocal(size_t self, uint32_t gen, uint32_t& index) noexcept;
+    bool steal(size_t self, uint32_t gen, uint32_t& index) noexcept;
+    void workerLoop(size_t self);
+
+    std::vector<Slot> slots_;              // 0 = appelant, 1..n = workers
+    std::vector<std::thread> workers_;
+
+    alignas(64) std::atomic<uint32_t> generation_{0};
+    alignas(64) std::atomic<size_t> remaining_{0};
+    std::atomic<TaskFn> fn_{nullptr};
+    std::atomic<void*> context_{nullptr};
+    std::atomic<size_t> base_{0};         // index absolu du premier élément du bloc
+    std::atomic<bool> stop_{false};
+    bool realtimePriority_;
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
@@ -0,0 +1,47 @@
+#include "CompensationDelay.h"
+#include <algorithm>
+#include <cstring>
+
+namespace AudioEqualizer {
+
+void CompensationDelay::setMaxDelay(size_t maxDelay) {
+    m_line.assign(maxDelay, 0.0f);
+    m_delay = std::min(m_delay, maxDelay);
+    m_pos = 0;
+}
+
+void CompensationDelay::setDelay(size_t samples) noexcept {
+    samples = std::min(samples, m_line.size());
+    if (samples == m_delay) return;
+    m_delay = samples;
+    reset();
+}
+
+void CompensationDelay::reset() noexcept {
+    std::fill(m_line.begin(), m_line.end(), 0.0f);
+    m_pos = 0;
+}
+
+void CompensationDelay::process(const float* input, float* output, size_t numSamples) noexcept {
+    if (m_delay == 0) {
+        if (output != input) std::memmove(output, input, numSamples * sizeof(float));
+        return;
+    }
+    float* line = m_line.data();
+    size_t i = 0;
+    while (i < numSamples) {
+        // Segment contigu de la ligne : échange sortie <- ligne <- entrée
+        const size_t chunk = std::min(numSamples - i, m_delay - m_pos);
+        float* slot = line + m_pos;
+        for (size_t k = 0; k < chunk; ++k) {
+            const float x = input[i + k];
+            output[i + k] = slot[k];
+            slot[k] = x;
+        }
+        i += chunk;
+        m_pos += chunk;
+        if (m_pos == m_delay) m_pos = 0;
+    }
+}
+
+} // namespace AudioEqualizer
@@ -0,0 +1,36 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <vector>
+
+namespace AudioEqualizer {
+
+// Retard entier d'un canal, pour aligner des chemins de latences différentes.
+//
+// Ligne circulaire de exactement delay échantillons, allouée par setMaxDelay() (hors
+// thread audio); setDelay() ne fait que borner et vider la ligne. Entrée et sortie
+// peuvent se recouvrir (traitement en place).
+class CompensationDelay {
+public:
+    explicit CompensationDelay(size_t maxDelay = 0) { setMaxDelay(maxDelay); }
+
+    void setMaxDelay(size_t maxDelay);
+    size_t getMaxDelay() const { return m_line.size(); }
+
+    // Borné à getMaxDelay(); sans effet si inchangé, sinon repart de silence
+    void setDelay(size_t samples) noexcept;
+    size_t getDelay() const { return m_delay; }
+
+    void reset() noexcept;
+    void process(const float* input, float* output, size_t numSamples) noexcept;
+
+private:
+    std::vector<float> m_line;
+    size_t m_delay = 0;
+    size_t m_pos = 0;
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
@@ -0,0 +1,229 @@
+#include "RealFFT.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace AudioEqualizer {
+
+namespace {
+
+// Vecteur de 4 floats (SSE2 / NEON); sans SIMD, boucles scalaires uniquement
+#if defined(__SSE2__)
+#define NAAYA_FFT_SIMD 1
+using vf4 = __m128;
+inline vf4 load4(const float* p) { return _mm_loadu_ps(p); }
+inline void store4(float* p, vf4 v) { _mm_storeu_ps(p, v); }
+inline vf4 add4(vf4 a, vf4 b) { return _mm_add_ps(a, b); }
+inline vf4 sub4(vf4 a, vf4 b) { return _mm_sub_ps(a, b); }
+inline vf4 mul4(vf4 a, vf4 b) { return _mm_mul_ps(a, b); }
+inline vf4 set4(float v) { return _mm_set1_ps(v); }
+inline vf4 reverse4(vf4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)); }
+#elif defined(__ARM_NEON)
+#define NAAYA_FFT_SIMD 1
+using vf4 = float32x4_t;
+inline vf4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, vf4 v) { vst1q_f32(p, v); }
+inline vf4 add4(vf4 a, vf4 b) { return vaddq_f32(a, b); }
+inline vf4 sub4(vf4 a, vf4 b) { return vsubq_f32(a, b); }
+inline vf4 mul4(vf4 a, vf4 b) { return vmulq_f32(a, b); }
+inline vf4 set4(float v) { return vdupq_n_f32(v); }
+inline vf4 reverse4(vf4 v) { const vf4 r = vrev64q_f32(v); return vcombine_f32(vget_high_f32(r), vget_low_f32(r)); }
+#else
+#define NAAYA_FFT_SIMD 0
+#endif
+
+} // namespace
+
+RealFFT::RealFFT(size_t size) {
+    size_t n = 16;
+    while (n < size && n < (size_t(1) << 16)) n <<= 1;
+    m_size = n;
+    m_half = n / 2;
+
+    const double twoPi = 2.0 * M_PI;
+    m_window.resize(m_size);
+    for (size_t i = 0; i < m_size; ++i) {
+        m_window[i] = static_cast<float>(0.5 * (1.0 - std::cos(twoPi * static_cast<double>(i) / static_cast<double>(m_size))));
+    }
+
+    unsigned bits = 0;
+    while ((size_t(1) << bits) < m_half) ++bits;
+    m_bitrev.resize(m_half);
+    for (size_t i = 0; i < m_half; ++i) {
+        uint32_t r = 0;
+        for (unsigned b = 0; b < bits; ++b) r |= static_cast<uint32_t>((i >> b) & 1u) << (bits - 1 - b);
+        m_bitrev[i] = r;
+    }
+
+    // Twiddles de chaque étage rangés à la suite : lecture contiguë dans la boucle vectorielle
+    m_twRe.resize(m_half);
+    m_twIm.resize(m_half);
+    for (size_t h = 1; h < m_half; h <<= 1) {
+        for (size_t k = 0; k < h; ++k) {
+            const double a = -M_PI * static_cast<double>(k) / static_cast<double>(h);
+            m_twRe[h - 1 + k] = static_cast<float>(std::cos(a));
+            m_twIm[h - 1 + k] = static_cast<float>(std::sin(a));
+        }
+    }
+    m_splitRe.resize(m_half);
+    m_splitIm.resize(m_half);
+    for (size_t k = 0; k < m_half; ++k) {
+        const double a = -twoPi * static_cast<double>(k) / static_cast<double>(m_size);
+        m_splitRe[k] = static_cast<float>(std::cos(a));
+        m_splitIm[k] = static_cast<float>(std::sin(a));
+    }
+
+    m_re.assign(m_half, 0.0f);
+    m_im.assign(m_half, 0.0f);
+    m_windowed.assign(m_size, 0.0f);
+    m_outRe.assign(m_half + 1, 0.0f);
+    m_outIm.assign(m_half + 1, 0.0f);
+}
+
+// FFT complexe de N/2 points en place (entrée déjà permutée)
+void RealFFT::transform() noexcept {
+    float* re = m_re.data();
+    float* im = m_im.data();
+    const size_t M = m_half;
+
+    // h = 1 et h = 2 : twiddles triviaux (1, -i)
+    for (size_t j = 0; j < M; j += 2) {
+        const float ar = re[j], ai = im[j], br = re[j + 1], bi = im[j + 1];
+        re[j] = ar + br; im[j] = ai + bi;
+        re[j + 1] = ar - br; im[j + 1] = ai - bi;
+    }
+    for (size_t j = 0; j < M; j += 4) {
+        float ar = re[j], ai = im[j], br = re[j + 2], bi = im[j + 2];
+        re[j] = ar + br; im[j] = ai + bi;
+        re[j + 2] = ar - br; im[j + 2] = ai - bi;
+        ar = re[j + 1]; ai = im[j + 1];
+        br = im[j + 3]; bi = -re[j + 3];        // b * (-i)
+        re[j + 1] = ar + br; im[j + 1] = ai + bi;
+        re[j + 3] = ar - br; im[j + 3] = ai - bi;
+    }
+
+    for (size_t h = 4; h < M; h <<= 1) {
+        const float* wRe = m_twRe.data() + h - 1;
+        const float* wIm = m_twIm.data() + h - 1;
+        for (size_t j = 0; j < M; j += 2 * h) {
+            float* aRe = re + j;
+            float* aIm = im + j;
+            float* bRe = aRe + h;
+            float* bIm = aIm + h;
+            size_t k = 0;
+#if NAAYA_FFT_SIMD
+            for (; k < h; k += 4) {
+                const vf4 wr = load4(wRe + k), wi = load4(wIm + k);
+                const vf4 xr = load4(bRe + k), xi = load4(bIm + k);
+                const vf4 tr = sub4(mul4(xr, wr), mul4(xi, wi));
+                const vf4 ti = add4(mul4(xr, wi), mul4(xi, wr));
+                const vf4 ur = load4(aRe + k), ui = load4(aIm + k);
+                store4(aRe + k, add4(ur, tr)); store4(aIm + k, add4(ui, ti));
+                store4(bRe + k, sub4(ur, tr)); store4(bIm + k, sub4(ui, ti));
+            }
+#endif
+            for (; k < h; ++k) {
+                const float tr = bRe[k] * wRe[k] - bIm[k] * wIm[k];
+                const float ti = bRe[k] * wIm[k] + bIm[k] * wRe[k];
+                const float ur = aRe[k], ui = aIm[k];
+                aRe[k] = ur + tr; aIm[k] = ui + ti;
+                bRe[k] = ur - tr; bIm[k] = ui - ti;
+            }
+        }
+    }
+}
+
+void RealFFT::forward(const float* input, float* outRe, float* outIm) noexcept {
+    const size_t M = m_half;
+    // z[n] = x[2n] + i x[2n + 1], rangé directement à sa place permutée
+    for (size_t n = 0; n < M; ++n) {
+        const uint32_t r = m_bitrev[n];
+        m_re[r] = input[2 * n];
+        m_im[r] = input[2 * n + 1];
+    }
+    transform();
+
+    // Séparation : X[k] = E[k] + W^k O[k], E/O tirés de Z[k] et conj(Z[M - k])
+    const float* zr = m_re.data();
+    const float* zi = m_im.data();
+    outRe[0] = zr[0] + zi[0]; outIm[0] = 0.0f;
+    outRe[M] = zr[0] - zi[0]; outIm[M] = 0.0f;
+    size_t k = 1;
+#if NAAYA_FFT_SIMD
+    const vf4 half = set4(0.5f);
+    for (; k + 4 <= M; k += 4) {
+        const vf4 ar = load4(zr + k), ai = load4(zi + k);
+        const vf4 cr = reverse4(load4(zr + M - k - 3)), ci = reverse4(load4(zi + M - k - 3));
+        const vf4 er = mul4(half, add4(ar, cr)), ei = mul4(half, sub4(ai, ci));
+        const vf4 orr = mul4(half, add4(ai, ci)), oi = mul4(half, sub4(cr, ar));
+        const vf4 wr = load4(m_splitRe.data() + k), wi = load4(m_splitIm.data() + k);
+        store4(outRe + k, add4(er, sub4(mul4(wr, orr), mul4(wi, oi))));
+        store4(outIm + k, add4(ei, add4(mul4(wr, oi), mul4(wi, orr))));
+    }
+#endif
+    for (; k < M; ++k) {
+        const float ar = zr[k], ai = zi[k], cr = zr[M - k], ci = zi[M - k];
+        const float er = 0.5f * (ar + cr), ei = 0.5f * (ai - ci);
+        const float orr = 0.5f * (ai + ci), oi = 0.5f * (cr - ar);
+        const float wr = m_splitRe[k], wi = m_splitIm[k];
+        outRe[k] = er + wr * orr - wi * oi;
+        outIm[k] = ei + wr * oi + wi * orr;
+    }
+}
+
+void RealFFT::inverse(const float* inRe, const float* inIm, float* output) noexcept {
+    const size_t M = m_half;
+    // Z[k] = E[k] + i W^-k O[k], avec E/O tirés de X[k] et conj(X[M - k]); conj(Z) permuté,
+    // puis FFT directe : ifft(Z) = conj(fft(conj(Z))) / M
+    for (size_t k = 0; k < M; ++k) {
+        const float ar = inRe[k], ai = k == 0 ? 0.0f : inIm[k];
+        const float cr = inRe[M - k], ci = k == 0 ? 0.0f : inIm[M - k];
+        const float er = 0.5f * (ar + cr), ei = 0.5f * (ai - ci);
+        const float dr = 0.5f * (ar - cr), di = 0.5f * (ai + ci);
+        const float wr = m_splitRe[k], wi = m_splitIm[k];
+        const float orr = dr * wr + di * wi, oi = di * wr - dr * wi;
+        const uint32_t r = m_bitrev[k];
+        m_re[r] = er - oi;
+        m_im[r] = -(ei + orr);
+    }
+    transform();
+
+    const float scale = 1.0f / static_cast<float>(M);
+    for (size_t n = 0; n < M; ++n) {
+        output[2 * n] = m_re[n] * scale;
+        output[2 * n + 1] = -m_im[n] * scale;
+    }
+}
+
+void RealFFT::powerSpectrum(const float* input, float* power) noexcept {
+    const float* w = m_window.data();
+    float* x = m_windowed.data();
+    size_t i = 0;
+#if NAAYA_FFT_SIMD
+    for (; i + 4 <= m_size; i += 4) store4(x + i, mul4(load4(input + i), load4(w + i)));
+#endif
+    for (; i < m_size; ++i) x[i] = input[i] * w[i];
+
+    forward(x, m_outRe.data(), m_outIm.data());
+
+    const float* re = m_outRe.data();
+    const float* im = m_outIm.data();
+    const size_t bins = numBins();
+    size_t k = 0;
+#if NAAYA_FFT_SIMD
+    for (; k + 4 <= bins; k += 4) {
+        const vf4 r = load4(re + k), m = load4(im + k);
+        store4(power + k, add4(mul4(r, r), mul4(m, m)));
+    }
+#endif
+    for (; k < bins; ++k) power[k] = re[k] * re[k] + im[k] * im[k];
+}
+
+} // namespace AudioEqualizer
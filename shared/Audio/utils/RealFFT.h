@@ -0,0 +1,54 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AudioEqualizer {
+
+// FFT réelle de taille N (puissance de deux, 16 .. 2^16), simple précision.
+//
+// FFT complexe de N/2 points sur les échantillons pairs/impairs, puis séparation des
+// spectres (recombinaison pour l'inverse). Fenêtre de Hann, permutation et twiddles (contigus par étage) sont calculés
+// à la construction : aucune allocation par trame. Étages, séparation et fenêtrage
+// traitent 4 cases à la fois (SSE2 / NEON, repli scalaire).
+//
+// Une instance par thread (tampons de travail internes).
+class RealFFT {
+public:
+    explicit RealFFT(size_t size);
+
+    size_t size() const { return m_size; }
+    size_t numBins() const { return m_size / 2 + 1; }
+
+    // Hann périodique : somme des coefficients = N / 2
+    const float* window() const { return m_window.data(); }
+
+    // X[k] = re[k] + i im[k], k = 0 .. N/2 (entrée non fenêtrée)
+    void forward(const float* input, float* re, float* im) noexcept;
+
+    // Inverse de forward() : N échantillons réels, mis à l'échelle (inverse(forward(x)) = x).
+    // im[0] et im[N/2] sont ignorés. output peut être l'entrée de forward().
+    void inverse(const float* re, const float* im, float* output) noexcept;
+
+    // |X[k]|^2 de l'entrée fenêtrée (Hann), k = 0 .. N/2
+    void powerSpectrum(const float* input, float* power) noexcept;
+
+private:
+    void transform() noexcept;
+
+    size_t m_size;
+    size_t m_half;
+    std::vector<float> m_window;
+    std::vector<uint32_t> m_bitrev;     // permutation des N/2 points complexes
+    std::vector<float> m_twRe, m_twIm;  // étage de demi-longueur h : [h - 1, 2h - 1)
+    std::vector<float> m_splitRe, m_splitIm;   // e^{-2 i pi k / N}, k < N/2
+    std::vector<float> m_re, m_im;      // travail
+    std::vector<float> m_windowed;
+    std::vector<float> m_outRe, m_outIm;
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
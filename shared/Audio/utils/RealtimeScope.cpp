@@ -0,0 +1,290 @@
+#include "RealtimeScope.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NAAYA_RT_X86 1
+#endif
+
+#include <unistd.h>
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <cerrno>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#define NAAYA_RT_LINUX 1
+#endif
+
+#if defined(NAAYA_RT_TRIPWIRES)
+#include <dlfcn.h>
+#include <pthread.h>
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+#endif
+
+namespace AudioEqualizer {
+
+namespace {
+thread_local int t_realtimeDepth = 0;
+thread_local bool t_reporting = false;
+std::atomic<uint64_t> g_violationCount{0};
+std::atomic<RealtimeViolationHandler> g_violationHandler{nullptr};
+
+// Priorité nice équivalente à ANDROID_PRIORITY_AUDIO
+constexpr int kAudioNicePriority = -16;
+
+uint64_t enableFlushToZero() noexcept {
+#if defined(NAAYA_RT_X86)
+    const unsigned int csr = _mm_getcsr();
+    _mm_setcsr(csr | 0x8040u);  // FTZ (bit 15) | DAZ (bit 6)
+    return csr;
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1ull << 24)));  // FZ
+    return fpcr;
+#elif defined(__arm__) && defined(__ARM_FP)
+    uint32_t fpscr;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr | (1u << 24)));  // FZ
+    return fpscr;
+#else
+    return 0;
+#endif
+}
+
+void restoreFpState(uint64_t state) noexcept {
+#if defined(NAAYA_RT_X86)
+    _mm_setcsr(static_cast<unsigned int>(state));
+#elif defined(__aarch64__)
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(state));
+#elif defined(__arm__) && defined(__ARM_FP)
+    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(static_cast<uint32_t>(state)));
+#else
+    (void)state;
+#endif
+}
+
+const char* kindLabel(RealtimeViolationKind kind) noexcept {
+    switch (kind) {
+        case RealtimeViolationKind::Allocation: return "allocation";
+        case RealtimeViolationKind::Deallocation: return "libération";
+        case RealtimeViolationKind::BlockingLock: return "verrou bloquant";
+    }
+    return "?";
+}
+
+// Pas d'allocation : snprintf sur la pile + write(2)
+void defaultViolationHandler(const RealtimeViolation& v) noexcept {
+    char line[256];
+    const char* symbol = nullptr;
+#if defined(NAAYA_RT_TRIPWIRES)
+    Dl_info info;
+    if (v.caller && dladdr(v.caller, &info) && info.dli_sname) symbol = info.dli_sname;
+#endif
+    int n = std::snprintf(line, sizeof(line),
+                          "[RealtimeScope] %s sur thread audio: %s (%zu octets) appelant=%p %s\n",
+                          kindLabel(v.kind), v.function ? v.function : "?", v.size, v.caller,
+                          symbol ? symbol : "");
+    if (n > 0) {
+        size_t len = static_cast<size_t>(n) < sizeof(line) ? static_cast<size_t>(n) : sizeof(line) - 1;
+        ssize_t written = ::write(2, line, len);
+        (void)written;
+    }
+#if defined(NAAYA_RT_TRIPWIRES) && defined(__GLIBC__)
+    void* frames[32];
+    int depth = backtrace(frames, 32);
+    backtrace_symbols_fd(frames, depth, 2);
+#endif
+}
+} // namespace
+
+DenormalScope::DenormalScope() noexcept : savedFpState_(enableFlushToZero()) {}
+
+DenormalScope::~DenormalScope() noexcept {
+    restoreFpState(savedFpState_);
+}
+
+bool DenormalScope::flushToZeroActive() noexcept {
+#if defined(NAAYA_RT_X86)
+    return (_mm_getcsr() & 0x8000u) != 0;
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    return (fpcr & (1ull << 24)) != 0;
+#elif defined(__arm__) && defined(__ARM_FP)
+    uint32_t fpscr;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+    return (fpscr & (1u << 24)) != 0;
+#else
+    return false;
+#endif
+}
+
+RealtimeScope::RealtimeScope(bool raisePriority) noexcept {
+    savedFpState_ = enableFlushToZero();
+#if defined(NAAYA_RT_LINUX)
+    if (raisePriority) {
+        const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        errno = 0;
+        int previous = getpriority(PRIO_PROCESS, static_cast<id_t>(tid));
+        if (errno == 0 && previous > kAudioNicePriority &&
+            setpriority(PRIO_PROCESS, static_cast<id_t>(tid), kAudioNicePriority) == 0) {
+            savedPriority_ = previous;
+            priorityRaised_ = true;
+        }
+    }
+#else
+    // Apple : les threads CoreAudio/AVFoundation sont déjà en classe temps réel
+    (void)raisePriority;
+#endif
+    ++t_realtimeDepth;
+}
+
+RealtimeScope::~RealtimeScope() noexcept {
+    --t_realtimeDepth;
+#if defined(NAAYA_RT_LINUX)
+    if (priorityRaised_) {
+        const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        setpriority(PRIO_PROCESS, static_cast<id_t>(tid), savedPriority_);
+    }
+#endif
+    restoreFpState(savedFpState_);
+}
+
+bool RealtimeScope::isActive() noexcept {
+    return t_realtimeDepth > 0;
+}
+
+bool RealtimeScope::tripwiresEnabled() noexcept {
+#if defined(NAAYA_RT_TRIPWIRES)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RealtimeScope::setViolationHandler(RealtimeViolationHandler handler) noexcept {
+    g_violationHandler.store(handler);
+}
+
+uint64_t RealtimeScope::violationCount() noexcept {
+    return g_violationCount.load(std::memory_order_relaxed);
+}
+
+void RealtimeScope::resetViolationCount() noexcept {
+    g_violationCount.store(0, std::memory_order_relaxed);
+}
+
+void RealtimeScope::reportViolation(RealtimeViolationKind kind, const char* function,
+                                    void* caller, size_t size) noexcept {
+    if (t_realtimeDepth <= 0 || t_reporting) return;
+    // Le handler peut lui-même allouer (symbolisation) : tripwires suspendus pendant le rapport
+    t_reporting = true;
+    g_violationCount.fetch_add(1, std::memory_order_relaxed);
+    RealtimeViolation v{kind, function, caller, size};
+    RealtimeViolationHandler handler = g_violationHandler.load();
+    (handler ? handler : defaultViolationHandler)(v);
+    t_reporting = false;
+}
+
+} // namespace AudioEqualizer
+
+#if defined(NAAYA_RT_TRIPWIRES)
+// ===== Tripwires =====
+// Vérification bon marché (un TLS) avant toute remontée; hors section temps réel,
+// les interposeurs ne font que relayer vers l'implémentation réelle.
+
+namespace {
+using AudioEqualizer::RealtimeScope;
+using AudioEqualizer::RealtimeViolationKind;
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void __libc_free(void*);
+inline void* rawMalloc(size_t n) { return __libc_malloc(n); }
+inline void rawFree(void* p) { __libc_free(p); }
+#else
+inline void* rawMalloc(size_t n) { return std::malloc(n); }
+inline void rawFree(void* p) { std::free(p); }
+#endif
+
+inline void checkAlloc(const char* fn, void* caller, size_t size) {
+    if (RealtimeScope::isActive()) RealtimeScope::reportViolation(RealtimeViolationKind::Allocation, fn, caller, size);
+}
+
+inline void checkFree(const char* fn, void* caller, void* p) {
+    if (p && RealtimeScope::isActive()) RealtimeScope::reportViolation(RealtimeViolationKind::Deallocation, fn, caller, 0);
+}
+
+void* tripwireNew(size_t size, void* caller) {
+    checkAlloc("operator new", caller, size);
+    void* p = rawMalloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+} // namespace
+
+void* operator new(size_t size) { return tripwireNew(size, __builtin_return_address(0)); }
+void* operator new[](size_t size) { return tripwireNew(size, __builtin_return_address(0)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    checkAlloc("operator new", __builtin_return_address(0), size);
+    return rawMalloc(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    checkAlloc("operator new[]", __builtin_return_address(0), size);
+    return rawMalloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept { checkFree("operator delete", __builtin_return_address(0), p); rawFree(p); }
+void operator delete[](void* p) noexcept { checkFree("operator delete[]", __builtin_return_address(0), p); rawFree(p); }
+void operator delete(void* p, size_t) noexcept { checkFree("operator delete", __builtin_return_address(0), p); rawFree(p); }
+void operator delete[](void* p, size_t) noexcept { checkFree("operator delete[]", __builtin_return_address(0), p); rawFree(p); }
+
+#if defined(__GLIBC__)
+// Interposition libc : couvre aussi le code C (FFmpeg, RNNoise) appelé depuis la chaîne
+extern "C" void* malloc(size_t size) {
+    checkAlloc("malloc", __builtin_return_address(0), size);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    checkAlloc("calloc", __builtin_return_address(0), count * size);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* p, size_t size) {
+    checkAlloc("realloc", __builtin_return_address(0), size);
+    return __libc_realloc(p, size);
+}
+
+extern "C" void free(void* p) {
+    checkFree("free", __builtin_return_address(0), p);
+    __libc_free(p);
+}
+
+namespace {
+using MutexLockFn = int (*)(pthread_mutex_t*);
+// Pas de static local : la garde d'initialisation C++ prend elle-même un mutex
+std::atomic<MutexLockFn> g_realMutexLock{nullptr};
+} // namespace
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    MutexLockFn real = g_realMutexLock.load(std::memory_order_acquire);
+    if (!real) {
+        real = reinterpret_cast<MutexLockFn>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        g_realMutexLock.store(real, std::memory_order_release);
+    }
+    if (RealtimeScope::isActive()) {
+        RealtimeScope::reportViolation(RealtimeViolationKind::BlockingLock, "pthread_mutex_lock",
+                                       __builtin_return_address(0), 0);
+    }
+    return real(mutex);
+}
+#endif // __GLIBC__
+#endif // NAAYA_RT_TRIPWIRES
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+
+namespace AudioEqualizer {
+
+// Violations détectées par les tripwires (builds instrumentés uniquement)
+enum class RealtimeViolationKind {
+    Allocation,
+    Deallocation,
+    BlockingLock
+};
+
+struct RealtimeViolation {
+    RealtimeViolationKind kind;
+    const char* function;   // "malloc", "operator new", "pthread_mutex_lock", ...
+    void* caller;           // adresse de retour, symbolisable (dladdr / addr2line)
+    size_t size;            // octets demandés (allocations), 0 sinon
+};
+
+using RealtimeViolationHandler = void (*)(const RealtimeViolation&);
+
+// FTZ/DAZ seul (RAII, imbricable), sans tripwires ni priorité : pour les appels DSP hors
+// thread audio qui allouent légitimement (JSI, thread appelant du mixeur, rendu hors ligne).
+class DenormalScope {
+public:
+    DenormalScope() noexcept;
+    ~DenormalScope() noexcept;
+
+    DenormalScope(const DenormalScope&) = delete;
+    DenormalScope& operator=(const DenormalScope&) = delete;
+
+    // FTZ actif sur le thread courant (contrôle des points d'entrée)
+    static bool flushToZeroActive() noexcept;
+
+private:
+    uint64_t savedFpState_ = 0;
+};
+
+// Section temps réel du thread courant (RAII, imbricable).
+//
+// - Active flush-to-zero / denormals-are-zero (MXCSR sur x86, FPCR/FPSCR.FZ sur ARM) :
+//   les filtres récursifs n'ont plus besoin de tester les dénormaux par échantillon.
+// - Optionnellement, élève la priorité du thread (Linux/Android, niveau audio).
+// - Compilé avec NAAYA_RT_TRIPWIRES, signale toute allocation/libération et tout
+//   verrou bloquant pris dans la section : operator new/delete partout, et sur glibc
+//   interposition de malloc/calloc/realloc/free et pthread_mutex_lock (harnais Linux).
+//   Sans NAAYA_RT_TRIPWIRES, aucun coût hors FTZ/DAZ.
+class RealtimeScope {
+public:
+    explicit RealtimeScope(bool raisePriority = false) noexcept;
+    ~RealtimeScope() noexcept;
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+    RealtimeScope(RealtimeScope&&) = delete;
+    RealtimeScope& operator=(RealtimeScope&&) = delete;
+
+    // Thread courant dans une section temps réel
+    static bool isActive() noexcept;
+
+    // Tripwires compilés dans ce binaire (NAAYA_RT_TRIPWIRES)
+    static bool tripwiresEnabled() noexcept;
+    // nullptr = handler par défaut (stderr + pile d'appels quand disponible)
+    static void setViolationHandler(RealtimeViolationHandler handler) noexcept;
+    static uint64_t violationCount() noexcept;
+    static void resetViolationCount() noexcept;
+
+    // Appelé par les interposeurs; utilisable aussi pour instrumenter un appel bloquant maison
+    static void reportViolation(RealtimeViolationKind kind, const char* function,
+                                void* caller, size_t size) noexcept;
+
+private:
+    uint64_t savedFpState_ = 0;
+    int savedPriority_ = 0;
+    bool priorityRaised_ = false;
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
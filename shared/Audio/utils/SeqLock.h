@@ -0,0 +1,80 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace AudioEqualizer {
+
+// Valeur publiée par le thread audio, lue ailleurs (JSI, enregistreur), sans verrou.
+//
+// Séquence paire au repos, impaire pendant une écriture; le lecteur recommence si elle a bougé.
+// Charge utile rangée en mots atomiques relâchés : aucune course de données au sens C++.
+// publish() est sans attente : une écriture concurrente (second thread audio) fait sauter la
+// publication plutôt que d'attendre, et une valeur identique à la courante n'est pas réécrite.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock : type copiable bit à bit");
+
+public:
+    SeqLock() noexcept { store(T{}); }
+    explicit SeqLock(const T& initial) noexcept { store(initial); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // false : valeur inchangée, ou écriture concurrente en cours
+    bool publish(const T& value) noexcept {
+        uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+        if ((seq & 1u) != 0 ||
+            !m_sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return false;
+        }
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        bool changed = false;
+        for (size_t i = 0; i < kWords && !changed; ++i) {
+            changed = m_words[i].load(std::memory_order_relaxed) != words[i];
+        }
+        if (!changed) {
+            m_sequence.store(seq, std::memory_order_release);
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) m_words[i].store(words[i], std::memory_order_relaxed);
+        m_sequence.store(seq + 2, std::memory_order_release);
+        return true;
+    }
+
+    T load() const noexcept {
+        uint64_t words[kWords];
+        for (;;) {
+            const uint32_t before = m_sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0) continue;
+            for (size_t i = 0; i < kWords; ++i) words[i] = m_words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void store(const T& value) noexcept {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < kWords; ++i) m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> m_sequence{0};
+    std::atomic<uint64_t> m_words[kWords];
+};
+
+} // namespace AudioEqualizer
+
+#endif // __cplusplus
@@ -0,0 +1,328 @@
+#include "AudioSource.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef FFMPEG_AVAILABLE
+extern "C" {
+    #include <libavformat/avformat.h>
+    #include <libavcodec/avcodec.h>
+    #include <libavutil/channel_layout.h>
+    #include <libavutil/mathematics.h>
+    #include <libswresample/swresample.h>
+}
+#endif
+
+namespace AudioWaveform {
+
+namespace {
+
+constexpr size_t kReadFrames = 8192;
+
+uint16_t le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t le32(const uint8_t* p) { return p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24); }
+uint64_t le64(const uint8_t* p) { return le32(p) | (uint64_t(le32(p + 4)) << 32); }
+
+// WAV/W64 PCM ou float, lus directement (pread) : pas de décodage, accès aléatoire exact.
+// Plus de deux canaux : les deux premiers sont gardés.
+class PcmSource final : public SampleSource {
+public:
+    ~PcmSource() override { if (m_fd >= 0) ::close(m_fd); }
+
+    bool open(const std::string& path) {
+        m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) return false;
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0) return false;
+        const uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+
+        static constexpr uint8_t kRiff[16] = {0x72, 0x69, 0x66, 0x66, 0x2E, 0x91, 0xCF, 0x11,
+                                              0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00};
+        static constexpr uint8_t kGuidTail[12] = {0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1,
+                                                  0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A};
+        uint8_t head[40];
+        if (::pread(m_fd, head, sizeof(head), 0) != static_cast<ssize_t>(sizeof(head))) return false;
+        bool w64 = false;
+        uint64_t off = 12;
+        if (std::memcmp(head, kRiff, 16) == 0) { w64 = true; off = 40; }
+        else if (std::memcmp(head, "RIFF", 4) != 0 || std::memcmp(head + 8, "WAVE", 4) != 0) return false;
+
+        const size_t chunkHead = w64 ? 24 : 8;
+        bool haveFmt = false;
+        uint8_t ck[24];
+        while (off + chunkHead <= fileSize) {
+            if (::pread(m_fd, ck, chunkHead, static_cast<off_t>(off)) != static_cast<ssize_t>(chunkHead)) return false;
+            if (w64 && std::memcmp(ck + 4, kGuidTail, 12) != 0) return false;
+            const uint64_t size = w64 ? le64(ck + 16) - 24 : le32(ck + 4);
+            if (std::memcmp(ck, "fmt ", 4) == 0) {
+                uint8_t fmt[40] = {0};
+                const size_t n = static_cast<size_t>(std::min<uint64_t>(size, sizeof(fmt)));
+                if (n < 16 || ::pread(m_fd, fmt, n, static_cast<off_t>(off + chunkHead)) != static_cast<ssize_t>(n)) return false;
+                m_tag = le16(fmt);
+                m_fileChannels = le16(fmt + 2);
+                m_sampleRate = le32(fmt + 4);
+                m_blockAlign = le16(fmt + 12);
+                m_bits = le16(fmt + 14);
+                if (m_tag == 0xFFFE && n >= 26) m_tag = le16(fmt + 24);   // WAVE_FORMAT_EXTENSIBLE
+                haveFmt = true;
+            } else if (std::memcmp(ck, "data", 4) == 0) {
+                if (!haveFmt) return false;
+                m_dataOffset = off + chunkHead;
+                const uint64_t available = fileSize > m_dataOffset ? fileSize - m_dataOffset : 0;
+                // Taille nulle, 0xFFFFFFFF ou au-delà du fichier : enregistrement en cours
+                m_dataBytes = (size == 0 || size > available) ? available : size;
+                break;
+            }
+            const uint64_t advance = w64 ? (size + 24 + 7) & ~uint64_t(7) : size + 8 + (size & 1);
+            off += advance;
+        }
+        if (m_dataOffset == 0 || m_fileChannels == 0 || m_sampleRate == 0) return false;
+        const bool pcm = m_tag == 1 && (m_bits == 8 || m_bits == 16 || m_bits == 24 || m_bits == 32);
+        const bool flt = m_tag == 3 && (m_bits == 32 || m_bits == 64);
+        if ((!pcm && !flt) || m_blockAlign != m_fileChannels * (m_bits / 8)) return false;
+        m_float = flt;
+        m_frames = m_dataBytes / m_blockAlign;
+        m_raw.resize(kReadFrames * m_blockAlign);
+        return true;
+    }
+
+    uint32_t sampleRate() const override { return m_sampleRate; }
+    int channels() const override { return m_fileChannels >= 2 ? 2 : 1; }
+    uint64_t frames() const override { return m_frames; }
+    bool exactLength() const override { return true; }
+
+    bool seek(uint64_t frame, std::string& /*error*/) override {
+        m_pos = std::min(frame, m_frames);
+        return true;
+    }
+
+    size_t read(float* const* planar, size_t maxFrames, std::string& error) override {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>({maxFrames, kReadFrames, m_frames - m_pos}));
+        if (n == 0) return 0;
+        const size_t bytes = n * m_blockAlign;
+        const ssize_t got = ::pread(m_fd, m_raw.data(), bytes, static_cast<off_t>(m_dataOffset + m_pos * m_blockAlign));
+        if (got != static_cast<ssize_t>(bytes)) { error = "Lecture PCM impossible"; return 0; }
+        const size_t width = m_bits / 8;
+        const int outCh = channels();
+        for (int c = 0; c < outCh; ++c) {
+            const uint8_t* p = m_raw.data() + static_cast<size_t>(c) * width;
+            float* dst = planar[c];
+            for (size_t i = 0; i < n; ++i, p += m_blockAlign) dst[i] = decode(p);
+        }
+        m_pos += n;
+        return n;
+    }
+
+private:
+    float decode(const uint8_t* p) const {
+        if (m_float) {
+            if (m_bits == 32) { float v; std::memcpy(&v, p, 4); return v; }
+            double v; std::memcpy(&v, p, 8); return static_cast<float>(v);
+        }
+        switch (m_bits) {
+            case 8:  return (static_cast<float>(p[0]) - 128.0f) * (1.0f / 128.0f);
+            case 16: return static_cast<float>(static_cast<int16_t>(le16(p))) * (1.0f / 32768.0f);
+            case 24: return static_cast<float>(static_cast<int32_t>((uint32_t(p[0]) << 8) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 24)) >> 8) * (1.0f / 8388608.0f);
+            default: return static_cast<float>(static_cast<int32_t>(le32(p))) * (1.0f / 2147483648.0f);
+        }
+    }
+
+    int m_fd = -1;
+    uint16_t m_tag = 0;
+    uint16_t m_fileChannels = 0;
+    uint16_t m_blockAlign = 0;
+    uint16_t m_bits = 0;
+    bool m_float = false;
+    uint32_t m_sampleRate = 0;
+    uint64_t m_dataOffset = 0;
+    uint64_t m_dataBytes = 0;
+    uint64_t m_frames = 0;
+    uint64_t m_pos = 0;
+    std::vector<uint8_t> m_raw;
+};
+
+#ifdef FFMPEG_AVAILABLE
+std::string avErrorString(int err) {
+    char buf[AV_ERROR_MAX_STRING_SIZE] = {0};
+    av_strerror(err, buf, sizeof(buf));
+    return buf;
+}
+
+// Piste audio principale décodée en float planaire (mono/stéréo, fréquence d'origine).
+// seek() : recherche FFmpeg en arrière puis découpe à l'échantillon d'après les pts.
+class FfmpegSource final : public SampleSource {
+public:
+    ~FfmpegSource() override {
+        av_frame_free(&m_frame);
+        av_packet_free(&m_pkt);
+        swr_free(&m_swr);
+        avcodec_free_context(&m_dec);
+        avformat_close_input(&m_fmt);
+    }
+
+    bool open(const std::string& path, std::string& error) {
+        int r = avformat_open_input(&m_fmt, path.c_str(), nullptr, nullptr);
+        if (r < 0) { error = "Ouverture impossible: " + avErrorString(r); return false; }
+        if ((r = avformat_find_stream_info(m_fmt, nullptr)) < 0) { error = avErrorString(r); return false; }
+        const AVCodec* codec = nullptr;
+        m_index = av_find_best_stream(m_fmt, AVMEDIA_TYPE_AUDIO, -1, -1, &codec, 0);
+        if (m_index < 0 || !codec) { error = "Aucune piste audio"; return false; }
+        AVStream* st = m_fmt->streams[m_index];
+        m_dec = avcodec_alloc_context3(codec);
+        if (!m_dec || avcodec_parameters_to_context(m_dec, st->codecpar) < 0) { error = "Décodeur audio"; return false; }
+        m_dec->pkt_timebase = st->time_base;
+        if ((r = avcodec_open2(m_dec, codec, nullptr)) < 0) { error = "Décodeur audio: " + avErrorString(r); return false; }
+
+        m_sampleRate = static_cast<uint32_t>(m_dec->sample_rate);
+        m_channels = m_dec->ch_layout.nb_channels >= 2 ? 2 : 1;
+        m_timeBase = st->time_base;
+        m_startTs = st->start_time != AV_NOPTS_VALUE ? st->start_time : 0;
+        if (st->duration > 0) {
+            m_frames = static_cast<uint64_t>(av_rescale_q(st->duration, st->time_base, AVRational{1, static_cast<int>(m_sampleRate)}));
+        } else if (m_fmt->duration > 0) {
+            m_frames = static_cast<uint64_t>(av_rescale(m_fmt->duration, m_sampleRate, AV_TIME_BASE));
+        }
+        if (!initResampler(error)) return false;
+        m_pkt = av_packet_alloc();
+        m_frame = av_frame_alloc();
+        if (!m_pkt || !m_frame) { error = "Mémoire"; return false; }
+        m_pending.assign(static_cast<size_t>(m_channels), {});
+        return true;
+    }
+
+    uint32_t sampleRate() const override { return m_sampleRate; }
+    int channels() const override { return m_channels; }
+    uint64_t frames() const override { return m_frames; }
+    bool exactLength() const override { return false; }
+
+    bool seek(uint64_t frame, std::string& error) override {
+        m_target = frame;
+        if (frame == 0 && m_next == 0 && !m_started) return true;
+        const int64_t ts = m_startTs + av_rescale_q(static_cast<int64_t>(frame), AVRational{1, static_cast<int>(m_sampleRate)}, m_timeBase);
+        const int r = av_seek_frame(m_fmt, m_index, ts, AVSEEK_FLAG_BACKWARD);
+        if (r < 0) { error = "Recherche: " + avErrorString(r); return false; }
+        avcodec_flush_buffers(m_dec);
+        swr_free(&m_swr);
+        if (!initResampler(error)) return false;
+        for (auto& ch : m_pending) ch.clear();
+        m_pendingPos = 0;
+        m_next = 0;
+        m_haveTs = false;
+        m_eof = false;
+        m_demuxEof = false;
+        return true;
+    }
+
+    size_t read(float* const* planar, size_t maxFrames, std::string& error) override {
+        m_started = true;
+        while (m_pendingPos >= m_pending[0].size()) {
+            if (m_eof) return 0;
+            for (auto& ch : m_pending) ch.clear();
+            m_pendingPos = 0;
+            if (!decode(error)) return 0;
+        }
+        const size_t n = std::min(maxFrames, m_pending[0].size() - m_pendingPos);
+        for (int c = 0; c < m_channels; ++c) {
+            std::memcpy(planar[c], m_pending[c].data() + m_pendingPos, n * sizeof(float));
+        }
+        m_pendingPos += n;
+        return n;
+    }
+
+private:
+    bool initResampler(std::string& error) {
+        AVChannelLayout layout;
+        av_channel_layout_default(&layout, m_channels);
+        const bool ok = swr_alloc_set_opts2(&m_swr, &layout, AV_SAMPLE_FMT_FLTP, m_dec->sample_rate,
+                                            &m_dec->ch_layout, m_dec->sample_fmt, m_dec->sample_rate, 0, nullptr) >= 0 &&
+                        swr_init(m_swr) >= 0;
+        av_channel_layout_uninit(&layout);
+        if (!ok) error = "Conversion audio";
+        return ok;
+    }
+
+    // Une trame décodée dans m_pending, échantillons antérieurs à m_target retirés
+    bool decode(std::string& error) {
+        for (;;) {
+            int r = avcodec_receive_frame(m_dec, m_frame);
+            if (r == 0) {
+                if (m_frame->best_effort_timestamp != AV_NOPTS_VALUE) {
+                    const int64_t idx = av_rescale_q(m_frame->best_effort_timestamp - m_startTs, m_timeBase,
+                                                     AVRational{1, static_cast<int>(m_sampleRate)});
+                    if (!m_haveTs || idx > static_cast<int64_t>(m_next)) m_next = static_cast<uint64_t>(std::max<int64_t>(0, idx));
+                    m_haveTs = true;
+                }
+                const int maxOut = swr_get_out_samples(m_swr, m_frame->nb_samples);
+                for (auto& ch : m_pending) ch.resize(static_cast<size_t>(std::max(0, maxOut)));
+                uint8_t* dst[2] = {nullptr, nullptr};
+                for (int c = 0; c < m_channels; ++c) dst[c] = reinterpret_cast<uint8_t*>(m_pending[c].data());
+                const int got = swr_convert(m_swr, dst, maxOut, const_cast<const uint8_t**>(m_frame->extended_data), m_frame->nb_samples);
+                av_frame_unref(m_frame);
+                if (got < 0) { error = "Conversion audio: " + avErrorString(got); return false; }
+                for (auto& ch : m_pending) ch.resize(static_cast<size_t>(got));
+                const uint64_t first = m_next;
+                m_next += static_cast<uint64_t>(got);
+                if (m_next <= m_target) { for (auto& ch : m_pending) ch.clear(); continue; }
+                m_pendingPos = first < m_target ? static_cast<size_t>(m_target - first) : 0;
+                if (m_pendingPos >= static_cast<size_t>(got)) continue;
+                return true;
+            }
+            if (r == AVERROR_EOF) { m_eof = true; return true; }
+            if (r != AVERROR(EAGAIN)) { error = "Décodage: " + avErrorString(r); return false; }
+            if (m_demuxEof) { avcodec_send_packet(m_dec, nullptr); continue; }
+            r = av_read_frame(m_fmt, m_pkt);
+            if (r < 0) { m_demuxEof = true; avcodec_send_packet(m_dec, nullptr); continue; }
+            if (m_pkt->stream_index == m_index) {
+                r = avcodec_send_packet(m_dec, m_pkt);
+                if (r < 0 && r != AVERROR(EAGAIN) && r != AVERROR_INVALIDDATA) {
+                    av_packet_unref(m_pkt);
+                    error = "Décodage: " + avErrorString(r);
+                    return false;
+                }
+            }
+            av_packet_unref(m_pkt);
+        }
+    }
+
+    AVFormatContext* m_fmt = nullptr;
+    AVCodecContext* m_dec = nullptr;
+    SwrContext* m_swr = nullptr;
+    AVPacket* m_pkt = nullptr;
+    AVFrame* m_frame = nullptr;
+    int m_index = -1;
+    uint32_t m_sampleRate = 0;
+    int m_channels = 1;
+    AVRational m_timeBase{1, 1};
+    int64_t m_startTs = 0;
+    uint64_t m_frames = 0;
+    uint64_t m_target = 0;     // premier échantillon voulu
+    uint64_t m_next = 0;       // index du prochain échantillon décodé
+    bool m_haveTs = false;
+    bool m_started = false;
+    bool m_eof = false;
+    bool m_demuxEof = false;
+    std::vector<std::vector<float>> m_pending;
+    size_t m_pendingPos = 0;
+};
+#endif // FFMPEG_AVAILABLE
+
+} // namespace
+
+std::unique_ptr<SampleSource> openSource(const std::string& path, std::string& error) {
+    auto pcm = std::make_unique<PcmSource>();
+    if (pcm->open(path)) return pcm;
+#ifdef FFMPEG_AVAILABLE
+    auto av = std::make_unique<FfmpegSource>();
+    if (av->open(path, error)) return av;
+    return nullptr;
+#else
+    error = "Format non pris en charge sans FFmpeg (WAV/W64 PCM uniquement)";
+    return nullptr;
+#endif
+}
+
+} // namespace AudioWaveform
@@ -0,0 +1,29 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace AudioWaveform {
+
+// Lecteur d'échantillons partagé par les vues d'édition (forme d'onde, spectrogramme)
+class SampleSource {
+public:
+    virtual ~SampleSource() = default;
+    virtual uint32_t sampleRate() const = 0;
+    virtual int channels() const = 0;             // 1 ou 2
+    virtual uint64_t frames() const = 0;          // longueur (0 si inconnue)
+    virtual bool exactLength() const = 0;         // false : estimation (durée du conteneur)
+    virtual bool seek(uint64_t frame, std::string& error) = 0;
+    // Jusqu'à maxFrames échantillons planaires; 0 en fin de flux
+    virtual size_t read(float* const* planar, size_t maxFrames, std::string& error) = 0;
+};
+
+// WAV/W64 PCM ou float lus directement (accès aléatoire exact), sinon FFmpeg si disponible
+std::unique_ptr<SampleSource> openSource(const std::string& path, std::string& error);
+
+} // namespace AudioWaveform
+
+#endif // __cplusplus
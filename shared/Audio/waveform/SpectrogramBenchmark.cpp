@@ -0,0 +1,165 @@
+#include "SpectrogramBenchmark.h"
+#include "../io/AudioFileWriter.h"
+#include "../utils/RealFFT.h"
+#include "../../PerformanceBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include <dirent.h>
+#include <unistd.h>
+
+namespace AudioWaveform {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Répertoire de cache du banc : fichiers des sous-répertoires puis répertoires
+void removeCacheDir(const std::string& dir) {
+    if (DIR* d = ::opendir(dir.c_str())) {
+        while (dirent* e = ::readdir(d)) {
+            const std::string name = e->d_name;
+            if (name == "." || name == "..") continue;
+            const std::string path = dir + "/" + name;
+            if (::unlink(path.c_str()) != 0) removeCacheDir(path);
+        }
+        ::closedir(d);
+    }
+    ::rmdir(dir.c_str());
+}
+
+bool writeClip(const std::string& path, const SpectrogramBenchmarkConfig& config, std::string& error) {
+    AudioIO::AudioFileWriterConfig wc;
+    wc.format = AudioIO::AudioFileFormat::WAV;
+    wc.sampleFormat = AudioIO::SampleFormat::Int16;
+    wc.sampleRate = config.sampleRate;
+    wc.numChannels = 2;
+    AudioIO::AudioFileWriter writer;
+    if (!writer.open(path, wc, error)) return false;
+
+    constexpr size_t kBlock = 4096;
+    std::vector<float> block(kBlock * 2);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.001f, 0.001f);
+    const uint64_t total = static_cast<uint64_t>(config.seconds * config.sampleRate);
+    const uint64_t halfQueue = static_cast<uint64_t>(wc.queueSeconds * wc.sampleRate / 2);
+    const double w = 2.0 * kPi * 1000.0 / config.sampleRate;
+    for (uint64_t frame = 0; frame < total; frame += kBlock) {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(kBlock, total - frame));
+        for (size_t i = 0; i < n; ++i) {
+            const float v = 0.5f * static_cast<float>(std::sin(w * static_cast<double>(frame + i)));
+            block[2 * i] = v + noise(rng);
+            block[2 * i + 1] = v + noise(rng);
+        }
+        for (;;) {
+            const AudioIO::AudioFileWriterStats s = writer.getStats();
+            if (s.framesQueued - s.framesWritten < halfQueue) break;
+            std::this_thread::yield();
+        }
+        writer.write(block.data(), n);
+    }
+    if (!writer.close()) { error = "Écriture du clip"; return false; }
+    return true;
+}
+
+} // namespace
+
+SpectrogramBenchmarkResult runSpectrogramBenchmark(const SpectrogramBenchmarkConfig& config) {
+    SpectrogramBenchmarkResult result;
+    const std::string clip = config.directory + "/naaya_spectrogram_bench.wav";
+    const std::string cacheDir = config.directory + "/naaya_spectrogram_bench_cache";
+    removeCacheDir(cacheDir);
+    if (!writeClip(clip, config, result.error)) return result;
+
+    SpectrogramConfig sc;
+    sc.cacheDir = cacheDir;
+    sc.parallel = config.parallel;
+    SpectrogramTiles tiles(sc);
+    result.fftSize = tiles.config().fftSize;
+
+    // FFT seule : une trame par appel, sans allocation
+    {
+        AudioEqualizer::RealFFT fft(result.fftSize);
+        std::vector<float> frame(result.fftSize);
+        std::vector<float> power(fft.numBins());
+        for (size_t i = 0; i < frame.size(); ++i) frame[i] = static_cast<float>(std::sin(0.01 * static_cast<double>(i)));
+        constexpr int kHops = 20000;
+        Performance::Benchmark bench("spectrogram fft");
+        {
+            BENCHMARK_SCOPE(bench);
+            for (int i = 0; i < kHops; ++i) {
+                frame[static_cast<size_t>(i) % frame.size()] += 1e-6f;
+                fft.powerSpectrum(frame.data(), power.data());
+            }
+        }
+        result.fftUsPerHop = bench.getAverageTime() * 1000.0 / kHops;
+    }
+
+    if (!tiles.open(clip, result.error)) return result;
+    for (int zoom : config.zooms) {
+        SpectrogramZoomResult z;
+        z.zoom = zoom;
+        z.samplesPerColumn = tiles.samplesPerColumn(zoom);
+        z.tiles = tiles.tileCount(zoom);
+        const auto start = std::chrono::steady_clock::now();
+        tiles.render(zoom, 0, z.tiles, result.error);
+        z.renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        z.realtimeFactor = z.renderSeconds > 0.0 ? config.seconds / z.renderSeconds : 0.0;
+        result.zooms.push_back(z);
+        if (!result.error.empty()) return result;
+    }
+
+    // Tuile du milieu servie par le cache; ligne du ton au centre de la tuile
+    const int zoom = config.zooms.empty() ? 0 : config.zooms.front();
+    const uint64_t count = tiles.tileCount(zoom);
+    const size_t width = sc.tileWidth;
+    const size_t height = sc.tileHeight;
+    std::vector<uint8_t> tile(width * height);
+    Performance::Benchmark cached("spectrogram cached tile");
+    for (uint64_t t = 0; t < std::min<uint64_t>(count, 64); ++t) {
+        BENCHMARK_SCOPE(cached);
+        if (!tiles.getTile(zoom, (count / 2 + t) % count, tile.data(), result.error)) return result;
+    }
+    result.cachedTileUs = cached.getAverageTime() * 1000.0;
+
+    if (!tiles.getTile(zoom, count / 2, tile.data(), result.error)) return result;
+    const size_t column = width / 2;
+    int best = 0;
+    for (size_t r = 1; r < height; ++r) {
+        if (tile[r * width + column] > tile[static_cast<size_t>(best) * width + column]) best = static_cast<int>(r);
+    }
+    const SpectrogramInfo info = tiles.getInfo();
+    const double band = static_cast<double>(height - 1 - static_cast<size_t>(best)) + 0.5;
+    result.toneRow = best;
+    result.toneHz = sc.minHz * std::pow(static_cast<double>(info.maxHz) / sc.minHz, band / height);
+    result.toneDb = sc.minDb + tile[static_cast<size_t>(best) * width + column] * (sc.maxDb - sc.minDb) / 255.0;
+    result.ok = std::fabs(result.toneHz - 1000.0) < 60.0 && std::fabs(result.toneDb + 6.0) < 2.0;
+
+    removeCacheDir(cacheDir);
+    ::unlink(clip.c_str());
+    return result;
+}
+
+void printSpectrogramBenchmark(const SpectrogramBenchmarkResult& result) {
+    std::cout << "\n=== Spectrogramme : tuiles 8 bits ===" << std::endl;
+    if (!result.error.empty()) std::cout << "erreur : " << result.error << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "FFT " << result.fftSize << " : " << result.fftUsPerHop << " us / trame" << std::endl;
+    std::cout << std::setw(6) << "zoom" << std::setw(10) << "hop" << std::setw(8) << "tuiles"
+              << std::setw(10) << "s" << std::setw(10) << "x RT" << std::endl;
+    for (const auto& z : result.zooms) {
+        std::cout << std::setw(6) << z.zoom << std::setw(10) << z.samplesPerColumn << std::setw(8) << z.tiles
+                  << std::setprecision(2) << std::setw(10) << z.renderSeconds
+                  << std::setprecision(0) << std::setw(10) << z.realtimeFactor << std::endl;
+    }
+    std::cout << std::setprecision(1) << "tuile en cache : " << result.cachedTileUs << " us" << std::endl;
+    std::cout << "ton 1 kHz : ligne " << result.toneRow << " (" << std::setprecision(0) << result.toneHz << " Hz, "
+              << std::setprecision(1) << result.toneDb << " dB) " << (result.ok ? "OK" : "ÉCHEC") << std::endl;
+}
+
+} // namespace AudioWaveform
@@ -0,0 +1,45 @@
+#pragma once
+
+#ifdef __cplusplus
+#include "SpectrogramTiles.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AudioWaveform {
+
+struct SpectrogramBenchmarkConfig {
+    std::string directory = "/tmp";
+    uint32_t sampleRate = 48000;
+    double seconds = 600.0;             // clip synthétique (ton 1 kHz à -6 dBFS + bruit)
+    std::vector<int> zooms{0, 2, 4};
+    bool parallel = true;
+};
+
+struct SpectrogramZoomResult {
+    int zoom = 0;
+    uint32_t samplesPerColumn = 0;
+    uint64_t tiles = 0;
+    double renderSeconds = 0.0;         // toutes les tuiles du zoom, cache vide
+    double realtimeFactor = 0.0;        // durée du clip / temps de rendu
+};
+
+struct SpectrogramBenchmarkResult {
+    bool ok = false;
+    std::string error;
+    double fftUsPerHop = 0.0;           // powerSpectrum() seul, un thread
+    size_t fftSize = 0;
+    std::vector<SpectrogramZoomResult> zooms;
+    double cachedTileUs = 0.0;          // getTile() servi par le cache disque
+    int toneRow = -1;                   // ligne la plus forte, attendue près de 1 kHz
+    double toneHz = 0.0;                // fréquence centrale de cette ligne
+    double toneDb = 0.0;                // niveau relu (attendu -6 dB à la quantification près)
+};
+
+SpectrogramBenchmarkResult runSpectrogramBenchmark(const SpectrogramBenchmarkConfig& config = {});
+void printSpectrogramBenchmark(const SpectrogramBenchmarkResult& result);
+
+} // namespace AudioWaveform
+
+#endif // __cplusplus
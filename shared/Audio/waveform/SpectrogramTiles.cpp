@@ -0,0 +1,402 @@
+#include "SpectrogramTiles.h"
+#include "AudioSource.h"
+#include "../utils/RealFFT.h"
+#include "../../Common/TaskScheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace AudioWaveform {
+
+namespace {
+
+constexpr size_t kReadFrames = 4096;
+constexpr size_t kFingerprintBytes = 64 * 1024;
+
+// FNV-1a 64 bits
+struct Fnv64 {
+    uint64_t h = 1469598103934665603ull;
+    void add(const void* data, size_t n) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    }
+    template <typename T> void add(const T& v) { add(&v, sizeof(v)); }
+};
+
+// Fenêtres successives (débuts croissants) d'une source, canaux fusionnés.
+// Lecture séquentielle dans un tampon de N + kReadFrames échantillons, recherche seulement
+// en cas de trou ou de retour en arrière.
+class FrameReader {
+public:
+    FrameReader(SampleSource& source, size_t frameSize)
+        : m_source(source), m_frameSize(frameSize), m_buf(frameSize + kReadFrames, 0.0f) {
+        m_planar[0].resize(kReadFrames);
+        m_planar[1].resize(kReadFrames);
+    }
+
+    // out[i] = échantillon start + i, 0 hors de la source
+    bool read(int64_t start, float* out, std::string& error) {
+        const size_t lead = start < 0 ? static_cast<size_t>(std::min<int64_t>(-start, static_cast<int64_t>(m_frameSize))) : 0;
+        std::fill(out, out + lead, 0.0f);
+        const size_t need = m_frameSize - lead;
+        if (need == 0) return true;
+        const uint64_t s = static_cast<uint64_t>(start + static_cast<int64_t>(lead));
+
+        if (s < m_bufStart) {
+            if (!reposition(s, error)) return false;
+        } else {
+            const size_t drop = static_cast<size_t>(std::min<uint64_t>(s - m_bufStart, m_len));
+            m_head += drop; m_len -= drop; m_bufStart += drop;
+            if (m_len == 0 && s > m_bufStart && !reposition(s, error)) return false;
+        }
+
+        while (m_len < need && !m_eof) {
+            if (m_head + m_len + kReadFrames > m_buf.size()) {
+                std::memmove(m_buf.data(), m_buf.data() + m_head, m_len * sizeof(float));
+                m_head = 0;
+            }
+            float* planar[2] = {m_planar[0].data(), m_planar[1].data()};
+            const size_t got = m_source.read(planar, kReadFrames, error);
+            if (got == 0) {
+                if (!error.empty()) return false;
+                m_eof = true;
+                break;
+            }
+            float* dst = m_buf.data() + m_head + m_len;
+            if (m_source.channels() == 2) {
+                const float* l = planar[0];
+                const float* r = planar[1];
+                for (size_t i = 0; i < got; ++i) dst[i] = 0.5f * (l[i] + r[i]);
+            } else {
+                std::memcpy(dst, planar[0], got * sizeof(float));
+            }
+            m_len += got;
+        }
+        const size_t avail = std::min(m_len, need);
+        std::memcpy(out + lead, m_buf.data() + m_head, avail * sizeof(float));
+        std::fill(out + lead + avail, out + m_frameSize, 0.0f);
+        return true;
+    }
+
+private:
+    bool reposition(uint64_t frame, std::string& error) {
+        if (!m_source.seek(frame, error)) return false;
+        m_head = 0;
+        m_len = 0;
+        m_bufStart = frame;
+        m_eof = false;
+        return true;
+    }
+
+    SampleSource& m_source;
+    size_t m_frameSize;
+    std::vector<float> m_buf;
+    std::vector<float> m_planar[2];
+    size_t m_head = 0;              // m_buf[m_head, m_head + m_len) = [m_bufStart, ...)
+    size_t m_len = 0;
+    uint64_t m_bufStart = 0;
+    bool m_eof = false;
+};
+
+// log2 de x > 0 normal : exposant + série atanh sur la mantisse (erreur < 1e-4 dB),
+// sans appel de bibliothèque pour que la boucle des lignes se vectorise
+inline float fastLog2(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const float e = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+    bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    const float t = (m - 1.0f) / (m + 1.0f);
+    const float t2 = t * t;
+    return e + t * (2.8853901f + t2 * (0.9617967f + t2 * (0.5770780f + t2 * 0.4121986f)));
+}
+
+std::string hex64(uint64_t v) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+    return buf;
+}
+
+} // namespace
+
+SpectrogramTiles::SpectrogramTiles(const SpectrogramConfig& config) : m_config(config) {
+    AudioEqualizer::RealFFT probe(config.fftSize);   // taille effective (puissance de deux)
+    m_config.fftSize = probe.size();
+    m_config.tileWidth = std::max<size_t>(1, std::min<size_t>(config.tileWidth, 4096));
+    m_config.tileHeight = std::max<size_t>(1, std::min<size_t>(config.tileHeight, 4096));
+    uint32_t hop = 1;
+    while (hop < config.baseHop && hop < (1u << 16)) hop <<= 1;
+    m_config.baseHop = hop;
+    m_config.minHz = std::max(1.0f, config.minHz);
+    m_config.maxHz = std::max(m_config.minHz * 2.0f, config.maxHz);
+    if (!(config.maxDb > config.minDb)) { m_config.minDb = -100.0f; m_config.maxDb = 0.0f; }
+}
+
+bool SpectrogramTiles::open(const std::string& sourcePath, std::string& error) {
+    auto source = openSource(sourcePath, error);
+    if (!source) {
+        if (error.empty()) error = "Source illisible";
+        return false;
+    }
+
+    Source next;
+    next.path = sourcePath;
+    next.info.sampleRate = source->sampleRate();
+    next.info.channels = source->channels();
+    next.info.frames = source->frames();
+
+    // Empreinte : métadonnées, début et fin du fichier, réglages qui changent les pixels
+    Fnv64 fnv;
+    const int fd = ::open(sourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { error = "Ouverture impossible: " + std::string(std::strerror(errno)); return false; }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) { ::close(fd); error = "stat impossible"; return false; }
+    fnv.add(static_cast<uint64_t>(st.st_size));
+    fnv.add(static_cast<int64_t>(st.st_mtime));
+    fnv.add(static_cast<uint64_t>(st.st_ino));
+    std::vector<uint8_t> chunk(kFingerprintBytes);
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+    const uint64_t tail = size > kFingerprintBytes ? size - kFingerprintBytes : 0;
+    for (uint64_t off : {uint64_t(0), tail}) {
+        const ssize_t got = ::pread(fd, chunk.data(), chunk.size(), static_cast<off_t>(off));
+        if (got > 0) fnv.add(chunk.data(), static_cast<size_t>(got));
+    }
+    ::close(fd);
+    fnv.add(static_cast<uint64_t>(m_config.tileWidth));
+    fnv.add(static_cast<uint64_t>(m_config.tileHeight));
+    fnv.add(static_cast<uint64_t>(m_config.fftSize));
+    fnv.add(m_config.baseHop);
+    fnv.add(m_config.minHz);
+    fnv.add(m_config.maxHz);
+    fnv.add(m_config.minDb);
+    fnv.add(m_config.maxDb);
+    next.info.cacheKey = hex64(fnv.h);
+
+    // Bandes log : ligne 0 = aigu
+    const size_t N = m_config.fftSize;
+    const size_t H = m_config.tileHeight;
+    const double sr = static_cast<double>(next.info.sampleRate);
+    const double fMin = m_config.minHz;
+    const double fMax = std::max(fMin * 2.0, std::min<double>(m_config.maxHz, sr * 0.5));
+    next.info.maxHz = static_cast<float>(fMax);
+    const double ratio = fMax / fMin;
+    const double binHz = sr / static_cast<double>(N);
+    const uint32_t lastBin = static_cast<uint32_t>(N / 2);
+    next.bands.resize(H);
+    for (size_t i = 0; i < H; ++i) {
+        const double lo = fMin * std::pow(ratio, static_cast<double>(i) / H) / binHz;
+        const double hi = fMin * std::pow(ratio, static_cast<double>(i + 1) / H) / binHz;
+        const uint32_t first = static_cast<uint32_t>(std::ceil(lo));
+        const uint32_t last = std::min(lastBin, static_cast<uint32_t>(std::floor(hi)));
+        RowBand band{};
+        if (last >= first + 1) {
+            band.bin = first;
+            band.count = last - first + 1;
+        } else {
+            const double center = std::min<double>(std::sqrt(lo * hi), lastBin - 1);
+            band.bin = static_cast<uint32_t>(center);
+            band.count = 0;
+            band.frac = static_cast<float>(center - band.bin);
+        }
+        next.bands[H - 1 - i] = band;
+    }
+    // Hann : |X| = A N / 4 pour un sinus d'amplitude A
+    next.powerScale = 16.0f / (static_cast<float>(N) * static_cast<float>(N));
+
+    if (!m_config.cacheDir.empty()) {
+        ::mkdir(m_config.cacheDir.c_str(), 0755);
+        ::mkdir((m_config.cacheDir + "/" + next.info.cacheKey).c_str(), 0755);
+    }
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_source = std::move(next);
+    return true;
+}
+
+SpectrogramInfo SpectrogramTiles::getInfo() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_source.info;
+}
+
+SpectrogramTiles::Source SpectrogramTiles::current() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_source;
+}
+
+uint32_t SpectrogramTiles::samplesPerColumn(int zoom) const {
+    return m_config.baseHop << std::max(0, std::min(zoom, kMaxSpectrogramZoom));
+}
+
+uint64_t SpectrogramTiles::tileCount(int zoom) const {
+    const uint64_t frames = getInfo().frames;
+    const uint64_t hop = samplesPerColumn(zoom);
+    const uint64_t columns = (frames + hop - 1) / hop;
+    return (columns + m_config.tileWidth - 1) / m_config.tileWidth;
+}
+
+std::string SpectrogramTiles::tilePath(const Source& source, int zoom, uint64_t index) const {
+    return m_config.cacheDir + "/" + source.info.cacheKey + "/z" + std::to_string(zoom) + "_" + std::to_string(index) + ".u8";
+}
+
+bool SpectrogramTiles::readCached(const std::string& path, uint8_t* out) const {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    const size_t bytes = m_config.tileWidth * m_config.tileHeight;
+    const bool ok = ::pread(fd, out, bytes, 0) == static_cast<ssize_t>(bytes);
+    ::close(fd);
+    return ok;
+}
+
+// Fichier temporaire puis rename : jamais de tuile partielle visible
+void SpectrogramTiles::writeCached(const std::string& path, const uint8_t* data) const {
+    std::string tmp = path.substr(0, path.find_last_of('/') + 1) + ".tileXXXXXX";
+    const int fd = ::mkstemp(&tmp[0]);
+    if (fd < 0) return;
+    const size_t bytes = m_config.tileWidth * m_config.tileHeight;
+    const bool ok = ::write(fd, data, bytes) == static_cast<ssize_t>(bytes);
+    ::close(fd);
+    if (!ok || ::rename(tmp.c_str(), path.c_str()) != 0) ::unlink(tmp.c_str());
+}
+
+bool SpectrogramTiles::computeTile(const Source& source, int zoom, uint64_t index, uint8_t* out, std::string& error) const {
+    const size_t W = m_config.tileWidth;
+    const size_t H = m_config.tileHeight;
+    const size_t N = m_config.fftSize;
+    std::memset(out, 0, W * H);
+
+    auto reader = openSource(source.path, error);
+    if (!reader) {
+        if (error.empty()) error = "Source illisible";
+        return false;
+    }
+
+    // Tampons alloués une fois par tuile
+    AudioEqualizer::RealFFT fft(N);
+    FrameReader frames(*reader, N);
+    std::vector<float> frame(N);
+    std::vector<float> power(fft.numBins());
+    std::vector<float> accum(fft.numBins());
+    std::vector<float> rows(H);
+
+    const uint64_t hop = samplesPerColumn(zoom);
+    const size_t perColumn = hop >= N ? static_cast<size_t>(hop / N) : 1;
+    const float dbScale = 255.0f / (m_config.maxDb - m_config.minDb);
+    const uint64_t firstColumn = index * W;
+    const uint64_t totalFrames = source.info.frames;
+
+    for (size_t c = 0; c < W; ++c) {
+        const uint64_t colStart = (firstColumn + c) * hop;
+        if (totalFrames > 0 && colStart >= totalFrames) break;
+        const float* p = power.data();
+        if (perColumn == 1) {
+            const int64_t start = static_cast<int64_t>(colStart + hop / 2) - static_cast<int64_t>(N / 2);
+            if (!frames.read(start, frame.data(), error)) return false;
+            fft.powerSpectrum(frame.data(), power.data());
+        } else {
+            std::fill(accum.begin(), accum.end(), 0.0f);
+            for (size_t j = 0; j < perColumn; ++j) {
+                if (!frames.read(static_cast<int64_t>(colStart + j * N), frame.data(), error)) return false;
+                fft.powerSpectrum(frame.data(), power.data());
+                for (size_t k = 0; k < accum.size(); ++k) accum[k] += power[k];
+            }
+            const float inv = 1.0f / static_cast<float>(perColumn);
+            for (size_t k = 0; k < accum.size(); ++k) accum[k] *= inv;
+            p = accum.data();
+        }
+
+        for (size_t r = 0; r < H; ++r) {
+            const RowBand& band = source.bands[r];
+            if (band.count == 0) {
+                rows[r] = p[band.bin] + (p[band.bin + 1] - p[band.bin]) * band.frac;
+            } else {
+                float sum = 0.0f;
+                for (uint32_t k = 0; k < band.count; ++k) sum += p[band.bin + k];
+                rows[r] = sum / static_cast<float>(band.count);
+            }
+        }
+        // 10 log10(v) = (10 log10 2) log2(v); le plancher garde v normal
+        for (size_t r = 0; r < H; ++r) {
+            const float db = 3.0103000f * fastLog2(rows[r] * source.powerScale + 1e-20f);
+            const float q = (db - m_config.minDb) * dbScale;
+            out[r * W + c] = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, q + 0.5f)));
+        }
+    }
+    return true;
+}
+
+bool SpectrogramTiles::getTile(int zoom, uint64_t index, uint8_t* out, std::string& error) {
+    const Source source = current();
+    if (source.path.empty()) { error = "Source non ouverte"; return false; }
+    if (zoom < 0 || zoom > kMaxSpectrogramZoom || index >= tileCount(zoom)) { error = "Tuile hors limites"; return false; }
+    const bool cached = !m_config.cacheDir.empty();
+    const std::string path = cached ? tilePath(source, zoom, index) : std::string();
+    if (cached && readCached(path, out)) return true;
+    if (!computeTile(source, zoom, index, out, error)) return false;
+    if (cached) writeCached(path, out);
+    return true;
+}
+
+struct SpectrogramTiles::RenderJob {
+    const SpectrogramTiles* self;
+    const Source* source;
+    int zoom;
+    std::vector<uint64_t> tiles;
+    std::atomic<size_t> done{0};
+    std::mutex errorMutex;
+    std::string error;
+};
+
+void SpectrogramTiles::renderTileTask(void* context, size_t i) {
+    auto& job = *static_cast<RenderJob*>(context);
+    const Source& source = *job.source;
+    const SpectrogramTiles& self = *job.self;
+    std::vector<uint8_t> tile(self.m_config.tileWidth * self.m_config.tileHeight);
+    std::string error;
+    if (self.computeTile(source, job.zoom, job.tiles[i], tile.data(), error)) {
+        self.writeCached(self.tilePath(source, job.zoom, job.tiles[i]), tile.data());
+        job.done.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        std::lock_guard<std::mutex> lk(job.errorMutex);
+        if (job.error.empty()) job.error = error;
+    }
+}
+
+size_t SpectrogramTiles::render(int zoom, uint64_t first, uint64_t count, std::string& error) {
+    const Source source = current();
+    if (source.path.empty()) { error = "Source non ouverte"; return 0; }
+    if (m_config.cacheDir.empty()) { error = "Pas de répertoire de cache"; return 0; }
+    if (zoom < 0 || zoom > kMaxSpectrogramZoom) { error = "Zoom hors limites"; return 0; }
+    const uint64_t total = tileCount(zoom);
+    const uint64_t end = first < total ? first + std::min(count, total - first) : first;
+
+    RenderJob job;
+    job.self = this;
+    job.source = &source;
+    job.zoom = zoom;
+    for (uint64_t t = first; t < end; ++t) {
+        if (::access(tilePath(source, zoom, t).c_str(), F_OK) != 0) job.tiles.push_back(t);
+    }
+    if (job.tiles.empty()) return 0;
+
+    // Ordonnanceur partagé, priorité basse : l'aperçu caméra passe avant les tuiles
+    auto range = [&job](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) renderTileTask(&job, i);
+    };
+    if (m_config.parallel && job.tiles.size() > 1) {
+        Common::TaskScheduler::shared().parallelFor(job.tiles.size(), range, Common::TaskPriority::Background, 1);
+    } else {
+        range(0, job.tiles.size());
+    }
+    if (!job.error.empty()) error = job.error;
+    return job.done.load();
+}
+
+} // namespace AudioWaveform
@@ -0,0 +1,103 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AudioWaveform {
+
+constexpr int kMaxSpectrogramZoom = 12;
+
+struct SpectrogramConfig {
+    size_t tileWidth = 256;         // colonnes (temps)
+    size_t tileHeight = 256;        // lignes (fréquence log, ligne 0 = maxHz)
+    size_t fftSize = 2048;
+    uint32_t baseHop = 128;         // échantillons par colonne au zoom 0, doublés à chaque zoom
+    float minHz = 20.0f;
+    float maxHz = 20000.0f;         // borné à Nyquist
+    float minDb = -100.0f;          // -> 0
+    float maxDb = 0.0f;             // -> 255 (0 dB = sinus pleine échelle)
+    std::string cacheDir;           // vide : pas de cache disque
+    bool parallel = true;           // sur TaskScheduler::shared(), sinon sur le thread appelant
+};
+
+struct SpectrogramInfo {
+    uint32_t sampleRate = 0;
+    int channels = 0;
+    uint64_t frames = 0;
+    float maxHz = 0.0f;             // borne haute effective
+    std::string cacheKey;           // empreinte source + réglages (hex)
+};
+
+// Spectrogramme en tuiles 8 bits pour l'éditeur (canaux fusionnés).
+//
+// Colonne c du zoom z : échantillons [c hop, (c + 1) hop), hop = baseHop << z. Une trame
+// FFT centrée par colonne tant que hop < fftSize, sinon hop / fftSize trames contiguës dont
+// la puissance est moyennée. Lignes réparties en log entre minHz et maxHz : interpolation
+// entre cases FFT dans le grave, moyenne des cases couvertes dans l'aigu. dB quantifiés
+// linéairement sur [minDb, maxDb].
+//
+// Les tuiles (tileHeight lignes de tileWidth octets) sont rangées dans
+// cacheDir/<clé>/z<zoom>_<index>.u8; la clé hache taille, date, inode, premiers et derniers
+// 64 Kio de la source ainsi que les réglages : une source modifiée change de répertoire.
+// render() calcule les tuiles manquantes en parallèle (une tuile par tâche, lecture
+// séquentielle de sa plage); la FFT ne fait aucune allocation par trame.
+class SpectrogramTiles {
+public:
+    explicit SpectrogramTiles(const SpectrogramConfig& config = {});
+
+    SpectrogramTiles(const SpectrogramTiles&) = delete;
+    SpectrogramTiles& operator=(const SpectrogramTiles&) = delete;
+
+    // Sonde la source et calcule la clé du cache (à rappeler si le fichier a changé)
+    bool open(const std::string& sourcePath, std::string& error);
+
+    SpectrogramInfo getInfo() const;
+    const SpectrogramConfig& config() const { return m_config; }
+
+    uint32_t samplesPerColumn(int zoom) const;
+    uint64_t tileCount(int zoom) const;
+
+    // Tuile (tileWidth x tileHeight octets) : cache disque, sinon calculée sur l'appelant
+    bool getTile(int zoom, uint64_t index, uint8_t* out, std::string& error);
+
+    // Calcule en parallèle les tuiles absentes de [first, first + count); retourne le
+    // nombre de tuiles calculées
+    size_t render(int zoom, uint64_t first, uint64_t count, std::string& error);
+
+private:
+    struct RowBand {
+        uint32_t bin;               // première case
+        uint32_t count;             // 0 : interpolation entre bin et bin + 1
+        float frac;
+    };
+
+    // Copie prise sous verrou par chaque calcul : open() peut être rappelé en parallèle
+    struct Source {
+        std::string path;
+        SpectrogramInfo info;
+        std::vector<RowBand> bands;
+        float powerScale = 1.0f;    // sinus pleine échelle -> 1
+    };
+
+    struct RenderJob;
+
+    Source current() const;
+    bool computeTile(const Source& source, int zoom, uint64_t index, uint8_t* out, std::string& error) const;
+    std::string tilePath(const Source& source, int zoom, uint64_t index) const;
+    bool readCached(const std::string& path, uint8_t* out) const;
+    void writeCached(const std::string& path, const uint8_t* data) const;
+
+    static void renderTileTask(void* context, size_t i);
+
+    SpectrogramConfig m_config;
+    mutable std::mutex m_mutex;
+    Source m_source;
+};
+
+} // namespace AudioWaveform
+
+#endif // __cplusplus
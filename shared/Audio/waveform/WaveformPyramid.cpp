@@ -0,0 +1,475 @@
+#include "WaveformPyramid.h"
+#include "AudioSource.h"
+#include "../../Common/TaskScheduler.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace AudioWaveform {
+
+namespace {
+
+constexpr uint32_t kVersion = 1;
+constexpr size_t kPage = 4096;
+constexpr size_t kReadFrames = 8192;
+constexpr double kMinCapacitySeconds = 60.0;
+
+// En-tête du fichier annexe (cibles little-endian); niveaux alignés sur une page
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t sampleRate;
+    uint32_t channels;
+    uint32_t numLevels;
+    uint32_t reserved;
+    uint32_t samplesPerBucket[kMaxLevels];
+    uint64_t frames;            // couverts, publié après les cases
+    uint64_t sourceInode;
+    uint64_t sourceSize;
+    uint64_t capacityFrames;
+    uint64_t offset[kMaxLevels];
+};
+static_assert(sizeof(CacheHeader) <= kPage, "en-tête sur une page");
+
+constexpr char kMagic[4] = {'N', 'W', 'F', 'P'};
+
+uint64_t bucketCount(uint64_t frames, uint32_t spb) { return (frames + spb - 1) / spb; }
+
+// Octets d'un niveau : 3 int16 (min, max, rms) par case et par canal
+size_t levelBytes(uint64_t capacityFrames, uint32_t spb, int channels) {
+    const size_t bytes = static_cast<size_t>(bucketCount(capacityFrames, spb)) * static_cast<size_t>(channels) * 3 * sizeof(int16_t);
+    return (bytes + kPage - 1) / kPage * kPage;
+}
+
+size_t layout(CacheHeader& h) {
+    size_t offset = kPage;
+    for (uint32_t l = 0; l < h.numLevels; ++l) {
+        h.offset[l] = offset;
+        offset += levelBytes(h.capacityFrames, h.samplesPerBucket[l], static_cast<int>(h.channels));
+    }
+    return offset;
+}
+
+int16_t quantize(float v) {
+    return static_cast<int16_t>(std::lrint(std::max(-1.0f, std::min(1.0f, v)) * 32767.0f));
+}
+
+// ===== Réduction =====
+
+struct Accum {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    double sumSq = 0.0;
+    uint32_t count = 0;
+
+    void merge(const Accum& o) {
+        min = std::min(min, o.min);
+        max = std::max(max, o.max);
+        sumSq += o.sumSq;
+        count += o.count;
+    }
+};
+
+// Segment [start, start + frames) : cases de chaque niveau, [case * canaux + canal]
+struct SegmentResult {
+    uint64_t start = 0;
+    uint64_t expected = 0;          // 0 : jusqu'à la fin du flux
+    uint64_t frames = 0;
+    std::vector<std::vector<Accum>> levels;
+    std::string error;
+};
+
+struct SegmentJob {
+    const std::string* path;
+    const std::vector<uint32_t>* spb;
+    int channels;
+    std::vector<SegmentResult>* results;
+};
+
+void reduceSegmentTask(void* context, size_t s) {
+    auto& job = *static_cast<SegmentJob*>(context);
+    SegmentResult& res = (*job.results)[s];
+    const size_t ch = static_cast<size_t>(job.channels);
+    const uint32_t fine = (*job.spb)[0];
+
+    std::string error;
+    auto source = openSource(*job.path, error);
+    if (!source || !source->seek(res.start, error)) {
+        res.error = error.empty() ? "Source illisible" : error;
+        return;
+    }
+
+    std::vector<float> buf[2] = {std::vector<float>(kReadFrames), std::vector<float>(kReadFrames)};
+    float* planar[2] = {buf[0].data(), buf[1].data()};
+    std::vector<Accum>& level0 = res.levels[0];
+    if (res.expected > 0) level0.reserve(static_cast<size_t>(bucketCount(res.expected, fine)) * ch);
+    Accum cur[2];
+    uint64_t limit = res.expected > 0 ? res.expected : std::numeric_limits<uint64_t>::max();
+    while (res.frames < limit) {
+        const size_t want = static_cast<size_t>(std::min<uint64_t>(kReadFrames, limit - res.frames));
+        const size_t n = source->read(planar, want, error);
+        if (n == 0) break;
+        size_t i = 0;
+        while (i < n) {
+            // Jusqu'à la fin de la case courante
+            const uint32_t inBucket = cur[0].count;
+            const size_t take = std::min<size_t>(n - i, fine - inBucket);
+            for (size_t c = 0; c < ch; ++c) {
+                const float* x = planar[c] + i;
+                float mn = cur[c].min, mx = cur[c].max;
+                double sq = 0.0;
+                for (size_t k = 0; k < take; ++k) {
+                    mn = std::min(mn, x[k]);
+                    mx = std::max(mx, x[k]);
+                    sq += static_cast<double>(x[k]) * x[k];
+                }
+                cur[c].min = mn; cur[c].max = mx; cur[c].sumSq += sq;
+                cur[c].count += static_cast<uint32_t>(take);
+            }
+            i += take;
+            if (cur[0].count == fine) {
+                for (size_t c = 0; c < ch; ++c) { level0.push_back(cur[c]); cur[c] = Accum{}; }
+            }
+        }
+        res.frames += n;
+    }
+    if (!error.empty()) res.error = error;
+    if (cur[0].count > 0) {
+        for (size_t c = 0; c < ch; ++c) level0.push_back(cur[c]);
+    }
+
+    // Niveaux supérieurs déduits du niveau fin (segments alignés sur le niveau le plus grossier)
+    for (size_t l = 1; l < job.spb->size(); ++l) {
+        const size_t ratio = (*job.spb)[l] / (*job.spb)[l - 1];
+        const std::vector<Accum>& src = res.levels[l - 1];
+        std::vector<Accum>& dst = res.levels[l];
+        const size_t srcBuckets = src.size() / ch;
+        dst.resize(((srcBuckets + ratio - 1) / ratio) * ch);
+        for (size_t b = 0; b < srcBuckets; ++b) {
+            for (size_t c = 0; c < ch; ++c) dst[(b / ratio) * ch + c].merge(src[b * ch + c]);
+        }
+    }
+}
+
+} // namespace
+
+// ===== Projection du fichier annexe =====
+
+struct WaveformPyramid::Mapping {
+    int fd = -1;
+    uint8_t* base = nullptr;
+    size_t size = 0;
+
+    ~Mapping() {
+        if (base) ::munmap(base, size);
+        if (fd >= 0) ::close(fd);
+    }
+    CacheHeader* header() const { return reinterpret_cast<CacheHeader*>(base); }
+    int16_t* level(size_t l) const { return reinterpret_cast<int16_t*>(base + header()->offset[l]); }
+};
+
+WaveformPyramid::WaveformPyramid(const WaveformConfig& config) : m_config(config) {
+    // Niveaux croissants, chacun multiple du précédent, au plus kMaxLevels
+    std::vector<uint32_t> spb;
+    for (uint32_t v : config.samplesPerBucket) {
+        if (v == 0 || spb.size() == kMaxLevels) continue;
+        if (spb.empty() || (v > spb.back() && v % spb.back() == 0)) spb.push_back(v);
+    }
+    if (spb.empty()) spb = {256, 2048, 16384};
+    m_config.samplesPerBucket = spb;
+    m_config.segmentSeconds = std::max(1.0, config.segmentSeconds);
+}
+
+WaveformPyramid::~WaveformPyramid() = default;
+
+void WaveformPyramid::closeMapping() {
+    m_map.reset();
+}
+
+bool WaveformPyramid::openMapping(const std::string& path, uint32_t sampleRate, int channels, uint64_t minFrames,
+                                  uint64_t sourceInode, uint64_t sourceSize, uint64_t& resumeFrame, std::string& error) {
+    const auto& spb = m_config.samplesPerBucket;
+    auto compatible = [&](const CacheHeader& h, uint64_t fileSize) {
+        if (std::memcmp(h.magic, kMagic, 4) != 0 || h.version != kVersion || h.sampleRate != sampleRate ||
+            h.channels != static_cast<uint32_t>(channels) || h.numLevels != spb.size() ||
+            h.sourceInode != sourceInode || h.sourceSize > sourceSize || h.frames > h.capacityFrames) return false;
+        for (size_t l = 0; l < spb.size(); ++l) if (h.samplesPerBucket[l] != spb[l]) return false;
+        CacheHeader copy = h;
+        return layout(copy) <= fileSize && std::memcmp(copy.offset, h.offset, sizeof(h.offset)) == 0;
+    };
+
+    if (m_map && m_cachePath == path && compatible(*m_map->header(), m_map->size)) {
+        resumeFrame = m_map->header()->frames / spb.back() * spb.back();
+        return true;
+    }
+    closeMapping();
+    m_cachePath = path;
+
+    // Cache existant
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd >= 0) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= kPage) {
+            void* base = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (base != MAP_FAILED) {
+                auto map = std::make_unique<Mapping>();
+                map->fd = fd;
+                map->base = static_cast<uint8_t*>(base);
+                map->size = static_cast<size_t>(st.st_size);
+                if (compatible(*map->header(), map->size)) {
+                    m_map = std::move(map);
+                    resumeFrame = m_map->header()->frames / spb.back() * spb.back();
+                    return true;
+                }
+                // incompatible : Mapping ferme fd
+            } else {
+                ::close(fd);
+            }
+        } else {
+            ::close(fd);
+        }
+    }
+
+    // Nouveau cache
+    CacheHeader h{};
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.sampleRate = sampleRate;
+    h.channels = static_cast<uint32_t>(channels);
+    h.numLevels = static_cast<uint32_t>(spb.size());
+    for (size_t l = 0; l < spb.size(); ++l) h.samplesPerBucket[l] = spb[l];
+    h.sourceInode = sourceInode;
+    h.capacityFrames = std::max<uint64_t>(minFrames, static_cast<uint64_t>(kMinCapacitySeconds * sampleRate));
+    const size_t total = layout(h);
+
+    const int nfd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (nfd < 0) { error = "Cache impossible à créer: " + path + " (" + std::strerror(errno) + ")"; return false; }
+    auto map = std::make_unique<Mapping>();
+    map->fd = nfd;
+    if (::ftruncate(nfd, static_cast<off_t>(total)) != 0) { error = "Cache: espace insuffisant"; return false; }
+    void* base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, nfd, 0);
+    if (base == MAP_FAILED) { error = "Cache: mmap impossible"; return false; }
+    map->base = static_cast<uint8_t*>(base);
+    map->size = total;
+    std::memcpy(map->base, &h, sizeof(h));
+    m_map = std::move(map);
+    resumeFrame = 0;
+    return true;
+}
+
+// Appelant : m_mapMutex exclusif. Agrandit en réécrivant le fichier (capacité doublée).
+bool WaveformPyramid::ensureCapacity(uint64_t frames, std::string& error) {
+    const CacheHeader& old = *m_map->header();
+    if (frames <= old.capacityFrames) return true;
+
+    CacheHeader h = old;
+    h.capacityFrames = std::max(frames, old.capacityFrames * 2);
+    const size_t total = layout(h);
+    const std::string tmp = m_cachePath + ".tmp";
+    const int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) { error = "Cache: agrandissement impossible"; return false; }
+    auto map = std::make_unique<Mapping>();
+    map->fd = fd;
+    if (::ftruncate(fd, static_cast<off_t>(total)) != 0) { ::unlink(tmp.c_str()); error = "Cache: espace insuffisant"; return false; }
+    void* base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) { ::unlink(tmp.c_str()); error = "Cache: mmap impossible"; return false; }
+    map->base = static_cast<uint8_t*>(base);
+    map->size = total;
+    std::memcpy(map->base, &h, sizeof(h));
+    for (uint32_t l = 0; l < h.numLevels; ++l) {
+        const size_t used = static_cast<size_t>(bucketCount(old.frames, h.samplesPerBucket[l])) * h.channels * 3;
+        std::memcpy(map->level(l), m_map->level(l), used * sizeof(int16_t));
+    }
+    ::msync(map->base, total, MS_SYNC);
+    if (::rename(tmp.c_str(), m_cachePath.c_str()) != 0) { ::unlink(tmp.c_str()); error = "Cache: remplacement impossible"; return false; }
+    m_map = std::move(map);
+    return true;
+}
+
+bool WaveformPyramid::update(const std::string& sourcePath, const std::string& cachePath, std::string& error) {
+    std::lock_guard<std::mutex> updateLock(m_updateMutex);
+    const std::string path = cachePath.empty() ? sourcePath + ".wfp" : cachePath;
+
+    struct stat st;
+    if (::stat(sourcePath.c_str(), &st) != 0) { error = "Source introuvable: " + sourcePath; return false; }
+    auto probe = openSource(sourcePath, error);
+    if (!probe) return false;
+    const uint32_t sr = probe->sampleRate();
+    const int ch = probe->channels();
+    const uint64_t known = probe->frames();
+    const bool exact = probe->exactLength();
+    probe.reset();
+
+    const auto& spb = m_config.samplesPerBucket;
+    const uint64_t top = spb.back();
+    uint64_t resume = 0;
+    {
+        std::unique_lock<std::shared_mutex> lk(m_mapMutex);
+        if (!openMapping(path, sr, ch, known, static_cast<uint64_t>(st.st_ino), static_cast<uint64_t>(st.st_size), resume, error)) {
+            closeMapping();
+            return false;
+        }
+        // Source inchangée depuis la dernière passe : rien à faire
+        const CacheHeader& h = *m_map->header();
+        if (h.sourceSize == static_cast<uint64_t>(st.st_size) && h.frames > 0 && (!exact || h.frames >= known)) return true;
+    }
+
+    // Segments alignés sur le niveau le plus grossier; le dernier va jusqu'à la fin du flux
+    // (longueur estimée) ou jusqu'à la longueur lue à l'ouverture (PCM, fichier qui grossit)
+    const uint64_t segFrames = std::max<uint64_t>(1, static_cast<uint64_t>(m_config.segmentSeconds * sr) / top) * top;
+    std::vector<SegmentResult> results;
+    for (uint64_t start = resume;; start += segFrames) {
+        SegmentResult r;
+        r.start = start;
+        const bool last = known <= start + segFrames;
+        r.expected = last ? (exact ? known - std::min(known, start) : 0) : segFrames;
+        r.levels.resize(spb.size());
+        results.push_back(std::move(r));
+        if (last) break;
+    }
+    if (exact && results.back().expected == 0) results.pop_back();   // rien de nouveau
+    if (results.empty()) return true;
+
+    SegmentJob job{&sourcePath, &spb, ch, &results};
+    // Segments décodés sur l'ordonnanceur partagé, priorité basse (après l'aperçu caméra)
+    auto range = [&job](size_t b, size_t e) {
+        for (size_t s = b; s < e; ++s) reduceSegmentTask(&job, s);
+    };
+    if (m_config.parallel && results.size() > 1) {
+        Common::TaskScheduler::shared().parallelFor(results.size(), range, Common::TaskPriority::Background, 1);
+    } else {
+        range(0, results.size());
+    }
+
+    // Segments contigus seulement : un segment court (fin de flux anticipée) arrête la couverture
+    uint64_t end = resume;
+    size_t usable = 0;
+    for (const auto& r : results) {
+        if (!r.error.empty()) { if (usable == 0) error = r.error; break; }
+        end = r.start + r.frames;
+        ++usable;
+        if (r.expected > 0 && r.frames < r.expected) break;
+    }
+    if (usable == 0) return error.empty();
+
+    std::unique_lock<std::shared_mutex> lk(m_mapMutex);
+    if (!ensureCapacity(end, error)) return false;
+    CacheHeader& h = *m_map->header();
+    for (size_t s = 0; s < usable; ++s) {
+        const SegmentResult& r = results[s];
+        for (size_t l = 0; l < spb.size(); ++l) {
+            int16_t* dst = m_map->level(l) + (r.start / spb[l]) * static_cast<uint64_t>(ch) * 3;
+            for (const Accum& a : r.levels[l]) {
+                const float rms = a.count > 0 ? static_cast<float>(std::sqrt(a.sumSq / a.count)) : 0.0f;
+                *dst++ = a.count > 0 ? quantize(a.min) : 0;
+                *dst++ = a.count > 0 ? quantize(a.max) : 0;
+                *dst++ = quantize(rms);
+            }
+        }
+    }
+    // Cases d'abord, couverture ensuite : un cache interrompu reste cohérent
+    ::msync(m_map->base, m_map->size, MS_SYNC);
+    h.frames = end;
+    h.sourceSize = static_cast<uint64_t>(st.st_size);
+    ::msync(m_map->base, kPage, MS_ASYNC);
+    return true;
+}
+
+WaveformInfo WaveformPyramid::getInfo() const {
+    std::shared_lock<std::shared_mutex> lk(m_mapMutex);
+    WaveformInfo info;
+    info.samplesPerBucket = m_config.samplesPerBucket;
+    if (!m_map) return info;
+    const CacheHeader& h = *m_map->header();
+    info.sampleRate = h.sampleRate;
+    info.channels = static_cast<int>(h.channels);
+    info.frames = h.frames;
+    return info;
+}
+
+size_t WaveformPyramid::readLevel(size_t level, uint64_t firstBucket, size_t count, int channel, float* out) const {
+    std::shared_lock<std::shared_mutex> lk(m_mapMutex);
+    if (!m_map || !out || level >= m_map->header()->numLevels) return 0;
+    const CacheHeader& h = *m_map->header();
+    const uint64_t buckets = bucketCount(h.frames, h.samplesPerBucket[level]);
+    if (firstBucket >= buckets) return 0;
+    const size_t n = static_cast<size_t>(std::min<uint64_t>(count, buckets - firstBucket));
+    const size_t ch = h.channels;
+    const int16_t* src = m_map->level(level) + firstBucket * ch * 3;
+    constexpr float kScale = 1.0f / 32767.0f;
+    for (size_t i = 0; i < n; ++i, src += ch * 3) {
+        if (channel >= 0 && static_cast<size_t>(channel) < ch) {
+            const int16_t* b = src + static_cast<size_t>(channel) * 3;
+            out[3 * i] = b[0] * kScale; out[3 * i + 1] = b[1] * kScale; out[3 * i + 2] = b[2] * kScale;
+        } else {
+            int mn = src[0], mx = src[1];
+            float sq = 0.0f;
+            for (size_t c = 0; c < ch; ++c) {
+                mn = std::min<int>(mn, src[3 * c]);
+                mx = std::max<int>(mx, src[3 * c + 1]);
+                sq += static_cast<float>(src[3 * c + 2]) * src[3 * c + 2];
+            }
+            out[3 * i] = mn * kScale; out[3 * i + 1] = mx * kScale;
+            out[3 * i + 2] = std::sqrt(sq / static_cast<float>(ch)) * kScale;
+        }
+    }
+    return n;
+}
+
+size_t WaveformPyramid::query(double startSeconds, double endSeconds, size_t width, int channel, float* out) const {
+    if (!out || width == 0) return 0;
+    std::fill(out, out + 3 * width, 0.0f);
+    std::shared_lock<std::shared_mutex> lk(m_mapMutex);
+    if (!m_map || !(endSeconds > startSeconds)) return 0;
+    const CacheHeader& h = *m_map->header();
+    const double sr = h.sampleRate;
+    const double startF = startSeconds * sr;
+    const double perColumn = (endSeconds - startSeconds) * sr / static_cast<double>(width);
+
+    // Niveau le plus grossier dont les cases ne dépassent pas une colonne
+    size_t level = 0;
+    for (size_t l = 1; l < h.numLevels; ++l) if (h.samplesPerBucket[l] <= perColumn) level = l;
+    const double spb = h.samplesPerBucket[level];
+    const uint64_t buckets = bucketCount(h.frames, h.samplesPerBucket[level]);
+    const size_t ch = h.channels;
+    const bool merge = channel < 0 || static_cast<size_t>(channel) >= ch;
+    const size_t c0 = merge ? 0 : static_cast<size_t>(channel);
+    const size_t c1 = merge ? ch : c0 + 1;
+    const int16_t* data = m_map->level(level);
+    constexpr float kScale = 1.0f / 32767.0f;
+
+    size_t covered = 0;
+    for (size_t i = 0; i < width; ++i) {
+        const double f0 = startF + perColumn * static_cast<double>(i);
+        if (f0 + perColumn <= 0.0) continue;
+        const uint64_t b0 = static_cast<uint64_t>(std::max(0.0, std::floor(f0 / spb)));
+        const uint64_t b1 = std::min(buckets, std::max(b0 + 1, static_cast<uint64_t>(std::ceil((f0 + perColumn) / spb))));
+        if (b0 >= buckets) break;
+        int mn = std::numeric_limits<int>::max(), mx = std::numeric_limits<int>::min();
+        double sq = 0.0;
+        for (uint64_t b = b0; b < b1; ++b) {
+            const int16_t* p = data + b * ch * 3;
+            for (size_t c = c0; c < c1; ++c) {
+                mn = std::min<int>(mn, p[3 * c]);
+                mx = std::max<int>(mx, p[3 * c + 1]);
+                sq += static_cast<double>(p[3 * c + 2]) * p[3 * c + 2];
+            }
+        }
+        const double n = static_cast<double>((b1 - b0) * (c1 - c0));
+        out[3 * i] = mn * kScale;
+        out[3 * i + 1] = mx * kScale;
+        out[3 * i + 2] = static_cast<float>(std::sqrt(sq / n)) * kScale;
+        ++covered;
+    }
+    return covered;
+}
+
+} // namespace AudioWaveform
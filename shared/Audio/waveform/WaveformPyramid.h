@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace AudioWaveform {
+
+constexpr size_t kMaxLevels = 4;
+
+struct WaveformConfig {
+    // Échantillons par case, du plus fin au plus grossier; chaque niveau multiple du précédent
+    std::vector<uint32_t> samplesPerBucket{256, 2048, 16384};
+    double segmentSeconds = 30.0;   // découpage du décodage entre les coeurs
+    bool parallel = true;           // sur TaskScheduler::shared(), sinon sur le thread appelant
+};
+
+struct WaveformInfo {
+    uint32_t sampleRate = 0;
+    int channels = 0;
+    uint64_t frames = 0;            // échantillons couverts par le cache
+    std::vector<uint32_t> samplesPerBucket;
+};
+
+// Aperçu de forme d'onde multi-résolution (min / max / RMS par case et par canal).
+//
+// La source est décodée une seule fois (WAV/W64 PCM lus directement, autres formats via
+// FFmpeg), par segments alignés sur le niveau le plus grossier et traités en parallèle;
+// chaque segment réduit ses cases du niveau fin puis en déduit les niveaux supérieurs.
+// Le résultat est un fichier annexe projeté en mémoire (mmap) : int16 min/max/rms par case,
+// niveaux contigus, de sorte qu'une requête ne lit que les cases visibles.
+//
+// update() peut être rappelé pendant qu'un enregistrement grossit : la réduction reprend au
+// début du dernier bloc incomplet. Le cache est reconstruit si la source a été remplacée
+// (inode différent) ou raccourcie.
+//
+// update() et les lectures peuvent être concurrents (verrou lecteurs/écrivain, tenu par
+// update() seulement pendant la fusion des segments).
+class WaveformPyramid {
+public:
+    explicit WaveformPyramid(const WaveformConfig& config = {});
+    ~WaveformPyramid();
+
+    WaveformPyramid(const WaveformPyramid&) = delete;
+    WaveformPyramid& operator=(const WaveformPyramid&) = delete;
+
+    // Crée ou complète le cache; cachePath vide : sourcePath + ".wfp"
+    bool update(const std::string& sourcePath, const std::string& cachePath, std::string& error);
+
+    WaveformInfo getInfo() const;
+
+    // width colonnes de [startSeconds, endSeconds) : out[3 i] = min, out[3 i + 1] = max,
+    // out[3 i + 2] = rms. Niveau le plus grossier qui garde au moins une case par colonne,
+    // coût proportionnel aux cases visibles. channel < 0 : canaux fusionnés.
+    // Retourne le nombre de colonnes couvertes par des données (les autres restent à 0).
+    size_t query(double startSeconds, double endSeconds, size_t width, int channel, float* out) const;
+
+    // Cases brutes d'un niveau (même disposition que query())
+    size_t readLevel(size_t level, uint64_t firstBucket, size_t count, int channel, float* out) const;
+
+private:
+    struct Mapping;
+
+    bool openMapping(const std::string& path, uint32_t sampleRate, int channels, uint64_t minFrames,
+                     uint64_t sourceInode, uint64_t sourceSize, uint64_t& resumeFrame, std::string& error);
+    bool ensureCapacity(uint64_t frames, std::string& error);
+    void closeMapping();
+
+    WaveformConfig m_config;
+    std::mutex m_updateMutex;                // un update() à la fois
+    mutable std::shared_mutex m_mapMutex;    // projection et en-tête
+    std::unique_ptr<Mapping> m_map;
+    std::string m_cachePath;
+};
+
+} // namespace AudioWaveform
+
+#endif // __cplusplus
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -81,10 +82,27 @@ public:
     // Vérification de support
     virtual bool supportsFormat(const std::string& format) const = 0;
     virtual bool supportsFilter(FilterType type) const = 0;
+    // Filtre complet (ex: CUSTOM "lut3d:..." réservé au processeur LUT)
+    virtual bool canProcess(const FilterState& filter) const { return supportsFilter(filter.type); }
     
     // Informations
     virtual std::string getName() const = 0;
     virtual std::vector<FilterInfo> getSupportedFilters() const = 0;
+    
+    // Priorité de sélection (FilterManager) : la plus élevée l'emporte
+    virtual int getPriority() const { return 0; }
+    
+    // Dimensions des buffers passés à applyFilter (false : format non supporté)
+    virtual bool setVideoFormat(int width, int height, const std::string& pixelFormat) {
+        (void)width; (void)height; (void)pixelFormat;
+        return false;
+    }
+    
+    // Traitement par bandes (FrameStripeExecutor) : instance indépendante, initialisée et
+    // réglée comme celle-ci, réservée à un worker. nullptr : image traitée d'un bloc.
+    virtual std::shared_ptr<IFilterProcessor> clone() const { return nullptr; }
+    // Lignes de contexte lues au-dessus et au-dessous de chaque ligne (0 : filtre ponctuel)
+    virtual int haloRows(const FilterState& filter) const { (void)filter; return 0; }
 };
 
 /**
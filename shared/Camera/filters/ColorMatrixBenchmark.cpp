@@ -0,0 +1,180 @@
+#include "ColorMatrixBenchmark.hpp"
+#include "ColorMatrixFilterProcessor.hpp"
+#ifdef FFMPEG_AVAILABLE
+#include "FFmpegFilterProcessor.hpp"
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace Camera {
+
+namespace {
+
+const char* filterName(FilterType type) {
+    switch (type) {
+        case FilterType::SEPIA: return "sepia";
+        case FilterType::NOIR: return "noir";
+        case FilterType::MONOCHROME: return "monochrome";
+        case FilterType::COLOR_CONTROLS: return "color_controls";
+        case FilterType::VINTAGE: return "vintage";
+        case FilterType::COOL: return "cool";
+        case FilterType::WARM: return "warm";
+        default: return "?";
+    }
+}
+
+FilterState makeState(FilterType type) {
+    FilterParams params;
+    params.intensity = 1.0;
+    if (type == FilterType::COLOR_CONTROLS) {
+        params.brightness = 0.05;
+        params.contrast = 1.2;
+        params.saturation = 1.3;
+        params.hue = 15.0;
+        params.gamma = 1.1;
+    }
+    return FilterState(type, params);
+}
+
+// BGRA lisse, stride = width * 4 + padding
+std::vector<uint8_t> makeImage(int width, int height, int stride) {
+    std::vector<uint8_t> img(static_cast<size_t>(stride) * height, 0);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = img.data() + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            const double u = static_cast<double>(x) / width;
+            const double v = static_cast<double>(y) / height;
+            row[x * 4 + 0] = static_cast<uint8_t>(255.0 * u);
+            row[x * 4 + 1] = static_cast<uint8_t>(255.0 * v);
+            row[x * 4 + 2] = static_cast<uint8_t>(127.5 + 127.0 * std::sin(6.0 * u) * std::cos(4.0 * v));
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return img;
+}
+
+template <typename Fn>
+double measureMPixPerSec(int width, int height, int frames, Fn&& fn) {
+    fn();   // préchauffage (compilation du programme, graphe FFmpeg)
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) fn();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return seconds > 0.0 ? static_cast<double>(width) * height * frames / seconds / 1e6 : 0.0;
+}
+
+} // namespace
+
+std::vector<ColorMatrixBenchmarkResult> runColorMatrixBenchmark(const ColorMatrixBenchmarkConfig& config) {
+    std::vector<ColorMatrixBenchmarkResult> results;
+    const int frames = std::max(1, config.frames);
+
+    ColorMatrixFilterProcessor native;
+    native.initialize();
+#ifdef FFMPEG_AVAILABLE
+    FFmpegFilterProcessor ffmpeg;
+    ffmpeg.initialize();
+    ffmpeg.setFrameRate(30);
+#endif
+
+    for (const auto& res : config.resolutions) {
+        const int width = res.first;
+        const int height = res.second;
+        const int stride = width * 4;
+        const int padded = stride + std::max(0, config.stridePadding);
+        const std::vector<uint8_t> input = makeImage(width, height, stride);
+        const std::vector<uint8_t> inputPadded = makeImage(width, height, padded);
+        const size_t pixelBytes = static_cast<size_t>(stride) * height;
+
+        for (FilterType type : config.filters) {
+            const FilterState state = makeState(type);
+            if (!ColorMatrixFilterProcessor::canCompile(state)) continue;
+            const ColorMatrixProgram program = ColorMatrixFilterProcessor::compile(state);
+
+            ColorMatrixBenchmarkResult r;
+            r.filter = filterName(type);
+            r.width = width;
+            r.height = height;
+
+            std::vector<uint8_t> outSimd(pixelBytes);
+            std::vector<uint8_t> outScalar(pixelBytes);
+            r.nativeMPixPerSec = measureMPixPerSec(width, height, frames, [&] {
+                native.applyFilterWithStride(state, input.data(), stride, width, height, "bgra",
+                                             outSimd.data(), stride);
+            });
+            r.scalarMPixPerSec = measureMPixPerSec(width, height, std::max(1, frames / 4), [&] {
+                ColorMatrixFilterProcessor::apply(program, input.data(), stride, width, height, true,
+                                                  outScalar.data(), stride, false);
+            });
+            for (size_t i = 0; i < pixelBytes; ++i) {
+                r.maxDiffScalar = std::max(r.maxDiffScalar, std::abs(int(outSimd[i]) - int(outScalar[i])));
+            }
+
+            // Stride paddé : mêmes pixels que le buffer packé, octets de padding non écrits
+            std::vector<uint8_t> outPadded(static_cast<size_t>(padded) * height, 0xA5);
+            native.applyFilterWithStride(state, inputPadded.data(), padded, width, height, "bgra",
+                                         outPadded.data(), padded);
+            r.strideOk = true;
+            for (int y = 0; y < height && r.strideOk; ++y) {
+                const uint8_t* row = outPadded.data() + static_cast<size_t>(y) * padded;
+                r.strideOk = std::equal(row, row + stride, outSimd.data() + static_cast<size_t>(y) * stride) &&
+                             std::all_of(row + stride, row + padded, [](uint8_t b) { return b == 0xA5; });
+            }
+
+#ifdef FFMPEG_AVAILABLE
+            std::vector<uint8_t> outFFmpeg(pixelBytes);
+            ffmpeg.setVideoFormat(width, height, "bgra");
+            bool ffmpegOk = true;
+            r.ffmpegMPixPerSec = measureMPixPerSec(width, height, std::max(1, frames / 4), [&] {
+                ffmpegOk = ffmpeg.applyFilterWithStride(state, input.data(), stride, width, height, "bgra",
+                                                        outFFmpeg.data(), stride) && ffmpegOk;
+            });
+            if (ffmpegOk) {
+                double sum = 0.0;
+                for (size_t i = 0; i < pixelBytes; i += 4) {
+                    for (size_t c = 0; c < 3; ++c) sum += std::abs(int(outSimd[i + c]) - int(outFFmpeg[i + c]));
+                }
+                r.meanDiffFFmpeg = sum / (static_cast<double>(width) * height * 3);
+            } else {
+                r.ffmpegMPixPerSec = 0.0;
+            }
+#endif
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+void printColorMatrixBenchmark(const std::vector<ColorMatrixBenchmarkResult>& results) {
+    std::cout << "\n=== Matrice couleur native vs FFmpeg (BGRA, MP/s) ===" << std::endl;
+    std::cout << std::left << std::setw(16) << "filtre" << std::right << std::setw(11) << "taille"
+              << std::setw(10) << "natif" << std::setw(10) << "scalaire" << std::setw(10) << "ffmpeg"
+              << std::setw(9) << "x ffmpeg" << std::setw(10) << "Δ scal" << std::setw(10) << "Δ ffmpeg"
+              << std::setw(8) << "stride" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        const std::string size = std::to_string(r.width) + "x" + std::to_string(r.height);
+        std::cout << std::left << std::setw(16) << r.filter << std::right << std::setw(11) << size
+                  << std::setprecision(0) << std::setw(10) << r.nativeMPixPerSec
+                  << std::setw(10) << r.scalarMPixPerSec;
+        if (r.ffmpegMPixPerSec > 0.0) {
+            std::cout << std::setw(10) << r.ffmpegMPixPerSec << std::setprecision(1)
+                      << std::setw(9) << r.nativeMPixPerSec / r.ffmpegMPixPerSec;
+        } else {
+            std::cout << std::setw(10) << "n/d" << std::setw(9) << "-";
+        }
+        std::cout << std::setw(10) << r.maxDiffScalar;
+        if (r.meanDiffFFmpeg >= 0.0) {
+            std::cout << std::setprecision(2) << std::setw(10) << r.meanDiffFFmpeg;
+        } else {
+            std::cout << std::setw(10) << "n/d";
+        }
+        std::cout << std::setw(8) << (r.strideOk ? "OK" : "ÉCART") << std::endl;
+    }
+}
+
+} // namespace Camera
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../common/FilterTypes.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Camera {
+
+struct ColorMatrixBenchmarkResult {
+    std::string filter;
+    int width{0};
+    int height{0};
+    double nativeMPixPerSec{0.0};   // ColorMatrixFilterProcessor (SIMD de la cible)
+    double scalarMPixPerSec{0.0};   // même programme, noyau scalaire
+    double ffmpegMPixPerSec{0.0};   // FFmpegFilterProcessor, 0 sans FFmpeg
+    int maxDiffScalar{0};           // SIMD vs scalaire (niveaux 8 bits)
+    double meanDiffFFmpeg{-1.0};    // écart moyen RGB vs graphe FFmpeg, -1 sans FFmpeg
+    bool strideOk{false};           // stride paddé : pixels identiques, padding intact
+};
+
+struct ColorMatrixBenchmarkConfig {
+    std::vector<std::pair<int, int>> resolutions = {{1280, 720}, {1920, 1080}, {3840, 2160}};
+    std::vector<FilterType> filters = {FilterType::SEPIA, FilterType::NOIR, FilterType::VINTAGE,
+                                       FilterType::WARM, FilterType::COLOR_CONTROLS};
+    int frames = 30;
+    int stridePadding = 64;         // octets ajoutés par ligne (CVPixelBuffer/ImageReader)
+};
+
+// Débit BGRA en mégapixels/s : matrice couleur native (SIMD puis scalaire) contre le graphe
+// FFmpeg eq/hue/colorbalance équivalent. Image de test lisse (dégradés) pour que l'écart
+// vs FFmpeg reflète le rendu plutôt que le sous-échantillonnage chroma du passage en YUV.
+// COLOR_CONTROLS utilise luminosité/contraste/saturation/teinte/gamma non neutres.
+std::vector<ColorMatrixBenchmarkResult> runColorMatrixBenchmark(const ColorMatrixBenchmarkConfig& config = {});
+void printColorMatrixBenchmark(const std::vector<ColorMatrixBenchmarkResult>& results);
+
+} // namespace Camera
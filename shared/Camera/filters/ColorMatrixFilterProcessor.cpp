@@ -0,0 +1,483 @@
+#include "ColorMatrixFilterProcessor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Camera {
+
+namespace {
+
+using Mat4 = std::array<std::array<double, 4>, 4>;
+
+// Poids de luma BT.601 (conversion RGB -> YUV de FFmpeg pour eq/hue)
+constexpr double kWr = 0.299;
+constexpr double kWg = 0.587;
+constexpr double kWb = 0.114;
+
+Mat4 identity() {
+    Mat4 m{};
+    for (int i = 0; i < 4; ++i) m[i][i] = 1.0;
+    return m;
+}
+
+Mat4 multiply(const Mat4& a, const Mat4& b) {
+    Mat4 r{};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            double s = 0.0;
+            for (int k = 0; k < 4; ++k) s += a[i][k] * b[k][j];
+            r[i][j] = s;
+        }
+    }
+    return r;
+}
+
+// eq : Y' = c (Y - 0.5) + 0.5 + b, chroma inchangée -> RGB' = RGB + (Y' - Y)
+Mat4 contrastBrightness(double contrast, double brightness) {
+    const double w[3] = {kWr, kWg, kWb};
+    Mat4 m = identity();
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) m[i][j] += (contrast - 1.0) * w[j];
+        m[i][3] = 0.5 * (1.0 - contrast) + brightness;
+    }
+    return m;
+}
+
+// Chroma multipliée par s autour de la luma (eq saturation, hue=s)
+Mat4 saturation(double s) {
+    const double w[3] = {kWr, kWg, kWb};
+    Mat4 m = identity();
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) m[i][j] = (i == j ? s : 0.0) + (1.0 - s) * w[j];
+    }
+    return m;
+}
+
+// hue=h : rotation du plan (Cb, Cr), luma conservée
+Mat4 hueRotation(double radians) {
+    const double c = std::cos(radians);
+    const double s = std::sin(radians);
+    auto rotate = [&](const double rgb[3], double out[3]) {
+        const double y = kWr * rgb[0] + kWg * rgb[1] + kWb * rgb[2];
+        const double cb = 0.5 * (rgb[2] - y) / (1.0 - kWb);
+        const double cr = 0.5 * (rgb[0] - y) / (1.0 - kWr);
+        const double cb2 = cb * c - cr * s;
+        const double cr2 = cb * s + cr * c;
+        out[0] = y + 2.0 * (1.0 - kWr) * cr2;
+        out[2] = y + 2.0 * (1.0 - kWb) * cb2;
+        out[1] = (y - kWr * out[0] - kWb * out[2]) / kWg;
+    };
+    // Opération linéaire : colonnes = images des vecteurs de base
+    Mat4 m = identity();
+    for (int j = 0; j < 3; ++j) {
+        double e[3] = {0.0, 0.0, 0.0};
+        double col[3];
+        e[j] = 1.0;
+        rotate(e, col);
+        for (int i = 0; i < 3; ++i) m[i][j] = col[i];
+    }
+    return m;
+}
+
+// colorbalance (ombres), LUT par canal comme vf_colorbalance
+double shadowShift(double v, double shift) {
+    const double weight = std::clamp((0.333 - v) * 4.0 + 0.5, 0.0, 1.0) * 0.7;
+    return v + shift * weight;
+}
+
+bool needsEq(const FilterParams& p) {
+    return (std::abs(p.brightness) > 1e-6) || (std::abs(p.contrast - 1.0) > 1e-6) ||
+           (std::abs(p.saturation - 1.0) > 1e-6) || (std::abs(p.gamma - 1.0) > 1e-6);
+}
+
+// Coefficients dans l'ordre mémoire des octets (0..255), arrondi inclus dans l'offset
+struct KernelCoeffs {
+    float c[3][4];
+    const uint8_t* lut[3];
+};
+
+KernelCoeffs kernelCoeffs(const ColorMatrixProgram& program, bool bgra) {
+    // Octet m -> canal R/G/B du programme
+    const int ch[3] = {bgra ? 2 : 0, 1, bgra ? 0 : 2};
+    KernelCoeffs k{};
+    for (int m = 0; m < 3; ++m) {
+        for (int n = 0; n < 3; ++n) k.c[m][n] = program.matrix[ch[m]][ch[n]];
+        k.c[m][3] = program.matrix[ch[m]][3] * 255.0f + 0.5f;
+        k.lut[m] = program.curves[ch[m]].data();
+    }
+    return k;
+}
+
+inline uint8_t quantize(float v) {
+    v = std::min(std::max(v, 0.0f), 255.0f);
+    return static_cast<uint8_t>(static_cast<int>(v));
+}
+
+void rowScalar(const KernelCoeffs& k, const uint8_t* in, uint8_t* out, int width) {
+    for (int x = 0; x < width; ++x, in += 4, out += 4) {
+        const float x0 = in[0], x1 = in[1], x2 = in[2];
+        const uint8_t a = in[3];
+        const uint8_t o0 = quantize(k.c[0][0] * x0 + k.c[0][1] * x1 + k.c[0][2] * x2 + k.c[0][3]);
+        const uint8_t o1 = quantize(k.c[1][0] * x0 + k.c[1][1] * x1 + k.c[1][2] * x2 + k.c[1][3]);
+        const uint8_t o2 = quantize(k.c[2][0] * x0 + k.c[2][1] * x1 + k.c[2][2] * x2 + k.c[2][3]);
+        out[0] = o0; out[1] = o1; out[2] = o2; out[3] = a;
+    }
+}
+
+#if defined(__AVX2__)
+// 8 pixels : octets désentrelacés par masques/décalages sur les mots 32 bits
+int rowSimd(const KernelCoeffs& k, const uint8_t* in, uint8_t* out, int width) {
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 maxv = _mm256_set1_ps(255.0f);
+    __m256 c[3][4];
+    for (int m = 0; m < 3; ++m)
+        for (int n = 0; n < 4; ++n) c[m][n] = _mm256_set1_ps(k.c[m][n]);
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + x * 4));
+        const __m256 x0 = _mm256_cvtepi32_ps(_mm256_and_si256(px, mask));
+        const __m256 x1 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 8), mask));
+        const __m256 x2 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 16), mask));
+        __m256i res = _mm256_and_si256(px, alphaMask);
+        for (int m = 0; m < 3; ++m) {
+            __m256 v = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c[m][0], x0),
+                                                                 _mm256_mul_ps(c[m][1], x1)),
+                                                   _mm256_mul_ps(c[m][2], x2)),
+                                     c[m][3]);
+            v = _mm256_min_ps(_mm256_max_ps(v, zero), maxv);
+            const __m256i q = _mm256_cvttps_epi32(v);
+            res = _mm256_or_si256(res, m == 0 ? q : m == 1 ? _mm256_slli_epi32(q, 8) : _mm256_slli_epi32(q, 16));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x * 4), res);
+    }
+    return x;
+}
+#elif defined(__SSE2__)
+// 4 pixels : même schéma que la variante AVX2
+int rowSimd(const KernelCoeffs& k, const uint8_t* in, uint8_t* out, int width) {
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maxv = _mm_set1_ps(255.0f);
+    __m128 c[3][4];
+    for (int m = 0; m < 3; ++m)
+        for (int n = 0; n < 4; ++n) c[m][n] = _mm_set1_ps(k.c[m][n]);
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 4));
+        const __m128 x0 = _mm_cvtepi32_ps(_mm_and_si128(px, mask));
+        const __m128 x1 = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 8), mask));
+        const __m128 x2 = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 16), mask));
+        __m128i res = _mm_and_si128(px, alphaMask);
+        for (int m = 0; m < 3; ++m) {
+            __m128 v = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[m][0], x0),
+                                                        _mm_mul_ps(c[m][1], x1)),
+                                             _mm_mul_ps(c[m][2], x2)),
+                                  c[m][3]);
+            v = _mm_min_ps(_mm_max_ps(v, zero), maxv);
+            const __m128i q = _mm_cvttps_epi32(v);
+            res = _mm_or_si128(res, m == 0 ? q : m == 1 ? _mm_slli_epi32(q, 8) : _mm_slli_epi32(q, 16));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), res);
+    }
+    return x;
+}
+#elif defined(__ARM_NEON)
+// 4 pixels par vecteur u32, deux vecteurs par itération
+int rowSimd(const KernelCoeffs& k, const uint8_t* in, uint8_t* out, int width) {
+    const uint32x4_t mask = vdupq_n_u32(0xFF);
+    const uint32x4_t alphaMask = vdupq_n_u32(0xFF000000u);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t maxv = vdupq_n_f32(255.0f);
+    auto pixels4 = [&](const uint8_t* src, uint8_t* dst) {
+        const uint32x4_t px = vld1q_u32(reinterpret_cast<const uint32_t*>(src));
+        const float32x4_t x0 = vcvtq_f32_u32(vandq_u32(px, mask));
+        const float32x4_t x1 = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(px, 8), mask));
+        const float32x4_t x2 = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(px, 16), mask));
+        uint32x4_t q[3];
+        for (int m = 0; m < 3; ++m) {
+            float32x4_t v = vdupq_n_f32(k.c[m][3]);
+            v = vmlaq_n_f32(v, x0, k.c[m][0]);
+            v = vmlaq_n_f32(v, x1, k.c[m][1]);
+            v = vmlaq_n_f32(v, x2, k.c[m][2]);
+            v = vminq_f32(vmaxq_f32(v, zero), maxv);
+            q[m] = vcvtq_u32_f32(v);
+        }
+        uint32x4_t res = vandq_u32(px, alphaMask);
+        res = vorrq_u32(res, q[0]);
+        res = vorrq_u32(res, vshlq_n_u32(q[1], 8));
+        res = vorrq_u32(res, vshlq_n_u32(q[2], 16));
+        vst1q_u32(reinterpret_cast<uint32_t*>(dst), res);
+    };
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        pixels4(in + x * 4, out + x * 4);
+        pixels4(in + x * 4 + 16, out + x * 4 + 16);
+    }
+    for (; x + 4 <= width; x += 4) pixels4(in + x * 4, out + x * 4);
+    return x;
+}
+#else
+int rowSimd(const KernelCoeffs&, const uint8_t*, uint8_t*, int) { return 0; }
+#endif
+
+void rowCurves(const KernelCoeffs& k, uint8_t* row, int width) {
+    for (int x = 0; x < width; ++x, row += 4) {
+        row[0] = k.lut[0][row[0]];
+        row[1] = k.lut[1][row[1]];
+        row[2] = k.lut[2][row[2]];
+    }
+}
+
+} // namespace
+
+ColorMatrixFilterProcessor::ColorMatrixFilterProcessor() {
+    std::cout << "[ColorMatrixFilterProcessor] Construction" << std::endl;
+}
+
+ColorMatrixFilterProcessor::~ColorMatrixFilterProcessor() {
+    shutdown();
+    std::cout << "[ColorMatrixFilterProcessor] Destruction" << std::endl;
+}
+
+bool ColorMatrixFilterProcessor::initialize() {
+    initialized_ = true;
+    return true;
+}
+
+void ColorMatrixFilterProcessor::shutdown() {
+    initialized_ = false;
+    hasProgram_ = false;
+}
+
+bool ColorMatrixFilterProcessor::applyFilter(const FilterState& filter, const void* inputData,
+                                             size_t inputSize, void* outputData, size_t outputSize) {
+    if (!initialized_) {
+        setLastError("Processeur non initialisé");
+        return false;
+    }
+    if (width_ <= 0 || height_ <= 0) {
+        setLastError("Format vidéo non défini");
+        return false;
+    }
+    // Buffer packé : stride = largeur * 4
+    const size_t frameBytes = static_cast<size_t>(width_) * height_ * 4;
+    if (inputSize < frameBytes || outputSize < frameBytes) {
+        setLastError("Taille de buffer insuffisante");
+        return false;
+    }
+    return applyFilterWithStride(filter, static_cast<const uint8_t*>(inputData), width_ * 4,
+                                 width_, height_, pixelFormat_.c_str(),
+                                 static_cast<uint8_t*>(outputData), width_ * 4);
+}
+
+bool ColorMatrixFilterProcessor::supportsFormat(const std::string& format) const {
+    return format == "bgra" || format == "rgba";
+}
+
+bool ColorMatrixFilterProcessor::supportsFilter(FilterType type) const {
+    return type == FilterType::SEPIA || type == FilterType::NOIR ||
+           type == FilterType::MONOCHROME || type == FilterType::COLOR_CONTROLS ||
+           type == FilterType::VINTAGE || type == FilterType::COOL ||
+           type == FilterType::WARM;
+}
+
+std::string ColorMatrixFilterProcessor::getName() const {
+    return "ColorMatrixFilterProcessor";
+}
+
+std::vector<FilterInfo> ColorMatrixFilterProcessor::getSupportedFilters() const {
+    std::vector<FilterInfo> filters;
+    filters.push_back({"sepia", "Sépia", FilterType::SEPIA, "Effet sépia vintage", false, {"bgra", "rgba"}});
+    filters.push_back({"noir", "Noir & Blanc", FilterType::NOIR, "Conversion noir et blanc", false, {"bgra", "rgba"}});
+    filters.push_back({"monochrome", "Monochrome", FilterType::MONOCHROME, "Monochrome avec teinte", false, {"bgra", "rgba"}});
+    filters.push_back({"color_controls", "Contrôles Couleur", FilterType::COLOR_CONTROLS, "Luminosité, contraste, saturation", false, {"bgra", "rgba"}});
+    filters.push_back({"vintage", "Vintage", FilterType::VINTAGE, "Effet vintage années 70", false, {"bgra", "rgba"}});
+    filters.push_back({"cool", "Cool", FilterType::COOL, "Effet froid bleuté", false, {"bgra", "rgba"}});
+    filters.push_back({"warm", "Warm", FilterType::WARM, "Effet chaud orangé", false, {"bgra", "rgba"}});
+    return filters;
+}
+
+std::shared_ptr<IFilterProcessor> ColorMatrixFilterProcessor::clone() const {
+    auto copy = std::make_shared<ColorMatrixFilterProcessor>();
+    copy->initialized_ = initialized_;
+    copy->width_ = width_;
+    copy->height_ = height_;
+    copy->pixelFormat_ = pixelFormat_;
+    return copy;
+}
+
+bool ColorMatrixFilterProcessor::setVideoFormat(int width, int height, const std::string& pixelFormat) {
+    if (!supportsFormat(pixelFormat)) {
+        setLastError("Format non supporté: " + pixelFormat);
+        return false;
+    }
+    width_ = width;
+    height_ = height;
+    pixelFormat_ = pixelFormat;
+    return true;
+}
+
+bool ColorMatrixFilterProcessor::applyFilterWithStride(const FilterState& filter,
+                                                       const uint8_t* inputData,
+                                                       int inputStride,
+                                                       int width,
+                                                       int height,
+                                                       const char* pixFormat,
+                                                       uint8_t* outputData,
+                                                       int outputStride) {
+    if (!initialized_) { setLastError("Processeur non initialisé"); return false; }
+    if (!inputData || !outputData || width <= 0 || height <= 0) { setLastError("Paramètres invalides"); return false; }
+    if (inputStride < width * 4 || outputStride < width * 4) { setLastError("Stride insuffisant"); return false; }
+    const std::string format = pixFormat ? pixFormat : "bgra";
+    if (!supportsFormat(format)) { setLastError("Format non supporté: " + format); return false; }
+    if (!canCompile(filter)) { setLastError("Filtre non ponctuel"); return false; }
+
+    apply(programFor(filter), inputData, inputStride, width, height, format == "bgra",
+          outputData, outputStride);
+    return true;
+}
+
+bool ColorMatrixFilterProcessor::canCompile(const FilterState& filter) {
+    switch (filter.type) {
+        case FilterType::SEPIA:
+        case FilterType::NOIR:
+        case FilterType::MONOCHROME:
+        case FilterType::COLOR_CONTROLS:
+        case FilterType::VINTAGE:
+        case FilterType::COOL:
+        case FilterType::WARM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ColorMatrixProgram ColorMatrixFilterProcessor::compile(const FilterState& filter) {
+    const FilterParams& p = filter.params;
+    const bool eq = needsEq(p);
+
+    // Même enchaînement que getFFmpegFilterString : eq, hue, puis effet
+    Mat4 m = identity();
+    if (eq) {
+        m = multiply(contrastBrightness(p.contrast, p.brightness), m);
+        m = multiply(saturation(p.saturation), m);
+    }
+    if (std::abs(p.hue) > 1e-6) {
+        m = multiply(hueRotation(p.hue * M_PI / 180.0), m);
+    }
+
+    double shift[3] = {0.0, 0.0, 0.0};   // colorbalance rs/gs/bs
+    switch (filter.type) {
+        case FilterType::SEPIA:
+            shift[0] = p.intensity * 0.3; shift[1] = p.intensity * 0.1; shift[2] = -p.intensity * 0.4;
+            break;
+        case FilterType::NOIR:
+            m = multiply(saturation(0.0), m);
+            break;
+        case FilterType::MONOCHROME:
+            m = multiply(saturation(0.5), m);
+            break;
+        case FilterType::VINTAGE:
+            shift[0] = 0.2; shift[1] = 0.1; shift[2] = -0.3;
+            m = multiply(saturation(0.8), m);
+            break;
+        case FilterType::COOL:
+            shift[0] = -0.2; shift[1] = 0.1; shift[2] = 0.3;
+            break;
+        case FilterType::WARM:
+            shift[0] = 0.3; shift[1] = 0.1; shift[2] = -0.2;
+            break;
+        default:
+            break;
+    }
+
+    ColorMatrixProgram program;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j) program.matrix[i][j] = static_cast<float>(m[i][j]);
+
+    const bool gamma = eq && std::abs(p.gamma - 1.0) > 1e-6 && p.gamma > 0.0;
+    program.hasCurves = gamma || shift[0] != 0.0 || shift[1] != 0.0 || shift[2] != 0.0;
+    for (int c = 0; c < 3; ++c) {
+        for (int i = 0; i < 256; ++i) {
+            double v = i / 255.0;
+            if (gamma) v = std::pow(v, 1.0 / p.gamma);
+            if (shift[c] != 0.0) v = shadowShift(v, shift[c]);
+            program.curves[c][i] = static_cast<uint8_t>(std::lround(std::clamp(v, 0.0, 1.0) * 255.0));
+        }
+    }
+    return program;
+}
+
+void ColorMatrixFilterProcessor::apply(const ColorMatrixProgram& program,
+                                       const uint8_t* inputData, int inputStride,
+                                       int width, int height, bool bgra,
+                                       uint8_t* outputData, int outputStride,
+                                       bool allowSimd) {
+    const KernelCoeffs k = kernelCoeffs(program, bgra);
+    // Ligne par ligne : courbes appliquées tant que la ligne est en cache
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = inputData + static_cast<size_t>(y) * inputStride;
+        uint8_t* out = outputData + static_cast<size_t>(y) * outputStride;
+        const int done = allowSimd ? rowSimd(k, in, out, width) : 0;
+        rowScalar(k, in + done * 4, out + done * 4, width - done);
+        if (program.hasCurves) rowCurves(k, out, width);
+    }
+}
+
+void ColorMatrixFilterProcessor::evaluate(const ColorMatrixProgram& program, float* rgb) {
+    float out[3];
+    for (int i = 0; i < 3; ++i) {
+        const auto& row = program.matrix[i];
+        out[i] = std::min(std::max(row[0] * rgb[0] + row[1] * rgb[1] + row[2] * rgb[2] + row[3], 0.0f), 1.0f);
+    }
+    for (int c = 0; c < 3; ++c) {
+        if (program.hasCurves) {
+            const float x = out[c] * 255.0f;
+            const int i = std::min(static_cast<int>(x), 254);
+            const float f = x - static_cast<float>(i);
+            const auto& curve = program.curves[c];
+            out[c] = (curve[i] + (curve[i + 1] - curve[i]) * f) / 255.0f;
+        }
+        rgb[c] = out[c];
+    }
+}
+
+const ColorMatrixProgram& ColorMatrixFilterProcessor::programFor(const FilterState& filter) {
+    const FilterParams& p = filter.params;
+    const bool same = hasProgram_ && lastType_ == filter.type &&
+                      lastParams_.intensity == p.intensity && lastParams_.brightness == p.brightness &&
+                      lastParams_.contrast == p.contrast && lastParams_.saturation == p.saturation &&
+                      lastParams_.hue == p.hue && lastParams_.gamma == p.gamma;
+    if (!same) {
+        program_ = compile(filter);
+        lastType_ = filter.type;
+        lastParams_.intensity = p.intensity;
+        lastParams_.brightness = p.brightness;
+        lastParams_.contrast = p.contrast;
+        lastParams_.saturation = p.saturation;
+        lastParams_.hue = p.hue;
+        lastParams_.gamma = p.gamma;
+        hasProgram_ = true;
+    }
+    return program_;
+}
+
+void ColorMatrixFilterProcessor::setLastError(const std::string& error) {
+    lastError_ = error;
+    std::cout << "[ColorMatrixFilterProcessor] Erreur: " << error << std::endl;
+}
+
+} // namespace Camera
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "../common/FilterTypes.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+/**
+ * Programme couleur compilé depuis un FilterState ponctuel
+ * out = curves[c](clamp(M · (R, G, B, 1)))   — valeurs normalisées 0..1
+ * La matrice 4×4 est homogène (dernière ligne 0 0 0 1) : alpha inchangé.
+ */
+struct ColorMatrixProgram {
+    std::array<std::array<float, 4>, 4> matrix{{
+        {{1.0f, 0.0f, 0.0f, 0.0f}},
+        {{0.0f, 1.0f, 0.0f, 0.0f}},
+        {{0.0f, 0.0f, 1.0f, 0.0f}},
+        {{0.0f, 0.0f, 0.0f, 1.0f}}
+    }};
+    // Courbes par canal (R, G, B) appliquées après la matrice, sur 8 bits
+    std::array<std::array<uint8_t, 256>, 3> curves{};
+    bool hasCurves{false};
+};
+
+/**
+ * Processeur natif pour les filtres ponctuels (SEPIA, NOIR, MONOCHROME,
+ * COLOR_CONTROLS, VINTAGE, COOL, WARM) : une seule passe SIMD (NEON/SSE2/AVX2)
+ * sur BGRA/RGBA avec stride, sans graphe FFmpeg ni conversion YUV.
+ *
+ * Reproduit les chaînes eq/hue/colorbalance de FFmpegFilterProcessor :
+ * - eq (contraste, luminosité, saturation) et hue (h, s) en BT.601 -> matrice;
+ * - gamma et colorbalance (ombres) -> courbes par canal.
+ * Écarts connus : le gamma porte sur chaque canal (FFmpeg : luma seule) et les
+ * courbes passent après la matrice (VINTAGE : colorbalance avant hue=s=0.8).
+ */
+class ColorMatrixFilterProcessor : public IFilterProcessor {
+public:
+    ColorMatrixFilterProcessor();
+    ~ColorMatrixFilterProcessor() override;
+
+    // IFilterProcessor interface
+    bool initialize() override;
+    void shutdown() override;
+
+    bool applyFilter(const FilterState& filter, const void* inputData,
+                   size_t inputSize, void* outputData, size_t outputSize) override;
+
+    bool supportsFormat(const std::string& format) const override;
+    bool supportsFilter(FilterType type) const override;
+
+    std::string getName() const override;
+    std::vector<FilterInfo> getSupportedFilters() const override;
+    std::shared_ptr<IFilterProcessor> clone() const override;
+
+    // Préféré au processeur FFmpeg pour les filtres ponctuels
+    int getPriority() const override { return 10; }
+
+    bool setVideoFormat(int width, int height, const std::string& pixelFormat) override;
+
+    // pixFormat: "bgra" ou "rgba". In-place autorisé (inputData == outputData).
+    bool applyFilterWithStride(const FilterState& filter,
+                               const uint8_t* inputData,
+                               int inputStride,
+                               int width,
+                               int height,
+                               const char* pixFormat,
+                               uint8_t* outputData,
+                               int outputStride);
+
+    // Compilation (pas d'allocation) : false si le filtre n'est pas ponctuel
+    static bool canCompile(const FilterState& filter);
+    static ColorMatrixProgram compile(const FilterState& filter);
+
+    // Noyau : SIMD selon la cible, allowSimd=false force la référence scalaire
+    static void apply(const ColorMatrixProgram& program,
+                      const uint8_t* inputData, int inputStride,
+                      int width, int height, bool bgra,
+                      uint8_t* outputData, int outputStride,
+                      bool allowSimd = true);
+
+    // Évaluation flottante d'une couleur (0..1, en place) : courbes interpolées
+    // linéairement entre leurs 256 entrées (compilation de chaînes en LUT 3D)
+    static void evaluate(const ColorMatrixProgram& program, float* rgb);
+
+private:
+    bool initialized_{false};
+    std::string lastError_;
+
+    int width_{0};
+    int height_{0};
+    std::string pixelFormat_{"bgra"};
+
+    // Cache : recompilation seulement si le filtre change
+    bool hasProgram_{false};
+    FilterType lastType_{FilterType::NONE};
+    FilterParams lastParams_;
+    ColorMatrixProgram program_;
+
+    const ColorMatrixProgram& programFor(const FilterState& filter);
+    void setLastError(const std::string& error);
+};
+
+} // namespace Camera
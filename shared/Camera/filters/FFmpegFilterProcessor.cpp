@@ -1,4 +1,7 @@
 #include "FFmpegFilterProcessor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <cstring>
 
@@ -12,6 +15,7 @@ extern "C" {
     #include <libavutil/frame.h>
     #include <libavutil/imgutils.h>
     #include <libavutil/pixfmt.h>
+    #include <libavutil/cpu.h>
     #include <libavutil/opt.h>
     #include <libavutil/pixdesc.h>
 }
@@ -71,19 +75,17 @@ bool FFmpegFilterProcessor::applyFilter(const FilterState& filter, const void* i
     }
     
     #ifdef FFMPEG_AVAILABLE
-    // Implémentation optimisée: supposer buffer packé et utiliser format courant
+    // Buffer contigu sans padding : stride de la luma (ou du plan packé), plans suivants derrière
     if (width_ <= 0 || height_ <= 0) { setLastError("Format vidéo non défini"); return false; }
     const char* fmt = pixelFormat_.empty() ? "yuv420p" : pixelFormat_.c_str();
-    int stride = 0;
-    // Estimer stride packé minimal lorsque inputSize est fourni (fallback)
-    if (std::strcmp(fmt, "bgra") == 0 || std::strcmp(fmt, "rgba") == 0 || std::strcmp(fmt, "rgb0") == 0) {
-        stride = width_ * 4;
-    } else if (std::strcmp(fmt, "rgb24") == 0 || std::strcmp(fmt, "bgr24") == 0) {
-        stride = width_ * 3;
-    }
-    if (stride == 0) {
-        // Repli: tenter packé via imgutils
-        stride = width_ * 4;
+    AVPixelFormat pix = av_get_pix_fmt(fmt);
+    if (pix == AV_PIX_FMT_NONE) pix = AV_PIX_FMT_BGRA;
+    const int stride = av_image_get_linesize(pix, width_, 0);
+    const int frameSize = av_image_get_buffer_size(pix, width_, height_, 1);
+    if (stride <= 0 || frameSize <= 0) { setLastError("Format de pixel inconnu"); return false; }
+    if (inputSize < static_cast<size_t>(frameSize) || outputSize < static_cast<size_t>(frameSize)) {
+        setLastError("Taille de buffer insuffisante");
+        return false;
     }
     return applyFilterWithStride(filter,
                                  reinterpret_cast<const uint8_t*>(inputData),
@@ -110,7 +112,7 @@ bool FFmpegFilterProcessor::supportsFormat(const std::string& format) const {
     #ifdef FFMPEG_AVAILABLE
     // Formats supportés par FFmpeg
     static const std::vector<std::string> supportedFormats = {
-        "yuv420p", "yuv422p", "yuv444p", "rgb24", "bgr24", "rgba", "bgra"
+        "yuv420p", "yuv422p", "yuv444p", "nv12", "rgb24", "bgr24", "rgba", "bgra"
     };
     
     return std::find(supportedFormats.begin(), supportedFormats.end(), format) != supportedFormats.end();
@@ -170,64 +172,481 @@ bool FFmpegFilterProcessor::setVideoFormat(int width, int height, const std::str
     return true;
 }
 
+std::shared_ptr<IFilterProcessor> FFmpegFilterProcessor::clone() const {
+    auto copy = std::make_shared<FFmpegFilterProcessor>();
+    if (initialized_) copy->initialize();
+    copy->width_ = width_;
+    copy->height_ = height_;
+    copy->pixelFormat_ = pixelFormat_;
+    copy->frameRate_ = frameRate_;
+    copy->liveUpdates_ = liveUpdates_;
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    copy->cacheCapacity_ = cacheCapacity_;
+    copy->graphThreads_ = 1;
+    return copy;
+}
+
 bool FFmpegFilterProcessor::setFrameRate(int fps) {
     frameRate_ = fps;
     std::cout << "[FFmpegFilterProcessor] Frame rate: " << fps << " fps" << std::endl;
     return true;
 }
 
+// Graphe FFmpeg construit pour une topologie et un format donnés
+struct FFmpegFilterProcessor::GraphInstance {
+    AVFilterGraph* graph{nullptr};
+    AVFilterContext* source{nullptr};
+    AVFilterContext* sink{nullptr};
+    std::string key;                // clé du cache (format + topologie)
+    int width{0};
+    int height{0};
+    int frameRate{0};
+    std::string pixelFormat;
+    int threads{0};
+    double buildMs{0.0};
+    uint64_t hits{0};
+    std::vector<GraphNode> nodes;   // valeurs actuellement appliquées
+    bool stale{false};              // commande refusée : reconstruction nécessaire
+
+    FFmpegGraphInfo info(bool active) const;
+    ~GraphInstance();
+};
+
+FFmpegGraphInfo FFmpegFilterProcessor::GraphInstance::info(bool active) const {
+    FFmpegGraphInfo info;
+    for (const auto& node : nodes) {
+        if (!info.description.empty()) info.description += ",";
+        info.description += node.label;
+        if (!node.fixedArgs.empty()) info.description += "=" + node.fixedArgs;
+    }
+    info.width = width;
+    info.height = height;
+    info.pixelFormat = pixelFormat;
+    info.frameRate = frameRate;
+    info.threads = threads;
+    info.buildMs = buildMs;
+    info.hits = hits;
+    info.active = active;
+    return info;
+}
+
+FFmpegFilterProcessor::GraphInstance::~GraphInstance() {
+    #ifdef FFMPEG_AVAILABLE
+    if (graph) {
+        avfilter_graph_free(&graph);
+    }
+    #endif
+}
+
+std::string FFmpegFilterProcessor::GraphPlan::description() const {
+    std::string desc;
+    for (const auto& node : nodes) {
+        if (!desc.empty()) desc += ",";
+        desc += node.label;
+        std::string args = node.fixedArgs;
+        for (const auto& param : node.params) {
+            if (!args.empty()) args += ":";
+            args += param.first + "=" + param.second;
+        }
+        if (!args.empty()) desc += "=" + args;
+    }
+    return desc;
+}
+
+void FFmpegFilterProcessor::setLiveParameterUpdates(bool enabled) {
+    liveUpdates_ = enabled;
+}
+
+FFmpegGraphStats FFmpegFilterProcessor::getGraphStats() const {
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    return stats_;
+}
+
+void FFmpegFilterProcessor::setGraphCacheCapacity(size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        cacheCapacity_ = capacity;
+        while (cache_.size() > cacheCapacity_) {
+            cacheIndex_.erase(cache_.back()->key);
+            retired_.push_back(std::move(cache_.back()));
+            cache_.pop_back();
+            ++stats_.evictions;
+        }
+        if (!retired_.empty()) startBuilderLocked();
+    }
+    buildWake_.notify_one();
+}
+
+void FFmpegFilterProcessor::setGraphThreads(int threads) {
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    graphThreads_ = std::max(0, threads);
+}
+
+std::vector<FFmpegGraphInfo> FFmpegFilterProcessor::getGraphCacheInfo() const {
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    std::vector<FFmpegGraphInfo> infos;
+    if (activeInfo_.active) infos.push_back(activeInfo_);
+    for (const auto& instance : cache_) {
+        infos.push_back(instance->info(false));
+    }
+    return infos;
+}
+
+void FFmpegFilterProcessor::prewarmBuiltinLooks(int width, int height, const std::string& pixelFormat, int frameRate) {
+    static const FilterType looks[] = {
+        FilterType::SEPIA, FilterType::NOIR, FilterType::MONOCHROME,
+        FilterType::VINTAGE, FilterType::COOL, FilterType::WARM
+    };
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        for (FilterType look : looks) {
+            // Au-delà de la capacité, un graphe préchauffé serait évincé aussitôt construit
+            if (queued >= cacheCapacity_) break;
+            BuildJob job;
+            job.plan = planFilter(FilterState(look, FilterParams()));
+            if (job.plan.nodes.empty()) continue;
+            job.key = graphKey(job.plan, width, height, pixelFormat, frameRate);
+            // Looks de même topologie : un seul graphe
+            const bool queuedAlready = std::any_of(prewarmJobs_.begin(), prewarmJobs_.end(),
+                                                   [&job](const BuildJob& other) { return other.key == job.key; });
+            if (queuedAlready || cacheIndex_.count(job.key)) continue;
+            job.width = width;
+            job.height = height;
+            job.frameRate = frameRate;
+            job.pixelFormat = pixelFormat;
+            prewarmJobs_.push_back(std::move(job));
+            ++queued;
+        }
+        if (queued) startBuilderLocked();
+    }
+    buildWake_.notify_one();
+    std::cout << "[FFmpegFilterProcessor] Préchauffage: " << queued << " looks (" << width << "x" << height
+              << " " << pixelFormat << ")" << std::endl;
+}
+
+void FFmpegFilterProcessor::waitForBuilds() {
+    std::unique_lock<std::mutex> lock(buildMutex_);
+    buildIdle_.wait(lock, [this] {
+        return buildStop_ || !builder_.joinable() || (!buildPending_ && prewarmJobs_.empty() && !building_);
+    });
+}
+
+bool FFmpegFilterProcessor::isGraphUpToDate() const {
+    return active_ && !active_->stale && active_->key == wantedKey_;
+}
+
+std::string FFmpegFilterProcessor::graphKey(const GraphPlan& plan, int width, int height,
+                                            const std::string& pixelFormat, int frameRate) const {
+    // Les options modifiables à chaud ne font pas partie de la clé : elles sont poussées par commande
+    std::string key = std::to_string(width) + "x" + std::to_string(height) + "|" + pixelFormat + "|" +
+                      std::to_string(frameRate);
+    for (const auto& node : plan.nodes) {
+        key += "|" + node.label + "=" + node.fixedArgs;
+        if (!liveUpdates_) {
+            for (const auto& param : node.params) key += ":" + param.second;
+        }
+    }
+    return key;
+}
+
+void FFmpegFilterProcessor::startBuilderLocked() {
+    if (!builder_.joinable()) {
+        builder_ = std::thread(&FFmpegFilterProcessor::builderLoop, this);
+    }
+}
+
+void FFmpegFilterProcessor::recordBuildLocked(double ms) {
+    ++stats_.builds;
+    stats_.lastBuildMs = ms;
+    stats_.totalBuildMs += ms;
+    stats_.maxBuildMs = std::max(stats_.maxBuildMs, ms);
+}
+
+void FFmpegFilterProcessor::retire(std::unique_ptr<GraphInstance> instance) {
+    if (!instance) return;
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        retired_.push_back(std::move(instance));
+        startBuilderLocked();
+    }
+    buildWake_.notify_one();
+}
+
+void FFmpegFilterProcessor::cacheGraphLocked(std::unique_ptr<GraphInstance> instance) {
+    if (!instance) return;
+    // Graphe invalide, cache désactivé ou doublon : libéré par le thread de construction
+    if (instance->stale || cacheCapacity_ == 0 || cacheIndex_.count(instance->key)) {
+        retired_.push_back(std::move(instance));
+        startBuilderLocked();
+        return;
+    }
+    const std::string key = instance->key;
+    cache_.push_front(std::move(instance));
+    cacheIndex_[key] = cache_.begin();
+    while (cache_.size() > cacheCapacity_) {
+        cacheIndex_.erase(cache_.back()->key);
+        retired_.push_back(std::move(cache_.back()));
+        cache_.pop_back();
+        ++stats_.evictions;
+    }
+    if (!retired_.empty()) startBuilderLocked();
+}
+
+void FFmpegFilterProcessor::cacheGraph(std::unique_ptr<GraphInstance> instance) {
+    if (!instance) return;
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        cacheGraphLocked(std::move(instance));
+    }
+    buildWake_.notify_one();
+}
+
+std::unique_ptr<FFmpegFilterProcessor::GraphInstance> FFmpegFilterProcessor::takeCached(const std::string& key) {
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    auto it = cacheIndex_.find(key);
+    if (it == cacheIndex_.end()) return nullptr;
+    std::unique_ptr<GraphInstance> instance = std::move(*it->second);
+    cache_.erase(it->second);
+    cacheIndex_.erase(it);
+    ++instance->hits;
+    ++stats_.cacheHits;
+    return instance;
+}
+
+void FFmpegFilterProcessor::setActive(std::unique_ptr<GraphInstance> instance) {
+    // L'ancien graphe retourne en cache (en tête de LRU)
+    cacheGraph(std::move(active_));
+    active_ = std::move(instance);
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    activeInfo_ = active_ ? active_->info(true) : FFmpegGraphInfo();
+}
+
+bool FFmpegFilterProcessor::requestBuild(const GraphPlan& plan, const std::string& key) {
+    // Une seule demande par topologie : les curseurs suivants passent par configureFilter
+    if (key == requestedKey_) return false;
+    requestedKey_ = key;
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        buildJob_.plan = plan;
+        buildJob_.key = key;
+        buildJob_.width = width_;
+        buildJob_.height = height_;
+        buildJob_.frameRate = frameRate_;
+        buildJob_.pixelFormat = pixelFormat_;
+        buildPending_ = true;
+        startBuilderLocked();
+    }
+    buildWake_.notify_one();
+    return true;
+}
+
+void FFmpegFilterProcessor::builderLoop() {
+    std::unique_lock<std::mutex> lock(buildMutex_);
+    while (true) {
+        buildWake_.wait(lock, [this] {
+            return buildStop_ || buildPending_ || !prewarmJobs_.empty() || !retired_.empty();
+        });
+        std::vector<std::unique_ptr<GraphInstance>> garbage;
+        garbage.swap(retired_);
+        if (buildStop_) break;
+
+        // Demande du thread image d'abord (fusionnée avec celles arrivées entre-temps), puis préchauffage
+        BuildJob job;
+        bool prewarm = false;
+        if (buildPending_) {
+            job = buildJob_;
+            buildPending_ = false;
+        } else if (!prewarmJobs_.empty()) {
+            job = std::move(prewarmJobs_.front());
+            prewarmJobs_.pop_front();
+            prewarm = true;
+        }
+        if (job.key.empty() || (prewarm && cacheIndex_.count(job.key))) {
+            lock.unlock();
+            garbage.clear();
+            lock.lock();
+            if (!buildPending_ && prewarmJobs_.empty() && !building_) buildIdle_.notify_all();
+            continue;
+        }
+        const int threads = graphThreads_;
+        building_ = true;
+        lock.unlock();
+        garbage.clear();
+
+        std::string error;
+        const auto t0 = std::chrono::steady_clock::now();
+        std::unique_ptr<GraphInstance> instance = createFilterGraph(job.plan, job.width, job.height, job.pixelFormat,
+                                                                    job.frameRate, threads, error);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (instance) {
+            instance->key = job.key;
+            instance->buildMs = ms;
+        } else {
+            std::cout << "[FFmpegFilterProcessor] Erreur: construction en arrière-plan échouée (" << error
+                      << "), graphe précédent conservé" << std::endl;
+        }
+
+        GraphInstance* previous = nullptr;
+        if (instance && !prewarm) {
+            // Échange atomique : le thread image adopte le graphe à la prochaine image
+            previous = ready_.exchange(instance.release(), std::memory_order_acq_rel);
+        }
+        lock.lock();
+        building_ = false;
+        if (error.empty()) {
+            recordBuildLocked(ms);
+            if (prewarm) {
+                ++stats_.prewarmBuilds;
+                cacheGraphLocked(std::move(instance));
+            } else {
+                ++stats_.asyncBuilds;
+            }
+        }
+        // Graphe prêt jamais adopté (demande remplacée) : gardé en cache
+        if (previous) cacheGraphLocked(std::unique_ptr<GraphInstance>(previous));
+        if (!buildPending_ && prewarmJobs_.empty()) buildIdle_.notify_all();
+    }
+    building_ = false;
+    buildIdle_.notify_all();
+}
+
+void FFmpegFilterProcessor::destroyFilterGraph() {
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        buildStop_ = true;
+    }
+    buildWake_.notify_all();
+    if (builder_.joinable()) {
+        builder_.join();
+    }
+    delete ready_.exchange(nullptr, std::memory_order_acq_rel);
+    retired_.clear();
+    cacheIndex_.clear();
+    cache_.clear();
+    prewarmJobs_.clear();
+    active_.reset();
+    activeInfo_ = FFmpegGraphInfo();
+    buildStop_ = false;
+    buildPending_ = false;
+    requestedKey_.clear();
+    wantedKey_.clear();
+
+    #ifdef FFMPEG_AVAILABLE
+    if (inputFrame_) {
+        av_frame_free(&inputFrame_);
+        inputFrame_ = nullptr;
+    }
+    
+    if (outputFrame_) {
+        av_frame_free(&outputFrame_);
+        outputFrame_ = nullptr;
+    }
+    #endif
+}
+
 // Méthodes privées
 #ifdef FFMPEG_AVAILABLE
-bool FFmpegFilterProcessor::ensureGraph(const FilterState& filter) {
-    // Optimisation: cache le graphe et évite la reconstruction inutile
-    std::string filterString = getFFmpegFilterString(filter);
-    if (filterString.empty()) { setLastError("Filtre FFmpeg non supporté"); return false; }
-    
-    bool formatChanged = (lastWidth_ != width_) || (lastHeight_ != height_) || 
-                        (lastPixelFormat_ != pixelFormat_) || (lastFrameRate_ != frameRate_);
-    bool filterChanged = (lastFilterDesc_ != filterString);
-    
-    // Optimisation: ne reconstruire que si vraiment nécessaire
-    if (filterGraph_ && !formatChanged && !filterChanged) {
-        return true;
+namespace {
+
+// Lignes d'un plan : chroma sous-échantillonnée (plans 1 et 2 des formats YUV)
+int planeRows(const AVPixFmtDescriptor* desc, int plane, int height) {
+    const bool chroma = (plane == 1 || plane == 2) && !(desc->flags & AV_PIX_FMT_FLAG_RGB);
+    return chroma ? -((-height) >> desc->log2_chroma_h) : height;
+}
+
+// Plans d'un buffer unique : plans successifs, padding de chroma proportionnel à celui de la luma
+bool contiguousPlanes(AVPixelFormat pix, uint8_t* base, int stride, int width, int height,
+                      uint8_t* data[4], int linesize[4]) {
+    int natural[4];
+    if (!base || av_image_fill_linesizes(natural, pix, width) < 0 || natural[0] <= 0 || stride < natural[0]) {
+        return false;
     }
-    
-    // Utiliser un pool de frames pour éviter les allocations répétées
-    static thread_local AVFrame* framePool[4] = {nullptr, nullptr, nullptr, nullptr};
-    static thread_local int poolIndex = 0;
-    
-    // (Re)créer graphe si nécessaire
-    if (formatChanged || !filterGraph_) {
-        destroyFilterGraph();
-        if (!createFilterGraph()) return false;
-        if (!addFilterToGraph(filter)) return false;
+    for (int i = 0; i < 4; ++i) {
+        linesize[i] = static_cast<int>(static_cast<int64_t>(natural[i]) * stride / natural[0]);
     }
-    
-    // Réutiliser les frames du pool
-    if (!inputFrame_) {
-        if (framePool[0] == nullptr) {
-            framePool[0] = av_frame_alloc();
+    return av_image_fill_pointers(data, pix, height, base, linesize) >= 0;
+}
+
+// Libération d'un plan de l'appelant par le graphe (la mémoire reste à l'appelant)
+void releaseCallerPlane(void* opaque, uint8_t*) {
+    static_cast<std::atomic<int>*>(opaque)->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool sameNode(const std::string& label, const std::string& filter, const std::string& fixedArgs,
+              const std::string& otherLabel, const std::string& otherFilter, const std::string& otherFixed) {
+    return label == otherLabel && filter == otherFilter && fixedArgs == otherFixed;
+}
+
+} // namespace
+
+bool FFmpegFilterProcessor::ensureGraph(const FilterState& filter) {
+    // Optimisation: cache le graphe et évite la reconstruction inutile
+    GraphPlan plan = planFilter(filter);
+    if (plan.nodes.empty()) { setLastError("Filtre FFmpeg non supporté"); return false; }
+    const std::string key = graphKey(plan, width_, height_, pixelFormat_, frameRate_);
+    wantedKey_ = key;
+
+    // Adopter le graphe reconstruit en arrière-plan s'il est prêt
+    if (GraphInstance* ready = ready_.exchange(nullptr, std::memory_order_acq_rel)) {
+        std::unique_ptr<GraphInstance> built(ready);
+        if (built->key == key) {
+            setActive(std::move(built));
+            requestedKey_.clear();
+            std::lock_guard<std::mutex> lock(buildMutex_);
+            ++stats_.swaps;
+        } else {
+            cacheGraph(std::move(built));
         }
-        inputFrame_ = framePool[0];
     }
-    if (!outputFrame_) {
-        if (framePool[1] == nullptr) {
-            framePool[1] = av_frame_alloc();
+
+    if (!active_ || active_->key != key) {
+        std::unique_ptr<GraphInstance> cached = takeCached(key);
+        const bool formatChanged = !active_ || active_->width != width_ || active_->height != height_ ||
+                                   active_->pixelFormat != pixelFormat_ || active_->frameRate != frameRate_;
+        if (cached) {
+            // Graphe déjà configuré : échange immédiat, sans parse ni config
+            setActive(std::move(cached));
+        } else if (formatChanged || !liveUpdates_) {
+            // Premier graphe ou changement de format : l'ancien graphe ne peut plus rien servir
+            int threads;
+            {
+                std::lock_guard<std::mutex> lock(buildMutex_);
+                threads = graphThreads_;
+                ++stats_.cacheMisses;
+            }
+            std::string error;
+            const auto t0 = std::chrono::steady_clock::now();
+            std::unique_ptr<GraphInstance> instance = createFilterGraph(plan, width_, height_, pixelFormat_,
+                                                                        frameRate_, threads, error);
+            if (!instance) { setLastError(error); return false; }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            instance->key = key;
+            instance->buildMs = ms;
+            setActive(std::move(instance));
+            requestedKey_.clear();
+            std::lock_guard<std::mutex> lock(buildMutex_);
+            ++stats_.syncBuilds;
+            recordBuildLocked(ms);
+        } else if (requestBuild(plan, key)) {
+            // Topologie inconnue : construction hors thread image. D'ici l'échange, l'ancien graphe
+            // reste servi avec les nœuds communs à jour et les nœuds en trop neutralisés.
+            std::lock_guard<std::mutex> lock(buildMutex_);
+            ++stats_.cacheMisses;
         }
-        outputFrame_ = framePool[1];
+    } else if (active_->stale) {
+        requestBuild(plan, key);
     }
-    
+
+    // Frames réutilisées d'une image à l'autre
+    if (!inputFrame_) inputFrame_ = av_frame_alloc();
+    if (!outputFrame_) outputFrame_ = av_frame_alloc();
     if (!inputFrame_ || !outputFrame_) { 
         setLastError("Impossible d'allouer les frames FFmpeg"); 
         return false; 
     }
-    
-    lastWidth_ = width_;
-    lastHeight_ = height_;
-    lastPixelFormat_ = pixelFormat_;
-    lastFrameRate_ = frameRate_;
-    lastFilterDesc_ = filterString;
-    return true;
+
+    return configureFilter(*active_, plan);
 }
 
 bool FFmpegFilterProcessor::applyFilterWithStride(const FilterState& filter,
@@ -238,6 +657,28 @@ bool FFmpegFilterProcessor::applyFilterWithStride(const FilterState& filter,
                                const char* pixFormat,
                                uint8_t* outputData,
                                int outputStride) {
+    AVPixelFormat pix = av_get_pix_fmt(pixFormat ? pixFormat : "bgra");
+    if (pix == AV_PIX_FMT_NONE) pix = AV_PIX_FMT_BGRA;
+    uint8_t* inPlanes[4];
+    uint8_t* outPlanes[4];
+    int inLinesizes[4];
+    int outLinesizes[4];
+    if (!contiguousPlanes(pix, const_cast<uint8_t*>(inputData), inputStride, width, height, inPlanes, inLinesizes) ||
+        !contiguousPlanes(pix, outputData, outputStride, width, height, outPlanes, outLinesizes)) {
+        setLastError("Stride invalide pour le format");
+        return false;
+    }
+    return applyFilterToPlanes(filter, inPlanes, inLinesizes, width, height, pixFormat, outPlanes, outLinesizes);
+}
+
+bool FFmpegFilterProcessor::applyFilterToPlanes(const FilterState& filter,
+                                                const uint8_t* const inputPlanes[4],
+                                                const int inputLinesizes[4],
+                                                int width,
+                                                int height,
+                                                const char* pixFormat,
+                                                uint8_t* const outputPlanes[4],
+                                                const int outputLinesizes[4]) {
     if (!initialized_) { setLastError("Processeur non initialisé"); return false; }
     pixelFormat_ = pixFormat ? std::string(pixFormat) : std::string("bgra");
     width_ = width; height_ = height;
@@ -245,145 +686,143 @@ bool FFmpegFilterProcessor::applyFilterWithStride(const FilterState& filter,
 
     AVPixelFormat pix = av_get_pix_fmt(pixelFormat_.c_str());
     if (pix == AV_PIX_FMT_NONE) pix = AV_PIX_FMT_BGRA;
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(pix);
+    const int planes = av_pix_fmt_count_planes(pix);
+    if (!desc || planes <= 0) { setLastError("Format de pixel inconnu"); return false; }
 
-    // Optimisation: éviter av_frame_unref si possible
-    // Préparer frame d'entrée en référençant directement les données + stride
+    // Entrée : plans de l'appelant enveloppés dans des AVBufferRef, sans copie. En lecture seule
+    // sauf en place, où les filtres qui écrivent dans leur entrée (colorbalance, hue, lut3d...)
+    // produisent directement dans les plans de sortie.
+    bool inPlace = true;
+    for (int i = 0; i < planes; ++i) {
+        inPlace = inPlace && inputPlanes[i] == outputPlanes[i] && inputLinesizes[i] == outputLinesizes[i];
+    }
+    const bool wrap = copyInputKeys_.count(active_->key) == 0;
     inputFrame_->width = width_;
     inputFrame_->height = height_;
     inputFrame_->format = pix;
-    inputFrame_->data[0] = const_cast<uint8_t*>(inputData);
-    inputFrame_->linesize[0] = inputStride;
-    
-    // Pour formats YUV, configurer les plans supplémentaires
-    if (pix == AV_PIX_FMT_YUV420P || pix == AV_PIX_FMT_YUV422P || pix == AV_PIX_FMT_YUV444P) {
-        int chromaHeight = (pix == AV_PIX_FMT_YUV420P) ? height_ / 2 : height_;
-        int chromaWidth = (pix == AV_PIX_FMT_YUV420P || pix == AV_PIX_FMT_YUV422P) ? width_ / 2 : width_;
-        inputFrame_->data[1] = inputFrame_->data[0] + (inputStride * height_);
-        inputFrame_->data[2] = inputFrame_->data[1] + (chromaWidth * chromaHeight);
-        inputFrame_->linesize[1] = inputFrame_->linesize[2] = chromaWidth;
+    for (int i = 0; i < planes; ++i) {
+        if (!inputPlanes[i] || inputLinesizes[i] < av_image_get_linesize(pix, width_, i)) {
+            av_frame_unref(inputFrame_);
+            setLastError("Plan d'entrée invalide");
+            return false;
+        }
+        inputFrame_->data[i] = const_cast<uint8_t*>(inputPlanes[i]);
+        inputFrame_->linesize[i] = inputLinesizes[i];
+        if (!wrap) continue;
+        const size_t size = static_cast<size_t>(inputLinesizes[i]) * planeRows(desc, i, height_);
+        inputFrame_->buf[i] = av_buffer_create(inputFrame_->data[i], size, releaseCallerPlane, &callerRefs_,
+                                               inPlace ? 0 : AV_BUFFER_FLAG_READONLY);
+        if (!inputFrame_->buf[i]) {
+            av_frame_unref(inputFrame_);
+            setLastError("Impossible d'envelopper le plan d'entrée");
+            return false;
+        }
+        callerRefs_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    // Pousser la frame avec flag optimisé
-    int ret = av_buffersrc_add_frame_flags(sourceContext_, inputFrame_, AV_BUFFERSRC_FLAG_KEEP_REF | AV_BUFFERSRC_FLAG_PUSH);
+    // Frame comptée : références transférées au graphe. Sinon KEEP_REF copie l'image.
+    int ret = av_buffersrc_add_frame_flags(active_->source, inputFrame_,
+                                           wrap ? AV_BUFFERSRC_FLAG_PUSH
+                                                : AV_BUFFERSRC_FLAG_KEEP_REF | AV_BUFFERSRC_FLAG_PUSH);
+    av_frame_unref(inputFrame_);
     if (ret < 0) { setLastError("buffersrc_add_frame a échoué"); return false; }
 
-    // Tirer la frame
-    ret = av_buffersink_get_frame(sinkContext_, outputFrame_);
-    if (ret < 0) { setLastError("buffersink_get_frame a échoué"); return false; }
-
-    // Optimisation: copie SIMD pour les formats supportés
-    const int outLinesize = outputFrame_->linesize[0];
-    const int rowBytes = av_get_bits_per_pixel(av_pix_fmt_desc_get((AVPixelFormat)outputFrame_->format)) * outputFrame_->width / 8;
-    
-    if (outputStride < rowBytes) {
-        av_frame_unref(outputFrame_);
-        setLastError("outputStride insuffisant");
+    ret = av_buffersink_get_frame(active_->sink, outputFrame_);
+    if (ret < 0) {
+        setLastError("buffersink_get_frame a échoué");
+        releaseCallerPlanes();
         return false;
     }
-    
-    // Utiliser copie SIMD si disponible
-    #ifdef __AVX2__
-    if (rowBytes >= 32) {
-        for (int y = 0; y < outputFrame_->height; ++y) {
-            const uint8_t* srcRow = outputFrame_->data[0] + y * outLinesize;
-            uint8_t* dstRow = outputData + y * outputStride;
-            
-            size_t simdBytes = rowBytes & ~31;
-            for (size_t x = 0; x < simdBytes; x += 32) {
-                __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(srcRow + x));
-                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + x), data);
-            }
-            
-            // Copier les octets restants
-            if (simdBytes < rowBytes) {
-                std::memcpy(dstRow + simdBytes, srcRow + simdBytes, rowBytes - simdBytes);
-            }
-        }
-    } else
-    #endif
-    {
-        // Fallback vers memcpy standard
-        for (int y = 0; y < outputFrame_->height; ++y) {
-            const uint8_t* srcRow = outputFrame_->data[0] + y * outLinesize;
-            uint8_t* dstRow = outputData + y * outputStride;
-            std::memcpy(dstRow, srcRow, (size_t)rowBytes);
+
+    // Sortie : les plans écrits en place n'ont pas à être recopiés
+    bool ok = true;
+    int copied = 0;
+    for (int i = 0; i < planes; ++i) {
+        if (outputFrame_->data[i] == outputPlanes[i] && outputFrame_->linesize[i] == outputLinesizes[i]) continue;
+        const int rowBytes = av_image_get_linesize(pix, outputFrame_->width, i);
+        if (!outputPlanes[i] || rowBytes <= 0 || outputLinesizes[i] < rowBytes) {
+            setLastError("outputStride insuffisant");
+            ok = false;
+            break;
         }
+        av_image_copy_plane(outputPlanes[i], outputLinesizes[i], outputFrame_->data[i], outputFrame_->linesize[i],
+                            rowBytes, planeRows(desc, i, outputFrame_->height));
+        ++copied;
     }
-    
-    // Ne pas faire av_frame_unref sur les frames du pool, juste réinitialiser les pointeurs
-    outputFrame_->data[0] = nullptr;
-    return true;
-}
-bool FFmpegFilterProcessor::createFilterGraph() {
-    if (filterGraph_) {
-        destroyFilterGraph();
-    }
-    
-    filterGraph_ = avfilter_graph_alloc();
-    if (!filterGraph_) {
-        setLastError("Impossible de créer le graphe de filtres FFmpeg");
-        return false;
+    // Rend les buffers au pool du graphe (et les références sur l'entrée)
+    av_frame_unref(outputFrame_);
+    releaseCallerPlanes();
+    if (ok) {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        stats_.planesCopied += copied;
+        if (copied == 0) ++stats_.zeroCopyFrames;
+        if (!wrap) ++stats_.inputCopies;
     }
-    
-    return true;
+    return ok;
 }
 
-void FFmpegFilterProcessor::destroyFilterGraph() {
-    if (filterGraph_) {
-        avfilter_graph_free(&filterGraph_);
-        filterGraph_ = nullptr;
-    }
-    
-    if (inputFrame_) {
-        av_frame_free(&inputFrame_);
-        inputFrame_ = nullptr;
-    }
-    
-    if (outputFrame_) {
-        av_frame_free(&outputFrame_);
-        outputFrame_ = nullptr;
-    }
-    
-    sourceContext_ = nullptr;
-    sinkContext_ = nullptr;
+void FFmpegFilterProcessor::releaseCallerPlanes() {
+    if (callerRefs_.load(std::memory_order_acquire) == 0 || !active_) return;
+    // Un filtre garde une image de l'appelant au-delà de l'appel : le graphe est libéré pour rendre
+    // la mémoire, et cette topologie copiera désormais son entrée
+    std::cout << "[FFmpegFilterProcessor] Référence conservée sur l'image d'entrée, copie activée pour "
+              << active_->key << std::endl;
+    copyInputKeys_.insert(active_->key);
+    active_.reset();
+    requestedKey_.clear();
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    activeInfo_ = FFmpegGraphInfo();
 }
 
-bool FFmpegFilterProcessor::addFilterToGraph(const FilterState& filter) {
-    if (!filterGraph_) {
-        return false;
+std::unique_ptr<FFmpegFilterProcessor::GraphInstance> FFmpegFilterProcessor::createFilterGraph(
+        const GraphPlan& plan, int width, int height, const std::string& pixelFormat, int frameRate,
+        int threads, std::string& error) const {
+    auto instance = std::make_unique<GraphInstance>();
+    instance->graph = avfilter_graph_alloc();
+    if (!instance->graph) {
+        error = "Impossible de créer le graphe de filtres FFmpeg";
+        return nullptr;
     }
-    
-    std::string filterString = getFFmpegFilterString(filter);
+    // Threads de tranche à fixer avant la création des filtres (0 : nombre de cœurs)
+    instance->graph->nb_threads = threads;
+    instance->threads = threads > 0 ? threads : av_cpu_count();
+    instance->width = width;
+    instance->height = height;
+    instance->pixelFormat = pixelFormat;
+    instance->frameRate = frameRate;
+
+    const std::string filterString = plan.description();
     if (filterString.empty()) {
-        setLastError("Filtre FFmpeg non supporté");
-        return false;
+        error = "Filtre FFmpeg non supporté";
+        return nullptr;
     }
 
     // Créer buffersrc/buffersink
     const AVFilter* buffersrc = avfilter_get_by_name("buffer");
     const AVFilter* buffersink = avfilter_get_by_name("buffersink");
     if (!buffersrc || !buffersink) {
-        setLastError("Impossible d'obtenir buffer/buffersink");
-        return false;
+        error = "Impossible d'obtenir buffer/buffersink";
+        return nullptr;
     }
 
     char args[256];
-    AVPixelFormat pix = av_get_pix_fmt(pixelFormat_.empty() ? "yuv420p" : pixelFormat_.c_str());
+    AVPixelFormat pix = av_get_pix_fmt(pixelFormat.empty() ? "yuv420p" : pixelFormat.c_str());
     if (pix == AV_PIX_FMT_NONE) pix = AV_PIX_FMT_YUV420P;
     snprintf(args, sizeof(args),
              "video_size=%dx%d:pix_fmt=%d:time_base=1/%d:frame_rate=%d/1:pixel_aspect=1/1",
-             width_, height_, pix, frameRate_, frameRate_);
+             width, height, pix, frameRate, frameRate);
 
-    int ret = avfilter_graph_create_filter(&sourceContext_, buffersrc, "in", args, NULL, filterGraph_);
-    if (ret < 0) { setLastError("create_filter buffer a échoué"); return false; }
+    int ret = avfilter_graph_create_filter(&instance->source, buffersrc, "in", args, NULL, instance->graph);
+    if (ret < 0) { error = "create_filter buffer a échoué"; return nullptr; }
 
-    ret = avfilter_graph_create_filter(&sinkContext_, buffersink, "out", NULL, NULL, filterGraph_);
-    if (ret < 0) { setLastError("create_filter buffersink a échoué"); return false; }
+    ret = avfilter_graph_create_filter(&instance->sink, buffersink, "out", NULL, NULL, instance->graph);
+    if (ret < 0) { error = "create_filter buffersink a échoué"; return nullptr; }
 
     // Verrouiller le format de sortie pour éviter conversions implicites
-    static const AVPixelFormat pix_fmts[] = { pix, AV_PIX_FMT_NONE };
-    ret = av_opt_set_int_list(sinkContext_, "pix_fmts", pix_fmts, AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN);
-    if (ret < 0) { setLastError("Impossible de fixer pix_fmts sur buffersink"); return false; }
+    const AVPixelFormat pix_fmts[] = { pix, AV_PIX_FMT_NONE };
+    ret = av_opt_set_int_list(instance->sink, "pix_fmts", pix_fmts, AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN);
+    if (ret < 0) { error = "Impossible de fixer pix_fmts sur buffersink"; return nullptr; }
 
     // Construire la description: [in]filterString[out]
     std::string desc = "[in]" + filterString + "[out]";
@@ -393,46 +832,97 @@ bool FFmpegFilterProcessor::addFilterToGraph(const FilterState& filter) {
     if (!outputs || !inputs) {
         if (outputs) avfilter_inout_free(&outputs);
         if (inputs) avfilter_inout_free(&inputs);
-        setLastError("Allocation AVFilterInOut a échoué");
-        return false;
+        error = "Allocation AVFilterInOut a échoué";
+        return nullptr;
     }
     outputs->name = av_strdup("in");
-    outputs->filter_ctx = sourceContext_;
+    outputs->filter_ctx = instance->source;
     outputs->pad_idx = 0;
     outputs->next = nullptr;
 
     inputs->name = av_strdup("out");
-    inputs->filter_ctx = sinkContext_;
+    inputs->filter_ctx = instance->sink;
     inputs->pad_idx = 0;
     inputs->next = nullptr;
 
-    ret = avfilter_graph_parse_ptr(filterGraph_, desc.c_str(), &inputs, &outputs, NULL);
+    ret = avfilter_graph_parse_ptr(instance->graph, desc.c_str(), &inputs, &outputs, NULL);
     if (ret < 0) {
         avfilter_inout_free(&outputs);
         avfilter_inout_free(&inputs);
-        setLastError("avfilter_graph_parse_ptr a échoué");
-        return false;
+        error = "avfilter_graph_parse_ptr a échoué";
+        return nullptr;
     }
     // Libérer les in/out maintenant que le graphe est parsé
     avfilter_inout_free(&outputs);
     avfilter_inout_free(&inputs);
-    ret = avfilter_graph_config(filterGraph_, NULL);
+    ret = avfilter_graph_config(instance->graph, NULL);
     if (ret < 0) {
-        setLastError("avfilter_graph_config a échoué");
-        return false;
+        error = "avfilter_graph_config a échoué";
+        return nullptr;
     }
 
-    std::cout << "[FFmpegFilterProcessor] Graphe FFmpeg configuré: " << filterString << std::endl;
-    return true;
+    // Contextes nommés pour les commandes à chaud
+    instance->nodes = plan.nodes;
+    for (auto& node : instance->nodes) {
+        node.context = avfilter_graph_get_filter(instance->graph, node.label.c_str());
+        if (!node.context) {
+            error = "Nœud introuvable dans le graphe: " + node.label;
+            return nullptr;
+        }
+    }
+
+    std::cout << "[FFmpegFilterProcessor] Graphe FFmpeg configuré: " << filterString
+              << " (threads: " << instance->threads << ")" << std::endl;
+    return instance;
 }
 
-bool FFmpegFilterProcessor::configureFilter(const FilterState& filter, AVFilterContext* filterCtx) {
-    // Configuration des paramètres du filtre FFmpeg
-    // Note: Implémentation simplifiée
+bool FFmpegFilterProcessor::configureFilter(GraphInstance& instance, const GraphPlan& plan) {
+    // Pousser uniquement les paramètres modifiés depuis la dernière image
+    char response[64];
+    uint64_t sent = 0;
+    uint64_t failed = 0;
+    for (auto& node : instance.nodes) {
+        const std::vector<std::pair<std::string, std::string>>* desired = nullptr;
+        for (const auto& wanted : plan.nodes) {
+            if (sameNode(node.label, node.filter, node.fixedArgs, wanted.label, wanted.filter, wanted.fixedArgs)) {
+                desired = &wanted.params;
+                break;
+            }
+        }
+        // Nœud absent du plan : neutralisé en attendant la reconstruction
+        if (!desired) desired = node.neutral.empty() ? nullptr : &node.neutral;
+        if (!desired) continue;
+
+        for (const auto& param : *desired) {
+            auto applied = std::find_if(node.params.begin(), node.params.end(),
+                                        [&](const auto& p) { return p.first == param.first; });
+            if (applied != node.params.end() && applied->second == param.second) continue;
+            response[0] = '\0';
+            const int ret = avfilter_process_command(node.context, param.first.c_str(), param.second.c_str(),
+                                                     response, sizeof(response), 0);
+            if (ret < 0) {
+                // Option non modifiable à chaud : le graphe sera reconstruit à l'image suivante
+                instance.stale = true;
+                ++failed;
+                continue;
+            }
+            if (applied != node.params.end()) {
+                applied->second = param.second;
+            } else {
+                node.params.push_back(param);
+            }
+            ++sent;
+        }
+    }
+    if (sent || failed) {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+        stats_.commandsSent += sent;
+        stats_.commandsFailed += failed;
+    }
     return true;
 }
 
-std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filter) const {
+FFmpegFilterProcessor::GraphPlan FFmpegFilterProcessor::planFilter(const FilterState& filter) const {
     auto escapeForFFmpeg = [](const std::string& path) -> std::string {
         std::string escaped;
         escaped.reserve(path.size() + 8);
@@ -444,9 +934,27 @@ std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filt
         }
         return escaped;
     };
+    auto num = [](double v) { return std::to_string(v); };
 
-    // Construire une chaîne combinée: ajustements (eq/gamma/hue) + effet principal (sepia/noir/... ou lut3d)
-    std::vector<std::string> parts;
+    // Ordre canonique des nœuds : ajustements (eq/hue) puis effet principal (colorbalance/hue ou lut3d).
+    // Les nœuds neutralisables restent en place quand un curseur revient au neutre.
+    GraphPlan plan;
+    auto add = [&plan](const char* label, const char* filterName) -> GraphNode& {
+        plan.nodes.emplace_back();
+        plan.nodes.back().label = label;
+        plan.nodes.back().filter = filterName;
+        return plan.nodes.back();
+    };
+    auto colorbalance = [&](double rs, double gs, double bs) {
+        GraphNode& node = add("colorbalance@effect", "colorbalance");
+        node.params = {{"rs", num(rs)}, {"gs", num(gs)}, {"bs", num(bs)}};
+        node.neutral = {{"rs", num(0.0)}, {"gs", num(0.0)}, {"bs", num(0.0)}};
+    };
+    auto saturation = [&](double s) {
+        GraphNode& node = add("hue@effect", "hue");
+        node.params = {{"s", num(s)}};
+        node.neutral = {{"s", num(1.0)}};
+    };
 
     // 1) Ajustements globaux à partir de FilterParams
     const bool needsEq = (std::abs(filter.params.brightness) > 1e-6) ||
@@ -454,34 +962,33 @@ std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filt
                          (std::abs(filter.params.saturation - 1.0) > 1e-6) ||
                          (std::abs(filter.params.gamma - 1.0) > 1e-6);
     if (needsEq) {
-        std::string eq = "eq=brightness=" + std::to_string(filter.params.brightness) +
-                         ":contrast=" + std::to_string(filter.params.contrast) +
-                         ":saturation=" + std::to_string(filter.params.saturation);
-        if (std::abs(filter.params.gamma - 1.0) > 1e-6) {
-            eq += ":gamma=" + std::to_string(filter.params.gamma);
-        }
-        parts.push_back(eq);
+        GraphNode& eq = add("eq@adjust", "eq");
+        eq.params = {{"brightness", num(filter.params.brightness)},
+                     {"contrast", num(filter.params.contrast)},
+                     {"saturation", num(filter.params.saturation)},
+                     {"gamma", num(filter.params.gamma)}};
+        eq.neutral = {{"brightness", num(0.0)}, {"contrast", num(1.0)},
+                      {"saturation", num(1.0)}, {"gamma", num(1.0)}};
     }
     if (std::abs(filter.params.hue) > 1e-6) {
         // Convertir degrés -> radians pour FFmpeg hue=h
-        const double radians = filter.params.hue * M_PI / 180.0;
-        parts.push_back("hue=h=" + std::to_string(radians));
+        GraphNode& hue = add("hue@adjust", "hue");
+        hue.params = {{"h", num(filter.params.hue * M_PI / 180.0)}};
+        hue.neutral = {{"h", num(0.0)}};
     }
 
     // 2) Effet principal selon le type
     switch (filter.type) {
         case FilterType::SEPIA: {
-            parts.push_back("colorbalance=rs=" + std::to_string(filter.params.intensity * 0.3) +
-                           ":gs=" + std::to_string(filter.params.intensity * 0.1) +
-                           ":bs=" + std::to_string(-filter.params.intensity * 0.4));
+            colorbalance(filter.params.intensity * 0.3, filter.params.intensity * 0.1, -filter.params.intensity * 0.4);
             break;
         }
         case FilterType::NOIR: {
-            parts.push_back("hue=s=0");
+            saturation(0.0);
             break;
         }
         case FilterType::MONOCHROME: {
-            parts.push_back("hue=s=0.5");
+            saturation(0.5);
             break;
         }
         case FilterType::COLOR_CONTROLS: {
@@ -489,15 +996,16 @@ std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filt
             break;
         }
         case FilterType::VINTAGE: {
-            parts.push_back("colorbalance=rs=0.2:gs=0.1:bs=-0.3,hue=s=0.8");
+            colorbalance(0.2, 0.1, -0.3);
+            saturation(0.8);
             break;
         }
         case FilterType::COOL: {
-            parts.push_back("colorbalance=rs=-0.2:gs=0.1:bs=0.3");
+            colorbalance(-0.2, 0.1, 0.3);
             break;
         }
         case FilterType::WARM: {
-            parts.push_back("colorbalance=rs=0.3:gs=0.1:bs=-0.2");
+            colorbalance(0.3, 0.1, -0.2);
             break;
         }
         case FilterType::CUSTOM: {
@@ -529,47 +1037,43 @@ std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filt
                         start = amp + 1;
                     }
                 }
-                std::string escapedPath = escapeForFFmpeg(path);
-                parts.push_back("lut3d=file='" + escapedPath + "':interp=" + interp);
+                // Le fichier fixe la topologie, l'interpolation se change à chaud
+                GraphNode& lut = add("lut3d@effect", "lut3d");
+                lut.fixedArgs = "file='" + escapeForFFmpeg(path) + "'";
+                lut.params = {{"interp", interp}};
             }
             break;
         }
         default:
             break;
     }
+    return plan;
+}
 
-    if (parts.empty()) {
-        return "";
-    }
-    // Joindre par virgule
-    std::string combined = parts[0];
-    for (size_t i = 1; i < parts.size(); ++i) {
-        combined += "," + parts[i];
-    }
-    return combined;
+std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filter) const {
+    return planFilter(filter).description();
 }
 #else
-bool FFmpegFilterProcessor::createFilterGraph() {
+std::unique_ptr<FFmpegFilterProcessor::GraphInstance> FFmpegFilterProcessor::createFilterGraph(
+        const GraphPlan& /*plan*/, int /*width*/, int /*height*/, const std::string& /*pixelFormat*/,
+        int /*frameRate*/, int /*threads*/, std::string& error) const {
     // Mode fallback: pas de graphe FFmpeg
-    return true;
+    error = "FFmpeg non disponible";
+    return nullptr;
 }
 
-void FFmpegFilterProcessor::destroyFilterGraph() {
-    // Mode fallback: rien à détruire
+bool FFmpegFilterProcessor::configureFilter(GraphInstance& /*instance*/, const GraphPlan& /*plan*/) {
+    // Mode fallback: pas de configuration FFmpeg
+    return true;
 }
 
-bool FFmpegFilterProcessor::addFilterToGraph(const FilterState& filter) {
+FFmpegFilterProcessor::GraphPlan FFmpegFilterProcessor::planFilter(const FilterState& filter) const {
     // Mode fallback: simulation
     std::cout << "[FFmpegFilterProcessor] Simulation filtre: " << static_cast<int>(filter.type) << std::endl;
-    return true;
-}
-
-bool FFmpegFilterProcessor::configureFilter(const FilterState& filter, AVFilterContext* filterCtx) {
-    // Mode fallback: pas de configuration FFmpeg
-    return true;
+    return {};
 }
 
-std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& filter) const {
+std::string FFmpegFilterProcessor::getFFmpegFilterString(const FilterState& /*filter*/) const {
     // Mode fallback: chaîne vide
     return "";
 }
@@ -590,7 +1094,7 @@ bool FFmpegFilterProcessor::isFFmpegAvailable() const {
 
 std::string FFmpegFilterProcessor::getSupportedPixelFormats() const {
     #ifdef FFMPEG_AVAILABLE
-    return "yuv420p,yuv422p,yuv444p,rgb24,bgr24,rgba,bgra";
+    return "yuv420p,yuv422p,yuv444p,nv12,rgb24,bgr24,rgba,bgra";
     #else
     return "yuv420p,rgb24";
     #endif
@@ -1,7 +1,18 @@
 #pragma once
 
 #include "../common/FilterTypes.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 // Forward declarations pour FFmpeg
@@ -15,9 +26,51 @@ extern "C" {
 
 namespace Camera {
 
+// Compteurs du graphe FFmpeg (mises à jour en direct vs reconstructions)
+struct FFmpegGraphStats {
+    uint64_t commandsSent{0};       // paramètres poussés via avfilter_process_command
+    uint64_t commandsFailed{0};     // commande refusée -> reconstruction demandée
+    uint64_t syncBuilds{0};         // premier graphe / changement de format (thread image)
+    uint64_t asyncBuilds{0};        // changement de topologie (thread de construction)
+    uint64_t swaps{0};              // graphes reconstruits adoptés par le thread image
+    double lastBuildMs{0.0};
+
+    // Cache LRU des graphes configurés
+    uint64_t cacheHits{0};          // topologie retrouvée en cache : échange immédiat
+    uint64_t cacheMisses{0};        // topologie à construire (synchrone ou en arrière-plan)
+    uint64_t evictions{0};
+    uint64_t prewarmBuilds{0};      // looks intégrés préconstruits
+    uint64_t builds{0};             // toutes constructions confondues
+    double totalBuildMs{0.0};
+    double maxBuildMs{0.0};
+
+    // Copies d'image (entrée enveloppée sans copie, sortie écrite en place si possible)
+    uint64_t zeroCopyFrames{0};     // aucun plan recopié vers la sortie
+    uint64_t planesCopied{0};       // plans recopiés depuis le buffersink
+    uint64_t inputCopies{0};        // entrée copiée (filtre gardant une référence sur l'image)
+};
+
+// Graphe configuré (actif ou en cache)
+struct FFmpegGraphInfo {
+    std::string description;        // topologie (nœuds et options figées)
+    int width{0};
+    int height{0};
+    std::string pixelFormat;
+    int frameRate{0};
+    int threads{0};                 // threads de tranche (nb_threads effectif)
+    double buildMs{0.0};
+    uint64_t hits{0};
+    bool active{false};
+};
+
 /**
  * Processeur de filtres utilisant FFmpeg
  * Supporte les filtres vidéo FFmpeg pour le traitement en temps réel
+ *
+ * Chaque filtre est décrit par des nœuds nommés (eq@adjust, hue@effect, lut3d@effect...).
+ * Tant que la topologie ne change pas, les curseurs sont appliqués en direct par
+ * avfilter_process_command. Un changement de topologie reconstruit le graphe sur un
+ * thread dédié; l'ancien graphe reste servi jusqu'à l'échange atomique.
  */
 class FFmpegFilterProcessor : public IFilterProcessor {
 public:
@@ -36,13 +89,16 @@ public:
     
     std::string getName() const override;
     std::vector<FilterInfo> getSupportedFilters() const override;
+    // Graphes propres au clone, un thread de tranche (les bandes occupent déjà les cœurs)
+    std::shared_ptr<IFilterProcessor> clone() const override;
     
     // Configuration spécifique FFmpeg
-    bool setVideoFormat(int width, int height, const std::string& pixelFormat);
+    bool setVideoFormat(int width, int height, const std::string& pixelFormat) override;
     bool setFrameRate(int fps);
     
     // Application optimisée avec gestion de stride (évite les copies pack/unpack)
-    // pixFormat: chaîne FFmpeg (ex: "bgra", "yuv420p")
+    // pixFormat: chaîne FFmpeg (ex: "bgra", "yuv420p", "nv12"). Formats planaires : plans
+    // successifs dans le buffer, stride de chroma proportionnel à celui de la luma.
     bool applyFilterWithStride(const FilterState& filter,
                                const uint8_t* inputData,
                                int inputStride,
@@ -51,8 +107,54 @@ public:
                                const char* pixFormat,
                                uint8_t* outputData,
                                int outputStride);
+
+    // Plans séparés (CVPixelBuffer biplanaire, AVFrame...). Entrée enveloppée sans copie; si
+    // entrée == sortie, les filtres en place écrivent directement dans les plans et rien n'est
+    // recopié. Aucune référence sur les plans n'est conservée après l'appel.
+    bool applyFilterToPlanes(const FilterState& filter,
+                             const uint8_t* const inputPlanes[4],
+                             const int inputLinesizes[4],
+                             int width,
+                             int height,
+                             const char* pixFormat,
+                             uint8_t* const outputPlanes[4],
+                             const int outputLinesizes[4]);
+
+    // false : toute variation de paramètre reconstruit le graphe (comparaison/benchmark)
+    void setLiveParameterUpdates(bool enabled);
+    FFmpegGraphStats getGraphStats() const;
+
+    // Cache LRU des graphes inactifs, clé (largeur, hauteur, pix_fmt, fps, topologie). Les looks de
+    // même topologie partagent un graphe. Un graphe inactif garde ses pools de frames
+    // (~20 Mo en 1080p BGRA) : capacité 2 par défaut (deux looks précédents), 0 désactive le cache.
+    void setGraphCacheCapacity(size_t capacity);
+    // Threads de tranche par graphe (0 : nombre de cœurs); s'applique aux graphes construits ensuite
+    void setGraphThreads(int threads);
+    std::vector<FFmpegGraphInfo> getGraphCacheInfo() const;
+    // Construit en arrière-plan les graphes des looks intégrés (sepia, noir, vintage...), dans la
+    // limite de la capacité du cache
+    void prewarmBuiltinLooks(int width, int height, const std::string& pixelFormat, int frameRate);
+    // Bloque jusqu'à la fin des constructions en attente (benchmarks)
+    void waitForBuilds();
+    // Vrai si la dernière image a été servie par le graphe de la topologie demandée
+    bool isGraphUpToDate() const;
     
 private:
+    // Nœud du graphe : options modifiables à chaud (params) et figées (fixedArgs)
+    struct GraphNode {
+        std::string label;          // "eq@adjust"
+        std::string filter;         // "eq"
+        std::string fixedArgs;      // "file='...'" (lut3d), changement = reconstruction
+        std::vector<std::pair<std::string, std::string>> params;
+        std::vector<std::pair<std::string, std::string>> neutral;   // vide : nœud obligatoire
+        AVFilterContext* context{nullptr};
+    };
+    struct GraphPlan {
+        std::vector<GraphNode> nodes;
+        std::string description() const;
+    };
+    struct GraphInstance;
+
     // État FFmpeg
     bool initialized_{false};
     std::string lastError_;
@@ -63,20 +165,67 @@ private:
     std::string pixelFormat_;
     int frameRate_{30};
     
-    // Contexte FFmpeg
-    AVFilterGraph* filterGraph_{nullptr};
-    AVFilterContext* sourceContext_{nullptr};
-    AVFilterContext* sinkContext_{nullptr};
+    // Contexte FFmpeg (graphe actif : thread image uniquement)
+    std::unique_ptr<GraphInstance> active_;
     AVFrame* inputFrame_{nullptr};
     AVFrame* outputFrame_{nullptr};
+    std::atomic<int> callerRefs_{0};                         // références du graphe sur les plans de l'appelant
+    std::unordered_set<std::string> copyInputKeys_;          // topologies gardant l'image d'entrée
     
     // Méthodes privées
-    bool createFilterGraph();
+    std::unique_ptr<GraphInstance> createFilterGraph(const GraphPlan& plan, int width, int height,
+                                                     const std::string& pixelFormat, int frameRate,
+                                                     int threads, std::string& error) const;
     void destroyFilterGraph();
-    bool addFilterToGraph(const FilterState& filter);
-    bool configureFilter(const FilterState& filter, AVFilterContext* filterCtx);
+    bool configureFilter(GraphInstance& instance, const GraphPlan& plan);
+    GraphPlan planFilter(const FilterState& filter) const;
     std::string getFFmpegFilterString(const FilterState& filter) const;
     void setLastError(const std::string& error);
+    void releaseCallerPlanes();
+
+    // Reconstruction hors thread image
+    struct BuildJob {
+        GraphPlan plan;
+        std::string key;
+        int width{0};
+        int height{0};
+        int frameRate{0};
+        std::string pixelFormat;
+    };
+    std::string graphKey(const GraphPlan& plan, int width, int height, const std::string& pixelFormat,
+                         int frameRate) const;
+    bool requestBuild(const GraphPlan& plan, const std::string& key);
+    void builderLoop();
+    void retire(std::unique_ptr<GraphInstance> instance);
+    void startBuilderLocked();
+    void setActive(std::unique_ptr<GraphInstance> instance);
+    std::unique_ptr<GraphInstance> takeCached(const std::string& key);
+    void cacheGraph(std::unique_ptr<GraphInstance> instance);
+    void cacheGraphLocked(std::unique_ptr<GraphInstance> instance);
+    void recordBuildLocked(double ms);
+    std::thread builder_;
+    mutable std::mutex buildMutex_;
+    std::condition_variable buildWake_;
+    std::condition_variable buildIdle_;
+    bool buildStop_{false};
+    bool buildPending_{false};
+    bool building_{false};
+    BuildJob buildJob_;                                      // demande du thread image (prioritaire)
+    std::deque<BuildJob> prewarmJobs_;
+    std::vector<std::unique_ptr<GraphInstance>> retired_;   // libérés par le thread de construction
+    std::atomic<GraphInstance*> ready_{nullptr};             // graphe prêt, adopté à la prochaine image
+    std::string requestedKey_;                               // topologie déjà demandée (thread image)
+    std::string wantedKey_;                                  // topologie de la dernière image
+
+    // Cache LRU (sous buildMutex_) : graphes inactifs, le plus récent en tête
+    std::list<std::unique_ptr<GraphInstance>> cache_;
+    std::unordered_map<std::string, std::list<std::unique_ptr<GraphInstance>>::iterator> cacheIndex_;
+    size_t cacheCapacity_{2};
+    int graphThreads_{0};
+    FFmpegGraphInfo activeInfo_;
+
+    bool liveUpdates_{true};
+    FFmpegGraphStats stats_;
     
     // Utilitaires
     bool isFFmpegAvailable() const;
@@ -84,11 +233,6 @@ private:
 
     // Cache/optimisation
     bool ensureGraph(const FilterState& filter);
-    int lastWidth_{0};
-    int lastHeight_{0};
-    int lastFrameRate_{0};
-    std::string lastPixelFormat_;
-    std::string lastFilterDesc_;
 };
 
 } // namespace Camera
@@ -0,0 +1,417 @@
+#include "FFmpegGraphBenchmark.hpp"
+#include "FFmpegFilterProcessor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <unistd.h>
+
+#ifdef FFMPEG_AVAILABLE
+extern "C" {
+    #include <libavutil/imgutils.h>
+    #include <libavutil/pixdesc.h>
+}
+#endif
+
+namespace Camera {
+
+#ifdef FFMPEG_AVAILABLE
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Buffer contigu sans padding (plans successifs pour les formats YUV)
+size_t frameSize(const std::string& pixelFormat, int width, int height, int& stride) {
+    const AVPixelFormat pix = av_get_pix_fmt(pixelFormat.c_str());
+    stride = pix == AV_PIX_FMT_NONE ? 0 : av_image_get_linesize(pix, width, 0);
+    const int size = pix == AV_PIX_FMT_NONE ? 0 : av_image_get_buffer_size(pix, width, height, 1);
+    return stride > 0 && size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+std::vector<uint8_t> makeFrame(size_t size) {
+    std::vector<uint8_t> frame(size);
+    for (size_t i = 0; i < size; ++i) {
+        frame[i] = static_cast<uint8_t>((i * 7 + (i >> 9) * 13) & 0xFF);
+    }
+    return frame;
+}
+
+// LUT 33³ écrite pour le scénario lut3d : chaque reconstruction relit et reparse le fichier
+std::string writeCube(const std::string& dir) {
+    const std::string path = dir + "/naaya_ffmpeg_graph_bench.cube";
+    std::ofstream f(path);
+    if (!f) return {};
+    const int n = 33;
+    f << "LUT_3D_SIZE " << n << "\n" << std::fixed << std::setprecision(6);
+    for (int b = 0; b < n; ++b) {
+        for (int g = 0; g < n; ++g) {
+            for (int r = 0; r < n; ++r) {
+                const double x[3] = {r / double(n - 1), g / double(n - 1), b / double(n - 1)};
+                for (int c = 0; c < 3; ++c) {
+                    f << (c ? " " : "") << x[c] * x[c] * (3.0 - 2.0 * x[c]);
+                }
+                f << '\n';
+            }
+        }
+    }
+    return f ? path : std::string();
+}
+
+// Paramètres à l'image f : curseur en va-et-vient, teinte activée sur le troisième quart
+// (changement de topologie). colorbalance/hue/lut3d : présents aussi dans les builds LGPL (sans eq).
+struct Scenario {
+    std::string label;
+    std::string cubePath;   // vide : sépia (colorbalance)
+
+    FilterState state(int f, int frames, int fps) const {
+        const double wave = std::sin(2.0 * kPi * f / fps);
+        FilterParams params;
+        if (cubePath.empty()) {
+            params.intensity = 0.5 + 0.4 * wave;
+            params.hue = (f >= frames / 2 && f < frames * 3 / 4) ? 20.0 : 0.0;
+            return FilterState(FilterType::SEPIA, params);
+        }
+        // Teinte toujours active (nœud hue@adjust), interpolation basculée sur le troisième quart
+        params.hue = 15.0 + 10.0 * wave;
+        params.customFilterName = "lut3d:" + cubePath;
+        if (f >= frames / 2 && f < frames * 3 / 4) params.customFilterName += "?interp=trilinear";
+        return FilterState(FilterType::CUSTOM, params);
+    }
+};
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const size_t idx = std::min(v.size() - 1, static_cast<size_t>(p * (v.size() - 1) + 0.5));
+    return v[idx];
+}
+
+FFmpegGraphBenchmarkResult runDrag(const FFmpegGraphBenchmarkConfig& config, const Scenario& scenario, bool live) {
+    FFmpegGraphBenchmarkResult r;
+    r.label = scenario.label + (live ? " / commandes" : " / reconstruction");
+
+    const int width = std::max(2, config.width);
+    const int height = std::max(2, config.height);
+    const int fps = std::max(1, config.fps);
+    const int frames = std::max(4, config.frames);
+    int stride = 0;
+    const size_t size = frameSize(config.pixelFormat, width, height, stride);
+    if (size == 0) {
+        std::cout << "[FFmpegGraphBenchmark] Format inconnu: " << config.pixelFormat << std::endl;
+        return r;
+    }
+    const std::vector<uint8_t> input = makeFrame(size);
+    std::vector<uint8_t> output(size);
+
+    FFmpegFilterProcessor processor;
+    processor.initialize();
+    processor.setFrameRate(fps);
+    processor.setVideoFormat(width, height, config.pixelFormat);
+    processor.setLiveParameterUpdates(live);
+
+    std::vector<double> times;
+    times.reserve(frames);
+    const auto period = std::chrono::nanoseconds(1000000000LL / fps);
+    const double budgetMs = 1000.0 / fps;
+    uint64_t swapsAtChange = 0;
+    const auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        if (config.realtime) std::this_thread::sleep_until(start + period * f);
+        const FilterState state = scenario.state(f, frames, fps);
+        const auto t0 = Clock::now();
+        const bool ok = processor.applyFilterWithStride(state, input.data(), stride, width, height,
+                                                        config.pixelFormat.c_str(), output.data(), stride);
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (!ok) {
+            std::cout << "[FFmpegGraphBenchmark] Échec image " << f << std::endl;
+            return r;
+        }
+        times.push_back(ms);
+        if (ms > budgetMs) ++r.missedFrames;
+
+        if (f == frames / 2) swapsAtChange = processor.getGraphStats().swaps;
+        if (f > frames / 2 && r.framesUntilSwap < 0 && processor.getGraphStats().swaps > swapsAtChange) {
+            r.framesUntilSwap = f - frames / 2;
+        }
+    }
+
+    // Dernière image comparée à un graphe construit directement avec les paramètres finaux
+    FFmpegFilterProcessor fresh;
+    fresh.initialize();
+    fresh.setFrameRate(fps);
+    std::vector<uint8_t> reference(size);
+    if (fresh.applyFilterWithStride(scenario.state(frames - 1, frames, fps), input.data(), stride, width, height,
+                                    config.pixelFormat.c_str(), reference.data(), stride)) {
+        r.maxDiffVsFresh = 0;
+        for (size_t i = 0; i < size; ++i) {
+            r.maxDiffVsFresh = std::max(r.maxDiffVsFresh, std::abs(int(output[i]) - int(reference[i])));
+        }
+    }
+
+    double sum = 0.0;
+    for (double t : times) sum += t;
+    r.meanMs = sum / times.size();
+    double var = 0.0;
+    for (double t : times) var += (t - r.meanMs) * (t - r.meanMs);
+    r.jitterMs = std::sqrt(var / times.size());
+    r.p50Ms = percentile(times, 0.50);
+    r.p99Ms = percentile(times, 0.99);
+    r.maxMs = *std::max_element(times.begin(), times.end());
+
+    const FFmpegGraphStats stats = processor.getGraphStats();
+    r.commandsSent = stats.commandsSent;
+    r.syncBuilds = stats.syncBuilds;
+    r.asyncBuilds = stats.asyncBuilds;
+    r.swaps = stats.swaps;
+    return r;
+}
+
+FFmpegGraphCacheBenchmarkResult runLookSwitches(const FFmpegGraphBenchmarkConfig& config, const char* label,
+                                                bool live, size_t capacity, bool prewarm) {
+    static const FilterType looks[] = {
+        FilterType::SEPIA, FilterType::NOIR, FilterType::MONOCHROME,
+        FilterType::VINTAGE, FilterType::COOL, FilterType::WARM
+    };
+    FFmpegGraphCacheBenchmarkResult r;
+    r.label = label;
+
+    const int width = std::max(2, config.width);
+    const int height = std::max(2, config.height);
+    const int fps = std::max(1, config.fps);
+    const int frames = std::max(2, config.frames);
+    const int every = std::max(1, config.switchEvery);
+    int stride = 0;
+    const size_t size = frameSize(config.pixelFormat, width, height, stride);
+    if (size == 0) {
+        std::cout << "[FFmpegGraphBenchmark] Format inconnu: " << config.pixelFormat << std::endl;
+        return r;
+    }
+    const std::vector<uint8_t> input = makeFrame(size);
+    std::vector<uint8_t> output(size);
+
+    FFmpegFilterProcessor processor;
+    processor.initialize();
+    processor.setFrameRate(fps);
+    processor.setVideoFormat(width, height, config.pixelFormat);
+    processor.setLiveParameterUpdates(live);
+    processor.setGraphCacheCapacity(capacity);
+    processor.setGraphThreads(config.graphThreads);
+    if (prewarm) {
+        processor.prewarmBuiltinLooks(width, height, config.pixelFormat, fps);
+        processor.waitForBuilds();
+    }
+
+    const auto period = std::chrono::nanoseconds(1000000000LL / fps);
+    double switchSum = 0.0;
+    double frameSum = 0.0;
+    const auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        if (config.realtime) std::this_thread::sleep_until(start + period * f);
+        const FilterState state(looks[(f / every) % 6], FilterParams());
+        const auto t0 = Clock::now();
+        if (!processor.applyFilterWithStride(state, input.data(), stride, width, height,
+                                             config.pixelFormat.c_str(), output.data(), stride)) {
+            std::cout << "[FFmpegGraphBenchmark] Échec image " << f << std::endl;
+            return r;
+        }
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (!processor.isGraphUpToDate()) ++r.staleFrames;
+        if (f > 0 && f % every == 0) {
+            ++r.switches;
+            switchSum += ms;
+            r.switchMaxMs = std::max(r.switchMaxMs, ms);
+        } else {
+            frameSum += ms;
+        }
+    }
+    processor.waitForBuilds();
+
+    r.switchMeanMs = r.switches ? switchSum / r.switches : 0.0;
+    r.frameMeanMs = frameSum / std::max(1, frames - r.switches);
+    const FFmpegGraphStats stats = processor.getGraphStats();
+    r.cacheHits = stats.cacheHits;
+    r.cacheMisses = stats.cacheMisses;
+    r.builds = stats.builds;
+    r.meanBuildMs = stats.builds ? stats.totalBuildMs / stats.builds : 0.0;
+    for (const auto& info : processor.getGraphCacheInfo()) {
+        if (info.active) {
+            r.threads = info.threads;
+        } else {
+            ++r.cachedGraphs;
+        }
+    }
+    return r;
+}
+
+// Même filtre en buffers distincts puis en place (entrée == sortie, comme un CVPixelBuffer
+// modifié directement) : temps par image et plans recopiés depuis le buffersink
+FFmpegGraphCopyBenchmarkResult runCopies(const FFmpegGraphBenchmarkConfig& config, const char* label,
+                                         const std::string& pixelFormat, FilterType type, bool inPlace,
+                                         std::vector<uint8_t>& distinctOutput) {
+    FFmpegGraphCopyBenchmarkResult r;
+    r.label = label;
+    r.pixelFormat = pixelFormat;
+    r.inPlace = inPlace;
+
+    const int width = std::max(2, config.width);
+    const int height = std::max(2, config.height);
+    const int frames = std::max(1, config.copyFrames);
+    int stride = 0;
+    const size_t size = frameSize(pixelFormat, width, height, stride);
+    if (size == 0) {
+        std::cout << "[FFmpegGraphBenchmark] Format inconnu: " << pixelFormat << std::endl;
+        return r;
+    }
+    const std::vector<uint8_t> input = makeFrame(size);
+    std::vector<uint8_t> output(size);
+
+    FFmpegFilterProcessor processor;
+    processor.initialize();
+    processor.setFrameRate(std::max(1, config.fps));
+    processor.setGraphThreads(config.graphThreads);
+    FilterParams params;
+    params.intensity = 0.8;
+    const FilterState state(type, params);
+
+    double sum = 0.0;
+    for (int f = 0; f <= frames; ++f) {
+        // Image caméra fraîche à chaque tour en place (hors mesure)
+        if (inPlace) output = input;
+        const uint8_t* src = inPlace ? output.data() : input.data();
+        const auto t0 = Clock::now();
+        if (!processor.applyFilterWithStride(state, src, stride, width, height, pixelFormat.c_str(),
+                                             output.data(), stride)) {
+            std::cout << "[FFmpegGraphBenchmark] Échec image " << f << " (" << pixelFormat << ")" << std::endl;
+            return r;
+        }
+        // Image 0 : construction du graphe
+        if (f > 0) sum += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    r.frames = frames;
+    r.msPerFrame = sum / frames;
+
+    const FFmpegGraphStats stats = processor.getGraphStats();
+    r.planesCopiedPerFrame = static_cast<double>(stats.planesCopied) / (frames + 1);
+    r.zeroCopyFrames = stats.zeroCopyFrames;
+    if (!inPlace) {
+        distinctOutput = output;
+    } else if (distinctOutput.size() == size) {
+        r.maxDiffVsDistinct = 0;
+        for (size_t i = 0; i < size; ++i) {
+            r.maxDiffVsDistinct = std::max(r.maxDiffVsDistinct, std::abs(int(output[i]) - int(distinctOutput[i])));
+        }
+    }
+    return r;
+}
+
+} // namespace
+#endif
+
+FFmpegGraphBenchmarkResults runFFmpegGraphBenchmark(const FFmpegGraphBenchmarkConfig& config) {
+    FFmpegGraphBenchmarkResults results;
+#ifdef FFMPEG_AVAILABLE
+    results.available = true;
+    std::string dir = config.workDir;
+    if (dir.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        dir = tmp && *tmp ? tmp : "/tmp";
+    }
+    std::vector<Scenario> scenarios = {{"sépia", ""}};
+    const std::string cubePath = writeCube(dir);
+    if (!cubePath.empty()) {
+        scenarios.push_back({"lut3d + teinte", cubePath});
+    } else {
+        std::cout << "[FFmpegGraphBenchmark] Écriture impossible dans " << dir << std::endl;
+    }
+    for (const auto& scenario : scenarios) {
+        results.rows.push_back(runDrag(config, scenario, true));
+        results.rows.push_back(runDrag(config, scenario, false));
+    }
+    if (!cubePath.empty()) ::unlink(cubePath.c_str());
+
+    results.cacheRows.push_back(runLookSwitches(config, "reconstruction synchrone", false, 0, false));
+    results.cacheRows.push_back(runLookSwitches(config, "sans cache", true, 0, false));
+    results.cacheRows.push_back(runLookSwitches(config, "LRU", true, config.cacheCapacity, false));
+    results.cacheRows.push_back(runLookSwitches(config, "LRU + préchauffage", true, config.cacheCapacity, true));
+
+    // sépia (colorbalance) écrit en place en BGRA; noir (hue) en place en YUV planaire, NV12 converti
+    const struct { const char* label; const char* format; FilterType type; } copyCases[] = {
+        {"sépia", "bgra", FilterType::SEPIA},
+        {"noir", "yuv420p", FilterType::NOIR},
+        {"noir", "nv12", FilterType::NOIR},
+    };
+    for (const auto& c : copyCases) {
+        std::vector<uint8_t> distinct;
+        results.copyRows.push_back(runCopies(config, c.label, c.format, c.type, false, distinct));
+        results.copyRows.push_back(runCopies(config, c.label, c.format, c.type, true, distinct));
+    }
+#else
+    (void)config;
+#endif
+    return results;
+}
+
+void printFFmpegGraphBenchmark(const FFmpegGraphBenchmarkResults& results) {
+    std::cout << "\n=== Graphe FFmpeg : curseur déplacé à chaque image ===" << std::endl;
+    if (!results.available) {
+        std::cout << "FFmpeg non disponible sur cette plateforme" << std::endl;
+        return;
+    }
+    std::cout << std::left << std::setw(34) << "scénario / mode" << std::right << std::setw(9) << "moy ms"
+              << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(9) << "max"
+              << std::setw(9) << "gigue" << std::setw(9) << "hors" << std::setw(10) << "commandes"
+              << std::setw(7) << "sync" << std::setw(7) << "async" << std::setw(8) << "swap@"
+              << std::setw(8) << "Δ neuf" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& r : results.rows) {
+        std::cout << std::left << std::setw(34) << r.label << std::right << std::setprecision(2)
+                  << std::setw(9) << r.meanMs << std::setw(9) << r.p50Ms << std::setw(9) << r.p99Ms
+                  << std::setw(9) << r.maxMs << std::setw(9) << r.jitterMs << std::setw(9) << r.missedFrames
+                  << std::setw(10) << r.commandsSent << std::setw(7) << r.syncBuilds
+                  << std::setw(7) << r.asyncBuilds << std::setw(8) << r.framesUntilSwap
+                  << std::setw(8) << r.maxDiffVsFresh << std::endl;
+    }
+
+    std::cout << "\n=== Graphe FFmpeg : changements de look (cache LRU) ===" << std::endl;
+    std::cout << std::left << std::setw(26) << "mode" << std::right << std::setw(8) << "looks"
+              << std::setw(12) << "périmées" << std::setw(11) << "chg moy" << std::setw(11) << "chg max"
+              << std::setw(11) << "autres" << std::setw(7) << "hits" << std::setw(8) << "misses"
+              << std::setw(8) << "builds" << std::setw(10) << "build ms" << std::setw(9) << "threads"
+              << std::setw(8) << "cache" << std::endl;
+    for (const auto& r : results.cacheRows) {
+        std::cout << std::left << std::setw(26) << r.label << std::right << std::setprecision(2)
+                  << std::setw(8) << r.switches << std::setw(10) << r.staleFrames
+                  << std::setw(11) << r.switchMeanMs << std::setw(11) << r.switchMaxMs
+                  << std::setw(11) << r.frameMeanMs << std::setw(7) << r.cacheHits
+                  << std::setw(8) << r.cacheMisses << std::setw(8) << r.builds
+                  << std::setw(10) << r.meanBuildMs << std::setw(9) << r.threads
+                  << std::setw(8) << r.cachedGraphs << std::endl;
+    }
+
+    std::cout << "\n=== Graphe FFmpeg : copies d'image (buffers distincts / en place) ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "filtre" << std::setw(10) << "format" << std::setw(12) << "sortie"
+              << std::right << std::setw(11) << "ms/image" << std::setw(14) << "plans copiés"
+              << std::setw(12) << "zéro copie" << std::setw(13) << "Δ distinct" << std::endl;
+    for (const auto& r : results.copyRows) {
+        std::cout << std::left << std::setw(10) << r.label << std::setw(10) << r.pixelFormat
+                  << std::setw(12) << (r.inPlace ? "en place" : "distincte") << std::right << std::setprecision(2)
+                  << std::setw(11) << r.msPerFrame << std::setw(14) << r.planesCopiedPerFrame
+                  << std::setw(8) << r.zeroCopyFrames << "/" << std::left << std::setw(4) << r.frames + 1
+                  << std::right << std::setw(11);
+        if (r.inPlace) {
+            std::cout << r.maxDiffVsDistinct;
+        } else {
+            std::cout << "réf.";
+        }
+        std::cout << std::endl;
+    }
+}
+
+} // namespace Camera
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+struct FFmpegGraphBenchmarkResult {
+    std::string label;              // "sépia / commandes", "lut3d + teinte / reconstruction", ...
+    double meanMs{0.0};
+    double p50Ms{0.0};
+    double p99Ms{0.0};
+    double maxMs{0.0};
+    double jitterMs{0.0};           // écart-type du temps par image
+    int missedFrames{0};            // images au-delà du budget 1/fps
+    uint64_t commandsSent{0};
+    uint64_t syncBuilds{0};
+    uint64_t asyncBuilds{0};
+    uint64_t swaps{0};
+    int framesUntilSwap{-1};        // images servies par l'ancien graphe après le changement de topologie
+    int maxDiffVsFresh{-1};         // dernière image vs graphe neuf aux mêmes paramètres
+};
+
+// Changement de look tous les switchEvery images (sepia -> noir -> ... -> warm)
+struct FFmpegGraphCacheBenchmarkResult {
+    std::string label;              // "reconstruction synchrone", "sans cache", "LRU", "LRU + préchauffage"
+    int switches{0};
+    int staleFrames{0};             // images servies par le graphe du look précédent
+    double switchMeanMs{0.0};       // image qui suit un changement de look
+    double switchMaxMs{0.0};
+    double frameMeanMs{0.0};        // autres images
+    uint64_t cacheHits{0};
+    uint64_t cacheMisses{0};
+    uint64_t builds{0};
+    double meanBuildMs{0.0};
+    int threads{0};                 // nb_threads effectif du graphe actif
+    size_t cachedGraphs{0};         // graphes en cache à la fin
+};
+
+// Même filtre en buffers distincts puis en place (entrée == sortie)
+struct FFmpegGraphCopyBenchmarkResult {
+    std::string label;              // "sépia", "noir"
+    std::string pixelFormat;        // "bgra", "yuv420p", "nv12"
+    bool inPlace{false};
+    double msPerFrame{0.0};
+    double planesCopiedPerFrame{0.0};   // plans recopiés depuis le buffersink
+    uint64_t zeroCopyFrames{0};
+    int frames{0};
+    int maxDiffVsDistinct{-1};      // en place vs buffers distincts
+};
+
+struct FFmpegGraphBenchmarkConfig {
+    int width = 1280;
+    int height = 720;
+    std::string pixelFormat = "bgra";   // bgra, rgba, yuv420p, nv12...
+    std::string workDir;            // .cube du scénario lut3d (vide : $TMPDIR)
+    int fps = 60;
+    int frames = 240;
+    bool realtime = true;           // images cadencées à fps (sinon enchaînées)
+    int switchEvery = 10;           // scénario cache : images par look
+    size_t cacheCapacity = 2;
+    int graphThreads = 0;           // nb_threads par graphe (0 : nombre de cœurs)
+    int copyFrames = 60;            // scénario copies : images par mode
+};
+
+struct FFmpegGraphBenchmarkResults {
+    bool available{false};          // false sans FFMPEG_AVAILABLE
+    std::vector<FFmpegGraphBenchmarkResult> rows;
+    std::vector<FFmpegGraphCacheBenchmarkResult> cacheRows;
+    std::vector<FFmpegGraphCopyBenchmarkResult> copyRows;
+};
+
+// Curseur déplacé à chaque image à fps : intensité sépia (colorbalance, teinte ajoutée au troisième
+// quart = changement de topologie) et teinte sur une LUT 33³ (interpolation basculée au troisième
+// quart). Compare les commandes avfilter_process_command à une reconstruction du graphe à chaque
+// variation : temps par image, gigue et images hors budget. Puis changements de look successifs :
+// reconstruction synchrone, construction en arrière-plan sans cache, cache LRU, cache préchauffé.
+// Enfin copies d'image en BGRA, yuv420p et NV12 : buffers distincts contre traitement en place.
+FFmpegGraphBenchmarkResults runFFmpegGraphBenchmark(const FFmpegGraphBenchmarkConfig& config = {});
+void printFFmpegGraphBenchmark(const FFmpegGraphBenchmarkResults& results);
+
+} // namespace Camera
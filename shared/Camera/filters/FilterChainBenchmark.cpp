@@ -0,0 +1,215 @@
+#include "FilterChainBenchmark.hpp"
+#include "ColorMatrixFilterProcessor.hpp"
+#include "FilterChainCompiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <unistd.h>
+
+namespace Camera {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// LUT utilisateur synthétique 17³ (courbe en S douce + léger virage sarcelle/orange)
+std::string writeLookCube(const std::string& dir) {
+    const std::string path = dir + "/naaya_chain_bench.cube";
+    std::ofstream f(path);
+    if (!f) return {};
+    const int n = 17;
+    f << "TITLE \"Naaya chain benchmark\"\nLUT_3D_SIZE " << n << "\n" << std::fixed << std::setprecision(6);
+    for (int b = 0; b < n; ++b) {
+        for (int g = 0; g < n; ++g) {
+            for (int r = 0; r < n; ++r) {
+                const float rgb[3] = {r / float(n - 1), g / float(n - 1), b / float(n - 1)};
+                const float luma = 0.299f * rgb[0] + 0.587f * rgb[1] + 0.114f * rgb[2];
+                float out[3];
+                for (int c = 0; c < 3; ++c) {
+                    const float s = rgb[c] * rgb[c] * (3.0f - 2.0f * rgb[c]);
+                    out[c] = 0.6f * s + 0.4f * rgb[c];
+                }
+                out[0] += 0.06f * (luma - 0.5f);
+                out[2] -= 0.06f * (luma - 0.5f);
+                f << std::clamp(out[0], 0.0f, 1.0f) << ' ' << std::clamp(out[1], 0.0f, 1.0f) << ' '
+                  << std::clamp(out[2], 0.0f, 1.0f) << '\n';
+            }
+        }
+    }
+    return f ? path : std::string();
+}
+
+std::vector<uint8_t> makeImage(int width, int height) {
+    std::vector<uint8_t> img(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = img.data() + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            const double u = static_cast<double>(x) / width;
+            const double v = static_cast<double>(y) / height;
+            row[x * 4 + 0] = static_cast<uint8_t>(255.0 * u);
+            row[x * 4 + 1] = static_cast<uint8_t>(255.0 * v);
+            row[x * 4 + 2] = static_cast<uint8_t>(127.5 + 127.0 * std::sin(6.0 * u) * std::cos(4.0 * v));
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return img;
+}
+
+template <typename Fn>
+double measureMsPerFrame(int frames, Fn&& fn) {
+    fn();   // préchauffage
+    const auto t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) fn();
+    return elapsedMs(t0) / frames;
+}
+
+} // namespace
+
+FilterChainBenchmarkResults runFilterChainBenchmark(const FilterChainBenchmarkConfig& config) {
+    FilterChainBenchmarkResults results;
+    std::string dir = config.workDir;
+    if (dir.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        dir = tmp && *tmp ? tmp : "/tmp";
+    }
+    const std::string cubePath = writeLookCube(dir);
+    if (cubePath.empty()) {
+        std::cout << "[FilterChainBenchmark] Écriture impossible dans " << dir << std::endl;
+        return results;
+    }
+
+    FilterParams controls;
+    controls.brightness = 0.05;
+    controls.contrast = 1.2;
+    controls.saturation = 1.3;
+    controls.hue = 15.0;
+    controls.gamma = 1.1;
+    FilterParams look;
+    look.intensity = 0.8;
+    look.customFilterName = "lut3d:" + cubePath;
+
+    PointwiseChain chain;
+    chain.filters = {FilterState(FilterType::COLOR_CONTROLS, controls),
+                     FilterState(FilterType::WARM, FilterParams()),
+                     FilterState(FilterType::CUSTOM, look)};
+
+    const int width = std::max(1, config.width);
+    const int height = std::max(1, config.height);
+    const int frames = std::max(1, config.frames);
+    const int stride = width * 4;
+    const double mpix = static_cast<double>(width) * height / 1e6;
+    const std::vector<uint8_t> input = makeImage(width, height);
+
+    // Référence : une passe par étage (matrice couleur, matrice couleur, LUT)
+    std::string error;
+    const auto userLut = Lut3D::load(cubePath, dir, error);
+    if (!userLut) {
+        std::cout << "[FilterChainBenchmark] " << error << std::endl;
+        return results;
+    }
+    const ColorMatrixProgram p0 = ColorMatrixFilterProcessor::compile(chain.filters[0]);
+    const ColorMatrixProgram p1 = ColorMatrixFilterProcessor::compile(chain.filters[1]);
+    results.stages = 3;
+    std::vector<uint8_t> reference(input.size());
+    FilterChainBenchmarkResult multi;
+    multi.label = "passes successives";
+    multi.msPerFrame = measureMsPerFrame(frames, [&] {
+        ColorMatrixFilterProcessor::apply(p0, input.data(), stride, width, height, true, reference.data(), stride);
+        ColorMatrixFilterProcessor::apply(p1, reference.data(), stride, width, height, true, reference.data(), stride);
+        userLut->applyPacked(reference.data(), stride, width, height, true, reference.data(), stride,
+                             Lut3DInterpolation::TETRAHEDRAL, static_cast<float>(look.intensity));
+    });
+    multi.mpixPerSec = multi.msPerFrame > 0.0 ? mpix * 1000.0 / multi.msPerFrame : 0.0;
+    results.rows.push_back(multi);
+
+    std::vector<uint8_t> baked(input.size());
+    for (int size : config.lutSizes) {
+        FilterChainBenchmarkResult r;
+        r.label = "LUT " + std::to_string(size) + "³";
+        r.lutSize = size;
+        std::shared_ptr<const Lut3D> lut;
+        const int runs = std::max(1, config.bakeRuns);
+        const auto t0 = Clock::now();
+        for (int i = 0; i < runs; ++i) lut = FilterChainCompiler::bake(chain, size, dir, error);
+        r.bakeMs = elapsedMs(t0) / runs;
+        if (!lut) {
+            std::cout << "[FilterChainBenchmark] " << error << std::endl;
+            continue;
+        }
+        r.msPerFrame = measureMsPerFrame(frames, [&] {
+            lut->applyPacked(input.data(), stride, width, height, true, baked.data(), stride,
+                             Lut3DInterpolation::TETRAHEDRAL, 1.0f);
+        });
+        r.mpixPerSec = r.msPerFrame > 0.0 ? mpix * 1000.0 / r.msPerFrame : 0.0;
+        double sum = 0.0;
+        for (size_t i = 0; i < baked.size(); i += 4) {
+            for (size_t c = 0; c < 3; ++c) {
+                const int d = std::abs(int(baked[i + c]) - int(reference[i + c]));
+                sum += d;
+                r.maxDiff = std::max(r.maxDiff, d);
+            }
+        }
+        r.meanDiff = sum / (static_cast<double>(width) * height * 3);
+        results.rows.push_back(r);
+    }
+
+    // Bake asynchrone : la première LUT reste servie pendant le bake de la chaîne modifiée
+    {
+        FilterChainCompiler compiler(config.lutSizes.empty() ? 33 : config.lutSizes.back());
+        compiler.setLutCacheDirectory(dir);
+        compiler.submit(chain);
+        compiler.waitIdle();
+        const auto first = compiler.current();
+
+        PointwiseChain adjusted = chain;
+        adjusted.adjustments.exposure = 0.3;
+        adjusted.adjustments.warmth = 0.4;
+        adjusted.adjustments.tint = -0.2;
+        const auto t0 = Clock::now();
+        compiler.submit(adjusted);
+        const auto during = compiler.current();
+        compiler.waitIdle();
+        results.asyncBakeMs = elapsedMs(t0);
+        results.previousLutServed = first && during == first && compiler.isUpToDate() && compiler.current() != first;
+    }
+    ::unlink(cubePath.c_str());
+    return results;
+}
+
+void printFilterChainBenchmark(const FilterChainBenchmarkResults& results) {
+    std::cout << "\n=== Chaîne ponctuelle compilée en LUT 3D (" << results.stages << " étages, BGRA) ===" << std::endl;
+    std::cout << std::left << std::setw(22) << "mode" << std::right << std::setw(10) << "bake ms"
+              << std::setw(11) << "ms/image" << std::setw(10) << "MP/s" << std::setw(10) << "Δ moyen"
+              << std::setw(8) << "Δ max" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& r : results.rows) {
+        std::cout << std::left << std::setw(22) << r.label << std::right << std::setprecision(2);
+        if (r.lutSize > 0) {
+            std::cout << std::setw(10) << r.bakeMs;
+        } else {
+            std::cout << std::setw(10) << "-";
+        }
+        std::cout << std::setw(11) << r.msPerFrame << std::setprecision(0) << std::setw(10) << r.mpixPerSec;
+        if (r.lutSize > 0) {
+            std::cout << std::setprecision(2) << std::setw(10) << r.meanDiff << std::setw(8) << r.maxDiff;
+        } else {
+            std::cout << std::setw(10) << "réf." << std::setw(8) << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Bake asynchrone (exposition/température/teinte) : " << std::setprecision(2)
+              << results.asyncBakeMs << " ms, LUT précédente servie pendant le bake : "
+              << (results.previousLutServed ? "OK" : "ÉCART") << std::endl;
+}
+
+} // namespace Camera
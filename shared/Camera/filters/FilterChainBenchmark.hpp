@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+struct FilterChainBenchmarkResult {
+    std::string label;              // "passes successives", "LUT 33³", ...
+    int lutSize{0};                 // 0 : une passe par étage
+    double bakeMs{0.0};             // compilation de la chaîne (bake synchrone)
+    double msPerFrame{0.0};
+    double mpixPerSec{0.0};
+    double meanDiff{0.0};           // écart moyen RGB vs passes successives (niveaux 8 bits)
+    int maxDiff{0};
+};
+
+struct FilterChainBenchmarkConfig {
+    std::vector<int> lutSizes = {33, 65};
+    std::string workDir;            // .cube synthétique et cache (vide : $TMPDIR)
+    int width = 1920;
+    int height = 1080;
+    int frames = 30;
+    int bakeRuns = 5;
+};
+
+struct FilterChainBenchmarkResults {
+    int stages{0};                  // passes évitées par le bake
+    std::vector<FilterChainBenchmarkResult> rows;
+    double asyncBakeMs{0.0};        // submit() -> nouvelle LUT publiée
+    bool previousLutServed{false};  // ancienne LUT renvoyée pendant le bake
+};
+
+// Chaîne color_controls (luminosité/contraste/saturation/teinte/gamma) + warm + LUT utilisateur :
+// coût par image en passes successives (matrice couleur puis LUT) contre une seule LUT compilée,
+// temps de bake par taille de LUT et écart de rendu. Le bake asynchrone est vérifié à part avec
+// exposition/température/teinte : la LUT précédente doit rester servie jusqu'à la publication.
+FilterChainBenchmarkResults runFilterChainBenchmark(const FilterChainBenchmarkConfig& config = {});
+void printFilterChainBenchmark(const FilterChainBenchmarkResults& results);
+
+} // namespace Camera
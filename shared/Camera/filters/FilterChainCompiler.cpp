@@ -0,0 +1,248 @@
+#include "FilterChainCompiler.hpp"
+#include "ColorMatrixFilterProcessor.hpp"
+#include "LutFilterProcessor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace Camera {
+
+namespace {
+
+// Étage évalué couleur par couleur pendant le bake
+struct Stage {
+    bool isLut{false};
+    ColorMatrixProgram program;
+    std::shared_ptr<const Lut3D> lut;
+    Lut3DInterpolation interp{Lut3DInterpolation::TETRAHEDRAL};
+    float intensity{1.0f};
+};
+
+bool hasColorControls(const FilterParams& p) {
+    return std::abs(p.brightness) > 1e-6 || std::abs(p.contrast - 1.0) > 1e-6 ||
+           std::abs(p.saturation - 1.0) > 1e-6 || std::abs(p.gamma - 1.0) > 1e-6 ||
+           std::abs(p.hue) > 1e-6;
+}
+
+bool lutPath(const FilterState& filter, std::string& path, Lut3DInterpolation& interp) {
+    interp = Lut3DInterpolation::TETRAHEDRAL;
+    if (filter.type != FilterType::CUSTOM) return false;
+    const bool named = LutFilterProcessor::parseName(filter.params.customFilterName, path, interp);
+    if (!filter.params.customLUTPath.empty()) path = filter.params.customLUTPath;
+    return named || !path.empty();
+}
+
+bool buildStages(const PointwiseChain& chain, const std::string& lutCacheDir,
+                 std::vector<Stage>& stages, std::string& error) {
+    for (const auto& filter : chain.filters) {
+        if (ColorMatrixFilterProcessor::canCompile(filter)) {
+            Stage s;
+            s.program = ColorMatrixFilterProcessor::compile(filter);
+            stages.push_back(std::move(s));
+            continue;
+        }
+        std::string path;
+        Lut3DInterpolation interp;
+        if (!lutPath(filter, path, interp)) {
+            error = "Filtre non ponctuel: " + std::to_string(static_cast<int>(filter.type));
+            return false;
+        }
+        // Même ordre que le graphe FFmpeg : eq/hue puis lut3d
+        if (hasColorControls(filter.params)) {
+            Stage s;
+            s.program = ColorMatrixFilterProcessor::compile(FilterState(FilterType::COLOR_CONTROLS, filter.params));
+            stages.push_back(std::move(s));
+        }
+        Stage s;
+        s.isLut = true;
+        s.lut = Lut3D::load(path, lutCacheDir, error);
+        if (!s.lut) return false;
+        s.interp = interp;
+        s.intensity = static_cast<float>(std::clamp(filter.params.intensity, 0.0, 1.0));
+        stages.push_back(std::move(s));
+    }
+    return true;
+}
+
+// Exposition et balance des blancs en lumière linéaire (gamma 2.2), avant les filtres.
+// Gains proches de CITemperatureAndTint (neutre 6500 K + 2000 K × warmth, tint × 50)
+// utilisé par le repli Core Image.
+struct AdjustmentGains {
+    bool active{false};
+    float gain[3]{1.0f, 1.0f, 1.0f};
+};
+
+AdjustmentGains adjustmentGains(const ColorAdjustments& a) {
+    AdjustmentGains g;
+    g.active = !a.isNeutral();
+    const double ev = std::pow(2.0, std::clamp(a.exposure, -2.0, 2.0));
+    const double warmth = std::clamp(a.warmth, -1.0, 1.0);
+    const double tint = std::clamp(a.tint, -1.0, 1.0);
+    g.gain[0] = static_cast<float>(ev * (1.0 + 0.2 * warmth) * (1.0 + 0.05 * tint));
+    g.gain[1] = static_cast<float>(ev * (1.0 - 0.1 * tint));
+    g.gain[2] = static_cast<float>(ev * (1.0 - 0.2 * warmth) * (1.0 + 0.05 * tint));
+    return g;
+}
+
+} // namespace
+
+bool ColorAdjustments::isNeutral() const {
+    return std::abs(exposure) < 1e-6 && std::abs(warmth) < 1e-6 && std::abs(tint) < 1e-6;
+}
+
+FilterChainCompiler::FilterChainCompiler(int lutSize)
+    : lutSize_(std::clamp(lutSize, Lut3D::kMinSize, Lut3D::kMaxSize)) {
+}
+
+FilterChainCompiler::~FilterChainCompiler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+bool FilterChainCompiler::isPointwise(const FilterState& filter) {
+    if (ColorMatrixFilterProcessor::canCompile(filter)) return true;
+    std::string path;
+    Lut3DInterpolation interp;
+    return lutPath(filter, path, interp);
+}
+
+bool FilterChainCompiler::isPointwise(const PointwiseChain& chain) {
+    return std::all_of(chain.filters.begin(), chain.filters.end(),
+                       [](const FilterState& f) { return isPointwise(f); });
+}
+
+bool FilterChainCompiler::needsBake(const PointwiseChain& chain) {
+    if (!isPointwise(chain) || (chain.filters.empty() && chain.adjustments.isNeutral())) return false;
+    if (!chain.adjustments.isNeutral() || chain.filters.size() > 1) return true;
+    // Un seul filtre : une passe suffit, sauf pour une LUT précédée d'eq/hue
+    const FilterState& f = chain.filters.front();
+    return !ColorMatrixFilterProcessor::canCompile(f) && hasColorControls(f.params);
+}
+
+std::shared_ptr<const Lut3D> FilterChainCompiler::bake(const PointwiseChain& chain, int size,
+                                                       const std::string& lutCacheDir, std::string& error) {
+    std::vector<Stage> stages;
+    if (!buildStages(chain, lutCacheDir, stages, error)) return nullptr;
+    const AdjustmentGains adjust = adjustmentGains(chain.adjustments);
+
+    return Lut3D::fromFunction(size, [&](float r, float g, float b, float* out) {
+        float c[3] = {r, g, b};
+        if (adjust.active) {
+            for (int i = 0; i < 3; ++i) {
+                const float linear = std::pow(c[i], 2.2f) * adjust.gain[i];
+                c[i] = std::pow(std::min(linear, 1.0f), 1.0f / 2.2f);
+            }
+        }
+        for (const auto& s : stages) {
+            if (!s.isLut) {
+                ColorMatrixFilterProcessor::evaluate(s.program, c);
+                continue;
+            }
+            float l[3];
+            s.lut->sample(c, l, s.interp);
+            for (int i = 0; i < 3; ++i) c[i] += (l[i] - c[i]) * s.intensity;
+        }
+        out[0] = c[0];
+        out[1] = c[1];
+        out[2] = c[2];
+    });
+}
+
+uint64_t FilterChainCompiler::submit(const PointwiseChain& chain) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = chain;
+        generation = ++requested_;
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&FilterChainCompiler::workerLoop, this);
+        }
+    }
+    wake_.notify_one();
+    return generation;
+}
+
+std::shared_ptr<const Lut3D> FilterChainCompiler::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+}
+
+uint64_t FilterChainCompiler::currentGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return baked_;
+}
+
+bool FilterChainCompiler::isUpToDate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_ && baked_ == requested_;
+}
+
+void FilterChainCompiler::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return stop_ || (!busy_ && processed_ == requested_); });
+}
+
+void FilterChainCompiler::setLutSize(int size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lutSize_ = std::clamp(size, Lut3D::kMinSize, Lut3D::kMaxSize);
+}
+
+void FilterChainCompiler::setLutCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lutCacheDir_ = directory;
+}
+
+double FilterChainCompiler::lastBakeMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastBakeMs_;
+}
+
+std::string FilterChainCompiler::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+void FilterChainCompiler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t taken = 0;
+    while (true) {
+        wake_.wait(lock, [&] { return stop_ || requested_ != taken; });
+        if (stop_) break;
+
+        // Copie de la dernière demande : les suivantes attendront la fin de ce bake
+        const PointwiseChain chain = pending_;
+        const int size = lutSize_;
+        const std::string cacheDir = lutCacheDir_;
+        taken = requested_;
+        busy_ = true;
+        lock.unlock();
+
+        std::string error;
+        const auto t0 = std::chrono::steady_clock::now();
+        auto lut = bake(chain, size, cacheDir, error);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        lock.lock();
+        busy_ = false;
+        if (lut) {
+            current_ = std::move(lut);
+            baked_ = taken;
+            lastBakeMs_ = ms;
+        } else {
+            // LUT précédente conservée
+            lastError_ = error;
+            std::cout << "[FilterChainCompiler] Erreur: " << error << std::endl;
+        }
+        processed_ = taken;
+        if (processed_ == requested_) idle_.notify_all();
+    }
+    busy_ = false;
+    idle_.notify_all();
+}
+
+} // namespace Camera
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../common/FilterTypes.hpp"
+#include "Lut3D.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Camera {
+
+// Réglages de prise de vue hors FilterParams (NaayaAdvancedFilterParams)
+struct ColorAdjustments {
+    double exposure{0.0};   // EV (-2 à 2)
+    double warmth{0.0};     // Température (-1 froid à 1 chaud)
+    double tint{0.0};       // Teinte (-1 vert à 1 magenta)
+
+    bool isNeutral() const;
+};
+
+// Chaîne ponctuelle : réglages de prise de vue puis filtres dans l'ordre d'application
+struct PointwiseChain {
+    ColorAdjustments adjustments;
+    std::vector<FilterState> filters;
+};
+
+/**
+ * Compile une chaîne de filtres ponctuels (eq/hue/colorbalance, effets, LUT utilisateur,
+ * exposition/température/teinte) en une seule LUT 3D : chaque image coûte alors une
+ * interpolation, quel que soit le nombre d'ajustements empilés.
+ *
+ * Le bake tourne sur un thread dédié à chaque changement de chaîne; current() continue de
+ * renvoyer la LUT précédente jusqu'à ce que la nouvelle soit prête. Les demandes arrivées
+ * pendant un bake sont fusionnées : seule la dernière est calculée.
+ */
+class FilterChainCompiler {
+public:
+    explicit FilterChainCompiler(int lutSize = 33);
+    ~FilterChainCompiler();
+
+    FilterChainCompiler(const FilterChainCompiler&) = delete;
+    FilterChainCompiler& operator=(const FilterChainCompiler&) = delete;
+
+    // Filtre évaluable couleur par couleur (matrice couleur ou LUT 3D)
+    static bool isPointwise(const FilterState& filter);
+    static bool isPointwise(const PointwiseChain& chain);
+    // Vrai si la chaîne demanderait plus d'une passe sans bake
+    static bool needsBake(const PointwiseChain& chain);
+
+    // Bake synchrone (33 ou 65 typiquement); nullptr si un étage est invalide
+    static std::shared_ptr<const Lut3D> bake(const PointwiseChain& chain, int size,
+                                             const std::string& lutCacheDir, std::string& error);
+
+    // Bake asynchrone de la chaîne; retourne le numéro de la demande
+    uint64_t submit(const PointwiseChain& chain);
+
+    // Dernière LUT terminée (nullptr avant le premier bake)
+    std::shared_ptr<const Lut3D> current() const;
+    // Numéro de la demande ayant produit current()
+    uint64_t currentGeneration() const;
+    bool isUpToDate() const;
+    // Bloque jusqu'à la fin des demandes en cours (benchmarks, tests manuels)
+    void waitIdle();
+
+    void setLutSize(int size);
+    void setLutCacheDirectory(const std::string& directory);
+    double lastBakeMs() const;
+    std::string getLastError() const;
+
+private:
+    void workerLoop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::thread worker_;
+    bool stop_{false};
+    bool busy_{false};
+
+    int lutSize_;
+    std::string lutCacheDir_;
+    PointwiseChain pending_;
+    uint64_t requested_{0};
+    uint64_t baked_{0};       // demande ayant produit current_
+    uint64_t processed_{0};   // dernière demande traitée (succès ou échec)
+    std::shared_ptr<const Lut3D> current_;
+    double lastBakeMs_{0.0};
+    std::string lastError_;
+};
+
+} // namespace Camera
@@ -1,5 +1,7 @@
 #include "FilterFactory.hpp"
 #include "FFmpegFilterProcessor.hpp"
+#include "ColorMatrixFilterProcessor.hpp"
+#include "LutFilterProcessor.hpp"
 #include <iostream>
 
 namespace Camera {
@@ -18,6 +20,12 @@ std::shared_ptr<IFilterProcessor> FilterFactory::createProcessor(ProcessorType t
         case ProcessorType::OPENGL:
             return createOpenGLProcessor();
         
+        case ProcessorType::COLOR_MATRIX:
+            return createColorMatrixProcessor();
+        
+        case ProcessorType::LUT3D:
+            return createLut3DProcessor();
+        
         case ProcessorType::CUSTOM:
             // Pour l'instant, retourner FFmpeg comme fallback
             std::cout << "[FilterFactory] Processeur CUSTOM non implémenté, fallback vers FFmpeg" << std::endl;
@@ -46,6 +54,16 @@ std::shared_ptr<IFilterProcessor> FilterFactory::createOpenGLProcessor() {
     return createFFmpegProcessor();
 }
 
+std::shared_ptr<IFilterProcessor> FilterFactory::createColorMatrixProcessor() {
+    std::cout << "[FilterFactory] Création du processeur matrice couleur" << std::endl;
+    return std::make_shared<ColorMatrixFilterProcessor>();
+}
+
+std::shared_ptr<IFilterProcessor> FilterFactory::createLut3DProcessor() {
+    std::cout << "[FilterFactory] Création du processeur LUT 3D" << std::endl;
+    return std::make_shared<LutFilterProcessor>();
+}
+
 std::vector<std::string> FilterFactory::getAvailableProcessorTypes() {
     std::vector<std::string> types;
     
@@ -60,6 +78,10 @@ std::vector<std::string> FilterFactory::getAvailableProcessorTypes() {
     // OpenGL disponible partout
     types.push_back("OPENGL");
     
+    // Matrice couleur native (CPU, sans dépendance)
+    types.push_back("COLOR_MATRIX");
+    types.push_back("LUT3D");
+    
     return types;
 }
 
@@ -78,6 +100,10 @@ bool FilterFactory::isProcessorTypeAvailable(ProcessorType type) {
         case ProcessorType::OPENGL:
             return true; // OpenGL disponible partout
         
+        case ProcessorType::COLOR_MATRIX:
+        case ProcessorType::LUT3D:
+            return true; // CPU, toujours disponible
+        
         case ProcessorType::CUSTOM:
             return false; // Pas encore implémenté
         
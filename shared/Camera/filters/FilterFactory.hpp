@@ -17,6 +17,8 @@ public:
         FFMPEG,     // Processeur FFmpeg
         CORE_IMAGE, // Processeur Core Image (iOS)
         OPENGL,     // Processeur OpenGL
+        COLOR_MATRIX, // Matrice couleur native SIMD (filtres ponctuels)
+        LUT3D,      // LUT 3D .cube native SIMD
         CUSTOM      // Processeur personnalisé
     };
     
@@ -25,6 +27,8 @@ public:
     static std::shared_ptr<IFilterProcessor> createFFmpegProcessor();
     static std::shared_ptr<IFilterProcessor> createCoreImageProcessor();
     static std::shared_ptr<IFilterProcessor> createOpenGLProcessor();
+    static std::shared_ptr<IFilterProcessor> createColorMatrixProcessor();
+    static std::shared_ptr<IFilterProcessor> createLut3DProcessor();
     
     // Informations sur les processeurs
     static std::vector<std::string> getAvailableProcessorTypes();
@@ -2,8 +2,6 @@
 #include <iostream>
 #include <algorithm>
 #include <cstring>
-#include <thread>
-#include <future>
 #if defined(__AVX2__)
 #include <immintrin.h>
 #elif defined(__SSE2__)
@@ -12,44 +10,14 @@
 
 namespace Camera {
 
-// ThreadPool implementation
-ThreadPool::ThreadPool(size_t numThreads) {
-    for (size_t i = 0; i < numThreads; ++i) {
-        workers_.emplace_back([this] {
-            while (true) {
-                std::function<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(queueMutex_);
-                    condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
-                    if (stop_ && tasks_.empty()) {
-                        return;
-                    }
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
-                }
-                task();
-            }
-        });
-    }
-}
-
-ThreadPool::~ThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(queueMutex_);
-        stop_ = true;
-    }
-    condition_.notify_all();
-    for (std::thread& worker : workers_) {
-        worker.join();
-    }
-}
-
 FilterManager::FilterManager() {
     std::cout << "[FilterManager] Construction" << std::endl;
-    // Initialiser le thread pool avec le nombre optimal de threads
-    size_t numThreads = std::min(std::thread::hardware_concurrency(), 8u);
-    threadPool_ = std::make_unique<ThreadPool>(numThreads);
-    parallelBuffers_.resize(numThreads);
+    // Ordonnanceur partagé : workers + thread appelant, borné à 8
+    scheduler_ = &Common::TaskScheduler::shared();
+    size_t numThreads = std::min(scheduler_->concurrency(), size_t(8));
+    threadPoolSize_ = numThreads;
+    stripeExecutor_ = std::make_unique<FrameStripeExecutor>(numThreads);
+    chainCompiler_ = std::make_unique<FilterChainCompiler>();
 }
 
 FilterManager::~FilterManager() {
@@ -94,6 +62,9 @@ void FilterManager::shutdown() {
     processors_.clear();
     processorMap_.clear();
     activeFilters_.clear();
+    snapshot_.reset();
+    stripeExecutor_->reset();
+    scratchPool_.reset();
     
     initialized_ = false;
     std::cout << "[FilterManager] Arrêt terminé" << std::endl;
@@ -118,6 +89,9 @@ bool FilterManager::registerProcessor(std::shared_ptr<IFilterProcessor> processo
         setLastError("Échec d'initialisation du processeur: " + name);
         return false;
     }
+    if (inputWidth_ > 0 && inputHeight_ > 0) {
+        processor->setVideoFormat(inputWidth_, inputHeight_, inputFormat_);
+    }
     
     processors_.push_back(processor);
     processorMap_[name] = processor;
@@ -147,6 +121,7 @@ bool FilterManager::unregisterProcessor(const std::string& name) {
         processors_.end()
     );
     processorMap_.erase(it);
+    ++chainVersion_;
     
     std::cout << "[FilterManager] Processeur désenregistré: " << name << std::endl;
     return true;
@@ -179,11 +154,14 @@ bool FilterManager::addFilter(const FilterState& filter) {
         return false;
     }
     
-    // Retirer l'ancien filtre du même type s'il existe
-    removeFilter(filter.type);
+    // Retirer l'ancien filtre du même type s'il existe (mutex déjà tenu : pas de removeFilter)
+    activeFilters_.erase(std::remove_if(activeFilters_.begin(), activeFilters_.end(),
+                                        [&](const FilterState& f) { return f.type == filter.type; }),
+                         activeFilters_.end());
     
     // Ajouter le nouveau filtre
     activeFilters_.push_back(filter);
+    ++chainVersion_;
     
     std::cout << "[FilterManager] Filtre ajouté: " << static_cast<int>(filter.type) 
               << " (intensité: " << filter.params.intensity << ")" << std::endl;
@@ -200,6 +178,7 @@ bool FilterManager::removeFilter(FilterType type) {
     
     if (it != activeFilters_.end()) {
         activeFilters_.erase(it);
+        ++chainVersion_;
         std::cout << "[FilterManager] Filtre retiré: " << static_cast<int>(type) << std::endl;
         return true;
     }
@@ -211,6 +190,7 @@ bool FilterManager::clearFilters() {
     std::lock_guard<std::mutex> lock(mutex_);
     
     activeFilters_.clear();
+    ++chainVersion_;
     std::cout << "[FilterManager] Tous les filtres supprimés" << std::endl;
     return true;
 }
@@ -280,26 +260,40 @@ bool FilterManager::processFrame(const void* inputData, size_t inputSize,
         }
     }
     
-    // Optimisation: réutiliser les buffers temporaires
-    static thread_local std::vector<uint8_t> tempBuffer1;
-    static thread_local std::vector<uint8_t> tempBuffer2;
-    
-    // Préallouer les buffers si nécessaire
-    if (tempBuffer1.size() < inputSize) {
-        tempBuffer1.resize(inputSize * 2);  // Prévoir de la marge
+    // Chaîne entièrement ponctuelle : une seule interpolation dans la LUT compilée
+    if (applyCompiledChain(inputData, inputSize, outputData, outputSize)) {
+        return true;
     }
-    if (tempBuffer2.size() < inputSize) {
-        tempBuffer2.resize(inputSize * 2);
+    
+    // Buffers intermédiaires (chaînes de 2 filtres et plus) : 2 images d'un pool à la taille du flux
+    const size_t passes = activeFilters_.size();
+    FrameRef scratch[2];
+    if (passes > 1) {
+        const FrameLayout layout = FrameLayout::forBytes(std::max(inputSize, outputSize));
+        if (!scratchPool_ || scratchPool_->layout() != layout) {
+            FramePoolConfig poolConfig;
+            poolConfig.name = "FilterManager";
+            poolConfig.layout = layout;
+            poolConfig.capacity = 2;
+            scratchPool_ = std::make_unique<FramePool>(poolConfig);
+        }
+        scratch[0] = scratchPool_->acquire();
+        if (passes > 2) {
+            scratch[1] = scratchPool_->acquire();
+        }
+        if (!scratch[0] || (passes > 2 && !scratch[1])) {
+            setLastError("Pool d'images intermédiaires épuisé");
+            return false;
+        }
     }
     
     // Utiliser double buffering pour éviter les copies
     void* currentInput = const_cast<void*>(inputData);
-    void* currentOutput = tempBuffer1.data();
+    void* currentOutput = nullptr;
     size_t currentSize = inputSize;
-    bool useBuffer1 = true;
     
     // Traiter chaque filtre avec double buffering
-    for (size_t i = 0; i < activeFilters_.size(); ++i) {
+    for (size_t i = 0; i < passes; ++i) {
         const auto& filter = activeFilters_[i];
         std::shared_ptr<IFilterProcessor> processor;
         
@@ -309,11 +303,11 @@ bool FilterManager::processFrame(const void* inputData, size_t inputSize,
         }
         
         // Dernier filtre: écrire directement dans outputData
-        if (i == activeFilters_.size() - 1) {
+        if (i == passes - 1) {
             currentOutput = outputData;
         } else {
             // Alterner entre les buffers
-            currentOutput = useBuffer1 ? tempBuffer2.data() : tempBuffer1.data();
+            currentOutput = scratch[i % 2].data();
         }
         
         // Appliquer le filtre
@@ -326,7 +320,6 @@ bool FilterManager::processFrame(const void* inputData, size_t inputSize,
         // Préparer pour le prochain filtre
         currentInput = currentOutput;
         currentSize = outputSize;  // Supposer que la taille reste constante
-        useBuffer1 = !useBuffer1;
     }
     
     return true;
@@ -334,107 +327,82 @@ bool FilterManager::processFrame(const void* inputData, size_t inputSize,
 
 bool FilterManager::processFrameParallel(const void* inputData, size_t inputSize,
                                         void* outputData, size_t outputSize) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!initialized_) {
-        setLastError("FilterManager non initialisé");
-        return false;
+    std::shared_ptr<const FilterChainSnapshot> chain;
+    Common::TaskPriority priority;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!initialized_) {
+            setLastError("FilterManager non initialisé");
+            return false;
+        }
+        chain = stripeSnapshot(inputSize, outputSize);
+        priority = taskPriority_;
     }
     
-    if (activeFilters_.empty()) {
-        // Pas de filtres actifs, utiliser processFrame standard
+    // Pas de filtres, format planaire ou processeur sans clone : traitement séquentiel
+    if (!chain) {
         return processFrame(inputData, inputSize, outputData, outputSize);
     }
     
-    // Pour le traitement parallèle d'images, diviser l'image en bandes horizontales
-    if (inputHeight_ <= 0 || inputWidth_ <= 0) {
-        // Pas d'informations sur les dimensions, utiliser le traitement séquentiel
-        return processFrame(inputData, inputSize, outputData, outputSize);
+    // Bandes exécutées hors du mutex : la chaîne figée suffit aux workers
+    std::string error;
+    if (!stripeExecutor_->run(*chain, static_cast<const uint8_t*>(inputData),
+                              static_cast<uint8_t*>(outputData), *scheduler_, priority, error)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        setLastError(error);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const FilterChainSnapshot> FilterManager::stripeSnapshot(size_t inputSize, size_t outputSize) {
+    if (activeFilters_.empty() || inputWidth_ <= 0 || inputHeight_ <= 0) {
+        return nullptr;
+    }
+    int bytesPerPixel = 0;
+    if (inputFormat_ == "bgra" || inputFormat_ == "rgba" || inputFormat_ == "rgb0" || inputFormat_ == "bgr0") {
+        bytesPerPixel = 4;
+    } else if (inputFormat_ == "rgb24" || inputFormat_ == "bgr24") {
+        bytesPerPixel = 3;
+    }
+    const size_t frameBytes = static_cast<size_t>(inputWidth_) * inputHeight_ * bytesPerPixel;
+    if (bytesPerPixel == 0 || inputSize < frameBytes || outputSize < frameBytes) {
+        return nullptr;
     }
     
-    // Calculer la taille d'une ligne
-    size_t bytesPerPixel = inputSize / (inputHeight_ * inputWidth_);
-    size_t bytesPerRow = inputWidth_ * bytesPerPixel;
-    
-    // Diviser en bandes pour traitement parallèle
-    size_t numThreads = std::min(static_cast<size_t>(inputHeight_), threadPoolSize_);
-    size_t rowsPerThread = inputHeight_ / numThreads;
-    size_t remainingRows = inputHeight_ % numThreads;
-    
-    std::vector<std::future<bool>> futures;
-    futures.reserve(numThreads);
-    
-    const uint8_t* inputBytes = static_cast<const uint8_t*>(inputData);
-    uint8_t* outputBytes = static_cast<uint8_t*>(outputData);
+    // LUT compilée : BGRA/RGBA uniquement (sinon passes successives, comme processFrame)
+    const auto lut = (inputFormat_ == "bgra" || inputFormat_ == "rgba") ? compiledChainLut() : nullptr;
+    if (snapshot_ && snapshot_->version == chainVersion_ && snapshot_->compiledLut == lut &&
+        snapshot_->width == inputWidth_ && snapshot_->height == inputHeight_ &&
+        snapshot_->pixelFormat == inputFormat_) {
+        return snapshot_;
+    }
     
-    size_t currentRow = 0;
-    for (size_t i = 0; i < numThreads; ++i) {
-        size_t rowsToProcess = rowsPerThread;
-        if (i < remainingRows) {
-            rowsToProcess++;
-        }
-        
-        if (rowsToProcess == 0) continue;
-        
-        size_t offset = currentRow * bytesPerRow;
-        size_t chunkSize = rowsToProcess * bytesPerRow;
-        
-        // Enqueue task for this chunk
-        futures.push_back(threadPool_->enqueue([this, i, inputBytes, outputBytes, offset, chunkSize]() {
-            // Assurer que le buffer local est assez grand
-            if (parallelBuffers_[i].size() < chunkSize * 2) {
-                parallelBuffers_[i].resize(chunkSize * 2);
+    auto chain = std::make_shared<FilterChainSnapshot>();
+    chain->pixelFormat = inputFormat_;
+    chain->width = inputWidth_;
+    chain->height = inputHeight_;
+    chain->bytesPerPixel = bytesPerPixel;
+    chain->version = chainVersion_;
+    chain->compiledLut = lut;
+    if (!lut) {
+        for (const auto& filter : activeFilters_) {
+            StripeStage stage;
+            stage.filter = filter;
+            if (!findBestProcessor(filter, stage.origin)) {
+                return nullptr;
             }
-            
-            const void* chunkInput = inputBytes + offset;
-            void* chunkOutput = outputBytes + offset;
-            
-            // Traiter chaque filtre pour cette bande
-            void* currentInput = const_cast<void*>(chunkInput);
-            void* currentOutput = parallelBuffers_[i].data();
-            bool useFirstBuffer = true;
-            
-            for (size_t j = 0; j < activeFilters_.size(); ++j) {
-                const auto& filter = activeFilters_[j];
-                std::shared_ptr<IFilterProcessor> processor;
-                
-                if (!findBestProcessor(filter, processor)) {
-                    return false;
-                }
-                
-                // Dernier filtre: écrire directement dans la sortie
-                if (j == activeFilters_.size() - 1) {
-                    currentOutput = chunkOutput;
-                } else {
-                    // Alterner entre les buffers
-                    size_t bufferOffset = useFirstBuffer ? chunkSize : 0;
-                    currentOutput = parallelBuffers_[i].data() + bufferOffset;
-                }
-                
-                if (!processor->applyFilter(filter, currentInput, chunkSize, 
-                                          currentOutput, chunkSize)) {
-                    return false;
-                }
-                
-                currentInput = currentOutput;
-                useFirstBuffer = !useFirstBuffer;
+            // Clone privé pris sous le mutex : les workers ne touchent jamais au processeur partagé
+            stage.seed = stage.origin->clone();
+            if (!stage.seed) {
+                return nullptr;
             }
-            
-            return true;
-        }));
-        
-        currentRow += rowsToProcess;
-    }
-    
-    // Attendre que tous les threads terminent
-    bool success = true;
-    for (auto& future : futures) {
-        if (!future.get()) {
-            success = false;
+            stage.halo = std::max(0, stage.origin->haloRows(filter));
+            chain->stages.push_back(std::move(stage));
         }
     }
-    
-    return success;
+    snapshot_ = chain;
+    return snapshot_;
 }
 
 void FilterManager::setParallelProcessing(bool enabled) {
@@ -452,13 +420,30 @@ void FilterManager::setThreadPoolSize(size_t numThreads) {
     std::lock_guard<std::mutex> lock(mutex_);
     threadPoolSize_ = std::max(size_t(1), std::min(numThreads, size_t(16)));
     
-    // Recréer le thread pool avec la nouvelle taille
-    threadPool_ = std::make_unique<ThreadPool>(threadPoolSize_);
-    parallelBuffers_.resize(threadPoolSize_);
+    // Les workers de l'ordonnanceur restent en place : seul le nombre de bandes est borné
+    stripeExecutor_->setWorkers(std::min(threadPoolSize_, scheduler_->concurrency()));
     
     std::cout << "[FilterManager] Taille du pool de threads: " << threadPoolSize_ << std::endl;
 }
 
+void FilterManager::setTaskPriority(Common::TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    taskPriority_ = priority;
+}
+
+void FilterManager::setStripeCount(int stripes) {
+    stripeExecutor_->setStripeCount(stripes);
+}
+
+StripeExecutorStats FilterManager::getStripeStats() const {
+    return stripeExecutor_->getStats();
+}
+
+FramePoolStats FilterManager::getScratchPoolStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scratchPool_ ? scratchPool_->getStats() : FramePoolStats{};
+}
+
 bool FilterManager::setInputFormat(const std::string& format, int width, int height) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -466,6 +451,11 @@ bool FilterManager::setInputFormat(const std::string& format, int width, int hei
     inputWidth_ = width;
     inputHeight_ = height;
     
+    // Dimensions propagées aux processeurs (applyFilter travaille sur des buffers contigus)
+    for (auto& processor : processors_) {
+        processor->setVideoFormat(width, height, format);
+    }
+    
     std::cout << "[FilterManager] Format d'entrée défini: " << format 
               << " (" << width << "x" << height << ")" << std::endl;
     return true;
@@ -500,7 +490,14 @@ std::vector<FilterInfo> FilterManager::getAvailableFilters() const {
     
     for (const auto& processor : processors_) {
         auto filters = processor->getSupportedFilters();
-        allFilters.insert(allFilters.end(), filters.begin(), filters.end());
+        // Un même filtre peut être fourni par plusieurs processeurs
+        for (auto& info : filters) {
+            const bool known = std::any_of(allFilters.begin(), allFilters.end(),
+                                           [&](const FilterInfo& f) { return f.name == info.name; });
+            if (!known) {
+                allFilters.push_back(std::move(info));
+            }
+        }
     }
     
     return allFilters;
@@ -559,14 +556,102 @@ FilterState FilterManager::createCustomFilter(const std::string& name, const std
 }
 
 // Méthodes privées
+void FilterManager::setColorAdjustments(const ColorAdjustments& adjustments) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    adjustments_ = adjustments;
+    ++chainVersion_;
+}
+
+void FilterManager::setChainCompilation(bool enabled, int lutSize) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    chainCompilationEnabled_ = enabled;
+    chainCompiler_->setLutSize(lutSize);
+    ++chainVersion_;
+}
+
+bool FilterManager::isChainCompilationEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chainCompilationEnabled_;
+}
+
+std::shared_ptr<const Lut3D> FilterManager::compiledChainLut() {
+    if (!chainCompilationEnabled_ || inputWidth_ <= 0 || inputHeight_ <= 0) {
+        return nullptr;
+    }
+    // Chaîne modifiée : nouveau bake en arrière-plan, l'ancienne LUT sert en attendant
+    if (chainVersion_ != submittedChainVersion_) {
+        submittedChainVersion_ = chainVersion_;
+        PointwiseChain chain;
+        chain.adjustments = adjustments_;
+        chain.filters = activeFilters_;
+        useCompiledChain_ = FilterChainCompiler::needsBake(chain);
+        if (useCompiledChain_) {
+            chainCompiler_->submit(chain);
+        }
+    }
+    if (!useCompiledChain_) {
+        return nullptr;
+    }
+    return chainCompiler_->current();   // nullptr pendant le premier bake : passes successives
+}
+
+bool FilterManager::applyCompiledChain(const void* inputData, size_t inputSize,
+                                       void* outputData, size_t outputSize) {
+    const auto lut = compiledChainLut();
+    if (!lut) {
+        return false;
+    }
+    
+    const int w = inputWidth_;
+    const int h = inputHeight_;
+    const auto* in = static_cast<const uint8_t*>(inputData);
+    auto* out = static_cast<uint8_t*>(outputData);
+    if (inputFormat_ == "bgra" || inputFormat_ == "rgba") {
+        const size_t frameBytes = static_cast<size_t>(w) * h * 4;
+        if (inputSize < frameBytes || outputSize < frameBytes) {
+            return false;
+        }
+        lut->applyPacked(in, w * 4, w, h, inputFormat_ == "bgra", out, w * 4,
+                         Lut3DInterpolation::TETRAHEDRAL, 1.0f);
+        return true;
+    }
+    if (inputFormat_ == "nv12") {
+        // Y (stride = largeur) puis UV entrelacé
+        const int uvStride = (w + 1) / 2 * 2;
+        const size_t ySize = static_cast<size_t>(w) * h;
+        const size_t frameBytes = ySize + static_cast<size_t>(uvStride) * ((h + 1) / 2);
+        if (inputSize < frameBytes || outputSize < frameBytes) {
+            return false;
+        }
+        lut->applyNV12(in, w, in + ySize, uvStride, w, h, out, w, out + ySize, uvStride,
+                       Nv12Format{}, Lut3DInterpolation::TETRAHEDRAL, 1.0f);
+        return true;
+    }
+    return false;
+}
+
 bool FilterManager::findBestProcessor(const FilterState& filter, std::shared_ptr<IFilterProcessor>& processor) {
+    // Priorité la plus élevée parmi les processeurs compatibles avec le format d'entrée
+    // (ex: matrice couleur native avant FFmpeg pour les filtres ponctuels)
+    std::shared_ptr<IFilterProcessor> best;
+    std::shared_ptr<IFilterProcessor> fallback;
     for (const auto& proc : processors_) {
-        if (proc->supportsFilter(filter.type)) {
-            processor = proc;
-            return true;
+        if (!proc->canProcess(filter)) {
+            continue;
+        }
+        if (!fallback) {
+            fallback = proc;
+        }
+        if (!inputFormat_.empty() && !proc->supportsFormat(inputFormat_)) {
+            continue;
+        }
+        if (!best || proc->getPriority() > best->getPriority()) {
+            best = proc;
         }
     }
-    return false;
+    // Aucun processeur déclarant le format : premier compatible avec le filtre
+    processor = best ? best : fallback;
+    return processor != nullptr;
 }
 
 void FilterManager::setLastError(const std::string& error) {
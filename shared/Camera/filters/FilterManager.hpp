@@ -1,49 +1,17 @@
 #pragma once
 
 #include "../common/FilterTypes.hpp"
+#include "FilterChainCompiler.hpp"
+#include "FrameStripeExecutor.hpp"
+#include "../pipeline/FramePool.hpp"
+#include "../../Common/TaskScheduler.hpp"
 #include <memory>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
-#include <thread>
-#include <future>
-#include <queue>
-#include <condition_variable>
 
 namespace Camera {
 
-// Thread pool for parallel processing
-class ThreadPool {
-public:
-    ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
-    ~ThreadPool();
-    
-    template<typename F>
-    auto enqueue(F&& f) -> std::future<decltype(f())> {
-        auto task = std::make_shared<std::packaged_task<decltype(f())()>>(
-            std::forward<F>(f)
-        );
-        
-        auto result = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            if (stop_) {
-                throw std::runtime_error("ThreadPool stopped");
-            }
-            tasks_.emplace([task](){ (*task)(); });
-        }
-        condition_.notify_one();
-        return result;
-    }
-    
-private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queueMutex_;
-    std::condition_variable condition_;
-    bool stop_{false};
-};
-
 /**
  * Gestionnaire principal des filtres
  * Architecture modulaire permettant d'ajouter différents processeurs
@@ -73,7 +41,8 @@ public:
     bool processFrame(const void* inputData, size_t inputSize,
                      void* outputData, size_t outputSize);
     
-    // Traitement parallèle
+    // Traitement parallèle par bandes (formats packés) : chaîne figée, clones de processeurs
+    // par bande, halos pour les filtres spatiaux. Sinon, repli sur processFrame.
     bool processFrameParallel(const void* inputData, size_t inputSize,
                              void* outputData, size_t outputSize);
     
@@ -81,10 +50,24 @@ public:
     bool setInputFormat(const std::string& format, int width, int height);
     bool setOutputFormat(const std::string& format, int width, int height);
     
+    // Exposition/température/teinte appliquées avant les filtres (chaîne compilée)
+    void setColorAdjustments(const ColorAdjustments& adjustments);
+    // Chaîne ponctuelle compilée en une LUT 3D (33 ou 65) au lieu d'une passe par filtre
+    void setChainCompilation(bool enabled, int lutSize = 33);
+    bool isChainCompilationEnabled() const;
+    
     // Configuration du parallélisme
     void setParallelProcessing(bool enabled);
     bool isParallelProcessingEnabled() const;
+    // Threads par image (bandes), sur l'ordonnanceur partagé : aucun thread recréé
     void setThreadPoolSize(size_t numThreads);
+    // Priorité des bandes : Preview (affichage) ou Recording (encodage)
+    void setTaskPriority(Common::TaskPriority priority);
+    // 0 : nombre de bandes choisi d'après le coût mesuré
+    void setStripeCount(int stripes);
+    StripeExecutorStats getStripeStats() const;
+    // Buffers intermédiaires de processFrame (mémoire au plus haut, épuisements)
+    FramePoolStats getScratchPoolStats() const;
     
     // Informations
     bool isInitialized() const;
@@ -125,16 +108,32 @@ private:
     int outputWidth_{0};
     int outputHeight_{0};
     
-    // Thread pool pour traitement parallèle
-    std::unique_ptr<ThreadPool> threadPool_;
+    // Ordonnanceur partagé (vol de travail) pour le traitement parallèle
+    Common::TaskScheduler* scheduler_{nullptr};
+    Common::TaskPriority taskPriority_{Common::TaskPriority::Preview};
     bool parallelProcessingEnabled_{false};
     size_t threadPoolSize_{4};
     
-    // Buffers pour traitement parallèle
-    mutable std::vector<std::vector<uint8_t>> parallelBuffers_;
+    // Traitement par bandes : chaîne figée reconstruite quand la chaîne ou le format change
+    std::unique_ptr<FrameStripeExecutor> stripeExecutor_;
+    std::shared_ptr<const FilterChainSnapshot> snapshot_;
+    
+    // Buffers intermédiaires de processFrame, recréés quand la taille du flux change
+    std::unique_ptr<FramePool> scratchPool_;
+    
+    // Compilation de la chaîne ponctuelle (bake en arrière-plan)
+    std::unique_ptr<FilterChainCompiler> chainCompiler_;
+    ColorAdjustments adjustments_;
+    bool chainCompilationEnabled_{true};
+    bool useCompiledChain_{false};
+    uint64_t chainVersion_{1};
+    uint64_t submittedChainVersion_{0};
     
     // Méthodes privées
     bool findBestProcessor(const FilterState& filter, std::shared_ptr<IFilterProcessor>& processor);
+    bool applyCompiledChain(const void* inputData, size_t inputSize, void* outputData, size_t outputSize);
+    std::shared_ptr<const Lut3D> compiledChainLut();
+    std::shared_ptr<const FilterChainSnapshot> stripeSnapshot(size_t inputSize, size_t outputSize);
     void setLastError(const std::string& error);
     bool validateFilter(const FilterState& filter) const;
 };
@@ -0,0 +1,300 @@
+#include "FrameStripeBenchmark.hpp"
+#include "ColorMatrixFilterProcessor.hpp"
+#include "FilterManager.hpp"
+#include "LutFilterProcessor.hpp"
+#ifdef FFMPEG_AVAILABLE
+#include "FFmpegFilterProcessor.hpp"
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace Camera {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Filtre spatial de test : flou boîte séparable (RGB, alpha conservé), bords répétés.
+// CUSTOM "box_blur", rayon = customParams[0]. reportHalo=false simule un filtre qui
+// n'annonce pas son voisinage.
+class BoxBlurProcessor : public IFilterProcessor {
+public:
+    explicit BoxBlurProcessor(bool reportHalo = true) : reportHalo_(reportHalo) {}
+
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+    bool applyFilter(const FilterState& filter, const void* inputData, size_t inputSize,
+                     void* outputData, size_t outputSize) override {
+        const size_t frameBytes = static_cast<size_t>(width_) * height_ * 4;
+        if (width_ <= 0 || height_ <= 0 || inputSize < frameBytes || outputSize < frameBytes) return false;
+        const int r = radius(filter);
+        const auto* in = static_cast<const uint8_t*>(inputData);
+        auto* out = static_cast<uint8_t*>(outputData);
+        if (tmp_.size() < frameBytes) tmp_.resize(frameBytes);
+        const int n = 2 * r + 1;
+        // Horizontal puis vertical
+        for (int y = 0; y < height_; ++y) {
+            const uint8_t* row = in + static_cast<size_t>(y) * width_ * 4;
+            uint8_t* dst = tmp_.data() + static_cast<size_t>(y) * width_ * 4;
+            for (int x = 0; x < width_; ++x) {
+                int sum[3] = {0, 0, 0};
+                for (int k = -r; k <= r; ++k) {
+                    const uint8_t* p = row + std::clamp(x + k, 0, width_ - 1) * 4;
+                    sum[0] += p[0];
+                    sum[1] += p[1];
+                    sum[2] += p[2];
+                }
+                for (int c = 0; c < 3; ++c) dst[x * 4 + c] = static_cast<uint8_t>(sum[c] / n);
+                dst[x * 4 + 3] = row[x * 4 + 3];
+            }
+        }
+        for (int y = 0; y < height_; ++y) {
+            uint8_t* dst = out + static_cast<size_t>(y) * width_ * 4;
+            for (int x = 0; x < width_; ++x) {
+                int sum[3] = {0, 0, 0};
+                for (int k = -r; k <= r; ++k) {
+                    const uint8_t* p = tmp_.data() + (static_cast<size_t>(std::clamp(y + k, 0, height_ - 1)) * width_ + x) * 4;
+                    sum[0] += p[0];
+                    sum[1] += p[1];
+                    sum[2] += p[2];
+                }
+                for (int c = 0; c < 3; ++c) dst[x * 4 + c] = static_cast<uint8_t>(sum[c] / n);
+                dst[x * 4 + 3] = tmp_[(static_cast<size_t>(y) * width_ + x) * 4 + 3];
+            }
+        }
+        return true;
+    }
+
+    bool supportsFormat(const std::string& format) const override { return format == "bgra" || format == "rgba"; }
+    bool supportsFilter(FilterType type) const override { return type == FilterType::CUSTOM; }
+    bool canProcess(const FilterState& filter) const override {
+        return filter.type == FilterType::CUSTOM && filter.params.customFilterName == "box_blur";
+    }
+    std::string getName() const override { return "BoxBlurProcessor"; }
+    std::vector<FilterInfo> getSupportedFilters() const override { return {}; }
+
+    bool setVideoFormat(int width, int height, const std::string& pixelFormat) override {
+        if (!supportsFormat(pixelFormat)) return false;
+        width_ = width;
+        height_ = height;
+        return true;
+    }
+    std::shared_ptr<IFilterProcessor> clone() const override {
+        auto copy = std::make_shared<BoxBlurProcessor>(reportHalo_);
+        copy->width_ = width_;
+        copy->height_ = height_;
+        return copy;
+    }
+    int haloRows(const FilterState& filter) const override { return reportHalo_ ? radius(filter) : 0; }
+
+private:
+    static int radius(const FilterState& filter) {
+        return filter.params.customParams.empty() ? 1 : std::max(0, static_cast<int>(filter.params.customParams[0]));
+    }
+
+    bool reportHalo_;
+    int width_{0};
+    int height_{0};
+    std::vector<uint8_t> tmp_;
+};
+
+std::string writeCube(const std::string& dir) {
+    const std::string path = dir + "/naaya_stripe_bench.cube";
+    std::ofstream f(path);
+    if (!f) return {};
+    const int n = 17;
+    f << "LUT_3D_SIZE " << n << "\n" << std::fixed << std::setprecision(6);
+    for (int b = 0; b < n; ++b) {
+        for (int g = 0; g < n; ++g) {
+            for (int r = 0; r < n; ++r) {
+                const float rgb[3] = {r / float(n - 1), g / float(n - 1), b / float(n - 1)};
+                f << rgb[0] * rgb[0] * (3.0f - 2.0f * rgb[0]) << ' ' << rgb[1] << ' '
+                  << std::sqrt(rgb[2]) << '\n';
+            }
+        }
+    }
+    return f ? path : std::string();
+}
+
+std::vector<uint8_t> makeImage(int width, int height) {
+    std::vector<uint8_t> img(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = img.data() + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            row[x * 4 + 0] = static_cast<uint8_t>((x * 255) / std::max(1, width - 1));
+            row[x * 4 + 1] = static_cast<uint8_t>((y * 255) / std::max(1, height - 1));
+            row[x * 4 + 2] = static_cast<uint8_t>(((x ^ y) & 0x3F) * 4);   // détails fins : le flou les voit
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return img;
+}
+
+struct Chain {
+    std::string label;
+    std::vector<std::shared_ptr<IFilterProcessor>> processors;
+    std::vector<FilterState> filters;
+};
+
+std::unique_ptr<FilterManager> makeManager(const Chain& chain, int width, int height) {
+    auto manager = std::make_unique<FilterManager>();
+    manager->initialize();
+    // Une passe par filtre : la chaîne n'est pas réduite à une LUT compilée
+    manager->setChainCompilation(false);
+    for (const auto& processor : chain.processors) manager->registerProcessor(processor);
+    manager->setInputFormat("bgra", width, height);
+    for (const auto& filter : chain.filters) manager->addFilter(filter);
+    return manager;
+}
+
+int maxDiff(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    int diff = 0;
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        diff = std::max(diff, std::abs(int(a[i]) - int(b[i])));
+    }
+    return diff;
+}
+
+template <typename Fn>
+double measureMsPerFrame(int frames, Fn&& fn) {
+    fn();   // préchauffage : clones, graphes, LUT
+    fn();
+    const auto t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames;
+}
+
+FrameStripeBenchmarkResult runParallel(const FrameStripeBenchmarkConfig& config, const Chain& chain,
+                                       const std::string& label, int workers, bool adaptive,
+                                       const std::vector<uint8_t>& input, const std::vector<uint8_t>& reference,
+                                       double sequentialMs) {
+    FrameStripeBenchmarkResult r;
+    r.label = label;
+    r.workers = workers;
+    r.adaptive = adaptive;
+    auto manager = makeManager(chain, config.width, config.height);
+    manager->setThreadPoolSize(workers);
+    manager->setStripeCount(adaptive ? 0 : workers);
+    std::vector<uint8_t> output(input.size());
+    bool ok = true;
+    // Mode adaptatif : le modèle a besoin de quelques images pour converger
+    const int frames = adaptive ? std::max(config.frames, 20) : config.frames;
+    r.msPerFrame = measureMsPerFrame(frames, [&] {
+        ok = manager->processFrameParallel(input.data(), input.size(), output.data(), output.size()) && ok;
+    });
+    if (!ok) {
+        std::cout << "[FrameStripeBenchmark] Échec " << label << " (" << workers << " workers): "
+                  << manager->getLastError() << std::endl;
+        return r;
+    }
+    const StripeExecutorStats stats = manager->getStripeStats();
+    r.stripes = stats.lastStripes;
+    r.clones = stats.clonesCreated;
+    r.speedup = r.msPerFrame > 0.0 ? sequentialMs / r.msPerFrame : 0.0;
+    r.efficiency = r.speedup / std::max(1, workers);
+    r.maxDiff = maxDiff(output, reference);
+    return r;
+}
+
+} // namespace
+
+FrameStripeBenchmarkResults runFrameStripeBenchmark(const FrameStripeBenchmarkConfig& config) {
+    FrameStripeBenchmarkResults results;
+    results.hardwareThreads = std::thread::hardware_concurrency();
+    std::string dir = config.workDir;
+    if (dir.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        dir = tmp && *tmp ? tmp : "/tmp";
+    }
+    const std::string cubePath = writeCube(dir);
+    if (cubePath.empty()) {
+        std::cout << "[FrameStripeBenchmark] Écriture impossible dans " << dir << std::endl;
+        return results;
+    }
+    FrameStripeBenchmarkConfig cfg = config;
+    cfg.width = std::max(16, config.width);
+    cfg.height = std::max(16, config.height);
+    cfg.frames = std::max(1, config.frames);
+    const std::vector<uint8_t> input = makeImage(cfg.width, cfg.height);
+
+    FilterParams controls;
+    controls.brightness = 0.05;
+    controls.contrast = 1.15;
+    controls.saturation = 1.2;
+    FilterParams look;
+    look.intensity = 0.8;
+    look.customFilterName = "lut3d:" + cubePath;
+    FilterParams blur;
+    blur.customFilterName = "box_blur";
+    blur.customParams = {static_cast<double>(std::max(1, config.blurRadius))};
+
+    std::vector<Chain> chains;
+    chains.push_back({"ponctuelle",
+                      {std::make_shared<ColorMatrixFilterProcessor>(), std::make_shared<LutFilterProcessor>()},
+                      {FilterState(FilterType::COLOR_CONTROLS, controls), FilterState(FilterType::WARM, FilterParams()),
+                       FilterState(FilterType::CUSTOM, look)}});
+    chains.push_back({"spatiale",
+                      {std::make_shared<ColorMatrixFilterProcessor>(), std::make_shared<BoxBlurProcessor>(true)},
+                      {FilterState(FilterType::SEPIA, FilterParams()), FilterState(FilterType::CUSTOM, blur)}});
+#ifdef FFMPEG_AVAILABLE
+    chains.push_back({"FFmpeg sépia", {std::make_shared<FFmpegFilterProcessor>()},
+                      {FilterState(FilterType::SEPIA, FilterParams())}});
+#endif
+
+    for (const auto& chain : chains) {
+        // Référence : processFrame, un seul thread
+        auto manager = makeManager(chain, cfg.width, cfg.height);
+        std::vector<uint8_t> reference(input.size());
+        const double sequentialMs = measureMsPerFrame(cfg.frames, [&] {
+            manager->processFrame(input.data(), input.size(), reference.data(), reference.size());
+        });
+        if (chain.label == "ponctuelle") results.sequentialMs = sequentialMs;
+        if (chain.label == "spatiale") results.sequentialSpatialMs = sequentialMs;
+
+        for (int workers : cfg.workerCounts) {
+            results.rows.push_back(runParallel(cfg, chain, chain.label, workers, false, input, reference, sequentialMs));
+        }
+        const int most = cfg.workerCounts.empty() ? 4 : *std::max_element(cfg.workerCounts.begin(), cfg.workerCounts.end());
+        results.rows.push_back(runParallel(cfg, chain, chain.label, most, true, input, reference, sequentialMs));
+
+        if (chain.label == "spatiale") {
+            // Même chaîne, halo non annoncé : les lignes proches des frontières divergent
+            Chain noHalo = chain;
+            noHalo.processors[1] = std::make_shared<BoxBlurProcessor>(false);
+            results.rows.push_back(runParallel(cfg, noHalo, "spatiale sans halo", std::max(2, most), false,
+                                               input, reference, sequentialMs));
+        }
+    }
+    ::unlink(cubePath.c_str());
+    return results;
+}
+
+void printFrameStripeBenchmark(const FrameStripeBenchmarkResults& results) {
+    std::cout << "\n=== Traitement par bandes (" << results.hardwareThreads << " threads matériels) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "processFrame séquentiel : ponctuelle " << results.sequentialMs << " ms, spatiale "
+              << results.sequentialSpatialMs << " ms" << std::endl;
+    std::cout << std::left << std::setw(22) << "chaîne" << std::right << std::setw(9) << "workers"
+              << std::setw(8) << "bandes" << std::setw(11) << "ms/image" << std::setw(10) << "speedup"
+              << std::setw(11) << "efficacité" << std::setw(8) << "Δ max" << std::setw(8) << "clones" << std::endl;
+    for (const auto& r : results.rows) {
+        std::cout << std::left << std::setw(22) << r.label << std::right << std::setw(9) << r.workers
+                  << std::setw(7) << r.stripes << (r.adaptive ? "*" : " ") << std::setprecision(2)
+                  << std::setw(11) << r.msPerFrame << std::setw(9) << r.speedup << "x"
+                  << std::setw(10) << std::setprecision(0) << r.efficiency * 100.0 << "%"
+                  << std::setw(8) << r.maxDiff << std::setw(8) << r.clones << std::endl;
+    }
+    std::cout << "* nombre de bandes choisi d'après le coût mesuré" << std::endl;
+}
+
+} // namespace Camera
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+struct FrameStripeBenchmarkResult {
+    std::string label;              // "ponctuelle", "spatiale", "spatiale sans halo", ...
+    int workers{0};                 // threads par image (setThreadPoolSize)
+    int stripes{0};                 // bandes (dernier choix en mode adaptatif)
+    bool adaptive{false};
+    double msPerFrame{0.0};
+    double speedup{0.0};            // vs processFrame séquentiel
+    double efficiency{0.0};         // speedup / workers
+    int maxDiff{-1};                // vs processFrame séquentiel (niveaux 8 bits)
+    uint64_t clones{0};             // clones de processeurs créés
+};
+
+struct FrameStripeBenchmarkConfig {
+    int width = 1920;
+    int height = 1080;
+    int frames = 30;
+    std::vector<int> workerCounts = {1, 2, 4, 8};
+    int blurRadius = 3;             // filtre spatial de test (flou boîte vertical/horizontal)
+    std::string workDir;            // .cube de la chaîne ponctuelle (vide : $TMPDIR)
+};
+
+struct FrameStripeBenchmarkResults {
+    unsigned hardwareThreads{0};
+    double sequentialMs{0.0};       // processFrame, chaîne ponctuelle
+    double sequentialSpatialMs{0.0};
+    std::vector<FrameStripeBenchmarkResult> rows;
+};
+
+// processFrameParallel sur 1 à 8 workers (BGRA) : chaîne ponctuelle (contrôles couleur, warm,
+// LUT 3D) et chaîne spatiale (sépia + flou boîte, halo = rayon). Bandes fixes (une par worker)
+// puis nombre de bandes adaptatif; chaque sortie est comparée à processFrame. Une ligne sans
+// halo montre l'écart aux frontières de bandes. Avec FFmpeg : sépia via colorbalance, un graphe
+// par bande.
+FrameStripeBenchmarkResults runFrameStripeBenchmark(const FrameStripeBenchmarkConfig& config = {});
+void printFrameStripeBenchmark(const FrameStripeBenchmarkResults& results);
+
+} // namespace Camera
@@ -0,0 +1,328 @@
+#include "FrameStripeExecutor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <time.h>
+
+namespace Camera {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Temps CPU du thread courant : insensible au partage des cœurs entre bandes
+double threadCpuMs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+constexpr double kAlpha = 0.25;         // lissage des mesures
+constexpr int kMinSamples = 3;          // mesures avant de préférer le temps mesuré au modèle
+constexpr uint64_t kProbeEvery = 120;   // images avant d'oublier les autres mesures
+constexpr double kHysteresis = 0.95;    // gain minimal pour changer de nombre de bandes
+
+double smooth(double value, double sample) {
+    return value > 0.0 ? value + kAlpha * (sample - value) : sample;
+}
+
+// Lignes traitées en plus : chaque frontière entre bandes coûte 2 halos
+int extraRows(int stripes, int halo, int height) {
+    return std::min(height * (stripes - 1), 2 * halo * (stripes - 1));
+}
+
+} // namespace
+
+int FilterChainSnapshot::halo() const {
+    int total = 0;
+    for (const auto& stage : stages) total += stage.halo;
+    return compiledLut ? 0 : total;
+}
+
+FrameStripeExecutor::FrameStripeExecutor(size_t workers)
+    : workers_(std::max<size_t>(1, workers)) {
+}
+
+FrameStripeExecutor::~FrameStripeExecutor() = default;
+
+void FrameStripeExecutor::setWorkers(size_t workers) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers_ = std::max<size_t>(1, workers);
+    // Autre parallélisme : les mesures ne valent plus
+    std::fill(samples_.begin(), samples_.end(), 0);
+    current_ = 0;
+}
+
+void FrameStripeExecutor::setStripeCount(int stripes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fixedStripes_ = std::clamp(stripes, 0, kMaxStripes);
+}
+
+StripeExecutorStats FrameStripeExecutor::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StripeExecutorStats stats = stats_;
+    stats.workMs = workMs_;
+    stats.dispatchMs = dispatchMs_;
+    stats.parallelism = parallelism_;
+    stats.measuredMs.assign(measured_.size(), 0.0);
+    for (size_t n = 0; n < measured_.size(); ++n) {
+        if (samples_[n] > 0) stats.measuredMs[n] = measured_[n];
+    }
+    return stats;
+}
+
+void FrameStripeExecutor::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.clear();
+    inputCopy_.clear();
+    measured_.clear();
+    samples_.clear();
+    workMs_ = 0.0;
+    dispatchMs_ = 0.0;
+    parallelism_ = 0.0;
+    current_ = 0;
+    sinceProbe_ = 0;
+    prunedVersion_ = 0;
+    stats_ = StripeExecutorStats();
+}
+
+int FrameStripeExecutor::maxStripes(const FilterChainSnapshot& chain) const {
+    // Bandes assez hautes pour que le halo reste minoritaire
+    const int minRows = std::max(kMinStripeRows, 2 * chain.halo());
+    const int byHeight = std::max(1, chain.height / minRows);
+    const int byWorkers = static_cast<int>(std::min<size_t>(workers_ * 2, kMaxStripes));
+    return std::max(1, std::min(byHeight, byWorkers));
+}
+
+double FrameStripeExecutor::predictMs(int stripes, int halo, int height) const {
+    if (stripes <= 1) return workMs_;
+    // Tant qu'aucune saturation n'est mesurée, tous les workers sont supposés disponibles
+    const double cores = parallelism_ > 0.0 ? parallelism_ : static_cast<double>(workers_);
+    const int rows = height + extraRows(stripes, halo, height);
+    const double work = workMs_ * rows / height;
+    return work / std::min<double>(stripes, cores) + dispatchMs_ * stripes;
+}
+
+int FrameStripeExecutor::chooseStripes(int maxStripes) {
+    if (fixedStripes_ > 0) return std::min(fixedStripes_, maxStripes);
+    if (workMs_ <= 0.0) {
+        // Première image : une bande par worker
+        return std::min(static_cast<int>(workers_), maxStripes);
+    }
+    // Mesures anciennes oubliées : le modèle peut reproposer un autre découpage
+    if (++sinceProbe_ >= kProbeEvery) {
+        sinceProbe_ = 0;
+        for (int n = 1; n < static_cast<int>(samples_.size()); ++n) {
+            if (n != current_) samples_[n] = 0;
+        }
+    }
+    auto estimate = [&](int n) {
+        if (n < static_cast<int>(samples_.size()) && samples_[n] >= kMinSamples) return measured_[n];
+        return predictMs(n, lastHalo_, lastHeight_);
+    };
+    int best = std::clamp(current_, 1, maxStripes);
+    double bestMs = estimate(best);
+    for (int n = 1; n <= maxStripes; ++n) {
+        const double ms = estimate(n);
+        if (ms < bestMs * kHysteresis) {
+            best = n;
+            bestMs = ms;
+        }
+    }
+    return best;
+}
+
+void FrameStripeExecutor::record(int stripes, double wallMs, int halo, int height) {
+    if (static_cast<int>(measured_.size()) <= stripes) {
+        measured_.resize(stripes + 1, 0.0);
+        samples_.resize(stripes + 1, 0);
+    }
+    measured_[stripes] = samples_[stripes] > 0 ? smooth(measured_[stripes], wallMs) : wallMs;
+    ++samples_[stripes];
+
+    // Coût par bande mesuré : temps CPU total ramené à l'image sans halo, reste = surcoût
+    double cpu = 0.0;
+    double longest = 0.0;
+    int rows = 0;
+    for (int i = 0; i < stripes; ++i) {
+        cpu += slots_[i].cpuMs;
+        longest = std::max(longest, slots_[i].ms);
+        rows += slots_[i].rows;
+    }
+    if (rows > 0) workMs_ = smooth(workMs_, cpu * height / rows);
+    if (stripes > 1 && wallMs > 0.0) {
+        dispatchMs_ = smooth(dispatchMs_, std::max(0.0, wallMs - longest) / stripes);
+        // Parallélisme obtenu : proche du nombre de bandes si les cœurs suivent, sinon saturé
+        const double achieved = cpu / wallMs;
+        const double target = achieved < 0.85 * stripes ? achieved : static_cast<double>(workers_);
+        parallelism_ = std::clamp(smooth(parallelism_, target), 1.0, static_cast<double>(workers_));
+    }
+    current_ = stripes;
+    lastHalo_ = halo;
+    lastHeight_ = height;
+}
+
+void FrameStripeExecutor::pruneClones(const FilterChainSnapshot& chain) {
+    // Processeurs retirés de la chaîne : clones (et graphes FFmpeg) libérés
+    for (auto& slot : slots_) {
+        for (auto it = slot.clones.begin(); it != slot.clones.end();) {
+            const bool used = std::any_of(chain.stages.begin(), chain.stages.end(),
+                                          [&](const StripeStage& s) { return s.origin.get() == it->first; });
+            it = used ? std::next(it) : slot.clones.erase(it);
+        }
+    }
+    prunedVersion_ = chain.version;
+}
+
+IFilterProcessor* FrameStripeExecutor::cloneFor(Slot& slot, const StripeStage& stage, int width, int height,
+                                                const std::string& pixelFormat) {
+    Clone& clone = slot.clones[stage.origin.get()];
+    if (!clone.processor || clone.origin != stage.origin) {
+        clone = Clone();
+        clone.origin = stage.origin;
+        clone.processor = stage.seed ? stage.seed->clone() : nullptr;
+        if (!clone.processor) return nullptr;
+        ++slot.clonesCreated;
+    }
+    if (clone.width != width || clone.height != height || clone.pixelFormat != pixelFormat) {
+        if (!clone.processor->setVideoFormat(width, height, pixelFormat)) return nullptr;
+        clone.width = width;
+        clone.height = height;
+        clone.pixelFormat = pixelFormat;
+    }
+    return clone.processor.get();
+}
+
+bool FrameStripeExecutor::runStripe(const FilterChainSnapshot& chain, Slot& slot, int y0, int y1,
+                                    const uint8_t* input, uint8_t* output) {
+    const auto t0 = Clock::now();
+    const double cpu0 = threadCpuMs();
+    const int width = chain.width;
+    const int stride = width * chain.bytesPerPixel;
+    slot.error.clear();
+
+    if (chain.compiledLut) {
+        chain.compiledLut->applyPacked(input + static_cast<size_t>(y0) * stride, stride, width, y1 - y0,
+                                       chain.pixelFormat == "bgra", output + static_cast<size_t>(y0) * stride,
+                                       stride, Lut3DInterpolation::TETRAHEDRAL, 1.0f);
+        slot.rows = y1 - y0;
+        slot.ms = elapsedMs(t0);
+        slot.cpuMs = threadCpuMs() - cpu0;
+        return true;
+    }
+
+    // Lignes lues : la bande plus les halos (bornés par l'image)
+    const int halo = chain.halo();
+    const int a = std::max(0, y0 - halo);
+    const int b = std::min(chain.height, y1 + halo);
+    const int rows = b - a;
+    const size_t bytes = static_cast<size_t>(rows) * stride;
+    for (auto& buffer : slot.scratch) {
+        if (buffer.size() < bytes) buffer.resize(bytes);
+    }
+
+    const uint8_t* current = input + static_cast<size_t>(a) * stride;
+    const size_t stages = chain.stages.size();
+    for (size_t k = 0; k < stages; ++k) {
+        const StripeStage& stage = chain.stages[k];
+        IFilterProcessor* processor = cloneFor(slot, stage, width, rows, chain.pixelFormat);
+        if (!processor) {
+            slot.error = "Clone indisponible pour le filtre " + std::to_string(static_cast<int>(stage.filter.type));
+            return false;
+        }
+        // Sans halo, la dernière étape écrit directement les lignes de la bande
+        uint8_t* target = (k + 1 == stages && halo == 0) ? output + static_cast<size_t>(y0) * stride
+                                                         : slot.scratch[k % 2].data();
+        if (!processor->applyFilter(stage.filter, current, bytes, target, bytes)) {
+            slot.error = "Échec du filtre " + std::to_string(static_cast<int>(stage.filter.type)) + " sur une bande";
+            return false;
+        }
+        current = target;
+    }
+    if (halo > 0) {
+        // Seules les lignes propres à la bande sont écrites
+        std::memcpy(output + static_cast<size_t>(y0) * stride, current + static_cast<size_t>(y0 - a) * stride,
+                    static_cast<size_t>(y1 - y0) * stride);
+    }
+    slot.rows = rows;
+    slot.ms = elapsedMs(t0);
+    slot.cpuMs = threadCpuMs() - cpu0;
+    return true;
+}
+
+bool FrameStripeExecutor::run(const FilterChainSnapshot& chain, const uint8_t* input, uint8_t* output,
+                              Common::TaskScheduler& scheduler, Common::TaskPriority priority,
+                              std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chain.width <= 0 || chain.height <= 0 || chain.bytesPerPixel <= 0) {
+        error = "Format de bande invalide";
+        return false;
+    }
+    if (chain.version != prunedVersion_) pruneClones(chain);
+
+    const size_t frameBytes = static_cast<size_t>(chain.width) * chain.bytesPerPixel * chain.height;
+    const int halo = chain.halo();
+    // En place avec halo : une bande lirait des lignes déjà écrites par sa voisine
+    if (halo > 0 && input < output + frameBytes && output < input + frameBytes) {
+        inputCopy_.assign(input, input + frameBytes);
+        input = inputCopy_.data();
+        ++stats_.inputCopies;
+    }
+
+    const int limit = maxStripes(chain);
+    const int stripes = chooseStripes(limit);
+    if (static_cast<int>(slots_.size()) < stripes) slots_.resize(stripes);
+
+    const auto t0 = Clock::now();
+    bool ok = true;
+    if (stripes == 1) {
+        ok = runStripe(chain, slots_[0], 0, chain.height, input, output);
+    } else {
+        // Bandes servies à la priorité de l'image; l'appelant en traite aussi
+        Common::TaskGroup group(priority);
+        const int base = chain.height / stripes;
+        const int remainder = chain.height % stripes;
+        int y = 0;
+        for (int i = 0; i < stripes; ++i) {
+            const int y0 = y;
+            const int y1 = y0 + base + (i < remainder ? 1 : 0);
+            y = y1;
+            Slot* slot = &slots_[i];
+            scheduler.submit(group, [this, &chain, slot, y0, y1, input, output] {
+                slot->ok = runStripe(chain, *slot, y0, y1, input, output);
+            });
+        }
+        scheduler.wait(group);
+        for (int i = 0; i < stripes; ++i) {
+            ok = slots_[i].ok && ok;
+        }
+    }
+    const double wallMs = elapsedMs(t0);
+    if (!ok) {
+        for (int i = 0; i < stripes; ++i) {
+            if (!slots_[i].error.empty()) {
+                error = slots_[i].error;
+                break;
+            }
+        }
+        return false;
+    }
+
+    record(stripes, wallMs, halo, chain.height);
+    ++stats_.frames;
+    stats_.lastStripes = stripes;
+    stats_.lastFrameMs = wallMs;
+    stats_.haloRows += extraRows(stripes, halo, chain.height);
+    stats_.clonesCreated = 0;
+    for (const auto& slot : slots_) stats_.clonesCreated += slot.clonesCreated;
+    return true;
+}
+
+} // namespace Camera
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../common/FilterTypes.hpp"
+#include "../../Common/TaskScheduler.hpp"
+#include "Lut3D.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Camera {
+
+// Étape de la chaîne figée pour le traitement par bandes
+struct StripeStage {
+    FilterState filter;
+    std::shared_ptr<IFilterProcessor> origin;           // processeur enregistré (identité des clones)
+    std::shared_ptr<const IFilterProcessor> seed;       // clone privé, source des clones par bande
+    int halo{0};                                        // lignes de contexte (filtre spatial)
+};
+
+// Chaîne de filtres immuable : les bandes la lisent sans le mutex du FilterManager
+struct FilterChainSnapshot {
+    std::vector<StripeStage> stages;
+    std::shared_ptr<const Lut3D> compiledLut;           // chaîne ponctuelle compilée (remplace les étapes)
+    std::string pixelFormat;                            // packé : bgra, rgba, rgb24...
+    int width{0};
+    int height{0};
+    int bytesPerPixel{0};
+    uint64_t version{0};
+
+    int halo() const;                                   // somme des halos des étapes
+};
+
+struct StripeExecutorStats {
+    uint64_t frames{0};
+    int lastStripes{0};
+    double lastFrameMs{0.0};
+    double workMs{0.0};             // temps CPU d'une image (somme des bandes, hors halo)
+    double dispatchMs{0.0};         // surcoût par bande (file, réveil, attente)
+    double parallelism{0.0};        // bandes réellement simultanées (CPU / temps écoulé)
+    uint64_t clonesCreated{0};
+    uint64_t haloRows{0};           // lignes traitées en plus pour les halos (cumul)
+    uint64_t inputCopies{0};        // entrée == sortie avec halo : entrée copiée
+    std::vector<double> measuredMs; // temps mesuré par nombre de bandes (index), 0 : non mesuré
+};
+
+/**
+ * Exécution d'une chaîne de filtres par bandes horizontales sur le TaskScheduler
+ *
+ * Chaque bande dispose de ses propres clones de processeurs (graphe FFmpeg, programme
+ * couleur, LUT...) : aucun état partagé entre workers. Une bande lit en plus les lignes de
+ * halo de ses voisines pour les filtres spatiaux, puis n'écrit que ses propres lignes.
+ * Le nombre de bandes est choisi d'après le coût mesuré : temps CPU par bande, surcoût de
+ * répartition et parallélisme effectif (cœurs réellement obtenus) alimentent un modèle,
+ * confirmé par le temps mesuré pour chaque choix.
+ * Formats packés uniquement (une bande = lignes contiguës).
+ */
+class FrameStripeExecutor {
+public:
+    explicit FrameStripeExecutor(size_t workers = 4);
+    ~FrameStripeExecutor();
+
+    // Threads disponibles : plafond du parallélisme dans le modèle de coût
+    void setWorkers(size_t workers);
+    // 0 : nombre de bandes adaptatif; sinon fixe (borné par la hauteur et les halos)
+    void setStripeCount(int stripes);
+
+    bool run(const FilterChainSnapshot& chain, const uint8_t* input, uint8_t* output,
+             Common::TaskScheduler& scheduler, Common::TaskPriority priority, std::string& error);
+
+    StripeExecutorStats getStats() const;
+    // Oublie clones et mesures
+    void reset();
+
+    static constexpr int kMaxStripes = 32;
+    static constexpr int kMinStripeRows = 16;
+
+private:
+    struct Clone {
+        std::shared_ptr<IFilterProcessor> origin;
+        std::shared_ptr<IFilterProcessor> processor;
+        int width{0};
+        int height{0};
+        std::string pixelFormat;
+    };
+    // Une bande par slot et par image : clones et buffers sans verrou
+    struct Slot {
+        std::unordered_map<const IFilterProcessor*, Clone> clones;
+        std::vector<uint8_t> scratch[2];
+        double ms{0.0};
+        double cpuMs{0.0};
+        int rows{0};
+        uint64_t clonesCreated{0};
+        bool ok{false};
+        std::string error;
+    };
+
+    bool runStripe(const FilterChainSnapshot& chain, Slot& slot, int y0, int y1,
+                   const uint8_t* input, uint8_t* output);
+    IFilterProcessor* cloneFor(Slot& slot, const StripeStage& stage, int width, int height,
+                               const std::string& pixelFormat);
+    int maxStripes(const FilterChainSnapshot& chain) const;
+    int chooseStripes(int maxStripes);
+    double predictMs(int stripes, int halo, int height) const;
+    void record(int stripes, double wallMs, int halo, int height);
+    void pruneClones(const FilterChainSnapshot& chain);
+
+    mutable std::mutex mutex_;      // une image à la fois (slots, mesures)
+    std::vector<Slot> slots_;
+    std::vector<uint8_t> inputCopy_;
+    size_t workers_;
+    int fixedStripes_{0};
+    uint64_t prunedVersion_{0};
+
+    // Modèle de coût
+    std::vector<double> measured_;
+    std::vector<int> samples_;
+    double workMs_{0.0};
+    double dispatchMs_{0.0};
+    double parallelism_{0.0};
+    int current_{0};
+    int lastHalo_{0};
+    int lastHeight_{0};
+    uint64_t sinceProbe_{0};
+    StripeExecutorStats stats_;
+};
+
+} // namespace Camera
@@ -0,0 +1,661 @@
+#include "Lut3D.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Camera {
+
+namespace {
+
+constexpr size_t kPage = 4096;
+constexpr uint32_t kVersion = 1;
+constexpr char kMagic[4] = {'N', 'L', 'U', 'T'};
+
+// En-tête du cache (cibles little-endian); noeuds à partir de dataOffset
+struct LutCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t size;
+    uint32_t brick;
+    float domainMin[3];
+    float domainMax[3];
+    uint64_t sourceSize;
+    int64_t sourceMtimeNs;
+    uint64_t dataOffset;
+    uint64_t dataBytes;
+};
+static_assert(sizeof(LutCacheHeader) <= kPage, "en-tête sur une page");
+
+// ===== Parse .cube =====
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+bool parseFloat(const char*& p, const char* end, float& out) {
+    while (p < end && isSpace(*p)) ++p;
+    if (p < end && *p == '+') ++p;
+    const auto r = std::from_chars(p, end, out);
+    if (r.ec != std::errc()) return false;
+    p = r.ptr;
+    return true;
+}
+#else
+// Bibliothèques sans from_chars flottant (libc++ iOS/NDK) : décimal simple + exposant
+bool parseFloat(const char*& p, const char* end, float& out) {
+    while (p < end && isSpace(*p)) ++p;
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) negative = (*s++ == '-');
+    double mantissa = 0.0;
+    int digits = 0;
+    int exponent = 0;
+    for (; s < end && *s >= '0' && *s <= '9'; ++s, ++digits) mantissa = mantissa * 10.0 + (*s - '0');
+    if (s < end && *s == '.') {
+        for (++s; s < end && *s >= '0' && *s <= '9'; ++s, ++digits, --exponent) mantissa = mantissa * 10.0 + (*s - '0');
+    }
+    if (digits == 0) return false;
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        const char* e = s + 1;
+        bool expNegative = false;
+        if (e < end && (*e == '-' || *e == '+')) expNegative = (*e++ == '-');
+        int value = 0;
+        const char* first = e;
+        for (; e < end && *e >= '0' && *e <= '9'; ++e) value = std::min(value * 10 + (*e - '0'), 1000);
+        if (e > first) {
+            exponent += expNegative ? -value : value;
+            s = e;
+        }
+    }
+    const double v = mantissa * std::pow(10.0, exponent);
+    out = static_cast<float>(negative ? -v : v);
+    p = s;
+    return true;
+}
+#endif
+
+bool parseInt(const char*& p, const char* end, int& out) {
+    while (p < end && isSpace(*p)) ++p;
+    const auto r = std::from_chars(p, end, out);
+    if (r.ec != std::errc()) return false;
+    p = r.ptr;
+    return true;
+}
+
+bool startsWith(const char* p, const char* end, const char* keyword) {
+    const size_t n = std::strlen(keyword);
+    return static_cast<size_t>(end - p) >= n && std::memcmp(p, keyword, n) == 0 &&
+           (static_cast<size_t>(end - p) == n || isSpace(p[n]));
+}
+
+uint16_t toUnorm16(float v) {
+    return static_cast<uint16_t>(std::lround(std::min(std::max(v, 0.0f), 1.0f) * 65535.0f));
+}
+
+int64_t mtimeNs(const struct stat& st) {
+#if defined(__APPLE__)
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+}
+
+std::string cacheFileFor(const std::string& cubePath, const std::string& cacheDir) {
+    uint64_t h = 1469598103934665603ULL;   // FNV-1a 64
+    for (unsigned char c : cubePath) { h ^= c; h *= 1099511628211ULL; }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.nlut", static_cast<unsigned long long>(h));
+    return cacheDir + "/" + name;
+}
+
+// ===== Interpolation : composantes R, G, B (+ bourrage) dans les lanes d'un vecteur =====
+
+struct ScalarOps {
+    struct V { float v[4]; };
+    static V load(const uint16_t* n) { return {{float(n[0]), float(n[1]), float(n[2]), 0.0f}}; }
+    static V set(float r, float g, float b) { return {{r, g, b, 0.0f}}; }
+    static V sub(V a, V b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], 0.0f}}; }
+    // acc + a * s
+    static V madd(V acc, V a, float s) {
+        return {{acc.v[0] + a.v[0] * s, acc.v[1] + a.v[1] * s, acc.v[2] + a.v[2] * s, 0.0f}};
+    }
+    static V scale(V a, float s) { return {{a.v[0] * s, a.v[1] * s, a.v[2] * s, 0.0f}}; }
+    static void store3(V a, float* out) { out[0] = a.v[0]; out[1] = a.v[1]; out[2] = a.v[2]; }
+    // Arrondi au plus proche puis saturation 0..255
+    static void bytes3(V a, uint8_t* out) {
+        for (int c = 0; c < 3; ++c) out[c] = static_cast<uint8_t>(std::min(static_cast<int>(a.v[c] + 0.5f), 255));
+    }
+};
+
+#if defined(__SSE2__)
+struct SimdOps {
+    struct V { __m128 v; };
+    static V load(const uint16_t* n) {
+        const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(n));
+        return {_mm_cvtepi32_ps(_mm_unpacklo_epi16(x, _mm_setzero_si128()))};
+    }
+    static V set(float r, float g, float b) { return {_mm_setr_ps(r, g, b, 0.0f)}; }
+    static V sub(V a, V b) { return {_mm_sub_ps(a.v, b.v)}; }
+    static V madd(V acc, V a, float s) { return {_mm_add_ps(acc.v, _mm_mul_ps(a.v, _mm_set1_ps(s)))}; }
+    static V scale(V a, float s) { return {_mm_mul_ps(a.v, _mm_set1_ps(s))}; }
+    static void store3(V a, float* out) {
+        alignas(16) float t[4];
+        _mm_store_ps(t, a.v);
+        out[0] = t[0]; out[1] = t[1]; out[2] = t[2];
+    }
+    static void bytes3(V a, uint8_t* out) {
+        const __m128i i = _mm_cvttps_epi32(_mm_add_ps(a.v, _mm_set1_ps(0.5f)));
+        const __m128i b = _mm_packus_epi16(_mm_packs_epi32(i, i), _mm_setzero_si128());
+        const uint32_t w = static_cast<uint32_t>(_mm_cvtsi128_si32(b));
+        out[0] = static_cast<uint8_t>(w); out[1] = static_cast<uint8_t>(w >> 8); out[2] = static_cast<uint8_t>(w >> 16);
+    }
+};
+#elif defined(__ARM_NEON)
+struct SimdOps {
+    struct V { float32x4_t v; };
+    static V load(const uint16_t* n) { return {vcvtq_f32_u32(vmovl_u16(vld1_u16(n)))}; }
+    static V set(float r, float g, float b) {
+        const float t[4] = {r, g, b, 0.0f};
+        return {vld1q_f32(t)};
+    }
+    static V sub(V a, V b) { return {vsubq_f32(a.v, b.v)}; }
+    static V madd(V acc, V a, float s) { return {vmlaq_n_f32(acc.v, a.v, s)}; }
+    static V scale(V a, float s) { return {vmulq_n_f32(a.v, s)}; }
+    static void store3(V a, float* out) {
+        float t[4];
+        vst1q_f32(t, a.v);
+        out[0] = t[0]; out[1] = t[1]; out[2] = t[2];
+    }
+    static void bytes3(V a, uint8_t* out) {
+        const uint32x4_t i = vcvtq_u32_f32(vaddq_f32(a.v, vdupq_n_f32(0.5f)));
+        const uint8x8_t b = vqmovn_u16(vcombine_u16(vqmovn_u32(i), vdup_n_u16(0)));
+        out[0] = vget_lane_u8(b, 0); out[1] = vget_lane_u8(b, 1); out[2] = vget_lane_u8(b, 2);
+    }
+};
+#else
+using SimdOps = ScalarOps;
+#endif
+
+// Sortie LUT (0..65535) pour une cellule; nodes pointe sur des noeuds de 4 uint16
+template <typename Ops, Lut3DInterpolation Interp, typename Axis>
+inline typename Ops::V interpolate(const uint16_t* nodes, const Axis& r, const Axis& g, const Axis& b) {
+    using V = typename Ops::V;
+    auto at = [nodes](uint32_t ri, uint32_t gi, uint32_t bi) { return Ops::load(nodes + 4 * size_t(ri + gi + bi)); };
+    if (Interp == Lut3DInterpolation::NEAREST) {
+        return at(r.frac < 0.5f ? r.lo : r.hi, g.frac < 0.5f ? g.lo : g.hi, b.frac < 0.5f ? b.lo : b.hi);
+    }
+    const V c000 = at(r.lo, g.lo, b.lo);
+    const V c111 = at(r.hi, g.hi, b.hi);
+    if (Interp == Lut3DInterpolation::TRILINEAR) {
+        const V c100 = at(r.hi, g.lo, b.lo), c010 = at(r.lo, g.hi, b.lo), c110 = at(r.hi, g.hi, b.lo);
+        const V c001 = at(r.lo, g.lo, b.hi), c101 = at(r.hi, g.lo, b.hi), c011 = at(r.lo, g.hi, b.hi);
+        const V c00 = Ops::madd(c000, Ops::sub(c100, c000), r.frac);
+        const V c10 = Ops::madd(c010, Ops::sub(c110, c010), r.frac);
+        const V c01 = Ops::madd(c001, Ops::sub(c101, c001), r.frac);
+        const V c11 = Ops::madd(c011, Ops::sub(c111, c011), r.frac);
+        const V c0 = Ops::madd(c00, Ops::sub(c10, c00), g.frac);
+        const V c1 = Ops::madd(c01, Ops::sub(c11, c01), g.frac);
+        return Ops::madd(c0, Ops::sub(c1, c0), b.frac);
+    }
+    // Tétraèdre de la cellule contenant le point : fractions triées a >= m >= c,
+    // out = c000 + a (n1 - c000) + m (n2 - n1) + c (c111 - n2)
+    const float fr = r.frac, fg = g.frac, fb = b.frac;
+    V n1, n2;
+    float a, m, c;
+    if (fr > fg) {
+        if (fg > fb)      { n1 = at(r.hi, g.lo, b.lo); n2 = at(r.hi, g.hi, b.lo); a = fr; m = fg; c = fb; }
+        else if (fr > fb) { n1 = at(r.hi, g.lo, b.lo); n2 = at(r.hi, g.lo, b.hi); a = fr; m = fb; c = fg; }
+        else              { n1 = at(r.lo, g.lo, b.hi); n2 = at(r.hi, g.lo, b.hi); a = fb; m = fr; c = fg; }
+    } else {
+        if (fb > fg)      { n1 = at(r.lo, g.lo, b.hi); n2 = at(r.lo, g.hi, b.hi); a = fb; m = fg; c = fr; }
+        else if (fb > fr) { n1 = at(r.lo, g.hi, b.lo); n2 = at(r.lo, g.hi, b.hi); a = fg; m = fb; c = fr; }
+        else              { n1 = at(r.lo, g.hi, b.lo); n2 = at(r.hi, g.hi, b.lo); a = fg; m = fr; c = fb; }
+    }
+    V out = Ops::madd(c000, Ops::sub(n1, c000), a);
+    out = Ops::madd(out, Ops::sub(n2, n1), m);
+    return Ops::madd(out, Ops::sub(c111, n2), c);
+}
+
+// Mélange entrée (0..255) / LUT (0..65535) : in (1 - k) + lut k / 257
+template <typename Ops>
+inline typename Ops::V blend(typename Ops::V in, typename Ops::V lut, float k) {
+    return Ops::madd(Ops::scale(in, 1.0f - k), lut, k / 257.0f);
+}
+
+template <typename Ops, Lut3DInterpolation Interp, typename AxisTables>
+void packedRows(const uint16_t* nodes, const AxisTables& axis, const uint8_t* input, int inputStride,
+                int width, int height, bool bgra, uint8_t* output, int outputStride, float k) {
+    const int ri = bgra ? 2 : 0;
+    const int bi = bgra ? 0 : 2;
+    const bool full = k >= 1.0f;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = input + static_cast<size_t>(y) * inputStride;
+        uint8_t* out = output + static_cast<size_t>(y) * outputStride;
+        for (int x = 0; x < width; ++x, in += 4, out += 4) {
+            const uint8_t r = in[ri], g = in[1], b = in[bi], a = in[3];
+            const auto lut = interpolate<Ops, Interp>(nodes, axis[0][r], axis[1][g], axis[2][b]);
+            uint8_t rgb[3];
+            // Intensité pleine (chaînes compilées) : pas de mélange avec l'entrée
+            Ops::bytes3(full ? Ops::scale(lut, 1.0f / 257.0f) : blend<Ops>(Ops::set(r, g, b), lut, k), rgb);
+            out[ri] = rgb[0]; out[1] = rgb[1]; out[bi] = rgb[2]; out[3] = a;
+        }
+    }
+}
+
+struct YuvCoeffs {
+    float kr, kg, kb;
+    float yScale, yOffset, cScale;
+};
+
+YuvCoeffs yuvCoeffs(const Nv12Format& f) {
+    YuvCoeffs c{};
+    c.kr = f.bt709 ? 0.2126f : 0.299f;
+    c.kb = f.bt709 ? 0.0722f : 0.114f;
+    c.kg = 1.0f - c.kr - c.kb;
+    c.yScale = f.fullRange ? 1.0f : 219.0f / 255.0f;
+    c.yOffset = f.fullRange ? 0.0f : 16.0f;
+    c.cScale = f.fullRange ? 1.0f : 224.0f / 255.0f;
+    return c;
+}
+
+uint8_t clampByte(float v) {
+    return static_cast<uint8_t>(std::min(std::max(static_cast<int>(v + 0.5f), 0), 255));
+}
+
+template <typename Ops, Lut3DInterpolation Interp, typename AxisTables>
+void nv12Blocks(const uint16_t* nodes, const AxisTables& axis, const uint8_t* inY, int inYStride,
+                const uint8_t* inUV, int inUVStride, int width, int height, uint8_t* outY, int outYStride,
+                uint8_t* outUV, int outUVStride, const YuvCoeffs& yc, float k) {
+    for (int by = 0; by < height; by += 2) {
+        const uint8_t* uvIn = inUV + static_cast<size_t>(by / 2) * inUVStride;
+        uint8_t* uvOut = outUV + static_cast<size_t>(by / 2) * outUVStride;
+        for (int bx = 0; bx < width; bx += 2) {
+            const float cb = (uvIn[bx] - 128.0f) / yc.cScale;
+            const float cr = (uvIn[bx + 1] - 128.0f) / yc.cScale;
+            float sumCb = 0.0f, sumCr = 0.0f;
+            int count = 0;
+            for (int dy = 0; dy < 2 && by + dy < height; ++dy) {
+                const uint8_t* yIn = inY + static_cast<size_t>(by + dy) * inYStride;
+                uint8_t* yOut = outY + static_cast<size_t>(by + dy) * outYStride;
+                for (int dx = 0; dx < 2 && bx + dx < width; ++dx) {
+                    const float luma = (yIn[bx + dx] - yc.yOffset) / yc.yScale;
+                    const uint8_t r = clampByte(luma + 2.0f * (1.0f - yc.kr) * cr);
+                    const uint8_t b = clampByte(luma + 2.0f * (1.0f - yc.kb) * cb);
+                    const uint8_t g = clampByte((luma - yc.kr * r - yc.kb * b) / yc.kg);
+                    const auto lut = interpolate<Ops, Interp>(nodes, axis[0][r], axis[1][g], axis[2][b]);
+                    float rgb[3];
+                    Ops::store3(blend<Ops>(Ops::set(r, g, b), lut, k), rgb);
+                    const float y2 = yc.kr * rgb[0] + yc.kg * rgb[1] + yc.kb * rgb[2];
+                    yOut[bx + dx] = clampByte(y2 * yc.yScale + yc.yOffset);
+                    sumCb += (rgb[2] - y2) / (2.0f * (1.0f - yc.kb));
+                    sumCr += (rgb[0] - y2) / (2.0f * (1.0f - yc.kr));
+                    ++count;
+                }
+            }
+            uvOut[bx] = clampByte(sumCb / count * yc.cScale + 128.0f);
+            uvOut[bx + 1] = clampByte(sumCr / count * yc.cScale + 128.0f);
+        }
+    }
+}
+
+// Mode d'interpolation résolu hors des boucles : un noyau instancié par mode
+template <typename Kernel>
+void dispatch(Lut3DInterpolation interp, Kernel&& kernel) {
+    switch (interp) {
+        case Lut3DInterpolation::NEAREST:
+            kernel(std::integral_constant<Lut3DInterpolation, Lut3DInterpolation::NEAREST>());
+            break;
+        case Lut3DInterpolation::TRILINEAR:
+            kernel(std::integral_constant<Lut3DInterpolation, Lut3DInterpolation::TRILINEAR>());
+            break;
+        default:
+            kernel(std::integral_constant<Lut3DInterpolation, Lut3DInterpolation::TETRAHEDRAL>());
+            break;
+    }
+}
+
+} // namespace
+
+// ===== Projection du cache =====
+
+struct Lut3D::Mapping {
+    void* base = nullptr;
+    size_t size = 0;
+    ~Mapping() {
+        if (base) ::munmap(base, size);
+    }
+};
+
+Lut3D::Lut3D(int size, const std::array<float, 3>& domainMin, const std::array<float, 3>& domainMax)
+    : size_(size), domainMin_(domainMin), domainMax_(domainMax) {
+    // Briques de kBrick noeuds par axe : offset(i) = brique(i) * pas + position dans la brique
+    const size_t bricks = paddedSize(size) / kBrick;
+    const size_t brickNodes = kBrick * kBrick * kBrick;
+    const size_t stride[3] = {brickNodes, brickNodes * bricks, brickNodes * bricks * bricks};
+    const size_t inner[3] = {1, kBrick, kBrick * kBrick};
+    for (int c = 0; c < 3; ++c) {
+        axisOffset_[c].resize(static_cast<size_t>(size));
+        for (int i = 0; i < size; ++i) {
+            axisOffset_[c][i] = static_cast<uint32_t>((i / kBrick) * stride[c] + (i % kBrick) * inner[c]);
+        }
+    }
+    buildAxisTables();
+}
+
+Lut3D::~Lut3D() = default;
+
+size_t Lut3D::paddedSize(int size) {
+    return (static_cast<size_t>(size) + kBrick - 1) / kBrick * kBrick;
+}
+
+size_t Lut3D::nodeCount() const {
+    const size_t p = paddedSize(size_);
+    return p * p * p;
+}
+
+size_t Lut3D::nodeIndex(int r, int g, int b) const {
+    return axisOffset_[0][r] + axisOffset_[1][g] + axisOffset_[2][b];
+}
+
+const uint16_t* Lut3D::node(int r, int g, int b) const {
+    return nodes_ + 4 * nodeIndex(r, g, b);
+}
+
+void Lut3D::buildAxisTables() {
+    for (int c = 0; c < 3; ++c) {
+        const float span = domainMax_[c] - domainMin_[c];
+        for (int v = 0; v < 256; ++v) {
+            float x = span > 0.0f ? (v / 255.0f - domainMin_[c]) / span : 0.0f;
+            x = std::min(std::max(x, 0.0f), 1.0f) * static_cast<float>(size_ - 1);
+            const int i = std::min(static_cast<int>(x), size_ - 2);
+            axis_[c][v] = {axisOffset_[c][i], axisOffset_[c][i + 1], x - static_cast<float>(i)};
+        }
+    }
+}
+
+std::shared_ptr<const Lut3D> Lut3D::parseCube(const char* text, size_t length, std::string& error) {
+    const char* p = text;
+    const char* end = text + length;
+    int size = 0;
+    std::array<float, 3> dmin{{0.0f, 0.0f, 0.0f}};
+    std::array<float, 3> dmax{{1.0f, 1.0f, 1.0f}};
+    std::vector<float> values;
+    int lineNo = 0;
+
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* lineEnd = eol ? eol : end;
+        ++lineNo;
+        const char* s = p;
+        p = eol ? eol + 1 : end;
+        while (s < lineEnd && isSpace(*s)) ++s;
+        if (s == lineEnd || *s == '#') continue;
+
+        if ((*s >= '0' && *s <= '9') || *s == '-' || *s == '+' || *s == '.') {
+            float rgb[3];
+            for (float& v : rgb) {
+                if (!parseFloat(s, lineEnd, v)) {
+                    error = "LUT: valeur invalide ligne " + std::to_string(lineNo);
+                    return nullptr;
+                }
+            }
+            values.insert(values.end(), rgb, rgb + 3);
+            continue;
+        }
+        if (startsWith(s, lineEnd, "LUT_3D_SIZE")) {
+            s += 11;
+            if (!parseInt(s, lineEnd, size) || size < kMinSize || size > kMaxSize) {
+                error = "LUT: LUT_3D_SIZE invalide ligne " + std::to_string(lineNo);
+                return nullptr;
+            }
+            values.reserve(static_cast<size_t>(size) * size * size * 3);
+        } else if (startsWith(s, lineEnd, "DOMAIN_MIN") || startsWith(s, lineEnd, "DOMAIN_MAX")) {
+            auto& d = s[8] == 'I' ? dmin : dmax;
+            s += 10;
+            for (float& v : d) {
+                if (!parseFloat(s, lineEnd, v)) {
+                    error = "LUT: domaine invalide ligne " + std::to_string(lineNo);
+                    return nullptr;
+                }
+            }
+        } else if (startsWith(s, lineEnd, "LUT_3D_INPUT_RANGE")) {
+            s += 18;
+            float lo = 0.0f, hi = 1.0f;
+            if (!parseFloat(s, lineEnd, lo) || !parseFloat(s, lineEnd, hi)) {
+                error = "LUT: LUT_3D_INPUT_RANGE invalide ligne " + std::to_string(lineNo);
+                return nullptr;
+            }
+            dmin = {{lo, lo, lo}};
+            dmax = {{hi, hi, hi}};
+        } else if (startsWith(s, lineEnd, "LUT_1D_SIZE")) {
+            error = "LUT: LUT 1D non supportée";
+            return nullptr;
+        }
+        // TITLE et mots-clés inconnus ignorés
+    }
+
+    if (size == 0) { error = "LUT: LUT_3D_SIZE manquant"; return nullptr; }
+    const size_t expected = static_cast<size_t>(size) * size * size;
+    const size_t count = values.size() / 3;
+    if (count == 0) { error = "LUT: aucune donnée"; return nullptr; }
+    if (count > expected) { error = "LUT: trop de valeurs"; return nullptr; }
+    if (count < expected) {
+        error = "LUT: fichier tronqué (" + std::to_string(count) + "/" + std::to_string(expected) + " noeuds)";
+        return nullptr;
+    }
+
+    std::shared_ptr<Lut3D> lut(new Lut3D(size, dmin, dmax));
+    lut->owned_.assign(lut->nodeCount() * 4, 0);
+    lut->nodes_ = lut->owned_.data();
+    // Ordre .cube : R le plus rapide, puis G, puis B
+    size_t i = 0;
+    for (int b = 0; b < size; ++b) {
+        for (int g = 0; g < size; ++g) {
+            for (int r = 0; r < size; ++r, ++i) {
+                uint16_t* n = lut->owned_.data() + 4 * lut->nodeIndex(r, g, b);
+                for (int c = 0; c < 3; ++c) n[c] = toUnorm16(values[i * 3 + c]);
+            }
+        }
+    }
+    return lut;
+}
+
+std::shared_ptr<const Lut3D> Lut3D::loadCube(const std::string& path, std::string& error) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { error = "LUT introuvable: " + path; return nullptr; }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); error = "LUT vide: " + path; return nullptr; }
+    std::string text(static_cast<size_t>(st.st_size), '\0');
+    size_t done = 0;
+    while (done < text.size()) {
+        const ssize_t n = ::read(fd, &text[done], text.size() - done);
+        if (n <= 0) break;
+        done += static_cast<size_t>(n);
+    }
+    ::close(fd);
+    auto lut = parseCube(text.data(), done, error);
+    if (!lut) error += ": " + path;
+    return lut;
+}
+
+std::shared_ptr<const Lut3D> Lut3D::load(const std::string& path, const std::string& cacheDir, std::string& error) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) { error = "LUT introuvable: " + path; return nullptr; }
+    const uint64_t sourceSize = static_cast<uint64_t>(st.st_size);
+    const int64_t sourceMtime = mtimeNs(st);
+
+    std::string dir = cacheDir;
+    if (dir.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        if (tmp && *tmp) dir = tmp;
+    }
+    const std::string cachePath = dir.empty() ? std::string() : cacheFileFor(path, dir);
+
+    if (!cachePath.empty()) {
+        std::string ignored;
+        if (auto mapped = mapCache(cachePath, sourceSize, sourceMtime, ignored)) return mapped;
+    }
+    auto lut = loadCube(path, error);
+    if (lut && !cachePath.empty()) {
+        std::string cacheError;
+        if (!lut->writeCache(cachePath, sourceSize, sourceMtime, cacheError)) {
+            std::cout << "[Lut3D] " << cacheError << std::endl;
+        }
+    }
+    return lut;
+}
+
+std::shared_ptr<const Lut3D> Lut3D::fromFunction(int size, const std::function<void(float, float, float, float*)>& fn) {
+    size = std::min(std::max(size, kMinSize), kMaxSize);
+    std::shared_ptr<Lut3D> lut(new Lut3D(size, {{0.0f, 0.0f, 0.0f}}, {{1.0f, 1.0f, 1.0f}}));
+    lut->owned_.assign(lut->nodeCount() * 4, 0);
+    lut->nodes_ = lut->owned_.data();
+    const float step = 1.0f / static_cast<float>(size - 1);
+    for (int b = 0; b < size; ++b) {
+        for (int g = 0; g < size; ++g) {
+            for (int r = 0; r < size; ++r) {
+                float out[3] = {0.0f, 0.0f, 0.0f};
+                fn(r * step, g * step, b * step, out);
+                uint16_t* n = lut->owned_.data() + 4 * lut->nodeIndex(r, g, b);
+                for (int c = 0; c < 3; ++c) n[c] = toUnorm16(out[c]);
+            }
+        }
+    }
+    return lut;
+}
+
+bool Lut3D::writeCache(const std::string& path, uint64_t sourceSize, int64_t sourceMtimeNs, std::string& error) const {
+    LutCacheHeader h{};
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.size = static_cast<uint32_t>(size_);
+    h.brick = kBrick;
+    for (int c = 0; c < 3; ++c) { h.domainMin[c] = domainMin_[c]; h.domainMax[c] = domainMax_[c]; }
+    h.sourceSize = sourceSize;
+    h.sourceMtimeNs = sourceMtimeNs;
+    h.dataOffset = kPage;
+    h.dataBytes = nodeCount() * 4 * sizeof(uint16_t);
+
+    // Écriture dans un temporaire puis rename : un lecteur ne voit jamais un cache partiel
+    const std::string tmp = path + ".tmp";
+    const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) { error = "Cache LUT impossible à créer: " + path; return false; }
+    std::vector<uint8_t> page(kPage, 0);
+    std::memcpy(page.data(), &h, sizeof(h));
+    auto writeAll = [fd](const void* data, size_t bytes) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        while (bytes > 0) {
+            const ssize_t n = ::write(fd, p, bytes);
+            if (n <= 0) return false;
+            p += n;
+            bytes -= static_cast<size_t>(n);
+        }
+        return true;
+    };
+    const bool ok = writeAll(page.data(), page.size()) && writeAll(nodes_, h.dataBytes);
+    ::close(fd);
+    if (!ok || ::rename(tmp.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        error = "Cache LUT: écriture impossible";
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const Lut3D> Lut3D::mapCache(const std::string& path, uint64_t sourceSize, int64_t sourceMtimeNs,
+                                             std::string& error) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { error = "Cache LUT absent"; return nullptr; }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kPage) { ::close(fd); error = "Cache LUT invalide"; return nullptr; }
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void* base = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) { error = "Cache LUT: mmap impossible"; return nullptr; }
+    auto mapping = std::make_unique<Mapping>();
+    mapping->base = base;
+    mapping->size = fileSize;
+
+    LutCacheHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, 4) != 0 || h.version != kVersion || h.brick != kBrick ||
+        h.size < kMinSize || h.size > kMaxSize || h.sourceSize != sourceSize || h.sourceMtimeNs != sourceMtimeNs) {
+        error = "Cache LUT périmé";
+        return nullptr;
+    }
+    std::array<float, 3> dmin, dmax;
+    for (int c = 0; c < 3; ++c) { dmin[c] = h.domainMin[c]; dmax[c] = h.domainMax[c]; }
+    std::shared_ptr<Lut3D> lut(new Lut3D(static_cast<int>(h.size), dmin, dmax));
+    if (h.dataOffset != kPage || h.dataBytes != lut->nodeCount() * 4 * sizeof(uint16_t) ||
+        h.dataOffset + h.dataBytes > fileSize) {
+        error = "Cache LUT tronqué";
+        return nullptr;
+    }
+    lut->nodes_ = reinterpret_cast<const uint16_t*>(static_cast<const uint8_t*>(base) + h.dataOffset);
+    lut->mapping_ = std::move(mapping);
+    return lut;
+}
+
+void Lut3D::sample(const float* rgb, float* out, Lut3DInterpolation interp) const {
+    AxisEntry a[3];
+    for (int c = 0; c < 3; ++c) {
+        const float span = domainMax_[c] - domainMin_[c];
+        float x = span > 0.0f ? (rgb[c] - domainMin_[c]) / span : 0.0f;
+        x = std::min(std::max(x, 0.0f), 1.0f) * static_cast<float>(size_ - 1);
+        const int i = std::min(static_cast<int>(x), size_ - 2);
+        a[c] = {axisOffset_[c][i], axisOffset_[c][i + 1], x - static_cast<float>(i)};
+    }
+    dispatch(interp, [&](auto mode) {
+        ScalarOps::store3(interpolate<ScalarOps, decltype(mode)::value>(nodes_, a[0], a[1], a[2]), out);
+    });
+    for (int c = 0; c < 3; ++c) out[c] /= 65535.0f;
+}
+
+void Lut3D::applyPacked(const uint8_t* input, int inputStride, int width, int height, bool bgra,
+                        uint8_t* output, int outputStride, Lut3DInterpolation interp, float intensity,
+                        bool allowSimd) const {
+    const float k = std::min(std::max(intensity, 0.0f), 1.0f);
+    auto run = [&](auto ops) {
+        using Ops = decltype(ops);
+        dispatch(interp, [&](auto mode) {
+            packedRows<Ops, decltype(mode)::value>(nodes_, axis_, input, inputStride, width, height, bgra,
+                                                   output, outputStride, k);
+        });
+    };
+    if (allowSimd) run(SimdOps());
+    else run(ScalarOps());
+}
+
+void Lut3D::applyNV12(const uint8_t* inputY, int inputYStride, const uint8_t* inputUV, int inputUVStride,
+                      int width, int height, uint8_t* outputY, int outputYStride,
+                      uint8_t* outputUV, int outputUVStride, const Nv12Format& format,
+                      Lut3DInterpolation interp, float intensity, bool allowSimd) const {
+    const float k = std::min(std::max(intensity, 0.0f), 1.0f);
+    const YuvCoeffs yc = yuvCoeffs(format);
+    auto run = [&](auto ops) {
+        using Ops = decltype(ops);
+        dispatch(interp, [&](auto mode) {
+            nv12Blocks<Ops, decltype(mode)::value>(nodes_, axis_, inputY, inputYStride, inputUV, inputUVStride,
+                                                   width, height, outputY, outputYStride, outputUV,
+                                                   outputUVStride, yc, k);
+        });
+    };
+    if (allowSimd) run(SimdOps());
+    else run(ScalarOps());
+}
+
+} // namespace Camera
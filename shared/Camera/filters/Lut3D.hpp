@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+enum class Lut3DInterpolation {
+    NEAREST,
+    TRILINEAR,
+    TETRAHEDRAL
+};
+
+// Matrice/plage YUV des buffers NV12 (capture iOS : '420v' BT.709 plage vidéo)
+struct Nv12Format {
+    bool bt709{true};
+    bool fullRange{false};
+};
+
+/**
+ * LUT 3D immuable (RGB -> RGB), partagée entre threads
+ *
+ * Noeuds RGB 16 bits (+ 16 bits de bourrage, 8 octets par noeud) rangés en briques
+ * 4×4×4 : les 8 sommets d'une cellule tombent presque toujours dans une même brique.
+ * L'adresse d'un noeud reste séparable (offset R + offset G + offset B), avec une
+ * table par axe et par valeur 8 bits qui intègre aussi DOMAIN_MIN/MAX.
+ *
+ * Le cache binaire (.nlut) reprend exactement cette disposition après un en-tête
+ * d'une page : il est projeté en mémoire tel quel (mmap, lecture seule).
+ */
+class Lut3D {
+public:
+    static constexpr int kMinSize = 2;
+    static constexpr int kMaxSize = 256;
+    static constexpr int kBrick = 4;
+
+    ~Lut3D();
+    Lut3D(const Lut3D&) = delete;
+    Lut3D& operator=(const Lut3D&) = delete;
+
+    // Parse un .cube (TITLE, LUT_3D_SIZE, DOMAIN_MIN/MAX, commentaires '#')
+    static std::shared_ptr<const Lut3D> parseCube(const char* text, size_t length, std::string& error);
+    static std::shared_ptr<const Lut3D> loadCube(const std::string& path, std::string& error);
+
+    // .cube via le cache : projection du .nlut si la source est inchangée (taille, date),
+    // sinon parse puis écriture du cache. cacheDir vide : $TMPDIR, sinon pas de cache disque.
+    static std::shared_ptr<const Lut3D> load(const std::string& path, const std::string& cacheDir,
+                                             std::string& error);
+
+    // Échantillonne fn(r, g, b, out) sur la grille (coordonnées et sorties 0..1)
+    static std::shared_ptr<const Lut3D> fromFunction(
+        int size, const std::function<void(float, float, float, float*)>& fn);
+
+    bool writeCache(const std::string& path, uint64_t sourceSize, int64_t sourceMtimeNs,
+                    std::string& error) const;
+    static std::shared_ptr<const Lut3D> mapCache(const std::string& path, uint64_t sourceSize,
+                                                 int64_t sourceMtimeNs, std::string& error);
+
+    int size() const { return size_; }
+    bool isMapped() const { return mapping_ != nullptr; }
+
+    // Noeud (r, g, b) : 3 composantes 0..65535
+    const uint16_t* node(int r, int g, int b) const;
+
+    // Couleur 0..1 (bornée au domaine) -> sortie LUT 0..1
+    void sample(const float* rgb, float* out, Lut3DInterpolation interp) const;
+
+    // BGRA/RGBA 8 bits avec stride, alpha conservé, in-place autorisé.
+    // intensity mélange entrée et sortie LUT dans la même passe (0 : copie).
+    void applyPacked(const uint8_t* input, int inputStride, int width, int height, bool bgra,
+                     uint8_t* output, int outputStride, Lut3DInterpolation interp, float intensity,
+                     bool allowSimd = true) const;
+
+    // NV12 (Y + UV entrelacés, 4:2:0) : conversion RGB par pixel, chroma de sortie
+    // moyennée sur chaque bloc 2×2. In-place autorisé.
+    void applyNV12(const uint8_t* inputY, int inputYStride, const uint8_t* inputUV, int inputUVStride,
+                   int width, int height, uint8_t* outputY, int outputYStride,
+                   uint8_t* outputUV, int outputUVStride, const Nv12Format& format,
+                   Lut3DInterpolation interp, float intensity, bool allowSimd = true) const;
+
+private:
+    struct Mapping;
+    struct AxisEntry {
+        uint32_t lo;    // offset (en noeuds) du noeud inférieur
+        uint32_t hi;    // offset du noeud supérieur
+        float frac;     // position dans la cellule (0..1)
+    };
+
+    Lut3D(int size, const std::array<float, 3>& domainMin, const std::array<float, 3>& domainMax);
+
+    static size_t paddedSize(int size);
+    size_t nodeCount() const;
+    size_t nodeIndex(int r, int g, int b) const;
+    void buildAxisTables();
+
+    int size_{0};
+    std::array<float, 3> domainMin_{{0.0f, 0.0f, 0.0f}};
+    std::array<float, 3> domainMax_{{1.0f, 1.0f, 1.0f}};
+    std::vector<uint16_t> owned_;
+    std::unique_ptr<Mapping> mapping_;
+    const uint16_t* nodes_{nullptr};
+    std::array<std::vector<uint32_t>, 3> axisOffset_;
+    std::array<std::array<AxisEntry, 256>, 3> axis_{};
+};
+
+} // namespace Camera
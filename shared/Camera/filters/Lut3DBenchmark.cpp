@@ -0,0 +1,263 @@
+#include "Lut3DBenchmark.hpp"
+#include "Lut3D.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Camera {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+template <typename Fn>
+double measureMPixPerSec(int width, int height, int frames, Fn&& fn) {
+    fn();   // préchauffage
+    const auto t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) fn();
+    const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    return seconds > 0.0 ? static_cast<double>(width) * height * frames / seconds / 1e6 : 0.0;
+}
+
+// Courbes non linéaires et mélange des canaux : toutes les branches du tétraèdre servent
+void gradeFunction(float r, float g, float b, float* out) {
+    out[0] = std::pow(0.8f * r + 0.2f * g, 0.8f);
+    out[1] = g * g * (3.0f - 2.0f * g);
+    out[2] = std::min(1.0f, 0.9f * b + 0.15f * r);
+}
+
+std::string writeSyntheticCube(const std::string& dir, int size) {
+    const std::string path = dir + "/naaya_bench_" + std::to_string(size) + ".cube";
+    std::ofstream f(path);
+    if (!f) return {};
+    f << "TITLE \"Naaya benchmark\"\nLUT_3D_SIZE " << size << "\n";
+    f << std::fixed << std::setprecision(6);
+    const float step = 1.0f / static_cast<float>(size - 1);
+    for (int b = 0; b < size; ++b) {
+        for (int g = 0; g < size; ++g) {
+            for (int r = 0; r < size; ++r) {
+                float out[3];
+                gradeFunction(r * step, g * step, b * step, out);
+                f << out[0] << ' ' << out[1] << ' ' << out[2] << '\n';
+            }
+        }
+    }
+    return f ? path : std::string();
+}
+
+Lut3DLoadResult measureLoad(const std::string& label, const std::string& path, const std::string& cacheDir) {
+    Lut3DLoadResult r;
+    r.source = label;
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return r;
+
+    std::string error;
+    auto t0 = Clock::now();
+    const auto parsed = Lut3D::loadCube(path, error);
+    r.parseMs = elapsedMs(t0);
+    if (!parsed) {
+        std::cout << "[Lut3DBenchmark] " << error << std::endl;
+        return r;
+    }
+    r.size = parsed->size();
+
+    // Horodatage fictif : le cache du benchmark ne doit pas être repris par Lut3D::load
+    const std::string cachePath = cacheDir + "/naaya_bench_" + std::to_string(r.size) + ".nlut";
+    const uint64_t sourceSize = static_cast<uint64_t>(st.st_size);
+    t0 = Clock::now();
+    const bool written = parsed->writeCache(cachePath, sourceSize, -1, error);
+    r.cacheWriteMs = elapsedMs(t0);
+    if (!written) {
+        std::cout << "[Lut3DBenchmark] " << error << std::endl;
+        return r;
+    }
+
+    t0 = Clock::now();
+    const auto mapped = Lut3D::mapCache(cachePath, sourceSize, -1, error);
+    r.cacheMapMs = elapsedMs(t0);
+    // Le cache doit restituer exactement les noeuds parsés
+    r.ok = mapped && mapped->size() == r.size;
+    for (int b = 0; r.ok && b < r.size; ++b) {
+        for (int g = 0; r.ok && g < r.size; ++g) {
+            for (int i = 0; r.ok && i < r.size; ++i) {
+                r.ok = std::memcmp(mapped->node(i, g, b), parsed->node(i, g, b), 3 * sizeof(uint16_t)) == 0;
+            }
+        }
+    }
+    ::unlink(cachePath.c_str());
+    return r;
+}
+
+// BGRA lisse sur tout le cube RGB
+std::vector<uint8_t> makeImage(int width, int height) {
+    std::vector<uint8_t> img(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = img.data() + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            const double u = static_cast<double>(x) / width;
+            const double v = static_cast<double>(y) / height;
+            row[x * 4 + 0] = static_cast<uint8_t>(255.0 * u);
+            row[x * 4 + 1] = static_cast<uint8_t>(255.0 * v);
+            row[x * 4 + 2] = static_cast<uint8_t>(127.5 + 127.0 * std::sin(9.0 * u) * std::cos(7.0 * v));
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return img;
+}
+
+// NV12 BT.709 plage vidéo obtenu depuis l'image BGRA (chroma dans le gamut)
+void makeNV12(const std::vector<uint8_t>& bgra, int width, int height,
+              std::vector<uint8_t>& y, std::vector<uint8_t>& uv) {
+    y.assign(static_cast<size_t>(width) * height, 0);
+    uv.assign(static_cast<size_t>(width) * ((height + 1) / 2), 128);
+    auto clampByte = [](double v) { return static_cast<uint8_t>(std::min(255.0, std::max(0.0, std::round(v)))); };
+    for (int by = 0; by < height; by += 2) {
+        for (int bx = 0; bx + 1 < width; bx += 2) {
+            const uint8_t* p = bgra.data() + (static_cast<size_t>(by) * width + bx) * 4;
+            const double luma = 0.2126 * p[2] + 0.7152 * p[1] + 0.0722 * p[0];
+            for (int d = 0; d < 4 && by + d / 2 < height; ++d) {
+                y[static_cast<size_t>(by + d / 2) * width + bx + d % 2] = clampByte(luma * 219.0 / 255.0 + 16.0);
+            }
+            uint8_t* c = uv.data() + static_cast<size_t>(by / 2) * width + bx;
+            c[0] = clampByte((p[0] - luma) / 1.8556 * 224.0 / 255.0 + 128.0);
+            c[1] = clampByte((p[2] - luma) / 1.5748 * 224.0 / 255.0 + 128.0);
+        }
+    }
+}
+
+int maxDiff(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    int d = 0;
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) d = std::max(d, std::abs(int(a[i]) - int(b[i])));
+    return d;
+}
+
+const char* interpName(Lut3DInterpolation interp) {
+    switch (interp) {
+        case Lut3DInterpolation::NEAREST: return "nearest";
+        case Lut3DInterpolation::TRILINEAR: return "trilinear";
+        default: return "tetrahedral";
+    }
+}
+
+} // namespace
+
+Lut3DBenchmarkResults runLut3DBenchmark(const Lut3DBenchmarkConfig& config) {
+    Lut3DBenchmarkResults results;
+    std::string dir = config.cacheDir;
+    if (dir.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        dir = tmp && *tmp ? tmp : "/tmp";
+    }
+
+    if (!config.cubePath.empty()) {
+        results.loads.push_back(measureLoad(config.cubePath, config.cubePath, dir));
+    }
+    const int synthetic = std::min(std::max(config.syntheticSize, Lut3D::kMinSize), Lut3D::kMaxSize);
+    const std::string syntheticPath = writeSyntheticCube(dir, synthetic);
+    if (!syntheticPath.empty()) {
+        results.loads.push_back(measureLoad("synthétique " + std::to_string(synthetic) + "³", syntheticPath, dir));
+        ::unlink(syntheticPath.c_str());
+    }
+
+    const int width = std::max(2, config.width);
+    const int height = std::max(2, config.height);
+    const int frames = std::max(1, config.frames);
+    const int stride = width * 4;
+    const std::vector<uint8_t> input = makeImage(width, height);
+    const auto identity = Lut3D::fromFunction(33, [](float r, float g, float b, float* out) {
+        out[0] = r; out[1] = g; out[2] = b;
+    });
+    const auto grade = Lut3D::fromFunction(33, gradeFunction);
+
+    std::vector<uint8_t> outSimd(input.size());
+    std::vector<uint8_t> outScalar(input.size());
+    for (Lut3DInterpolation interp : {Lut3DInterpolation::NEAREST, Lut3DInterpolation::TRILINEAR,
+                                      Lut3DInterpolation::TETRAHEDRAL}) {
+        Lut3DKernelResult r;
+        r.kernel = std::string("bgra ") + interpName(interp);
+        r.width = width;
+        r.height = height;
+        identity->applyPacked(input.data(), stride, width, height, true, outSimd.data(), stride, interp, 1.0f);
+        r.maxDiffIdentity = maxDiff(input, outSimd);
+        r.simdMPixPerSec = measureMPixPerSec(width, height, frames, [&] {
+            grade->applyPacked(input.data(), stride, width, height, true, outSimd.data(), stride, interp, 0.8f);
+        });
+        r.scalarMPixPerSec = measureMPixPerSec(width, height, std::max(1, frames / 4), [&] {
+            grade->applyPacked(input.data(), stride, width, height, true, outScalar.data(), stride, interp, 0.8f, false);
+        });
+        r.maxDiffScalar = maxDiff(outSimd, outScalar);
+        results.kernels.push_back(r);
+    }
+
+    grade->applyPacked(input.data(), stride, width, height, true, outSimd.data(), stride,
+                       Lut3DInterpolation::TETRAHEDRAL, 0.0f);
+    results.zeroIntensityCopy = outSimd == input;
+
+    {
+        std::vector<uint8_t> y, uv;
+        makeNV12(input, width, height, y, uv);
+        std::vector<uint8_t> y2(y.size()), uv2(uv.size()), y3(y.size()), uv3(uv.size());
+        const Nv12Format format;
+        Lut3DKernelResult r;
+        r.kernel = "nv12 tetrahedral";
+        r.width = width;
+        r.height = height;
+        identity->applyNV12(y.data(), width, uv.data(), width, width, height, y2.data(), width,
+                            uv2.data(), width, format, Lut3DInterpolation::TETRAHEDRAL, 1.0f);
+        r.maxDiffIdentity = std::max(maxDiff(y, y2), maxDiff(uv, uv2));
+        r.simdMPixPerSec = measureMPixPerSec(width, height, frames, [&] {
+            grade->applyNV12(y.data(), width, uv.data(), width, width, height, y2.data(), width,
+                             uv2.data(), width, format, Lut3DInterpolation::TETRAHEDRAL, 0.8f);
+        });
+        r.scalarMPixPerSec = measureMPixPerSec(width, height, std::max(1, frames / 4), [&] {
+            grade->applyNV12(y.data(), width, uv.data(), width, width, height, y3.data(), width,
+                             uv3.data(), width, format, Lut3DInterpolation::TETRAHEDRAL, 0.8f, false);
+        });
+        r.maxDiffScalar = std::max(maxDiff(y2, y3), maxDiff(uv2, uv3));
+        results.kernels.push_back(r);
+    }
+    return results;
+}
+
+void printLut3DBenchmark(const Lut3DBenchmarkResults& results) {
+    std::cout << "\n=== LUT 3D : chargement (ms) ===" << std::endl;
+    std::cout << std::left << std::setw(28) << "source" << std::right << std::setw(7) << "taille"
+              << std::setw(10) << "parse" << std::setw(10) << "écriture" << std::setw(10) << "mmap"
+              << std::setw(8) << "cache" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& r : results.loads) {
+        std::string label = r.source;
+        if (label.size() > 27) label = "…" + label.substr(label.size() - 26);
+        std::cout << std::left << std::setw(28) << label << std::right << std::setw(7) << r.size
+                  << std::setprecision(2) << std::setw(10) << r.parseMs << std::setw(10) << r.cacheWriteMs
+                  << std::setprecision(3) << std::setw(10) << r.cacheMapMs
+                  << std::setw(8) << (r.ok ? "OK" : "ÉCART") << std::endl;
+    }
+
+    std::cout << "\n=== LUT 3D : interpolation (MP/s) ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "noyau" << std::right << std::setw(11) << "taille"
+              << std::setw(10) << "SIMD" << std::setw(10) << "scalaire" << std::setw(8) << "Δ scal"
+              << std::setw(10) << "Δ ident" << std::endl;
+    for (const auto& r : results.kernels) {
+        const std::string size = std::to_string(r.width) + "x" + std::to_string(r.height);
+        std::cout << std::left << std::setw(20) << r.kernel << std::right << std::setw(11) << size
+                  << std::setprecision(0) << std::setw(10) << r.simdMPixPerSec << std::setw(10) << r.scalarMPixPerSec
+                  << std::setw(8) << r.maxDiffScalar << std::setw(10) << r.maxDiffIdentity << std::endl;
+    }
+    std::cout << "Intensité 0 = copie : " << (results.zeroIntensityCopy ? "OK" : "ÉCART") << std::endl;
+}
+
+} // namespace Camera
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+struct Lut3DLoadResult {
+    std::string source;
+    int size{0};
+    double parseMs{0.0};            // .cube texte -> noeuds 16 bits
+    double cacheWriteMs{0.0};       // écriture du .nlut
+    double cacheMapMs{0.0};         // projection du .nlut (chargements suivants)
+    bool ok{false};
+};
+
+struct Lut3DKernelResult {
+    std::string kernel;             // "bgra nearest", "bgra tetrahedral", "nv12 ..."
+    int width{0};
+    int height{0};
+    double simdMPixPerSec{0.0};
+    double scalarMPixPerSec{0.0};
+    int maxDiffScalar{0};           // SIMD vs scalaire (niveaux 8 bits)
+    int maxDiffIdentity{0};         // LUT identité vs entrée (niveaux 8 bits)
+};
+
+struct Lut3DBenchmarkConfig {
+    std::string cubePath;           // .cube réel en plus de la LUT synthétique (optionnel)
+    std::string cacheDir;           // répertoire du .nlut (vide : $TMPDIR)
+    int syntheticSize = 65;
+    int width = 1920;
+    int height = 1080;
+    int frames = 30;
+};
+
+struct Lut3DBenchmarkResults {
+    std::vector<Lut3DLoadResult> loads;
+    std::vector<Lut3DKernelResult> kernels;
+    bool zeroIntensityCopy{false};  // intensité 0 : sortie identique à l'entrée
+};
+
+// Chargement (parse .cube, écriture puis projection du cache binaire) et débit des noyaux
+// d'interpolation en mégapixels/s. La LUT synthétique (syntheticSize³) est écrite dans le
+// répertoire du cache puis reparsée; les noyaux tournent sur une LUT identité 33³ pour
+// mesurer l'erreur de l'interpolation elle-même, et sur une LUT non linéaire pour SIMD/scalaire.
+Lut3DBenchmarkResults runLut3DBenchmark(const Lut3DBenchmarkConfig& config = {});
+void printLut3DBenchmark(const Lut3DBenchmarkResults& results);
+
+} // namespace Camera
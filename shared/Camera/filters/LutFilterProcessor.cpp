@@ -0,0 +1,228 @@
+#include "LutFilterProcessor.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace Camera {
+
+namespace {
+
+constexpr const char* kLutPrefix = "lut3d:";
+constexpr size_t kMaxCachedLuts = 8;
+
+} // namespace
+
+LutFilterProcessor::LutFilterProcessor() {
+    std::cout << "[LutFilterProcessor] Construction" << std::endl;
+}
+
+LutFilterProcessor::~LutFilterProcessor() {
+    shutdown();
+    std::cout << "[LutFilterProcessor] Destruction" << std::endl;
+}
+
+bool LutFilterProcessor::initialize() {
+    initialized_ = true;
+    return true;
+}
+
+void LutFilterProcessor::shutdown() {
+    initialized_ = false;
+    luts_.clear();
+    failedPath_.clear();
+}
+
+bool LutFilterProcessor::applyFilter(const FilterState& filter, const void* inputData,
+                                     size_t inputSize, void* outputData, size_t outputSize) {
+    if (!initialized_) {
+        setLastError("Processeur non initialisé");
+        return false;
+    }
+    if (width_ <= 0 || height_ <= 0) {
+        setLastError("Format vidéo non défini");
+        return false;
+    }
+    const auto* in = static_cast<const uint8_t*>(inputData);
+    auto* out = static_cast<uint8_t*>(outputData);
+    if (pixelFormat_ == "nv12") {
+        // Buffer contigu : Y (stride = largeur) puis UV entrelacé
+        const size_t ySize = static_cast<size_t>(width_) * height_;
+        const size_t frameBytes = ySize + static_cast<size_t>((width_ + 1) / 2 * 2) * ((height_ + 1) / 2);
+        if (inputSize < frameBytes || outputSize < frameBytes) {
+            setLastError("Taille de buffer insuffisante");
+            return false;
+        }
+        const int uvStride = (width_ + 1) / 2 * 2;
+        return applyNV12(filter, in, width_, in + ySize, uvStride, width_, height_,
+                         out, width_, out + ySize, uvStride);
+    }
+    // Buffer packé : stride = largeur * 4
+    const size_t frameBytes = static_cast<size_t>(width_) * height_ * 4;
+    if (inputSize < frameBytes || outputSize < frameBytes) {
+        setLastError("Taille de buffer insuffisante");
+        return false;
+    }
+    return applyFilterWithStride(filter, in, width_ * 4, width_, height_, pixelFormat_.c_str(),
+                                 out, width_ * 4);
+}
+
+bool LutFilterProcessor::supportsFormat(const std::string& format) const {
+    return format == "bgra" || format == "rgba" || format == "nv12";
+}
+
+bool LutFilterProcessor::supportsFilter(FilterType type) const {
+    return type == FilterType::CUSTOM;
+}
+
+bool LutFilterProcessor::canProcess(const FilterState& filter) const {
+    return filter.type == FilterType::CUSTOM &&
+           (filter.params.customFilterName.rfind(kLutPrefix, 0) == 0 || !filter.params.customLUTPath.empty());
+}
+
+std::string LutFilterProcessor::getName() const {
+    return "LutFilterProcessor";
+}
+
+std::vector<FilterInfo> LutFilterProcessor::getSupportedFilters() const {
+    std::vector<FilterInfo> filters;
+    filters.push_back({"lut3d", "LUT 3D (.cube)", FilterType::CUSTOM, "Applique une LUT 3D au format .cube (DaVinci, etc.)", true, {"bgra", "rgba", "nv12"}});
+    return filters;
+}
+
+void LutFilterProcessor::setCacheDirectory(const std::string& directory) {
+    cacheDirectory_ = directory;
+}
+
+std::shared_ptr<IFilterProcessor> LutFilterProcessor::clone() const {
+    auto copy = std::make_shared<LutFilterProcessor>();
+    copy->initialized_ = initialized_;
+    copy->width_ = width_;
+    copy->height_ = height_;
+    copy->pixelFormat_ = pixelFormat_;
+    copy->nv12Format_ = nv12Format_;
+    copy->cacheDirectory_ = cacheDirectory_;
+    copy->luts_ = luts_;
+    return copy;
+}
+
+bool LutFilterProcessor::setVideoFormat(int width, int height, const std::string& pixelFormat) {
+    if (!supportsFormat(pixelFormat)) {
+        setLastError("Format non supporté: " + pixelFormat);
+        return false;
+    }
+    width_ = width;
+    height_ = height;
+    pixelFormat_ = pixelFormat;
+    return true;
+}
+
+bool LutFilterProcessor::parseName(const std::string& name, std::string& path, Lut3DInterpolation& interp) {
+    const std::string prefix = kLutPrefix;
+    if (name.rfind(prefix, 0) != 0 || name.size() <= prefix.size()) return false;
+    std::string rest = name.substr(prefix.size());
+    interp = Lut3DInterpolation::TETRAHEDRAL;
+    const auto qpos = rest.find('?');
+    path = rest.substr(0, qpos);
+    if (qpos != std::string::npos) {
+        const std::string query = rest.substr(qpos + 1);
+        size_t start = 0;
+        while (start < query.size()) {
+            const size_t amp = query.find('&', start);
+            const std::string pair = query.substr(start, amp == std::string::npos ? std::string::npos : amp - start);
+            const size_t eq = pair.find('=');
+            if (eq != std::string::npos && pair.compare(0, eq, "interp") == 0) {
+                const std::string value = pair.substr(eq + 1);
+                if (value == "nearest") interp = Lut3DInterpolation::NEAREST;
+                else if (value == "trilinear") interp = Lut3DInterpolation::TRILINEAR;
+                else if (value == "tetrahedral") interp = Lut3DInterpolation::TETRAHEDRAL;
+            }
+            if (amp == std::string::npos) break;
+            start = amp + 1;
+        }
+    }
+    return !path.empty();
+}
+
+std::shared_ptr<const Lut3D> LutFilterProcessor::lutFor(const FilterState& filter, Lut3DInterpolation& interp) {
+    std::string path;
+    if (!parseName(filter.params.customFilterName, path, interp)) {
+        interp = Lut3DInterpolation::TETRAHEDRAL;
+    }
+    if (!filter.params.customLUTPath.empty()) {
+        path = filter.params.customLUTPath;
+    }
+    if (path.empty()) {
+        setLastError("Chemin LUT manquant");
+        return nullptr;
+    }
+    auto it = luts_.find(path);
+    if (it != luts_.end()) return it->second;
+    if (path == failedPath_) return nullptr;
+
+    std::string error;
+    auto lut = Lut3D::load(path, cacheDirectory_, error);
+    if (!lut) {
+        failedPath_ = path;
+        setLastError(error);
+        return nullptr;
+    }
+    std::cout << "[LutFilterProcessor] LUT " << lut->size() << "³ chargée"
+              << (lut->isMapped() ? " (cache)" : "") << ": " << path << std::endl;
+    if (luts_.size() >= kMaxCachedLuts) luts_.clear();
+    luts_.emplace(path, lut);
+    return lut;
+}
+
+bool LutFilterProcessor::applyFilterWithStride(const FilterState& filter,
+                                               const uint8_t* inputData,
+                                               int inputStride,
+                                               int width,
+                                               int height,
+                                               const char* pixFormat,
+                                               uint8_t* outputData,
+                                               int outputStride) {
+    if (!initialized_) { setLastError("Processeur non initialisé"); return false; }
+    if (!inputData || !outputData || width <= 0 || height <= 0) { setLastError("Paramètres invalides"); return false; }
+    if (inputStride < width * 4 || outputStride < width * 4) { setLastError("Stride insuffisant"); return false; }
+    const std::string format = pixFormat ? pixFormat : "bgra";
+    if (format != "bgra" && format != "rgba") { setLastError("Format non supporté: " + format); return false; }
+
+    Lut3DInterpolation interp;
+    const auto lut = lutFor(filter, interp);
+    if (!lut) return false;
+    lut->applyPacked(inputData, inputStride, width, height, format == "bgra", outputData, outputStride,
+                     interp, static_cast<float>(filter.params.intensity));
+    return true;
+}
+
+bool LutFilterProcessor::applyNV12(const FilterState& filter,
+                                   const uint8_t* inputY, int inputYStride,
+                                   const uint8_t* inputUV, int inputUVStride,
+                                   int width, int height,
+                                   uint8_t* outputY, int outputYStride,
+                                   uint8_t* outputUV, int outputUVStride) {
+    if (!initialized_) { setLastError("Processeur non initialisé"); return false; }
+    if (!inputY || !inputUV || !outputY || !outputUV || width <= 0 || height <= 0) {
+        setLastError("Paramètres invalides");
+        return false;
+    }
+    const int uvBytes = (width + 1) / 2 * 2;
+    if (inputYStride < width || outputYStride < width || inputUVStride < uvBytes || outputUVStride < uvBytes) {
+        setLastError("Stride insuffisant");
+        return false;
+    }
+
+    Lut3DInterpolation interp;
+    const auto lut = lutFor(filter, interp);
+    if (!lut) return false;
+    lut->applyNV12(inputY, inputYStride, inputUV, inputUVStride, width, height,
+                   outputY, outputYStride, outputUV, outputUVStride, nv12Format_,
+                   interp, static_cast<float>(filter.params.intensity));
+    return true;
+}
+
+void LutFilterProcessor::setLastError(const std::string& error) {
+    lastError_ = error;
+    std::cout << "[LutFilterProcessor] Erreur: " << error << std::endl;
+}
+
+} // namespace Camera
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../common/FilterTypes.hpp"
+#include "Lut3D.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Camera {
+
+/**
+ * Processeur natif pour les LUT 3D (.cube) : filtre CUSTOM nommé
+ * "lut3d:/chemin/absolu.cube?interp=nearest|trilinear|tetrahedral" (défaut tetrahedral),
+ * ou customLUTPath renseigné.
+ *
+ * Une passe SIMD par image (BGRA/RGBA avec stride, ou NV12 biplanaire) avec le
+ * mélange d'intensité intégré; les LUT sont chargées via le cache binaire (.nlut)
+ * et gardées en mémoire par chemin.
+ */
+class LutFilterProcessor : public IFilterProcessor {
+public:
+    LutFilterProcessor();
+    ~LutFilterProcessor() override;
+
+    // IFilterProcessor interface
+    bool initialize() override;
+    void shutdown() override;
+
+    bool applyFilter(const FilterState& filter, const void* inputData,
+                   size_t inputSize, void* outputData, size_t outputSize) override;
+
+    bool supportsFormat(const std::string& format) const override;
+    bool supportsFilter(FilterType type) const override;
+    bool canProcess(const FilterState& filter) const override;
+
+    std::string getName() const override;
+    std::vector<FilterInfo> getSupportedFilters() const override;
+    // LUT déjà chargées partagées (immuables)
+    std::shared_ptr<IFilterProcessor> clone() const override;
+
+    // Préféré au graphe FFmpeg lut3d
+    int getPriority() const override { return 10; }
+
+    // Répertoire du cache .nlut (vide : $TMPDIR)
+    void setCacheDirectory(const std::string& directory);
+    bool setVideoFormat(int width, int height, const std::string& pixelFormat) override;
+    void setNv12Format(const Nv12Format& format) { nv12Format_ = format; }
+
+    // pixFormat: "bgra" ou "rgba". In-place autorisé (inputData == outputData).
+    bool applyFilterWithStride(const FilterState& filter,
+                               const uint8_t* inputData,
+                               int inputStride,
+                               int width,
+                               int height,
+                               const char* pixFormat,
+                               uint8_t* outputData,
+                               int outputStride);
+
+    // NV12 biplanaire (CVPixelBuffer '420v'/'420f', ImageReader)
+    bool applyNV12(const FilterState& filter,
+                   const uint8_t* inputY, int inputYStride,
+                   const uint8_t* inputUV, int inputUVStride,
+                   int width, int height,
+                   uint8_t* outputY, int outputYStride,
+                   uint8_t* outputUV, int outputUVStride);
+
+    // "lut3d:/p.cube?interp=..." -> chemin + interpolation; false si ce n'est pas une LUT
+    static bool parseName(const std::string& name, std::string& path, Lut3DInterpolation& interp);
+
+    // LUT chargée (ou en cache) pour ce filtre, nullptr en cas d'échec
+    std::shared_ptr<const Lut3D> lutFor(const FilterState& filter, Lut3DInterpolation& interp);
+
+private:
+    bool initialized_{false};
+    std::string lastError_;
+
+    int width_{0};
+    int height_{0};
+    std::string pixelFormat_{"bgra"};
+    Nv12Format nv12Format_;
+
+    std::string cacheDirectory_;
+    std::unordered_map<std::string, std::shared_ptr<const Lut3D>> luts_;
+    // Dernier chemin en échec : pas de nouveau parse à chaque image
+    std::string failedPath_;
+
+    void setLastError(const std::string& error);
+};
+
+} // namespace Camera
@@ -0,0 +1,383 @@
+#include "FramePipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace Camera {
+
+namespace {
+
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Attente active avant de s'endormir : couvre l'écart entre deux étapes d'une même image
+constexpr int kSpinIterations = 1024;
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void storeMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+// RecordQueue
+
+FramePipeline::RecordQueue::RecordQueue(size_t capacity)
+    : slots_(new std::atomic<uint32_t>[nextPowerOfTwo(std::max<size_t>(2, capacity))]),
+      mask_(nextPowerOfTwo(std::max<size_t>(2, capacity)) - 1) {
+    for (size_t i = 0; i <= mask_; ++i) slots_[i].store(0, std::memory_order_relaxed);
+}
+
+bool FramePipeline::RecordQueue::push(uint32_t index) {
+    const uint64_t t = tail_.load(std::memory_order_relaxed);
+    const uint64_t h = head_.load(std::memory_order_acquire);
+    if (t - h > mask_) {
+        return false;
+    }
+    slots_[t & mask_].store(index, std::memory_order_relaxed);
+    tail_.store(t + 1, std::memory_order_release);
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) > 0) {
+        epoch_.notify_one();
+    }
+    return true;
+}
+
+bool FramePipeline::RecordQueue::pop(uint32_t& index) {
+    uint64_t h = head_.load(std::memory_order_acquire);
+    for (;;) {
+        const uint64_t t = tail_.load(std::memory_order_acquire);
+        if (h == t) {
+            return false;
+        }
+        const uint32_t value = slots_[h & mask_].load(std::memory_order_relaxed);
+        // Tête disputée par le consommateur et le producteur (retrait de la plus ancienne)
+        if (head_.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            index = value;
+            return true;
+        }
+    }
+}
+
+bool FramePipeline::RecordQueue::empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+}
+
+bool FramePipeline::RecordQueue::waitPop(uint32_t& index, const std::atomic<bool>& stop) {
+    int idle = 0;
+    for (;;) {
+        if (stop.load(std::memory_order_acquire)) return false;
+        if (pop(index)) return true;
+        if (++idle < kSpinIterations) {
+            cpuRelax();
+            continue;
+        }
+        idle = 0;
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        if (empty() && !stop.load(std::memory_order_seq_cst)) {
+            epoch_.wait(epoch, std::memory_order_seq_cst);
+        }
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+void FramePipeline::RecordQueue::wakeAll() {
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    epoch_.notify_all();
+}
+
+// FramePipeline
+
+FramePipeline::FramePipeline(const FramePipelineConfig& config)
+    : config_(config) {
+    config_.depth = std::clamp(config_.depth, 1, kMaxDepth);
+    config_.blockTimeoutMs = std::max(0, config_.blockTimeoutMs);
+}
+
+FramePipeline::~FramePipeline() {
+    stop(false);
+}
+
+bool FramePipeline::addStage(const std::string& name, StageFn fn) {
+    if (running_.load(std::memory_order_acquire) || !fn) {
+        return false;
+    }
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->fn = std::move(fn);
+    stages_.push_back(std::move(stage));
+    return true;
+}
+
+void FramePipeline::setReleaseCallback(ReleaseFn fn) {
+    if (!running_.load(std::memory_order_acquire)) {
+        release_ = std::move(fn);
+    }
+}
+
+bool FramePipeline::start() {
+    if (running_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (stages_.empty()) {
+        std::cout << "[FramePipeline] " << config_.name << " : aucune étape" << std::endl;
+        return false;
+    }
+    const size_t depth = static_cast<size_t>(config_.depth);
+    records_.reset(new Record[depth]);
+    queues_.clear();
+    for (size_t i = 0; i <= stages_.size(); ++i) {
+        queues_.push_back(std::make_unique<RecordQueue>(depth));
+    }
+    for (size_t i = 0; i < depth; ++i) {
+        queues_.back()->push(static_cast<uint32_t>(i));
+    }
+    inFlight_.store(0, std::memory_order_relaxed);
+    stop_.store(false, std::memory_order_release);
+    accepting_.store(true, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        stages_[i]->thread = std::thread([this, i] { stageLoop(i); });
+    }
+    std::cout << "[FramePipeline] " << config_.name << " : " << stages_.size() << " étapes, "
+              << depth << " images en vol, "
+              << (config_.policy == FrameDropPolicy::DropOldest ? "drop-oldest" : "contre-pression")
+              << std::endl;
+    return true;
+}
+
+void FramePipeline::stop(bool drain) {
+    if (!running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    accepting_.store(false, std::memory_order_seq_cst);
+    if (drain) {
+        // Images en vol menées au bout (fin d'enregistrement)
+        slotWaiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::unique_lock<std::mutex> lock(slotMutex_);
+        const bool drained = slotCondition_.wait_for(lock, std::chrono::milliseconds(config_.drainTimeoutMs), [this] {
+            return inFlight_.load(std::memory_order_seq_cst) == 0;
+        });
+        slotWaiters_.fetch_sub(1, std::memory_order_seq_cst);
+        if (!drained) {
+            std::cout << "[FramePipeline] " << config_.name << " : vidage interrompu après "
+                      << config_.drainTimeoutMs << " ms, " << inFlight_.load() << " images en vol" << std::endl;
+        }
+    }
+    stop_.store(true, std::memory_order_seq_cst);
+    {
+        // Producteur Block encore en attente : refus immédiat
+        std::lock_guard<std::mutex> lock(slotMutex_);
+        slotCondition_.notify_all();
+    }
+    for (auto& queue : queues_) queue->wakeAll();
+    for (auto& stage : stages_) {
+        if (stage->thread.joinable()) stage->thread.join();
+    }
+    flush();
+    running_.store(false, std::memory_order_release);
+}
+
+void FramePipeline::flush() {
+    // Threads arrêtés : images restées dans les files d'étapes
+    for (size_t i = 0; i + 1 < queues_.size(); ++i) {
+        uint32_t index = 0;
+        while (queues_[i]->pop(index)) {
+            Record& record = records_[index];
+            if (release_) release_(record.frame, FrameOutcome::Flushed);
+            record.frame = PipelineFrame{};
+            flushed_.fetch_add(1, std::memory_order_relaxed);
+            inFlight_.fetch_sub(1, std::memory_order_relaxed);
+            queues_.back()->push(index);
+        }
+    }
+}
+
+bool FramePipeline::submit(void* image, int64_t timestampNs, void* user) {
+    if (!accepting_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t index = 0;
+    if (!queues_.back()->pop(index)) {
+        if (config_.policy == FrameDropPolicy::DropOldest) {
+            // L'image en attente la plus ancienne cède sa place
+            if (!queues_[0]->pop(index)) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            Record& old = records_[index];
+            if (release_) release_(old.frame, FrameOutcome::Dropped);
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            inFlight_.fetch_sub(1, std::memory_order_relaxed);
+        } else if (!waitForSlot(index)) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    Record& record = records_[index];
+    record.frame = PipelineFrame{};
+    record.frame.sequence = nextSequence_++;
+    record.frame.timestampNs = timestampNs;
+    record.frame.image = image;
+    record.frame.user = user;
+    record.submittedNs = nowNs();
+    record.queuedNs = record.submittedNs;
+
+    const int inFlight = inFlight_.fetch_add(1, std::memory_order_relaxed) + 1;
+    int high = maxInFlight_.load(std::memory_order_relaxed);
+    while (inFlight > high && !maxInFlight_.compare_exchange_weak(high, inFlight, std::memory_order_relaxed)) {
+    }
+    queues_[0]->push(index);
+    return true;
+}
+
+bool FramePipeline::waitForSlot(uint32_t& index) {
+    const int64_t t0 = nowNs();
+    backpressureWaits_.fetch_add(1, std::memory_order_relaxed);
+    bool ok = false;
+    {
+        slotWaiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::unique_lock<std::mutex> lock(slotMutex_);
+        slotCondition_.wait_for(lock, std::chrono::milliseconds(config_.blockTimeoutMs), [this] {
+            return !queues_.back()->empty() || stop_.load(std::memory_order_acquire);
+        });
+        slotWaiters_.fetch_sub(1, std::memory_order_seq_cst);
+        ok = queues_.back()->pop(index);
+    }
+    backpressureNs_.fetch_add(static_cast<uint64_t>(nowNs() - t0), std::memory_order_relaxed);
+    return ok;
+}
+
+void FramePipeline::stageLoop(size_t index) {
+    Stage& stage = *stages_[index];
+    RecordQueue& input = *queues_[index];
+    const bool last = index + 1 == stages_.size();
+
+    uint32_t slot = 0;
+    while (input.waitPop(slot, stop_)) {
+        Record& record = records_[slot];
+        const int64_t start = nowNs();
+        const uint64_t wait = static_cast<uint64_t>(std::max<int64_t>(0, start - record.queuedNs));
+        if (!record.frame.failed) {
+            bool ok = false;
+            try {
+                ok = stage.fn(record.frame);
+            } catch (...) {
+                ok = false;
+            }
+            const int64_t end = nowNs();
+            const uint64_t busy = static_cast<uint64_t>(end - start);
+            stage.frames.fetch_add(1, std::memory_order_relaxed);
+            stage.busyNs.fetch_add(busy, std::memory_order_relaxed);
+            storeMax(stage.maxBusyNs, busy);
+            stage.waitNs.fetch_add(wait, std::memory_order_relaxed);
+            storeMax(stage.maxWaitNs, wait);
+            if (!ok) {
+                // Étapes suivantes sautées, l'image suit la file jusqu'à la libération
+                record.frame.failed = true;
+                stage.failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        const int64_t end = nowNs();
+        if (last) {
+            complete(record, end);
+        } else {
+            record.queuedNs = end;
+            queues_[index + 1]->push(slot);
+        }
+    }
+}
+
+void FramePipeline::complete(Record& record, int64_t now) {
+    const bool failed = record.frame.failed;
+    if (failed) {
+        failed_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        completed_.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t latency = static_cast<uint64_t>(std::max<int64_t>(0, now - record.submittedNs));
+        latencyNs_.fetch_add(latency, std::memory_order_relaxed);
+        storeMax(maxLatencyNs_, latency);
+    }
+    if (release_) release_(record.frame, failed ? FrameOutcome::Failed : FrameOutcome::Completed);
+    record.frame = PipelineFrame{};
+
+    const uint32_t slot = static_cast<uint32_t>(&record - records_.get());
+    inFlight_.fetch_sub(1, std::memory_order_seq_cst);
+    queues_.back()->push(slot);
+    // Producteur bloqué (Block) ou stop() en vidage
+    if (slotWaiters_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(slotMutex_);
+        slotCondition_.notify_all();
+    }
+}
+
+FramePipelineStats FramePipeline::getStats() const {
+    FramePipelineStats stats;
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.completed = completed_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    stats.flushed = flushed_.load(std::memory_order_relaxed);
+    stats.backpressureWaits = backpressureWaits_.load(std::memory_order_relaxed);
+    stats.backpressureMs = backpressureNs_.load(std::memory_order_relaxed) / 1e6;
+    stats.meanLatencyMs = stats.completed > 0 ? latencyNs_.load(std::memory_order_relaxed) / 1e6 / stats.completed : 0.0;
+    stats.maxLatencyMs = maxLatencyNs_.load(std::memory_order_relaxed) / 1e6;
+    stats.inFlight = inFlight_.load(std::memory_order_relaxed);
+    stats.maxInFlight = maxInFlight_.load(std::memory_order_relaxed);
+    for (const auto& stage : stages_) {
+        PipelineStageStats s;
+        s.name = stage->name;
+        s.frames = stage->frames.load(std::memory_order_relaxed);
+        s.failed = stage->failed.load(std::memory_order_relaxed);
+        if (s.frames > 0) {
+            s.meanMs = stage->busyNs.load(std::memory_order_relaxed) / 1e6 / s.frames;
+            s.meanWaitMs = stage->waitNs.load(std::memory_order_relaxed) / 1e6 / s.frames;
+        }
+        s.maxMs = stage->maxBusyNs.load(std::memory_order_relaxed) / 1e6;
+        s.maxWaitMs = stage->maxWaitNs.load(std::memory_order_relaxed) / 1e6;
+        stats.stages.push_back(s);
+    }
+    return stats;
+}
+
+void FramePipeline::resetStats() {
+    for (auto* counter : {&submitted_, &completed_, &dropped_, &rejected_, &failed_, &flushed_,
+                          &backpressureWaits_, &backpressureNs_, &latencyNs_, &maxLatencyNs_}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    maxInFlight_.store(inFlight_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (auto& stage : stages_) {
+        for (auto* counter : {&stage->frames, &stage->failed, &stage->busyNs, &stage->maxBusyNs,
+                              &stage->waitNs, &stage->maxWaitNs}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace Camera
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Camera {
+
+// Politique quand toutes les places en vol sont prises
+enum class FrameDropPolicy {
+    DropOldest,     // aperçu : l'image en attente la plus ancienne est remplacée
+    Block,          // enregistrement : le producteur attend une place (contre-pression)
+};
+
+// Sortie d'une image du pipeline (callback de libération)
+enum class FrameOutcome {
+    Completed,      // toutes les étapes exécutées
+    Dropped,        // remplacée par une image plus récente (DropOldest)
+    Failed,         // une étape a échoué : étapes suivantes sautées
+    Flushed,        // stop() sans vidage
+};
+
+// Image en vol : handles opaques (CVPixelBufferRef, AHardwareBuffer, buffer CPU...)
+struct PipelineFrame {
+    uint64_t sequence{0};           // ordre de soumission
+    int64_t timestampNs{0};         // horodatage de capture (appelant)
+    void* image{nullptr};           // entrée
+    void* output{nullptr};          // produit par une étape (buffer filtré...)
+    void* user{nullptr};
+    bool failed{false};
+};
+
+struct PipelineStageStats {
+    std::string name;
+    uint64_t frames{0};
+    uint64_t failed{0};
+    double meanMs{0.0};             // durée de l'étape
+    double maxMs{0.0};
+    double meanWaitMs{0.0};         // attente dans la file d'entrée
+    double maxWaitMs{0.0};
+};
+
+struct FramePipelineStats {
+    uint64_t submitted{0};
+    uint64_t completed{0};
+    uint64_t dropped{0};            // DropOldest
+    uint64_t rejected{0};           // refusées à la soumission (aucune place, délai Block dépassé)
+    uint64_t failed{0};
+    uint64_t flushed{0};
+    uint64_t backpressureWaits{0};  // soumissions Block qui ont attendu
+    double backpressureMs{0.0};     // cumul de ces attentes
+    double meanLatencyMs{0.0};      // soumission -> fin de la dernière étape
+    double maxLatencyMs{0.0};
+    int inFlight{0};
+    int maxInFlight{0};
+    std::vector<PipelineStageStats> stages;
+};
+
+struct FramePipelineConfig {
+    std::string name = "pipeline";
+    int depth = 3;                  // images en vol, de la soumission à la fin de la dernière étape
+    FrameDropPolicy policy = FrameDropPolicy::DropOldest;
+    int blockTimeoutMs = 500;       // Block : attente max d'une place avant refus
+    int drainTimeoutMs = 2000;      // stop(true) : au-delà, images restantes libérées en Flushed
+};
+
+/**
+ * Pipeline d'images par étapes (capture -> filtre -> encodage/affichage)
+ *
+ * Chaque étape a son thread et lit une file bornée sans verrou d'index d'images : l'ordre de
+ * soumission est conservé de bout en bout. depth enregistrements sont préalloués; le dernier
+ * étage les rend au producteur par une file dédiée, sans allocation par image.
+ * Producteur unique (callback de capture). submit ne bloque qu'en politique Block, et seulement
+ * quand depth images sont déjà en vol.
+ */
+class FramePipeline {
+public:
+    using StageFn = std::function<bool(PipelineFrame&)>;
+    using ReleaseFn = std::function<void(PipelineFrame&, FrameOutcome)>;
+
+    static constexpr int kMaxDepth = 64;
+
+    explicit FramePipeline(const FramePipelineConfig& config = {});
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Avant start()
+    bool addStage(const std::string& name, StageFn fn);
+    // Appelé à chaque sortie d'image (thread de la dernière étape, ou producteur pour Dropped)
+    void setReleaseCallback(ReleaseFn fn);
+
+    bool start();
+    // drain : attend la fin des images en vol (enregistrement); sinon Flushed
+    void stop(bool drain = true);
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // false : image refusée, elle reste à l'appelant (pas de callback de libération)
+    bool submit(void* image, int64_t timestampNs, void* user = nullptr);
+
+    FramePipelineStats getStats() const;
+    void resetStats();
+    const FramePipelineConfig& config() const { return config_; }
+
+private:
+    // File bornée d'index d'enregistrements. Un producteur, un consommateur; le producteur de la
+    // file d'entrée peut aussi retirer la tête (DropOldest) : la tête avance par CAS.
+    class RecordQueue {
+    public:
+        explicit RecordQueue(size_t capacity);
+        bool push(uint32_t index);
+        bool pop(uint32_t& index);
+        bool empty() const;
+        // Attend un index; false si stop passe à true
+        bool waitPop(uint32_t& index, const std::atomic<bool>& stop);
+        void wakeAll();
+    private:
+        std::unique_ptr<std::atomic<uint32_t>[]> slots_;
+        size_t mask_;
+        alignas(64) std::atomic<uint64_t> head_{0};
+        alignas(64) std::atomic<uint64_t> tail_{0};
+        alignas(64) std::atomic<uint32_t> epoch_{0};
+        std::atomic<uint32_t> waiters_{0};
+    };
+
+    struct Record {
+        PipelineFrame frame;
+        int64_t submittedNs{0};
+        int64_t queuedNs{0};            // entrée dans la file courante
+    };
+
+    struct Stage {
+        std::string name;
+        StageFn fn;
+        std::thread thread;
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> maxBusyNs{0};
+        std::atomic<uint64_t> waitNs{0};
+        std::atomic<uint64_t> maxWaitNs{0};
+    };
+
+    void stageLoop(size_t index);
+    void complete(Record& record, int64_t nowNs);
+    bool waitForSlot(uint32_t& index);
+    void flush();
+
+    FramePipelineConfig config_;
+    std::vector<std::unique_ptr<Stage>> stages_;
+    ReleaseFn release_;
+    std::unique_ptr<Record[]> records_;
+    // queues_[i] : entrée de l'étape i; queues_.back() : enregistrements libres
+    std::vector<std::unique_ptr<RecordQueue>> queues_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> accepting_{false};
+    std::atomic<bool> stop_{false};
+    uint64_t nextSequence_{0};
+
+    // Attente d'une place (Block, vidage) : hors chemin chaud
+    std::mutex slotMutex_;
+    std::condition_variable slotCondition_;
+    std::atomic<int> slotWaiters_{0};   // producteur Block et stop() peuvent attendre ensemble
+
+    std::atomic<int> inFlight_{0};
+    std::atomic<int> maxInFlight_{0};
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> flushed_{0};
+    std::atomic<uint64_t> backpressureWaits_{0};
+    std::atomic<uint64_t> backpressureNs_{0};
+    std::atomic<uint64_t> latencyNs_{0};
+    std::atomic<uint64_t> maxLatencyNs_{0};
+};
+
+} // namespace Camera
@@ -0,0 +1,238 @@
+#include "FramePipelineBenchmark.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace Camera {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void simulateWork(double ms) {
+    if (ms > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms));
+    }
+}
+
+// Buffer du capteur simulé : rendu par le callback de libération
+struct CaptureBuffer {
+    std::vector<uint8_t> pixels;
+    std::atomic<bool> busy{false};
+};
+
+class SyntheticCamera {
+public:
+    SyntheticCamera(const FramePipelineBenchmarkConfig& config)
+        : config_(config),
+          interval_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.fps))),
+          buffers_(new CaptureBuffer[std::max(1, config.captureBuffers)]),
+          bufferCount_(std::max(1, config.captureBuffers)),
+          deliveries_(static_cast<size_t>(config.frames), -1.0) {
+        const size_t bytes = static_cast<size_t>(config.width) * config.height * 4;
+        for (int i = 0; i < bufferCount_; ++i) {
+            buffers_[i].pixels.assign(bytes, 0);
+        }
+    }
+
+    double intervalMs() const { return std::chrono::duration<double, std::milli>(interval_).count(); }
+
+    // deliver(buffer, tick) : false si l'image n'a pas été prise en charge (buffer rendu ici)
+    template <typename Deliver>
+    void run(FramePipelineBenchmarkResult& result, Deliver&& deliver) {
+        start_ = Clock::now() + std::chrono::milliseconds(5);
+        int tick = 0;
+        while (tick < config_.frames) {
+            std::this_thread::sleep_until(start_ + interval_ * tick);
+            CaptureBuffer* buffer = acquire();
+            if (!buffer) {
+                ++result.captureDrops;
+            } else {
+                stamp(*buffer, tick);
+                if (!deliver(buffer, tick)) {
+                    ++result.rejected;
+                    buffer->busy.store(false, std::memory_order_release);
+                }
+            }
+            // Ticks écoulés pendant le callback : images perdues par la session de capture
+            const auto late = Clock::now() - start_;
+            const int next = std::min(config_.frames, static_cast<int>(late / interval_) + 1);
+            if (next > tick + 1) {
+                result.captureDrops += next - tick - 1;
+                tick = next;
+            } else {
+                ++tick;
+            }
+        }
+        result.captured = config_.frames;
+    }
+
+    bool filter(CaptureBuffer& buffer, int tick) {
+        const bool spike = config_.spikeEvery > 0 && tick % config_.spikeEvery == config_.spikeEvery - 1;
+        simulateWork(spike ? config_.filterSpikeMs : config_.filterMs);
+        buffer.pixels[sizeof(uint64_t)] = 1;
+        return true;
+    }
+
+    // Dernière étape : contrôle du contenu, de l'ordre et de la cadence de sortie
+    bool output(CaptureBuffer& buffer, int tick) {
+        simulateWork(config_.outputMs);
+        uint64_t head = 0;
+        uint64_t tail = 0;
+        std::memcpy(&head, buffer.pixels.data(), sizeof(head));
+        std::memcpy(&tail, buffer.pixels.data() + buffer.pixels.size() - sizeof(tail), sizeof(tail));
+        if (head != static_cast<uint64_t>(tick) || tail != head || buffer.pixels[sizeof(uint64_t)] != 1 ||
+            tick <= lastTick_) {
+            intact_ = false;
+        }
+        lastTick_ = tick;
+        deliveries_[static_cast<size_t>(tick)] =
+            std::chrono::duration<double, std::milli>(Clock::now() - (start_ + interval_ * tick)).count();
+        return true;
+    }
+
+    void release(CaptureBuffer& buffer) { buffer.busy.store(false, std::memory_order_release); }
+
+    void finish(FramePipelineBenchmarkResult& result) const {
+        double sum = 0.0;
+        double previousEnd = -1.0;
+        for (size_t tick = 0; tick < deliveries_.size(); ++tick) {
+            const double latency = deliveries_[tick];
+            if (latency < 0.0) continue;
+            ++result.delivered;
+            sum += latency;
+            result.maxLatencyMs = std::max(result.maxLatencyMs, latency);
+            const double end = tick * intervalMs() + latency;
+            if (previousEnd >= 0.0) result.maxGapMs = std::max(result.maxGapMs, end - previousEnd);
+            previousEnd = end;
+        }
+        result.meanLatencyMs = result.delivered > 0 ? sum / result.delivered : 0.0;
+        result.intact = intact_;
+    }
+
+private:
+    CaptureBuffer* acquire() {
+        for (int i = 0; i < bufferCount_; ++i) {
+            bool expected = false;
+            if (buffers_[i].busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return &buffers_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    static void stamp(CaptureBuffer& buffer, int tick) {
+        const uint64_t value = static_cast<uint64_t>(tick);
+        std::memcpy(buffer.pixels.data(), &value, sizeof(value));
+        std::memcpy(buffer.pixels.data() + buffer.pixels.size() - sizeof(value), &value, sizeof(value));
+        buffer.pixels[sizeof(uint64_t)] = 0;
+    }
+
+    const FramePipelineBenchmarkConfig& config_;
+    Clock::duration interval_;
+    std::unique_ptr<CaptureBuffer[]> buffers_;
+    int bufferCount_;
+    Clock::time_point start_;
+    std::vector<double> deliveries_;   // latence par tick, -1 : non livré
+    int lastTick_{-1};
+    bool intact_{true};
+};
+
+FramePipelineBenchmarkResult runSynchronous(const FramePipelineBenchmarkConfig& config) {
+    FramePipelineBenchmarkResult result;
+    result.label = "synchrone";
+    SyntheticCamera camera(config);
+    camera.run(result, [&](CaptureBuffer* buffer, int tick) {
+        camera.filter(*buffer, tick);
+        camera.output(*buffer, tick);
+        camera.release(*buffer);
+        return true;
+    });
+    camera.finish(result);
+    return result;
+}
+
+FramePipelineBenchmarkResult runPipelined(const FramePipelineBenchmarkConfig& config, int depth, FrameDropPolicy policy) {
+    FramePipelineBenchmarkResult result;
+    result.label = policy == FrameDropPolicy::DropOldest ? "aperçu drop-oldest" : "enregistrement";
+    result.depth = depth;
+    SyntheticCamera camera(config);
+
+    FramePipelineConfig pipelineConfig;
+    pipelineConfig.name = result.label;
+    pipelineConfig.depth = depth;
+    pipelineConfig.policy = policy;
+    FramePipeline pipeline(pipelineConfig);
+    auto tickOf = [](const PipelineFrame& frame) { return static_cast<int>(frame.timestampNs); };
+    pipeline.addStage("filtre", [&](PipelineFrame& frame) {
+        return camera.filter(*static_cast<CaptureBuffer*>(frame.image), tickOf(frame));
+    });
+    pipeline.addStage("sortie", [&](PipelineFrame& frame) {
+        return camera.output(*static_cast<CaptureBuffer*>(frame.image), tickOf(frame));
+    });
+    pipeline.setReleaseCallback([&](PipelineFrame& frame, FrameOutcome) {
+        camera.release(*static_cast<CaptureBuffer*>(frame.image));
+    });
+    pipeline.start();
+
+    // Horodatage = numéro de tick : la dernière étape vérifie le contenu du buffer
+    camera.run(result, [&](CaptureBuffer* buffer, int tick) {
+        return pipeline.submit(buffer, tick);
+    });
+    pipeline.stop(true);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    result.pipelineDrops = static_cast<int>(stats.dropped);
+    result.backpressureMs = stats.backpressureMs;
+    result.stages = stats.stages;
+    camera.finish(result);
+    return result;
+}
+
+} // namespace
+
+FramePipelineBenchmarkResults runFramePipelineBenchmark(const FramePipelineBenchmarkConfig& config) {
+    FramePipelineBenchmarkResults results;
+    results.frameIntervalMs = 1000.0 / config.fps;
+
+    results.rows.push_back(runSynchronous(config));
+    for (int depth : config.depths) {
+        results.rows.push_back(runPipelined(config, depth, FrameDropPolicy::DropOldest));
+    }
+    for (int depth : config.depths) {
+        results.rows.push_back(runPipelined(config, depth, FrameDropPolicy::Block));
+    }
+    return results;
+}
+
+void printFramePipelineBenchmark(const FramePipelineBenchmarkResults& results) {
+    std::cout << "\n=== Pipeline capture -> filtre -> sortie (tick " << std::fixed << std::setprecision(1)
+              << results.frameIntervalMs << " ms) ===" << std::endl;
+    // Largeurs des en-têtes accentués : +1 octet par caractère UTF-8 accentué
+    std::cout << std::left << std::setw(21) << "scénario" << std::right << std::setw(6) << "vol"
+              << std::setw(11) << "livrées" << std::setw(10) << "perdues" << std::setw(10) << "drop"
+              << std::setw(10) << "lat moy" << std::setw(10) << "lat max" << std::setw(11) << "écart max"
+              << std::setw(10) << "attente" << "  intègre" << std::endl;
+    for (const auto& r : results.rows) {
+        std::cout << std::left << std::setw(20 + (r.label.find("ç") != std::string::npos ? 1 : 0)) << r.label
+                  << std::right << std::setw(6) << r.depth
+                  << std::setw(10) << r.delivered << std::setw(10) << (r.captureDrops + r.rejected)
+                  << std::setw(10) << r.pipelineDrops << std::setprecision(1)
+                  << std::setw(10) << r.meanLatencyMs << std::setw(10) << r.maxLatencyMs
+                  << std::setw(10) << r.maxGapMs << std::setw(10) << r.backpressureMs
+                  << "  " << (r.intact ? "oui" : "NON") << std::endl;
+        for (const auto& s : r.stages) {
+            std::cout << "    " << std::left << std::setw(8) << s.name << std::right << std::setprecision(2)
+                      << s.frames << " images, " << s.meanMs << " ms moy / " << s.maxMs << " max, file "
+                      << s.meanWaitMs << " ms moy / " << s.maxWaitMs << " max" << std::endl;
+        }
+    }
+}
+
+} // namespace Camera
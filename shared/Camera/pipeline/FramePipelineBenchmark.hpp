@@ -0,0 +1,51 @@
+#pragma once
+
+#include "FramePipeline.hpp"
+#include <string>
+#include <vector>
+
+namespace Camera {
+
+struct FramePipelineBenchmarkResult {
+    std::string label;              // "synchrone", "aperçu drop-oldest", "enregistrement"
+    int depth{0};                   // images en vol (0 : traitement dans le callback)
+    int captured{0};                // ticks du capteur
+    int delivered{0};               // images sorties de la dernière étape
+    int captureDrops{0};            // callback encore occupé ou buffer capteur indisponible
+    int pipelineDrops{0};           // remplacées dans le pipeline (DropOldest)
+    int rejected{0};
+    double meanLatencyMs{0.0};      // capture -> fin de la dernière étape
+    double maxLatencyMs{0.0};
+    double maxGapMs{0.0};           // plus grand écart entre deux images livrées
+    double backpressureMs{0.0};
+    bool intact{true};              // ordre croissant, contenu du buffer non réécrit en vol
+    std::vector<PipelineStageStats> stages;
+};
+
+struct FramePipelineBenchmarkConfig {
+    int width = 1280;
+    int height = 720;
+    double fps = 30.0;
+    int frames = 150;               // ticks du capteur par scénario
+    double filterMs = 20.0;         // coût du filtre
+    double filterSpikeMs = 55.0;    // une image sur spikeEvery
+    int spikeEvery = 10;
+    double outputMs = 12.0;         // encodage / affichage
+    int captureBuffers = 6;         // buffers du capteur (pool de la session de capture)
+    std::vector<int> depths = {2, 3, 4};
+};
+
+struct FramePipelineBenchmarkResults {
+    double frameIntervalMs{0.0};
+    std::vector<FramePipelineBenchmarkResult> rows;
+};
+
+// Capteur synthétique cadencé à fps : chaque tick estampille un buffer BGRA (numéro d'image) et
+// appelle le callback. "synchrone" filtre et encode dans le callback, comme l'enregistreur filtré
+// iOS (un tick manqué pendant le traitement est perdu). Les autres scénarios passent par
+// FramePipeline : drop-oldest comme l'aperçu (NaayaPreviewView), contre-pression pour l'enregistrement.
+// Coûts des étapes simulés par attente (GPU, encodeur matériel).
+FramePipelineBenchmarkResults runFramePipelineBenchmark(const FramePipelineBenchmarkConfig& config = {});
+void printFramePipelineBenchmark(const FramePipelineBenchmarkResults& results);
+
+} // namespace Camera
@@ -0,0 +1,314 @@
+#include "FramePool.hpp"
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+namespace Camera {
+
+namespace {
+
+constexpr size_t alignUp(size_t value) {
+    return (value + FrameLayout::kAlignment - 1) & ~(FrameLayout::kAlignment - 1);
+}
+
+const char* formatName(FrameFormat format) {
+    switch (format) {
+        case FrameFormat::BGRA: return "BGRA";
+        case FrameFormat::NV12: return "NV12";
+        case FrameFormat::I420: return "I420";
+        case FrameFormat::P010: return "P010";
+        case FrameFormat::Bytes: return "octets";
+    }
+    return "?";
+}
+
+} // namespace
+
+// FrameLayout
+
+FrameLayout FrameLayout::make(FrameFormat format, int width, int height) {
+    FrameLayout layout;
+    if (width <= 0 || height <= 0) {
+        return layout;
+    }
+    if (format == FrameFormat::Bytes) {
+        return forBytes(static_cast<size_t>(width) * height);
+    }
+    layout.format = format;
+    layout.width = width;
+    layout.height = height;
+
+    const size_t w = static_cast<size_t>(width);
+    const size_t cw = (w + 1) / 2;
+    const int ch = (height + 1) / 2;
+    auto addPlane = [&layout](size_t rowBytes, int rows) {
+        const int i = layout.planes++;
+        layout.offset[i] = layout.bytes;
+        layout.stride[i] = alignUp(rowBytes);
+        layout.rows[i] = rows;
+        layout.bytes += layout.stride[i] * static_cast<size_t>(rows);
+    };
+    switch (format) {
+        case FrameFormat::BGRA:
+            addPlane(w * 4, height);
+            break;
+        case FrameFormat::NV12:
+            addPlane(w, height);
+            addPlane(cw * 2, ch);
+            break;
+        case FrameFormat::I420:
+            addPlane(w, height);
+            addPlane(cw, ch);
+            addPlane(cw, ch);
+            break;
+        case FrameFormat::P010:
+            addPlane(w * 2, height);
+            addPlane(cw * 4, ch);
+            break;
+        case FrameFormat::Bytes:
+            break;
+    }
+    return layout;
+}
+
+FrameLayout FrameLayout::forBytes(size_t bytes) {
+    FrameLayout layout;
+    if (bytes == 0) {
+        return layout;
+    }
+    layout.format = FrameFormat::Bytes;
+    layout.width = static_cast<int>(std::min<size_t>(bytes, INT32_MAX));
+    layout.height = 1;
+    layout.planes = 1;
+    layout.stride[0] = bytes;
+    layout.rows[0] = 1;
+    layout.bytes = bytes;
+    return layout;
+}
+
+bool FrameLayout::operator==(const FrameLayout& other) const {
+    return format == other.format && width == other.width && height == other.height && bytes == other.bytes;
+}
+
+// État partagé : détruit avec la dernière image rendue ou avec le pool, le plus tard des deux
+
+struct FramePoolState {
+    FramePoolConfig config;
+    size_t allocBytes{0};
+    std::unique_ptr<FramePoolSlot[]> slots;
+
+    alignas(64) std::atomic<uint64_t> freeHead{0};  // étiquette << 32 | (index + 1)
+    std::atomic<int> claimed{0};                    // emplacements dotés d'une image
+    std::atomic<uint32_t> refs{1};                  // pool + images dehors
+
+    std::atomic<int> inUse{0};
+    std::atomic<int> highWater{0};
+    std::atomic<uint64_t> acquired{0};
+    std::atomic<uint64_t> exhausted{0};
+
+    explicit FramePoolState(const FramePoolConfig& cfg)
+        : config(cfg),
+          allocBytes(alignUp(std::max<size_t>(1, cfg.layout.bytes))),
+          slots(new FramePoolSlot[static_cast<size_t>(std::max(1, cfg.capacity))]) {
+        config.capacity = std::max(1, config.capacity);
+        for (int i = 0; i < config.capacity; ++i) {
+            slots[i].state = this;
+        }
+    }
+
+    ~FramePoolState() {
+        const int count = std::min(claimed.load(std::memory_order_acquire), config.capacity);
+        for (int i = 0; i < count; ++i) {
+            if (slots[i].data) {
+                ::operator delete(slots[i].data, std::align_val_t(FrameLayout::kAlignment));
+            }
+        }
+    }
+
+    FramePoolSlot* pop() {
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t index = static_cast<uint32_t>(head);
+            if (index == 0) {
+                return nullptr;
+            }
+            FramePoolSlot* slot = &slots[index - 1];
+            const uint32_t next = slot->next.load(std::memory_order_relaxed);
+            // Étiquette incrémentée à chaque changement de tête : pas d'ABA
+            const uint64_t desired = (((head >> 32) + 1) << 32) | next;
+            if (freeHead.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire)) {
+                return slot;
+            }
+        }
+    }
+
+    void push(FramePoolSlot* slot) {
+        const uint32_t index = static_cast<uint32_t>(slot - slots.get()) + 1;
+        uint64_t head = freeHead.load(std::memory_order_relaxed);
+        for (;;) {
+            slot->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            const uint64_t desired = (((head >> 32) + 1) << 32) | index;
+            if (freeHead.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    // Nouvelle image tant que capacity n'est pas atteinte
+    FramePoolSlot* grow() {
+        int index = claimed.load(std::memory_order_relaxed);
+        do {
+            if (index >= config.capacity) {
+                return nullptr;
+            }
+        } while (!claimed.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+        FramePoolSlot* slot = &slots[index];
+        try {
+            slot->data = static_cast<uint8_t*>(::operator new(allocBytes, std::align_val_t(FrameLayout::kAlignment)));
+        } catch (const std::bad_alloc&) {
+            std::cout << "[FramePool] " << config.name << " : allocation impossible (" << allocBytes << " octets)" << std::endl;
+            return nullptr;
+        }
+        return slot;
+    }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
+// FrameRef
+
+FrameRef::FrameRef(const FrameRef& other) noexcept : slot_(other.slot_) {
+    if (slot_) slot_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameRef& FrameRef::operator=(const FrameRef& other) noexcept {
+    if (slot_ != other.slot_) {
+        if (other.slot_) other.slot_->refs.fetch_add(1, std::memory_order_relaxed);
+        reset();
+        slot_ = other.slot_;
+    }
+    return *this;
+}
+
+FrameRef& FrameRef::operator=(FrameRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        slot_ = other.slot_;
+        other.slot_ = nullptr;
+    }
+    return *this;
+}
+
+void FrameRef::reset() noexcept {
+    FramePoolSlot* slot = slot_;
+    slot_ = nullptr;
+    if (!slot || slot->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    // Dernière référence : l'image retourne sur la pile libre
+    FramePoolState* state = slot->state;
+    state->inUse.fetch_sub(1, std::memory_order_relaxed);
+    state->push(slot);
+    state->release();
+}
+
+uint8_t* FrameRef::plane(int index) const {
+    if (!slot_ || index < 0 || index >= slot_->state->config.layout.planes) {
+        return nullptr;
+    }
+    return slot_->data + slot_->state->config.layout.offset[index];
+}
+
+size_t FrameRef::stride(int index) const {
+    if (!slot_ || index < 0 || index >= slot_->state->config.layout.planes) {
+        return 0;
+    }
+    return slot_->state->config.layout.stride[index];
+}
+
+size_t FrameRef::size() const {
+    return slot_ ? slot_->state->config.layout.bytes : 0;
+}
+
+const FrameLayout& FrameRef::layout() const {
+    static const FrameLayout empty;
+    return slot_ ? slot_->state->config.layout : empty;
+}
+
+// FramePool
+
+FramePool::FramePool(const FramePoolConfig& config)
+    : state_(new FramePoolState(config)) {
+    if (state_->config.preallocate && state_->config.layout.valid()) {
+        while (FramePoolSlot* slot = state_->grow()) {
+            state_->push(slot);
+        }
+    }
+    std::cout << "[FramePool] " << state_->config.name << " : " << formatName(state_->config.layout.format) << " "
+              << state_->config.layout.width << "x" << state_->config.layout.height << ", "
+              << state_->config.capacity << " images de " << state_->allocBytes << " octets" << std::endl;
+}
+
+FramePool::~FramePool() {
+    const FramePoolStats stats = getStats();
+    if (stats.inUse > 0) {
+        // Images encore dehors : l'état partagé est libéré avec la dernière
+        std::cout << "[FramePool] " << state_->config.name << " : " << stats.inUse
+                  << " images encore utilisées à la destruction" << std::endl;
+    }
+    state_->release();
+}
+
+FrameRef FramePool::acquire() {
+    FramePoolState& s = *state_;
+    if (!s.config.layout.valid()) {
+        return FrameRef();
+    }
+    FramePoolSlot* slot = s.pop();
+    if (!slot) {
+        slot = s.grow();
+    }
+    if (!slot) {
+        s.exhausted.fetch_add(1, std::memory_order_relaxed);
+        return FrameRef();
+    }
+    slot->refs.store(1, std::memory_order_relaxed);
+    s.refs.fetch_add(1, std::memory_order_relaxed);
+    s.acquired.fetch_add(1, std::memory_order_relaxed);
+    const int inUse = s.inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    int high = s.highWater.load(std::memory_order_relaxed);
+    while (inUse > high && !s.highWater.compare_exchange_weak(high, inUse, std::memory_order_relaxed)) {
+    }
+    return FrameRef(slot);
+}
+
+const FrameLayout& FramePool::layout() const {
+    return state_->config.layout;
+}
+
+FramePoolStats FramePool::getStats() const {
+    const FramePoolState& s = *state_;
+    FramePoolStats stats;
+    stats.frameBytes = s.allocBytes;
+    stats.capacity = s.config.capacity;
+    stats.allocated = std::min(s.claimed.load(std::memory_order_relaxed), s.config.capacity);
+    stats.inUse = s.inUse.load(std::memory_order_relaxed);
+    stats.highWater = s.highWater.load(std::memory_order_relaxed);
+    stats.allocatedBytes = static_cast<size_t>(stats.allocated) * s.allocBytes;
+    stats.highWaterBytes = static_cast<size_t>(stats.highWater) * s.allocBytes;
+    stats.acquired = s.acquired.load(std::memory_order_relaxed);
+    stats.exhausted = s.exhausted.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void FramePool::resetStats() {
+    state_->acquired.store(0, std::memory_order_relaxed);
+    state_->exhausted.store(0, std::memory_order_relaxed);
+    state_->highWater.store(state_->inUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace Camera
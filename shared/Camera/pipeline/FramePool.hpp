@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Camera {
+
+enum class FrameFormat : uint8_t {
+    BGRA,       // 1 plan, 4 octets/pixel
+    NV12,       // Y + UV entrelacés, 4:2:0
+    I420,       // Y + U + V, 4:2:0
+    P010,       // NV12 sur 16 bits (10 bits utiles, poids fort)
+    Bytes,      // buffer opaque d'un plan (taille connue en octets seulement)
+};
+
+// Géométrie d'une image : plans et strides alignés sur 64 octets
+struct FrameLayout {
+    static constexpr int kMaxPlanes = 3;
+    static constexpr size_t kAlignment = 64;
+
+    FrameFormat format{FrameFormat::BGRA};
+    int width{0};
+    int height{0};
+    int planes{0};
+    size_t offset[kMaxPlanes]{};
+    size_t stride[kMaxPlanes]{};
+    int rows[kMaxPlanes]{};
+    size_t bytes{0};
+
+    static FrameLayout make(FrameFormat format, int width, int height);
+    static FrameLayout forBytes(size_t bytes);
+    bool valid() const { return bytes > 0; }
+    bool operator==(const FrameLayout& other) const;
+    bool operator!=(const FrameLayout& other) const { return !(*this == other); }
+};
+
+struct FramePoolState;
+
+// Emplacement d'image du pool (interne)
+struct FramePoolSlot {
+    uint8_t* data{nullptr};
+    FramePoolState* state{nullptr};
+    std::atomic<uint32_t> refs{0};
+    std::atomic<uint32_t> next{0};      // pile libre : index + 1, 0 = fin
+};
+
+/**
+ * Référence comptée sur une image du pool
+ * La dernière référence rend l'image au pool (aucune libération mémoire). Copiable entre
+ * threads; une image survit au pool qui l'a produite.
+ */
+class FrameRef {
+public:
+    FrameRef() = default;
+    FrameRef(const FrameRef& other) noexcept;
+    FrameRef(FrameRef&& other) noexcept : slot_(other.slot_) { other.slot_ = nullptr; }
+    FrameRef& operator=(const FrameRef& other) noexcept;
+    FrameRef& operator=(FrameRef&& other) noexcept;
+    ~FrameRef() { reset(); }
+
+    void reset() noexcept;
+    explicit operator bool() const { return slot_ != nullptr; }
+
+    uint8_t* data() const { return slot_ ? slot_->data : nullptr; }
+    uint8_t* plane(int index) const;
+    size_t stride(int index) const;
+    size_t size() const;
+    const FrameLayout& layout() const;
+    uint32_t useCount() const { return slot_ ? slot_->refs.load(std::memory_order_acquire) : 0; }
+
+private:
+    friend class FramePool;
+    explicit FrameRef(FramePoolSlot* slot) : slot_(slot) {}
+    FramePoolSlot* slot_{nullptr};
+};
+
+struct FramePoolConfig {
+    std::string name = "frames";
+    FrameLayout layout;
+    int capacity = 4;               // images au plus (au-delà : acquire vide, compté dans exhausted)
+    bool preallocate = true;        // sinon allocation à la première demande, jusqu'à capacity
+};
+
+struct FramePoolStats {
+    size_t frameBytes{0};
+    int capacity{0};
+    int allocated{0};               // images créées (jamais libérées avant la fin du pool)
+    int inUse{0};
+    int highWater{0};               // images sorties simultanément au plus
+    size_t allocatedBytes{0};
+    size_t highWaterBytes{0};
+    uint64_t acquired{0};
+    uint64_t exhausted{0};          // demandes refusées, pool plein
+};
+
+/**
+ * Pool d'images à géométrie fixe (BGRA, NV12, I420, P010 ou octets bruts)
+ * acquire() prend une image libre sur une pile sans verrou; une géométrie différente demande un
+ * autre pool. Épuisement signalé (référence vide + exhausted) plutôt qu'une allocation cachée.
+ */
+class FramePool {
+public:
+    explicit FramePool(const FramePoolConfig& config);
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // Référence vide si les capacity images sont dehors
+    FrameRef acquire();
+
+    const FrameLayout& layout() const;
+    FramePoolStats getStats() const;
+    void resetStats();
+
+private:
+    FramePoolState* state_{nullptr};
+};
+
+} // namespace Camera
@@ -0,0 +1,483 @@
+#include "TaskScheduler.hpp"
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace Common {
+
+namespace {
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Recherches de tâche avant de s'endormir (workers et threads en attente d'un groupe)
+constexpr int kSpinIterations = 256;
+
+constexpr size_t kDequeMask = TaskScheduler::kDequeCapacity - 1;
+constexpr size_t kInjectMask = TaskScheduler::kInjectCapacity - 1;
+static_assert((TaskScheduler::kDequeCapacity & kDequeMask) == 0, "capacité de deque : puissance de 2");
+static_assert((TaskScheduler::kInjectCapacity & kInjectMask) == 0, "capacité d'injection : puissance de 2");
+
+// Worker courant (nullptr hors worker)
+struct WorkerContext {
+    const TaskScheduler* scheduler{nullptr};
+    size_t index{0};
+};
+thread_local WorkerContext tlsWorker;
+
+// Point de départ des vols hors worker
+thread_local uint32_t tlsStealSeed = 0x9E3779B9u;
+
+inline uint32_t nextSeed() noexcept {
+    uint32_t x = tlsStealSeed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    tlsStealSeed = x;
+    return x;
+}
+} // namespace
+
+// WorkDeque
+
+bool TaskScheduler::WorkDeque::push(Node* node) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t >= static_cast<int64_t>(kDequeCapacity)) {
+        return false;
+    }
+    buffer_[static_cast<size_t>(b) & kDequeMask].store(node, std::memory_order_relaxed);
+    // Publie le contenu du nœud avec la case
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+TaskScheduler::Node* TaskScheduler::WorkDeque::pop() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Node* node = buffer_[static_cast<size_t>(b) & kDequeMask].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Dernier élément : course avec les voleurs
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            node = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+TaskScheduler::Node* TaskScheduler::WorkDeque::steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+        return nullptr;
+    }
+    Node* node = buffer_[static_cast<size_t>(t) & kDequeMask].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return node;
+}
+
+bool TaskScheduler::WorkDeque::empty() const {
+    return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+}
+
+// InjectQueue
+
+TaskScheduler::InjectQueue::InjectQueue() {
+    for (size_t i = 0; i < kInjectCapacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool TaskScheduler::InjectQueue::push(Node* node) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & kInjectMask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false;                   // pleine
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->node = node;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+TaskScheduler::Node* TaskScheduler::InjectQueue::pop() {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & kInjectMask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return nullptr;                 // vide
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+    Node* node = cell->node;
+    cell->sequence.store(pos + kInjectCapacity, std::memory_order_release);
+    return node;
+}
+
+// TaskScheduler
+
+TaskScheduler::TaskScheduler(size_t workers)
+    : nodes_(new Node[kNodeCapacity]) {
+    if (workers == 0) {
+        workers = recommendedWorkers();
+    }
+
+    // Pile libre : nœud i -> i + 1
+    for (size_t i = 0; i < kNodeCapacity; ++i) {
+        nodes_[i].next.store(i + 1 < kNodeCapacity ? static_cast<uint32_t>(i + 2) : 0, std::memory_order_relaxed);
+    }
+    freeHead_.store(1, std::memory_order_relaxed);
+
+    state_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        state_.push_back(std::make_unique<Worker>());
+    }
+    active_.store(workers, std::memory_order_relaxed);
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+    std::cout << "[TaskScheduler] " << workers << " workers" << std::endl;
+}
+
+TaskScheduler::~TaskScheduler() {
+    stop_.store(true, std::memory_order_seq_cst);
+    workEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    workEpoch_.notify_all();
+    parkEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    parkEpoch_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+
+    // Tâches détachées restantes : exécutées pour libérer ce qu'elles capturent
+    bool stolen = false;
+    while (Node* node = findTask(kTaskPriorityCount - 1, stolen)) {
+        execute(node);
+    }
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+size_t TaskScheduler::recommendedWorkers(size_t maxWorkers) {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, std::min<size_t>(maxWorkers, hw > 1 ? hw - 1 : 1));
+}
+
+void TaskScheduler::setActiveWorkers(size_t count) {
+    count = std::max<size_t>(1, std::min(count, workers_.size()));
+    if (active_.exchange(count, std::memory_order_seq_cst) == count) {
+        return;
+    }
+    parkEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    parkEpoch_.notify_all();
+}
+
+TaskScheduler::Node* TaskScheduler::acquireNode() {
+    uint64_t head = freeHead_.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t slot = static_cast<uint32_t>(head);
+        if (slot == 0) {
+            return nullptr;
+        }
+        Node* node = &nodes_[slot - 1];
+        const uint32_t next = node->next.load(std::memory_order_relaxed);
+        // Étiquette incrémentée à chaque changement de tête : pas d'ABA
+        const uint64_t desired = (((head >> 32) + 1) << 32) | next;
+        if (freeHead_.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire)) {
+            const size_t inUse = nodesInUse_.fetch_add(1, std::memory_order_relaxed) + 1;
+            size_t high = nodesHighWater_.load(std::memory_order_relaxed);
+            while (inUse > high && !nodesHighWater_.compare_exchange_weak(high, inUse, std::memory_order_relaxed)) {
+            }
+            return node;
+        }
+    }
+}
+
+void TaskScheduler::releaseNode(Node* node) {
+    const uint32_t slot = static_cast<uint32_t>(node - nodes_.get()) + 1;
+    nodesInUse_.fetch_sub(1, std::memory_order_relaxed);
+    uint64_t head = freeHead_.load(std::memory_order_relaxed);
+    for (;;) {
+        node->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        const uint64_t desired = (((head >> 32) + 1) << 32) | slot;
+        if (freeHead_.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+void TaskScheduler::enqueue(Node* node) {
+    const size_t priority = static_cast<size_t>(node->priority);
+    bool queued = false;
+    if (tlsWorker.scheduler == this) {
+        queued = state_[tlsWorker.index]->deques[priority].push(node);
+    }
+    if (!queued) {
+        queued = inject_[priority].push(node);
+        if (queued) injected_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!queued) {
+        // Files pleines : exécution immédiate plutôt qu'une allocation
+        inlineRuns_.fetch_add(1, std::memory_order_relaxed);
+        execute(node);
+        return;
+    }
+    wake();
+}
+
+void TaskScheduler::wake() {
+    workEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        workEpoch_.notify_one();
+    }
+}
+
+void TaskScheduler::execute(Node* node) {
+    const size_t priority = static_cast<size_t>(node->priority);
+    TaskGroup* group = node->group;
+    try {
+        node->invoke(node->storage);
+    } catch (...) {
+        failedTasks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    releaseNode(node);
+    countExecuted(priority);
+    finish(group);
+}
+
+void TaskScheduler::countExecuted(size_t priority) {
+    if (tlsWorker.scheduler == this) {
+        state_[tlsWorker.index]->executed[priority].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        helped_[priority].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void TaskScheduler::finish(TaskGroup* group) {
+    if (!group) {
+        return;
+    }
+    // Après le dernier décrément, le groupe peut être détruit par son attente : plus d'accès
+    if (group->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        doneEpoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            doneEpoch_.notify_all();
+        }
+    }
+}
+
+bool TaskScheduler::localWork(TaskPriority priority) const {
+    if (tlsWorker.scheduler != this) {
+        return false;
+    }
+    return !state_[tlsWorker.index]->deques[static_cast<size_t>(priority)].empty();
+}
+
+TaskScheduler::Node* TaskScheduler::findTask(size_t maxPriority, bool& stolen) {
+    stolen = false;
+    Worker* self = tlsWorker.scheduler == this ? state_[tlsWorker.index].get() : nullptr;
+    const size_t count = state_.size();
+    const size_t start = self ? tlsWorker.index + 1 : nextSeed();
+
+    for (size_t p = 0; p <= maxPriority && p < kTaskPriorityCount; ++p) {
+        if (self) {
+            if (Node* node = self->deques[p].pop()) return node;
+        }
+        if (Node* node = inject_[p].pop()) return node;
+        for (size_t k = 0; k < count; ++k) {
+            Worker* victim = state_[(start + k) % count].get();
+            if (victim == self) continue;
+            if (Node* node = victim->deques[p].steal()) {
+                stolen = true;
+                return node;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::wait(TaskGroup& group) {
+    const size_t maxPriority = static_cast<size_t>(group.priority());
+    Worker* self = tlsWorker.scheduler == this ? state_[tlsWorker.index].get() : nullptr;
+    int idle = 0;
+    while (!group.done()) {
+        // L'appelant aide : tâches au moins aussi prioritaires que le groupe
+        bool stolen = false;
+        if (Node* node = findTask(maxPriority, stolen)) {
+            if (stolen && self) self->steals.fetch_add(1, std::memory_order_relaxed);
+            execute(node);
+            idle = 0;
+            continue;
+        }
+        if (++idle < kSpinIterations) {
+            cpuRelax();
+            continue;
+        }
+        // Tâches restantes en cours ailleurs : attente de la fin d'un groupe
+        idle = 0;
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t epoch = doneEpoch_.load(std::memory_order_seq_cst);
+        if (!group.done()) {
+            doneEpoch_.wait(epoch, std::memory_order_seq_cst);
+        }
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+void TaskScheduler::runParallelFor(size_t count, size_t grain, TaskPriority priority,
+                                   void (*fn)(void*, size_t, size_t), void* context) {
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = std::max<size_t>(1, count / (concurrency() * kChunksPerThread));
+    }
+    if (count <= grain) {
+        fn(context, 0, count);
+        return;
+    }
+    TaskGroup group(priority);
+    ForJob job{fn, context, grain, &group};
+    runRange(&job, 0, count);
+    wait(group);
+}
+
+void TaskScheduler::runRange(ForJob* job, size_t begin, size_t end) {
+    const TaskPriority priority = job->group->priority();
+    while (end - begin > job->grain) {
+        if (localWork(priority)) {
+            // Moitiés déjà publiées non volées : pas de découpage supplémentaire
+            job->fn(job->context, begin, begin + job->grain);
+            begin += job->grain;
+            continue;
+        }
+        const size_t mid = begin + (end - begin) / 2;
+        submit(*job->group, [this, job, mid, end] { runRange(job, mid, end); });
+        end = mid;
+    }
+    job->fn(job->context, begin, end);
+}
+
+void TaskScheduler::workerLoop(size_t index) {
+    tlsWorker.scheduler = this;
+    tlsWorker.index = index;
+    tlsStealSeed = static_cast<uint32_t>(index * 2654435761u + 1);
+    Worker& self = *state_[index];
+    int idle = 0;
+
+    while (!stop_.load(std::memory_order_acquire)) {
+        // Mis en réserve par setActiveWorkers : les autres peuvent voler sa deque
+        const uint32_t park = parkEpoch_.load(std::memory_order_seq_cst);
+        if (index >= active_.load(std::memory_order_seq_cst)) {
+            self.sleeps.fetch_add(1, std::memory_order_relaxed);
+            parkEpoch_.wait(park, std::memory_order_seq_cst);
+            continue;
+        }
+
+        bool stolen = false;
+        if (Node* node = findTask(kTaskPriorityCount - 1, stolen)) {
+            if (stolen) self.steals.fetch_add(1, std::memory_order_relaxed);
+            execute(node);
+            idle = 0;
+            continue;
+        }
+        if (++idle < kSpinIterations) {
+            cpuRelax();
+            continue;
+        }
+        idle = 0;
+
+        // Déclaré endormi avant la dernière recherche : une soumission ultérieure réveille
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t epoch = workEpoch_.load(std::memory_order_seq_cst);
+        Node* node = findTask(kTaskPriorityCount - 1, stolen);
+        if (!node && !stop_.load(std::memory_order_seq_cst)) {
+            self.sleeps.fetch_add(1, std::memory_order_relaxed);
+            workEpoch_.wait(epoch, std::memory_order_seq_cst);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+        if (node) {
+            if (stolen) self.steals.fetch_add(1, std::memory_order_relaxed);
+            execute(node);
+        }
+    }
+    tlsWorker = WorkerContext{};
+}
+
+TaskSchedulerStats TaskScheduler::getStats() const {
+    TaskSchedulerStats stats;
+    stats.workers = workers_.size();
+    stats.activeWorkers = activeWorkers();
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.injected = injected_.load(std::memory_order_relaxed);
+    stats.inlineRuns = inlineRuns_.load(std::memory_order_relaxed);
+    stats.failedTasks = failedTasks_.load(std::memory_order_relaxed);
+    for (size_t p = 0; p < kTaskPriorityCount; ++p) {
+        const uint64_t helped = helped_[p].load(std::memory_order_relaxed);
+        stats.helped += helped;
+        stats.executedByPriority[p] += helped;
+    }
+    for (const auto& worker : state_) {
+        for (size_t p = 0; p < kTaskPriorityCount; ++p) {
+            stats.executedByPriority[p] += worker->executed[p].load(std::memory_order_relaxed);
+        }
+        stats.steals += worker->steals.load(std::memory_order_relaxed);
+        stats.sleeps += worker->sleeps.load(std::memory_order_relaxed);
+    }
+    for (size_t p = 0; p < kTaskPriorityCount; ++p) {
+        stats.executed += stats.executedByPriority[p];
+    }
+    stats.nodesInUse = nodesInUse_.load(std::memory_order_relaxed);
+    stats.nodesHighWater = nodesHighWater_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TaskScheduler::resetStats() {
+    submitted_.store(0, std::memory_order_relaxed);
+    injected_.store(0, std::memory_order_relaxed);
+    inlineRuns_.store(0, std::memory_order_relaxed);
+    failedTasks_.store(0, std::memory_order_relaxed);
+    for (auto& helped : helped_) helped.store(0, std::memory_order_relaxed);
+    for (auto& worker : state_) {
+        for (auto& executed : worker->executed) executed.store(0, std::memory_order_relaxed);
+        worker->steals.store(0, std::memory_order_relaxed);
+        worker->sleeps.store(0, std::memory_order_relaxed);
+    }
+    nodesHighWater_.store(nodesInUse_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace Common
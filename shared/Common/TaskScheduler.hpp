@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Common {
+
+// Ordre de service : un worker prend toujours la tâche la plus prioritaire disponible
+// (deque locale, file d'injection puis vol), à priorité égale la plus récente en local.
+enum class TaskPriority : uint8_t {
+    Preview = 0,        // images affichées : latence
+    Recording = 1,      // encodage, enregistrement
+    Background = 2,     // miniatures, formes d'onde, spectrogrammes
+};
+
+constexpr size_t kTaskPriorityCount = 3;
+
+// Zone d'image traitée par une tâche de parallelForTiles : [x0, x1) x [y0, y1)
+struct TileRect {
+    int x0{0};
+    int y0{0};
+    int x1{0};
+    int y1{0};
+};
+
+struct TaskSchedulerStats {
+    size_t workers{0};
+    size_t activeWorkers{0};
+    uint64_t submitted{0};
+    uint64_t executed{0};
+    uint64_t executedByPriority[kTaskPriorityCount]{};
+    uint64_t steals{0};             // tâches prises dans la deque d'un autre worker
+    uint64_t injected{0};           // soumises hors worker (file d'injection)
+    uint64_t inlineRuns{0};         // nœuds ou files épuisés : exécutées par l'appelant (incluses dans executed)
+    uint64_t helped{0};             // exécutées par un thread en attente d'un groupe
+    uint64_t sleeps{0};
+    uint64_t failedTasks{0};        // exception sortie d'une tâche
+    size_t nodesInUse{0};
+    size_t nodesHighWater{0};
+};
+
+class TaskScheduler;
+
+// Ensemble de tâches attendues ensemble (wait). Ses tâches sont servies à sa priorité.
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPriority priority = TaskPriority::Preview) : priority_(priority) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    TaskPriority priority() const { return priority_; }
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class TaskScheduler;
+    std::atomic<uint32_t> pending_{0};
+    TaskPriority priority_;
+};
+
+/**
+ * Ordonnanceur à vol de travail partagé (image et audio)
+ *
+ * Un nombre fixe de workers, chacun avec une deque Chase-Lev par priorité : le propriétaire
+ * empile et dépile en bas, les autres volent en haut. Les soumissions hors worker passent par
+ * une file d'injection bornée (MPMC) par priorité. Les tâches sont construites en place dans
+ * des nœuds préalloués (callable de kTaskStorage octets au plus, vérifié à la compilation) :
+ * submit, parallelFor et wait n'allouent pas et ne prennent aucun verrou. Nœuds ou files
+ * épuisés : la tâche s'exécute dans le thread appelant.
+ *
+ * wait(group) fait travailler l'appelant sur les tâches de priorité au moins égale à celle du
+ * groupe, puis s'endort. Les workers au-delà de setActiveWorkers restent endormis (les threads
+ * ne sont jamais recréés).
+ */
+class TaskScheduler {
+public:
+    static constexpr size_t kTaskStorage = 64;
+    static constexpr size_t kDequeCapacity = 512;       // par worker et par priorité
+    static constexpr size_t kInjectCapacity = 1024;     // par priorité
+    static constexpr size_t kNodeCapacity = 2048;
+    static constexpr size_t kChunksPerThread = 4;       // grain automatique de parallelFor
+    static constexpr int kDefaultTileWidth = 256;
+    static constexpr int kDefaultTileHeight = 64;
+
+    // workers : threads créés en plus des appelants (0 : recommendedWorkers())
+    explicit TaskScheduler(size_t workers = 0);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Instance partagée par la caméra, les filtres et l'audio hors temps réel
+    static TaskScheduler& shared();
+    // Cœurs - 1 (l'appelant participe), borné
+    static size_t recommendedWorkers(size_t maxWorkers = 7);
+
+    size_t workerCount() const { return workers_.size(); }
+    // Workers autorisés à prendre des tâches (1..workerCount), sans recréer de thread
+    void setActiveWorkers(size_t count);
+    size_t activeWorkers() const { return active_.load(std::memory_order_relaxed); }
+    // Threads qui exécutent un parallelFor : workers actifs + appelant
+    size_t concurrency() const { return activeWorkers() + 1; }
+
+    // Tâche du groupe (attendue par wait) ou tâche détachée
+    template <typename F>
+    void submit(TaskGroup& group, F&& fn) {
+        submitTo(&group, group.priority(), std::forward<F>(fn));
+    }
+    template <typename F>
+    void submit(TaskPriority priority, F&& fn) {
+        submitTo(nullptr, priority, std::forward<F>(fn));
+    }
+
+    // Rend la main quand toutes les tâches du groupe sont terminées
+    void wait(TaskGroup& group);
+
+    // fn(begin, end) sur des plages de [0, count); grain 0 : count / (concurrency * kChunksPerThread).
+    // Découpage binaire paresseux : tant que la plage dépasse le grain, sa moitié haute est publiée
+    // si la deque locale est vide (des voleurs l'ont vidée), sinon un grain est traité sur place.
+    // Le découpage suit donc la charge réelle des workers. L'appelant participe.
+    template <typename F>
+    void parallelFor(size_t count, F&& fn, TaskPriority priority = TaskPriority::Preview, size_t grain = 0) {
+        using Fn = std::remove_reference_t<F>;
+        runParallelFor(count, grain, priority,
+                       [](void* ctx, size_t b, size_t e) { (*static_cast<Fn*>(ctx))(b, e); },
+                       const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+    }
+
+    // fn(const TileRect&) sur les tuiles d'une image width x height (0 : tuiles par défaut),
+    // tuiles numérotées ligne par ligne : une plage contiguë couvre des tuiles voisines
+    template <typename F>
+    void parallelForTiles(int width, int height, F&& fn, TaskPriority priority = TaskPriority::Preview,
+                          int tileWidth = 0, int tileHeight = 0) {
+        if (width <= 0 || height <= 0) return;
+        const int tw = tileWidth > 0 ? std::min(tileWidth, width) : std::min(kDefaultTileWidth, width);
+        const int th = tileHeight > 0 ? std::min(tileHeight, height) : std::min(kDefaultTileHeight, height);
+        const size_t tilesX = static_cast<size_t>((width + tw - 1) / tw);
+        const size_t tilesY = static_cast<size_t>((height + th - 1) / th);
+        auto range = [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                TileRect tile;
+                tile.x0 = static_cast<int>(i % tilesX) * tw;
+                tile.y0 = static_cast<int>(i / tilesX) * th;
+                tile.x1 = std::min(tile.x0 + tw, width);
+                tile.y1 = std::min(tile.y0 + th, height);
+                fn(tile);
+            }
+        };
+        parallelFor(tilesX * tilesY, range, priority);
+    }
+
+    TaskSchedulerStats getStats() const;
+    void resetStats();
+
+private:
+    using InvokeFn = void (*)(void* storage);
+
+    struct Node {
+        alignas(std::max_align_t) unsigned char storage[kTaskStorage];
+        InvokeFn invoke{nullptr};           // appelle puis détruit le callable
+        TaskGroup* group{nullptr};
+        TaskPriority priority{TaskPriority::Preview};
+        std::atomic<uint32_t> next{0};      // pile libre : index + 1, 0 = fin
+    };
+
+    // Deque Chase-Lev à capacité fixe (Lê et al., modèle mémoire C11)
+    class WorkDeque {
+    public:
+        bool push(Node* node);              // propriétaire
+        Node* pop();                        // propriétaire
+        Node* steal();                      // autres threads
+        bool empty() const;
+    private:
+        alignas(64) std::atomic<int64_t> top_{0};
+        alignas(64) std::atomic<int64_t> bottom_{0};
+        std::atomic<Node*> buffer_[kDequeCapacity];
+    };
+
+    // File bornée multi-producteurs multi-consommateurs (Vyukov)
+    class InjectQueue {
+    public:
+        InjectQueue();
+        bool push(Node* node);
+        Node* pop();
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            Node* node{nullptr};
+        };
+        alignas(64) std::atomic<size_t> head_{0};
+        alignas(64) std::atomic<size_t> tail_{0};
+        Cell cells_[kInjectCapacity];
+    };
+
+    struct alignas(64) Worker {
+        WorkDeque deques[kTaskPriorityCount];
+        std::atomic<uint64_t> executed[kTaskPriorityCount]{};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> sleeps{0};
+    };
+
+    struct ForJob {
+        void (*fn)(void*, size_t, size_t);
+        void* context;
+        size_t grain;
+        TaskGroup* group;
+    };
+
+    template <typename F>
+    void submitTo(TaskGroup* group, TaskPriority priority, F&& fn) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= kTaskStorage, "tâche trop grande pour le stockage en place (kTaskStorage)");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "alignement de tâche non supporté");
+        static_assert(std::is_invocable_v<Fn&>, "tâche : callable sans argument attendu");
+
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        if (group) group->pending_.fetch_add(1, std::memory_order_relaxed);
+        Node* node = acquireNode();
+        if (!node) {
+            // Plus de nœud libre : exécution immédiate, sans allocation
+            inlineRuns_.fetch_add(1, std::memory_order_relaxed);
+            Fn local(std::forward<F>(fn));
+            runCallable(local, group, priority);
+            return;
+        }
+        ::new (static_cast<void*>(node->storage)) Fn(std::forward<F>(fn));
+        node->invoke = [](void* storage) {
+            Fn* f = std::launder(static_cast<Fn*>(storage));
+            struct Destroy { Fn* f; ~Destroy() { f->~Fn(); } } destroy{f};
+            (*f)();
+        };
+        node->group = group;
+        node->priority = priority;
+        enqueue(node);
+    }
+
+    template <typename Fn>
+    void runCallable(Fn& fn, TaskGroup* group, TaskPriority priority) {
+        try {
+            fn();
+        } catch (...) {
+            failedTasks_.fetch_add(1, std::memory_order_relaxed);
+        }
+        countExecuted(static_cast<size_t>(priority));
+        finish(group);
+    }
+
+    void runParallelFor(size_t count, size_t grain, TaskPriority priority,
+                        void (*fn)(void*, size_t, size_t), void* context);
+    void runRange(ForJob* job, size_t begin, size_t end);
+
+    Node* acquireNode();
+    void releaseNode(Node* node);
+    void enqueue(Node* node);
+    void execute(Node* node);
+    void countExecuted(size_t priority);
+    void finish(TaskGroup* group);
+    // Tâche de priorité <= maxPriority : deque locale, injection, vol
+    Node* findTask(size_t maxPriority, bool& stolen);
+    bool localWork(TaskPriority priority) const;
+    void wake();
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Worker>> state_;
+    std::vector<std::thread> workers_;
+    InjectQueue inject_[kTaskPriorityCount];
+
+    std::unique_ptr<Node[]> nodes_;
+    alignas(64) std::atomic<uint64_t> freeHead_{0};   // étiquette << 32 | (index + 1)
+    std::atomic<size_t> nodesInUse_{0};
+    std::atomic<size_t> nodesHighWater_{0};
+
+    alignas(64) std::atomic<uint32_t> workEpoch_{0};  // incrémenté à chaque tâche publiée
+    std::atomic<uint32_t> sleepers_{0};
+    alignas(64) std::atomic<uint32_t> doneEpoch_{0};  // incrémenté quand un groupe se termine
+    std::atomic<uint32_t> waiters_{0};
+    std::atomic<uint32_t> parkEpoch_{0};              // workers mis en réserve (setActiveWorkers)
+    std::atomic<size_t> active_{0};
+    std::atomic<bool> stop_{false};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> injected_{0};
+    std::atomic<uint64_t> inlineRuns_{0};
+    std::atomic<uint64_t> helped_[kTaskPriorityCount]{};   // exécutées hors worker (wait)
+    std::atomic<uint64_t> failedTasks_{0};
+};
+
+} // namespace Common
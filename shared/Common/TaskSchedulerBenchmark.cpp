@@ -0,0 +1,399 @@
+#include "TaskSchedulerBenchmark.hpp"
+#include "TaskScheduler.hpp"
+#include "../Audio/utils/RealtimeScope.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+
+namespace Common {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Ancien Camera::ThreadPool (FilterManager.hpp), gardé ici comme référence
+class LegacyThreadPool {
+public:
+    explicit LegacyThreadPool(size_t numThreads) {
+        for (size_t i = 0; i < numThreads; ++i) {
+            workers_.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(queueMutex_);
+                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) {
+                            return;
+                        }
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~LegacyThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    template<typename F>
+    auto enqueue(F&& f) -> std::future<decltype(f())> {
+        auto task = std::make_shared<std::packaged_task<decltype(f())()>>(std::forward<F>(f));
+        auto result = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            if (stop_) {
+                throw std::runtime_error("ThreadPool stopped");
+            }
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex queueMutex_;
+    std::condition_variable condition_;
+    bool stop_{false};
+};
+
+// Tâche de tuile : sépia + vignette, passes répétées pour le scénario de coût inégal
+struct TileWork {
+    const uint8_t* input{nullptr};
+    uint8_t* output{nullptr};
+    int width{0};
+    int height{0};
+    bool skewed{false};
+};
+
+void shadeTile(const TileWork& work, const TileRect& tile) {
+    const float cx = work.width * 0.5f;
+    const float cy = work.height * 0.5f;
+    const float invR2 = 1.0f / (cx * cx + cy * cy);
+    for (int y = tile.y0; y < tile.y1; ++y) {
+        const int passes = (work.skewed && y < work.height / 3) ? 4 : 1;
+        const uint8_t* src = work.input + static_cast<size_t>(y) * work.width * 4;
+        uint8_t* dst = work.output + static_cast<size_t>(y) * work.width * 4;
+        for (int x = tile.x0; x < tile.x1; ++x) {
+            float b = src[x * 4 + 0];
+            float g = src[x * 4 + 1];
+            float r = src[x * 4 + 2];
+            for (int p = 0; p < passes; ++p) {
+                const float nr = std::min(255.0f, 0.393f * r + 0.769f * g + 0.189f * b);
+                const float ng = std::min(255.0f, 0.349f * r + 0.686f * g + 0.168f * b);
+                const float nb = std::min(255.0f, 0.272f * r + 0.534f * g + 0.131f * b);
+                r = nr;
+                g = ng;
+                b = nb;
+            }
+            const float dx = x - cx;
+            const float dy = y - cy;
+            const float v = 1.0f - 0.5f * (dx * dx + dy * dy) * invR2;
+            dst[x * 4 + 0] = static_cast<uint8_t>(b * v + 0.5f);
+            dst[x * 4 + 1] = static_cast<uint8_t>(g * v + 0.5f);
+            dst[x * 4 + 2] = static_cast<uint8_t>(r * v + 0.5f);
+            dst[x * 4 + 3] = src[x * 4 + 3];
+        }
+    }
+}
+
+std::vector<TileRect> makeTiles(int width, int height, int tw, int th) {
+    std::vector<TileRect> tiles;
+    for (int y = 0; y < height; y += th) {
+        for (int x = 0; x < width; x += tw) {
+            tiles.push_back({x, y, std::min(x + tw, width), std::min(y + th, height)});
+        }
+    }
+    return tiles;
+}
+
+int maxDiff(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    int diff = 0;
+    for (size_t i = 0; i < a.size(); ++i) diff = std::max(diff, std::abs(int(a[i]) - int(b[i])));
+    return diff;
+}
+
+// Tripwires : allocations et verrous du thread appelant, sans trace sur stderr
+std::atomic<uint64_t> g_callerViolations{0};
+void countViolation(const AudioEqualizer::RealtimeViolation&) {
+    g_callerViolations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Fn>
+TaskSchedulerBenchmarkResult measureFrames(int frames, Fn&& frame) {
+    TaskSchedulerBenchmarkResult r;
+    frame();    // préchauffage
+    std::vector<double> times;
+    times.reserve(frames);
+    g_callerViolations.store(0);
+    for (int f = 0; f < frames; ++f) {
+        const auto t0 = Clock::now();
+        {
+            AudioEqualizer::RealtimeScope scope;
+            frame();
+        }
+        times.push_back(elapsedMs(t0));
+    }
+    double sum = 0.0;
+    for (double t : times) sum += t;
+    r.msPerFrame = frames > 0 ? sum / frames : 0.0;
+    std::sort(times.begin(), times.end());
+    r.p99Ms = times.empty() ? 0.0 : times[std::min(times.size() - 1, static_cast<size_t>(times.size() * 0.99))];
+    if (AudioEqualizer::RealtimeScope::tripwiresEnabled() && frames > 0) {
+        r.callerViolations = static_cast<int64_t>(g_callerViolations.load() / static_cast<uint64_t>(frames));
+    }
+    return r;
+}
+
+void busyFor(double ms) {
+    const auto t0 = Clock::now();
+    while (elapsedMs(t0) < ms) {
+    }
+}
+
+} // namespace
+
+TaskSchedulerBenchmarkResults runTaskSchedulerBenchmark(const TaskSchedulerBenchmarkConfig& config) {
+    TaskSchedulerBenchmarkResults results;
+    results.hardwareThreads = std::thread::hardware_concurrency();
+    AudioEqualizer::RealtimeScope::setViolationHandler(&countViolation);
+
+    const int w = config.width;
+    const int h = config.height;
+    std::vector<uint8_t> input(static_cast<size_t>(w) * h * 4);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            uint8_t* p = &input[(static_cast<size_t>(y) * w + x) * 4];
+            p[0] = static_cast<uint8_t>(x * 255 / std::max(1, w - 1));
+            p[1] = static_cast<uint8_t>(y * 255 / std::max(1, h - 1));
+            p[2] = static_cast<uint8_t>((x ^ y) & 0xFF);
+            p[3] = 255;
+        }
+    }
+    std::vector<uint8_t> reference(input.size());
+    std::vector<uint8_t> skewedReference(input.size());
+    std::vector<uint8_t> output(input.size());
+
+    // Référence séquentielle (une tuile = l'image)
+    {
+        TileWork work{input.data(), reference.data(), w, h, false};
+        const TileRect whole{0, 0, w, h};
+        shadeTile(work, whole);
+        const auto t0 = Clock::now();
+        for (int f = 0; f < config.frames; ++f) shadeTile(work, whole);
+        results.sequentialMs = elapsedMs(t0) / std::max(1, config.frames);
+        TileWork skewed{input.data(), skewedReference.data(), w, h, true};
+        const auto t1 = Clock::now();
+        for (int f = 0; f < std::max(1, config.frames); ++f) shadeTile(skewed, whole);
+        results.sequentialSkewedMs = elapsedMs(t1) / std::max(1, config.frames);
+    }
+
+    struct Scenario {
+        const char* label;
+        int tw;
+        int th;
+        bool skewed;
+    };
+    const Scenario scenarios[] = {
+        {"uniforme", config.tileWidth, config.tileHeight, false},
+        {"inégale", config.tileWidth, config.tileHeight, true},
+        {"fine", config.fineTile, config.fineTile, false},
+    };
+
+    for (int n : config.workerCounts) {
+        n = std::max(1, n);
+        LegacyThreadPool pool(static_cast<size_t>(n));
+        // L'appelant participe : n - 1 workers pour n threads (au moins un worker)
+        TaskScheduler scheduler(static_cast<size_t>(std::max(1, n - 1)));
+
+        for (const Scenario& sc : scenarios) {
+            TileWork work{input.data(), output.data(), w, h, sc.skewed};
+            const auto& expected = sc.skewed ? skewedReference : reference;
+            const std::vector<TileRect> tiles = makeTiles(w, h, sc.tw, sc.th);
+            const std::string label = sc.label == std::string("fine")
+                ? "fine " + std::to_string(sc.tw) + "x" + std::to_string(sc.th) : sc.label;
+
+            // Ancien pool : une tâche (et un future) par tuile
+            std::fill(output.begin(), output.end(), 0);
+            TaskSchedulerBenchmarkResult legacy = measureFrames(config.frames, [&] {
+                std::vector<std::future<void>> futures;
+                futures.reserve(tiles.size());
+                for (const TileRect& tile : tiles) {
+                    futures.push_back(pool.enqueue([&work, tile] { shadeTile(work, tile); }));
+                }
+                for (auto& future : futures) future.get();
+            });
+            legacy.label = label;
+            legacy.engine = "ThreadPool";
+            legacy.threads = n;
+            legacy.tasksPerFrame = static_cast<int>(tiles.size());
+            legacy.maxDiff = maxDiff(output, expected);
+            results.rows.push_back(legacy);
+
+            // Ordonnanceur : grain automatique sur les tuiles
+            std::fill(output.begin(), output.end(), 0);
+            scheduler.resetStats();
+            TaskSchedulerBenchmarkResult stealing = measureFrames(config.frames, [&] {
+                scheduler.parallelForTiles(w, h, [&work](const TileRect& tile) { shadeTile(work, tile); },
+                                           TaskPriority::Preview, sc.tw, sc.th);
+            });
+            stealing.label = label;
+            stealing.engine = "TaskScheduler";
+            stealing.threads = static_cast<int>(scheduler.concurrency());
+            stealing.tasksPerFrame = static_cast<int>(scheduler.getStats().submitted / static_cast<uint64_t>(config.frames + 1));
+            stealing.maxDiff = maxDiff(output, expected);
+            results.rows.push_back(stealing);
+        }
+    }
+
+    for (auto& r : results.rows) {
+        const double sequential = r.label == "inégale" ? results.sequentialSkewedMs : results.sequentialMs;
+        r.speedup = r.msPerFrame > 0.0 ? sequential / r.msPerFrame : 0.0;
+    }
+
+    // Priorités : lot de fond soumis juste avant l'image d'aperçu
+    const int most = config.workerCounts.empty() ? 1 : std::max(1, *std::max_element(config.workerCounts.begin(), config.workerCounts.end()));
+    const std::vector<TileRect> tiles = makeTiles(w, h, config.tileWidth, config.tileHeight);
+    TileWork work{input.data(), output.data(), w, h, false};
+    constexpr int kPriorityFrames = 5;
+    {
+        LegacyThreadPool pool(static_cast<size_t>(most));
+        TaskSchedulerPriorityResult r;
+        r.engine = "ThreadPool";
+        r.threads = most;
+        r.backgroundTasks = config.backgroundTasks;
+        auto frame = [&] {
+            std::vector<std::future<void>> futures;
+            for (const TileRect& tile : tiles) futures.push_back(pool.enqueue([&work, tile] { shadeTile(work, tile); }));
+            for (auto& future : futures) future.get();
+        };
+        frame();
+        for (int f = 0; f < kPriorityFrames; ++f) {
+            auto t0 = Clock::now();
+            frame();
+            r.idleMs += elapsedMs(t0) / kPriorityFrames;
+            std::vector<std::future<void>> background;
+            for (int i = 0; i < config.backgroundTasks; ++i) {
+                background.push_back(pool.enqueue([ms = config.backgroundMs] { busyFor(ms); }));
+            }
+            t0 = Clock::now();
+            frame();
+            r.loadedMs += elapsedMs(t0) / kPriorityFrames;
+            for (auto& future : background) future.get();
+        }
+        results.priorityRows.push_back(r);
+    }
+    {
+        TaskScheduler scheduler(static_cast<size_t>(std::max(1, most - 1)));
+        TaskSchedulerPriorityResult r;
+        r.engine = "TaskScheduler";
+        r.threads = static_cast<int>(scheduler.concurrency());
+        r.backgroundTasks = config.backgroundTasks;
+        auto frame = [&] {
+            scheduler.parallelForTiles(w, h, [&work](const TileRect& tile) { shadeTile(work, tile); },
+                                       TaskPriority::Preview, config.tileWidth, config.tileHeight);
+        };
+        frame();
+        for (int f = 0; f < kPriorityFrames; ++f) {
+            auto t0 = Clock::now();
+            frame();
+            r.idleMs += elapsedMs(t0) / kPriorityFrames;
+            TaskGroup background(TaskPriority::Background);
+            for (int i = 0; i < config.backgroundTasks; ++i) {
+                scheduler.submit(background, [ms = config.backgroundMs] { busyFor(ms); });
+            }
+            t0 = Clock::now();
+            frame();
+            r.loadedMs += elapsedMs(t0) / kPriorityFrames;
+            scheduler.wait(background);
+        }
+        results.priorityRows.push_back(r);
+    }
+
+    // Surcoût : lots de tâches vides, soumission puis attente
+    constexpr int kBatches = 20;
+    for (int n : config.workerCounts) {
+        n = std::max(1, n);
+        {
+            LegacyThreadPool pool(static_cast<size_t>(n));
+            std::vector<std::future<void>> futures;
+            futures.reserve(config.emptyTasks);
+            const auto t0 = Clock::now();
+            for (int b = 0; b < kBatches; ++b) {
+                futures.clear();
+                for (int i = 0; i < config.emptyTasks; ++i) futures.push_back(pool.enqueue([] {}));
+                for (auto& future : futures) future.get();
+            }
+            results.overheadRows.push_back({"ThreadPool", n, elapsedMs(t0) * 1e6 / (kBatches * std::max(1, config.emptyTasks))});
+        }
+        {
+            TaskScheduler scheduler(static_cast<size_t>(std::max(1, n - 1)));
+            const auto t0 = Clock::now();
+            for (int b = 0; b < kBatches; ++b) {
+                TaskGroup group;
+                for (int i = 0; i < config.emptyTasks; ++i) scheduler.submit(group, [] {});
+                scheduler.wait(group);
+            }
+            results.overheadRows.push_back({"TaskScheduler", static_cast<int>(scheduler.concurrency()),
+                                            elapsedMs(t0) * 1e6 / (kBatches * std::max(1, config.emptyTasks))});
+        }
+    }
+
+    AudioEqualizer::RealtimeScope::setViolationHandler(nullptr);
+    return results;
+}
+
+void printTaskSchedulerBenchmark(const TaskSchedulerBenchmarkResults& results) {
+    std::cout << "\n=== Ordonnanceur à vol de travail (" << results.hardwareThreads << " threads matériels) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << "Boucle séquentielle : " << results.sequentialMs
+              << " ms/image (inégale : " << results.sequentialSkewedMs << " ms)" << std::endl;
+    std::cout << std::left << std::setw(14) << "tuiles" << std::setw(15) << "moteur" << std::right
+              << std::setw(8) << "threads" << std::setw(8) << "tâches" << std::setw(11) << "ms/image"
+              << std::setw(9) << "p99" << std::setw(10) << "speedup" << std::setw(7) << "Δ max"
+              << std::setw(12) << "alloc+verr." << std::endl;
+    for (const auto& r : results.rows) {
+        std::cout << std::left << std::setw(14) << r.label << std::setw(15) << r.engine << std::right
+                  << std::setw(8) << r.threads << std::setw(8) << r.tasksPerFrame << std::setw(11) << r.msPerFrame
+                  << std::setw(9) << r.p99Ms << std::setw(9) << r.speedup << "x" << std::setw(7) << r.maxDiff
+                  << std::setw(12);
+        if (r.callerViolations >= 0) std::cout << r.callerViolations; else std::cout << "n/a";
+        std::cout << std::endl;
+    }
+    std::cout << "\nImage d'aperçu derrière un lot de tâches de fond :" << std::endl;
+    for (const auto& r : results.priorityRows) {
+        std::cout << "  " << std::left << std::setw(15) << r.engine << std::right << r.threads << " threads, "
+                  << r.backgroundTasks << " tâches de fond : " << r.idleMs << " ms seule, " << r.loadedMs
+                  << " ms avec le lot" << std::endl;
+    }
+    std::cout << "\nSurcoût par tâche vide (soumission + attente) :" << std::endl;
+    for (const auto& r : results.overheadRows) {
+        std::cout << "  " << std::left << std::setw(15) << r.engine << std::right << std::setw(3) << r.threads
+                  << " threads : " << std::setprecision(0) << r.nsPerTask << " ns" << std::setprecision(2) << std::endl;
+    }
+}
+
+} // namespace Common
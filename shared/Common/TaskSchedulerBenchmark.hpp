@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Common {
+
+struct TaskSchedulerBenchmarkResult {
+    std::string label;              // "uniforme", "inégale", "fine 32x32"
+    std::string engine;             // "ThreadPool", "TaskScheduler"
+    int threads{0};                 // threads qui traitent l'image (TaskScheduler : workers + appelant)
+    int tasksPerFrame{0};           // tâches soumises par image
+    double msPerFrame{0.0};
+    double p99Ms{0.0};
+    double speedup{0.0};            // vs boucle séquentielle du même scénario
+    int maxDiff{-1};                // vs boucle séquentielle (niveaux 8 bits)
+    int64_t callerViolations{-1};   // allocations + verrous du thread appelant par image (-1 : sans NAAYA_RT_TRIPWIRES)
+};
+
+// Image d'aperçu pendant qu'un lot de tâches de fond occupe les workers
+struct TaskSchedulerPriorityResult {
+    std::string engine;
+    int threads{0};
+    int backgroundTasks{0};
+    double idleMs{0.0};             // image seule
+    double loadedMs{0.0};           // image soumise juste après le lot de fond
+};
+
+// Soumission + attente de tâches vides
+struct TaskSchedulerOverheadResult {
+    std::string engine;
+    int threads{0};
+    double nsPerTask{0.0};
+};
+
+struct TaskSchedulerBenchmarkConfig {
+    int width = 1920;
+    int height = 1080;
+    int frames = 30;
+    std::vector<int> workerCounts = {1, 2, 4, 8};
+    int tileWidth = 256;
+    int tileHeight = 64;
+    int fineTile = 32;              // scénario "fine" : coût de soumission par tuile
+    int backgroundTasks = 32;       // scénario priorités
+    double backgroundMs = 2.0;      // durée d'une tâche de fond
+    int emptyTasks = 1000;          // scénario surcoût : tâches par lot (20 lots)
+};
+
+struct TaskSchedulerBenchmarkResults {
+    unsigned hardwareThreads{0};
+    double sequentialMs{0.0};
+    double sequentialSkewedMs{0.0};
+    std::vector<TaskSchedulerBenchmarkResult> rows;
+    std::vector<TaskSchedulerPriorityResult> priorityRows;
+    std::vector<TaskSchedulerOverheadResult> overheadRows;
+};
+
+// Image BGRA 1080p découpée en tuiles (sépia + vignette par pixel) : l'ancien ThreadPool
+// (file unique sous mutex, une std::function + packaged_task + future par tuile) contre
+// TaskScheduler::parallelForTiles (grain automatique, vol de travail), tuiles uniformes, de
+// coût inégal (tiers haut 4x plus cher) et fines. Puis latence d'une image d'aperçu derrière un
+// lot de tâches de fond, et surcoût par tâche vide.
+TaskSchedulerBenchmarkResults runTaskSchedulerBenchmark(const TaskSchedulerBenchmarkConfig& config = {});
+void printTaskSchedulerBenchmark(const TaskSchedulerBenchmarkResults& results);
+
+} // namespace Common
@@ -1,4 +1,5 @@
 #include "NativeAudioEqualizerModule.h"
+#include "Audio/utils/SeqLock.h"
 #include <atomic>
 #include <mutex>
 
@@ -10,6 +11,8 @@ static double g_naaya_eq_master_gain = 0.0;
 static double g_naaya_eq_band_gains[32] = {0};
 static size_t g_naaya_eq_num_bands = 10;
 static std::atomic<bool> g_naaya_eq_dirty{false};
+// Durée du fondu vers les gains publiés (0 = application immédiate), consommée par le moteur
+static double g_naaya_eq_morph_ms = 0.0;
 
 // === NR global state (accessible cross-platform) ===
 static std::mutex g_naaya_nr_mutex;
@@ -39,12 +42,49 @@ static double g_naaya_safety_knee_db = 6.0;
 static bool   g_naaya_safety_feedback_enabled = true;
 static double g_naaya_safety_feedback_thresh = 0.95;
 static std::atomic<bool> g_naaya_safety_dirty{false};
-static double g_naaya_safety_last_peak = 0.0;
-static double g_naaya_safety_last_rms = 0.0;
-static double g_naaya_safety_last_dc = 0.0;
-static uint32_t g_naaya_safety_last_clipped = 0;
-static double g_naaya_safety_last_feedback = 0.0;
-static bool g_naaya_safety_last_overload = false;
+// Mesures publiées par le thread audio à chaque buffer : seqlock, jamais de verrou côté audio
+struct NaayaSafetyMetrics {
+  double peak = 0.0;
+  double rms = 0.0;
+  double dcOffset = 0.0;
+  double feedbackScore = 0.0;
+  uint32_t clippedSamples = 0;
+  uint32_t overload = 0;
+};
+// Loudness EBU R128 (LUFS / LU / dBTP), -70 = silence
+struct NaayaLoudnessMetrics {
+  double momentary = -70.0;
+  double shortTerm = -70.0;
+  double integrated = -70.0;
+  double range = 0.0;
+  double truePeak = -70.0;
+};
+// Gouverneur CPU : palier publié par le moteur audio
+struct NaayaGovernorMetrics {
+  double cpuLoad = 0.0;         // charge lissée (temps / échéance)
+  int32_t qualityTier = 0;      // 0=full, 1=reduced, 2=minimal
+  uint32_t tierChanges = 0;
+  uint64_t deadlineMisses = 0;
+};
+static AudioEqualizer::SeqLock<NaayaSafetyMetrics> g_naaya_safety_metrics;
+static AudioEqualizer::SeqLock<NaayaLoudnessMetrics> g_naaya_safety_loudness;
+static AudioEqualizer::SeqLock<NaayaGovernorMetrics> g_naaya_safety_governor;
+static std::atomic<bool> g_naaya_safety_loudness_reset{false};
+static std::atomic<bool> g_naaya_safety_governor_enabled{true};
+
+// === Latence de la chaîne temps réel (échantillons par étage, publiée par le moteur audio) ===
+struct NaayaLatencyStages {
+  uint64_t sampleRate = 48000;
+  uint64_t noiseReduction = 0;  // moteur NR complété au retard commun des paliers
+  uint64_t effects = 0;
+  uint64_t safety = 0;
+  uint64_t equalizer = 0;
+  uint64_t total() const { return noiseReduction + effects + safety + equalizer; }
+};
+// Réécrite seulement quand un étage change de retard
+static AudioEqualizer::SeqLock<NaayaLatencyStages> g_naaya_latency;
+static std::atomic<bool>   g_naaya_latency_low{false};        // mode faible latence
+static std::atomic<double> g_naaya_latency_budget_ms{10.0};
 
 // === FX (creative effects) global state ===
 static std::mutex g_naaya_fx_mutex;
@@ -59,6 +99,12 @@ static double g_naaya_fx_comp_makeup_db    = 0.0;
 static double g_naaya_fx_delay_ms          = 150.0;
 static double g_naaya_fx_delay_feedback    = 0.3;
 static double g_naaya_fx_delay_mix         = 0.25;
+// Saturation (ADAA)
+static bool   g_naaya_fx_sat_enabled       = false;
+static int    g_naaya_fx_sat_type          = 0;     // 0=tanh, 1=cubic, 2=asymmetric
+static double g_naaya_fx_sat_drive_db      = 12.0;
+static double g_naaya_fx_sat_mix           = 1.0;
+static double g_naaya_fx_sat_output_db     = -6.0;
 static std::atomic<bool> g_naaya_fx_dirty{false};
 
 extern "C" bool NaayaEQ_IsEnabled() {
@@ -92,6 +138,13 @@ extern "C" void NaayaEQ_ClearPendingUpdate() {
   g_naaya_eq_dirty.store(false);
 }
 
+extern "C" double NaayaEQ_ConsumeMorphMs() {
+  std::lock_guard<std::mutex> lk(g_naaya_eq_mutex);
+  double ms = g_naaya_eq_morph_ms;
+  g_naaya_eq_morph_ms = 0.0;
+  return ms;
+}
+
 // === NR C API ===
 extern "C" bool NaayaNR_IsEnabled() {
   std::lock_guard<std::mutex> lk(g_naaya_nr_mutex);
@@ -169,9 +222,34 @@ extern "C" void NaayaFX_GetDelay(double* delayMs,
   if (mix)      *mix      = g_naaya_fx_delay_mix;
 }
 
+extern "C" void NaayaFX_GetSaturation(bool* enabled,
+                                       int* type,
+                                       double* driveDb,
+                                       double* mix,
+                                       double* outputDb) {
+  std::lock_guard<std::mutex> lk(g_naaya_fx_mutex);
+  if (enabled)  *enabled  = g_naaya_fx_sat_enabled;
+  if (type)     *type     = g_naaya_fx_sat_type;
+  if (driveDb)  *driveDb  = g_naaya_fx_sat_drive_db;
+  if (mix)      *mix      = g_naaya_fx_sat_mix;
+  if (outputDb) *outputDb = g_naaya_fx_sat_output_db;
+}
+
 #if NAAYA_AUDIO_EQ_ENABLED
+#include "Audio/safety/LoudnessMeter.h"
+#include "Audio/utils/AudioProfiler.h"
+#include "Audio/utils/RealtimeScope.h"
+#include "Audio/offline/OfflineRenderer.h"
+#include "Audio/io/AudioFileWriter.h"
+#include "Audio/waveform/WaveformPyramid.h"
+#include "Audio/waveform/SpectrogramTiles.h"
+#include <deque>
+#include <map>
 #include <cmath>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <thread>
 #ifndef NAAYA_HAS_SPECTRUM
 #define NAAYA_HAS_SPECTRUM 1
 #endif
@@ -183,6 +261,198 @@ size_t NaayaAudioSpectrumCopyMagnitudes(float* outBuffer, size_t maxCount);
 }
 #endif
 
+// === Rendu hors ligne (un rendu à la fois) ===
+static std::mutex g_naaya_offline_mutex;
+static std::unique_ptr<AudioOffline::OfflineRenderer> g_naaya_offline_renderer;
+static AudioOffline::RenderOptions g_naaya_offline_options;   // normalisation (sous g_naaya_offline_mutex)
+
+// === Enregistrement de la sortie traitée (WAV/W64/FLAC) ===
+// open/close sous mutex (thread JS); le thread audio pousse sans verrou (AudioFileWriter)
+static std::mutex g_naaya_rec_mutex;
+static AudioIO::AudioFileWriter g_naaya_rec_writer;
+static std::atomic<uint32_t> g_naaya_rec_stream_rate{48000};   // format du flux, fixé par le bridge
+static std::atomic<int> g_naaya_rec_stream_channels{2};
+static std::atomic<int> g_naaya_rec_channels{0};               // canaux du fichier en cours, 0 = inactif
+static std::atomic<uint64_t> g_naaya_rec_skip{0};              // trames ignorées : retard de la chaîne au départ
+
+// === Aperçus de forme d'onde (un cache par fichier source) ===
+// Mise à jour sur un thread détaché qui garde l'entrée en vie; une demande pendant un calcul
+// relance une passe à la fin (enregistrement qui grossit).
+struct NaayaWaveformEntry {
+  AudioWaveform::WaveformPyramid pyramid;
+  std::atomic<bool> running{false};
+  std::atomic<bool> rerun{false};
+  std::mutex errorMutex;
+  std::string error;
+};
+static std::mutex g_naaya_waveform_mutex;
+static std::map<std::string, std::shared_ptr<NaayaWaveformEntry>> g_naaya_waveforms;
+
+static std::shared_ptr<NaayaWaveformEntry> findWaveform(const std::string& path, bool create) {
+  std::lock_guard<std::mutex> lk(g_naaya_waveform_mutex);
+  auto it = g_naaya_waveforms.find(path);
+  if (it != g_naaya_waveforms.end()) return it->second;
+  if (!create) return nullptr;
+  auto entry = std::make_shared<NaayaWaveformEntry>();
+  g_naaya_waveforms[path] = entry;
+  return entry;
+}
+
+static void startWaveformUpdate(const std::string& path, std::shared_ptr<NaayaWaveformEntry> entry) {
+  entry->rerun.store(true);
+  if (entry->running.exchange(true)) return;   // la passe en cours verra rerun
+  std::thread([path, entry] {
+    for (;;) {
+      while (entry->rerun.exchange(false)) {
+        std::string error;
+        const bool ok = entry->pyramid.update(path, std::string(), error);
+        std::lock_guard<std::mutex> lk(entry->errorMutex);
+        entry->error = ok ? std::string() : error;
+      }
+      entry->running.store(false);
+      // Demande arrivée après la dernière vérification : reprise si personne ne l'a fait
+      if (!entry->rerun.load() || entry->running.exchange(true)) break;
+    }
+  }).detach();
+}
+
+// === Spectrogrammes en tuiles (cache disque fourni par JS) ===
+// Rendus demandés mis en file; un thread détaché les traite tant que la file n'est pas vide.
+struct NaayaSpectrogramRequest {
+  int zoom;
+  uint64_t first;
+  uint64_t count;
+};
+struct NaayaSpectrogramEntry {
+  explicit NaayaSpectrogramEntry(const AudioWaveform::SpectrogramConfig& config) : tiles(config) {}
+  AudioWaveform::SpectrogramTiles tiles;
+  std::mutex mutex;                               // file et erreur
+  std::deque<NaayaSpectrogramRequest> pending;
+  bool running = false;
+  std::string error;
+};
+static std::mutex g_naaya_spectrogram_mutex;
+static std::map<std::string, std::shared_ptr<NaayaSpectrogramEntry>> g_naaya_spectrograms;
+
+static std::shared_ptr<NaayaSpectrogramEntry> findSpectrogram(const std::string& path) {
+  std::lock_guard<std::mutex> lk(g_naaya_spectrogram_mutex);
+  auto it = g_naaya_spectrograms.find(path);
+  return it != g_naaya_spectrograms.end() ? it->second : nullptr;
+}
+
+static void startSpectrogramRender(std::shared_ptr<NaayaSpectrogramEntry> entry, const NaayaSpectrogramRequest& request) {
+  {
+    std::lock_guard<std::mutex> lk(entry->mutex);
+    entry->pending.push_back(request);
+    if (entry->running) return;
+    entry->running = true;
+  }
+  std::thread([entry] {
+    for (;;) {
+      NaayaSpectrogramRequest next;
+      {
+        std::lock_guard<std::mutex> lk(entry->mutex);
+        if (entry->pending.empty()) { entry->running = false; return; }
+        next = entry->pending.front();
+        entry->pending.pop_front();
+      }
+      std::string error;
+      entry->tiles.render(next.zoom, next.first, next.count, error);
+      std::lock_guard<std::mutex> lk(entry->mutex);
+      entry->error = error;
+    }
+  }).detach();
+}
+
+// Copie des réglages live pour le rendu hors ligne.
+// RNNoise n'est pas disponible partout : le mode 1 est rendu avec l'expander.
+static AudioOffline::ChainSettings snapshotChainSettings() {
+  AudioOffline::ChainSettings cs;
+  {
+    std::lock_guard<std::mutex> lk(g_naaya_nr_mutex);
+    cs.nr.enabled        = g_naaya_nr_enabled && g_naaya_nr_mode != 2;
+    cs.nr.enableHighPass = g_naaya_nr_hp_enabled;
+    cs.nr.highPassHz     = g_naaya_nr_hp_hz;
+    cs.nr.thresholdDb    = g_naaya_nr_threshold_db;
+    cs.nr.ratio          = g_naaya_nr_ratio;
+    cs.nr.floorDb        = g_naaya_nr_floor_db;
+    cs.nr.attackMs       = g_naaya_nr_attack_ms;
+    cs.nr.releaseMs      = g_naaya_nr_release_ms;
+  }
+  {
+    std::lock_guard<std::mutex> lk(g_naaya_fx_mutex);
+    cs.fxEnabled       = g_naaya_fx_enabled;
+    cs.compThresholdDb = g_naaya_fx_comp_threshold_db;
+    cs.compRatio       = g_naaya_fx_comp_ratio;
+    cs.compAttackMs    = g_naaya_fx_comp_attack_ms;
+    cs.compReleaseMs   = g_naaya_fx_comp_release_ms;
+    cs.compMakeupDb    = g_naaya_fx_comp_makeup_db;
+    cs.delayMs         = g_naaya_fx_delay_ms;
+    cs.delayFeedback   = g_naaya_fx_delay_feedback;
+    cs.delayMix        = g_naaya_fx_delay_mix;
+    cs.satEnabled      = g_naaya_fx_sat_enabled;
+    cs.satType         = g_naaya_fx_sat_type;
+    cs.satDriveDb      = g_naaya_fx_sat_drive_db;
+    cs.satMix          = g_naaya_fx_sat_mix;
+    cs.satOutputDb     = g_naaya_fx_sat_output_db;
+  }
+  {
+    std::lock_guard<std::mutex> lk(g_naaya_safety_mutex);
+    cs.safety.enabled               = g_naaya_safety_enabled;
+    cs.safety.dcRemovalEnabled      = g_naaya_safety_dc_enabled;
+    cs.safety.dcThreshold           = g_naaya_safety_dc_threshold;
+    cs.safety.limiterEnabled        = g_naaya_safety_limiter_enabled;
+    cs.safety.limiterThresholdDb    = g_naaya_safety_limiter_threshold_db;
+    cs.safety.softKneeLimiter       = g_naaya_safety_softknee;
+    cs.safety.kneeWidthDb           = g_naaya_safety_knee_db;
+    cs.safety.feedbackDetectEnabled = g_naaya_safety_feedback_enabled;
+    cs.safety.feedbackCorrThreshold = g_naaya_safety_feedback_thresh;
+  }
+  {
+    std::lock_guard<std::mutex> lk(g_naaya_eq_mutex);
+    cs.eqEnabled      = g_naaya_eq_enabled;
+    cs.eqMasterGainDb = g_naaya_eq_master_gain;
+    cs.eqBandGains.assign(g_naaya_eq_band_gains, g_naaya_eq_band_gains + g_naaya_eq_num_bands);
+  }
+  return cs;
+}
+
+static const char* offlineStateName(AudioOffline::RenderState state) {
+  switch (state) {
+    case AudioOffline::RenderState::Running:   return "running";
+    case AudioOffline::RenderState::Done:      return "done";
+    case AudioOffline::RenderState::Cancelled: return "cancelled";
+    case AudioOffline::RenderState::Failed:    return "failed";
+    default:                                   return "idle";
+  }
+}
+
+// Tampon natif d'un Float32Array : rempli en C++, exposé à JS sans boucle par élément
+class NaayaFloatBuffer : public facebook::jsi::MutableBuffer {
+public:
+  explicit NaayaFloatBuffer(size_t count) : data_(count, 0.0f) {}
+  size_t size() const override { return data_.size() * sizeof(float); }
+  uint8_t* data() override { return reinterpret_cast<uint8_t*>(data_.data()); }
+  float* floats() { return data_.data(); }
+private:
+  std::vector<float> data_;
+};
+
+static facebook::jsi::Object makeFloat32Array(facebook::jsi::Runtime& rt, std::shared_ptr<NaayaFloatBuffer> buffer) {
+  facebook::jsi::ArrayBuffer arrayBuffer(rt, std::move(buffer));
+  return rt.global().getPropertyAsFunction(rt, "Float32Array").callAsConstructor(rt, arrayBuffer).asObject(rt);
+}
+
+// Tampon natif d'un ArrayBuffer d'octets (tuiles de spectrogramme)
+class NaayaByteBuffer : public facebook::jsi::MutableBuffer {
+public:
+  explicit NaayaByteBuffer(size_t count) : data_(count, 0) {}
+  size_t size() const override { return data_.size(); }
+  uint8_t* data() override { return data_.data(); }
+private:
+  std::vector<uint8_t> data_;
+};
+
 namespace facebook {
 namespace react {
 
@@ -419,6 +689,34 @@ NativeAudioEqualizerModule::NativeAudioEqualizerModule(std::shared_ptr<CallInvok
         return jsi::Value(self.getBandGain(rt, self.defaultEqualizerId_, args[0].asNumber()));
     }};
 
+    // Courbe exacte de l'EQ par défaut : numPoints fréquences log-espacées dans [minHz, maxHz]
+    methodMap_["getFrequencyResponse"] = MethodMetadata{3, [](jsi::Runtime& rt, TurboModule& turboModule, const jsi::Value* args, size_t count) -> jsi::Value {
+        auto& self = static_cast<NativeAudioEqualizerModule&>(turboModule);
+        self.ensureDefaultEqualizer(rt);
+        auto* eq = self.getEqualizer(self.defaultEqualizerId_);
+        double points = (count > 0 && args[0].isNumber()) ? args[0].asNumber() : 512.0;
+        double minHz = (count > 1 && args[1].isNumber()) ? args[1].asNumber() : 20.0;
+        double maxHz = (count > 2 && args[2].isNumber()) ? args[2].asNumber() : 20000.0;
+        const size_t n = static_cast<size_t>(std::max(2.0, std::min(4096.0, points)));
+        const double nyquist = 0.5 * (eq ? eq->getSampleRate() : 48000u);
+        maxHz = std::max(2.0, std::min(maxHz, nyquist));
+        minHz = std::max(1.0, std::min(minHz, maxHz * 0.5));
+
+        auto freqs = std::make_shared<NaayaFloatBuffer>(n);
+        auto magDb = std::make_shared<NaayaFloatBuffer>(n);
+        auto phase = std::make_shared<NaayaFloatBuffer>(n);
+        const double ratio = std::pow(maxHz / minHz, 1.0 / static_cast<double>(n - 1));
+        double f = minHz;
+        for (size_t i = 0; i < n; ++i, f *= ratio) freqs->floats()[i] = static_cast<float>(f);
+        if (eq) eq->getFrequencyResponse(freqs->floats(), magDb->floats(), phase->floats(), n);
+
+        auto obj = jsi::Object(rt);
+        obj.setProperty(rt, "frequencies", makeFloat32Array(rt, std::move(freqs)));
+        obj.setProperty(rt, "magnitudeDb", makeFloat32Array(rt, std::move(magDb)));
+        obj.setProperty(rt, "phase", makeFloat32Array(rt, std::move(phase)));
+        return obj;
+    }};
+
     methodMap_["setPreset"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& turboModule, const jsi::Value* args, size_t count) -> jsi::Value {
         auto& self = static_cast<NativeAudioEqualizerModule&>(turboModule);
         self.ensureDefaultEqualizer(rt);
@@ -436,6 +734,35 @@ NativeAudioEqualizerModule::NativeAudioEqualizerModule(std::shared_ptr<CallInvok
               g_naaya_eq_band_gains[i] = eq->getBandGain(i);
             }
           }
+          g_naaya_eq_morph_ms = 0.0;
+          g_naaya_eq_dirty.store(true);
+        }
+        return jsi::Value::undefined();
+    }};
+
+    // Fondu vers un preset (EQ par défaut et moteur audio), sans saut audible
+    methodMap_["morphToPreset"] = MethodMetadata{2, [](jsi::Runtime& rt, TurboModule& turboModule, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto& self = static_cast<NativeAudioEqualizerModule&>(turboModule);
+        self.ensureDefaultEqualizer(rt);
+        auto name = args[0].asString(rt).utf8(rt);
+        const double durationMs = std::max(0.0, std::min(10000.0, args[1].asNumber()));
+        const AudioEqualizer::EQPreset* preset = AudioEqualizer::EQPresetFactory::findPreset(name);
+        if (!preset) {
+            throw jsi::JSError(rt, "Unknown preset name: " + name);
+        }
+        auto* eq = self.getEqualizer(self.defaultEqualizerId_);
+        if (eq) eq->morphToPreset(*preset, durationMs);
+        self.currentPresetName_ = name;
+        {
+          std::lock_guard<std::mutex> lk(g_naaya_eq_mutex);
+          if (eq) {
+            size_t n = eq->getNumBands();
+            g_naaya_eq_num_bands = n <= 32 ? n : 32;
+            for (size_t i = 0; i < g_naaya_eq_num_bands; ++i) {
+              g_naaya_eq_band_gains[i] = eq->getBandGain(i);
+            }
+          }
+          g_naaya_eq_morph_ms = durationMs;
           g_naaya_eq_dirty.store(true);
         }
         return jsi::Value::undefined();
@@ -604,17 +931,363 @@ NativeAudioEqualizerModule::NativeAudioEqualizerModule(std::shared_ptr<CallInvok
     }};
 
     methodMap_["safetyGetReport"] = MethodMetadata{0, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
-        std::lock_guard<std::mutex> lk(g_naaya_safety_mutex);
+        const NaayaSafetyMetrics m = g_naaya_safety_metrics.load();
+        const NaayaLoudnessMetrics l = g_naaya_safety_loudness.load();
+        const NaayaGovernorMetrics g = g_naaya_safety_governor.load();
+        auto obj = jsi::Object(rt);
+        obj.setProperty(rt, "peak", jsi::Value(m.peak));
+        obj.setProperty(rt, "rms", jsi::Value(m.rms));
+        obj.setProperty(rt, "dcOffset", jsi::Value(m.dcOffset));
+        obj.setProperty(rt, "clippedSamples", jsi::Value(static_cast<double>(m.clippedSamples)));
+        obj.setProperty(rt, "feedbackScore", jsi::Value(m.feedbackScore));
+        obj.setProperty(rt, "overload", jsi::Value(m.overload != 0));
+        obj.setProperty(rt, "momentaryLufs", jsi::Value(l.momentary));
+        obj.setProperty(rt, "shortTermLufs", jsi::Value(l.shortTerm));
+        obj.setProperty(rt, "integratedLufs", jsi::Value(l.integrated));
+        obj.setProperty(rt, "loudnessRange", jsi::Value(l.range));
+        obj.setProperty(rt, "truePeakDbtp", jsi::Value(l.truePeak));
+        obj.setProperty(rt, "qualityTier", jsi::Value(g.qualityTier));
+        obj.setProperty(rt, "qualityTierChanges", jsi::Value(static_cast<double>(g.tierChanges)));
+        obj.setProperty(rt, "cpuLoad", jsi::Value(g.cpuLoad));
+        obj.setProperty(rt, "deadlineMisses", jsi::Value(static_cast<double>(g.deadlineMisses)));
+        return obj;
+    }};
+
+    // Redémarre la mesure intégrée/LRA (appliqué par le moteur audio au prochain buffer)
+    methodMap_["safetyResetLoudness"] = MethodMetadata{0, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        g_naaya_safety_loudness_reset.store(true);
+        return jsi::Value::undefined();
+    }};
+
+    // Gain de normalisation export (dB) : cible LUFS, plafond true-peak dBTP
+    methodMap_["safetyGetNormalizationGain"] = MethodMetadata{2, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        const NaayaLoudnessMetrics l = g_naaya_safety_loudness.load();
+        AudioSafety::LoudnessReport lr;
+        lr.integratedLufs = l.integrated;
+        lr.truePeakDbtp = l.truePeak;
+        return jsi::Value(AudioSafety::LoudnessMeter::normalizationGainDb(lr, args[0].asNumber(), args[1].asNumber()));
+    }};
+
+    // Gouverneur CPU : dégradation automatique de la qualité sous charge
+    methodMap_["safetySetGovernorEnabled"] = MethodMetadata{1, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        g_naaya_safety_governor_enabled.store(args[0].getBool());
+        return jsi::Value::undefined();
+    }};
+
+    // ===== Profilage CPU par étage (chaîne audio temps réel) =====
+    methodMap_["perfGetReport"] = MethodMetadata{0, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        const AudioEqualizer::ProfilerReport rep = AudioEqualizer::AudioProfiler::instance().report();
+        auto statsToJs = [&rt](const AudioEqualizer::ProfileStats& st) {
+            auto o = jsi::Object(rt);
+            o.setProperty(rt, "count", jsi::Value(static_cast<double>(st.count)));
+            o.setProperty(rt, "mean", jsi::Value(st.mean));
+            o.setProperty(rt, "p50", jsi::Value(st.p50));
+            o.setProperty(rt, "p95", jsi::Value(st.p95));
+            o.setProperty(rt, "p99", jsi::Value(st.p99));
+            o.setProperty(rt, "max", jsi::Value(st.max));
+            return o;
+        };
+        auto obj = jsi::Object(rt);
+        obj.setProperty(rt, "compiledIn", jsi::Value(AudioEqualizer::AudioProfiler::compiledIn()));
+        obj.setProperty(rt, "enabled", jsi::Value(rep.enabled));
+        obj.setProperty(rt, "buffers", jsi::Value(static_cast<double>(rep.buffers)));
+        obj.setProperty(rt, "overruns", jsi::Value(static_cast<double>(rep.overruns)));
+        obj.setProperty(rt, "loadPercent", statsToJs(rep.loadPercent));
+        auto stages = jsi::Object(rt);
+        for (size_t i = 0; i < AudioEqualizer::kProfileStageCount; ++i) {
+            const char* name = AudioEqualizer::AudioProfiler::stageName(static_cast<AudioEqualizer::ProfileStage>(i));
+            stages.setProperty(rt, name, statsToJs(rep.stagesUs[i]));
+        }
+        obj.setProperty(rt, "stagesUs", std::move(stages));
+        return obj;
+    }};
+
+    methodMap_["perfSetEnabled"] = MethodMetadata{1, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        AudioEqualizer::AudioProfiler::instance().setEnabled(args[0].getBool());
+        return jsi::Value::undefined();
+    }};
+
+    methodMap_["perfReset"] = MethodMetadata{0, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        AudioEqualizer::AudioProfiler::instance().reset();
+        return jsi::Value::undefined();
+    }};
+
+    // ===== Latence de la chaîne temps réel (retard par étage, mode faible latence) =====
+    methodMap_["latencyGetReport"] = MethodMetadata{0, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        const NaayaLatencyStages lat = g_naaya_latency.load();
+        const double rate = static_cast<double>(lat.sampleRate);
+        const uint64_t total = lat.total();
+        auto stages = jsi::Object(rt);
+        stages.setProperty(rt, "noiseReduction", jsi::Value(static_cast<double>(lat.noiseReduction)));
+        stages.setProperty(rt, "effects", jsi::Value(static_cast<double>(lat.effects)));
+        stages.setProperty(rt, "safety", jsi::Value(static_cast<double>(lat.safety)));
+        stages.setProperty(rt, "equalizer", jsi::Value(static_cast<double>(lat.equalizer)));
+        auto obj = jsi::Object(rt);
+        obj.setProperty(rt, "sampleRate", jsi::Value(rate));
+        obj.setProperty(rt, "stagesSamples", std::move(stages));
+        obj.setProperty(rt, "totalSamples", jsi::Value(static_cast<double>(total)));
+        obj.setProperty(rt, "totalMs", jsi::Value(rate > 0.0 ? 1000.0 * static_cast<double>(total) / rate : 0.0));
+        obj.setProperty(rt, "lowLatency", jsi::Value(g_naaya_latency_low.load()));
+        obj.setProperty(rt, "budgetMs", jsi::Value(g_naaya_latency_budget_ms.load()));
+        return obj;
+    }};
+
+    // Mode faible latence : la NR se replie sur le moteur le plus riche tenant dans budgetMs
+    methodMap_["latencySetLowLatencyMode"] = MethodMetadata{2, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        const double budget = args[1].asNumber();
+        g_naaya_latency_budget_ms.store(std::isfinite(budget) ? std::max(0.0, std::min(budget, 1000.0)) : 10.0);
+        g_naaya_latency_low.store(args[0].getBool());
+        return jsi::Value::undefined();
+    }};
+
+    // ===== Rendu hors ligne des fichiers enregistrés (réglages EQ/NR/FX courants) =====
+    methodMap_["offlineRenderStart"] = MethodMetadata{2, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto toStrings = [&rt](const jsi::Value& v) {
+            std::vector<std::string> out;
+            if (!v.isObject() || !v.asObject(rt).isArray(rt)) return out;
+            auto arr = v.asObject(rt).asArray(rt);
+            const size_t n = arr.length(rt);
+            out.reserve(n);
+            for (size_t i = 0; i < n; ++i) out.push_back(arr.getValueAtIndex(rt, i).asString(rt).utf8(rt));
+            return out;
+        };
+        const auto inputs = toStrings(args[0]);
+        const auto outputs = toStrings(args[1]);
+        if (inputs.empty() || inputs.size() != outputs.size()) {
+            throw jsi::JSError(rt, "offlineRenderStart: listes d'entrées/sorties invalides");
+        }
+        std::lock_guard<std::mutex> lk(g_naaya_offline_mutex);
+        if (g_naaya_offline_renderer &&
+            g_naaya_offline_renderer->getProgress().state == AudioOffline::RenderState::Running) {
+            return jsi::Value(false);
+        }
+        g_naaya_offline_renderer.reset();
+        g_naaya_offline_renderer = std::make_unique<AudioOffline::OfflineRenderer>(snapshotChainSettings(), g_naaya_offline_options);
+        return jsi::Value(g_naaya_offline_renderer->start(inputs, outputs));
+    }};
+
+    // Normalisation des prochains rendus : passe de mesure puis gain vers targetLufs sous ceilingDbtp
+    methodMap_["offlineRenderSetNormalization"] = MethodMetadata{3, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        const double target = args[1].asNumber();
+        const double ceiling = args[2].asNumber();
+        std::lock_guard<std::mutex> lk(g_naaya_offline_mutex);
+        g_naaya_offline_options.normalize = args[0].getBool();
+        g_naaya_offline_options.targetLufs = std::isfinite(target) ? std::max(-70.0, std::min(target, 0.0)) : -14.0;
+        g_naaya_offline_options.ceilingDbtp = std::isfinite(ceiling) ? std::max(-20.0, std::min(ceiling, 0.0)) : -1.0;
+        return jsi::Value::undefined();
+    }};
+
+    methodMap_["offlineRenderGetProgress"] = MethodMetadata{0, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        AudioOffline::RenderProgress p;
+        {
+            std::lock_guard<std::mutex> lk(g_naaya_offline_mutex);
+            if (g_naaya_offline_renderer) p = g_naaya_offline_renderer->getProgress();
+        }
+        auto obj = jsi::Object(rt);
+        obj.setProperty(rt, "state", jsi::String::createFromUtf8(rt, offlineStateName(p.state)));
+        obj.setProperty(rt, "progress", jsi::Value(p.progress));
+        obj.setProperty(rt, "realtimeFactor", jsi::Value(p.realtimeFactor));
+        obj.setProperty(rt, "audioSeconds", jsi::Value(p.audioSeconds));
+        obj.setProperty(rt, "elapsedSeconds", jsi::Value(p.elapsedSeconds));
+        obj.setProperty(rt, "filesDone", jsi::Value(static_cast<double>(p.filesDone)));
+        obj.setProperty(rt, "filesTotal", jsi::Value(static_cast<double>(p.filesTotal)));
+        obj.setProperty(rt, "error", jsi::String::createFromUtf8(rt, p.error));
+        return obj;
+    }};
+
+    methodMap_["offlineRenderCancel"] = MethodMetadata{0, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        std::lock_guard<std::mutex> lk(g_naaya_offline_mutex);
+        if (g_naaya_offline_renderer) g_naaya_offline_renderer->cancel();
+        return jsi::Value::undefined();
+    }};
+
+    // ===== Enregistrement de la sortie traitée =====
+    // format : 0=WAV, 1=W64, 2=FLAC; sampleFormat : 0=16 bits, 1=24 bits, 2=float
+    methodMap_["recordStart"] = MethodMetadata{3, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        const std::string path = args[0].asString(rt).utf8(rt);
+        const int format = static_cast<int>(args[1].asNumber());
+        const int sampleFormat = static_cast<int>(args[2].asNumber());
+        AudioIO::AudioFileWriterConfig cfg;
+        cfg.format = static_cast<AudioIO::AudioFileFormat>((format >= 0 && format <= 2) ? format : 0);
+        cfg.sampleFormat = static_cast<AudioIO::SampleFormat>((sampleFormat >= 0 && sampleFormat <= 2) ? sampleFormat : 1);
+        cfg.sampleRate = g_naaya_rec_stream_rate.load();
+        cfg.numChannels = g_naaya_rec_stream_channels.load();
+        std::lock_guard<std::mutex> lk(g_naaya_rec_mutex);
+        g_naaya_rec_channels.store(0);
+        g_naaya_rec_writer.close();
+        std::string error;
+        if (!g_naaya_rec_writer.open(path, cfg, error)) {
+            throw jsi::JSError(rt, "recordStart: " + error);
+        }
+        // Les premières trames sortent avant que le son capté n'ait traversé la chaîne
+        g_naaya_rec_skip.store(g_naaya_latency.load().total());
+        g_naaya_rec_channels.store(cfg.numChannels, std::memory_order_release);
+        return jsi::Value(true);
+    }};
+
+    methodMap_["recordStop"] = MethodMetadata{0, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        std::lock_guard<std::mutex> lk(g_naaya_rec_mutex);
+        g_naaya_rec_channels.store(0);
+        return jsi::Value(g_naaya_rec_writer.close());
+    }};
+
+    methodMap_["recordGetStats"] = MethodMetadata{0, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* /*args*/, size_t /*count*/) -> jsi::Value {
+        std::lock_guard<std::mutex> lk(g_naaya_rec_mutex);
+        const auto s = g_naaya_rec_writer.getStats();
+        const double rate = static_cast<double>(g_naaya_rec_writer.getConfig().sampleRate);
+        auto obj = jsi::Object(rt);
+        obj.setProperty(rt, "recording", jsi::Value(g_naaya_rec_writer.isOpen()));
+        obj.setProperty(rt, "seconds", jsi::Value(rate > 0.0 ? static_cast<double>(s.framesWritten) / rate : 0.0));
+        obj.setProperty(rt, "framesWritten", jsi::Value(static_cast<double>(s.framesWritten)));
+        obj.setProperty(rt, "framesDropped", jsi::Value(static_cast<double>(s.framesDropped)));
+        obj.setProperty(rt, "bytesWritten", jsi::Value(static_cast<double>(s.bytesWritten)));
+        obj.setProperty(rt, "maxQueueFill", jsi::Value(s.maxQueueFill));
+        obj.setProperty(rt, "error", jsi::String::createFromUtf8(rt, g_naaya_rec_writer.getLastError()));
+        return obj;
+    }};
+
+    methodMap_["recordRepair"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        std::string error;
+        return jsi::Value(AudioIO::AudioFileWriter::repairHeader(args[0].asString(rt).utf8(rt), error));
+    }};
+
+    // ===== Formes d'onde (cache <fichier>.wfp projeté en mémoire) =====
+    methodMap_["waveformUpdate"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        const std::string path = args[0].asString(rt).utf8(rt);
+        startWaveformUpdate(path, findWaveform(path, true));
+        return jsi::Value::undefined();
+    }};
+
+    methodMap_["waveformGetInfo"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto entry = findWaveform(args[0].asString(rt).utf8(rt), false);
         auto obj = jsi::Object(rt);
-        obj.setProperty(rt, "peak", jsi::Value(g_naaya_safety_last_peak));
-        obj.setProperty(rt, "rms", jsi::Value(g_naaya_safety_last_rms));
-        obj.setProperty(rt, "dcOffset", jsi::Value(g_naaya_safety_last_dc));
-        obj.setProperty(rt, "clippedSamples", jsi::Value(static_cast<double>(g_naaya_safety_last_clipped)));
-        obj.setProperty(rt, "feedbackScore", jsi::Value(g_naaya_safety_last_feedback));
-        obj.setProperty(rt, "overload", jsi::Value(g_naaya_safety_last_overload));
+        const AudioWaveform::WaveformInfo info = entry ? entry->pyramid.getInfo() : AudioWaveform::WaveformInfo{};
+        obj.setProperty(rt, "running", jsi::Value(entry && entry->running.load()));
+        obj.setProperty(rt, "sampleRate", jsi::Value(static_cast<double>(info.sampleRate)));
+        obj.setProperty(rt, "channels", jsi::Value(info.channels));
+        obj.setProperty(rt, "frames", jsi::Value(static_cast<double>(info.frames)));
+        obj.setProperty(rt, "seconds", jsi::Value(info.sampleRate > 0 ? static_cast<double>(info.frames) / info.sampleRate : 0.0));
+        auto levels = jsi::Array(rt, info.samplesPerBucket.size());
+        for (size_t i = 0; i < info.samplesPerBucket.size(); ++i) {
+            levels.setValueAtIndex(rt, i, jsi::Value(static_cast<double>(info.samplesPerBucket[i])));
+        }
+        obj.setProperty(rt, "samplesPerBucket", levels);
+        std::string error;
+        if (entry) {
+            std::lock_guard<std::mutex> lk(entry->errorMutex);
+            error = entry->error;
+        }
+        obj.setProperty(rt, "error", jsi::String::createFromUtf8(rt, error));
         return obj;
     }};
 
+    // Float32Array de 3 x width : min, max, rms par colonne; channel -1 : canaux fusionnés
+    methodMap_["waveformQuery"] = MethodMetadata{5, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto entry = findWaveform(args[0].asString(rt).utf8(rt), false);
+        const double startSeconds = args[1].asNumber();
+        const double endSeconds = args[2].asNumber();
+        const size_t width = static_cast<size_t>(std::max(1.0, std::min(8192.0, args[3].asNumber())));
+        const int channel = args[4].isNumber() ? static_cast<int>(args[4].asNumber()) : -1;
+        auto buffer = std::make_shared<NaayaFloatBuffer>(3 * width);
+        if (entry) entry->pyramid.query(startSeconds, endSeconds, width, channel, buffer->floats());
+        return makeFloat32Array(rt, std::move(buffer));
+    }};
+
+    methodMap_["waveformRelease"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        std::lock_guard<std::mutex> lk(g_naaya_waveform_mutex);
+        g_naaya_waveforms.erase(args[0].asString(rt).utf8(rt));
+        return jsi::Value::undefined();
+    }};
+
+    // ===== Spectrogrammes (tuiles 8 bits, cache <cacheDir>/<clé>/) =====
+    methodMap_["spectrogramOpen"] = MethodMetadata{2, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        const std::string path = args[0].asString(rt).utf8(rt);
+        const std::string cacheDir = args[1].isString() ? args[1].asString(rt).utf8(rt) : std::string();
+        std::shared_ptr<NaayaSpectrogramEntry> entry;
+        {
+            // Nouveau répertoire : nouvelle entrée (un rendu en cours garde l'ancienne)
+            std::lock_guard<std::mutex> lk(g_naaya_spectrogram_mutex);
+            auto& slot = g_naaya_spectrograms[path];
+            if (!slot || slot->tiles.config().cacheDir != cacheDir) {
+                AudioWaveform::SpectrogramConfig config;
+                config.cacheDir = cacheDir;
+                slot = std::make_shared<NaayaSpectrogramEntry>(config);
+            }
+            entry = slot;
+        }
+        std::string error;
+        const bool ok = entry->tiles.open(path, error);
+        std::lock_guard<std::mutex> lk(entry->mutex);
+        entry->error = error;
+        return jsi::Value(ok);
+    }};
+
+    methodMap_["spectrogramGetInfo"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto entry = findSpectrogram(args[0].asString(rt).utf8(rt));
+        auto obj = jsi::Object(rt);
+        const AudioWaveform::SpectrogramInfo info = entry ? entry->tiles.getInfo() : AudioWaveform::SpectrogramInfo{};
+        const AudioWaveform::SpectrogramConfig config = entry ? entry->tiles.config() : AudioWaveform::SpectrogramConfig{};
+        std::string error;
+        bool running = false;
+        if (entry) {
+            std::lock_guard<std::mutex> lk(entry->mutex);
+            error = entry->error;
+            running = entry->running;
+        }
+        obj.setProperty(rt, "rendering", jsi::Value(running));
+        obj.setProperty(rt, "sampleRate", jsi::Value(static_cast<double>(info.sampleRate)));
+        obj.setProperty(rt, "channels", jsi::Value(info.channels));
+        obj.setProperty(rt, "frames", jsi::Value(static_cast<double>(info.frames)));
+        obj.setProperty(rt, "seconds", jsi::Value(info.sampleRate > 0 ? static_cast<double>(info.frames) / info.sampleRate : 0.0));
+        obj.setProperty(rt, "tileWidth", jsi::Value(static_cast<double>(config.tileWidth)));
+        obj.setProperty(rt, "tileHeight", jsi::Value(static_cast<double>(config.tileHeight)));
+        obj.setProperty(rt, "samplesPerColumn", jsi::Value(static_cast<double>(config.baseHop)));
+        obj.setProperty(rt, "maxZoom", jsi::Value(AudioWaveform::kMaxSpectrogramZoom));
+        obj.setProperty(rt, "minHz", jsi::Value(static_cast<double>(config.minHz)));
+        obj.setProperty(rt, "maxHz", jsi::Value(static_cast<double>(info.maxHz)));
+        obj.setProperty(rt, "minDb", jsi::Value(static_cast<double>(config.minDb)));
+        obj.setProperty(rt, "maxDb", jsi::Value(static_cast<double>(config.maxDb)));
+        obj.setProperty(rt, "cacheKey", jsi::String::createFromUtf8(rt, info.cacheKey));
+        obj.setProperty(rt, "error", jsi::String::createFromUtf8(rt, error));
+        return obj;
+    }};
+
+    // ArrayBuffer de tileHeight x tileWidth octets (ligne 0 = aigu), null si hors limites
+    methodMap_["spectrogramGetTile"] = MethodMetadata{3, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto entry = findSpectrogram(args[0].asString(rt).utf8(rt));
+        if (!entry) return jsi::Value::null();
+        const int zoom = static_cast<int>(args[1].asNumber());
+        const double index = args[2].asNumber();
+        if (index < 0.0) return jsi::Value::null();
+        const auto& config = entry->tiles.config();
+        auto buffer = std::make_shared<NaayaByteBuffer>(config.tileWidth * config.tileHeight);
+        std::string error;
+        if (!entry->tiles.getTile(zoom, static_cast<uint64_t>(index), buffer->data(), error)) {
+            std::lock_guard<std::mutex> lk(entry->mutex);
+            entry->error = error;
+            return jsi::Value::null();
+        }
+        return jsi::ArrayBuffer(rt, std::move(buffer));
+    }};
+
+    // Pré-calcul en arrière-plan des tuiles [firstTile, firstTile + count) d'un zoom
+    methodMap_["spectrogramRender"] = MethodMetadata{4, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        auto entry = findSpectrogram(args[0].asString(rt).utf8(rt));
+        if (!entry) return jsi::Value::undefined();
+        NaayaSpectrogramRequest request;
+        request.zoom = static_cast<int>(args[1].asNumber());
+        request.first = static_cast<uint64_t>(std::max(0.0, args[2].asNumber()));
+        request.count = static_cast<uint64_t>(std::max(0.0, args[3].asNumber()));
+        startSpectrogramRender(entry, request);
+        return jsi::Value::undefined();
+    }};
+
+    methodMap_["spectrogramRelease"] = MethodMetadata{1, [](jsi::Runtime& rt, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        std::lock_guard<std::mutex> lk(g_naaya_spectrogram_mutex);
+        g_naaya_spectrograms.erase(args[0].asString(rt).utf8(rt));
+        return jsi::Value::undefined();
+    }};
+
     // ===== FX controls exposed to JS =====
     methodMap_["fxSetEnabled"] = MethodMetadata{1, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
         bool en = args[0].getBool();
@@ -704,6 +1377,24 @@ NativeAudioEqualizerModule::NativeAudioEqualizerModule(std::shared_ptr<CallInvok
         }
         return jsi::Value::undefined();
     }};
+
+    methodMap_["fxSetSaturation"] = MethodMetadata{5, [](jsi::Runtime& /*rt*/, TurboModule& /*turboModule*/, const jsi::Value* args, size_t /*count*/) -> jsi::Value {
+        bool en = args[0].getBool();
+        int ty = static_cast<int>(args[1].asNumber());
+        double dr = args[2].asNumber();
+        double mx = args[3].asNumber();
+        double od = args[4].asNumber();
+        {
+          std::lock_guard<std::mutex> lk(g_naaya_fx_mutex);
+          g_naaya_fx_sat_enabled   = en;
+          g_naaya_fx_sat_type      = (ty >= 0 && ty <= 2) ? ty : 0;
+          g_naaya_fx_sat_drive_db  = std::max(0.0, std::min(dr, 36.0));
+          g_naaya_fx_sat_mix       = std::max(0.0, std::min(mx, 1.0));
+          g_naaya_fx_sat_output_db = std::max(-24.0, std::min(od, 24.0));
+          g_naaya_fx_dirty.store(true);
+        }
+        return jsi::Value::undefined();
+    }};
 }
 
 // === Safety C API to update metrics from platform recorders ===
@@ -713,13 +1404,100 @@ extern "C" void NaayaSafety_UpdateReport(double peak,
                                           uint32_t clippedSamples,
                                           double feedbackScore,
                                           bool overload) {
-  std::lock_guard<std::mutex> lk(g_naaya_safety_mutex);
-  g_naaya_safety_last_peak = peak;
-  g_naaya_safety_last_rms = rms;
-  g_naaya_safety_last_dc = dcOffset;
-  g_naaya_safety_last_clipped = clippedSamples;
-  g_naaya_safety_last_feedback = feedbackScore;
-  g_naaya_safety_last_overload = overload;
+  NaayaSafetyMetrics m;
+  m.peak = peak;
+  m.rms = rms;
+  m.dcOffset = dcOffset;
+  m.feedbackScore = feedbackScore;
+  m.clippedSamples = clippedSamples;
+  m.overload = overload ? 1u : 0u;
+  g_naaya_safety_metrics.publish(m);
+}
+
+extern "C" void NaayaSafety_UpdateLoudness(double momentaryLufs,
+                                            double shortTermLufs,
+                                            double integratedLufs,
+                                            double loudnessRange,
+                                            double truePeakDbtp) {
+  NaayaLoudnessMetrics l;
+  l.momentary = momentaryLufs;
+  l.shortTerm = shortTermLufs;
+  l.integrated = integratedLufs;
+  l.range = loudnessRange;
+  l.truePeak = truePeakDbtp;
+  g_naaya_safety_loudness.publish(l);
+}
+
+// Retourne true une seule fois après safetyResetLoudness()
+extern "C" bool NaayaSafety_ConsumeLoudnessReset() {
+  return g_naaya_safety_loudness_reset.exchange(false);
+}
+
+extern "C" void NaayaSafety_UpdateGovernor(int qualityTier,
+                                           uint32_t tierChanges,
+                                           double cpuLoad,
+                                           uint32_t deadlineMisses) {
+  NaayaGovernorMetrics g;
+  g.cpuLoad = cpuLoad;
+  g.qualityTier = qualityTier;
+  g.tierChanges = tierChanges;
+  g.deadlineMisses = deadlineMisses;
+  g_naaya_safety_governor.publish(g);
+}
+
+extern "C" bool NaayaSafety_IsGovernorEnabled() {
+  return g_naaya_safety_governor_enabled.load();
+}
+
+// === Recording C API (bridges) ===
+extern "C" void NaayaRecord_SetStreamFormat(uint32_t sampleRate, int numChannels) {
+  if (sampleRate > 0) g_naaya_rec_stream_rate.store(sampleRate);
+  if (numChannels > 0) g_naaya_rec_stream_channels.store(numChannels);
+}
+
+// Thread audio : sortie de la chaîne (planaire). Ignoré si aucun enregistrement ou format différent.
+extern "C" void NaayaRecord_PushPlanar(const float* const* channels, int numChannels, size_t frames) {
+  if (g_naaya_rec_channels.load(std::memory_order_acquire) != numChannels) return;
+  // Retard de la chaîne : le fichier commence au premier échantillon capté après recordStart
+  const uint64_t skip = g_naaya_rec_skip.load(std::memory_order_relaxed);
+  if (skip > 0) {
+    const size_t drop = static_cast<size_t>(std::min<uint64_t>(skip, frames));
+    g_naaya_rec_skip.store(skip - drop, std::memory_order_relaxed);
+    if (drop == frames || numChannels > 8) return;
+    const float* shifted[8];
+    for (int c = 0; c < numChannels; ++c) shifted[c] = channels[c] + drop;
+    g_naaya_rec_writer.writePlanar(shifted, frames - drop);
+    return;
+  }
+  g_naaya_rec_writer.writePlanar(channels, frames);
+}
+
+// === Latency C API (bridges) ===
+// Thread audio : retard de chaque étage de la chaîne courante (échantillons), sans verrou.
+// Appelable à chaque buffer : rien n'est écrit tant que les retards ne changent pas.
+extern "C" void NaayaLatency_Update(uint32_t sampleRate,
+                                    size_t noiseReduction,
+                                    size_t effects,
+                                    size_t safety,
+                                    size_t equalizer) {
+  NaayaLatencyStages lat;
+  lat.sampleRate = sampleRate > 0 ? sampleRate : g_naaya_latency.load().sampleRate;
+  lat.noiseReduction = noiseReduction;
+  lat.effects = effects;
+  lat.safety = safety;
+  lat.equalizer = equalizer;
+  g_naaya_latency.publish(lat);
+}
+
+extern "C" size_t NaayaLatency_GetTotalFrames() {
+  return static_cast<size_t>(g_naaya_latency.load().total());
+}
+
+// Budget du mode faible latence en échantillons; SIZE_MAX hors mode faible latence
+extern "C" size_t NaayaLatency_GetBudgetSamples(uint32_t sampleRate) {
+  if (!g_naaya_latency_low.load()) return SIZE_MAX;
+  const double ms = g_naaya_latency_budget_ms.load();
+  return static_cast<size_t>(std::floor(ms * 0.001 * static_cast<double>(sampleRate)));
 }
 
 void NativeAudioEqualizerModule::ensureDefaultEqualizer(jsi::Runtime& rt) {
@@ -763,7 +1541,11 @@ jsi::Value NativeAudioEqualizerModule::processAudio(jsi::Runtime& rt, double equ
     auto input = jsArrayToFloatVector(rt, inputBuffer);
     std::vector<float> output(input.size());
     
-    eq->process(input.data(), output.data(), input.size());
+    // Thread JS : FTZ/DAZ pour les filtres récursifs (pas de test de dénormaux par échantillon)
+    {
+        AudioEqualizer::DenormalScope ftz;
+        eq->process(input.data(), output.data(), input.size());
+    }
     
     return floatVectorToJsArray(rt, output);
 }
@@ -785,7 +1567,10 @@ jsi::Value NativeAudioEqualizerModule::processAudioStereo(jsi::Runtime& rt, doub
     std::vector<float> outputL(inputL.size());
     std::vector<float> outputR(inputR.size());
     
-    eq->processStereo(inputL.data(), inputR.data(), outputL.data(), outputR.data(), inputL.size());
+    {
+        AudioEqualizer::DenormalScope ftz;
+        eq->processStereo(inputL.data(), inputR.data(), outputL.data(), outputR.data(), inputL.size());
+    }
     
     auto result = jsi::Object(rt);
     result.setProperty(rt, "left", floatVectorToJsArray(rt, outputL));
@@ -1000,33 +1785,12 @@ void NativeAudioEqualizerModule::loadPresetByName(jsi::Runtime& rt, double equal
     }
     
     std::string name = presetName.utf8(rt);
-    AudioEqualizer::EQPreset preset;
-    
-    if (name == "Flat") {
-        preset = AudioEqualizer::EQPresetFactory::createFlatPreset();
-    } else if (name == "Rock") {
-        preset = AudioEqualizer::EQPresetFactory::createRockPreset();
-    } else if (name == "Pop") {
-        preset = AudioEqualizer::EQPresetFactory::createPopPreset();
-    } else if (name == "Jazz") {
-        preset = AudioEqualizer::EQPresetFactory::createJazzPreset();
-    } else if (name == "Classical") {
-        preset = AudioEqualizer::EQPresetFactory::createClassicalPreset();
-    } else if (name == "Electronic") {
-        preset = AudioEqualizer::EQPresetFactory::createElectronicPreset();
-    } else if (name == "Vocal Boost") {
-        preset = AudioEqualizer::EQPresetFactory::createVocalBoostPreset();
-    } else if (name == "Bass Boost") {
-        preset = AudioEqualizer::EQPresetFactory::createBassBoostPreset();
-    } else if (name == "Treble Boost") {
-        preset = AudioEqualizer::EQPresetFactory::createTrebleBoostPreset();
-    } else if (name == "Loudness") {
-        preset = AudioEqualizer::EQPresetFactory::createLoudnessPreset();
-    } else {
+    const AudioEqualizer::EQPreset* preset = AudioEqualizer::EQPresetFactory::findPreset(name);
+    if (!preset) {
         throw jsi::JSError(rt, "Unknown preset name: " + name);
     }
     
-    eq->loadPreset(preset);
+    eq->loadPreset(*preset);
 }
 
 // Utility
@@ -83,6 +83,14 @@ public:
      * – Wrappers par défaut (sans equalizerId explicite):
      *   beginBatch(), endBatch()
      *
+     * – Presets:
+     *   morphToPreset(name, durationMs)   // fondu des gains (0 .. 10000 ms) au lieu d'un saut
+     *
+     * – Courbe de l'EQ par défaut (réponse exacte de la cascade, calcul natif):
+     *   getFrequencyResponse(numPoints, minHz, maxHz)
+     *     -> { frequencies, magnitudeDb, phase }   // Float32Array (Hz, dB, radians)
+     *                                               // défauts : 512 points, 20 Hz .. 20 kHz
+     *
      * – Noise Reduction (NR):
      *   nrSetEnabled(enabled)
      *   nrGetEnabled() -> boolean
@@ -96,12 +104,66 @@ public:
      * – Audio Safety:
      *   safetySetConfig(enabled, dcRemovalEnabled, dcThreshold, limiterEnabled, limiterThresholdDb,
      *                  softKneeLimiter, kneeWidthDb, feedbackDetectEnabled, feedbackCorrThreshold)
-     *   safetyGetReport() -> { peak, rms, dcOffset, clippedSamples, feedbackScore, overload }
+     *   safetyGetReport() -> { peak, rms, dcOffset, clippedSamples, feedbackScore, overload,
+     *                          momentaryLufs, shortTermLufs, integratedLufs, loudnessRange, truePeakDbtp,
+     *                          qualityTier, qualityTierChanges, cpuLoad, deadlineMisses }
+     *                          // qualityTier: 0=complet, 1=NR spectrale + EQ 1/2 des bandes, 2=expander + EQ 3 bandes
+     *   safetyResetLoudness()                 // nouvelle mesure intégrée (début d'enregistrement)
+     *   safetyGetNormalizationGain(targetLufs, ceilingDbtp) -> number (dB, à appliquer à l'export)
+     *   safetySetGovernorEnabled(enabled)     // gouverneur de budget CPU (actif par défaut)
+     *
+     * – Profilage CPU (désactivable à la compilation : NAAYA_AUDIO_PROFILER=0):
+     *   perfGetReport() -> { compiledIn, enabled, buffers, overruns,
+     *                        loadPercent: {count, mean, p50, p95, p99, max},
+     *                        stagesUs: { conversion, nr, rnnoise, fx, safety, eq, analysis, total } }
+     *   perfSetEnabled(enabled), perfReset()
+     *
+     * – Latence de la chaîne temps réel (échantillons; enregistrements recalés d'autant):
+     *   latencyGetReport() -> { sampleRate, stagesSamples: { noiseReduction, effects, safety,
+     *                           equalizer }, totalSamples, totalMs, lowLatency, budgetMs }
+     *   latencySetLowLatencyMode(enabled, budgetMs)  // NR repliée sur le moteur tenant le budget
+     *
+     * – Rendu hors ligne (réglages NR/FX/safety/EQ courants appliqués à des fichiers):
+     *   offlineRenderStart(inputs[], outputs[]) -> boolean  // false si un rendu est en cours
+     *   offlineRenderGetProgress() -> { state, progress, realtimeFactor, audioSeconds,
+     *                                   elapsedSeconds, filesDone, filesTotal, error }
+     *                                   // state: idle | running | done | cancelled | failed
+     *   offlineRenderCancel()
+     *   offlineRenderSetNormalization(enabled, targetLufs, ceilingDbtp)  // rendus suivants: mesure
+     *                                   // puis gain vers targetLufs, true peak sous ceilingDbtp
+     *
+     * – Enregistrement de la sortie traitée (E/S disque sur un thread dédié):
+     *   recordStart(path, format 0=WAV|1=W64|2=FLAC, sampleFormat 0=16|1=24 bits|2=float) -> true
+     *   recordStop() -> boolean  // false si une erreur d'écriture est survenue
+     *   recordGetStats() -> { recording, seconds, framesWritten, framesDropped, bytesWritten,
+     *                         maxQueueFill, error }
+     *   recordRepair(path) -> boolean  // en-tête WAV/W64 d'un fichier interrompu
+     *
+     * – Formes d'onde (pyramide min/max/rms, cache <fichier>.wfp projeté en mémoire):
+     *   waveformUpdate(path)  // calcul ou reprise en arrière-plan (fichier qui grossit)
+     *   waveformGetInfo(path) -> { running, sampleRate, channels, frames, seconds,
+     *                              samplesPerBucket[], error }
+     *   waveformQuery(path, startSec, endSec, width, channel) -> Float32Array(3 x width)
+     *                              // min, max, rms par colonne; channel -1 : canaux fusionnés
+     *   waveformRelease(path)
+     *
+     * – Spectrogrammes (tuiles 8 bits log-fréquence / dB, cache <cacheDir>/<empreinte>/):
+     *   spectrogramOpen(path, cacheDir) -> boolean  // à rappeler si le fichier a changé
+     *   spectrogramGetInfo(path) -> { rendering, sampleRate, channels, frames, seconds,
+     *                                 tileWidth, tileHeight, samplesPerColumn, maxZoom,
+     *                                 minHz, maxHz, minDb, maxDb, cacheKey, error }
+     *   spectrogramGetTile(path, zoom, index) -> ArrayBuffer | null
+     *                                 // tileHeight lignes de tileWidth octets, ligne 0 = aigu;
+     *                                 // colonne = samplesPerColumn << zoom échantillons
+     *   spectrogramRender(path, zoom, firstTile, count)  // pré-calcul en arrière-plan
+     *   spectrogramRelease(path)
      *
      * – FX (effets créatifs):
      *   fxSetEnabled(enabled), fxGetEnabled()
      *   fxSetCompressor(thresholdDb, ratio, attackMs, releaseMs, makeupDb)
      *   fxSetDelay(delayMs, feedback, mix)
+     *   fxSetSaturation(enabled, type 0=tanh|1=cubic|2=asym, driveDb 0..36, mix 0..1, outputDb)
+     *     – saturation anti-repliée (ADAA), en tête de chaîne
      */
 
 private:
@@ -1,4 +1,7 @@
 #include "NativeCameraFiltersModule.h"
+#include "Camera/filters/ColorMatrixFilterProcessor.hpp"
+#include "Camera/filters/FilterChainCompiler.hpp"
+#include "Camera/filters/LutFilterProcessor.hpp"
 #include <mutex>
 #include <string>
 
@@ -39,6 +42,12 @@ NativeCameraFiltersModule::NativeCameraFiltersModule(std::shared_ptr<CallInvoker
   // Enregistrer le processeur FFmpeg par défaut
   auto processor = Camera::FilterFactory::createProcessor(Camera::FilterFactory::ProcessorType::FFMPEG);
   filterManager_->registerProcessor(processor);
+  // Matrice couleur native : prioritaire pour les filtres ponctuels
+  filterManager_->registerProcessor(
+    Camera::FilterFactory::createProcessor(Camera::FilterFactory::ProcessorType::COLOR_MATRIX));
+  // LUT 3D native : prioritaire sur le graphe FFmpeg lut3d
+  filterManager_->registerProcessor(
+    Camera::FilterFactory::createProcessor(Camera::FilterFactory::ProcessorType::LUT3D));
 }
 
 NativeCameraFiltersModule::~NativeCameraFiltersModule() = default;
@@ -125,6 +134,13 @@ bool NativeCameraFiltersModule::setFilterWithParams(jsi::Runtime& rt, jsi::Strin
   g_naaya_filters_advanced_params.vignette = getNumber("vignette", 0.0);
   g_naaya_filters_advanced_params.grain = getNumber("grain", 0.0);
 
+  // Réglages de prise de vue : intégrés à la chaîne compilée du FilterManager
+  Camera::ColorAdjustments adjustments;
+  adjustments.exposure = g_naaya_filters_advanced_params.exposure;
+  adjustments.warmth = g_naaya_filters_advanced_params.warmth;
+  adjustments.tint = g_naaya_filters_advanced_params.tint;
+  filterManager_->setColorAdjustments(adjustments);
+
   // Mémoriser LUT si demandé
   if (state_.name.rfind("lut3d:", 0) == 0) {
     // Retirer la query éventuelle pour le chemin LUT côté iOS
@@ -195,6 +211,49 @@ extern "C" bool NaayaFilters_GetAdvancedParams(NaayaAdvancedFilterParams* outPar
   return true;
 }
 
+// Processeur LUT natif partagé (ProcessBGRA, chargement CIColorCube) : LUT gardées par chemin
+static std::mutex g_naaya_lut_mutex;
+static Camera::LutFilterProcessor& naayaLutProcessor() {
+  static Camera::LutFilterProcessor sProcessor;
+  static const bool sInitialized = sProcessor.initialize();
+  (void)sInitialized;
+  return sProcessor;
+}
+
+extern "C" void NaayaFilters_SetLUTCacheDirectory(const char* directory) {
+  std::lock_guard<std::mutex> lock(g_naaya_lut_mutex);
+  naayaLutProcessor().setCacheDirectory(directory ? directory : "");
+}
+
+extern "C" bool NaayaFilters_LoadLUTRGBA(const char* path, float* outRGBA, size_t capacity, int* outSize) {
+  if (!path || !*path) return false;
+  std::lock_guard<std::mutex> lock(g_naaya_lut_mutex);
+  Camera::FilterState state;
+  state.type = Camera::FilterType::CUSTOM;
+  state.params.customLUTPath = path;
+  Camera::Lut3DInterpolation interp;
+  const auto lut = naayaLutProcessor().lutFor(state, interp);
+  if (!lut) return false;
+  const int n = lut->size();
+  if (outSize) *outSize = n;
+  if (!outRGBA) return true;
+  if (capacity < static_cast<size_t>(n) * n * n * 4) return false;
+  // Ordre CIColorCube : R le plus rapide, puis G, puis B; alpha 1
+  float* dst = outRGBA;
+  for (int b = 0; b < n; ++b) {
+    for (int g = 0; g < n; ++g) {
+      for (int r = 0; r < n; ++r, dst += 4) {
+        const uint16_t* node = lut->node(r, g, b);
+        dst[0] = node[0] / 65535.0f;
+        dst[1] = node[1] / 65535.0f;
+        dst[2] = node[2] / 65535.0f;
+        dst[3] = 1.0f;
+      }
+    }
+  }
+  return true;
+}
+
 // === API de traitement FFmpeg pour iOS ===
 // Traite un buffer BGRA via FFmpeg si disponible
 extern "C" bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
@@ -212,13 +271,6 @@ extern "C" bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
                                          double fps,
                                          uint8_t* outData,
                                          int outStride) {
-#ifndef FFMPEG_AVAILABLE
-  // FFmpeg non disponible sur cette plateforme
-  (void)inData; (void)inStride; (void)width; (void)height;
-  (void)fps; (void)outData; (void)outStride;
-  return false;
-#else
-  // Implémentation FFmpeg
   if (!inData || !outData || width <= 0 || height <= 0) {
     return false;
   }
@@ -227,34 +279,10 @@ extern "C" bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
     return false;
   }
   
-  static std::mutex sMutex;
-  static std::unique_ptr<Camera::FFmpegFilterProcessor> sProcessor;
-  static int sLastW = 0, sLastH = 0;
-  
-  std::lock_guard<std::mutex> lock(sMutex);
-  
-  if (!sProcessor) {
-    sProcessor = std::make_unique<Camera::FFmpegFilterProcessor>();
-    if (!sProcessor->initialize()) {
-      sProcessor.reset();
-      return false;
-    }
-  }
-  
-  // Configurer le format si changé
-  if (width != sLastW || height != sLastH) {
-    sProcessor->setVideoFormat(width, height, "bgra");
-    sLastW = width;
-    sLastH = height;
-  }
-  // Propager fps au processeur
-  if (fps > 0) {
-    sProcessor->setFrameRate((int)fps);
-  }
-  
   // Construire l'état du filtre
   const char* name = NaayaFilters_GetCurrentName();
-  std::string filterName = name ? name : "";
+  const std::string fullName = name ? name : "";
+  std::string filterName = fullName;
   // Normaliser: retirer une éventuelle query (ex: ?interp=)
   auto qpos = filterName.find('?');
   if (qpos != std::string::npos) {
@@ -292,11 +320,94 @@ extern "C" bool NaayaFilters_ProcessBGRA(const uint8_t* inData,
     state.type = Camera::FilterType::WARM;
   } else if (filterName.find("lut3d:") == 0) {
     state.type = Camera::FilterType::CUSTOM;
-    state.params.customFilterName = filterName;
+    // Query conservée : interp= lu par les processeurs LUT natif et FFmpeg
+    state.params.customFilterName = fullName;
   } else {
     return false;
   }
   
+  // Plusieurs étages ponctuels (LUT + eq/hue, exposition/température/teinte) : une LUT
+  // compilée en arrière-plan, la précédente reste utilisée jusqu'à ce qu'elle soit prête
+  {
+    Camera::PointwiseChain chain;
+    chain.adjustments.exposure = adv.exposure;
+    chain.adjustments.warmth = adv.warmth;
+    chain.adjustments.tint = adv.tint;
+    chain.filters.push_back(state);
+    if (Camera::FilterChainCompiler::needsBake(chain)) {
+      static std::mutex sChainMutex;
+      static Camera::FilterChainCompiler sCompiler;
+      static std::string sLastKey;
+      const std::string key = fullName + "|" + std::to_string(state.params.intensity) + "|" +
+                              std::to_string(adv.brightness) + "|" + std::to_string(adv.contrast) + "|" +
+                              std::to_string(adv.saturation) + "|" + std::to_string(adv.hue) + "|" +
+                              std::to_string(adv.gamma) + "|" + std::to_string(adv.exposure) + "|" +
+                              std::to_string(adv.warmth) + "|" + std::to_string(adv.tint);
+      std::lock_guard<std::mutex> lock(sChainMutex);
+      if (key != sLastKey) {
+        sLastKey = key;
+        sCompiler.submit(chain);
+      }
+      if (const auto lut = sCompiler.current()) {
+        lut->applyPacked(inData, inStride, width, height, true, outData, outStride,
+                         Camera::Lut3DInterpolation::TETRAHEDRAL, 1.0f);
+        return true;
+      }
+    }
+  }
+  
+  // Filtres ponctuels : une passe SIMD native, sans graphe FFmpeg ni conversion YUV
+  if (Camera::ColorMatrixFilterProcessor::canCompile(state)) {
+    static std::mutex sNativeMutex;
+    static Camera::ColorMatrixFilterProcessor sNative;
+    std::lock_guard<std::mutex> lock(sNativeMutex);
+    if (!sNative.initialize()) {
+      return false;
+    }
+    return sNative.applyFilterWithStride(state, inData, inStride, width, height,
+                                         "bgra", outData, outStride);
+  }
+  
+  // LUT 3D : interpolation SIMD native, FFmpeg seulement si la LUT n'a pas pu être chargée
+  if (state.type == Camera::FilterType::CUSTOM) {
+    std::lock_guard<std::mutex> lock(g_naaya_lut_mutex);
+    if (naayaLutProcessor().applyFilterWithStride(state, inData, inStride, width, height,
+                                                  "bgra", outData, outStride)) {
+      return true;
+    }
+  }
+  
+#ifndef FFMPEG_AVAILABLE
+  // FFmpeg non disponible sur cette plateforme
+  (void)fps;
+  return false;
+#else
+  // Implémentation FFmpeg (LUT 3D)
+  static std::mutex sMutex;
+  static std::unique_ptr<Camera::FFmpegFilterProcessor> sProcessor;
+  static int sLastW = 0, sLastH = 0;
+  
+  std::lock_guard<std::mutex> lock(sMutex);
+  
+  if (!sProcessor) {
+    sProcessor = std::make_unique<Camera::FFmpegFilterProcessor>();
+    if (!sProcessor->initialize()) {
+      sProcessor.reset();
+      return false;
+    }
+  }
+  
+  // Configurer le format si changé
+  if (width != sLastW || height != sLastH) {
+    sProcessor->setVideoFormat(width, height, "bgra");
+    sLastW = width;
+    sLastH = height;
+  }
+  // Propager fps au processeur
+  if (fps > 0) {
+    sProcessor->setFrameRate((int)fps);
+  }
+  
   // Application sans copies intermédiaires (strides)
   bool ok = sProcessor->applyFilterWithStride(state,
                                               inData,
@@ -83,6 +83,7 @@
 #ifndef __cplusplus
   #include <stdbool.h>
 #endif
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -111,6 +112,13 @@ typedef struct {
 // Remplit outParams avec la dernière valeur des paramètres avancés. Retourne true si dispo.
 bool NaayaFilters_GetAdvancedParams(NaayaAdvancedFilterParams* outParams);
 
+// Répertoire du cache binaire des LUT 3D (.nlut). NULL ou vide : $TMPDIR.
+void NaayaFilters_SetLUTCacheDirectory(const char* directory);
+
+// Charge un .cube (via le cache) en RGBA float, ordre CIColorCube (R le plus rapide).
+// outRGBA NULL : renseigne seulement outSize. capacity en nombre de floats (>= size³ × 4).
+bool NaayaFilters_LoadLUTRGBA(const char* path, float* outRGBA, size_t capacity, int* outSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <numeric>
+#include <unordered_map>
 
 namespace Performance {
 
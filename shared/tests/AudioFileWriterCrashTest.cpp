@@ -0,0 +1,195 @@
+// Arrêt brutal de l'enregistreur : un processus fils écrit au rythme temps réel (accéléré) puis
+// reçoit SIGKILL. Le fichier doit être lisible jusqu'au dernier point de contrôle, puis
+// entièrement après repairHeader(), avec des échantillons identiques au signal envoyé.
+// Disque plein (RLIMIT_FSIZE, EFBIG) : close() doit rendre la main et signaler l'échec.
+#include "TestSupport.h"
+#include "Audio/io/AudioFileWriter.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using AudioIO::AudioFileFormat;
+using AudioIO::AudioFileWriter;
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr int kChannels = 2;
+constexpr double kSpeedFactor = 8.0;    // audio produit = 8 x temps réel
+constexpr double kKillAfterSeconds = 1.0;
+
+// Exactement représentable en 16 bits, reconstructible par index
+int16_t expectedCode(uint64_t frame, int channel) {
+    return static_cast<int16_t>(static_cast<int32_t>((frame * 37 + static_cast<uint64_t>(channel) * 1001) % 65535) - 32767);
+}
+
+uint32_t readLE32(const uint8_t* p) { return p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24); }
+uint64_t readLE64(const uint8_t* p) { return readLE32(p) | (uint64_t(readLE32(p + 4)) << 32); }
+
+// Offset et taille (en-tête) du bloc de données. WAV/W64 écrits par AudioFileWriter : données à 4096.
+bool readDataChunk(const std::string& path, AudioFileFormat format, uint64_t& offset, uint64_t& size) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    uint8_t head[4096];
+    const bool ok = ::pread(fd, head, sizeof(head), 0) == static_cast<ssize_t>(sizeof(head));
+    ::close(fd);
+    if (!ok) return false;
+    offset = 4096;
+    if (format == AudioFileFormat::W64) {
+        if (std::memcmp(head + 4096 - 24, "data", 4) != 0) return false;
+        size = readLE64(head + 4096 - 8) - 24;
+    } else {
+        if (std::memcmp(head + 4096 - 8, "data", 4) != 0) return false;
+        size = readLE32(head + 4096 - 4);
+    }
+    return true;
+}
+
+// Fils : thread "audio" cadencé, jamais fermé proprement
+[[noreturn]] void writeUntilKilled(const std::string& path, AudioFileFormat format) {
+    AudioIO::AudioFileWriterConfig wc;
+    wc.format = format;
+    wc.sampleFormat = AudioIO::SampleFormat::Int16;
+    wc.sampleRate = kRate;
+    wc.numChannels = kChannels;
+    wc.checkpointSeconds = 0.1;
+    AudioFileWriter writer;
+    std::string error;
+    if (!writer.open(path, wc, error)) ::_exit(2);
+    constexpr size_t kBlock = 256;
+    std::vector<float> block(kBlock * kChannels);
+    const auto period = std::chrono::duration<double>(kBlock / (kRate * kSpeedFactor));
+    auto next = std::chrono::steady_clock::now();
+    for (uint64_t frame = 0;; frame += kBlock) {
+        for (size_t i = 0; i < kBlock; ++i) {
+            for (int c = 0; c < kChannels; ++c) block[i * kChannels + c] = expectedCode(frame + i, c) / 32767.0f;
+        }
+        // Trames perdues : le contrôle de contenu échouerait, le fils s'arrête
+        if (!writer.write(block.data(), kBlock)) ::_exit(3);
+        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void checkCrash(AudioFileFormat format, const std::string& path) {
+    ::unlink(path.c_str());
+    const pid_t pid = ::fork();
+    NAAYA_CHECK(pid >= 0);
+    if (pid < 0) return;
+    if (pid == 0) writeUntilKilled(path, format);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(kKillAfterSeconds));
+    ::kill(pid, SIGKILL);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    NAAYA_CHECK(WIFSIGNALED(status));   // sinon le fils s'est arrêté seul (ouverture, trames perdues)
+    if (!WIFSIGNALED(status)) return;
+
+    const uint64_t frameBytes = 2ull * kChannels;
+    uint64_t offset = 0, size = 0;
+    NAAYA_CHECK(readDataChunk(path, format, offset, size));
+    const uint64_t framesAtCheckpoint = size / frameBytes;
+
+    std::string error;
+    NAAYA_CHECK(AudioFileWriter::repairHeader(path, error));
+    NAAYA_CHECK(readDataChunk(path, format, offset, size));
+    const uint64_t framesRecovered = size / frameBytes;
+    std::printf("%s : %llu trames au dernier point de contrôle, %llu après réparation\n",
+                format == AudioFileFormat::W64 ? "W64" : "WAV",
+                static_cast<unsigned long long>(framesAtCheckpoint), static_cast<unsigned long long>(framesRecovered));
+
+    struct stat st;
+    NAAYA_CHECK(::stat(path.c_str(), &st) == 0);
+    NAAYA_CHECK(offset + size <= static_cast<uint64_t>(st.st_size));
+    NAAYA_CHECK(size % frameBytes == 0);
+    NAAYA_CHECK(framesRecovered >= framesAtCheckpoint);
+    // Au moins la moitié de l'audio produit avant le kill
+    NAAYA_CHECK(framesRecovered > static_cast<uint64_t>(kRate * kSpeedFactor * kKillAfterSeconds / 2));
+
+    // Contenu : chaque trame récupérée doit être celle envoyée
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    NAAYA_CHECK(fd >= 0 && ::pread(fd, data.data(), data.size(), static_cast<off_t>(offset)) == static_cast<ssize_t>(data.size()));
+    if (fd >= 0) ::close(fd);
+    uint64_t mismatches = 0;
+    for (uint64_t f = 0; f < framesRecovered; ++f) {
+        for (int c = 0; c < kChannels; ++c) {
+            const uint8_t* p = data.data() + f * frameBytes + 2 * static_cast<uint64_t>(c);
+            if (static_cast<int16_t>(p[0] | (p[1] << 8)) != expectedCode(f, c)) ++mismatches;
+        }
+    }
+    NAAYA_CHECK(mismatches == 0);
+    ::unlink(path.c_str());
+}
+
+// Fils : fichier limité à 64 Kio, écriture jusqu'au premier refus puis close()
+[[noreturn]] void writeUntilFull(const std::string& path) {
+    ::signal(SIGXFSZ, SIG_IGN);
+    rlimit limit{64 * 1024, 64 * 1024};
+    if (::setrlimit(RLIMIT_FSIZE, &limit) != 0) ::_exit(2);
+    AudioIO::AudioFileWriterConfig wc;
+    wc.format = AudioFileFormat::WAV;
+    wc.sampleFormat = AudioIO::SampleFormat::Int16;
+    wc.sampleRate = kRate;
+    wc.numChannels = kChannels;
+    wc.checkpointSeconds = 0.05;
+    AudioFileWriter writer;
+    std::string error;
+    if (!writer.open(path, wc, error)) ::_exit(2);
+    constexpr size_t kBlock = 256;
+    std::vector<float> block(kBlock * kChannels, 0.25f);
+    // File remplie d'avance : un arriéré reste à écrire quand le disque refuse. 10 s au plus.
+    bool refused = false;
+    for (uint64_t frame = 0; frame < kRate * 10 && !refused; frame += kBlock) {
+        if (writer.write(block.data(), kBlock)) continue;
+        refused = !writer.getLastError().empty();   // sinon file pleine : le disque suit
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const bool closed = writer.close();
+    ::_exit(!refused ? 4 : closed ? 5 : 0);
+}
+
+void checkWriteError(const std::string& path) {
+    ::unlink(path.c_str());
+    const pid_t pid = ::fork();
+    NAAYA_CHECK(pid >= 0);
+    if (pid < 0) return;
+    if (pid == 0) writeUntilFull(path);
+
+    int status = 0;
+    pid_t done = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((done = ::waitpid(pid, &status, WNOHANG)) == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (done == 0) {
+        ::kill(pid, SIGKILL);
+        ::waitpid(pid, &status, 0);
+    }
+    std::printf("disque plein : %s\n", done == 0 ? "close() bloqué" : "close() terminé");
+    // 0 : écriture refusée puis close() en échec; 4 : jamais refusée; 5 : close() sans erreur
+    NAAYA_CHECK(done == pid);
+    NAAYA_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    ::unlink(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string suffix = std::to_string(::getpid());
+    checkCrash(AudioFileFormat::WAV, (dir / ("naaya_writer_crash_" + suffix + ".wav")).string());
+    checkCrash(AudioFileFormat::W64, (dir / ("naaya_writer_crash_" + suffix + ".w64")).string());
+    checkWriteError((dir / ("naaya_writer_full_" + suffix + ".wav")).string());
+    return naayaTestResult("AudioFileWriterCrashTest");
+}
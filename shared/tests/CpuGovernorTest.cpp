@@ -0,0 +1,94 @@
+// Gouverneur CPU : un changement de palier réduit réellement le nombre de bandes EQ traitées.
+// La charge est simulée par l'attente injectée (setInjectedDelayUs), comme un coeur bridé.
+#include "TestSupport.h"
+#include "Audio/core/AudioEqualizer.h"
+#include "Audio/safety/CpuGovernor.h"
+#include "Audio/utils/RealtimeScope.h"
+#include <cstdio>
+#include <vector>
+
+using AudioSafety::CpuGovernor;
+using AudioSafety::QualityTier;
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr size_t kFrames = 480;     // 10 ms
+
+struct Chain {
+    CpuGovernor governor{kRate};
+    AudioEqualizer::AudioEqualizer eq{AudioEqualizer::NUM_BANDS, kRate};
+    std::vector<float> buffer = std::vector<float>(kFrames, 0.1f);
+
+    // Même ordre que les bridges : limite du palier courant, DSP, mesure
+    void runBuffer() {
+        AudioEqualizer::RealtimeScope rt;
+        governor.beginBuffer();
+        eq.setBandLimit(CpuGovernor::eqBandLimitFor(governor.tier(), eq.getNumBands()));
+        eq.process(buffer.data(), buffer.data(), kFrames);
+        governor.endBuffer(kFrames);
+    }
+
+    // Jusqu'au palier voulu, puis au-delà du fondu des bandes écartées (20 ms)
+    bool runUntil(QualityTier tier, int maxBuffers) {
+        for (int i = 0; i < maxBuffers; ++i) {
+            runBuffer();
+            if (governor.tier() == tier) {
+                governor.setInjectedDelayUs(0.0);
+                for (int j = 0; j < 5 && governor.tier() == tier; ++j) runBuffer();
+                return governor.tier() == tier;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+int main() {
+    // Limites par palier
+    NAAYA_CHECK(CpuGovernor::eqBandLimitFor(QualityTier::Full, 10) == 0);
+    NAAYA_CHECK(CpuGovernor::eqBandLimitFor(QualityTier::Reduced, 10) == 5);
+    NAAYA_CHECK(CpuGovernor::eqBandLimitFor(QualityTier::Minimal, 10) == 3);
+    NAAYA_CHECK(CpuGovernor::eqBandLimitFor(QualityTier::Minimal, 4) == 2);
+    NAAYA_CHECK(CpuGovernor::eqBandLimitFor(QualityTier::Reduced, 1) == 1);
+
+    Chain chain;
+    AudioSafety::GovernorConfig cfg;
+    cfg.cooldownMs = 30.0;
+    cfg.holdUpMs = 100.0;
+    cfg.smoothingMs = 20.0;
+    chain.governor.setConfig(cfg);
+    for (size_t i = 0; i < chain.eq.getNumBands(); ++i) {
+        chain.eq.setBandGain(i, (i % 2 ? -1.0 : 1.0) * (1.0 + static_cast<double>(i)));
+    }
+
+    for (int i = 0; i < 5; ++i) chain.runBuffer();
+    NAAYA_CHECK(chain.governor.tier() == QualityTier::Full);
+    NAAYA_CHECK(chain.eq.getProcessedBandCount() == 10);
+
+    // Échéance manquée : Full -> Reduced
+    chain.governor.setInjectedDelayUs(12000.0);
+    NAAYA_CHECK(chain.runUntil(QualityTier::Reduced, 20));
+    std::printf("Reduced : %zu bandes\n", chain.eq.getProcessedBandCount());
+    NAAYA_CHECK(chain.eq.getProcessedBandCount() == 5);
+
+    // Reduced -> Minimal
+    chain.governor.setInjectedDelayUs(12000.0);
+    NAAYA_CHECK(chain.runUntil(QualityTier::Minimal, 20));
+    std::printf("Minimal : %zu bandes\n", chain.eq.getProcessedBandCount());
+    NAAYA_CHECK(chain.eq.getProcessedBandCount() == 3);
+
+    // Charge retombée : remontée lente jusqu'à Full, toutes les bandes reviennent
+    bool full = false;
+    for (int i = 0; i < 200 && !full; ++i) {
+        chain.runBuffer();
+        full = chain.governor.tier() == QualityTier::Full;
+    }
+    NAAYA_CHECK(full);
+    chain.runBuffer();
+    NAAYA_CHECK(chain.eq.getProcessedBandCount() == 10);
+    NAAYA_CHECK(chain.governor.tierChanges() == 4);
+
+    return naayaTestResult("CpuGovernorTest");
+}
@@ -0,0 +1,130 @@
+// Dénormaux et tripwires : les filtres récursifs n'ont plus de test par échantillon, chaque
+// point d'entrée du traitement doit donc ouvrir FTZ/DAZ. Une queue de silence après un signal
+// laisse l'état des biquads décroître vers les dénormaux : sans FTZ, le coût par bloc explose.
+#include "TestSupport.h"
+#include "Audio/core/AudioEqualizer.h"
+#include "Audio/mixer/Mixer.h"
+#include "Audio/utils/RealtimeScope.h"
+#include <chrono>
+#include <functional>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using AudioEqualizer::DenormalScope;
+using AudioEqualizer::RealtimeScope;
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr size_t kBlock = 512;
+constexpr int kTailBlocks = 3000;       // 32 s de silence : l'état le plus lent atteint les dénormaux
+constexpr double kMaxTailRatio = 4.0;   // sans FTZ, > 30x mesuré sur x86
+
+template <typename Fn>
+double microsPerBlock(int blocks, Fn&& fn) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / blocks;
+}
+
+void setGains(AudioEqualizer::AudioEqualizer& eq) {
+    for (size_t i = 0; i < eq.getNumBands(); ++i) eq.setBandGain(i, (i % 2) ? 6.0 : -6.0);
+}
+
+std::vector<float> noise(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    std::vector<float> x(n);
+    for (auto& v : x) v = dist(rng);
+    return x;
+}
+
+// Coût d'un bloc de queue de silence rapporté à un bloc de bruit
+double tailRatio(const std::function<void(const std::vector<float>&)>& process) {
+    const auto signal = noise(kBlock, 7);
+    const std::vector<float> silence(kBlock, 0.0f);
+    const double signalUs = microsPerBlock(400, [&] { process(signal); });
+    microsPerBlock(kTailBlocks, [&] { process(silence); });
+    const double tailUs = microsPerBlock(400, [&] { process(silence); });
+    return tailUs / signalUs;
+}
+
+uint64_t g_violations = 0;
+void countViolation(const AudioEqualizer::RealtimeViolation&) { ++g_violations; }
+
+} // namespace
+
+int main() {
+    // Thread de test : FTZ désactivé au départ (point d'entrée non protégé par défaut)
+    NAAYA_CHECK(!DenormalScope::flushToZeroActive());
+
+    // EQ sous DenormalScope (processAudio JSI, rendu hors ligne)
+    {
+        AudioEqualizer::AudioEqualizer eq(10, kRate);
+        setGains(eq);
+        std::vector<float> out(kBlock);
+        const double ratio = tailRatio([&](const std::vector<float>& in) {
+            DenormalScope ftz;
+            eq.process(in.data(), out.data(), in.size());
+        });
+        std::printf("EQ sous DenormalScope : queue/signal = %.2f\n", ratio);
+        NAAYA_CHECK(ratio < kMaxTailRatio);
+        NAAYA_CHECK(!DenormalScope::flushToZeroActive());   // état FP restauré
+    }
+
+    // Mixer appelé depuis un thread quelconque (le thread appelant rend des pistes)
+    for (size_t workers : {size_t(0), size_t(2)}) {
+        AudioMixer::Mixer mixer(kRate, kBlock, workers);
+        for (int t = 0; t < 3; ++t) setGains(mixer.getTrack(mixer.addTrack())->getEqualizer());
+        std::vector<float> outL(kBlock), outR(kBlock);
+        const double ratio = tailRatio([&](const std::vector<float>& in) {
+            AudioMixer::TrackInput inputs[3];
+            for (auto& input : inputs) input.left = in.data();
+            mixer.process(inputs, 3, outL.data(), outR.data(), in.size());
+        });
+        std::printf("Mixer (%zu workers) : queue/signal = %.2f\n", workers, ratio);
+        NAAYA_CHECK(ratio < kMaxTailRatio);
+        NAAYA_CHECK(!DenormalScope::flushToZeroActive());
+    }
+
+    // Tripwires : actifs dans une RealtimeScope, muets sous DenormalScope
+    NAAYA_CHECK(RealtimeScope::tripwiresEnabled());
+    RealtimeScope::setViolationHandler(&countViolation);
+    {
+        AudioEqualizer::AudioEqualizer eq(10, kRate);
+        setGains(eq);
+        AudioMixer::Mixer mixer(kRate, kBlock, 2);
+        setGains(mixer.getTrack(mixer.addTrack())->getEqualizer());
+        const auto in = noise(kBlock, 3);
+        std::vector<float> outL(kBlock), outR(kBlock);
+        AudioMixer::TrackInput input;
+        input.left = in.data();
+
+        g_violations = 0;
+        {
+            RealtimeScope rt;
+            NAAYA_CHECK(DenormalScope::flushToZeroActive());
+            for (int b = 0; b < 50; ++b) {
+                eq.process(in.data(), outL.data(), kBlock);
+                mixer.process(&input, 1, outL.data(), outR.data(), kBlock);
+            }
+        }
+        NAAYA_CHECK(g_violations == 0);
+
+        {
+            RealtimeScope rt;
+            delete new int(1);          // allocation + libération signalées
+        }
+        NAAYA_CHECK(g_violations == 2);
+
+        {
+            DenormalScope ftz;
+            delete new int(2);          // hors section temps réel : autorisé
+        }
+        NAAYA_CHECK(g_violations == 2);
+    }
+    RealtimeScope::setViolationHandler(nullptr);
+
+    return naayaTestResult("DenormalTest");
+}
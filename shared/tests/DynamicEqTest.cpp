@@ -0,0 +1,90 @@
+// Bande dynamique : un sinus à la fréquence de la bande, au-dessus du seuil, est atténué de
+// (niveau - seuil) * (1 - 1/ratio), borné à rangeDb; sous le seuil, il passe inchangé.
+// Attaque = relâchement : l'enveloppe se stabilise sur la moyenne redressée 2A/pi.
+#include "TestSupport.h"
+#include "Audio/core/AudioEqualizer.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr size_t kBlock = 256;
+constexpr size_t kBand = 5;          // 1 kHz
+constexpr double kFrequency = 1000.0;
+constexpr double kPi = 3.14159265358979323846;
+
+struct Result {
+    double gainDb;       // sortie / entrée, en RMS, une fois l'enveloppe établie
+    double maxDiff;      // écart maximal échantillon par échantillon
+};
+
+Result run(double amplitudeDb, const AudioEqualizer::EQDynamicParams& dyn) {
+    AudioEqualizer::AudioEqualizer eq(AudioEqualizer::NUM_BANDS, kRate);
+    eq.setMasterGain(0.0);          // valeur initiale : 1 dB
+    eq.setBandDynamics(kBand, dyn);
+
+    const double amplitude = std::pow(10.0, amplitudeDb / 20.0);
+    std::vector<float> in(kBlock), out(kBlock);
+    double inEnergy = 0.0, outEnergy = 0.0, maxDiff = 0.0;
+    size_t phase = 0;
+    const size_t blocks = 2 * kRate / kBlock;   // 2 s, mesure sur la seconde
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t i = 0; i < kBlock; ++i, ++phase) {
+            in[i] = static_cast<float>(amplitude * std::sin(2.0 * kPi * kFrequency * phase / kRate));
+        }
+        eq.process(in.data(), out.data(), kBlock);
+        if (b < blocks / 2) continue;
+        for (size_t i = 0; i < kBlock; ++i) {
+            inEnergy += static_cast<double>(in[i]) * in[i];
+            outEnergy += static_cast<double>(out[i]) * out[i];
+            maxDiff = std::max(maxDiff, static_cast<double>(std::abs(out[i] - in[i])));
+        }
+    }
+    return { 10.0 * std::log10(outEnergy / inEnergy), maxDiff };
+}
+
+double expectedReductionDb(double amplitudeDb, const AudioEqualizer::EQDynamicParams& dyn) {
+    const double levelDb = amplitudeDb + 20.0 * std::log10(2.0 / kPi);
+    if (levelDb <= dyn.thresholdDb) return 0.0;
+    return std::min(dyn.rangeDb, (levelDb - dyn.thresholdDb) * (1.0 - 1.0 / dyn.ratio));
+}
+
+AudioEqualizer::EQDynamicParams params(double thresholdDb, double ratio, double rangeDb) {
+    AudioEqualizer::EQDynamicParams p;
+    p.enabled = true;
+    p.thresholdDb = thresholdDb;
+    p.ratio = ratio;
+    p.attackMs = 50.0;
+    p.releaseMs = 50.0;
+    p.rangeDb = rangeDb;
+    return p;
+}
+
+} // namespace
+
+int main() {
+    // Au-dessus du seuil, régime ratio : -12 dBFS crête, seuil -30, ratio 4 -> ~10.6 dB
+    const auto ratioParams = params(-30.0, 4.0, 24.0);
+    const Result ratio = run(-12.0, ratioParams);
+    const double ratioExpected = expectedReductionDb(-12.0, ratioParams);
+    std::printf("ratio : %.2f dB (attendu %.2f dB)\n", ratio.gainDb, -ratioExpected);
+    NAAYA_CHECK(ratioExpected > 6.0);
+    NAAYA_CHECK_NEAR(ratio.gainDb, -ratioExpected, 0.5);
+
+    // Régime borné : ratio 20, la réduction s'arrête à rangeDb
+    const auto rangeParams = params(-40.0, 20.0, 6.0);
+    const Result range = run(-12.0, rangeParams);
+    std::printf("plage : %.2f dB (attendu %.2f dB)\n", range.gainDb, -rangeParams.rangeDb);
+    NAAYA_CHECK_NEAR(range.gainDb, -rangeParams.rangeDb, 0.5);
+
+    // Sous le seuil : gain statique 0 dB, sortie identique à l'entrée
+    const Result below = run(-40.0, ratioParams);
+    std::printf("sous le seuil : %.3f dB, écart max %.2e\n", below.gainDb, below.maxDiff);
+    NAAYA_CHECK(expectedReductionDb(-40.0, ratioParams) == 0.0);
+    NAAYA_CHECK_NEAR(below.gainDb, 0.0, 0.01);
+    NAAYA_CHECK(below.maxDiff < 1e-5);
+
+    return naayaTestResult("DynamicEqTest");
+}
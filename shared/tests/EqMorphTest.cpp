@@ -0,0 +1,70 @@
+// Morphing de preset : la fin du fondu applique les coefficients exacts de la cible, précalculés
+// par startMorph sur le thread de contrôle (aucun calcul de coefficients sur le thread audio).
+#include "TestSupport.h"
+#include "Audio/core/AudioEqualizer.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr size_t kBlock = 256;
+
+AudioEqualizer::EQPreset preset(double scale) {
+    AudioEqualizer::EQPreset p;
+    p.name = "test";
+    for (size_t i = 0; i < AudioEqualizer::NUM_BANDS; ++i) {
+        // Gains hors de la grille de 0.25 dB : jamais obtenus pendant le fondu
+        p.gains.push_back(scale * (static_cast<double>(i) - 4.5) * 1.37);
+    }
+    return p;
+}
+
+} // namespace
+
+int main() {
+    AudioEqualizer::AudioEqualizer morphed(AudioEqualizer::NUM_BANDS, kRate);
+    AudioEqualizer::AudioEqualizer direct(AudioEqualizer::NUM_BANDS, kRate);
+    const AudioEqualizer::EQPreset from = preset(1.0);
+    const AudioEqualizer::EQPreset to = preset(-0.8);
+    for (size_t i = 0; i < to.gains.size(); ++i) direct.setBandGain(i, to.gains[i]);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    std::vector<float> in(kBlock), outA(kBlock), outB(kBlock);
+    auto fill = [&] { for (auto& v : in) v = dist(rng); };
+
+    fill();
+    morphed.process(in.data(), outA.data(), kBlock);
+    morphed.morphPresets(from, to, 100.0);
+    NAAYA_CHECK(morphed.isMorphing());
+
+    // Toutes les cibles sont en cache dès startMorph : plus aucun défaut jusqu'à la fin
+    const uint64_t missesAfterStart = morphed.getCoefficientCacheMisses();
+    int blocks = 0;
+    while (morphed.isMorphing() && blocks < 1000) {
+        fill();
+        morphed.process(in.data(), outA.data(), kBlock);
+        ++blocks;
+    }
+    NAAYA_CHECK(!morphed.isMorphing());
+    NAAYA_CHECK(blocks >= 18);        // 100 ms = 4800 échantillons
+    NAAYA_CHECK(morphed.getCoefficientCacheMisses() == missesAfterStart);
+    for (size_t i = 0; i < to.gains.size(); ++i) NAAYA_CHECK(morphed.getBandGain(i) == to.gains[i]);
+
+    // Même réponse qu'un égaliseur réglé directement sur la cible, une fois les états convergés
+    double maxDiff = 0.0;
+    for (int b = 0; b < 400; ++b) {
+        fill();
+        morphed.process(in.data(), outA.data(), kBlock);
+        direct.process(in.data(), outB.data(), kBlock);
+        if (b < 200) continue;
+        for (size_t i = 0; i < kBlock; ++i) {
+            maxDiff = std::max(maxDiff, static_cast<double>(std::abs(outA[i] - outB[i])));
+        }
+    }
+    NAAYA_CHECK(maxDiff < 1e-5);
+
+    return naayaTestResult("EqMorphTest");
+}
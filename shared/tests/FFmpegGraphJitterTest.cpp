@@ -0,0 +1,120 @@
+// Curseur sépia déplacé à 60 Hz : les paramètres passent par avfilter_process_command sans
+// reconstruire le graphe, la teinte ajoutée au troisième quart (changement de topologie) est
+// construite hors du thread image. Gigue et images hors budget bornées; la dernière image doit
+// être celle d'un graphe neuf aux mêmes paramètres. Sans FFmpeg : rien à mesurer, test passant.
+// Temps CPU du thread image, graphe sur ce seul thread : mesure insensible aux préemptions de
+// l'hôte. Petit format : le filtre lui-même reste loin du budget sur une machine lente.
+#include "TestSupport.h"
+#include "Camera/filters/FFmpegFilterProcessor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using namespace Camera;
+
+#ifdef FFMPEG_AVAILABLE
+namespace {
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 180;
+constexpr int kStride = kWidth * 4;
+constexpr int kFps = 60;
+constexpr int kFrames = 180;
+constexpr double kBudgetMs = 1000.0 / kFps;
+constexpr double kMaxJitterMs = kBudgetMs / 8;     // écart-type du temps par image
+constexpr int kMaxMissedFrames = kFrames / 20;     // 5 % au-delà du budget
+constexpr double kPi = 3.14159265358979323846;
+
+FilterState dragState(int f) {
+    FilterParams params;
+    params.intensity = 0.5 + 0.4 * std::sin(2.0 * kPi * f / kFps);
+    params.hue = (f >= kFrames / 2 && f < kFrames * 3 / 4) ? 20.0 : 0.0;
+    return FilterState(FilterType::SEPIA, params);
+}
+
+double threadCpuMs() {
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+} // namespace
+#endif
+
+int main() {
+#ifndef FFMPEG_AVAILABLE
+    std::printf("FFmpeg non disponible : gigue non mesurée\n");
+#else
+    std::vector<uint8_t> input(static_cast<size_t>(kStride) * kHeight);
+    for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<uint8_t>((i * 7 + (i >> 9) * 13) & 0xFF);
+    std::vector<uint8_t> output(input.size());
+
+    FFmpegFilterProcessor processor;
+    NAAYA_CHECK(processor.initialize());
+    processor.setFrameRate(kFps);
+    processor.setVideoFormat(kWidth, kHeight, "bgra");
+    processor.setLiveParameterUpdates(true);
+    processor.setGraphThreads(1);
+
+    std::vector<double> times;
+    times.reserve(kFrames);
+    int missed = 0;
+    int framesUntilSwap = -1;
+    uint64_t swapsAtChange = 0;
+    const auto period = std::chrono::nanoseconds(1000000000LL / kFps);
+    const auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        std::this_thread::sleep_until(start + period * f);
+        const double t0 = threadCpuMs();
+        const bool ok = processor.applyFilterWithStride(dragState(f), input.data(), kStride, kWidth, kHeight,
+                                                        "bgra", output.data(), kStride);
+        const double ms = threadCpuMs() - t0;
+        NAAYA_CHECK(ok);
+        if (!ok) return naayaTestResult("FFmpegGraphJitterTest");
+        times.push_back(ms);
+        if (ms > kBudgetMs) ++missed;
+        if (f == kFrames / 2) swapsAtChange = processor.getGraphStats().swaps;
+        if (f > kFrames / 2 && framesUntilSwap < 0 && processor.getGraphStats().swaps > swapsAtChange) {
+            framesUntilSwap = f - kFrames / 2;
+        }
+    }
+
+    double mean = 0.0;
+    for (double t : times) mean += t;
+    mean /= times.size();
+    double var = 0.0;
+    for (double t : times) var += (t - mean) * (t - mean);
+    const double jitter = std::sqrt(var / times.size());
+    const double maxMs = *std::max_element(times.begin(), times.end());
+    const FFmpegGraphStats stats = processor.getGraphStats();
+    std::printf("moy %.2f ms, gigue %.2f ms, max %.2f ms, %d/%d hors budget, %llu commandes, "
+                "%llu sync, %llu async, échange après %d images\n",
+                mean, jitter, maxMs, missed, kFrames, static_cast<unsigned long long>(stats.commandsSent),
+                static_cast<unsigned long long>(stats.syncBuilds), static_cast<unsigned long long>(stats.asyncBuilds),
+                framesUntilSwap);
+
+    NAAYA_CHECK(jitter <= kMaxJitterMs);
+    NAAYA_CHECK(missed <= kMaxMissedFrames);
+    // Curseur : commandes seulement; seul le premier graphe est construit sur le thread image
+    NAAYA_CHECK(stats.commandsSent >= static_cast<uint64_t>(kFrames / 2));
+    NAAYA_CHECK(stats.syncBuilds == 1);
+    NAAYA_CHECK(stats.asyncBuilds >= 1);
+    NAAYA_CHECK(framesUntilSwap >= 0 && framesUntilSwap <= kFps / 4);
+
+    // Paramètres appliqués : identique à un graphe construit directement
+    FFmpegFilterProcessor fresh;
+    NAAYA_CHECK(fresh.initialize());
+    fresh.setFrameRate(kFps);
+    std::vector<uint8_t> reference(input.size());
+    NAAYA_CHECK(fresh.applyFilterWithStride(dragState(kFrames - 1), input.data(), kStride, kWidth, kHeight,
+                                            "bgra", reference.data(), kStride));
+    int maxDiff = 0;
+    for (size_t i = 0; i < output.size(); ++i) maxDiff = std::max(maxDiff, std::abs(int(output[i]) - int(reference[i])));
+    NAAYA_CHECK(maxDiff <= 1);
+#endif
+    return naayaTestResult("FFmpegGraphJitterTest");
+}
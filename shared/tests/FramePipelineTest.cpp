@@ -0,0 +1,324 @@
+// FramePipeline : ordre de soumission conservé à chaque étape, remplacement de l'image la plus
+// ancienne en drop-oldest, contre-pression et refus après délai en Block, enregistrement vidé à
+// l'arrêt, arrêt pendant une attente Block, échec d'étape, arrêt sans vidage. Chaque image soumise est libérée une seule fois, avec la bonne issue.
+#include "TestSupport.h"
+#include "Camera/pipeline/FramePipeline.hpp"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Camera;
+
+namespace {
+
+void sleepMs(double ms) {
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms));
+}
+
+void* imageFor(uint64_t n) { return reinterpret_cast<void*>(static_cast<uintptr_t>(n + 1)); }
+
+// Issues reçues par le callback de libération (producteur pour Dropped, dernière étape sinon),
+// repérées par l'horodatage : numéro de soumission, refusées comprises
+struct Releases {
+    std::mutex mutex;
+    std::vector<uint64_t> completed;
+    std::vector<uint64_t> dropped;
+    std::vector<uint64_t> failed;
+    std::vector<uint64_t> flushed;
+    bool imagesIntact{true};
+
+    FramePipeline::ReleaseFn callback() {
+        return [this](PipelineFrame& frame, FrameOutcome outcome) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const uint64_t n = static_cast<uint64_t>(frame.timestampNs);
+            imagesIntact = imagesIntact && frame.image == imageFor(n);
+            switch (outcome) {
+                case FrameOutcome::Completed: completed.push_back(n); break;
+                case FrameOutcome::Dropped: dropped.push_back(n); break;
+                case FrameOutcome::Failed: failed.push_back(n); break;
+                case FrameOutcome::Flushed: flushed.push_back(n); break;
+            }
+        };
+    }
+};
+
+bool strictlyIncreasing(const std::vector<uint64_t>& v) {
+    for (size_t i = 1; i < v.size(); ++i) {
+        if (v[i] <= v[i - 1]) return false;
+    }
+    return true;
+}
+
+// Trois étapes de durées variables, chacune voit toutes les images dans l'ordre
+void checkOrdering() {
+    constexpr int kFrames = 200;
+    FramePipelineConfig config;
+    config.name = "ordre";
+    config.depth = 3;
+    config.policy = FrameDropPolicy::Block;
+    FramePipeline pipeline(config);
+    std::vector<uint64_t> seen[3];
+    bool outputsChained = true;
+    for (int s = 0; s < 3; ++s) {
+        pipeline.addStage("étape", [s, &seen, &outputsChained](PipelineFrame& frame) {
+            if (s > 0) outputsChained = outputsChained && frame.output == imageFor(frame.sequence + s * 1000);
+            seen[s].push_back(frame.sequence);
+            frame.output = imageFor(frame.sequence + (s + 1) * 1000);
+            sleepMs(((frame.sequence * 7 + s * 3) % 5) * 0.2);
+            return true;
+        });
+    }
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    for (int i = 0; i < kFrames; ++i) NAAYA_CHECK(pipeline.submit(imageFor(i), i));
+    pipeline.stop(true);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    for (const auto& stage : seen) {
+        NAAYA_CHECK(stage.size() == static_cast<size_t>(kFrames));
+        NAAYA_CHECK(strictlyIncreasing(stage));
+    }
+    NAAYA_CHECK(outputsChained);
+    NAAYA_CHECK(releases.imagesIntact);
+    NAAYA_CHECK(releases.completed.size() == static_cast<size_t>(kFrames));
+    NAAYA_CHECK(strictlyIncreasing(releases.completed));
+    NAAYA_CHECK(stats.completed == static_cast<uint64_t>(kFrames));
+    NAAYA_CHECK(stats.dropped == 0 && stats.rejected == 0 && stats.failed == 0);
+    NAAYA_CHECK(stats.maxInFlight <= config.depth);
+    NAAYA_CHECK(stats.inFlight == 0);
+}
+
+// Aperçu : capteur à 1 ms, filtre à 5 ms. Les images en attente sont remplacées, jamais
+// réordonnées; la plus récente passe toujours.
+void checkDropOldest() {
+    constexpr int kFrames = 100;
+    FramePipelineConfig config;
+    config.name = "drop-oldest";
+    config.depth = 2;
+    config.policy = FrameDropPolicy::DropOldest;
+    FramePipeline pipeline(config);
+    pipeline.addStage("filtre", [](PipelineFrame&) { sleepMs(5.0); return true; });
+    pipeline.addStage("affichage", [](PipelineFrame&) { return true; });
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    int accepted = 0;
+    bool lastAccepted = false;
+    for (int i = 0; i < kFrames; ++i) {
+        lastAccepted = pipeline.submit(imageFor(i), i);
+        if (lastAccepted) ++accepted;
+        sleepMs(1.0);
+    }
+    pipeline.stop(true);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    std::printf("drop-oldest : %llu livrées, %llu remplacées, %llu refusées sur %d\n",
+                static_cast<unsigned long long>(stats.completed), static_cast<unsigned long long>(stats.dropped),
+                static_cast<unsigned long long>(stats.rejected), kFrames);
+    NAAYA_CHECK(stats.submitted == static_cast<uint64_t>(kFrames));
+    NAAYA_CHECK(stats.dropped > 0);
+    NAAYA_CHECK(stats.completed + stats.dropped == static_cast<uint64_t>(accepted));
+    NAAYA_CHECK(stats.completed + stats.dropped + stats.rejected == stats.submitted);
+    NAAYA_CHECK(releases.dropped.size() == stats.dropped);
+    NAAYA_CHECK(releases.completed.size() == stats.completed);
+    NAAYA_CHECK(strictlyIncreasing(releases.completed));
+    NAAYA_CHECK(strictlyIncreasing(releases.dropped));
+    NAAYA_CHECK(releases.imagesIntact);
+    NAAYA_CHECK(stats.maxInFlight <= config.depth);
+    NAAYA_CHECK(stats.backpressureWaits == 0);
+    // Dernière image acceptée : jamais remplacée, donc livrée
+    NAAYA_CHECK(!lastAccepted || (!releases.completed.empty() && releases.completed.back() == kFrames - 1));
+}
+
+// Enregistrement : producteur plus rapide que l'encodeur, il attend une place sans rien perdre
+void checkBackpressure() {
+    constexpr int kFrames = 50;
+    constexpr double kStageMs = 4.0;
+    FramePipelineConfig config;
+    config.name = "contre-pression";
+    config.depth = 2;
+    config.policy = FrameDropPolicy::Block;
+    config.blockTimeoutMs = 1000;
+    FramePipeline pipeline(config);
+    pipeline.addStage("encodage", [](PipelineFrame&) { sleepMs(kStageMs); return true; });
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFrames; ++i) NAAYA_CHECK(pipeline.submit(imageFor(i), i));
+    const double submitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    pipeline.stop(true);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    std::printf("contre-pression : %llu attentes, %.1f ms attendues, soumission %.1f ms\n",
+                static_cast<unsigned long long>(stats.backpressureWaits), stats.backpressureMs, submitMs);
+    NAAYA_CHECK(stats.completed == static_cast<uint64_t>(kFrames));
+    NAAYA_CHECK(stats.dropped == 0 && stats.rejected == 0);
+    NAAYA_CHECK(stats.backpressureWaits >= static_cast<uint64_t>(kFrames - config.depth - 1));
+    NAAYA_CHECK(stats.backpressureMs > 0.0);
+    // Le producteur avance au rythme de l'encodeur
+    NAAYA_CHECK(submitMs >= (kFrames - config.depth - 1) * kStageMs * 0.9);
+    NAAYA_CHECK(releases.completed.size() == static_cast<size_t>(kFrames));
+    NAAYA_CHECK(strictlyIncreasing(releases.completed));
+    NAAYA_CHECK(stats.maxInFlight <= config.depth);
+
+    // Délai dépassé : image refusée, rendue à l'appelant sans callback
+    FramePipelineConfig slowConfig = config;
+    slowConfig.depth = 1;
+    slowConfig.blockTimeoutMs = 10;
+    FramePipeline slow(slowConfig);
+    slow.addStage("encodage", [](PipelineFrame&) { sleepMs(100.0); return true; });
+    Releases slowReleases;
+    slow.setReleaseCallback(slowReleases.callback());
+    NAAYA_CHECK(slow.start());
+    NAAYA_CHECK(slow.submit(imageFor(0), 0));
+    NAAYA_CHECK(!slow.submit(imageFor(1), 1));
+    slow.stop(true);
+    const FramePipelineStats slowStats = slow.getStats();
+    NAAYA_CHECK(slowStats.rejected == 1);
+    NAAYA_CHECK(slowStats.completed == 1);
+    NAAYA_CHECK(slowReleases.completed.size() == 1 && slowReleases.dropped.empty());
+}
+
+// Enregistreur iOS : filtre puis encodage, Block, stop(true) en fin d'enregistrement. Capture à
+// 30 fps par rafales, encodage parfois plus lent qu'une période : toutes les images acceptées
+// sont encodées dans l'ordre, y compris celles encore en vol à l'arrêt.
+void checkRecording() {
+    constexpr int kFrames = 90;
+    FramePipelineConfig config;
+    config.name = "enregistrement";
+    config.depth = 3;
+    config.policy = FrameDropPolicy::Block;
+    config.blockTimeoutMs = 2000 / 30;
+    FramePipeline pipeline(config);
+    std::vector<uint64_t> encoded;
+    pipeline.addStage("filtre", [](PipelineFrame& frame) {
+        sleepMs(frame.sequence % 10 == 0 ? 12.0 : 2.0);
+        frame.output = imageFor(frame.timestampNs + 1000);
+        return true;
+    });
+    pipeline.addStage("encodage", [&encoded](PipelineFrame& frame) {
+        if (frame.output != imageFor(frame.timestampNs + 1000)) return false;
+        sleepMs(frame.sequence % 15 == 0 ? 40.0 : 3.0);
+        encoded.push_back(static_cast<uint64_t>(frame.timestampNs));
+        return true;
+    });
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    int accepted = 0;
+    for (int i = 0; i < kFrames; ++i) {
+        if (pipeline.submit(imageFor(i), i)) ++accepted;
+        // Rafales de cinq images, 30 fps en moyenne; arrêt juste après la dernière rafale
+        if (i % 5 == 4 && i + 1 < kFrames) sleepMs(500.0 / 3.0);
+    }
+    pipeline.stop(true);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    std::printf("enregistrement : %zu encodées, %llu refusées, %llu attentes\n", encoded.size(),
+                static_cast<unsigned long long>(stats.rejected), static_cast<unsigned long long>(stats.backpressureWaits));
+    NAAYA_CHECK(stats.rejected == 0);
+    NAAYA_CHECK(accepted == kFrames);
+    NAAYA_CHECK(encoded.size() == static_cast<size_t>(kFrames));
+    NAAYA_CHECK(strictlyIncreasing(encoded));
+    NAAYA_CHECK(stats.dropped == 0 && stats.failed == 0 && stats.flushed == 0);
+    NAAYA_CHECK(releases.completed.size() == static_cast<size_t>(kFrames));
+    NAAYA_CHECK(releases.imagesIntact);
+    NAAYA_CHECK(stats.backpressureWaits > 0);
+    NAAYA_CHECK(stats.inFlight == 0);
+}
+
+// stop(true) pendant qu'un producteur Block attend une place : son délai expire avant la fin de
+// l'image en vol, stop() doit tout de même être réveillé à la libération
+void checkStopWhileBlocked() {
+    FramePipelineConfig config;
+    config.name = "arrêt-bloqué";
+    config.depth = 1;
+    config.policy = FrameDropPolicy::Block;
+    config.blockTimeoutMs = 10;
+    FramePipeline pipeline(config);
+    pipeline.addStage("encodage", [](PipelineFrame&) { sleepMs(50.0); return true; });
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    bool secondAccepted = true;
+    std::thread producer([&] {
+        pipeline.submit(imageFor(0), 0);
+        secondAccepted = pipeline.submit(imageFor(1), 1);
+    });
+    sleepMs(3.0);
+    const auto t0 = std::chrono::steady_clock::now();
+    pipeline.stop(true);
+    const double stopMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    producer.join();
+
+    const FramePipelineStats stats = pipeline.getStats();
+    std::printf("arrêt pendant l'attente : %.1f ms\n", stopMs);
+    NAAYA_CHECK(stopMs < config.drainTimeoutMs / 2.0);
+    NAAYA_CHECK(!secondAccepted);
+    NAAYA_CHECK(stats.completed == 1 && stats.flushed == 0);
+    NAAYA_CHECK(releases.completed.size() == 1);
+}
+
+// Étape en échec : étapes suivantes sautées, issue Failed
+void checkFailure() {
+    constexpr int kFrames = 20;
+    FramePipelineConfig config;
+    config.name = "échec";
+    config.policy = FrameDropPolicy::Block;
+    FramePipeline pipeline(config);
+    int secondStageFrames = 0;
+    pipeline.addStage("filtre", [](PipelineFrame& frame) { return frame.sequence % 2 == 0; });
+    pipeline.addStage("encodage", [&secondStageFrames](PipelineFrame&) { ++secondStageFrames; return true; });
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    for (int i = 0; i < kFrames; ++i) NAAYA_CHECK(pipeline.submit(imageFor(i), i));
+    pipeline.stop(true);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    NAAYA_CHECK(stats.failed == kFrames / 2 && stats.completed == kFrames / 2);
+    NAAYA_CHECK(secondStageFrames == kFrames / 2);
+    NAAYA_CHECK(releases.failed.size() == kFrames / 2);
+    for (uint64_t sequence : releases.failed) NAAYA_CHECK(sequence % 2 == 1);
+    NAAYA_CHECK(stats.stages.size() == 2 && stats.stages[0].failed == kFrames / 2);
+}
+
+// Arrêt sans vidage : images en attente libérées en Flushed, chacune une fois
+void checkFlush() {
+    FramePipelineConfig config;
+    config.name = "arrêt";
+    config.depth = 4;
+    config.policy = FrameDropPolicy::Block;
+    FramePipeline pipeline(config);
+    pipeline.addStage("filtre", [](PipelineFrame&) { sleepMs(20.0); return true; });
+    Releases releases;
+    pipeline.setReleaseCallback(releases.callback());
+    NAAYA_CHECK(pipeline.start());
+    for (int i = 0; i < config.depth; ++i) NAAYA_CHECK(pipeline.submit(imageFor(i), i));
+    sleepMs(5.0);
+    pipeline.stop(false);
+
+    const FramePipelineStats stats = pipeline.getStats();
+    NAAYA_CHECK(stats.flushed > 0);
+    NAAYA_CHECK(stats.completed + stats.flushed == static_cast<uint64_t>(config.depth));
+    NAAYA_CHECK(releases.completed.size() + releases.flushed.size() == static_cast<size_t>(config.depth));
+    NAAYA_CHECK(stats.inFlight == 0);
+    NAAYA_CHECK(!pipeline.submit(imageFor(config.depth), config.depth));
+}
+
+} // namespace
+
+int main() {
+    checkOrdering();
+    checkDropOldest();
+    checkBackpressure();
+    checkRecording();
+    checkStopWhileBlocked();
+    checkFailure();
+    checkFlush();
+    return naayaTestResult("FramePipelineTest");
+}
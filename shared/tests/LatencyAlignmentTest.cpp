@@ -0,0 +1,280 @@
+// Alignement à l'échantillon des étages à retard, sans appareil.
+//
+// Entrée : impulsions espacées aléatoirement (5 à 12 ms), le retard mesuré est le pic de
+// la corrélation sortie / positions des impulsions, non ambigu. Vérifie :
+// - chaque moteur NR seul (expander, NR spectrale, RNNoise si lié : sinon passe-tout, 0);
+// - la chaîne compensée (CompensationDelay) pour chaque palier, puis après un changement
+//   de palier en cours de flux : le retard reste celui de noiseChainLatency();
+// - la sortie enregistrée, recalée du retard total (premières trames ignorées);
+// - le mode faible latence : moteur retenu par budget et retard de la chaîne obtenue.
+// Tailles de blocs irrégulières : le retard ne doit pas dépendre du découpage.
+#include "TestSupport.h"
+#include "Audio/noise/NoiseReducer.h"
+#include "Audio/noise/RNNoiseSuppressor.h"
+#include "Audio/noise/SpectralNR.h"
+#include "Audio/safety/CpuGovernor.h"
+#include "Audio/utils/CompensationDelay.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using AudioNR::NoiseReducer;
+using AudioNR::NoiseReducerConfig;
+using AudioNR::RNNoiseSuppressor;
+using AudioNR::SpectralNR;
+using AudioNR::SpectralNRConfig;
+using AudioSafety::CpuGovernor;
+using AudioSafety::NoiseEngine;
+using AudioSafety::NoiseEngineLatency;
+using AudioSafety::QualityTier;
+
+constexpr double kMinPeakRatio = 2.0;   // pic nettement au-dessus du second meilleur retard
+
+struct LatencyCheckResult {
+    std::string name;
+    size_t reportedSamples = 0;     // getLatencySamples() / retard de chaîne attendu
+    long measuredSamples = -1;      // pic de corrélation avec les impulsions d'entrée
+    double peakRatio = 0.0;         // pic / second meilleur retard (netteté de la mesure)
+    bool aligned = false;           // mesuré == annoncé, à l'échantillon près
+};
+
+struct LatencyCheckConfig {
+    uint32_t sampleRate = 48000;
+    double seconds = 2.0;
+    std::vector<size_t> blockSizes = {64, 441, 512, 1000};
+    size_t spectralFftSize = 512;   // réglage iOS (hop fftSize / 4)
+    std::vector<double> budgetsMs = {5.0, 15.0, 40.0};
+};
+
+struct ImpulseSignal {
+    std::vector<float> samples;
+    std::vector<size_t> positions;
+};
+
+ImpulseSignal makeImpulses(uint32_t sampleRate, double seconds) {
+    ImpulseSignal s;
+    s.samples.assign(static_cast<size_t>(seconds * sampleRate), 0.0f);
+    std::mt19937 rng(0x5eed);
+    std::uniform_int_distribution<size_t> gap(sampleRate * 5 / 1000, sampleRate * 12 / 1000);
+    for (size_t t = gap(rng); t < s.samples.size(); t += gap(rng)) {
+        s.samples[t] = 0.5f;
+        s.positions.push_back(t);
+    }
+    return s;
+}
+
+const char* engineName(NoiseEngine engine) {
+    switch (engine) {
+        case NoiseEngine::Off: return "off";
+        case NoiseEngine::Expander: return "expander";
+        case NoiseEngine::Spectral: return "spectrale";
+        case NoiseEngine::RNNoise: return "rnnoise";
+    }
+    return "?";
+}
+
+// Moteurs NR d'une chaîne mono (état propre à chaque instance) + compensation par moteur
+class NoiseChain {
+public:
+    explicit NoiseChain(const LatencyCheckConfig& config)
+        : nr_(config.sampleRate, 1), snr_(spectralConfig(config)) {
+        NoiseReducerConfig nrCfg;
+        nrCfg.enabled = true;
+        nr_.setConfig(nrCfg);
+        rnnoise_.initialize(config.sampleRate, 1);
+        latency_.expander = nr_.getLatencySamples();
+        latency_.spectral = snr_.getLatencySamples();
+        latency_.rnnoise = rnnoise_.getLatencySamples();
+        const size_t maxDelay = std::max({latency_.expander, latency_.spectral, latency_.rnnoise});
+        align_.assign(4, AudioEqualizer::CompensationDelay(maxDelay));
+    }
+
+    static SpectralNRConfig spectralConfig(const LatencyCheckConfig& config) {
+        SpectralNRConfig cfg;
+        cfg.sampleRate = config.sampleRate;
+        cfg.fftSize = config.spectralFftSize;
+        cfg.hopSize = config.spectralFftSize / 4;
+        cfg.enabled = true;
+        return cfg;
+    }
+
+    const NoiseEngineLatency& latency() const { return latency_; }
+    bool rnnoiseAvailable() const { return rnnoise_.isAvailable(); }
+
+    // Comme la plateforme : chaque moteur complété jusqu'au retard de chaîne
+    void setChainLatency(size_t chain) {
+        for (size_t e = 0; e < align_.size(); ++e) {
+            const size_t own = latency_.of(static_cast<NoiseEngine>(e));
+            align_[e].setDelay(chain > own ? chain - own : 0);
+        }
+    }
+
+    void enter(NoiseEngine engine) {
+        if (engine == NoiseEngine::Spectral) snr_.reset();
+        if (engine == NoiseEngine::RNNoise) rnnoise_.reset();
+        align_[static_cast<size_t>(engine)].reset();
+    }
+
+    void process(NoiseEngine engine, const float* in, float* out, size_t n, bool compensate) {
+        switch (engine) {
+            case NoiseEngine::Expander: nr_.processMono(in, out, n); break;
+            case NoiseEngine::Spectral: snr_.process(in, out, n); break;
+            case NoiseEngine::RNNoise: rnnoise_.processMono(in, out, n); break;
+            case NoiseEngine::Off: std::copy(in, in + n, out); break;
+        }
+        if (compensate) align_[static_cast<size_t>(engine)].process(out, out, n);
+    }
+
+private:
+    NoiseReducer nr_;
+    SpectralNR snr_;
+    RNNoiseSuppressor rnnoise_;
+    NoiseEngineLatency latency_;
+    std::vector<AudioEqualizer::CompensationDelay> align_;
+};
+
+// Blocs de tailles cycliques; engineAt(position) choisit le moteur de chaque bloc
+template <typename EngineAt>
+std::vector<float> runChain(NoiseChain& chain, const std::vector<float>& in, const std::vector<size_t>& blocks,
+                            bool compensate, EngineAt engineAt) {
+    std::vector<float> out(in.size(), 0.0f);
+    NoiseEngine current = engineAt(0);
+    size_t pos = 0, b = 0;
+    while (pos < in.size()) {
+        const size_t n = std::min(std::max<size_t>(1, blocks[b++ % blocks.size()]), in.size() - pos);
+        const NoiseEngine engine = engineAt(pos);
+        if (engine != current) {
+            chain.enter(engine);
+            current = engine;
+        }
+        chain.process(engine, in.data() + pos, out.data() + pos, n, compensate);
+        pos += n;
+    }
+    return out;
+}
+
+// Pic de corrélation entre la sortie et les impulsions postérieures à fromSample
+void measureLag(const ImpulseSignal& signal, const std::vector<float>& out, size_t fromSample,
+                size_t maxLag, LatencyCheckResult& result) {
+    std::vector<double> corr(maxLag + 1, 0.0);
+    for (size_t t : signal.positions) {
+        if (t < fromSample || t + maxLag >= out.size()) continue;
+        for (size_t lag = 0; lag <= maxLag; ++lag) corr[lag] += out[t + lag];
+    }
+    const size_t best = static_cast<size_t>(std::max_element(corr.begin(), corr.end()) - corr.begin());
+    double second = 0.0;
+    for (size_t lag = 0; lag <= maxLag; ++lag) {
+        if (lag + 2 < best || lag > best + 2) second = std::max(second, std::fabs(corr[lag]));
+    }
+    result.measuredSamples = corr[best] > 0.0 ? static_cast<long>(best) : -1;
+    result.peakRatio = second > 0.0 ? corr[best] / second : 0.0;
+    result.aligned = result.measuredSamples == static_cast<long>(result.reportedSamples);
+}
+
+std::vector<LatencyCheckResult> runLatencyChecks(const LatencyCheckConfig& config) {
+    std::vector<LatencyCheckResult> results;
+    const ImpulseSignal signal = makeImpulses(config.sampleRate, config.seconds);
+    const std::vector<size_t> blocks = config.blockSizes.empty() ? std::vector<size_t>{512} : config.blockSizes;
+    const size_t maxLag = config.sampleRate / 10;   // 100 ms
+
+    NoiseChain probe(config);
+    const NoiseEngineLatency lat = probe.latency();
+    const bool hasRnnoise = probe.rnnoiseAvailable();
+    // Sans RNNoise lié, la NR spectrale est le moteur le plus lent à compenser
+    const NoiseEngine requested = hasRnnoise ? NoiseEngine::RNNoise : NoiseEngine::Spectral;
+    const size_t chainLatency = CpuGovernor::noiseChainLatency(requested, lat);
+
+    // Moteurs seuls
+    for (NoiseEngine engine : {NoiseEngine::Expander, NoiseEngine::Spectral, NoiseEngine::RNNoise}) {
+        NoiseChain chain(config);
+        LatencyCheckResult r;
+        r.name = std::string(engineName(engine)) + " seul";
+        if (engine == NoiseEngine::RNNoise && !hasRnnoise) r.name += " (non lié : passe-tout)";
+        r.reportedSamples = lat.of(engine);
+        const auto out = runChain(chain, signal.samples, blocks, false, [engine](size_t) { return engine; });
+        measureLag(signal, out, 0, maxLag, r);
+        results.push_back(r);
+    }
+
+    // Chaîne compensée, palier par palier
+    for (QualityTier tier : {QualityTier::Full, QualityTier::Reduced, QualityTier::Minimal}) {
+        const NoiseEngine engine = CpuGovernor::noiseEngineFor(tier, requested);
+        NoiseChain chain(config);
+        chain.setChainLatency(chainLatency);
+        LatencyCheckResult r;
+        r.name = std::string("chaîne palier ") + std::to_string(static_cast<int>(tier)) + " (" + engineName(engine) + ")";
+        r.reportedSamples = chainLatency;
+        const auto out = runChain(chain, signal.samples, blocks, true, [engine](size_t) { return engine; });
+        measureLag(signal, out, 0, maxLag, r);
+        results.push_back(r);
+    }
+
+    // Changement de palier au milieu du flux (complet -> minimal), mesuré après le changement
+    {
+        const size_t half = signal.samples.size() / 2;
+        const NoiseEngine first = CpuGovernor::noiseEngineFor(QualityTier::Full, requested);
+        const NoiseEngine second = CpuGovernor::noiseEngineFor(QualityTier::Minimal, requested);
+        NoiseChain chain(config);
+        chain.setChainLatency(chainLatency);
+        LatencyCheckResult r;
+        r.name = std::string("changement ") + engineName(first) + " -> " + engineName(second);
+        r.reportedSamples = chainLatency;
+        const auto out = runChain(chain, signal.samples, blocks, true,
+                                  [=](size_t pos) { return pos < half ? first : second; });
+        measureLag(signal, out, half, maxLag, r);
+        results.push_back(r);
+    }
+
+    // Enregistrement : premières trames ignorées (NaayaRecord_PushPlanar), fichier sans retard
+    {
+        NoiseChain chain(config);
+        chain.setChainLatency(chainLatency);
+        const NoiseEngine engine = CpuGovernor::noiseEngineFor(QualityTier::Full, requested);
+        const auto out = runChain(chain, signal.samples, blocks, true, [engine](size_t) { return engine; });
+        std::vector<float> file(out.begin() + static_cast<std::ptrdiff_t>(std::min(chainLatency, out.size())), out.end());
+        LatencyCheckResult r;
+        r.name = "fichier enregistré (recalé)";
+        r.reportedSamples = 0;
+        measureLag(signal, file, 0, maxLag, r);
+        results.push_back(r);
+    }
+
+    // Mode faible latence
+    for (double budgetMs : config.budgetsMs) {
+        const size_t budget = static_cast<size_t>(std::floor(budgetMs * 0.001 * config.sampleRate));
+        const NoiseEngine engine = CpuGovernor::noiseEngineWithinBudget(requested, budget, lat);
+        const size_t lowChain = CpuGovernor::noiseChainLatency(engine, lat);
+        NoiseChain chain(config);
+        chain.setChainLatency(lowChain);
+        std::ostringstream name;
+        name << "budget " << budgetMs << " ms -> " << engineName(engine);
+        LatencyCheckResult r;
+        r.name = name.str();
+        r.reportedSamples = lowChain;
+        const auto out = runChain(chain, signal.samples, blocks, true, [engine](size_t) { return engine; });
+        measureLag(signal, out, 0, maxLag, r);
+        r.aligned = r.aligned && lowChain <= budget;
+        results.push_back(r);
+    }
+    return results;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<LatencyCheckResult> results = runLatencyChecks(LatencyCheckConfig{});
+    NAAYA_CHECK(results.size() == 11);
+    for (const auto& r : results) {
+        std::printf("%-40s annoncé %6zu  mesuré %6ld  netteté %6.1f\n", r.name.c_str(), r.reportedSamples,
+                    r.measuredSamples, r.peakRatio);
+        NAAYA_CHECK(r.aligned);
+        NAAYA_CHECK(r.peakRatio > kMinPeakRatio);
+    }
+    return naayaTestResult("LatencyAlignmentTest");
+}
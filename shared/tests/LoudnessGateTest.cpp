@@ -0,0 +1,50 @@
+// Porte absolue BS.1770 (-70 LUFS) : un passage plus calme ne compte pas dans l'intégrée.
+// 10 s à -65 LUFS puis 60 s à -95 LUFS : l'intégrée reste celle du passage audible.
+#include "TestSupport.h"
+#include "Audio/safety/LoudnessMeter.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr double kPi = 3.14159265358979323846;
+
+// Sinus 997 Hz mono : 0 dBFS crête = -3.01 LUFS (pondération K ~ 0 dB à cette fréquence)
+void feedSine(AudioSafety::LoudnessMeter& meter, double lufs, double seconds, size_t& phase) {
+    const double amplitude = std::pow(10.0, (lufs + 3.01) / 20.0);
+    std::vector<float> block(1024);
+    size_t remaining = static_cast<size_t>(seconds * kRate);
+    while (remaining > 0) {
+        const size_t n = std::min(block.size(), remaining);
+        for (size_t i = 0; i < n; ++i, ++phase) {
+            block[i] = static_cast<float>(amplitude * std::sin(2.0 * kPi * 997.0 * phase / kRate));
+        }
+        meter.processMono(block.data(), n);
+        remaining -= n;
+    }
+}
+
+} // namespace
+
+int main() {
+    AudioSafety::LoudnessMeter meter(kRate);
+    size_t phase = 0;
+    feedSine(meter, -65.0, 10.0, phase);
+    const double audible = meter.getReport().integratedLufs;
+    feedSine(meter, -95.0, 60.0, phase);
+    const double withTail = meter.getReport().integratedLufs;
+    std::printf("intégrée : %.2f LUFS, %.2f LUFS avec la fin à -95\n", audible, withTail);
+
+    NAAYA_CHECK_NEAR(audible, -65.0, 0.2);
+    NAAYA_CHECK_NEAR(withTail, audible, 0.05);
+
+    // Uniquement sous la porte : rien de mesuré
+    AudioSafety::LoudnessMeter quiet(kRate);
+    phase = 0;
+    feedSine(quiet, -95.0, 5.0, phase);
+    NAAYA_CHECK(quiet.getReport().integratedLufs == AudioSafety::LoudnessMeter::kSilenceLufs);
+    NAAYA_CHECK(AudioSafety::LoudnessMeter::normalizationGainDb(quiet.getReport(), -16.0, -1.0) == 0.0);
+    return naayaTestResult("LoudnessGateTest");
+}
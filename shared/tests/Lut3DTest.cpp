@@ -0,0 +1,64 @@
+// Lut3D::parseCube : une table .cube doit avoir exactement LUT_3D_SIZE³ noeuds. Un fichier
+// tronqué est refusé (aucune extrapolation des plans manquants), comme un fichier trop long.
+// loadCube ajoute le chemin au message d'erreur.
+#include "TestSupport.h"
+#include "Camera/filters/Lut3D.hpp"
+#include <string>
+
+using Camera::Lut3D;
+
+namespace {
+
+std::string cube(int size, int nodes) {
+    std::string text = "TITLE \"test\"\nLUT_3D_SIZE " + std::to_string(size) + "\n";
+    for (int i = 0; i < nodes; ++i) {
+        const int r = i % size, g = (i / size) % size, b = i / (size * size);
+        text += std::to_string(r / float(size - 1)) + " " + std::to_string(g / float(size - 1)) + " " +
+                std::to_string(b / float(size - 1)) + "\n";
+    }
+    return text;
+}
+
+} // namespace
+
+int main() {
+    std::string error;
+    const std::string full = cube(4, 64);
+    auto lut = Lut3D::parseCube(full.data(), full.size(), error);
+    NAAYA_CHECK(lut != nullptr);
+    NAAYA_CHECK(lut && lut->size() == 4);
+    if (lut) {
+        const uint16_t* last = lut->node(3, 3, 3);
+        NAAYA_CHECK(last[0] == 65535 && last[1] == 65535 && last[2] == 65535);
+    }
+
+    error.clear();
+    const std::string truncated = cube(4, 63);
+    NAAYA_CHECK(Lut3D::parseCube(truncated.data(), truncated.size(), error) == nullptr);
+    NAAYA_CHECK(error.find("tronqué") != std::string::npos);
+
+    error.clear();
+    const std::string tooLong = cube(4, 65);
+    NAAYA_CHECK(Lut3D::parseCube(tooLong.data(), tooLong.size(), error) == nullptr);
+    NAAYA_CHECK(!error.empty());
+
+    // test_lut.cube : plans B 2..6 absents (137 noeuds sur 512), refusé avec un message explicite
+    error.clear();
+    NAAYA_CHECK(Lut3D::loadCube(NAAYA_SOURCE_ROOT "/test_lut.cube", error) == nullptr);
+    NAAYA_CHECK(error.find("tronqué (137/512 noeuds)") != std::string::npos);
+    NAAYA_CHECK(error.find("test_lut.cube") != std::string::npos);
+    std::printf("%s\n", error.c_str());
+
+    // Même rampe sépia, table 8³ complète
+    error.clear();
+    auto fixture = Lut3D::loadCube(NAAYA_SOURCE_ROOT "/shared/tests/fixtures/sepia_lut_8.cube", error);
+    NAAYA_CHECK(fixture != nullptr);
+    NAAYA_CHECK(fixture && fixture->size() == 8);
+    if (fixture) {
+        const uint16_t* black = fixture->node(0, 0, 0);
+        NAAYA_CHECK(black[0] == 0 && black[1] == 0 && black[2] == 0);
+    }
+    if (!error.empty()) std::fprintf(stderr, "%s\n", error.c_str());
+
+    return naayaTestResult("Lut3DTest");
+}
@@ -0,0 +1,58 @@
+// Benchmarks hôte du code partagé, hors des apps et de CTest (durées longues, pas de seuil) :
+//   naaya_benchmarks            tous
+//   naaya_benchmarks mixer ...  sélection par nom
+#include "Audio/mixer/MixerBenchmark.h"
+#include "Audio/effects/SaturationBenchmark.h"
+#include "Audio/io/AudioFileWriterBenchmark.h"
+#include "Audio/waveform/SpectrogramBenchmark.h"
+#include "Camera/filters/ColorMatrixBenchmark.hpp"
+#include "Camera/filters/Lut3DBenchmark.hpp"
+#include "Camera/filters/FilterChainBenchmark.hpp"
+#include "Camera/filters/FFmpegGraphBenchmark.hpp"
+#include "Camera/filters/FrameStripeBenchmark.hpp"
+#include "Common/TaskSchedulerBenchmark.hpp"
+#include "Camera/pipeline/FramePipelineBenchmark.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+const Benchmark kBenchmarks[] = {
+    {"mixer", [] { AudioMixer::printMixerBenchmark(AudioMixer::runMixerBenchmark()); }},
+    {"saturation", [] { AudioFX::printSaturationBenchmark(AudioFX::runSaturationBenchmark()); }},
+    {"filewriter", [] { AudioIO::printAudioFileWriterBenchmark(AudioIO::runAudioFileWriterBenchmark()); }},
+    {"spectrogram", [] { AudioWaveform::printSpectrogramBenchmark(AudioWaveform::runSpectrogramBenchmark()); }},
+    {"colormatrix", [] { Camera::printColorMatrixBenchmark(Camera::runColorMatrixBenchmark()); }},
+    {"lut3d", [] { Camera::printLut3DBenchmark(Camera::runLut3DBenchmark()); }},
+    {"filterchain", [] { Camera::printFilterChainBenchmark(Camera::runFilterChainBenchmark()); }},
+    {"ffmpeggraph", [] { Camera::printFFmpegGraphBenchmark(Camera::runFFmpegGraphBenchmark()); }},
+    {"framestripe", [] { Camera::printFrameStripeBenchmark(Camera::runFrameStripeBenchmark()); }},
+    {"scheduler", [] { Common::printTaskSchedulerBenchmark(Common::runTaskSchedulerBenchmark()); }},
+    {"framepipeline", [] { Camera::printFramePipelineBenchmark(Camera::runFramePipelineBenchmark()); }},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int ran = 0;
+    for (const Benchmark& b : kBenchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i) selected = std::strcmp(argv[i], b.name) == 0;
+        if (!selected) continue;
+        std::printf("=== %s ===\n", b.name);
+        b.run();
+        ++ran;
+    }
+    if (ran == 0) {
+        std::fprintf(stderr, "Benchmarks :");
+        for (const Benchmark& b : kBenchmarks) std::fprintf(stderr, " %s", b.name);
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+    return 0;
+}
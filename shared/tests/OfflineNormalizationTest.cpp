@@ -0,0 +1,114 @@
+// Normalisation à l'export du rendu hors ligne : passe de mesure de la sortie de la chaîne,
+// puis rendu avec le gain d'export. Vérifie l'intégrée atteinte et le plafond true peak.
+#include "TestSupport.h"
+#include "Audio/offline/OfflineRenderer.h"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace AudioOffline;
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr size_t kWindow = 48000;   // fenêtre décodée simulée (1 s)
+
+// Rend tout le signal fenêtre par fenêtre, comme renderFile; mesure, ou applique gainDb
+AudioSafety::LoudnessReport renderPass(const ChainSettings& settings, const RenderOptions& options,
+                                       const std::vector<std::vector<float>>& input, double gainDb,
+                                       AudioEqualizer::AudioTaskPool* pool) {
+    const size_t total = input[0].size();
+    const size_t seg = OfflineRenderer::segmentFramesFor(settings, options, kRate);
+    std::vector<std::vector<float>> out(2, std::vector<float>(kWindow));
+    float* outPtrs[2] = {out[0].data(), out[1].data()};
+    std::unique_ptr<RenderChain> carry;
+    AudioSafety::LoudnessMeter meter(kRate);
+    for (size_t pos = 0; pos < total; pos += kWindow) {
+        const size_t n = std::min(kWindow, total - pos);
+        const float* inPtrs[2] = {input[0].data() + pos, input[1].data() + pos};
+        OfflineRenderer::renderWindow(settings, kRate, 2, inPtrs, outPtrs, n, seg, options.blockSize, carry, pool);
+        OfflineRenderer::applyGain(outPtrs, 2, n, gainDb);
+        OfflineRenderer::measureWindow(meter, 2, outPtrs, n);
+    }
+    return meter.getReport();
+}
+
+double normalizeAndMeasure(const ChainSettings& settings, const RenderOptions& options,
+                           const std::vector<std::vector<float>>& input, AudioEqualizer::AudioTaskPool* pool,
+                           double& gainDb) {
+    gainDb = OfflineRenderer::exportGainDb(options, renderPass(settings, options, input, 0.0, pool));
+    return renderPass(settings, options, input, gainDb, pool).integratedLufs;
+}
+
+std::vector<std::vector<float>> noise(double seconds, float amplitude, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<std::vector<float>> x(2, std::vector<float>(static_cast<size_t>(seconds * kRate)));
+    for (auto& ch : x) {
+        for (auto& v : ch) v = amplitude * dist(rng);
+    }
+    return x;
+}
+
+} // namespace
+
+int main() {
+    ChainSettings settings;          // safety (DC + limiteur) et NR actifs par défaut
+    settings.eqEnabled = true;
+    settings.eqBandGains = std::vector<double>(10, 0.0);
+    settings.eqBandGains[3] = 4.0;
+
+    RenderOptions options;
+    options.normalize = true;
+    options.targetLufs = -16.0;
+    options.ceilingDbtp = -1.0;
+
+    // Programme calme : gain positif, cible atteinte sans toucher le plafond
+    {
+        const auto input = noise(12.0, 0.02f, 1);
+        double gainDb = 0.0;
+        const double lufs = normalizeAndMeasure(settings, options, input, nullptr, gainDb);
+        NAAYA_CHECK(gainDb > 10.0);
+        NAAYA_CHECK_NEAR(lufs, options.targetLufs, 0.1);
+        const auto after = renderPass(settings, options, input, gainDb, nullptr);
+        NAAYA_CHECK(after.truePeakDbtp <= options.ceilingDbtp + 0.05);
+    }
+
+    // Programme à fort facteur de crête : le gain est plafonné par le true peak
+    {
+        auto input = noise(12.0, 0.01f, 2);
+        for (size_t i = kRate / 2; i < input[0].size(); i += kRate) {
+            input[0][i] = 0.8f;
+            input[1][i] = -0.8f;
+        }
+        double gainDb = 0.0;
+        const double lufs = normalizeAndMeasure(settings, options, input, nullptr, gainDb);
+        const auto after = renderPass(settings, options, input, gainDb, nullptr);
+        NAAYA_CHECK(lufs < options.targetLufs - 1.0);
+        NAAYA_CHECK_NEAR(after.truePeakDbtp, options.ceilingDbtp, 0.1);
+    }
+
+    // Rendu segmenté en parallèle : les deux passes restent identiques
+    {
+        AudioEqualizer::AudioTaskPool pool(3, false);
+        RenderOptions segmented = options;
+        segmented.segmentSeconds = 0.5;
+        const auto input = noise(12.0, 0.05f, 3);
+        double gainDb = 0.0;
+        const double lufs = normalizeAndMeasure(settings, segmented, input, &pool, gainDb);
+        NAAYA_CHECK_NEAR(lufs, segmented.targetLufs, 0.1);
+    }
+
+    // Sans normalize : aucun gain
+    {
+        RenderOptions plain;
+        AudioSafety::LoudnessReport loud;
+        loud.integratedLufs = -30.0;
+        loud.truePeakDbtp = -12.0;
+        NAAYA_CHECK(OfflineRenderer::exportGainDb(plain, loud) == 0.0);
+        NAAYA_CHECK_NEAR(OfflineRenderer::exportGainDb(options, loud), 11.0, 1e-9);
+    }
+
+    return naayaTestResult("OfflineNormalizationTest");
+}
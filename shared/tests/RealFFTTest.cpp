@@ -0,0 +1,71 @@
+// RealFFT : spectre comparé à une DFT directe (double précision), aller-retour forward/inverse,
+// et SpectralNR (qui s'appuie dessus) transparent quand le bruit estimé est nul.
+#include "TestSupport.h"
+#include "Audio/utils/RealFFT.h"
+#include "Audio/noise/SpectralNR.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using AudioEqualizer::RealFFT;
+
+namespace {
+
+void checkSize(size_t n) {
+    RealFFT fft(n);
+    NAAYA_CHECK(fft.size() == n);
+    std::mt19937 rng(static_cast<unsigned>(n));
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> x(n);
+    for (auto& v : x) v = dist(rng);
+
+    std::vector<float> re(fft.numBins()), im(fft.numBins());
+    fft.forward(x.data(), re.data(), im.data());
+    double maxErr = 0.0;
+    for (size_t k = 0; k < fft.numBins(); ++k) {
+        double sr = 0.0, si = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double a = -2.0 * M_PI * static_cast<double>(k * i % n) / static_cast<double>(n);
+            sr += x[i] * std::cos(a);
+            si += x[i] * std::sin(a);
+        }
+        maxErr = std::max({maxErr, std::fabs(sr - re[k]), std::fabs(si - im[k])});
+    }
+    NAAYA_CHECK(maxErr < 1e-4 * std::sqrt(static_cast<double>(n)));
+
+    std::vector<float> y(n);
+    fft.inverse(re.data(), im.data(), y.data());
+    double maxDiff = 0.0;
+    for (size_t i = 0; i < n; ++i) maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(y[i] - x[i])));
+    NAAYA_CHECK(maxDiff < 1e-5);
+}
+
+} // namespace
+
+int main() {
+    for (size_t n : {16, 32, 64, 256, 1024, 4096}) checkSize(n);
+
+    // beta = 0, plancher nul : gain unité sur chaque case, sortie = entrée retardée de fftSize
+    AudioNR::SpectralNRConfig cfg;
+    cfg.enabled = true;
+    cfg.fftSize = 512;
+    cfg.hopSize = 128;
+    cfg.beta = 0.0;
+    cfg.floorGain = 0.0;
+    AudioNR::SpectralNR nr(cfg);
+    const size_t latency = nr.getLatencySamples();
+    NAAYA_CHECK(latency == 512);
+    std::vector<float> in(48000), out(in.size());
+    for (size_t i = 0; i < in.size(); ++i) in[i] = 0.5f * std::sin(0.031f * static_cast<float>(i));
+    for (size_t i = 0; i < in.size(); i += 441) {
+        const size_t block = std::min<size_t>(441, in.size() - i);
+        nr.process(in.data() + i, out.data() + i, block);
+    }
+    double maxDiff = 0.0;
+    for (size_t i = 2 * latency; i < in.size(); ++i) {
+        maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(out[i] - in[i - latency])));
+    }
+    NAAYA_CHECK(maxDiff < 1e-4);
+
+    return naayaTestResult("RealFFTTest");
+}
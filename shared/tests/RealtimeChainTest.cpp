@@ -0,0 +1,142 @@
+// Chaîne Android complète (NR -> FX -> sécurité -> EQ, gouverneur, tampons du pool) exécutée
+// comme nativeProcessShortInterleaved, sous RealtimeScope avec les tripwires : aucune allocation,
+// libération ni verrou bloquant, y compris quand les paramètres FX changent entre deux buffers
+// (effets mis à jour en place, comme nativeSyncParams).
+#include "TestSupport.h"
+#include "Audio/core/AudioEqualizer.h"
+#include "Audio/effects/Compressor.h"
+#include "Audio/effects/Delay.h"
+#include "Audio/effects/EffectChain.h"
+#include "Audio/effects/Saturation.h"
+#include "Audio/noise/NoiseReducer.h"
+#include "Audio/safety/AudioSafety.h"
+#include "Audio/safety/CpuGovernor.h"
+#include "Audio/utils/AudioBuffer.h"
+#include "Audio/utils/AudioProfiler.h"
+#include "Audio/utils/RealtimeScope.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using AudioEqualizer::RealtimeScope;
+
+namespace {
+
+constexpr uint32_t kRate = 48000;
+constexpr size_t kFrames = 960;     // 20 ms, taille de buffer AudioRecord typique
+constexpr int kBuffers = 500;       // 10 s
+
+uint64_t g_violations = 0;
+const char* g_firstViolation = "";
+void countViolation(const AudioEqualizer::RealtimeViolation& v) {
+    if (g_violations++ == 0) g_firstViolation = v.function;
+}
+
+struct Chain {
+    AudioEqualizer::AudioEqualizer eq{10, kRate};
+    AudioNR::NoiseReducer nr{kRate, 2};
+    AudioSafety::AudioSafetyEngine safety{kRate, 2};
+    AudioSafety::CpuGovernor governor{kRate};
+    AudioFX::EffectChain fx;
+    AudioFX::SaturationEffect* sat = nullptr;
+    AudioFX::CompressorEffect* comp = nullptr;
+    AudioFX::DelayEffect* del = nullptr;
+    AudioEqualizer::AudioBufferPool scratch{3, 2, 4096};
+
+    Chain() {
+        fx.setSampleRate(kRate, 2);
+        sat = fx.emplaceEffect<AudioFX::SaturationEffect>();
+        comp = fx.emplaceEffect<AudioFX::CompressorEffect>();
+        del = fx.emplaceEffect<AudioFX::DelayEffect>();
+        comp->setEnabled(true);
+        del->setEnabled(true);
+        AudioNR::NoiseReducerConfig cfg;
+        cfg.enabled = true;
+        nr.setConfig(cfg);
+        for (size_t i = 0; i < eq.getNumBands(); ++i) eq.setBandGain(i, (i % 2) ? 4.0 : -3.0);
+    }
+
+    // nativeSyncParams : paramètres changés sur les effets existants
+    void syncFx(int step) {
+        sat->setParameters(AudioFX::SaturationType::Tanh, 3.0 + (step % 4), 0.5, 0.0);
+        sat->setEnabled(true);
+        comp->setParameters(-18.0 - step % 6, 3.0, 10.0, 80.0, 2.0);
+        del->setParameters(step % 2 ? 220.0 : 150.0, 0.3, 0.2);   // retard allongé : aucune réallocation
+    }
+
+    // Corps de nativeProcessShortInterleaved (stéréo)
+    void process(int16_t* pcm, size_t n) {
+        RealtimeScope rt;
+        AudioEqualizer::ProfileLap lap(n, kRate);
+        governor.beginBuffer();
+        eq.setBandLimit(AudioSafety::CpuGovernor::eqBandLimitFor(governor.tier(), eq.getNumBands()));
+        auto work = scratch.acquire(n);
+        auto tmp = scratch.acquire(n);
+        auto out = scratch.acquire(n);
+        float* inL = work.getChannel(0);
+        float* inR = work.getChannel(1);
+        for (size_t i = 0; i < n; ++i) {
+            inL[i] = pcm[2 * i] / 32768.0f;
+            inR[i] = pcm[2 * i + 1] / 32768.0f;
+        }
+        nr.processStereo(work.getChannel(0), work.getChannel(1), tmp.getChannel(0), tmp.getChannel(1), n);
+        std::swap(work, tmp);
+        if (fx.isEnabled()) {
+            fx.processStereo(work.getChannel(0), work.getChannel(1), tmp.getChannel(0), tmp.getChannel(1), n);
+            std::swap(work, tmp);
+        }
+        safety.processStereo(work.getChannel(0), work.getChannel(1), n);
+        (void)safety.getLastReport();
+        eq.processStereo(work.getChannel(0), work.getChannel(1), out.getChannel(0), out.getChannel(1), n);
+        const float* oL = out.getChannel(0);
+        const float* oR = out.getChannel(1);
+        for (size_t i = 0; i < n; ++i) {
+            pcm[2 * i] = static_cast<int16_t>(std::lrint(std::fmax(-1.f, std::fmin(1.f, oL[i])) * 32767.0f));
+            pcm[2 * i + 1] = static_cast<int16_t>(std::lrint(std::fmax(-1.f, std::fmin(1.f, oR[i])) * 32767.0f));
+        }
+        lap.finish();
+        governor.endBuffer(n);
+    }
+};
+
+} // namespace
+
+int main() {
+    NAAYA_CHECK(RealtimeScope::tripwiresEnabled());
+    RealtimeScope::setViolationHandler(&countViolation);
+
+    Chain chain;
+    chain.syncFx(0);
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> dist(-12000, 12000);
+    std::vector<int16_t> pcm(kFrames * 2);
+    double energy = 0.0;
+
+    g_violations = 0;
+    for (int b = 0; b < kBuffers; ++b) {
+        for (auto& v : pcm) v = static_cast<int16_t>(dist(rng));
+        if (b % 25 == 0) {
+            RealtimeScope rt;
+            chain.syncFx(b / 25);
+        }
+        chain.process(pcm.data(), kFrames);
+        for (int16_t v : pcm) energy += static_cast<double>(v) * v;
+    }
+    std::printf("chaîne temps réel : %d buffers, %llu violations %s\n", kBuffers,
+                static_cast<unsigned long long>(g_violations), g_firstViolation);
+    NAAYA_CHECK(g_violations == 0);
+    NAAYA_CHECK(energy > 0.0);   // la chaîne produit bien du signal
+
+    // Tripwires armés : une reconstruction de la chaîne (ancien nativeSyncParams) est signalée
+    {
+        RealtimeScope rt;
+        chain.fx.clear();
+    }
+    NAAYA_CHECK(g_violations > 0);
+    RealtimeScope::setViolationHandler(nullptr);
+
+    return naayaTestResult("RealtimeChainTest");
+}
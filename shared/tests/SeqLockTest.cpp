@@ -0,0 +1,88 @@
+// SeqLock : mesures publiées par le thread audio (latence, sécurité, gouverneur) et lues par
+// JSI sans verrou. Lecture jamais déchirée, publication seulement sur changement, aucune
+// allocation ni verrou bloquant dans la section temps réel.
+#include "TestSupport.h"
+#include "Audio/utils/RealtimeScope.h"
+#include "Audio/utils/SeqLock.h"
+#include <atomic>
+#include <thread>
+
+using AudioEqualizer::RealtimeScope;
+using AudioEqualizer::SeqLock;
+
+namespace {
+
+// Champs liés : une lecture déchirée les désaccorde (rapport de sécurité complet : 16 mots)
+struct Stages {
+    uint64_t sampleRate = 48000;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    uint64_t c = 0;
+    uint64_t copies[12] = {};
+    uint64_t total() const { return a + b + c; }
+    bool consistent() const {
+        for (uint64_t v : copies) {
+            if (v != a) return false;
+        }
+        return b == 2 * a && c == 3 * a && sampleRate == 48000 + a;
+    }
+    void set(uint64_t value) {
+        a = value;
+        b = 2 * value;
+        c = 3 * value;
+        sampleRate = 48000 + value;
+        for (uint64_t& v : copies) v = value;
+    }
+};
+
+std::atomic<int> g_violations{0};
+void countViolation(const AudioEqualizer::RealtimeViolation&) { g_violations.fetch_add(1); }
+
+} // namespace
+
+int main() {
+    SeqLock<Stages> lock;
+    NAAYA_CHECK(lock.load().sampleRate == 48000);
+    NAAYA_CHECK(lock.load().total() == 0);
+
+    // Valeur inchangée : pas de réécriture
+    Stages s;
+    s.set(512);
+    NAAYA_CHECK(lock.publish(s));
+    NAAYA_CHECK(!lock.publish(s));
+    NAAYA_CHECK(lock.load().a == 512);
+
+    // Écrivain "audio" en section temps réel, lecteur concurrent
+    RealtimeScope::setViolationHandler(&countViolation);
+    std::atomic<bool> started{false}, done{false};
+    uint64_t torn = 0, reads = 0;
+    std::thread reader([&] {
+        started.store(true, std::memory_order_release);
+        while (!done.load(std::memory_order_acquire)) {
+            const Stages v = lock.load();
+            if (!v.consistent()) ++torn;
+            ++reads;
+        }
+    });
+    while (!started.load(std::memory_order_acquire)) std::this_thread::yield();
+    int published = 0;
+    {
+        RealtimeScope rt;
+        for (uint64_t i = 1; i <= 200000; ++i) {
+            Stages v;
+            v.set(i / 4);   // quatre buffers de suite à la même valeur (0 .. 50000)
+            if (lock.publish(v)) ++published;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    RealtimeScope::setViolationHandler(nullptr);
+
+    NAAYA_CHECK(torn == 0);
+    NAAYA_CHECK(reads > 0);
+    NAAYA_CHECK(published == 50001);
+    NAAYA_CHECK(lock.load().a == 50000);
+    NAAYA_CHECK(g_violations.load() == 0);
+
+    return naayaTestResult("SeqLockTest");
+}
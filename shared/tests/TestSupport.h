@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+// Vérifications des tests hôte : un échec est affiché et compté, main() retourne naayaTestResult()
+namespace NaayaTest {
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+} // namespace NaayaTest
+
+#define NAAYA_CHECK(cond)                                                               \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: échec: %s\n", __FILE__, __LINE__, #cond);      \
+            ++NaayaTest::failures();                                                    \
+        }                                                                               \
+    } while (0)
+
+#define NAAYA_CHECK_NEAR(a, b, tol)                                                     \
+    do {                                                                                \
+        const double naayaA_ = static_cast<double>(a);                                  \
+        const double naayaB_ = static_cast<double>(b);                                  \
+        if (!(naayaA_ - naayaB_ <= (tol) && naayaB_ - naayaA_ <= (tol))) {              \
+            std::fprintf(stderr, "%s:%d: échec: %s = %g, attendu %g +/- %g\n",          \
+                         __FILE__, __LINE__, #a, naayaA_, naayaB_, static_cast<double>(tol)); \
+            ++NaayaTest::failures();                                                    \
+        }                                                                               \
+    } while (0)
+
+inline int naayaTestResult(const char* name) {
+    const int n = NaayaTest::failures();
+    std::printf("[%s] %s (%d échec%s)\n", name, n == 0 ? "OK" : "ÉCHEC", n, n > 1 ? "s" : "");
+    return n == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
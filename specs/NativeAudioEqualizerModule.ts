@@ -1,5 +1,22 @@
 import { TurboModule, TurboModuleRegistry } from 'react-native';
 
+// Statistiques d'un histogramme de profilage (p50/p95/p99 à ±6 %)
+export type AudioProfileStats = {
+  count: number;
+  mean: number;
+  p50: number;
+  p95: number;
+  p99: number;
+  max: number;
+};
+
+// Courbe de l'EQ renvoyée par getFrequencyResponse (Float32Array : hors codegen, typée ici)
+export type EQFrequencyResponse = {
+  frequencies: Float32Array; // Hz, log-espacées
+  magnitudeDb: Float32Array;
+  phase: Float32Array; // radians
+};
+
 export interface Spec extends TurboModule {
   // Contrôle de l'égaliseur
   readonly setEQEnabled: (enabled: boolean) => void;
@@ -10,9 +27,17 @@ export interface Spec extends TurboModule {
   // Gestion des bandes de fréquence
   readonly setBandGain: (bandIndex: number, gain: number) => void;
   readonly getBandGain: (bandIndex: number) => number;
+  // Réponse exacte de la cascade (calcul natif) -> EQFrequencyResponse
+  readonly getFrequencyResponse: (
+    numPoints: number,
+    minHz: number,
+    maxHz: number,
+  ) => Object;
   
   // Préréglages
   readonly setPreset: (presetName: string) => void;
+  // Fondu des gains vers le preset en durationMs (0 .. 10000)
+  readonly morphToPreset: (presetName: string, durationMs: number) => void;
   readonly getCurrentPreset: () => string;
   readonly getAvailablePresets: () => string[];
   
@@ -66,7 +91,150 @@ export interface Spec extends TurboModule {
     clippedSamples: number;
     feedbackScore: number;
     overload: boolean;
+    // Loudness EBU R128
+    momentaryLufs: number;
+    shortTermLufs: number;
+    integratedLufs: number;
+    loudnessRange: number;
+    truePeakDbtp: number;
+    // Gouverneur CPU (0 = complet, 1 = NR spectrale + EQ 1/2 des bandes, 2 = expander + EQ 3 bandes)
+    qualityTier: number;
+    qualityTierChanges: number;
+    cpuLoad: number;
+    deadlineMisses: number;
+  };
+  readonly safetyResetLoudness: () => void;
+  readonly safetyGetNormalizationGain: (
+    targetLufs: number,
+    ceilingDbtp: number,
+  ) => number;
+  readonly safetySetGovernorEnabled: (enabled: boolean) => void;
+
+  // Profilage CPU par étage (temps en µs par buffer, charge en % de la durée du buffer)
+  readonly perfGetReport: () => {
+    compiledIn: boolean;
+    enabled: boolean;
+    buffers: number;
+    overruns: number;
+    loadPercent: AudioProfileStats;
+    stagesUs: {
+      conversion: AudioProfileStats;
+      nr: AudioProfileStats;
+      rnnoise: AudioProfileStats;
+      fx: AudioProfileStats;
+      safety: AudioProfileStats;
+      eq: AudioProfileStats;
+      analysis: AudioProfileStats;
+      total: AudioProfileStats;
+    };
+  };
+  readonly perfSetEnabled: (enabled: boolean) => void;
+  readonly perfReset: () => void;
+
+  // Latence de la chaîne temps réel (échantillons par étage). La sortie enregistrée et
+  // l'horodatage audio des vidéos sont recalés de totalSamples.
+  readonly latencyGetReport: () => {
+    sampleRate: number;
+    stagesSamples: {
+      noiseReduction: number; // moteur NR complété au retard commun des paliers CPU
+      effects: number;
+      safety: number;
+      equalizer: number;
+    };
+    totalSamples: number;
+    totalMs: number;
+    lowLatency: boolean;
+    budgetMs: number;
+  };
+  // Mode faible latence : RNNoise -> NR spectrale -> expander jusqu'à tenir budgetMs (0 .. 1000)
+  readonly latencySetLowLatencyMode: (enabled: boolean, budgetMs: number) => void;
+
+  // Rendu hors ligne : réapplique les réglages courants à des fichiers enregistrés
+  // (sortie = entrée autorisée : remplacement en fin de rendu)
+  readonly offlineRenderStart: (inputs: string[], outputs: string[]) => boolean;
+  readonly offlineRenderGetProgress: () => {
+    state: string; // 'idle' | 'running' | 'done' | 'cancelled' | 'failed'
+    progress: number; // 0..1
+    realtimeFactor: number; // x temps réel
+    audioSeconds: number;
+    elapsedSeconds: number;
+    filesDone: number;
+    filesTotal: number;
+    error: string;
+  };
+  readonly offlineRenderCancel: () => void;
+  // Normalisation des rendus suivants : passe de mesure, puis gain vers targetLufs
+  // (réduit pour garder le true peak sous ceilingDbtp)
+  readonly offlineRenderSetNormalization: (
+    enabled: boolean,
+    targetLufs: number,
+    ceilingDbtp: number,
+  ) => void;
+
+  // Enregistrement de la sortie traitée (format du flux audio courant)
+  // format : 0=WAV, 1=W64, 2=FLAC ; sampleFormat : 0=16 bits, 1=24 bits, 2=float
+  readonly recordStart: (path: string, format: number, sampleFormat: number) => boolean;
+  readonly recordStop: () => boolean;
+  readonly recordGetStats: () => {
+    recording: boolean;
+    seconds: number;
+    framesWritten: number;
+    framesDropped: number; // file pleine (disque trop lent)
+    bytesWritten: number;
+    maxQueueFill: number; // 0..1
+    error: string;
+  };
+  readonly recordRepair: (path: string) => boolean;
+
+  // Formes d'onde : pyramide min/max/rms calculée en arrière-plan, cache <fichier>.wfp
+  readonly waveformUpdate: (path: string) => void;
+  readonly waveformGetInfo: (path: string) => {
+    running: boolean;
+    sampleRate: number;
+    channels: number;
+    frames: number;
+    seconds: number;
+    samplesPerBucket: number[];
+    error: string;
+  };
+  // -> Float32Array de 3 x width (min, max, rms par colonne) ; channel -1 : canaux fusionnés
+  readonly waveformQuery: (
+    path: string,
+    startSeconds: number,
+    endSeconds: number,
+    width: number,
+    channel: number,
+  ) => Object;
+  readonly waveformRelease: (path: string) => void;
+
+  // Spectrogrammes : tuiles 8 bits (fréquence log, dB), cache disque <cacheDir>/<empreinte>/
+  readonly spectrogramOpen: (path: string, cacheDir: string) => boolean;
+  readonly spectrogramGetInfo: (path: string) => {
+    rendering: boolean;
+    sampleRate: number;
+    channels: number;
+    frames: number;
+    seconds: number;
+    tileWidth: number;
+    tileHeight: number;
+    samplesPerColumn: number; // au zoom 0, doublé à chaque zoom
+    maxZoom: number;
+    minHz: number;
+    maxHz: number;
+    minDb: number;
+    maxDb: number;
+    cacheKey: string;
+    error: string;
   };
+  // -> ArrayBuffer de tileHeight x tileWidth octets (ligne 0 = aigu) ou null
+  readonly spectrogramGetTile: (path: string, zoom: number, index: number) => Object | null;
+  readonly spectrogramRender: (
+    path: string,
+    zoom: number,
+    firstTile: number,
+    count: number,
+  ) => void;
+  readonly spectrogramRelease: (path: string) => void;
 
   // Effets créatifs (FX)
   readonly fxSetEnabled: (enabled: boolean) => void;
@@ -83,6 +251,14 @@ export interface Spec extends TurboModule {
     feedback: number,
     mix: number,
   ) => void;
+  // Saturation anti-repliée (ADAA) : type 0 = tanh, 1 = cubique, 2 = asymétrique
+  readonly fxSetSaturation: (
+    enabled: boolean,
+    type: number,
+    driveDb: number,
+    mix: number,
+    outputDb: number,
+  ) => void;
 }
 
 export default TurboModuleRegistry.getEnforcing<Spec>('NativeAudioEqualizerModule');
@@ -36,7 +36,7 @@ console.log('   - Sélecteur d\'interpolation (Nearest/Trilinear)');
 console.log('   - Boutons Appliquer/Annuler');
 
 // Simuler la saisie du chemin
-const testLutPath = '/Users/m1/Desktop/yana/Naaya/test_lut.cube';
+const testLutPath = '/Users/m1/Desktop/yana/Naaya/shared/tests/fixtures/sepia_lut_8.cube';
 console.log(`3. Utilisateur saisit: ${testLutPath}`);
 console.log('4. Utilisateur choisit interpolation: Trilinear');
 console.log('5. Utilisateur tape "Appliquer"');